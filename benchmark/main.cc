@@ -0,0 +1,582 @@
+#define CGLTF_IMPLEMENTATION
+#include <thirdparty/cgltf/cgltf.h>
+
+#define STB_SPRINTF_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include <thirdparty/stb/stb_sprintf.h>
+#include <thirdparty/stb/stb_image.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <engine/core/file.h>
+#include <engine/core/log.h>
+#include <engine/core/time.h>
+#include <engine/core/array.h>
+#include <engine/core/task_sheduler.h>
+#include <engine/scene/scene_ecs.h>
+#include <engine/physics/physics.h>
+#include <engine/physics/physics_ecs.h>
+#include <engine/physics/physics_shapes_manager.h>
+
+#define CRUDE_PHYSICS_BENCHMARK_GRID_SPACING                       4.f
+
+/**
+ * Headless physics stress benchmark. Boots crude_physics with the ECS sync
+ * systems and no graphics or audio, spawns bodies on a grid and steps a
+ * fixed number of frames with a fixed delta time.
+ *
+ * crude_physics_benchmark [--characters N] [--virtual-characters 0|1] [--kinematic-bodies N]
+ *   [--static-bodies N] [--frames N] [--max-bodies N] [--resources DIRECTORY] [--mesh RELATIVE_GLTF] [--csv FILE]
+ */
+typedef struct crude_physics_benchmark_options
+{
+  uint32                                                   characters_count;
+  bool                                                     virtual_characters;
+  uint32                                                   kinematic_bodies_count;
+  uint32                                                   static_bodies_count;
+  uint32                                                   frames_count;
+  uint32                                                   max_bodies;
+  char const                                              *resources_absolute_directory;
+  /* Static bodies use the mesh shape of this gltf, boxes if NULL */
+  char const                                              *mesh_relative_filepath;
+  char const                                              *csv_absolute_filepath;
+} crude_physics_benchmark_options;
+
+typedef struct crude_physics_benchmark_frame
+{
+  float32                                                  frame_time;
+  crude_physics_telemetry                                  telemetry;
+} crude_physics_benchmark_frame;
+
+static bool
+crude_physics_benchmark_parse_options_
+(
+  _In_ int                                                 argc,
+  _In_ char                                              **argv,
+  _Out_ crude_physics_benchmark_options                   *options
+);
+
+static void
+crude_physics_benchmark_spawn_
+(
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_shapes_manager                       *physics_shapes_manager,
+  _In_ crude_physics_benchmark_options const              *options
+);
+
+static void
+crude_physics_benchmark_move_
+(
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics                                      *physics,
+  _In_ uint32                                              frame_index
+);
+
+static void
+crude_physics_benchmark_report_
+(
+  _In_ crude_physics_benchmark_frame const                *frames,
+  _In_ uint32                                              frames_count,
+  _In_ crude_physics const                                *physics,
+  _In_ crude_heap_allocator const                         *physics_allocator,
+  _In_ int64                                               physics_allocator_peak_occupied,
+  _In_ crude_physics_benchmark_options const              *options,
+  _In_ crude_heap_allocator                               *allocator
+);
+
+static void
+crude_physics_benchmark_contact_added_callback_
+(
+  _In_ crude_entity                                        signal_entity,
+  _In_ crude_entity                                        hitted_entity
+);
+
+static int
+crude_physics_benchmark_compare_time_
+(
+  _In_ void const                                         *a,
+  _In_ void const                                         *b
+);
+
+static float32
+crude_physics_benchmark_random_
+(
+  _In_ float32                                             min,
+  _In_ float32                                             max
+);
+
+int
+main
+(
+  _In_ int                                                 argc,
+  _In_ char                                              **argv
+)
+{
+  crude_physics_benchmark_options                          options;
+  crude_heap_allocator                                     common_allocator;
+  crude_heap_allocator                                     physics_allocator;
+  crude_heap_allocator                                     cgltf_temporary_allocator;
+  crude_task_sheduler                                      task_sheduler;
+  crude_components_serialization_manager                   components_serialization_manager;
+  crude_physics_shapes_manager_creation                    physics_shapes_manager_creation;
+  crude_physics_shapes_manager                             physics_shapes_manager;
+  crude_physics_system_context                             physics_system_context;
+  crude_physics_creation                                   physics_creation;
+  crude_physics                                            physics;
+  crude_physics_benchmark_frame                           *frames;
+  crude_ecs                                               *world;
+  char                                                     working_directory[ 4096 ];
+  int64                                                    current_time;
+  int64                                                    step_time;
+  int64                                                    physics_allocator_peak_occupied;
+
+  if ( !crude_physics_benchmark_parse_options_( argc, argv, &options ) )
+  {
+    return 1;
+  }
+
+  crude_log_initialize( );
+  crude_time_service_initialize( );
+
+  crude_heap_allocator_initialize( &common_allocator, CRUDE_RMEGA( 64 ), "common_allocator" );
+  crude_heap_allocator_initialize( &physics_allocator, CRUDE_RMEGA( 256 ), "physics_allocator" );
+  crude_heap_allocator_initialize( &cgltf_temporary_allocator, CRUDE_RMEGA( 64 ), "cgltf_temporary_allocator" );
+
+  crude_task_sheduler_initialize( &task_sheduler );
+
+  world = crude_ecs_create( );
+  crude_ecs_set_threads( world, 1 );
+  crude_components_serialization_manager_initialize( &components_serialization_manager, &common_allocator );
+  crude_scene_components_import( world, &components_serialization_manager );
+
+  crude_get_current_working_directory( working_directory, sizeof( working_directory ) );
+
+  physics_creation = CRUDE_COMPOUNT_EMPTY( crude_physics_creation );
+  physics_creation.physics_allocator = &physics_allocator;
+  physics_creation.physics_shapes_manager = &physics_shapes_manager;
+  physics_creation.physics_system_context = &physics_system_context;
+  physics_creation.task_sheduler = &task_sheduler;
+  physics_creation.max_bodies = options.max_bodies;
+  crude_physics_initialize( &physics, &physics_creation, world );
+
+  physics_shapes_manager_creation = CRUDE_COMPOUNT_EMPTY( crude_physics_shapes_manager_creation );
+  physics_shapes_manager_creation.allocator = &common_allocator;
+  physics_shapes_manager_creation.cgltf_temporary_allocator = &cgltf_temporary_allocator;
+  physics_shapes_manager_creation.physics_manager = &physics;
+  physics_shapes_manager_creation.resources_absolute_directory = options.resources_absolute_directory ? options.resources_absolute_directory : working_directory;
+  /* Cooking is a part of the level loading, not of the step */
+  physics_shapes_manager_creation.cache_absolute_directory = NULL;
+  crude_physics_shapes_manager_initialize( &physics_shapes_manager, &physics_shapes_manager_creation );
+
+  physics_system_context = CRUDE_COMPOUNT_EMPTY( crude_physics_system_context );
+  physics_system_context.physics = &physics;
+  crude_physics_system_import( world, &components_serialization_manager, &physics_system_context );
+
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_PHYSICS, "Physics benchmark: %u %s characters, %u kinematic bodies, %u static %s, %u frames",
+    options.characters_count, options.virtual_characters ? "virtual" : "rigid", options.kinematic_bodies_count, options.static_bodies_count, options.mesh_relative_filepath ? options.mesh_relative_filepath : "boxes", options.frames_count );
+
+  crude_physics_begin_bodies_batch( &physics );
+  crude_physics_benchmark_spawn_( world, &physics_shapes_manager, &options );
+  crude_physics_end_bodies_batch( &physics );
+  crude_physics_run_system_on_start( world );
+
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( frames, options.frames_count, crude_heap_allocator_pack( &common_allocator ) );
+
+  /* Fixed delta time in microseconds rounded up, every frame does exactly one step */
+  step_time = CRUDE_CAST( int64, ceilf( physics.step_delta_time * 1000000.f ) );
+  current_time = crude_time_now( );
+  physics.last_update_time = current_time;
+  physics_allocator_peak_occupied = physics_allocator.occupied;
+
+  for ( uint32 frame_index = 0; frame_index < options.frames_count; ++frame_index )
+  {
+    int64                                                  frame_start_time;
+
+    current_time += step_time;
+    crude_physics_benchmark_move_( world, &physics, frame_index );
+
+    frame_start_time = crude_time_now( );
+    crude_physics_update( &physics, current_time );
+    crude_ecs_progress( world, physics.step_delta_time );
+    frames[ frame_index ].frame_time = 1000.f * crude_time_delta_seconds( frame_start_time, crude_time_now( ) );
+    frames[ frame_index ].telemetry = physics.telemetry;
+
+    physics_allocator_peak_occupied = CRUDE_MAX( physics_allocator_peak_occupied, physics_allocator.occupied );
+  }
+
+  crude_physics_benchmark_report_( frames, options.frames_count, &physics, &physics_allocator, physics_allocator_peak_occupied, &options, &common_allocator );
+
+  CRUDE_ARRAY_DEINITIALIZE( frames );
+
+  crude_ecs_destroy( world );
+  crude_components_serialization_manager_deinitialize( &components_serialization_manager );
+  crude_physics_shapes_manager_deinitialize( &physics_shapes_manager );
+  crude_physics_deinitialize( &physics );
+  crude_task_sheduler_deinitialize( &task_sheduler );
+
+  crude_heap_allocator_deinitialize( &cgltf_temporary_allocator );
+  crude_heap_allocator_deinitialize( &physics_allocator );
+  crude_heap_allocator_deinitialize( &common_allocator );
+  crude_log_deinitialize( );
+  return 0;
+}
+
+bool
+crude_physics_benchmark_parse_options_
+(
+  _In_ int                                                 argc,
+  _In_ char                                              **argv,
+  _Out_ crude_physics_benchmark_options                   *options
+)
+{
+  *options = CRUDE_COMPOUNT_EMPTY( crude_physics_benchmark_options );
+  options->characters_count = 256;
+  options->kinematic_bodies_count = 64;
+  options->static_bodies_count = 512;
+  options->frames_count = 1000;
+
+  for ( int i = 1; i < argc; ++i )
+  {
+    char const                                            *value;
+
+    if ( i + 1 >= argc )
+    {
+      fprintf( stderr, "Missing value for \"%s\"\n", argv[ i ] );
+      return false;
+    }
+
+    value = argv[ ++i ];
+    if ( strcmp( argv[ i - 1 ], "--characters" ) == 0 )
+    {
+      options->characters_count = strtoul( value, NULL, 10 );
+    }
+    else if ( strcmp( argv[ i - 1 ], "--virtual-characters" ) == 0 )
+    {
+      options->virtual_characters = strtoul( value, NULL, 10 ) != 0;
+    }
+    else if ( strcmp( argv[ i - 1 ], "--kinematic-bodies" ) == 0 )
+    {
+      options->kinematic_bodies_count = strtoul( value, NULL, 10 );
+    }
+    else if ( strcmp( argv[ i - 1 ], "--static-bodies" ) == 0 )
+    {
+      options->static_bodies_count = strtoul( value, NULL, 10 );
+    }
+    else if ( strcmp( argv[ i - 1 ], "--frames" ) == 0 )
+    {
+      options->frames_count = strtoul( value, NULL, 10 );
+    }
+    else if ( strcmp( argv[ i - 1 ], "--max-bodies" ) == 0 )
+    {
+      options->max_bodies = strtoul( value, NULL, 10 );
+    }
+    else if ( strcmp( argv[ i - 1 ], "--resources" ) == 0 )
+    {
+      options->resources_absolute_directory = value;
+    }
+    else if ( strcmp( argv[ i - 1 ], "--mesh" ) == 0 )
+    {
+      options->mesh_relative_filepath = value;
+    }
+    else if ( strcmp( argv[ i - 1 ], "--csv" ) == 0 )
+    {
+      options->csv_absolute_filepath = value;
+    }
+    else
+    {
+      fprintf( stderr, "Unknown option \"%s\"\n", argv[ i - 1 ] );
+      return false;
+    }
+  }
+
+  if ( options->frames_count == 0 )
+  {
+    fprintf( stderr, "Frames count must be positive\n" );
+    return false;
+  }
+
+  if ( options->max_bodies == 0 )
+  {
+    options->max_bodies = CRUDE_MAX( CRUDE_PHYSICS_JOLT_MAX_BODIES, 2 * ( options->characters_count + options->kinematic_bodies_count + options->static_bodies_count + 1 ) );
+  }
+  return true;
+}
+
+/* Characters walk over a grid of static bodies, every fourth one is an area which kinematic sensors sweep through */
+void
+crude_physics_benchmark_spawn_
+(
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_shapes_manager                       *physics_shapes_manager,
+  _In_ crude_physics_benchmark_options const              *options
+)
+{
+  crude_physics_mesh_shape_handle                          mesh_shape_handle;
+  crude_transform                                          transform;
+  crude_entity                                             entity;
+  float32                                                  grid_half_size;
+  uint32                                                   grid_side;
+
+  grid_side = CRUDE_CAST( uint32, ceilf( sqrtf( CRUDE_CAST( float32, CRUDE_MAX( options->static_bodies_count, 1u ) ) ) ) );
+  grid_half_size = 0.5f * grid_side * CRUDE_PHYSICS_BENCHMARK_GRID_SPACING;
+
+  transform = CRUDE_COMPOUNT_EMPTY( crude_transform );
+  transform.rotation = XMFLOAT4{ 0.f, 0.f, 0.f, 1.f };
+  transform.scale = XMFLOAT3{ 1.f, 1.f, 1.f };
+
+  mesh_shape_handle.index = -1;
+  if ( options->mesh_relative_filepath )
+  {
+    mesh_shape_handle = crude_physics_shapes_manager_get_mesh_shape_handle( physics_shapes_manager, options->mesh_relative_filepath );
+  }
+
+  /* Ground */
+  {
+    crude_physics_static_body                              static_body;
+
+    static_body = crude_physics_static_body_empty( );
+    static_body.type = CRUDE_PHYSICS_BODY_SHAPE_TYPE_BOX;
+    static_body.box.extent = XMFLOAT3{ grid_half_size + CRUDE_PHYSICS_BENCHMARK_GRID_SPACING, 1.f, grid_half_size + CRUDE_PHYSICS_BENCHMARK_GRID_SPACING };
+    static_body.layers = g_crude_jph_static | g_crude_jph_layer_custom0 | g_crude_jph_mask_custom0;
+
+    transform.translation = XMFLOAT3{ 0.f, -1.f, 0.f };
+    entity = crude_entity_create_empty_without_name( world );
+    crude_entity_set_component( world, entity, ecs_id( crude_transform ), sizeof( crude_transform ), &transform );
+    crude_entity_set_component( world, entity, ecs_id( crude_physics_static_body ), sizeof( crude_physics_static_body ), &static_body );
+  }
+
+  for ( uint32 i = 0; i < options->static_bodies_count; ++i )
+  {
+    crude_physics_static_body                              static_body;
+    bool                                                   area;
+
+    area = ( i % 4 ) == 3;
+
+    static_body = crude_physics_static_body_empty( );
+    if ( mesh_shape_handle.index != -1 && !area )
+    {
+      static_body.type = CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH;
+      static_body.mesh.handle = mesh_shape_handle;
+    }
+    else
+    {
+      static_body.type = CRUDE_PHYSICS_BODY_SHAPE_TYPE_BOX;
+      static_body.box.extent = XMFLOAT3{ 0.5f, 0.5f, 0.5f };
+    }
+    static_body.layers = area ? ( g_crude_jph_layer_custom1 | g_crude_jph_mask_custom1 ) : ( g_crude_jph_static | g_crude_jph_layer_custom0 | g_crude_jph_mask_custom0 );
+
+    transform.translation = XMFLOAT3{ ( i % grid_side ) * CRUDE_PHYSICS_BENCHMARK_GRID_SPACING - grid_half_size, 0.5f, ( i / grid_side ) * CRUDE_PHYSICS_BENCHMARK_GRID_SPACING - grid_half_size };
+    entity = crude_entity_create_empty_without_name( world );
+    crude_entity_set_component( world, entity, ecs_id( crude_transform ), sizeof( crude_transform ), &transform );
+    crude_entity_set_component( world, entity, ecs_id( crude_physics_static_body ), sizeof( crude_physics_static_body ), &static_body );
+  }
+
+  for ( uint32 i = 0; i < options->kinematic_bodies_count; ++i )
+  {
+    crude_physics_kinematic_body                           kinematic_body;
+
+    kinematic_body = crude_physics_kinematic_body_empty( );
+    kinematic_body.type = CRUDE_PHYSICS_BODY_SHAPE_TYPE_BOX;
+    kinematic_body.box.extent = XMFLOAT3{ 0.5f, 0.5f, 0.5f };
+    kinematic_body.layers = g_crude_jph_layer_custom1 | g_crude_jph_mask_custom1;
+    kinematic_body.sensor = true;
+
+    transform.translation = XMFLOAT3{ crude_physics_benchmark_random_( -grid_half_size, grid_half_size ), 0.5f, crude_physics_benchmark_random_( -grid_half_size, grid_half_size ) };
+    entity = crude_entity_create_empty_without_name( world );
+    crude_entity_set_component( world, entity, ecs_id( crude_transform ), sizeof( crude_transform ), &transform );
+    crude_entity_set_component( world, entity, ecs_id( crude_physics_kinematic_body ), sizeof( crude_physics_kinematic_body ), &kinematic_body );
+  }
+
+  for ( uint32 i = 0; i < options->characters_count; ++i )
+  {
+    crude_physics_character                                character;
+
+    character = crude_physics_character_empty( );
+    character.layers = g_crude_jph_dynamic | g_crude_jph_layer_custom0 | g_crude_jph_mask_custom0;
+    character.virtual_character = options->virtual_characters;
+
+    transform.translation = XMFLOAT3{ crude_physics_benchmark_random_( -grid_half_size, grid_half_size ), 2.f, crude_physics_benchmark_random_( -grid_half_size, grid_half_size ) };
+    entity = crude_entity_create_empty_without_name( world );
+    crude_entity_set_component( world, entity, ecs_id( crude_transform ), sizeof( crude_transform ), &transform );
+    crude_entity_set_component( world, entity, ecs_id( crude_physics_character ), sizeof( crude_physics_character ), &character );
+  }
+}
+
+/* Kinematic bodies move on circles through the transform, characters change direction every second */
+void
+crude_physics_benchmark_move_
+(
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics                                      *physics,
+  _In_ uint32                                              frame_index
+)
+{
+  ecs_iter_t                                               it;
+  float32                                                  time;
+
+  time = frame_index * physics->step_delta_time;
+
+  it = ecs_each_id( world, ecs_id( crude_physics_kinematic_body_handle ) );
+  while ( ecs_each_next( &it ) )
+  {
+    crude_physics_kinematic_body_handle                   *kinematic_body_handle_per_entity;
+
+    kinematic_body_handle_per_entity = ecs_field( &it, crude_physics_kinematic_body_handle, 0 );
+    for ( uint32 i = 0; i < it.count; ++i )
+    {
+      crude_physics_kinematic_body_container              *kinematic_body_container;
+      crude_transform                                     *transform;
+      float32                                              angle;
+
+      kinematic_body_container = crude_physics_access_kinematic_body( physics, kinematic_body_handle_per_entity[ i ] );
+      if ( !kinematic_body_container->contact_added_callback )
+      {
+        kinematic_body_container->contact_added_callback = crude_physics_benchmark_contact_added_callback_;
+      }
+
+      transform = CRUDE_ENTITY_GET_MUTABLE_COMPONENT( world, it.entities[ i ], crude_transform );
+      angle = time + 0.1f * kinematic_body_handle_per_entity[ i ].index;
+      transform->translation.x += CRUDE_PHYSICS_BENCHMARK_GRID_SPACING * physics->step_delta_time * cosf( angle );
+      transform->translation.z += CRUDE_PHYSICS_BENCHMARK_GRID_SPACING * physics->step_delta_time * sinf( angle );
+    }
+  }
+
+  if ( frame_index % 60 )
+  {
+    return;
+  }
+
+  it = ecs_each_id( world, ecs_id( crude_physics_character_handle ) );
+  while ( ecs_each_next( &it ) )
+  {
+    crude_physics_character_handle                        *character_handle_per_entity;
+
+    character_handle_per_entity = ecs_field( &it, crude_physics_character_handle, 0 );
+    for ( uint32 i = 0; i < it.count; ++i )
+    {
+      crude_physics_character_container                   *character_container;
+      XMVECTOR                                             velocity;
+
+      character_container = crude_physics_access_character( physics, character_handle_per_entity[ i ] );
+      velocity = crude_physics_character_get_linear_velocity( character_container );
+      velocity = XMVectorSetX( velocity, crude_physics_benchmark_random_( -3.f, 3.f ) );
+      velocity = XMVectorSetZ( velocity, crude_physics_benchmark_random_( -3.f, 3.f ) );
+      crude_physics_character_set_linear_velocity( character_container, velocity );
+    }
+  }
+}
+
+void
+crude_physics_benchmark_report_
+(
+  _In_ crude_physics_benchmark_frame const                *frames,
+  _In_ uint32                                              frames_count,
+  _In_ crude_physics const                                *physics,
+  _In_ crude_heap_allocator const                         *physics_allocator,
+  _In_ int64                                               physics_allocator_peak_occupied,
+  _In_ crude_physics_benchmark_options const              *options,
+  _In_ crude_heap_allocator                               *allocator
+)
+{
+  float32                                                 *sorted_steps_times;
+  float32                                                 *sorted_frames_times;
+  FILE                                                    *file;
+  float64                                                  average_step_time;
+  uint32                                                   max_active_bodies_count, max_contacts_count, update_errors;
+
+  average_step_time = 0.0;
+  max_active_bodies_count = max_contacts_count = update_errors = 0u;
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( sorted_steps_times, frames_count, crude_heap_allocator_pack( allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( sorted_frames_times, frames_count, crude_heap_allocator_pack( allocator ) );
+  for ( uint32 i = 0; i < frames_count; ++i )
+  {
+    sorted_steps_times[ i ] = frames[ i ].telemetry.max_step_time;
+    sorted_frames_times[ i ] = frames[ i ].frame_time;
+    average_step_time += frames[ i ].telemetry.max_step_time;
+    max_active_bodies_count = CRUDE_MAX( max_active_bodies_count, frames[ i ].telemetry.active_bodies_count );
+    max_contacts_count = CRUDE_MAX( max_contacts_count, frames[ i ].telemetry.contacts_count );
+    update_errors |= frames[ i ].telemetry.update_errors;
+  }
+  average_step_time /= frames_count;
+  qsort( sorted_steps_times, frames_count, sizeof( float32 ), crude_physics_benchmark_compare_time_ );
+  qsort( sorted_frames_times, frames_count, sizeof( float32 ), crude_physics_benchmark_compare_time_ );
+
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_PHYSICS, "Step time ms: avg %.3f p50 %.3f p95 %.3f p99 %.3f max %.3f",
+    average_step_time,
+    sorted_steps_times[ frames_count / 2 ],
+    sorted_steps_times[ ( frames_count * 95 ) / 100 ],
+    sorted_steps_times[ ( frames_count * 99 ) / 100 ],
+    sorted_steps_times[ frames_count - 1 ] );
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_PHYSICS, "Frame time ms (step, contact events and ECS sync): p50 %.3f p95 %.3f p99 %.3f max %.3f",
+    sorted_frames_times[ frames_count / 2 ],
+    sorted_frames_times[ ( frames_count * 95 ) / 100 ],
+    sorted_frames_times[ ( frames_count * 99 ) / 100 ],
+    sorted_frames_times[ frames_count - 1 ] );
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_PHYSICS, "Bodies %u / %u, max active %u, max contacts %u / %u, update errors 0x%x",
+    frames[ frames_count - 1 ].telemetry.bodies_count, physics->max_bodies, max_active_bodies_count, max_contacts_count, physics->max_contact_constraints, update_errors );
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_PHYSICS, "Physics memory MB: occupied %.3f peak %.3f",
+    physics_allocator->occupied / ( 1024.f * 1024.f ), physics_allocator_peak_occupied / ( 1024.f * 1024.f ) );
+
+  CRUDE_ARRAY_DEINITIALIZE( sorted_steps_times );
+  CRUDE_ARRAY_DEINITIALIZE( sorted_frames_times );
+
+  if ( !options->csv_absolute_filepath )
+  {
+    return;
+  }
+
+  file = fopen( options->csv_absolute_filepath, "w" );
+  if ( !file )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_PHYSICS, "Cannot write physics benchmark to \"%s\"", options->csv_absolute_filepath );
+    return;
+  }
+
+  fprintf( file, "frame,frame_ms,step_ms,contact_events_dispatch_ms,active_bodies,contacts,contact_events\n" );
+  for ( uint32 i = 0; i < frames_count; ++i )
+  {
+    fprintf( file, "%u,%.4f,%.4f,%.4f,%u,%u,%u\n", i, frames[ i ].frame_time, frames[ i ].telemetry.max_step_time, frames[ i ].telemetry.contact_events_dispatch_time,
+      frames[ i ].telemetry.active_bodies_count, frames[ i ].telemetry.contacts_count, frames[ i ].telemetry.contact_events_count );
+  }
+  fclose( file );
+}
+
+void
+crude_physics_benchmark_contact_added_callback_
+(
+  _In_ crude_entity                                        signal_entity,
+  _In_ crude_entity                                        hitted_entity
+)
+{
+}
+
+int
+crude_physics_benchmark_compare_time_
+(
+  _In_ void const                                         *a,
+  _In_ void const                                         *b
+)
+{
+  float32 time_a = *CRUDE_CAST( float32 const*, a );
+  float32 time_b = *CRUDE_CAST( float32 const*, b );
+  return ( time_a > time_b ) - ( time_a < time_b );
+}
+
+/* Same sequence every run, so results are comparable */
+float32
+crude_physics_benchmark_random_
+(
+  _In_ float32                                             min,
+  _In_ float32                                             max
+)
+{
+  static uint32                                            state = 0x9E3779B9u;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return min + ( max - min ) * ( state / CRUDE_CAST( float32, UINT32_MAX ) );
+}
@@ -1,3 +1,16 @@
 #pragma once
 
-#define CRUDE_AUDIO_RELATIVE_FILEPATH_LENGTH_MAX           1024
\ No newline at end of file
+#define CRUDE_AUDIO_RELATIVE_FILEPATH_LENGTH_MAX           1024
+#define CRUDE_AUDIO_SOUNDS_MAX                             512
+#define CRUDE_AUDIO_SOUNDS_DATA_MAX                        256
+// Default, environment "audio" section overrides it. Cached files without sounds are evicted once the cache is above it
+#define CRUDE_AUDIO_SOUND_CACHE_BUDGET                     ( 64u * 1024u * 1024u )
+// Default, environment "audio" section overrides it. Only this many sounds are mixed, the rest play virtually
+#define CRUDE_AUDIO_REAL_VOICES_MAX                        32
+// Voices quieter than this are virtual even when real voices are free
+#define CRUDE_AUDIO_VOICE_AUDIBILITY_MIN                   0.001f
+// Real voice keeps its slot till a virtual one is that many times louder, so voices near the cut don't flip every frame
+#define CRUDE_AUDIO_VOICE_REAL_HYSTERESIS                  1.25f
+#define CRUDE_AUDIO_VOICE_FADE_IN_MILLISECONDS             20
+// Power of two. Game thread publishes at most one command per sound and listener each frame, full ring keeps them for the next frame
+#define CRUDE_AUDIO_COMMANDS_MAX                           1024
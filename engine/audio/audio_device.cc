@@ -1,7 +1,134 @@
+#include <atomic>
+
 #include <engine/core/log.h>
+#include <engine/core/profiler.h>
+#include <engine/core/array.h>
 
 #include <engine/audio/audio_device.h>
 
+static crude_sound_container*
+crude_audio_device_access_sound_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+);
+
+static crude_sound_data_handle
+crude_audio_device_obtain_sound_data_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_creation const                          *creation
+);
+
+static void
+crude_audio_device_release_sound_data_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_data_handle                              sound_data_handle
+);
+
+static void
+crude_audio_device_evict_sound_data_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_data_handle                              sound_data_handle
+);
+
+static crude_sound_data_handle
+crude_audio_device_find_least_recently_used_sound_data_
+(
+  _In_ crude_audio_device                                  *audio
+);
+
+static void
+crude_audio_device_update_sound_data_size_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_data_container                          *sound_data_container
+);
+
+static void
+crude_audio_device_add_voice_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+);
+
+static void
+crude_audio_device_remove_voice_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+);
+
+static void
+crude_audio_device_virtualize_voice_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+);
+
+static void
+crude_audio_device_devirtualize_voice_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+);
+
+static float32
+crude_audio_device_voice_audibility_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_container                               *sound_container
+);
+
+static int
+crude_audio_device_voice_compare_
+(
+  _In_ void const                                         *a,
+  _In_ void const                                         *b
+);
+
+static crude_audio_command*
+crude_audio_device_sound_pending_command_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+);
+
+static bool
+crude_audio_device_sound_commands_in_flight_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_container                               *sound_container
+);
+
+static bool
+crude_audio_device_voice_finished_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_container                               *sound_container
+);
+
+static void
+crude_audio_device_publish_commands_
+(
+  _In_ crude_audio_device                                  *audio
+);
+
+static void
+crude_audio_device_consume_commands_
+(
+  _In_ crude_audio_device                                  *audio
+);
+
+static void
+crude_audio_device_release_destroyed_sounds_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ bool                                                 force
+);
+
 static void
 crude_audio_device_data_callback
 (
@@ -12,6 +139,7 @@ crude_audio_device_data_callback
 )
 {
   crude_audio_device *audio = CRUDE_CAST( crude_audio_device*, lma_device->pUserData );
+  crude_audio_device_consume_commands_( audio );
   ma_engine_read_pcm_frames( &audio->lma_engine, output, frame_count, NULL );
 }
 
@@ -32,8 +160,28 @@ crude_audio_device_initialize
   audio->allocator = allocator;
   audio->resources_absolute_directory = resources_absolute_directory;
 
-  crude_resource_pool_initialize( &audio->sounds, crude_heap_allocator_pack( audio->allocator ), 512, sizeof( ma_sound ) );
+  crude_resource_pool_initialize( &audio->sounds, crude_heap_allocator_pack( audio->allocator ), CRUDE_AUDIO_SOUNDS_MAX, sizeof( crude_sound_container ) );
   crude_resource_pool_initialize( &audio->sounds_groups, crude_heap_allocator_pack( audio->allocator ), 512, sizeof( ma_sound_group ) );
+  crude_resource_pool_initialize( &audio->sounds_data, crude_heap_allocator_pack( audio->allocator ), CRUDE_AUDIO_SOUNDS_DATA_MAX, sizeof( crude_sound_data_container ) );
+  CRUDE_HASHMAPSTR_INITIALIZE( audio->relative_filepath_to_sound_data, crude_heap_allocator_pack( audio->allocator ) );
+  audio->sound_data_use_index = 0u;
+  audio->sound_cache_stats = CRUDE_COMPOUNT_EMPTY( crude_audio_sound_cache_stats );
+  audio->sound_cache_stats.memory_budget = CRUDE_AUDIO_SOUND_CACHE_BUDGET;
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( audio->voices, CRUDE_AUDIO_SOUNDS_MAX, crude_heap_allocator_pack( audio->allocator ) );
+  audio->voices_stats = CRUDE_COMPOUNT_EMPTY( crude_audio_voices_stats );
+  audio->voices_stats.real_voices_max = CRUDE_AUDIO_REAL_VOICES_MAX;
+
+  audio->commands = CRUDE_CAST( crude_audio_command*, CRUDE_ALLOCATE( crude_heap_allocator_pack( audio->allocator ), CRUDE_AUDIO_COMMANDS_MAX * sizeof( crude_audio_command ) ) );
+  audio->commands_write_index = 0u;
+  std::atomic_ref< uint32 >( audio->commands_published_write_index ).store( 0u, std::memory_order_relaxed );
+  std::atomic_ref< uint32 >( audio->commands_read_index ).store( 0u, std::memory_order_relaxed );
+  audio->commands_batch_index = 1u;
+  std::atomic_ref< uint64 >( audio->commands_consumed_batch_index ).store( 0u, std::memory_order_relaxed );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( audio->commands_dirty_sounds, CRUDE_AUDIO_SOUNDS_MAX, crude_heap_allocator_pack( audio->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( audio->sounds_to_release, 16, crude_heap_allocator_pack( audio->allocator ) );
+  audio->listener_pending_command = CRUDE_COMPOUNT_EMPTY( crude_audio_command );
+  audio->listener_pending_command.sound_handle = CRUDE_SOUND_HANDLE_INVALID;
+  audio->listener_position = CRUDE_COMPOUNT( XMFLOAT3, { 0, 0, 0 } );
 
   if ( ma_context_init( NULL, 0, NULL, &audio->lma_context ) != MA_SUCCESS )
   {
@@ -95,15 +243,107 @@ crude_audio_device_deinitialize
   _In_ crude_audio_device                                  *audio
 )
 {
+  /* Mixer is stopped, commands left in the ring are never applied */
+  ma_device_stop( &audio->lma_device );
+  crude_audio_device_release_destroyed_sounds_( audio, true );
+
+  for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( audio->relative_filepath_to_sound_data ); ++i )
+  {
+    if ( crude_hashmapstr_backet_key_hash_valid( audio->relative_filepath_to_sound_data[ i ].key.key_hash ) )
+    {
+      crude_sound_data_container *sound_data_container = crude_audio_device_access_sound_data( audio, audio->relative_filepath_to_sound_data[ i ].value );
+      ma_resource_manager_data_source_uninit( &sound_data_container->lma_data_source );
+    }
+  }
+
   ma_fence_uninit( &audio->lma_fence );
   ma_engine_uninit( &audio->lma_engine );
   ma_device_uninit( &audio->lma_device );
   ma_context_uninit( &audio->lma_context );
   crude_resource_pool_deinitialize( &audio->sounds );
   crude_resource_pool_deinitialize( &audio->sounds_groups );
+  crude_resource_pool_deinitialize( &audio->sounds_data );
+  CRUDE_HASHMAPSTR_DEINITIALIZE( audio->relative_filepath_to_sound_data );
+  CRUDE_ARRAY_DEINITIALIZE( audio->voices );
+  CRUDE_ARRAY_DEINITIALIZE( audio->commands_dirty_sounds );
+  CRUDE_ARRAY_DEINITIALIZE( audio->sounds_to_release );
+  CRUDE_DEALLOCATE( crude_heap_allocator_pack( audio->allocator ), audio->commands );
   crude_string_buffer_deinitialize( &audio->absolute_filepath_string_buffer ); 
 }
 
+void
+crude_audio_device_update
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ float32                                              delta_time
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_audio_device_update" );
+  audio->voices_stats.virtualized_count = 0u;
+  audio->voices_stats.devirtualized_count = 0u;
+  audio->voices_stats.finished_count = 0u;
+
+  for ( int32 i = CRUDE_ARRAY_LENGTH( audio->voices ) - 1; i >= 0; --i )
+  {
+    crude_sound_container                                 *sound_container;
+
+    sound_container = crude_audio_device_access_sound_( audio, audio->voices[ i ].sound_handle );
+
+    if ( sound_container->virtual_voice )
+    {
+      sound_container->virtual_cursor_time += delta_time;
+      if ( sound_container->length_time > 0.0 && sound_container->virtual_cursor_time >= sound_container->length_time && ma_sound_is_looping( &sound_container->lma_sound ) )
+      {
+        sound_container->virtual_cursor_time = fmod( sound_container->virtual_cursor_time, sound_container->length_time );
+      }
+    }
+
+    if ( crude_audio_device_voice_finished_( audio, sound_container ) )
+    {
+      ++audio->voices_stats.finished_count;
+      crude_audio_device_remove_voice_( audio, audio->voices[ i ].sound_handle );
+      continue;
+    }
+
+    audio->voices[ i ].audibility = crude_audio_device_voice_audibility_( audio, sound_container );
+    audio->voices[ i ].score = sound_container->virtual_voice ? audio->voices[ i ].audibility : audio->voices[ i ].audibility * CRUDE_AUDIO_VOICE_REAL_HYSTERESIS;
+  }
+
+  qsort( audio->voices, CRUDE_ARRAY_LENGTH( audio->voices ), sizeof( crude_audio_voice ), crude_audio_device_voice_compare_ );
+  
+  /* Virtualize first, so there are free real voices for the louder ones */
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( audio->voices ); ++i )
+  {
+    crude_sound_container                                 *sound_container;
+
+    sound_container = crude_audio_device_access_sound_( audio, audio->voices[ i ].sound_handle );
+    sound_container->voice_index = i;
+    if ( !sound_container->virtual_voice && ( i >= audio->voices_stats.real_voices_max || audio->voices[ i ].audibility < CRUDE_AUDIO_VOICE_AUDIBILITY_MIN ) )
+    {
+      crude_audio_device_virtualize_voice_( audio, audio->voices[ i ].sound_handle );
+      ++audio->voices_stats.virtualized_count;
+    }
+  }
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( audio->voices ) && i < audio->voices_stats.real_voices_max; ++i )
+  {
+    crude_sound_container                                 *sound_container;
+
+    sound_container = crude_audio_device_access_sound_( audio, audio->voices[ i ].sound_handle );
+    if ( sound_container->virtual_voice && audio->voices[ i ].audibility >= CRUDE_AUDIO_VOICE_AUDIBILITY_MIN )
+    {
+      crude_audio_device_devirtualize_voice_( audio, audio->voices[ i ].sound_handle );
+      ++audio->voices_stats.devirtualized_count;
+    }
+  }
+
+  audio->voices_stats.voices_count = CRUDE_ARRAY_LENGTH( audio->voices );
+
+  crude_audio_device_publish_commands_( audio );
+  crude_audio_device_release_destroyed_sounds_( audio, false );
+  CRUDE_PROFILER_ZONE_END;
+}
+
 void
 crude_audio_device_wait_wait_till_uploaded
 (
@@ -143,7 +383,7 @@ crude_audio_device_destroy_sound_group
 )
 {
   ma_sound_group                                          *lma_sound_group;
-  lma_sound_group = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_group_handle.index ) );
+  lma_sound_group = CRUDE_CAST( ma_sound_group*, crude_resource_pool_access_resource( &audio->sounds_groups, sound_group_handle.index ) );
   ma_sound_group_uninit( lma_sound_group );
   crude_resource_pool_release_resource(  &audio->sounds_groups, sound_group_handle.index );
 }
@@ -156,7 +396,7 @@ crude_audio_device_start_sound_group
 )
 {
   ma_sound_group                                          *lma_sound_group;
-  lma_sound_group = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_group_handle.index ) );
+  lma_sound_group = CRUDE_CAST( ma_sound_group*, crude_resource_pool_access_resource( &audio->sounds_groups, sound_group_handle.index ) );
   ma_sound_group_start( lma_sound_group );
 }
 
@@ -168,7 +408,7 @@ crude_audio_device_stop_sound_group
 )
 {
   ma_sound_group                                          *lma_sound_group;
-  lma_sound_group = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_group_handle.index ) );
+  lma_sound_group = CRUDE_CAST( ma_sound_group*, crude_resource_pool_access_resource( &audio->sounds_groups, sound_group_handle.index ) );
   ma_sound_group_stop( lma_sound_group );
 }
 
@@ -181,7 +421,7 @@ crude_audio_device_sound_group_set_volume
 )
 {
   ma_sound_group                                          *lma_sound_group;
-  lma_sound_group = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_group_handle.index ) );
+  lma_sound_group = CRUDE_CAST( ma_sound_group*, crude_resource_pool_access_resource( &audio->sounds_groups, sound_group_handle.index ) );
   ma_sound_group_set_volume( lma_sound_group, volume );
 }
 
@@ -192,6 +432,8 @@ crude_audio_device_create_sound
   _In_ crude_sound_creation const                          *creation
 )
 {
+  crude_sound_container                                   *sound_container;
+  crude_sound_data_container                              *sound_data_container;
   ma_sound                                                *lma_sound;
   char const                                              *absolute_filepath;
   crude_sound_handle                                       sound_handle;
@@ -199,35 +441,77 @@ crude_audio_device_create_sound
   ma_uint32                                                sounnd_flags;
 
   sound_handle.index = crude_resource_pool_obtain_resource( &audio->sounds );
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  sound_container->data_handle = CRUDE_SOUND_DATA_HANDLE_INVALID;
+  sound_container->priority = creation->priority;
+  sound_container->voice_index = CRUDE_AUDIO_VOICE_INDEX_INVALID;
+  sound_container->virtual_voice = false;
+  sound_container->virtual_cursor_time = 0.0;
+  sound_container->length_time = 0.0;
+  sound_container->position = CRUDE_COMPOUNT( XMFLOAT3, { 0, 0, 0 } );
+  sound_container->volume = 1.f;
+  sound_container->pending_command = CRUDE_COMPOUNT_EMPTY( crude_audio_command );
+  sound_container->pending_command.sound_handle = sound_handle;
+  sound_container->last_command_batch_index = 0u;
+  lma_sound = &sound_container->lma_sound;
 
-  sounnd_flags = MA_SOUND_FLAG_NO_PITCH;
-  if ( creation->decode )
-  {
-    sounnd_flags |= MA_SOUND_FLAG_DECODE;
-  }
-  if ( creation->async_loading )
-  {
-    sounnd_flags |= MA_SOUND_FLAG_ASYNC;
-  }
+  /* Streams decode a small window on their own, there is nothing to share */
   if ( creation->stream )
   {
-    sounnd_flags |= MA_SOUND_FLAG_STREAM;
-  }
-
-  if ( creation->looping )
-  {
-    sounnd_flags |= MA_SOUND_FLAG_LOOPING;
-  }
+    sounnd_flags = MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_STREAM;
+    if ( creation->decode )
+    {
+      sounnd_flags |= MA_SOUND_FLAG_DECODE;
+    }
+    if ( creation->async_loading )
+    {
+      sounnd_flags |= MA_SOUND_FLAG_ASYNC;
+    }
+    if ( creation->looping )
+    {
+      sounnd_flags |= MA_SOUND_FLAG_LOOPING;
+    }
   
-  crude_string_buffer_clear( &audio->absolute_filepath_string_buffer ); 
-  absolute_filepath = crude_string_buffer_append_use_f( &audio->absolute_filepath_string_buffer, "%s%s", audio->resources_absolute_directory, creation->relative_filepath );
+    crude_string_buffer_clear( &audio->absolute_filepath_string_buffer ); 
+    absolute_filepath = crude_string_buffer_append_use_f( &audio->absolute_filepath_string_buffer, "%s%s", audio->resources_absolute_directory, creation->relative_filepath );
 
-  result = ma_sound_init_from_file( &audio->lma_engine, absolute_filepath, sounnd_flags, NULL, creation->async_loading ? &audio->lma_fence : NULL, lma_sound );
-  if ( result != MA_SUCCESS )
+    result = ma_sound_init_from_file( &audio->lma_engine, absolute_filepath, sounnd_flags, NULL, creation->async_loading ? &audio->lma_fence : NULL, lma_sound );
+    if ( result != MA_SUCCESS )
+    {
+      CRUDE_LOG_ERROR( CRUDE_CHANNEL_AUDIO, "Failed load sound \"%s\"", absolute_filepath );
+      crude_resource_pool_release_resource( &audio->sounds, sound_handle.index );
+      return CRUDE_SOUND_HANDLE_INVALID;
+    }
+  }
+  else
   {
-    CRUDE_LOG_ERROR( CRUDE_CHANNEL_AUDIO, "Failed load sound \"%s\"", absolute_filepath );
-    return CRUDE_SOUND_HANDLE_INVALID;
+    sound_container->data_handle = crude_audio_device_obtain_sound_data_( audio, creation );
+    if ( sound_container->data_handle.index == CRUDE_RESOURCE_INDEX_INVALID )
+    {
+      crude_resource_pool_release_resource( &audio->sounds, sound_handle.index );
+      return CRUDE_SOUND_HANDLE_INVALID;
+    }
+
+    sound_data_container = crude_audio_device_access_sound_data( audio, sound_container->data_handle );
+    result = ma_resource_manager_data_source_init_copy( ma_engine_get_resource_manager( &audio->lma_engine ), &sound_data_container->lma_data_source, &sound_container->lma_data_source );
+    if ( result == MA_SUCCESS )
+    {
+      result = ma_sound_init_from_data_source( &audio->lma_engine, &sound_container->lma_data_source, MA_SOUND_FLAG_NO_PITCH, NULL, lma_sound );
+      if ( result != MA_SUCCESS )
+      {
+        ma_resource_manager_data_source_uninit( &sound_container->lma_data_source );
+      }
+    }
+
+    if ( result != MA_SUCCESS )
+    {
+      CRUDE_LOG_ERROR( CRUDE_CHANNEL_AUDIO, "Failed create sound \"%s\"", creation->relative_filepath );
+      crude_audio_device_release_sound_data_( audio, sound_container->data_handle );
+      crude_resource_pool_release_resource( &audio->sounds, sound_handle.index );
+      return CRUDE_SOUND_HANDLE_INVALID;
+    }
+
+    ma_sound_set_looping( lma_sound, creation->looping );
   }
 
   ma_sound_set_positioning( lma_sound, CRUDE_CAST( ma_positioning, creation->positioning ) );
@@ -258,10 +542,10 @@ crude_audio_device_destroy_sound
   _In_ crude_sound_handle                                   sound_handle
 )
 {
-  ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
-  ma_sound_uninit( lma_sound );
-  crude_resource_pool_release_resource(  &audio->sounds, sound_handle.index );
+  crude_audio_device_sound_stop( audio, sound_handle );
+
+  /* Mixer could still have commands for the sound, it's uninitialized once they are consumed */
+  CRUDE_ARRAY_PUSH( audio->sounds_to_release, sound_handle );
 }
 
 void
@@ -271,9 +555,50 @@ crude_audio_device_sound_start
   _In_ crude_sound_handle                                   sound_handle
 )
 { 
-  ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
-  ma_sound_start( lma_sound );
+  crude_sound_container                                   *sound_container;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  if ( sound_container->voice_index != CRUDE_AUDIO_VOICE_INDEX_INVALID )
+  {
+    /* A one shot which ended before the update removed its voice is restarted in place, not dropped */
+    if ( crude_audio_device_voice_finished_( audio, sound_container ) )
+    {
+      if ( sound_container->virtual_voice )
+      {
+        sound_container->virtual_cursor_time = 0.0;
+      }
+      else
+      {
+        crude_audio_command                               *pending_command;
+
+        /* ma_sound_start rewinds a sound that is at its end */
+        pending_command = crude_audio_device_sound_pending_command_( audio, sound_handle );
+        pending_command->flags = ( pending_command->flags & ~CRUDE_AUDIO_COMMAND_FLAGS_STOP ) | CRUDE_AUDIO_COMMAND_FLAGS_START;
+      }
+    }
+    return;
+  }
+
+  crude_audio_device_add_voice_( audio, sound_handle );
+
+  /* Over the limit the voice starts virtual, next update decides if it's loud enough to take a real one */
+  if ( audio->voices_stats.real_voices_count < audio->voices_stats.real_voices_max )
+  {
+    crude_audio_command                                   *pending_command;
+
+    pending_command = crude_audio_device_sound_pending_command_( audio, sound_handle );
+    pending_command->flags = ( pending_command->flags & ~CRUDE_AUDIO_COMMAND_FLAGS_STOP ) | CRUDE_AUDIO_COMMAND_FLAGS_START;
+    ++audio->voices_stats.real_voices_count;
+  }
+  else
+  {
+    sound_container->virtual_voice = true;
+    crude_audio_device_virtualize_voice_( audio, sound_handle );
+    if ( ma_sound_at_end( &sound_container->lma_sound ) )
+    {
+      sound_container->virtual_cursor_time = 0.0;
+    }
+  }
 }
 
 void
@@ -283,9 +608,14 @@ crude_audio_device_sound_reset
   _In_ crude_sound_handle                                   sound_handle
 )
 {
-  ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
-  ma_sound_seek_to_pcm_frame( lma_sound, 0 );
+  crude_sound_container                                   *sound_container;
+  crude_audio_command                                     *pending_command;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  pending_command = crude_audio_device_sound_pending_command_( audio, sound_handle );
+  pending_command->flags |= CRUDE_AUDIO_COMMAND_FLAGS_SEEK;
+  pending_command->seek_time = 0.f;
+  sound_container->virtual_cursor_time = 0.0;
 }
 
 void
@@ -295,9 +625,28 @@ crude_audio_device_sound_stop
   _In_ crude_sound_handle                                   sound_handle
 )
 { 
-  ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
-  ma_sound_stop( lma_sound );
+  crude_sound_container                                   *sound_container;
+  crude_audio_command                                     *pending_command;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  if ( sound_container->voice_index == CRUDE_AUDIO_VOICE_INDEX_INVALID )
+  {
+    return;
+  }
+
+  pending_command = crude_audio_device_sound_pending_command_( audio, sound_handle );
+
+  /* Virtual voice is already stopped in miniaudio, keep the cursor where it was played virtually */
+  if ( sound_container->virtual_voice )
+  {
+    pending_command->flags |= CRUDE_AUDIO_COMMAND_FLAGS_SEEK;
+    pending_command->seek_time = sound_container->virtual_cursor_time;
+  }
+  else
+  {
+    pending_command->flags = ( pending_command->flags & ~CRUDE_AUDIO_COMMAND_FLAGS_START ) | CRUDE_AUDIO_COMMAND_FLAGS_STOP;
+  }
+  crude_audio_device_remove_voice_( audio, sound_handle );
 }
 
 bool
@@ -307,11 +656,28 @@ crude_audio_device_sound_is_playing
   _In_ crude_sound_handle                                   sound_handle
 )
 {
-  ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
-  return ma_sound_is_playing( lma_sound );
+  crude_sound_container                                   *sound_container;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  if ( sound_container->voice_index == CRUDE_AUDIO_VOICE_INDEX_INVALID )
+  {
+    return false;
+  }
+  return sound_container->virtual_voice || crude_audio_device_sound_commands_in_flight_( audio, sound_container ) || ma_sound_is_playing( &sound_container->lma_sound );
 }
 
+bool
+crude_audio_device_sound_is_virtual
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+)
+{
+  crude_sound_container                                   *sound_container;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  return sound_container->voice_index != CRUDE_AUDIO_VOICE_INDEX_INVALID && sound_container->virtual_voice;
+}
 
 void
 crude_audio_device_sound_set_translation
@@ -321,9 +687,14 @@ crude_audio_device_sound_set_translation
   _In_ XMVECTOR                                             translation
 )
 {
-  ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
-  ma_sound_set_position( lma_sound, XMVectorGetX( translation ), XMVectorGetY( translation ), XMVectorGetZ( translation ) );
+  crude_sound_container                                   *sound_container;
+  crude_audio_command                                     *pending_command;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  XMStoreFloat3( &sound_container->position, translation );
+  pending_command = crude_audio_device_sound_pending_command_( audio, sound_handle );
+  pending_command->flags |= CRUDE_AUDIO_COMMAND_FLAGS_POSITION;
+  pending_command->position = sound_container->position;
 }
 
 void
@@ -334,9 +705,12 @@ crude_audio_device_sound_set_volume
   _In_ float32                                              volume
 )
 {
-  ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
-  ma_sound_set_volume( lma_sound, volume );
+  crude_audio_command                                     *pending_command;
+
+  crude_audio_device_access_sound_( audio, sound_handle )->volume = volume;
+  pending_command = crude_audio_device_sound_pending_command_( audio, sound_handle );
+  pending_command->flags |= CRUDE_AUDIO_COMMAND_FLAGS_VOLUME;
+  pending_command->volume = volume;
 }
 
 float32
@@ -346,9 +720,7 @@ crude_audio_device_sound_get_volume
   _In_ crude_sound_handle                                   sound_handle
 )
 {
-  ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
-  return ma_sound_get_volume( lma_sound );
+  return crude_audio_device_access_sound_( audio, sound_handle )->volume;
 }
 
 void
@@ -360,7 +732,7 @@ crude_audio_device_sound_set_attenuation_model
 )
 {
   ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
+  lma_sound = &crude_audio_device_access_sound_( audio, sound_handle )->lma_sound;
   ma_sound_set_attenuation_model( lma_sound, CRUDE_CAST( ma_attenuation_model, attenuation_model ) );
 }
 
@@ -377,8 +749,10 @@ crude_audio_device_listener_set_local_to_world
   XMStoreFloat3( &translation, local_to_world.r[ 3 ] );
   XMStoreFloat3( &forward, XMVector3TransformNormal( XMVectorSet( 0, 0, -1, 0 ), local_to_world ) );
 
-  ma_engine_listener_set_position( &audio->lma_engine, 0, translation.x, translation.y, translation.z );
-  ma_engine_listener_set_direction( &audio->lma_engine, 0, forward.x, forward.y, forward.z );
+  audio->listener_position = translation;
+  audio->listener_pending_command.flags |= CRUDE_AUDIO_COMMAND_FLAGS_POSITION | CRUDE_AUDIO_COMMAND_FLAGS_DIRECTION;
+  audio->listener_pending_command.position = translation;
+  audio->listener_pending_command.direction = forward;
 }
 
 void
@@ -399,7 +773,7 @@ crude_audio_device_sound_get_looping
 )
 {
   ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
+  lma_sound = &crude_audio_device_access_sound_( audio, sound_handle )->lma_sound;
   return ma_sound_is_looping( lma_sound );
 }
 
@@ -411,6 +785,670 @@ crude_audio_device_sound_get_positiong
 )
 {
   ma_sound                                                *lma_sound;
-  lma_sound = CRUDE_CAST( ma_sound*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
+  lma_sound = &crude_audio_device_access_sound_( audio, sound_handle )->lma_sound;
   return CRUDE_CAST( crude_audio_sound_positioning, ma_sound_get_positioning( lma_sound ) );
-}
\ No newline at end of file
+}
+
+void
+crude_audio_device_set_sound_cache_budget
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ uint64                                               budget
+)
+{
+  audio->sound_cache_stats.memory_budget = budget;
+  crude_audio_device_trim_sound_cache( audio );
+}
+
+void
+crude_audio_device_trim_sound_cache
+(
+  _In_ crude_audio_device                                  *audio
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_audio_device_trim_sound_cache" );
+  for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( audio->relative_filepath_to_sound_data ); ++i )
+  {
+    if ( crude_hashmapstr_backet_key_hash_valid( audio->relative_filepath_to_sound_data[ i ].key.key_hash ) )
+    {
+      crude_audio_device_update_sound_data_size_( audio, crude_audio_device_access_sound_data( audio, audio->relative_filepath_to_sound_data[ i ].value ) );
+    }
+  }
+
+  while ( audio->sound_cache_stats.memory_used > audio->sound_cache_stats.memory_budget )
+  {
+    crude_sound_data_handle                                least_recently_used_handle;
+
+    least_recently_used_handle = crude_audio_device_find_least_recently_used_sound_data_( audio );
+
+    /* Everything left is played, the budget is exceeded till some sounds are destroyed */
+    if ( least_recently_used_handle.index == CRUDE_RESOURCE_INDEX_INVALID )
+    {
+      break;
+    }
+
+    crude_audio_device_evict_sound_data_( audio, least_recently_used_handle );
+  }
+  CRUDE_PROFILER_ZONE_END;
+}
+
+crude_audio_sound_cache_stats
+crude_audio_device_get_sound_cache_stats
+(
+  _In_ crude_audio_device                                  *audio
+)
+{
+  return audio->sound_cache_stats;
+}
+
+void
+crude_audio_device_set_real_voices_max
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ uint32                                               real_voices_max
+)
+{
+  audio->voices_stats.real_voices_max = real_voices_max;
+}
+
+crude_audio_voices_stats
+crude_audio_device_get_voices_stats
+(
+  _In_ crude_audio_device                                  *audio
+)
+{
+  return audio->voices_stats;
+}
+
+crude_sound_data_container*
+crude_audio_device_access_sound_data
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_data_handle                              sound_data_handle
+)
+{
+  return CRUDE_CAST( crude_sound_data_container*, crude_resource_pool_access_resource( &audio->sounds_data, sound_data_handle.index ) );
+}
+
+crude_sound_container*
+crude_audio_device_access_sound_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+)
+{
+  return CRUDE_CAST( crude_sound_container*, crude_resource_pool_access_resource( &audio->sounds, sound_handle.index ) );
+}
+
+crude_sound_data_handle
+crude_audio_device_obtain_sound_data_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_creation const                          *creation
+)
+{
+  ma_resource_manager_pipeline_notifications               lma_notifications;
+  crude_sound_data_container                              *sound_data_container;
+  char const                                              *absolute_filepath;
+  crude_sound_data_handle                                  sound_data_handle;
+  int64                                                    handle_index;
+  ma_result                                                result;
+  ma_uint32                                                data_source_flags;
+  
+  handle_index = CRUDE_HASHMAPSTR_GET_INDEX( audio->relative_filepath_to_sound_data, creation->relative_filepath );
+  if ( handle_index != -1 )
+  {
+    sound_data_handle = audio->relative_filepath_to_sound_data[ handle_index ].value;
+    sound_data_container = crude_audio_device_access_sound_data( audio, sound_data_handle );
+    ++audio->sound_cache_stats.hits;
+  }
+  else
+  {
+    sound_data_handle.index = crude_resource_pool_obtain_resource( &audio->sounds_data );
+    if ( sound_data_handle.index == CRUDE_RESOURCE_INDEX_INVALID )
+    {
+      crude_sound_data_handle                              least_recently_used_handle;
+
+      /* Pool is full of cached files, the least recently used one nobody plays gives its slot */
+      least_recently_used_handle = crude_audio_device_find_least_recently_used_sound_data_( audio );
+      if ( least_recently_used_handle.index == CRUDE_RESOURCE_INDEX_INVALID )
+      {
+        CRUDE_LOG_ERROR( CRUDE_CHANNEL_AUDIO, "Sound cache is full of played files, can't load \"%s\". Increase CRUDE_AUDIO_SOUNDS_DATA_MAX", creation->relative_filepath );
+        return CRUDE_SOUND_DATA_HANDLE_INVALID;
+      }
+
+      crude_audio_device_evict_sound_data_( audio, least_recently_used_handle );
+      sound_data_handle.index = crude_resource_pool_obtain_resource( &audio->sounds_data );
+      CRUDE_ASSERT( sound_data_handle.index != CRUDE_RESOURCE_INDEX_INVALID );
+    }
+
+    sound_data_container = crude_audio_device_access_sound_data( audio, sound_data_handle );
+    crude_string_copy( sound_data_container->relative_filepath, creation->relative_filepath, sizeof( sound_data_container->relative_filepath ) );
+    sound_data_container->size = 0u;
+    sound_data_container->references_count = 0u;
+
+    data_source_flags = 0u;
+    if ( creation->decode )
+    {
+      data_source_flags |= MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE;
+    }
+
+    lma_notifications = ma_resource_manager_pipeline_notifications_init( );
+    if ( creation->async_loading )
+    {
+      data_source_flags |= MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC;
+      lma_notifications.done.pFence = &audio->lma_fence;
+    }
+    
+    crude_string_buffer_clear( &audio->absolute_filepath_string_buffer ); 
+    absolute_filepath = crude_string_buffer_append_use_f( &audio->absolute_filepath_string_buffer, "%s%s", audio->resources_absolute_directory, creation->relative_filepath );
+
+    result = ma_resource_manager_data_source_init( ma_engine_get_resource_manager( &audio->lma_engine ), absolute_filepath, data_source_flags, &lma_notifications, &sound_data_container->lma_data_source );
+    if ( result != MA_SUCCESS )
+    {
+      CRUDE_LOG_ERROR( CRUDE_CHANNEL_AUDIO, "Failed load sound \"%s\"", absolute_filepath );
+      crude_resource_pool_release_resource( &audio->sounds_data, sound_data_handle.index );
+      return CRUDE_SOUND_DATA_HANDLE_INVALID;
+    }
+
+    CRUDE_HASHMAPSTR_SET( audio->relative_filepath_to_sound_data, CRUDE_COMPOUNT( crude_string_link, { sound_data_container->relative_filepath } ), sound_data_handle );
+    ++audio->sound_cache_stats.entries_count;
+    ++audio->sound_cache_stats.misses;
+    crude_audio_device_update_sound_data_size_( audio, sound_data_container );
+  }
+
+  if ( sound_data_container->references_count++ == 0u )
+  {
+    ++audio->sound_cache_stats.referenced_entries_count;
+  }
+  sound_data_container->last_use_index = ++audio->sound_data_use_index;
+
+  if ( handle_index == -1 )
+  {
+    crude_audio_device_trim_sound_cache( audio );
+  }
+  return sound_data_handle;
+}
+
+void
+crude_audio_device_release_sound_data_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_data_handle                              sound_data_handle
+)
+{
+  crude_sound_data_container                              *sound_data_container;
+
+  sound_data_container = crude_audio_device_access_sound_data( audio, sound_data_handle );
+  CRUDE_ASSERT( sound_data_container->references_count );
+  if ( --sound_data_container->references_count == 0u )
+  {
+    --audio->sound_cache_stats.referenced_entries_count;
+    sound_data_container->last_use_index = ++audio->sound_data_use_index;
+    crude_audio_device_trim_sound_cache( audio );
+  }
+}
+
+void
+crude_audio_device_evict_sound_data_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_data_handle                              sound_data_handle
+)
+{
+  crude_sound_data_container                              *sound_data_container;
+
+  sound_data_container = crude_audio_device_access_sound_data( audio, sound_data_handle );
+  CRUDE_ASSERT( sound_data_container->references_count == 0u );
+
+  ma_resource_manager_data_source_uninit( &sound_data_container->lma_data_source );
+  CRUDE_HASHMAPSTR_REMOVE( audio->relative_filepath_to_sound_data, sound_data_container->relative_filepath );
+
+  audio->sound_cache_stats.memory_used -= sound_data_container->size;
+  --audio->sound_cache_stats.entries_count;
+  ++audio->sound_cache_stats.evictions;
+  crude_resource_pool_release_resource( &audio->sounds_data, sound_data_handle.index );
+}
+
+crude_sound_data_handle
+crude_audio_device_find_least_recently_used_sound_data_
+(
+  _In_ crude_audio_device                                  *audio
+)
+{
+  crude_sound_data_handle                                  least_recently_used_handle;
+  uint64                                                   least_recently_used_index;
+
+  least_recently_used_handle = CRUDE_SOUND_DATA_HANDLE_INVALID;
+  least_recently_used_index = UINT64_MAX;
+  for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( audio->relative_filepath_to_sound_data ); ++i )
+  {
+    crude_sound_data_container                            *sound_data_container;
+
+    if ( !crude_hashmapstr_backet_key_hash_valid( audio->relative_filepath_to_sound_data[ i ].key.key_hash ) )
+    {
+      continue;
+    }
+    
+    sound_data_container = crude_audio_device_access_sound_data( audio, audio->relative_filepath_to_sound_data[ i ].value );
+    if ( sound_data_container->references_count == 0u && sound_data_container->last_use_index < least_recently_used_index )
+    {
+      least_recently_used_handle = audio->relative_filepath_to_sound_data[ i ].value;
+      least_recently_used_index = sound_data_container->last_use_index;
+    }
+  }
+
+  return least_recently_used_handle;
+}
+
+void
+crude_audio_device_update_sound_data_size_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_data_container                          *sound_data_container
+)
+{
+  ma_resource_manager_data_buffer_node                    *lma_node;
+  ma_resource_manager_data_supply_type                     lma_supply_type;
+  ma_format                                                lma_format;
+  ma_uint64                                                lma_length;
+  ma_uint32                                                lma_channels;
+
+  if ( sound_data_container->size )
+  {
+    return;
+  }
+
+  /* Async loads report MA_BUSY till the decoder knows the format and length */
+  if ( ma_resource_manager_data_source_get_data_format( &sound_data_container->lma_data_source, &lma_format, &lma_channels, NULL, NULL, 0 ) != MA_SUCCESS )
+  {
+    return;
+  }
+
+  /* Files without the decode flag stay encoded in memory, every sound decodes its copy while playing */
+  lma_node = sound_data_container->lma_data_source.backend.buffer.pNode;
+  lma_supply_type = std::atomic_ref< ma_resource_manager_data_supply_type >( lma_node->data.type ).load( std::memory_order_acquire );
+  if ( lma_supply_type == ma_resource_manager_data_supply_type_encoded )
+  {
+    sound_data_container->size = lma_node->data.backend.encoded.sizeInBytes;
+  }
+  else
+  {
+    if ( ma_resource_manager_data_source_get_length_in_pcm_frames( &sound_data_container->lma_data_source, &lma_length ) != MA_SUCCESS )
+    {
+      return;
+    }
+
+    sound_data_container->size = lma_length * ma_get_bytes_per_frame( lma_format, lma_channels );
+  }
+
+  audio->sound_cache_stats.memory_used += sound_data_container->size;
+}
+
+void
+crude_audio_device_add_voice_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+)
+{
+  crude_sound_container                                   *sound_container;
+  crude_audio_voice                                        voice;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  sound_container->voice_index = CRUDE_ARRAY_LENGTH( audio->voices );
+  sound_container->virtual_voice = false;
+
+  voice.sound_handle = sound_handle;
+  voice.priority = sound_container->priority;
+  voice.audibility = 1.f;
+  voice.score = 1.f;
+  CRUDE_ARRAY_PUSH( audio->voices, voice );
+  audio->voices_stats.voices_count = CRUDE_ARRAY_LENGTH( audio->voices );
+}
+
+void
+crude_audio_device_remove_voice_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+)
+{
+  crude_sound_container                                   *sound_container;
+  uint32                                                   voice_index;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  voice_index = sound_container->voice_index;
+  if ( !sound_container->virtual_voice )
+  {
+    --audio->voices_stats.real_voices_count;
+  }
+  sound_container->voice_index = CRUDE_AUDIO_VOICE_INDEX_INVALID;
+  sound_container->virtual_voice = false;
+
+  CRUDE_ARRAY_DELSWAP( audio->voices, voice_index );
+  if ( voice_index < CRUDE_ARRAY_LENGTH( audio->voices ) )
+  {
+    crude_audio_device_access_sound_( audio, audio->voices[ voice_index ].sound_handle )->voice_index = voice_index;
+  }
+  audio->voices_stats.voices_count = CRUDE_ARRAY_LENGTH( audio->voices );
+}
+
+void
+crude_audio_device_virtualize_voice_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+)
+{
+  crude_sound_container                                   *sound_container;
+  crude_audio_command                                     *pending_command;
+  ma_uint64                                                lma_cursor;
+  ma_uint64                                                lma_length;
+  ma_uint32                                                lma_sample_rate;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  if ( ma_sound_get_data_format( &sound_container->lma_sound, NULL, NULL, &lma_sample_rate, NULL, 0 ) != MA_SUCCESS || lma_sample_rate == 0 )
+  {
+    lma_sample_rate = ma_engine_get_sample_rate( &audio->lma_engine );
+  }
+
+  /* Cursor lags behind by commands the mixer didn't consume yet, it's below a buffer */
+  if ( ma_sound_get_cursor_in_pcm_frames( &sound_container->lma_sound, &lma_cursor ) != MA_SUCCESS )
+  {
+    lma_cursor = 0u;
+  }
+
+  if ( ma_sound_get_length_in_pcm_frames( &sound_container->lma_sound, &lma_length ) != MA_SUCCESS )
+  {
+    lma_length = 0u;
+  }
+
+  sound_container->virtual_cursor_time = CRUDE_CAST( float64, lma_cursor ) / lma_sample_rate;
+  sound_container->length_time = CRUDE_CAST( float64, lma_length ) / lma_sample_rate;
+
+  /* Start wasn't consumed yet, ma_sound_start would rewind the sound at the end */
+  if ( ( sound_container->pending_command.flags & CRUDE_AUDIO_COMMAND_FLAGS_START ) && ma_sound_at_end( &sound_container->lma_sound ) )
+  {
+    sound_container->virtual_cursor_time = 0.0;
+  }
+
+  if ( !sound_container->virtual_voice )
+  {
+    pending_command = crude_audio_device_sound_pending_command_( audio, sound_handle );
+    pending_command->flags = ( pending_command->flags & ~( CRUDE_AUDIO_COMMAND_FLAGS_START | CRUDE_AUDIO_COMMAND_FLAGS_FADE_IN ) ) | CRUDE_AUDIO_COMMAND_FLAGS_STOP;
+    --audio->voices_stats.real_voices_count;
+  }
+  sound_container->virtual_voice = true;
+}
+
+void
+crude_audio_device_devirtualize_voice_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+)
+{
+  crude_sound_container                                   *sound_container;
+  crude_audio_command                                     *pending_command;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+
+  /* Fade in hides the jump, the voice continues from where it would be if it was mixed all the time */
+  pending_command = crude_audio_device_sound_pending_command_( audio, sound_handle );
+  pending_command->flags = ( pending_command->flags & ~CRUDE_AUDIO_COMMAND_FLAGS_STOP ) | CRUDE_AUDIO_COMMAND_FLAGS_SEEK | CRUDE_AUDIO_COMMAND_FLAGS_FADE_IN | CRUDE_AUDIO_COMMAND_FLAGS_START;
+  pending_command->seek_time = sound_container->virtual_cursor_time;
+  sound_container->virtual_voice = false;
+  ++audio->voices_stats.real_voices_count;
+}
+
+float32
+crude_audio_device_voice_audibility_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_container                               *sound_container
+)
+{
+  ma_sound                                                *lma_sound;
+  XMVECTOR                                                 position;
+  float32                                                  distance, min_distance, max_distance, rolloff, gain;
+
+  lma_sound = &sound_container->lma_sound;
+  position = XMLoadFloat3( &sound_container->position );
+  if ( ma_sound_get_positioning( lma_sound ) == ma_positioning_absolute )
+  {
+    position = XMVectorSubtract( position, XMLoadFloat3( &audio->listener_position ) );
+  }
+
+  distance = XMVectorGetX( XMVector3Length( position ) );
+  min_distance = ma_sound_get_min_distance( lma_sound );
+  max_distance = ma_sound_get_max_distance( lma_sound );
+  rolloff = ma_sound_get_rolloff( lma_sound );
+
+  /* Same curves miniaudio spatializer applies */
+  gain = 1.f;
+  if ( min_distance < max_distance )
+  {
+    distance = CRUDE_MAX( min_distance, CRUDE_MIN( distance, max_distance ) );
+    switch ( ma_sound_get_attenuation_model( lma_sound ) )
+    {
+    case ma_attenuation_model_inverse:
+    {
+      gain = min_distance / ( min_distance + rolloff * ( distance - min_distance ) );
+      break;
+    }
+    case ma_attenuation_model_linear:
+    {
+      gain = CRUDE_MAX( 0.f, 1.f - rolloff * ( distance - min_distance ) / ( max_distance - min_distance ) );
+      break;
+    }
+    case ma_attenuation_model_exponential:
+    {
+      gain = powf( distance / min_distance, -rolloff );
+      break;
+    }
+    }
+  }
+
+  return gain * sound_container->volume;
+}
+
+int
+crude_audio_device_voice_compare_
+(
+  _In_ void const                                         *a,
+  _In_ void const                                         *b
+)
+{
+  crude_audio_voice const                                 *a_voice, *b_voice;
+
+  a_voice = CRUDE_CAST( crude_audio_voice const*, a );
+  b_voice = CRUDE_CAST( crude_audio_voice const*, b );
+  if ( a_voice->priority != b_voice->priority )
+  {
+    return ( a_voice->priority < b_voice->priority ) - ( a_voice->priority > b_voice->priority );
+  }
+  return ( a_voice->score < b_voice->score ) - ( a_voice->score > b_voice->score );
+}
+
+crude_audio_command*
+crude_audio_device_sound_pending_command_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+)
+{
+  crude_sound_container                                   *sound_container;
+
+  sound_container = crude_audio_device_access_sound_( audio, sound_handle );
+  if ( !sound_container->pending_command.flags )
+  {
+    CRUDE_ARRAY_PUSH( audio->commands_dirty_sounds, sound_handle );
+  }
+  return &sound_container->pending_command;
+}
+
+bool
+crude_audio_device_sound_commands_in_flight_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_container                               *sound_container
+)
+{
+  return sound_container->pending_command.flags || sound_container->last_command_batch_index > std::atomic_ref< uint64 >( audio->commands_consumed_batch_index ).load( std::memory_order_acquire );
+}
+
+bool
+crude_audio_device_voice_finished_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_container                               *sound_container
+)
+{
+  if ( sound_container->virtual_voice )
+  {
+    return sound_container->length_time > 0.0 && sound_container->virtual_cursor_time >= sound_container->length_time && !ma_sound_is_looping( &sound_container->lma_sound );
+  }
+  return !crude_audio_device_sound_commands_in_flight_( audio, sound_container ) && !ma_sound_is_playing( &sound_container->lma_sound ) && ma_sound_at_end( &sound_container->lma_sound );
+}
+
+void
+crude_audio_device_publish_commands_
+(
+  _In_ crude_audio_device                                  *audio
+)
+{
+  uint32                                                   free_commands_count;
+  uint32                                                   dirty_sounds_count;
+  uint32                                                   published_count;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_audio_device_publish_commands_" );
+  free_commands_count = CRUDE_AUDIO_COMMANDS_MAX - ( audio->commands_write_index - std::atomic_ref< uint32 >( audio->commands_read_index ).load( std::memory_order_acquire ) );
+
+  if ( audio->listener_pending_command.flags && free_commands_count )
+  {
+    audio->listener_pending_command.batch_index = audio->commands_batch_index;
+    audio->commands[ audio->commands_write_index++ & ( CRUDE_AUDIO_COMMANDS_MAX - 1 ) ] = audio->listener_pending_command;
+    audio->listener_pending_command.flags = 0u;
+    --free_commands_count;
+  }
+
+  /* Sounds which didn't fit stay dirty and go with the next frame */
+  dirty_sounds_count = CRUDE_ARRAY_LENGTH( audio->commands_dirty_sounds );
+  published_count = CRUDE_MIN( dirty_sounds_count, free_commands_count );
+  for ( uint32 i = 0; i < published_count; ++i )
+  {
+    crude_sound_container                                 *sound_container;
+
+    sound_container = crude_audio_device_access_sound_( audio, audio->commands_dirty_sounds[ i ] );
+    sound_container->pending_command.batch_index = audio->commands_batch_index;
+    audio->commands[ audio->commands_write_index++ & ( CRUDE_AUDIO_COMMANDS_MAX - 1 ) ] = sound_container->pending_command;
+    sound_container->pending_command.flags = 0u;
+    sound_container->last_command_batch_index = audio->commands_batch_index;
+  }
+
+  for ( uint32 i = published_count; i < dirty_sounds_count; ++i )
+  {
+    audio->commands_dirty_sounds[ i - published_count ] = audio->commands_dirty_sounds[ i ];
+  }
+  CRUDE_ARRAY_SET_LENGTH( audio->commands_dirty_sounds, dirty_sounds_count - published_count );
+
+  std::atomic_ref< uint32 >( audio->commands_published_write_index ).store( audio->commands_write_index, std::memory_order_release );
+  ++audio->commands_batch_index;
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_audio_device_consume_commands_
+(
+  _In_ crude_audio_device                                  *audio
+)
+{
+  uint32                                                   read_index;
+  uint32                                                   write_index;
+
+  read_index = std::atomic_ref< uint32 >( audio->commands_read_index ).load( std::memory_order_relaxed );
+  write_index = std::atomic_ref< uint32 >( audio->commands_published_write_index ).load( std::memory_order_acquire );
+  if ( read_index == write_index )
+  {
+    return;
+  }
+
+  for ( ; read_index != write_index; ++read_index )
+  {
+    crude_audio_command const                             *command;
+    ma_sound                                              *lma_sound;
+
+    command = &audio->commands[ read_index & ( CRUDE_AUDIO_COMMANDS_MAX - 1 ) ];
+    if ( command->sound_handle.index == CRUDE_SOUND_HANDLE_INVALID.index )
+    {
+      if ( command->flags & CRUDE_AUDIO_COMMAND_FLAGS_POSITION )
+      {
+        ma_engine_listener_set_position( &audio->lma_engine, 0, command->position.x, command->position.y, command->position.z );
+      }
+      if ( command->flags & CRUDE_AUDIO_COMMAND_FLAGS_DIRECTION )
+      {
+        ma_engine_listener_set_direction( &audio->lma_engine, 0, command->direction.x, command->direction.y, command->direction.z );
+      }
+      continue;
+    }
+
+    lma_sound = &crude_audio_device_access_sound_( audio, command->sound_handle )->lma_sound;
+    if ( command->flags & CRUDE_AUDIO_COMMAND_FLAGS_POSITION )
+    {
+      ma_sound_set_position( lma_sound, command->position.x, command->position.y, command->position.z );
+    }
+    if ( command->flags & CRUDE_AUDIO_COMMAND_FLAGS_VOLUME )
+    {
+      ma_sound_set_volume( lma_sound, command->volume );
+    }
+    if ( command->flags & CRUDE_AUDIO_COMMAND_FLAGS_SEEK )
+    {
+      ma_sound_seek_to_second( lma_sound, command->seek_time );
+    }
+    if ( command->flags & CRUDE_AUDIO_COMMAND_FLAGS_FADE_IN )
+    {
+      ma_sound_set_fade_in_milliseconds( lma_sound, 0.f, 1.f, CRUDE_AUDIO_VOICE_FADE_IN_MILLISECONDS );
+    }
+    if ( command->flags & CRUDE_AUDIO_COMMAND_FLAGS_START )
+    {
+      ma_sound_start( lma_sound );
+    }
+    if ( command->flags & CRUDE_AUDIO_COMMAND_FLAGS_STOP )
+    {
+      ma_sound_stop( lma_sound );
+    }
+  }
+
+  std::atomic_ref< uint64 >( audio->commands_consumed_batch_index ).store( audio->commands[ ( write_index - 1 ) & ( CRUDE_AUDIO_COMMANDS_MAX - 1 ) ].batch_index, std::memory_order_release );
+  std::atomic_ref< uint32 >( audio->commands_read_index ).store( write_index, std::memory_order_release );
+}
+
+void
+crude_audio_device_release_destroyed_sounds_
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ bool                                                 force
+)
+{
+  for ( int32 i = CRUDE_ARRAY_LENGTH( audio->sounds_to_release ) - 1; i >= 0; --i )
+  {
+    crude_sound_container                                 *sound_container;
+
+    sound_container = crude_audio_device_access_sound_( audio, audio->sounds_to_release[ i ] );
+    if ( !force && crude_audio_device_sound_commands_in_flight_( audio, sound_container ) )
+    {
+      continue;
+    }
+
+    ma_sound_uninit( &sound_container->lma_sound );
+    if ( sound_container->data_handle.index != CRUDE_RESOURCE_INDEX_INVALID )
+    {
+      /* The sound doesn't own a data source it was initialized from */
+      ma_resource_manager_data_source_uninit( &sound_container->lma_data_source );
+      crude_audio_device_release_sound_data_( audio, sound_container->data_handle );
+    }
+    crude_resource_pool_release_resource( &audio->sounds, audio->sounds_to_release[ i ].index );
+    CRUDE_ARRAY_DELSWAP( audio->sounds_to_release, i );
+  }
+}
@@ -16,6 +16,32 @@ typedef struct crude_audio_device
   crude_heap_allocator                                    *allocator;
   char const                                              *resources_absolute_directory;
   crude_string_buffer                                      absolute_filepath_string_buffer;
+  /* Sound cache */
+  crude_resource_pool                                      sounds_data;
+  CRUDE_HASHMAPSTR( crude_sound_data_handle )             *relative_filepath_to_sound_data;
+  uint64                                                   sound_data_use_index;
+  crude_audio_sound_cache_stats                            sound_cache_stats;
+  /* Voices */
+  crude_audio_voice                                       *voices;
+  crude_audio_voices_stats                                 voices_stats;
+  /**
+   * Commands, single producer is the game thread, single consumer is the
+   * mixer. Whole frame is published with one store of the write index, so
+   * the mixer applies either all changes of a frame or none of them.
+   * Indices shared with the mixer are accessed through std::atomic_ref,
+   * the device stays trivially copyable.
+   */
+  crude_audio_command                                     *commands;
+  uint32                                                   commands_write_index;
+  uint32                                                   commands_published_write_index;
+  uint32                                                   commands_read_index;
+  uint64                                                   commands_batch_index;
+  uint64                                                   commands_consumed_batch_index;
+  crude_sound_handle                                      *commands_dirty_sounds;
+  crude_audio_command                                      listener_pending_command;
+  XMFLOAT3                                                 listener_position;
+  /* Destroyed sounds wait till the mixer consumed their commands */
+  crude_sound_handle                                      *sounds_to_release;
 } crude_audio_device;
 
 CRUDE_API void
@@ -32,6 +58,18 @@ crude_audio_device_deinitialize
   _In_ crude_audio_device                                  *audio
 );
 
+/**
+ * Advances virtual voices, scores every voice and keeps only the most
+ * important ones real, then publishes the frame commands to the mixer.
+ * Should be called once per frame after sounds and listener are moved.
+ */
+CRUDE_API void
+crude_audio_device_update
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ float32                                              delta_time
+);
+
 CRUDE_API void
 crude_audio_device_wait_wait_till_uploaded
 (
@@ -172,4 +210,51 @@ crude_audio_device_sound_get_positiong
 (
   _In_ crude_audio_device                                  *audio,
   _In_ crude_sound_handle                                   sound_handle
-);
\ No newline at end of file
+);
+
+CRUDE_API void
+crude_audio_device_set_sound_cache_budget
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ uint64                                               budget
+);
+
+/* Evicts unreferenced data till the cache fits the budget */
+CRUDE_API void
+crude_audio_device_trim_sound_cache
+(
+  _In_ crude_audio_device                                  *audio
+);
+
+CRUDE_API crude_audio_sound_cache_stats
+crude_audio_device_get_sound_cache_stats
+(
+  _In_ crude_audio_device                                  *audio
+);
+
+CRUDE_API crude_sound_data_container*
+crude_audio_device_access_sound_data
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_data_handle                              sound_data_handle
+);
+
+CRUDE_API void
+crude_audio_device_set_real_voices_max
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ uint32                                               real_voices_max
+);
+
+CRUDE_API crude_audio_voices_stats
+crude_audio_device_get_voices_stats
+(
+  _In_ crude_audio_device                                  *audio
+);
+
+CRUDE_API bool
+crude_audio_device_sound_is_virtual
+(
+  _In_ crude_audio_device                                  *audio,
+  _In_ crude_sound_handle                                   sound_handle
+);
@@ -3,6 +3,7 @@
 #include <miniaudio.h>
 
 #include <engine/core/alias.h>
+#include <engine/core/math.h>
 #include <engine/core/resource_pool.h>
 #include <engine/audio/audio_config.h>
 
@@ -16,8 +17,15 @@ typedef struct crude_sound_group_handle
   uint32                                                   index;
 } crude_sound_group_handle;
 
+typedef struct crude_sound_data_handle
+{
+  uint32                                                   index;
+} crude_sound_data_handle;
+
 #define CRUDE_SOUND_GROUP_HANDLE_INVALID                   ( CRUDE_COMPOUNT( crude_sound_group_handle, { CRUDE_RESOURCE_INDEX_INVALID } ) )
 #define CRUDE_SOUND_HANDLE_INVALID                         ( CRUDE_COMPOUNT( crude_sound_handle, { CRUDE_RESOURCE_INDEX_INVALID } ) )
+#define CRUDE_SOUND_DATA_HANDLE_INVALID                    ( CRUDE_COMPOUNT( crude_sound_data_handle, { CRUDE_RESOURCE_INDEX_INVALID } ) )
+#define CRUDE_AUDIO_VOICE_INDEX_INVALID                    ( UINT32_MAX )
 
 typedef enum crude_audio_sound_positioning
 {
@@ -46,8 +54,105 @@ typedef struct crude_sound_creation
   float32                                                  min_distance;
   float32                                                  rolloff;
   crude_sound_group_handle                                 sound_group_handle;
+  /* Higher priority voices take real voices first, audibility decides between equal ones */
+  int32                                                    priority;
 } crude_sound_creation;
 
+/**
+ * Loaded file shared by every sound created from it, sounds read copies
+ * of lma_data_source referencing the same buffer. Data nobody references
+ * stays cached until the budget or a new file needs its memory or slot back.
+ */
+typedef struct crude_sound_data_container
+{
+  char                                                     relative_filepath[ CRUDE_AUDIO_RELATIVE_FILEPATH_LENGTH_MAX ];
+  ma_resource_manager_data_source                          lma_data_source;
+  /* Resident bytes, encoded file or decoded PCM. 0 until the load knows it, async loads fill it later */
+  uint64                                                   size;
+  uint32                                                   references_count;
+  /* Larger is more recently used */
+  uint64                                                   last_use_index;
+} crude_sound_data_container;
+
+typedef enum crude_audio_command_flags
+{
+  CRUDE_AUDIO_COMMAND_FLAGS_POSITION = 1 << 0,
+  CRUDE_AUDIO_COMMAND_FLAGS_DIRECTION = 1 << 1,
+  CRUDE_AUDIO_COMMAND_FLAGS_VOLUME = 1 << 2,
+  CRUDE_AUDIO_COMMAND_FLAGS_SEEK = 1 << 3,
+  CRUDE_AUDIO_COMMAND_FLAGS_FADE_IN = 1 << 4,
+  CRUDE_AUDIO_COMMAND_FLAGS_START = 1 << 5,
+  CRUDE_AUDIO_COMMAND_FLAGS_STOP = 1 << 6,
+} crude_audio_command_flags;
+
+/* All changes of one sound during a frame, listener commands have invalid sound_handle */
+typedef struct crude_audio_command
+{
+  crude_sound_handle                                       sound_handle;
+  uint32                                                   flags;
+  XMFLOAT3                                                 position;
+  XMFLOAT3                                                 direction;
+  float32                                                  volume;
+  float32                                                  seek_time;
+  uint64                                                   batch_index;
+} crude_audio_command;
+
+/**
+ * Streamed sounds decode on their own, data_handle is invalid for them.
+ * Started sound is a voice till it's stopped or reaches the end. Virtual
+ * voices are stopped in miniaudio and only advance virtual_cursor_time.
+ */
+typedef struct crude_sound_container
+{
+  ma_sound                                                 lma_sound;
+  ma_resource_manager_data_source                          lma_data_source;
+  crude_sound_data_handle                                  data_handle;
+  int32                                                    priority;
+  uint32                                                   voice_index;
+  bool                                                     virtual_voice;
+  /* Valid while virtual, seconds from the sound start */
+  float64                                                  virtual_cursor_time;
+  /* Seconds, 0 if unknown, virtual voice never ends then */
+  float64                                                  length_time;
+  /* Game thread copy of the parameters, mixer gets them through commands */
+  XMFLOAT3                                                 position;
+  float32                                                  volume;
+  crude_audio_command                                      pending_command;
+  /* Batch of the last published command, ma_sound state lags till the mixer consumed it */
+  uint64                                                   last_command_batch_index;
+} crude_sound_container;
+
+typedef struct crude_audio_voice
+{
+  crude_sound_handle                                       sound_handle;
+  int32                                                    priority;
+  float32                                                  audibility;
+  /* Audibility with the real voice hysteresis, voices are sorted by it */
+  float32                                                  score;
+} crude_audio_voice;
+
+typedef struct crude_audio_voices_stats
+{
+  uint32                                                   voices_count;
+  uint32                                                   real_voices_count;
+  uint32                                                   real_voices_max;
+  /* Last update only */
+  uint32                                                   virtualized_count;
+  uint32                                                   devirtualized_count;
+  uint32                                                   finished_count;
+} crude_audio_voices_stats;
+
+typedef struct crude_audio_sound_cache_stats
+{
+  uint64                                                   memory_used;
+  uint64                                                   memory_budget;
+  uint32                                                   entries_count;
+  uint32                                                   referenced_entries_count;
+  uint32                                                   hits;
+  uint32                                                   misses;
+  uint32                                                   evictions;
+} crude_audio_sound_cache_stats;
+
 typedef struct crude_audio_player
 {
   char                                                     relative_filepath[ CRUDE_AUDIO_RELATIVE_FILEPATH_LENGTH_MAX ];
@@ -59,12 +164,15 @@ typedef struct crude_audio_player
   float32                                                  rolloff;
   float32                                                  start_volume;
   bool                                                     autoplay;
+  int32                                                    priority;
 } crude_audio_player;
 
 typedef struct crude_audio_player_handle
 {
   crude_sound_handle                                       sound_handle;
   float32                                                  last_local_to_world_update_time;
+  /* crude_audio_system_context::update_index of the last update the emitter was in audible range */
+  uint32                                                   audible_update_index;
 } crude_audio_player_handle;
 
 typedef struct crude_audio_listener
@@ -74,6 +74,10 @@ CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_IMPLEMENTATION( crude_audio_player )
   {
     component->autoplay = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( component_json, "autoplay" ) );
   }
+  if ( cJSON_GetObjectItemCaseSensitive( component_json, "priority" ) )
+  {
+    component->priority = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( component_json, "priority" ) );
+  }
   return true;
 }
 
@@ -90,6 +94,7 @@ CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_IMPLEMENTATION( crude_audio_player )
   cJSON_AddItemToObject( component_json, "rolloff", cJSON_CreateNumber( component->rolloff ) );
   cJSON_AddItemToObject( component_json, "start_volume", cJSON_CreateNumber( component->start_volume ) );
   cJSON_AddItemToObject( component_json, "autoplay", cJSON_CreateNumber( component->autoplay ) );
+  cJSON_AddItemToObject( component_json, "priority", cJSON_CreateNumber( component->priority ) );
   return component_json;
 }
 
@@ -163,6 +168,10 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_audio_player )
     ImGui::Checkbox( "##Autoplay", &component->autoplay );
     } );
 
+  CRUDE_IMGUI_OPTION( "Priority", {
+    modified |= ImGui::DragInt( "##Priority", &component->priority );
+    } );
+
   if ( modified )
   {
     CRUDE_ENTITY_SET_COMPONENT( world, node, crude_audio_player, { *component } );
@@ -193,6 +202,9 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_audio_player_handle )
         crude_audio_device_sound_reset( manager->audio_device, component->sound_handle );
       }
       }); 
+    CRUDE_IMGUI_OPTION( "Virtual", {
+      ImGui::Text( "%s", crude_audio_device_sound_is_virtual( manager->audio_device, component->sound_handle ) ? "Yes" : "No" );
+      }); 
     CRUDE_IMGUI_OPTION( "Volume", {
       float32 volume = crude_audio_device_sound_get_volume( manager->audio_device, component->sound_handle );
       if ( ImGui::DragFloat( "##Volume", &volume, 0.1f, 0.01f ) )
@@ -232,8 +244,8 @@ crude_audio_system_import
   } );
 
   CRUDE_ECS_SYSTEM_DEFINE( world, crude_audio_player_update_system_, crude_ecs_on_engine_update, ctx, { 
-    { .id = ecs_id( crude_audio_player_handle ) },
     { .id = ecs_id( crude_transform ) },
+    { .id = ecs_id( crude_audio_listener ) },
   } );
   
   CRUDE_ECS_OBSERVER_DEFINE( world, crude_audio_player_create_observer_, EcsOnSet, ctx, { 
@@ -241,7 +253,8 @@ crude_audio_system_import
   } );
 
   CRUDE_ECS_OBSERVER_DEFINE( world, crude_audio_player_destroy_observer_, EcsOnRemove, ctx, { 
-    { .id = ecs_id( crude_audio_player_handle ), .oper = EcsAnd }
+    { .id = ecs_id( crude_audio_player_handle ), .oper = EcsAnd },
+    { .id = EcsDisabled, .oper = EcsOptional }
   } );
 }
 
@@ -314,15 +327,24 @@ crude_audio_player_create_observer_
       sound_creation.decode = true;
       crude_string_copy( sound_creation.relative_filepath, audio_player->relative_filepath, sizeof( sound_creation.relative_filepath ) );
       sound_creation.positioning = audio_player->positioning;
-      sound_creation.async_loading = false;
+      /* Decoded on the miniaudio resource manager job thread, so node loads don't decode on the main thread */
+      sound_creation.async_loading = true;
       sound_creation.min_distance = audio_player->min_distance;
       sound_creation.max_distance = audio_player->max_distance;
       sound_creation.rolloff = audio_player->rolloff;
+      sound_creation.priority = audio_player->priority;
 
       audio_player_handle.sound_handle = crude_audio_device_create_sound( ctx->device, &sound_creation );
       audio_player_handle.last_local_to_world_update_time = 0;
+      audio_player_handle.audible_update_index = 0;
       CRUDE_ENTITY_SET_COMPONENT( it->world, audio_player_node, crude_audio_player_handle, { audio_player_handle } );
 
+      /* Emitters out of range aren't updated, so they start with a valid translation instead of the origin */
+      if ( audio_player->positioning == CRUDE_AUDIO_SOUND_POSITIONING_ABSOLUTE )
+      {
+        crude_audio_device_sound_set_translation( ctx->device, audio_player_handle.sound_handle, crude_transform_node_to_world( it->world, audio_player_node, NULL ).r[ 3 ] );
+      }
+
       crude_audio_device_sound_set_volume( ctx->device, audio_player_handle.sound_handle, audio_player->start_volume );
 
       if ( audio_player->autoplay && CRUDE_ECS_GAME_STAGE_IS_ENABLED( it->world ) )
@@ -357,6 +379,12 @@ crude_audio_player_destroy_observer_
   }
 }
 
+/**
+ * Emitter proxies are as big as max_distance, so only emitters the listener
+ * can hear are updated. An emitter leaving the range gets its translation
+ * refreshed once, so it is past max_distance for the voice culling, then
+ * keeps it till it is in range again.
+ */
 void
 crude_audio_player_update_system_
 (
@@ -365,34 +393,73 @@ crude_audio_player_update_system_
 {
   crude_audio_system_context                              *ctx;
   crude_transform                                         *transform_per_entity;
-  crude_audio_player_handle                               *audio_player_per_entity;
+  crude_entity                                             audible_emitters[ CRUDE_AUDIO_SOUNDS_MAX ];
+  uint32                                                   audible_emitters_count;
 
   ctx = CRUDE_CAST( crude_audio_system_context*, it->ctx );
-  audio_player_per_entity = ecs_field( it, crude_audio_player_handle, 0 );
-  transform_per_entity = ecs_field( it, crude_transform, 1 );
+  transform_per_entity = ecs_field( it, crude_transform, 0 );
+
+  ++ctx->update_index;
+  audible_emitters_count = 0u;
 
   for ( uint32 i = 0; i < it->count; ++i )
   {
-    crude_transform                                       *transform;
+    crude_scene_bvh_query_result                           query_result;
+    XMFLOAT4                                               listener_sphere;
+    crude_entity                                           listener_node;
+
+    listener_node = crude_entity_from_iterator( it, i );
+    XMStoreFloat4( &listener_sphere, XMVectorSetW( crude_transform_node_to_world( it->world, listener_node, &transform_per_entity[ i ] ).r[ 3 ], 0.f ) );
+
+    query_result = crude_scene_bvh_query_result_empty( audible_emitters + audible_emitters_count, CRUDE_COUNTOF( audible_emitters ) - audible_emitters_count, NULL );
+    crude_scene_bvh_query_spheres( ctx->scene_bvh, &listener_sphere, 1u, CRUDE_SCENE_BVH_CATEGORY_AUDIO_EMITTER, &query_result );
+    audible_emitters_count += query_result.entities_count;
+
+    for ( uint32 emitter_index = 0; emitter_index < query_result.entities_count; ++emitter_index )
+    {
+      crude_audio_player_handle                           *audio_player_handle;
+      crude_entity                                         audio_player_node;
+    
+      audio_player_node = query_result.entities[ emitter_index ];
+      audio_player_handle = CRUDE_ENTITY_GET_MUTABLE_COMPONENT( it->world, audio_player_node, crude_audio_player_handle );
+
+      if ( !audio_player_handle || crude_audio_device_sound_get_positiong( ctx->device, audio_player_handle->sound_handle ) != CRUDE_AUDIO_SOUND_POSITIONING_ABSOLUTE )
+      {
+        continue;
+      }
+
+      audio_player_handle->audible_update_index = ctx->update_index;
+      audio_player_handle->last_local_to_world_update_time += it->delta_time;
+      if ( audio_player_handle->last_local_to_world_update_time < 0.016f )
+      {
+        continue;
+      }
+
+      crude_audio_device_sound_set_translation( ctx->device, audio_player_handle->sound_handle, crude_transform_node_to_world( it->world, audio_player_node, NULL ).r[ 3 ] );
+      audio_player_handle->last_local_to_world_update_time = 0.f;
+    }
+  }
+
+  for ( uint32 emitter_index = 0; emitter_index < ctx->audible_emitters_count; ++emitter_index )
+  {
     crude_audio_player_handle                             *audio_player_handle;
     crude_entity                                           audio_player_node;
     
-    transform = &transform_per_entity[ i ];
-    audio_player_handle = &audio_player_per_entity[ i ];
-    audio_player_node = crude_entity_from_iterator( it, i );
-
-    if ( crude_audio_device_sound_get_positiong( ctx->device, audio_player_handle->sound_handle ) != CRUDE_AUDIO_SOUND_POSITIONING_ABSOLUTE )
+    audio_player_node = ctx->audible_emitters[ emitter_index ];
+    if ( !crude_entity_valid( it->world, audio_player_node ) )
     {
       continue;
     }
 
-    audio_player_handle->last_local_to_world_update_time += it->delta_time;
-    if ( audio_player_handle->last_local_to_world_update_time < 0.016f )
+    audio_player_handle = CRUDE_ENTITY_GET_MUTABLE_COMPONENT( it->world, audio_player_node, crude_audio_player_handle );
+    if ( !audio_player_handle || audio_player_handle->audible_update_index == ctx->update_index || crude_audio_device_sound_get_positiong( ctx->device, audio_player_handle->sound_handle ) != CRUDE_AUDIO_SOUND_POSITIONING_ABSOLUTE )
     {
       continue;
     }
 
-    crude_audio_device_sound_set_translation( ctx->device, audio_player_handle->sound_handle, crude_transform_node_to_world( it->world, audio_player_node, transform ).r[ 3 ] );
-    audio_player_handle->last_local_to_world_update_time = 0.f;
+    crude_audio_device_sound_set_translation( ctx->device, audio_player_handle->sound_handle, crude_transform_node_to_world( it->world, audio_player_node, NULL ).r[ 3 ] );
   }
-}
\ No newline at end of file
+
+  crude_memory_copy( ctx->audible_emitters, audible_emitters, sizeof( crude_entity ) * audible_emitters_count );
+  ctx->audible_emitters_count = audible_emitters_count;
+}
@@ -2,6 +2,7 @@
 
 #include <engine/core/ecs.h>
 #include <engine/scene/components_serialization.h>
+#include <engine/scene/scene_bvh.h>
 #include <engine/audio/audio_device.h>
 
 /**********************************************************
@@ -42,6 +43,12 @@ typedef struct crude_audio_system_context
 {
   crude_ecs                                               *world;
   crude_audio_device                                      *device;
+  /* Emitters in audible range of the listener are found through it */
+  crude_scene_bvh                                         *scene_bvh;
+  /* Emitters found by the last update, the ones which left the range get their translation refreshed once */
+  crude_entity                                             audible_emitters[ CRUDE_AUDIO_SOUNDS_MAX ];
+  uint32                                                   audible_emitters_count;
+  uint32                                                   update_index;
 } crude_audio_system_context;
 
 
@@ -1,7 +1,8 @@
-#include <thirdparty/cJSON/cJSON.h>
+#include <math.h>
 
 #include <engine/core/file.h>
 #include <engine/core/log.h>
+#include <engine/core/json.h>
 
 #include <engine/core/environment.h>
 
@@ -15,7 +16,8 @@ crude_environment_initialize
   _In_ crude_stack_allocator                              *temporary_allocator
 )
 {
-  cJSON                                                   *json;
+  crude_json_document                                      json_document;
+  crude_json_cursor                                        json;
   uint8                                                   *json_buffer;
   size_t                                                   allocated_marker;
   uint32                                                   json_buffer_size;
@@ -23,15 +25,17 @@ crude_environment_initialize
   allocated_marker = crude_stack_allocator_get_marker( temporary_allocator );
   crude_read_file( absolute_filepath, crude_stack_allocator_pack( temporary_allocator ), &json_buffer, &json_buffer_size );
 
-  json = cJSON_ParseWithLength( CRUDE_REINTERPRET_CAST( char const*, json_buffer ), json_buffer_size );
-  if ( !json )
+  if ( !crude_json_document_parse( &json_document, CRUDE_REINTERPRET_CAST( char*, json_buffer ), json_buffer_size, crude_stack_allocator_pack( temporary_allocator ) ) )
   {
-    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot parse a file for game... Error %s", cJSON_GetErrorPtr() );
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot parse a file for game... Error at offset %u", crude_json_document_get_error_offset( &json_document ) );
     goto cleanup;
   }
+
+  json = crude_json_document_get_root( &json_document );
   
   {
-    cJSON                                                 *directories_json;
+    crude_json_cursor                                      directories_json, input_replay_json;
+    char const                                            *input_replay_relative_filepaths[ 3 ];
     char const                                            *render_graph_relative_directory;
     char const                                            *resources_relative_directory;
     char const                                            *techniques_relative_directory;
@@ -42,13 +46,17 @@ crude_environment_initialize
     constant_string_buffer_size = 0u;
     working_absolute_directory_length = crude_string_length( working_absolute_directory ) + 1;
 
-    directories_json = cJSON_GetObjectItemCaseSensitive( json, "directories" );
+    directories_json = crude_json_cursor_get_object_item( json, "directories" );
+    input_replay_json = crude_json_cursor_get_object_item( json, "input_replay" );
     
-    render_graph_relative_directory = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( directories_json, "render_graph_relative_directory" ) );
-    resources_relative_directory = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( directories_json, "resources_relative_directory" ) );
-    techniques_relative_directory = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( directories_json, "techniques_relative_directory" ) );
-    shaders_relative_directory = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( directories_json, "shaders_relative_directory" ) );
-    compiled_shaders_relative_directory = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( directories_json, "compiled_shaders_relative_directory" ) );
+    render_graph_relative_directory = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( directories_json, "render_graph_relative_directory" ) );
+    resources_relative_directory = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( directories_json, "resources_relative_directory" ) );
+    techniques_relative_directory = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( directories_json, "techniques_relative_directory" ) );
+    shaders_relative_directory = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( directories_json, "shaders_relative_directory" ) );
+    compiled_shaders_relative_directory = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( directories_json, "compiled_shaders_relative_directory" ) );
+    input_replay_relative_filepaths[ 0 ] = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( input_replay_json, "record_relative_filepath" ) );
+    input_replay_relative_filepaths[ 1 ] = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( input_replay_json, "replay_relative_filepath" ) );
+    input_replay_relative_filepaths[ 2 ] = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( input_replay_json, "benchmark_relative_filepath" ) );
 
     environment->directories.render_graph_absolute_directory_length = working_absolute_directory_length + crude_string_length( render_graph_relative_directory );
     environment->directories.resources_absolute_directory_length = working_absolute_directory_length + crude_string_length( resources_relative_directory );
@@ -62,6 +70,13 @@ crude_environment_initialize
     constant_string_buffer_size += environment->directories.shaders_absolute_directory_length;
     constant_string_buffer_size += environment->directories.compiled_shaders_absolute_directory_length;
     constant_string_buffer_size += working_absolute_directory_length;
+    for ( uint32 i = 0; i < CRUDE_COUNTOF( input_replay_relative_filepaths ); ++i )
+    {
+      if ( input_replay_relative_filepaths[ i ] )
+      {
+        constant_string_buffer_size += working_absolute_directory_length + crude_string_length( input_replay_relative_filepaths[ i ] );
+      }
+    }
 
     crude_string_buffer_initialize( &environment->constant_string_buffer, constant_string_buffer_size, crude_heap_allocator_pack( heap_allocator ) );
     environment->directories.render_graph_absolute_directory = crude_string_buffer_append_use_f( &environment->constant_string_buffer, "%s%s", working_absolute_directory, render_graph_relative_directory );
@@ -70,19 +85,59 @@ crude_environment_initialize
     environment->directories.shaders_absolute_directory = crude_string_buffer_append_use_f( &environment->constant_string_buffer, "%s%s", working_absolute_directory, shaders_relative_directory );
     environment->directories.compiled_shaders_absolute_directory = crude_string_buffer_append_use_f( &environment->constant_string_buffer, "%s%s", working_absolute_directory, compiled_shaders_relative_directory );
     environment->directories.temporary_absolute_directory = crude_string_buffer_append_use_f( &environment->constant_string_buffer, "%s", working_absolute_directory );
+
+    environment->input_replay.record_absolute_filepath = input_replay_relative_filepaths[ 0 ] ? crude_string_buffer_append_use_f( &environment->constant_string_buffer, "%s%s", working_absolute_directory, input_replay_relative_filepaths[ 0 ] ) : NULL;
+    environment->input_replay.replay_absolute_filepath = input_replay_relative_filepaths[ 1 ] ? crude_string_buffer_append_use_f( &environment->constant_string_buffer, "%s%s", working_absolute_directory, input_replay_relative_filepaths[ 1 ] ) : NULL;
+    environment->input_replay.benchmark_absolute_filepath = input_replay_relative_filepaths[ 2 ] ? crude_string_buffer_append_use_f( &environment->constant_string_buffer, "%s%s", working_absolute_directory, input_replay_relative_filepaths[ 2 ] ) : NULL;
   }
   
   {
-    cJSON                                                 *window_json;
+    crude_json_cursor                                      window_json;
     
-    window_json = cJSON_GetObjectItemCaseSensitive( json, "window" );
-    crude_snprintf( environment->window.initial_title, CRUDE_COUNTOF( environment->window.initial_title ), cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( window_json, "title" ) ) );
-    environment->window.initial_width = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( window_json, "width" ) );
-    environment->window.initial_height = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( window_json, "height" ) );
+    window_json = crude_json_cursor_get_object_item( json, "window" );
+    crude_snprintf( environment->window.initial_title, CRUDE_COUNTOF( environment->window.initial_title ), crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( window_json, "title" ) ) );
+    environment->window.initial_width = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( window_json, "width" ) );
+    environment->window.initial_height = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( window_json, "height" ) );
+  }
+
+  {
+    crude_json_cursor                                      physics_json;
+    char const                                            *capacities_names[ 3 ];
+    uint32                                                *capacities[ 3 ];
+
+    physics_json = crude_json_cursor_get_object_item( json, "physics" );
+    capacities_names[ 0 ] = "max_bodies";
+    capacities_names[ 1 ] = "max_body_pairs";
+    capacities_names[ 2 ] = "max_contact_constraints";
+    capacities[ 0 ] = &environment->physics.max_bodies;
+    capacities[ 1 ] = &environment->physics.max_body_pairs;
+    capacities[ 2 ] = &environment->physics.max_contact_constraints;
+    for ( uint32 i = 0; i < CRUDE_COUNTOF( capacities ); ++i )
+    {
+      float64 capacity = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( physics_json, capacities_names[ i ] ) );
+      *capacities[ i ] = ( isnan( capacity ) || capacity < 0.0 ) ? 0u : CRUDE_CAST( uint32, capacity );
+    }
+  }
+
+  {
+    crude_json_cursor                                      audio_json;
+    char const                                            *options_names[ 2 ];
+    uint32                                                *options[ 2 ];
+
+    audio_json = crude_json_cursor_get_object_item( json, "audio" );
+    options_names[ 0 ] = "sound_cache_budget_mb";
+    options_names[ 1 ] = "real_voices_max";
+    options[ 0 ] = &environment->audio.sound_cache_budget_mb;
+    options[ 1 ] = &environment->audio.real_voices_max;
+    for ( uint32 i = 0; i < CRUDE_COUNTOF( options ); ++i )
+    {
+      float64 option = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( audio_json, options_names[ i ] ) );
+      *options[ i ] = ( isnan( option ) || option < 0.0 ) ? 0u : CRUDE_CAST( uint32, option );
+    }
   }
 
-  cJSON_Delete( json );
 cleanup:
+  crude_json_document_deinitialize( &json_document );
   crude_stack_allocator_free_marker( temporary_allocator, allocated_marker );
 }
 
@@ -27,6 +27,26 @@ typedef struct crude_environment
     uint64                                                 initial_width;
     uint64                                                 initial_height;
   } window;
+  /* Optional, paths are NULL when not set */
+  struct
+  {
+    char const                                            *record_absolute_filepath;
+    char const                                            *replay_absolute_filepath;
+    char const                                            *benchmark_absolute_filepath;
+  } input_replay;
+  /* Optional, 0 when not set, physics picks defaults then */
+  struct
+  {
+    uint32                                                 max_bodies;
+    uint32                                                 max_body_pairs;
+    uint32                                                 max_contact_constraints;
+  } physics;
+  /* Optional, 0 when not set, audio picks defaults then */
+  struct
+  {
+    uint32                                                 sound_cache_budget_mb;
+    uint32                                                 real_voices_max;
+  } audio;
   crude_string_buffer                                      constant_string_buffer;
 } crude_environment;
 
@@ -5,6 +5,8 @@
 #define GetCurrentDir _getcwd
 #else
 #include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
 #define GetCurrentDir getcwd
 #endif
 
@@ -210,7 +212,6 @@ crude_read_file_binary
   {
     *buffer_size = fread( buffer, 1, filesize, file );
     buffer[ *buffer_size ] = 0;
-    fclose( file );
     
     CRUDE_ASSERT( *buffer_size < filesize + 1 );
   }
@@ -218,6 +219,7 @@ crude_read_file_binary
   {
     *buffer_size = filesize + 1;
   }
+  fclose( file );
   return true;
 }
 
@@ -234,6 +236,26 @@ crude_write_file
   fclose( file );
 }
 
+bool
+crude_write_file_binary
+(
+  _In_ char const                                         *filename,
+  _In_ void const                                         *buffer,
+  _In_ size_t                                              buffer_size
+)
+{
+  FILE* file = fopen( filename, "wb" );
+  if ( !file )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_FILEIO, "Cannor write file \"%s\"", filename );
+    return false;
+  }
+
+  bool written = fwrite( buffer, buffer_size, 1, file ) == 1;
+  fclose( file );
+  return written;
+}
+
 bool
 crude_file_delete
 (
@@ -247,4 +269,56 @@ crude_file_delete
   int result = remove( path );
   return ( result == 0 );
 #endif
-}
\ No newline at end of file
+}
+
+bool
+crude_file_replace
+(
+  _In_ char const                                         *src_path,
+  _In_ char const                                         *dst_path
+)
+{
+#if defined(_WIN64)
+  return MoveFileExA( src_path, dst_path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) != 0;
+#else
+  return rename( src_path, dst_path ) == 0;
+#endif
+}
+
+bool
+crude_file_create_directory
+(
+  _In_ char const                                         *path
+)
+{
+#if defined( _WIN64 )
+  return CreateDirectoryA( path, NULL ) || GetLastError( ) == ERROR_ALREADY_EXISTS;
+#else
+  return mkdir( path, 0755 ) == 0 || errno == EEXIST;
+#endif
+}
+
+uint64
+crude_file_last_write_time
+(
+  _In_ char const                                         *path
+)
+{
+#if defined( _WIN64 )
+  WIN32_FILE_ATTRIBUTE_DATA                                file_attribute_data;
+
+  if ( !GetFileAttributesExA( path, GetFileExInfoStandard, &file_attribute_data ) )
+  {
+    return 0u;
+  }
+  return ( CRUDE_CAST( uint64, file_attribute_data.ftLastWriteTime.dwHighDateTime ) << 32u ) | file_attribute_data.ftLastWriteTime.dwLowDateTime;
+#else
+  struct stat                                              file_stat;
+
+  if ( stat( path, &file_stat ) != 0 )
+  {
+    return 0u;
+  }
+  return CRUDE_CAST( uint64, file_stat.st_mtime );
+#endif
+}
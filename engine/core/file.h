@@ -98,8 +98,38 @@ crude_write_file
   _In_ size_t                                              buffer_size
 );
 
+CRUDE_API bool
+crude_write_file_binary
+(
+  _In_ char const                                         *filename,
+  _In_ void const                                         *buffer,
+  _In_ size_t                                              buffer_size
+);
+
 CRUDE_API bool
 crude_file_delete
+(
+  _In_ char const                                         *path
+);
+
+/* Renames src_path to dst_path, dst_path is replaced if it exists */
+CRUDE_API bool
+crude_file_replace
+(
+  _In_ char const                                         *src_path,
+  _In_ char const                                         *dst_path
+);
+
+/* Returns true if the directory exists after the call */
+CRUDE_API bool
+crude_file_create_directory
+(
+  _In_ char const                                         *path
+);
+
+/* Returns 0 if the file doesn't exist */
+CRUDE_API uint64
+crude_file_last_write_time
 (
   _In_ char const                                         *path
 );
\ No newline at end of file
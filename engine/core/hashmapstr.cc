@@ -31,8 +31,8 @@ crude_hash_bytes
   _In_ size_t                                              seed
 )
 {
-  uint64 hash = FNV_OFFSET;
-  for ( uint32 i = 0; i < len; ++i )
+  uint64 hash = seed ? seed : FNV_OFFSET;
+  for ( size_t i = 0; i < len; ++i )
   {
     hash ^= ( uint64 )( unsigned char )( p[ i ] );
     hash *= FNV_PRIME;
@@ -24,6 +24,15 @@ typedef struct crude_hashmapstr_header
   uint64                                                   temp;
 } crude_hashmapstr_header;
 
+/* FNV-1a, seed continues the hash, so chained calls hash concatenated data */
+CRUDE_API uint64
+crude_hash_bytes
+(
+  _In_ uint8 const                                        *p,
+  _In_ size_t                                              len,
+  _In_ size_t                                              seed
+);
+
 CRUDE_API uint64
 crude_hashmapstr_backet_key_hash_valid
 (
@@ -0,0 +1,999 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+/* Without SSE2 the scanners only run their scalar loops, which otherwise handle the last bytes */
+#if defined( __SSE2__ ) || defined( _M_X64 )
+#define CRUDE_JSON_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <engine/core/assert.h>
+#include <engine/core/log.h>
+
+#include <engine/core/json.h>
+
+typedef struct crude_json_parser
+{
+  crude_json_document                                     *document;
+  char                                                    *position;
+  char                                                    *end;
+  uint32                                                   depth;
+} crude_json_parser;
+
+#ifdef CRUDE_JSON_SSE2
+static uint32
+crude_json_bit_scan_forward_
+(
+  _In_ uint32                                              mask
+);
+
+static uint32
+crude_json_bit_count_
+(
+  _In_ uint32                                              mask
+);
+#endif
+
+static uint32
+crude_json_count_values_upper_bound_
+(
+  _In_ char const                                         *buffer,
+  _In_ uint32                                              buffer_size
+);
+
+static void
+crude_json_skip_whitespaces_
+(
+  _In_ crude_json_parser                                  *parser
+);
+
+static bool
+crude_json_parse_value_
+(
+  _In_ crude_json_parser                                  *parser,
+  _In_opt_ char const                                     *key
+);
+
+static bool
+crude_json_parse_container_
+(
+  _In_ crude_json_parser                                  *parser,
+  _In_ uint32                                              container_index
+);
+
+static bool
+crude_json_parse_string_
+(
+  _In_ crude_json_parser                                  *parser,
+  _Out_ char const                                       **string,
+  _Out_ uint32                                            *string_length
+);
+
+static bool
+crude_json_parse_escape_
+(
+  _In_ crude_json_parser                                  *parser,
+  _Inout_ char                                           **read,
+  _Inout_ char                                           **write
+);
+
+static bool
+crude_json_parse_number_
+(
+  _In_ crude_json_parser                                  *parser,
+  _Out_ float64                                           *number
+);
+
+static bool
+crude_json_parse_hex4_
+(
+  _In_ char const                                         *hex,
+  _Out_ uint32                                            *code
+);
+
+static bool
+crude_json_parse_literal_
+(
+  _In_ crude_json_parser                                  *parser,
+  _In_ char const                                         *literal,
+  _In_ uint32                                              literal_length
+);
+
+bool
+crude_json_document_parse
+(
+  _Out_ crude_json_document                               *document,
+  _In_ char                                               *buffer,
+  _In_ uint32                                              buffer_size,
+  _In_ crude_allocator_container                           allocator_container
+)
+{
+  crude_json_parser                                        parser;
+
+  CRUDE_ASSERT( buffer[ buffer_size ] == 0 );
+
+  document->allocator_container = allocator_container;
+  document->buffer = buffer;
+  document->error = NULL;
+  document->values_count = 0;
+
+  /* Every value but the root one is preceded by a comma or an opening bracket, so one allocation is enough */
+  document->values_capacity = crude_json_count_values_upper_bound_( buffer, buffer_size ) + 1;
+  document->values = CRUDE_REINTERPRET_CAST( crude_json_value*, CRUDE_ALLOCATE( allocator_container, document->values_capacity * sizeof( crude_json_value ) ) );
+
+  parser.document = document;
+  parser.position = buffer;
+  parser.end = buffer + buffer_size;
+  parser.depth = 0;
+
+  /* Skip UTF-8 BOM */
+  if ( buffer_size >= 3 && CRUDE_CAST( uint8, buffer[ 0 ] ) == 0xEF && CRUDE_CAST( uint8, buffer[ 1 ] ) == 0xBB && CRUDE_CAST( uint8, buffer[ 2 ] ) == 0xBF )
+  {
+    parser.position += 3;
+  }
+
+  if ( !crude_json_parse_value_( &parser, NULL ) )
+  {
+    return false;
+  }
+
+  crude_json_skip_whitespaces_( &parser );
+  if ( parser.position != parser.end )
+  {
+    document->error = parser.position;
+    return false;
+  }
+
+  return true;
+}
+
+void
+crude_json_document_deinitialize
+(
+  _In_ crude_json_document                                *document
+)
+{
+  if ( document->values )
+  {
+    CRUDE_DEALLOCATE( document->allocator_container, document->values );
+  }
+  document->values = NULL;
+  document->values_count = document->values_capacity = 0;
+}
+
+uint32
+crude_json_document_get_error_offset
+(
+  _In_ crude_json_document const                          *document
+)
+{
+  return document->error ? CRUDE_CAST( uint32, document->error - document->buffer ) : 0;
+}
+
+crude_json_cursor
+crude_json_document_get_root
+(
+  _In_ crude_json_document const                          *document
+)
+{
+  crude_json_cursor                                        cursor;
+
+  cursor = CRUDE_COMPOUNT_EMPTY( crude_json_cursor );
+  if ( document->values_count && !document->error )
+  {
+    cursor.document = document;
+    cursor.index = 0;
+  }
+  return cursor;
+}
+
+bool
+crude_json_cursor_valid
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  return cursor.document && cursor.index < cursor.document->values_count;
+}
+
+crude_json_type
+crude_json_cursor_get_type
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  if ( !crude_json_cursor_valid( cursor ) )
+  {
+    return CRUDE_JSON_TYPE_INVALID;
+  }
+  return CRUDE_CAST( crude_json_type, cursor.document->values[ cursor.index ].type );
+}
+
+bool
+crude_json_cursor_is_array
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  return crude_json_cursor_get_type( cursor ) == CRUDE_JSON_TYPE_ARRAY;
+}
+
+bool
+crude_json_cursor_is_string
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  return crude_json_cursor_get_type( cursor ) == CRUDE_JSON_TYPE_STRING;
+}
+
+crude_json_cursor
+crude_json_cursor_get_object_item
+(
+  _In_ crude_json_cursor                                   cursor,
+  _In_ char const                                         *key
+)
+{
+  crude_json_cursor                                        child;
+
+  if ( crude_json_cursor_get_type( cursor ) != CRUDE_JSON_TYPE_OBJECT )
+  {
+    return CRUDE_COMPOUNT_EMPTY( crude_json_cursor );
+  }
+
+  CRUDE_JSON_CURSOR_FOR_EACH( child, cursor )
+  {
+    if ( strcmp( cursor.document->values[ child.index ].key, key ) == 0 )
+    {
+      return child;
+    }
+  }
+
+  return CRUDE_COMPOUNT_EMPTY( crude_json_cursor );
+}
+
+crude_json_cursor
+crude_json_cursor_get_array_item
+(
+  _In_ crude_json_cursor                                   cursor,
+  _In_ uint32                                              index
+)
+{
+  crude_json_cursor                                        child;
+
+  child = crude_json_cursor_get_child( cursor );
+  for ( uint32 i = 0; i < index && crude_json_cursor_valid( child ); ++i )
+  {
+    child = crude_json_cursor_get_next( child );
+  }
+  return child;
+}
+
+uint32
+crude_json_cursor_get_array_size
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  if ( !crude_json_cursor_valid( cursor ) )
+  {
+    return 0;
+  }
+  return cursor.document->values[ cursor.index ].children_count;
+}
+
+crude_json_cursor
+crude_json_cursor_get_child
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  if ( !crude_json_cursor_valid( cursor ) || cursor.document->values[ cursor.index ].children_count == 0 )
+  {
+    return CRUDE_COMPOUNT_EMPTY( crude_json_cursor );
+  }
+  ++cursor.index;
+  return cursor;
+}
+
+crude_json_cursor
+crude_json_cursor_get_next
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  if ( !crude_json_cursor_valid( cursor ) || cursor.document->values[ cursor.index ].next == 0 )
+  {
+    return CRUDE_COMPOUNT_EMPTY( crude_json_cursor );
+  }
+  cursor.index = cursor.document->values[ cursor.index ].next;
+  return cursor;
+}
+
+char const*
+crude_json_cursor_get_key
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  if ( !crude_json_cursor_valid( cursor ) )
+  {
+    return NULL;
+  }
+  return cursor.document->values[ cursor.index ].key;
+}
+
+char const*
+crude_json_cursor_get_string_value
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  if ( !crude_json_cursor_is_string( cursor ) )
+  {
+    return NULL;
+  }
+  return cursor.document->values[ cursor.index ].string;
+}
+
+uint32
+crude_json_cursor_get_string_length
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  if ( !crude_json_cursor_is_string( cursor ) )
+  {
+    return 0;
+  }
+  return cursor.document->values[ cursor.index ].string_length;
+}
+
+float64
+crude_json_cursor_get_number_value
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  if ( crude_json_cursor_get_type( cursor ) != CRUDE_JSON_TYPE_NUMBER )
+  {
+    return NAN;
+  }
+  return cursor.document->values[ cursor.index ].number;
+}
+
+bool
+crude_json_cursor_get_bool_value
+(
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  return crude_json_cursor_get_type( cursor ) == CRUDE_JSON_TYPE_TRUE;
+}
+
+#ifdef CRUDE_JSON_SSE2
+uint32
+crude_json_bit_scan_forward_
+(
+  _In_ uint32                                              mask
+)
+{
+#if defined(_MSC_VER)
+  unsigned long                                            index;
+  _BitScanForward( &index, mask );
+  return index;
+#else
+  return __builtin_ctz( mask );
+#endif
+}
+
+uint32
+crude_json_bit_count_
+(
+  _In_ uint32                                              mask
+)
+{
+  mask = mask - ( ( mask >> 1 ) & 0x55555555u );
+  mask = ( mask & 0x33333333u ) + ( ( mask >> 2 ) & 0x33333333u );
+  return ( ( ( mask + ( mask >> 4 ) ) & 0x0F0F0F0Fu ) * 0x01010101u ) >> 24;
+}
+#endif
+
+uint32
+crude_json_count_values_upper_bound_
+(
+  _In_ char const                                         *buffer,
+  _In_ uint32                                              buffer_size
+)
+{
+  uint32                                                   count;
+  uint32                                                   i;
+
+  /* Characters inside of strings are counted too, it only makes the bound looser */
+  count = 0;
+  i = 0;
+
+#ifdef CRUDE_JSON_SSE2
+  __m128i                                                  comma, bracket, brace;
+
+  comma = _mm_set1_epi8( ',' );
+  bracket = _mm_set1_epi8( '[' );
+  brace = _mm_set1_epi8( '{' );
+
+  for ( ; i + 16 <= buffer_size; i += 16 )
+  {
+    __m128i                                                chunk;
+    __m128i                                                structural;
+
+    chunk = _mm_loadu_si128( CRUDE_REINTERPRET_CAST( __m128i const*, buffer + i ) );
+    structural = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( chunk, comma ), _mm_cmpeq_epi8( chunk, bracket ) ), _mm_cmpeq_epi8( chunk, brace ) );
+    count += crude_json_bit_count_( _mm_movemask_epi8( structural ) );
+  }
+#endif
+
+  for ( ; i < buffer_size; ++i )
+  {
+    if ( buffer[ i ] == ',' || buffer[ i ] == '[' || buffer[ i ] == '{' )
+    {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+void
+crude_json_skip_whitespaces_
+(
+  _In_ crude_json_parser                                  *parser
+)
+{
+#ifdef CRUDE_JSON_SSE2
+  __m128i                                                  space, tab, line_feed, carriage_return;
+
+  space = _mm_set1_epi8( ' ' );
+  tab = _mm_set1_epi8( '\t' );
+  line_feed = _mm_set1_epi8( '\n' );
+  carriage_return = _mm_set1_epi8( '\r' );
+
+  while ( parser->end - parser->position >= 16 )
+  {
+    __m128i                                                chunk;
+    __m128i                                                whitespace;
+    uint32                                                 mask;
+
+    chunk = _mm_loadu_si128( CRUDE_REINTERPRET_CAST( __m128i const*, parser->position ) );
+    whitespace = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( chunk, space ), _mm_cmpeq_epi8( chunk, tab ) ), _mm_or_si128( _mm_cmpeq_epi8( chunk, line_feed ), _mm_cmpeq_epi8( chunk, carriage_return ) ) );
+    mask = ~CRUDE_CAST( uint32, _mm_movemask_epi8( whitespace ) ) & 0xFFFFu;
+    if ( mask )
+    {
+      parser->position += crude_json_bit_scan_forward_( mask );
+      return;
+    }
+    parser->position += 16;
+  }
+#endif
+
+  while ( parser->position < parser->end && ( *parser->position == ' ' || *parser->position == '\t' || *parser->position == '\n' || *parser->position == '\r' ) )
+  {
+    ++parser->position;
+  }
+}
+
+bool
+crude_json_parse_value_
+(
+  _In_ crude_json_parser                                  *parser,
+  _In_opt_ char const                                     *key
+)
+{
+  crude_json_document                                     *document;
+  crude_json_value                                        *value;
+  uint32                                                   value_index;
+  bool                                                     result;
+
+  document = parser->document;
+
+  crude_json_skip_whitespaces_( parser );
+  if ( parser->position >= parser->end || document->values_count >= document->values_capacity )
+  {
+    document->error = parser->position;
+    return false;
+  }
+
+  value_index = document->values_count++;
+  value = &document->values[ value_index ];
+  value->key = key;
+  value->string = NULL;
+  value->string_length = 0;
+  value->children_count = 0;
+  value->next = 0;
+
+  switch ( *parser->position )
+  {
+  case '{':
+  {
+    value->type = CRUDE_JSON_TYPE_OBJECT;
+    result = crude_json_parse_container_( parser, value_index );
+    break;
+  }
+  case '[':
+  {
+    value->type = CRUDE_JSON_TYPE_ARRAY;
+    result = crude_json_parse_container_( parser, value_index );
+    break;
+  }
+  case '\"':
+  {
+    value->type = CRUDE_JSON_TYPE_STRING;
+    result = crude_json_parse_string_( parser, &value->string, &value->string_length );
+    break;
+  }
+  case 't':
+  {
+    value->type = CRUDE_JSON_TYPE_TRUE;
+    result = crude_json_parse_literal_( parser, "true", 4 );
+    break;
+  }
+  case 'f':
+  {
+    value->type = CRUDE_JSON_TYPE_FALSE;
+    result = crude_json_parse_literal_( parser, "false", 5 );
+    break;
+  }
+  case 'n':
+  {
+    value->type = CRUDE_JSON_TYPE_NULL;
+    result = crude_json_parse_literal_( parser, "null", 4 );
+    break;
+  }
+  default:
+  {
+    value->type = CRUDE_JSON_TYPE_NUMBER;
+    result = crude_json_parse_number_( parser, &value->number );
+    break;
+  }
+  }
+
+  if ( !result && !document->error )
+  {
+    document->error = parser->position;
+  }
+  return result;
+}
+
+bool
+crude_json_parse_container_
+(
+  _In_ crude_json_parser                                  *parser,
+  _In_ uint32                                              container_index
+)
+{
+  crude_json_document                                     *document;
+  char                                                     closing;
+  bool                                                     is_object;
+  uint32                                                   previous_child_index;
+
+  document = parser->document;
+  is_object = ( *parser->position == '{' );
+  closing = is_object ? '}' : ']';
+
+  if ( ++parser->depth > CRUDE_JSON_NESTING_LIMIT )
+  {
+    return false;
+  }
+
+  ++parser->position;
+  crude_json_skip_whitespaces_( parser );
+  if ( parser->position < parser->end && *parser->position == closing )
+  {
+    ++parser->position;
+    --parser->depth;
+    return true;
+  }
+
+  previous_child_index = 0;
+  while ( true )
+  {
+    char const                                            *key;
+    uint32                                                 key_length;
+    uint32                                                 child_index;
+
+    key = NULL;
+    if ( is_object )
+    {
+      crude_json_skip_whitespaces_( parser );
+      if ( parser->position >= parser->end || *parser->position != '\"' || !crude_json_parse_string_( parser, &key, &key_length ) )
+      {
+        return false;
+      }
+
+      crude_json_skip_whitespaces_( parser );
+      if ( parser->position >= parser->end || *parser->position != ':' )
+      {
+        return false;
+      }
+      ++parser->position;
+    }
+
+    child_index = document->values_count;
+    if ( !crude_json_parse_value_( parser, key ) )
+    {
+      return false;
+    }
+
+    if ( previous_child_index )
+    {
+      document->values[ previous_child_index ].next = child_index;
+    }
+    previous_child_index = child_index;
+    ++document->values[ container_index ].children_count;
+
+    crude_json_skip_whitespaces_( parser );
+    if ( parser->position >= parser->end )
+    {
+      return false;
+    }
+
+    if ( *parser->position == ',' )
+    {
+      ++parser->position;
+      continue;
+    }
+
+    if ( *parser->position == closing )
+    {
+      ++parser->position;
+      break;
+    }
+
+    return false;
+  }
+
+  --parser->depth;
+  return true;
+}
+
+bool
+crude_json_parse_string_
+(
+  _In_ crude_json_parser                                  *parser,
+  _Out_ char const                                       **string,
+  _Out_ uint32                                            *string_length
+)
+{
+  char                                                    *start;
+  char                                                    *read;
+  char                                                    *write;
+
+#ifdef CRUDE_JSON_SSE2
+  __m128i                                                  quote, backslash;
+
+  quote = _mm_set1_epi8( '\"' );
+  backslash = _mm_set1_epi8( '\\' );
+#endif
+
+  start = read = parser->position + 1;
+
+  /* Stays NULL until the first escape, after it characters are moved back to close the gap */
+  write = NULL;
+
+  while ( true )
+  {
+#ifdef CRUDE_JSON_SSE2
+    while ( parser->end - read >= 16 )
+    {
+      __m128i                                              chunk;
+      uint32                                               mask;
+      uint32                                               offset;
+
+      chunk = _mm_loadu_si128( CRUDE_REINTERPRET_CAST( __m128i const*, read ) );
+      mask = _mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8( chunk, quote ), _mm_cmpeq_epi8( chunk, backslash ) ) );
+      if ( mask )
+      {
+        offset = crude_json_bit_scan_forward_( mask );
+        if ( write )
+        {
+          memmove( write, read, offset );
+          write += offset;
+        }
+        read += offset;
+        break;
+      }
+
+      if ( write )
+      {
+        _mm_storeu_si128( CRUDE_REINTERPRET_CAST( __m128i*, write ), chunk );
+        write += 16;
+      }
+      read += 16;
+    }
+#endif
+
+    while ( read < parser->end && *read != '\"' && *read != '\\' )
+    {
+      if ( write )
+      {
+        *write++ = *read;
+      }
+      ++read;
+    }
+
+    if ( read >= parser->end )
+    {
+      parser->position = read;
+      return false;
+    }
+
+    if ( *read == '\"' )
+    {
+      break;
+    }
+
+    if ( !write )
+    {
+      write = read;
+    }
+
+    if ( !crude_json_parse_escape_( parser, &read, &write ) )
+    {
+      parser->position = read;
+      return false;
+    }
+  }
+
+  if ( !write )
+  {
+    write = read;
+  }
+
+  *write = 0;
+  *string = start;
+  *string_length = CRUDE_CAST( uint32, write - start );
+  parser->position = read + 1;
+  return true;
+}
+
+bool
+crude_json_parse_escape_
+(
+  _In_ crude_json_parser                                  *parser,
+  _Inout_ char                                           **read,
+  _Inout_ char                                           **write
+)
+{
+  char                                                    *r;
+  char                                                    *w;
+  uint32                                                   code;
+
+  r = *read;
+  w = *write;
+
+  if ( parser->end - r < 2 )
+  {
+    return false;
+  }
+
+  switch ( r[ 1 ] )
+  {
+  case '\"': *w++ = '\"'; break;
+  case '\\': *w++ = '\\'; break;
+  case '/': *w++ = '/'; break;
+  case 'b': *w++ = '\b'; break;
+  case 'f': *w++ = '\f'; break;
+  case 'n': *w++ = '\n'; break;
+  case 'r': *w++ = '\r'; break;
+  case 't': *w++ = '\t'; break;
+  case 'u':
+  {
+    if ( parser->end - r < 6 || !crude_json_parse_hex4_( r + 2, &code ) )
+    {
+      return false;
+    }
+    r += 4;
+
+    /* Surrogate pair */
+    if ( code >= 0xD800 && code <= 0xDBFF )
+    {
+      uint32                                               low_code;
+
+      if ( parser->end - r < 8 || r[ 2 ] != '\\' || r[ 3 ] != 'u' || !crude_json_parse_hex4_( r + 4, &low_code ) || low_code < 0xDC00 || low_code > 0xDFFF )
+      {
+        return false;
+      }
+      code = 0x10000 + ( ( ( code & 0x3FF ) << 10 ) | ( low_code & 0x3FF ) );
+      r += 6;
+    }
+    else if ( code >= 0xDC00 && code <= 0xDFFF )
+    {
+      return false;
+    }
+
+    if ( code < 0x80 )
+    {
+      *w++ = CRUDE_CAST( char, code );
+    }
+    else if ( code < 0x800 )
+    {
+      *w++ = CRUDE_CAST( char, 0xC0 | ( code >> 6 ) );
+      *w++ = CRUDE_CAST( char, 0x80 | ( code & 0x3F ) );
+    }
+    else if ( code < 0x10000 )
+    {
+      *w++ = CRUDE_CAST( char, 0xE0 | ( code >> 12 ) );
+      *w++ = CRUDE_CAST( char, 0x80 | ( ( code >> 6 ) & 0x3F ) );
+      *w++ = CRUDE_CAST( char, 0x80 | ( code & 0x3F ) );
+    }
+    else
+    {
+      *w++ = CRUDE_CAST( char, 0xF0 | ( code >> 18 ) );
+      *w++ = CRUDE_CAST( char, 0x80 | ( ( code >> 12 ) & 0x3F ) );
+      *w++ = CRUDE_CAST( char, 0x80 | ( ( code >> 6 ) & 0x3F ) );
+      *w++ = CRUDE_CAST( char, 0x80 | ( code & 0x3F ) );
+    }
+    break;
+  }
+  default:
+  {
+    return false;
+  }
+  }
+
+  *read = r + 2;
+  *write = w;
+  return true;
+}
+
+bool
+crude_json_parse_number_
+(
+  _In_ crude_json_parser                                  *parser,
+  _Out_ float64                                           *number
+)
+{
+  static float64 const                                     powers_of_ten[ ] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  char const                                              *c;
+  char                                                    *number_end;
+  uint64                                                   mantissa;
+  int32                                                    mantissa_digits;
+  int32                                                    exponent;
+  bool                                                     negative;
+
+  c = parser->position;
+  negative = ( *c == '-' );
+  if ( negative )
+  {
+    ++c;
+  }
+
+  if ( c >= parser->end || *c < '0' || *c > '9' )
+  {
+    return false;
+  }
+
+  /* Exact when the mantissa and the power of ten fit into a double (Clinger's fast path), strtod handles the rest */
+  mantissa = 0;
+  mantissa_digits = 0;
+  exponent = 0;
+
+  while ( c < parser->end && *c >= '0' && *c <= '9' )
+  {
+    mantissa = mantissa * 10 + ( *c - '0' );
+    mantissa_digits += ( mantissa != 0 );
+    ++c;
+  }
+
+  if ( c < parser->end && *c == '.' )
+  {
+    ++c;
+    while ( c < parser->end && *c >= '0' && *c <= '9' )
+    {
+      mantissa = mantissa * 10 + ( *c - '0' );
+      mantissa_digits += ( mantissa != 0 );
+      --exponent;
+      ++c;
+    }
+  }
+
+  if ( c < parser->end && ( *c == 'e' || *c == 'E' ) )
+  {
+    int32                                                  explicit_exponent;
+    bool                                                   exponent_negative;
+
+    ++c;
+    exponent_negative = false;
+    if ( c < parser->end && ( *c == '-' || *c == '+' ) )
+    {
+      exponent_negative = ( *c == '-' );
+      ++c;
+    }
+
+    if ( c >= parser->end || *c < '0' || *c > '9' )
+    {
+      return false;
+    }
+
+    explicit_exponent = 0;
+    while ( c < parser->end && *c >= '0' && *c <= '9' )
+    {
+      if ( explicit_exponent < 100000 )
+      {
+        explicit_exponent = explicit_exponent * 10 + ( *c - '0' );
+      }
+      ++c;
+    }
+    exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+  }
+
+  if ( mantissa_digits <= 15 && exponent >= -22 && exponent <= 22 )
+  {
+    *number = CRUDE_CAST( float64, mantissa );
+    *number = ( exponent < 0 ) ? *number / powers_of_ten[ -exponent ] : *number * powers_of_ten[ exponent ];
+    *number = negative ? -*number : *number;
+    parser->position = CRUDE_CAST( char*, c );
+    return true;
+  }
+
+  *number = strtod( parser->position, &number_end );
+  if ( number_end != c )
+  {
+    return false;
+  }
+
+  parser->position = number_end;
+  return true;
+}
+
+bool
+crude_json_parse_hex4_
+(
+  _In_ char const                                         *hex,
+  _Out_ uint32                                            *code
+)
+{
+  *code = 0;
+  for ( uint32 i = 0; i < 4; ++i )
+  {
+    *code <<= 4;
+    if ( hex[ i ] >= '0' && hex[ i ] <= '9' )
+    {
+      *code |= hex[ i ] - '0';
+    }
+    else if ( hex[ i ] >= 'a' && hex[ i ] <= 'f' )
+    {
+      *code |= hex[ i ] - 'a' + 10;
+    }
+    else if ( hex[ i ] >= 'A' && hex[ i ] <= 'F' )
+    {
+      *code |= hex[ i ] - 'A' + 10;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+crude_json_parse_literal_
+(
+  _In_ crude_json_parser                                  *parser,
+  _In_ char const                                         *literal,
+  _In_ uint32                                              literal_length
+)
+{
+  if ( parser->end - parser->position < literal_length || strncmp( parser->position, literal, literal_length ) != 0 )
+  {
+    return false;
+  }
+  parser->position += literal_length;
+  return true;
+}
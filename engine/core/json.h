@@ -0,0 +1,177 @@
+#pragma once
+
+#include <engine/core/memory.h>
+
+#define CRUDE_JSON_NESTING_LIMIT                                   1000
+
+typedef enum crude_json_type
+{
+  CRUDE_JSON_TYPE_INVALID,
+  CRUDE_JSON_TYPE_NULL,
+  CRUDE_JSON_TYPE_FALSE,
+  CRUDE_JSON_TYPE_TRUE,
+  CRUDE_JSON_TYPE_NUMBER,
+  CRUDE_JSON_TYPE_STRING,
+  CRUDE_JSON_TYPE_ARRAY,
+  CRUDE_JSON_TYPE_OBJECT,
+} crude_json_type;
+
+/**
+ * Values are stored in pre-order, the first child follows its container and
+ * next is the index of the next sibling (0 for the last one). Keys and
+ * strings point into the parsed buffer.
+ */
+typedef struct crude_json_value
+{
+  char const                                              *key;
+  union
+  {
+    char const                                            *string;
+    float64                                                number;
+  };
+  uint32                                                   string_length;
+  uint32                                                   children_count;
+  uint32                                                   next;
+  uint8                                                    type;
+} crude_json_value;
+
+typedef struct crude_json_document
+{
+  crude_json_value                                        *values;
+  uint32                                                   values_count;
+  uint32                                                   values_capacity;
+  char const                                              *buffer;
+  char const                                              *error;
+  crude_allocator_container                                allocator_container;
+} crude_json_document;
+
+typedef struct crude_json_cursor
+{
+  crude_json_document const                               *document;
+  uint32                                                   index;
+} crude_json_cursor;
+
+#define CRUDE_JSON_CURSOR_FOR_EACH( element, container )\
+for ( element = crude_json_cursor_get_child( container ); crude_json_cursor_valid( element ); element = crude_json_cursor_get_next( element ) )
+
+/**
+ * Parses in place, strings are unescaped and null terminated inside of the buffer,
+ * so it has to be writable, null terminated (crude_read_file does it) and outlive
+ * the document. All values are allocated at once.
+ */
+CRUDE_API bool
+crude_json_document_parse
+(
+  _Out_ crude_json_document                               *document,
+  _In_ char                                               *buffer,
+  _In_ uint32                                              buffer_size,
+  _In_ crude_allocator_container                           allocator_container
+);
+
+CRUDE_API void
+crude_json_document_deinitialize
+(
+  _In_ crude_json_document                                *document
+);
+
+/* Byte offset in the buffer where parsing stopped */
+CRUDE_API uint32
+crude_json_document_get_error_offset
+(
+  _In_ crude_json_document const                          *document
+);
+
+CRUDE_API crude_json_cursor
+crude_json_document_get_root
+(
+  _In_ crude_json_document const                          *document
+);
+
+/* Getters accept invalid cursors, so lookups can be chained like cJSON ones */
+CRUDE_API bool
+crude_json_cursor_valid
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API crude_json_type
+crude_json_cursor_get_type
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API bool
+crude_json_cursor_is_array
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API bool
+crude_json_cursor_is_string
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API crude_json_cursor
+crude_json_cursor_get_object_item
+(
+  _In_ crude_json_cursor                                   cursor,
+  _In_ char const                                         *key
+);
+
+CRUDE_API crude_json_cursor
+crude_json_cursor_get_array_item
+(
+  _In_ crude_json_cursor                                   cursor,
+  _In_ uint32                                              index
+);
+
+CRUDE_API uint32
+crude_json_cursor_get_array_size
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API crude_json_cursor
+crude_json_cursor_get_child
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API crude_json_cursor
+crude_json_cursor_get_next
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API char const*
+crude_json_cursor_get_key
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+/* NULL if the value isn't a string */
+CRUDE_API char const*
+crude_json_cursor_get_string_value
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API uint32
+crude_json_cursor_get_string_length
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+/* NAN if the value isn't a number */
+CRUDE_API float64
+crude_json_cursor_get_number_value
+(
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API bool
+crude_json_cursor_get_bool_value
+(
+  _In_ crude_json_cursor                                   cursor
+);
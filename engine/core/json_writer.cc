@@ -0,0 +1,438 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <engine/core/assert.h>
+#include <engine/core/string.h>
+#include <engine/core/file.h>
+
+#include <engine/core/json_writer.h>
+
+static void
+crude_json_writer_flush_
+(
+  _In_ crude_json_writer                                  *writer
+);
+
+static void
+crude_json_writer_write_
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ char const                                         *data,
+  _In_ uint32                                              size
+);
+
+static void
+crude_json_writer_write_tabs_
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ uint32                                              count
+);
+
+static void
+crude_json_writer_begin_value_
+(
+  _In_ crude_json_writer                                  *writer
+);
+
+static void
+crude_json_writer_write_string_
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ char const                                         *value
+);
+
+bool
+crude_json_writer_initialize
+(
+  _Out_ crude_json_writer                                 *writer,
+  _In_ char const                                         *absolute_filepath
+)
+{
+  crude_string_copy( writer->filepath, absolute_filepath, sizeof( writer->filepath ) );
+  crude_snprintf( writer->temporary_filepath, sizeof( writer->temporary_filepath ), "%s.tmp", absolute_filepath );
+
+  writer->file = fopen( writer->temporary_filepath, "wb" );
+  writer->buffer_occupied = 0;
+  writer->depth = 0;
+  writer->failed = ( writer->file == NULL );
+  return !writer->failed;
+}
+
+bool
+crude_json_writer_deinitialize
+(
+  _In_ crude_json_writer                                  *writer
+)
+{
+  if ( writer->file )
+  {
+    crude_json_writer_flush_( writer );
+    if ( fflush( CRUDE_REINTERPRET_CAST( FILE*, writer->file ) ) != 0 )
+    {
+      writer->failed = true;
+    }
+    if ( fclose( CRUDE_REINTERPRET_CAST( FILE*, writer->file ) ) != 0 )
+    {
+      writer->failed = true;
+    }
+    writer->file = NULL;
+
+    if ( writer->failed || !crude_file_replace( writer->temporary_filepath, writer->filepath ) )
+    {
+      writer->failed = true;
+      crude_file_delete( writer->temporary_filepath );
+    }
+  }
+  return !writer->failed;
+}
+
+void
+crude_json_writer_begin_object
+(
+  _In_ crude_json_writer                                  *writer
+)
+{
+  CRUDE_ASSERT( writer->depth < CRUDE_JSON_WRITER_DEPTH_MAX );
+
+  crude_json_writer_begin_value_( writer );
+  crude_json_writer_write_( writer, "{\n", 2 );
+  writer->scope_is_array[ writer->depth ] = false;
+  writer->scope_empty[ writer->depth ] = true;
+  ++writer->depth;
+}
+
+void
+crude_json_writer_end_object
+(
+  _In_ crude_json_writer                                  *writer
+)
+{
+  CRUDE_ASSERT( writer->depth && !writer->scope_is_array[ writer->depth - 1 ] );
+
+  --writer->depth;
+  if ( !writer->scope_empty[ writer->depth ] )
+  {
+    crude_json_writer_write_( writer, "\n", 1 );
+  }
+  crude_json_writer_write_tabs_( writer, writer->depth );
+  crude_json_writer_write_( writer, "}", 1 );
+}
+
+void
+crude_json_writer_begin_array
+(
+  _In_ crude_json_writer                                  *writer
+)
+{
+  CRUDE_ASSERT( writer->depth < CRUDE_JSON_WRITER_DEPTH_MAX );
+
+  crude_json_writer_begin_value_( writer );
+  crude_json_writer_write_( writer, "[", 1 );
+  writer->scope_is_array[ writer->depth ] = true;
+  writer->scope_empty[ writer->depth ] = true;
+  ++writer->depth;
+}
+
+void
+crude_json_writer_end_array
+(
+  _In_ crude_json_writer                                  *writer
+)
+{
+  CRUDE_ASSERT( writer->depth && writer->scope_is_array[ writer->depth - 1 ] );
+
+  --writer->depth;
+  crude_json_writer_write_( writer, "]", 1 );
+}
+
+void
+crude_json_writer_key
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ char const                                         *key
+)
+{
+  CRUDE_ASSERT( writer->depth && !writer->scope_is_array[ writer->depth - 1 ] );
+
+  if ( !writer->scope_empty[ writer->depth - 1 ] )
+  {
+    crude_json_writer_write_( writer, ",\n", 2 );
+  }
+  writer->scope_empty[ writer->depth - 1 ] = false;
+
+  crude_json_writer_write_tabs_( writer, writer->depth );
+  crude_json_writer_write_string_( writer, key );
+  crude_json_writer_write_( writer, ":\t", 2 );
+}
+
+void
+crude_json_writer_string
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ char const                                         *value
+)
+{
+  crude_json_writer_begin_value_( writer );
+  crude_json_writer_write_string_( writer, value );
+}
+
+void
+crude_json_writer_number
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ float64                                             value
+)
+{
+  char                                                     number_buffer[ 32 ];
+  int32                                                    number_length;
+
+  crude_json_writer_begin_value_( writer );
+
+  /* Same rules as cJSON print_number */
+  if ( isnan( value ) || isinf( value ) )
+  {
+    number_length = snprintf( number_buffer, sizeof( number_buffer ), "null" );
+  }
+  else if ( fabs( value ) < 2147483647.0 && value == CRUDE_CAST( float64, CRUDE_CAST( int32, value ) ) )
+  {
+    number_length = snprintf( number_buffer, sizeof( number_buffer ), "%d", CRUDE_CAST( int32, value ) );
+  }
+  else
+  {
+    number_length = snprintf( number_buffer, sizeof( number_buffer ), "%1.15g", value );
+    if ( strtod( number_buffer, NULL ) != value )
+    {
+      number_length = snprintf( number_buffer, sizeof( number_buffer ), "%1.17g", value );
+    }
+  }
+
+  crude_json_writer_write_( writer, number_buffer, number_length );
+}
+
+void
+crude_json_writer_bool
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ bool                                                value
+)
+{
+  crude_json_writer_begin_value_( writer );
+  if ( value )
+  {
+    crude_json_writer_write_( writer, "true", 4 );
+  }
+  else
+  {
+    crude_json_writer_write_( writer, "false", 5 );
+  }
+}
+
+void
+crude_json_writer_null
+(
+  _In_ crude_json_writer                                  *writer
+)
+{
+  crude_json_writer_begin_value_( writer );
+  crude_json_writer_write_( writer, "null", 4 );
+}
+
+void
+crude_json_writer_cjson
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ cJSON const                                        *json
+)
+{
+  cJSON const                                             *child;
+
+  switch ( json->type & 0xFF )
+  {
+  case cJSON_Object:
+  {
+    crude_json_writer_begin_object( writer );
+    for ( child = json->child; child; child = child->next )
+    {
+      crude_json_writer_key( writer, child->string );
+      crude_json_writer_cjson( writer, child );
+    }
+    crude_json_writer_end_object( writer );
+    break;
+  }
+  case cJSON_Array:
+  {
+    crude_json_writer_begin_array( writer );
+    for ( child = json->child; child; child = child->next )
+    {
+      crude_json_writer_cjson( writer, child );
+    }
+    crude_json_writer_end_array( writer );
+    break;
+  }
+  case cJSON_String:
+  {
+    crude_json_writer_string( writer, json->valuestring );
+    break;
+  }
+  case cJSON_Number:
+  {
+    crude_json_writer_number( writer, json->valuedouble );
+    break;
+  }
+  case cJSON_True:
+  case cJSON_False:
+  {
+    crude_json_writer_bool( writer, json->type & cJSON_True );
+    break;
+  }
+  case cJSON_Raw:
+  {
+    crude_json_writer_begin_value_( writer );
+    crude_json_writer_write_( writer, json->valuestring, crude_string_length( json->valuestring ) );
+    break;
+  }
+  default:
+  {
+    crude_json_writer_null( writer );
+    break;
+  }
+  }
+}
+
+void
+crude_json_writer_flush_
+(
+  _In_ crude_json_writer                                  *writer
+)
+{
+  if ( writer->buffer_occupied && !writer->failed )
+  {
+    if ( fwrite( writer->buffer, 1, writer->buffer_occupied, CRUDE_REINTERPRET_CAST( FILE*, writer->file ) ) != writer->buffer_occupied )
+    {
+      writer->failed = true;
+    }
+  }
+  writer->buffer_occupied = 0;
+}
+
+void
+crude_json_writer_write_
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ char const                                         *data,
+  _In_ uint32                                              size
+)
+{
+  if ( writer->failed )
+  {
+    return;
+  }
+
+  if ( writer->buffer_occupied + size > sizeof( writer->buffer ) )
+  {
+    crude_json_writer_flush_( writer );
+  }
+
+  if ( size > sizeof( writer->buffer ) )
+  {
+    if ( fwrite( data, 1, size, CRUDE_REINTERPRET_CAST( FILE*, writer->file ) ) != size )
+    {
+      writer->failed = true;
+    }
+    return;
+  }
+
+  crude_memory_copy( writer->buffer + writer->buffer_occupied, data, size );
+  writer->buffer_occupied += size;
+}
+
+void
+crude_json_writer_write_tabs_
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ uint32                                              count
+)
+{
+  for ( uint32 i = 0; i < count; ++i )
+  {
+    crude_json_writer_write_( writer, "\t", 1 );
+  }
+}
+
+void
+crude_json_writer_begin_value_
+(
+  _In_ crude_json_writer                                  *writer
+)
+{
+  if ( writer->depth == 0 || !writer->scope_is_array[ writer->depth - 1 ] )
+  {
+    return;
+  }
+
+  if ( !writer->scope_empty[ writer->depth - 1 ] )
+  {
+    crude_json_writer_write_( writer, ", ", 2 );
+  }
+  writer->scope_empty[ writer->depth - 1 ] = false;
+}
+
+void
+crude_json_writer_write_string_
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ char const                                         *value
+)
+{
+  char const                                              *run_start;
+  char                                                     escape_buffer[ 8 ];
+
+  crude_json_writer_write_( writer, "\"", 1 );
+
+  if ( value )
+  {
+    run_start = value;
+    for ( char const *c = value; *c; ++c )
+    {
+      uint8                                                character;
+      char const                                          *escape;
+      uint32                                               escape_length;
+
+      character = CRUDE_CAST( uint8, *c );
+      escape = NULL;
+      escape_length = 2;
+
+      switch ( character )
+      {
+      case '\"': escape = "\\\""; break;
+      case '\\': escape = "\\\\"; break;
+      case '\b': escape = "\\b"; break;
+      case '\f': escape = "\\f"; break;
+      case '\n': escape = "\\n"; break;
+      case '\r': escape = "\\r"; break;
+      case '\t': escape = "\\t"; break;
+      default:
+      {
+        if ( character < 32 )
+        {
+          snprintf( escape_buffer, sizeof( escape_buffer ), "\\u%04x", character );
+          escape = escape_buffer;
+          escape_length = 6;
+        }
+        break;
+      }
+      }
+
+      if ( escape )
+      {
+        crude_json_writer_write_( writer, run_start, CRUDE_CAST( uint32, c - run_start ) );
+        crude_json_writer_write_( writer, escape, escape_length );
+        run_start = c + 1;
+      }
+    }
+    crude_json_writer_write_( writer, run_start, crude_string_length( run_start ) );
+  }
+
+  crude_json_writer_write_( writer, "\"", 1 );
+}
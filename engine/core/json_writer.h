@@ -0,0 +1,107 @@
+#pragma once
+
+#include <thirdparty/cJSON/cJSON.h>
+
+#include <engine/core/memory.h>
+
+#define CRUDE_JSON_WRITER_BUFFER_SIZE                              CRUDE_RKILO( 64 )
+#define CRUDE_JSON_WRITER_DEPTH_MAX                                64
+#define CRUDE_JSON_WRITER_FILEPATH_LENGTH_MAX                      1024
+
+/**
+ * Streaming json writer, output is flushed to the file through a fixed buffer.
+ * Formatting matches cJSON_Print, so saved files don't change between writers.
+ * Output goes to "<filepath>.tmp", which replaces the file only once it is
+ * completely written, so a failed write keeps the original.
+ */
+typedef struct crude_json_writer
+{
+  void                                                    *file;
+  char                                                     filepath[ CRUDE_JSON_WRITER_FILEPATH_LENGTH_MAX ];
+  char                                                     temporary_filepath[ CRUDE_JSON_WRITER_FILEPATH_LENGTH_MAX ];
+  char                                                     buffer[ CRUDE_JSON_WRITER_BUFFER_SIZE ];
+  uint32                                                   buffer_occupied;
+  uint32                                                   depth;
+  bool                                                     scope_is_array[ CRUDE_JSON_WRITER_DEPTH_MAX ];
+  bool                                                     scope_empty[ CRUDE_JSON_WRITER_DEPTH_MAX ];
+  bool                                                     failed;
+} crude_json_writer;
+
+CRUDE_API bool
+crude_json_writer_initialize
+(
+  _Out_ crude_json_writer                                 *writer,
+  _In_ char const                                         *absolute_filepath
+);
+
+/* Returns false if anything failed to be written */
+CRUDE_API bool
+crude_json_writer_deinitialize
+(
+  _In_ crude_json_writer                                  *writer
+);
+
+CRUDE_API void
+crude_json_writer_begin_object
+(
+  _In_ crude_json_writer                                  *writer
+);
+
+CRUDE_API void
+crude_json_writer_end_object
+(
+  _In_ crude_json_writer                                  *writer
+);
+
+CRUDE_API void
+crude_json_writer_begin_array
+(
+  _In_ crude_json_writer                                  *writer
+);
+
+CRUDE_API void
+crude_json_writer_end_array
+(
+  _In_ crude_json_writer                                  *writer
+);
+
+CRUDE_API void
+crude_json_writer_key
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ char const                                         *key
+);
+
+CRUDE_API void
+crude_json_writer_string
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ char const                                         *value
+);
+
+CRUDE_API void
+crude_json_writer_number
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ float64                                             value
+);
+
+CRUDE_API void
+crude_json_writer_bool
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ bool                                                value
+);
+
+CRUDE_API void
+crude_json_writer_null
+(
+  _In_ crude_json_writer                                  *writer
+);
+
+CRUDE_API void
+crude_json_writer_cjson
+(
+  _In_ crude_json_writer                                  *writer,
+  _In_ cJSON const                                        *json
+);
@@ -28,6 +28,34 @@ crude_random_unit_f32
   return CRUDE_CAST( float32, ( rand( ) - RAND_MAX / 2 ) ) / ( RAND_MAX / 2 );
 }
 
+void
+crude_random_initialize
+(
+  _Out_ crude_random                                      *random,
+  _In_ uint64                                              seed
+)
+{
+  /* Xorshift state must not be zero, splitmix64 scatters close seeds too */
+  seed += 0x9E3779B97F4A7C15ull;
+  seed = ( seed ^ ( seed >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+  seed = ( seed ^ ( seed >> 27 ) ) * 0x94D049BB133111EBull;
+  seed = seed ^ ( seed >> 31 );
+  random->state = seed ? seed : 0x9E3779B97F4A7C15ull;
+}
+
+uint32
+crude_random_next_u32
+(
+  _Inout_ crude_random                                    *random
+)
+{
+  /* xorshift64* */
+  random->state ^= random->state >> 12;
+  random->state ^= random->state << 25;
+  random->state ^= random->state >> 27;
+  return CRUDE_CAST( uint32, ( random->state * 0x2545F4914F6CDD1Dull ) >> 32 );
+}
+
 float32
 crude_lerp_angle
 (
@@ -349,4 +377,64 @@ crude_parse_json_to_float4
   float4->y = CRUDE_STATIC_CAST( float32, cJSON_GetNumberValue( cJSON_GetArrayItem( json, 1 ) ) );
   float4->z = CRUDE_STATIC_CAST( float32, cJSON_GetNumberValue( cJSON_GetArrayItem( json, 2 ) ) );
   float4->w = CRUDE_STATIC_CAST( float32, cJSON_GetNumberValue( cJSON_GetArrayItem( json, 3 ) ) );
+}
+
+void
+crude_parse_json_cursor_to_float2
+(
+  _Out_ XMFLOAT2                                          *float2,
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  crude_json_cursor                                        element;
+
+  CRUDE_ASSERT( crude_json_cursor_get_array_size( cursor ) == 2 );
+
+  /* Walk the siblings once instead of looking up every item by index */
+  element = crude_json_cursor_get_child( cursor );
+  float2->x = CRUDE_STATIC_CAST( float32, crude_json_cursor_get_number_value( element ) );
+  element = crude_json_cursor_get_next( element );
+  float2->y = CRUDE_STATIC_CAST( float32, crude_json_cursor_get_number_value( element ) );
+}
+
+void
+crude_parse_json_cursor_to_float3
+(
+  _Out_ XMFLOAT3                                          *float3,
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  crude_json_cursor                                        element;
+
+  CRUDE_ASSERT( crude_json_cursor_get_array_size( cursor ) == 3 );
+
+  /* Walk the siblings once instead of looking up every item by index */
+  element = crude_json_cursor_get_child( cursor );
+  float3->x = CRUDE_STATIC_CAST( float32, crude_json_cursor_get_number_value( element ) );
+  element = crude_json_cursor_get_next( element );
+  float3->y = CRUDE_STATIC_CAST( float32, crude_json_cursor_get_number_value( element ) );
+  element = crude_json_cursor_get_next( element );
+  float3->z = CRUDE_STATIC_CAST( float32, crude_json_cursor_get_number_value( element ) );
+}
+
+void
+crude_parse_json_cursor_to_float4
+(
+  _Out_ XMFLOAT4                                          *float4,
+  _In_ crude_json_cursor                                   cursor
+)
+{
+  crude_json_cursor                                        element;
+
+  CRUDE_ASSERT( crude_json_cursor_get_array_size( cursor ) == 4 );
+
+  /* Walk the siblings once instead of looking up every item by index */
+  element = crude_json_cursor_get_child( cursor );
+  float4->x = CRUDE_STATIC_CAST( float32, crude_json_cursor_get_number_value( element ) );
+  element = crude_json_cursor_get_next( element );
+  float4->y = CRUDE_STATIC_CAST( float32, crude_json_cursor_get_number_value( element ) );
+  element = crude_json_cursor_get_next( element );
+  float4->z = CRUDE_STATIC_CAST( float32, crude_json_cursor_get_number_value( element ) );
+  element = crude_json_cursor_get_next( element );
+  float4->w = CRUDE_STATIC_CAST( float32, crude_json_cursor_get_number_value( element ) );
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <math.h>
 
 #include <engine/core/alias.h>
+#include <engine/core/json.h>
 
 #define CRUDE_RIGHT_HAND 1
 
@@ -16,6 +17,7 @@ using namespace DirectX;
 #define CRUDE_MAX( a, b ) fmaxf( a, b )
 #define CRUDE_MIN( a, b ) fminf( a, b )
 #define CRUDE_MIN_INT( a, b ) ( ( ( a ) < ( b ) ) ? ( a ) : ( b ) )
+#define CRUDE_MAX_INT( a, b ) ( ( ( a ) > ( b ) ) ? ( a ) : ( b ) )
 #define CRUDE_CLAMP( x, u, l ) CRUDE_MIN( u, CRUDE_MAX( x, l ) )
 #define CRUDE_DEG_TO_RAD( x ) ( XMConvertToRadians( x ) ) 
 #define CRUDE_RAD_TO_DEG( x ) ( XMConvertToDegrees( x ) ) 
@@ -29,11 +31,31 @@ crude_quaternion_to_pitch_yaw_roll
   _In_ FXMVECTOR                                           quaternion
 );
 
+/* Uses rand( ), for effects only, gameplay draws from crude_random */
 CRUDE_API float32
 crude_random_unit_f32
 (
 );
 
+/* Deterministic generator owned by its user, the same seed always gives the same sequence */
+typedef struct crude_random
+{
+  uint64                                                   state;
+} crude_random;
+
+CRUDE_API void
+crude_random_initialize
+(
+  _Out_ crude_random                                      *random,
+  _In_ uint64                                              seed
+);
+
+CRUDE_API uint32
+crude_random_next_u32
+(
+  _Inout_ crude_random                                    *random
+);
+
 CRUDE_API float32
 crude_lerp_angle
 (
@@ -160,4 +182,25 @@ crude_parse_json_to_float4
 (
   _Out_ XMFLOAT4                                          *float4,
   _In_ cJSON                                              *json
+);
+
+CRUDE_API void
+crude_parse_json_cursor_to_float2
+(
+  _Out_ XMFLOAT2                                          *float2,
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API void
+crude_parse_json_cursor_to_float3
+(
+  _Out_ XMFLOAT3                                          *float3,
+  _In_ crude_json_cursor                                   cursor
+);
+
+CRUDE_API void
+crude_parse_json_cursor_to_float4
+(
+  _Out_ XMFLOAT4                                          *float4,
+  _In_ crude_json_cursor                                   cursor
 );
\ No newline at end of file
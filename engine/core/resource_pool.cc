@@ -82,6 +82,41 @@ crude_resource_pool_release_resource
   --resource_pool->used_indices;
 }
 
+void
+crude_resource_pool_grow
+(
+  _In_ crude_resource_pool                                *resource_pool,
+  _In_ uint32                                              pool_size
+)
+{
+  uint8                                                   *memory;
+  uint32                                                  *free_indices;
+  uint64                                                   allocation_size;
+
+  if ( pool_size <= resource_pool->pool_size )
+  {
+    return;
+  }
+
+  allocation_size = CRUDE_CAST( uint64, pool_size ) * ( resource_pool->resource_size + sizeof( uint32 ) );
+  memory = CRUDE_REINTERPRET_CAST( uint8*, CRUDE_ALLOCATE( resource_pool->allocator, allocation_size ) );
+  memset( memory, 0, allocation_size );
+  memcpy( memory, resource_pool->memory, resource_pool->pool_size * resource_pool->resource_size );
+
+  /* Indices after the head are free, new indices go right after them */
+  free_indices = CRUDE_REINTERPRET_CAST( uint32*, memory + pool_size * resource_pool->resource_size );
+  memcpy( free_indices, resource_pool->free_indices, resource_pool->pool_size * sizeof( uint32 ) );
+  for ( uint32 i = resource_pool->pool_size; i < pool_size; ++i )
+  {
+    free_indices[ i ] = i;
+  }
+
+  CRUDE_DEALLOCATE( resource_pool->allocator, resource_pool->memory );
+  resource_pool->memory = memory;
+  resource_pool->free_indices = free_indices;
+  resource_pool->pool_size = pool_size;
+}
+
 void
 crude_resource_pool_free_all_resource
 (
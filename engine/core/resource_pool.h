@@ -43,6 +43,14 @@ crude_resource_pool_release_resource
   _In_ uint32                                              index
 );
 
+/* Resources are moved to the new memory, pointers to them become invalid */
+CRUDE_API void
+crude_resource_pool_grow
+(
+  _In_ crude_resource_pool                                *resource_pool,
+  _In_ uint32                                              pool_size
+);
+
 CRUDE_API void
 crude_resource_pool_free_all_resource
 (
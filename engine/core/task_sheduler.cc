@@ -124,4 +124,15 @@ crude_task_sheduler_start_task_set
 {
   enkiTaskSet *task_set = CRUDE_CAST( enkiTaskSet*, handle.data );
   enkiAddTaskSet( sheduler->enki_task_sheduler, task_set );
+}
+
+bool
+crude_task_sheduler_is_task_set_complete
+(
+  _In_ crude_task_sheduler                                *sheduler,
+  _In_ crude_task_set_handle                               handle
+)
+{
+  enkiTaskSet *task_set = CRUDE_CAST( enkiTaskSet*, handle.data );
+  return enkiIsTaskSetComplete( sheduler->enki_task_sheduler, task_set );
 }
\ No newline at end of file
@@ -68,6 +68,13 @@ crude_task_sheduler_wait_task_set
 
 CRUDE_API void
 crude_task_sheduler_start_task_set
+(
+  _In_ crude_task_sheduler                                *sheduler,
+  _In_ crude_task_set_handle                               handle
+);
+
+CRUDE_API bool
+crude_task_sheduler_is_task_set_complete
 (
   _In_ crude_task_sheduler                                *sheduler,
   _In_ crude_task_set_handle                               handle
@@ -259,7 +259,7 @@ crude_editor_update
   crude_gui_debug_update( &editor->debug );
   crude_gui_texture_inspector_update( &editor->texture_inspector );
 
-  if ( CRUDE_ECS_EDITOR_STAGE_IS_ENABLED( editor->engine->world ) )
+  if ( CRUDE_ECS_EDITOR_STAGE_IS_ENABLED( editor->engine->world ) && crude_entity_valid( editor->engine->world, editor->engine->main_node ) )
   {
     crude_editor_blend_animations_from_node_( &editor->engine->scene_renderer, editor->engine->world, editor->engine->main_node, delta_time );
   }
@@ -343,9 +343,9 @@ crude_editor_start_game
   CRUDE_ECS_GAME_STAGE_ENABLE( editor->engine->world, true );
   CRUDE_ECS_EDITOR_STAGE_ENABLE( editor->engine->world, false );
   
-  crude_node_manager_save_node_to_file( &editor->engine->node_manager, editor->engine->world, editor->engine->main_node, "___crude_engine_autosave/autosave.crude_node" );
+  /* Edited main node is snapshotted in memory, stop_game restores it with the restart command */
+  crude_engine_commands_manager_push_snapshot_node_command( &editor->engine->commands_manager );
   crude_physics_enable_simulation( &editor->engine->physics, editor->engine->world, true );
-  crude_engine_commands_manager_push_load_node_command( &editor->engine->commands_manager, "___crude_engine_autosave/autosave.crude_node" );
 }
 
 void
@@ -356,7 +356,7 @@ crude_editor_stop_game
 {
   CRUDE_ECS_EDITOR_STAGE_ENABLE( editor->engine->world, true );
   CRUDE_ECS_GAME_STAGE_ENABLE( editor->engine->world, false );
-  crude_engine_commands_manager_push_load_node_command( &editor->engine->commands_manager, "___crude_engine_autosave/autosave.crude_node" );
+  crude_engine_commands_manager_push_restart_node_command( &editor->engine->commands_manager );
   editor->engine->camera_node = editor->editor_camera_node;
   crude_physics_enable_simulation( &editor->engine->physics, editor->engine->world, false );
 }
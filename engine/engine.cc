@@ -70,6 +70,18 @@ crude_engine_deinitialize_platform_
   _In_ crude_engine                                       *engine
 );
 
+static void
+crude_engine_initialize_input_replay_
+(
+  _In_ crude_engine                                       *engine
+);
+
+static void
+crude_engine_deinitialize_input_replay_
+(
+  _In_ crude_engine                                       *engine
+);
+
 static void
 crude_engine_initialize_imgui_
 (
@@ -201,6 +213,13 @@ crude_engine_graphics_task_set_thread_loop_
   _In_ void                                               *ctx
 );
 
+static float32
+crude_engine_audio_player_bvh_radius_
+(
+  _In_opt_ void                                           *ctx,
+  _In_ void const                                         *component
+);
+
 static void
 crude_engine_update_animations_from_node_
 (
@@ -274,6 +293,7 @@ crude_engine_initialize
   crude_engine_commands_manager_initialize( &engine->commands_manager, engine, &engine->common_allocator );
   crude_engine_initialize_gui_( engine );
   crude_engine_initialize_editor_( engine );
+  crude_engine_initialize_input_replay_( engine );
   
   engine->running = true;
   
@@ -296,6 +316,7 @@ crude_engine_deinitialize
   crude_gfx_model_renderer_resources_manager_wait_till_uploaded( &engine->model_renderer_resources_manager, immediate_cmd );
   crude_gfx_submit_immediate( immediate_cmd );
   
+  crude_engine_deinitialize_input_replay_( engine );
   crude_engine_deinitialize_editor_( engine );
   crude_engine_deinitialize_gui_( engine );
   crude_engine_commands_manager_deinitialize( &engine->commands_manager );
@@ -319,19 +340,41 @@ crude_engine_update
   _In_ crude_engine                                       *engine
 )
 {
-  int64                                                    current_time;
+  int64                                                    current_time, frame_start_time, frame_time, update_delta_time;
   float32                                                  delta_time;
-  bool                                                     should_not_quit;
+  bool                                                     should_not_quit, input_replay_frame;
 
   CRUDE_PROFILER_ZONE_NAME( "crude_engine_update" );
   
+  frame_start_time = crude_time_now( );
+  frame_time = frame_start_time - engine->last_frame_time;
+  engine->last_frame_time = frame_start_time;
+
   crude_platform_update( &engine->platform );
 
+  /* Engine time advances by recorded deltas during the replay, frames of main node loading are skipped so they don't depend on loading speed */
+  update_delta_time = frame_time;
+  input_replay_frame = ( engine->input_replay.mode != CRUDE_INPUT_REPLAY_MODE_NONE ) && !engine->commands_manager.loading_main_node;
+  if ( input_replay_frame )
+  {
+    if ( engine->input_replay.frames_count == 0 )
+    {
+      crude_physics_reset_time( &engine->physics, engine->last_update_time );
+      crude_random_initialize( &engine->gameplay_random, engine->input_replay.random_seed );
+    }
+
+    if ( !crude_input_replay_update( &engine->input_replay, &engine->platform.input, &update_delta_time ) )
+    {
+      input_replay_frame = false;
+      engine->running = false;
+    }
+  }
+
 #if CRUDE_DEVELOP
   crude_gui_devmenu_update( &engine->devmenu );
 #endif /* CRUDE_DEVELOP */
 
-  current_time = crude_time_now( );
+  current_time = engine->last_update_time + update_delta_time;
   delta_time = crude_time_delta_seconds( engine->last_update_time, current_time );
   
 #if CRUDE_EDITOR
@@ -340,9 +383,13 @@ crude_engine_update
 
   crude_physics_update( &engine->physics, current_time );
 
-  crude_engine_update_animations_from_node_( &engine->scene_renderer, engine->world, engine->main_node, delta_time );
+  if ( crude_entity_valid( engine->world, engine->main_node ) )
+  {
+    crude_engine_update_animations_from_node_( &engine->scene_renderer, engine->world, engine->main_node, delta_time );
+  }
 
   crude_ecs_progress( engine->world, delta_time );
+  crude_audio_device_update( &engine->audio_device, delta_time );
   engine->last_update_time = current_time;
 
   {
@@ -351,6 +398,17 @@ crude_engine_update
     CRUDE_PROFILER_ZONE_END;
   }
 
+  crude_node_manager_update( &engine->node_manager );
+  crude_scene_bvh_update( &engine->scene_bvh );
+
+  if ( crude_entity_valid( engine->world, engine->camera_node ) && !engine->commands_manager.loading_main_node )
+  {
+    XMMATRIX                                               camera_to_world;
+
+    camera_to_world = crude_transform_node_to_world( engine->world, engine->camera_node, CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( engine->world, engine->camera_node, crude_transform ) );
+    crude_world_partition_update( &engine->world_partition, camera_to_world.r[ 3 ] );
+  }
+
   crude_engine_commands_manager_update( &engine->commands_manager );
 
   if ( crude_engine_graphics_main_thread_loop_( engine )  )
@@ -358,6 +416,11 @@ crude_engine_update
     crude_task_sheduler_start_task_set( &engine->task_sheduler, engine->graphics_task_set_handle );
   }
 
+  if ( input_replay_frame )
+  {
+    crude_input_replay_push_frame_timing( &engine->input_replay, frame_time, crude_time_now( ) - frame_start_time );
+  }
+
   CRUDE_PROFILER_ZONE_END;
   return engine->running;
 }
@@ -525,9 +588,18 @@ crude_engine_initialize_audio_
 )
 {
   crude_audio_device_initialize( &engine->audio_device, &engine->common_allocator, engine->environment.directories.resources_absolute_directory );
+  if ( engine->environment.audio.sound_cache_budget_mb )
+  {
+    crude_audio_device_set_sound_cache_budget( &engine->audio_device, CRUDE_RMEGA( CRUDE_CAST( uint64, engine->environment.audio.sound_cache_budget_mb ) ) );
+  }
+  if ( engine->environment.audio.real_voices_max )
+  {
+    crude_audio_device_set_real_voices_max( &engine->audio_device, engine->environment.audio.real_voices_max );
+  }
   
   engine->audio_system_context = CRUDE_COMPOUNT_EMPTY( crude_audio_system_context );
   engine->audio_system_context.device = &engine->audio_device;
+  engine->audio_system_context.scene_bvh = &engine->scene_bvh;
 
   crude_audio_system_import( engine->world, &engine->components_serialization_manager, &engine->audio_system_context );
 }
@@ -576,6 +648,41 @@ crude_engine_deinitialize_platform_
   crude_platform_deintialize( &engine->platform );
 }
 
+void
+crude_engine_initialize_input_replay_
+(
+  _In_ crude_engine                                       *engine
+)
+{
+  crude_input_replay_creation                              creation;
+
+  creation = CRUDE_COMPOUNT_EMPTY( crude_input_replay_creation );
+  creation.allocator = &engine->common_allocator;
+  creation.benchmark_absolute_filepath = engine->environment.input_replay.benchmark_absolute_filepath;
+  if ( engine->environment.input_replay.replay_absolute_filepath )
+  {
+    creation.mode = CRUDE_INPUT_REPLAY_MODE_REPLAY;
+    creation.absolute_filepath = engine->environment.input_replay.replay_absolute_filepath;
+  }
+  else if ( engine->environment.input_replay.record_absolute_filepath )
+  {
+    creation.mode = CRUDE_INPUT_REPLAY_MODE_RECORD;
+    creation.absolute_filepath = engine->environment.input_replay.record_absolute_filepath;
+  }
+  crude_input_replay_initialize( &engine->input_replay, &creation );
+  crude_random_initialize( &engine->gameplay_random, crude_time_now( ) );
+  engine->last_frame_time = crude_time_now( );
+}
+
+void
+crude_engine_deinitialize_input_replay_
+(
+  _In_ crude_engine                                       *engine
+)
+{
+  crude_input_replay_deinitialize( &engine->input_replay );
+}
+
 void
 crude_engine_initialize_graphics_
 (
@@ -715,6 +822,10 @@ crude_engine_initialize_physics_
   physics_creation.physics_shapes_manager = &engine->physics_shapes_manager;
   physics_creation.physics_allocator = &engine->common_allocator;
   physics_creation.physics_system_context = &engine->physics_system_context;
+  physics_creation.task_sheduler = &engine->task_sheduler;
+  physics_creation.max_bodies = engine->environment.physics.max_bodies;
+  physics_creation.max_body_pairs = engine->environment.physics.max_body_pairs;
+  physics_creation.max_contact_constraints = engine->environment.physics.max_contact_constraints;
   crude_physics_initialize( &engine->physics, &physics_creation, engine->world );
   
   physics_shapes_manager_creation = CRUDE_COMPOUNT_EMPTY( crude_physics_shapes_manager_creation );
@@ -725,6 +836,7 @@ crude_engine_initialize_physics_
 #endif
   physics_shapes_manager_creation.physics_manager = &engine->physics;
   physics_shapes_manager_creation.resources_absolute_directory = engine->environment.directories.resources_absolute_directory;
+  physics_shapes_manager_creation.cache_absolute_directory = engine->environment.directories.temporary_absolute_directory;
   crude_physics_shapes_manager_initialize( &engine->physics_shapes_manager, &physics_shapes_manager_creation );
 
   engine->physics_system_context = CRUDE_COMPOUNT_EMPTY( crude_physics_system_context );
@@ -765,6 +877,16 @@ crude_engine_select_camera_
   engine->camera_node = camera_node;
 }
 
+float32
+crude_engine_audio_player_bvh_radius_
+(
+  _In_opt_ void                                           *ctx,
+  _In_ void const                                         *component
+)
+{
+  return CRUDE_CAST( crude_audio_player const*, component )->max_distance;
+}
+
 void
 crude_engine_input_callback_
 (
@@ -793,10 +915,14 @@ crude_engine_initialize_scene_
 )
 {
   crude_node_manager_creation                              node_manager_creation;
+  crude_world_partition_creation                           world_partition_creation;
+  crude_scene_bvh_creation                                 scene_bvh_creation;
+
   node_manager_creation = CRUDE_COMPOUNT_EMPTY( crude_node_manager_creation );
   node_manager_creation.resources_absolute_directory = engine->environment.directories.resources_absolute_directory;
   node_manager_creation.temporary_allocator = &engine->temporary_allocator;
   node_manager_creation.physics_manager = &engine->physics;
+  node_manager_creation.task_sheduler = &engine->task_sheduler;
   node_manager_creation.components_serialization_manager = &engine->components_serialization_manager;
   node_manager_creation.allocator = &engine->common_allocator;
   node_manager_creation.model_renderer_resources_manager = &engine->model_renderer_resources_manager;
@@ -805,6 +931,22 @@ crude_engine_initialize_scene_
   node_manager_creation.audio_device = &engine->audio_device;
   node_manager_creation.scene_renderer = &engine->scene_renderer;
   crude_node_manager_initialize( &engine->node_manager, &node_manager_creation );
+
+  world_partition_creation = CRUDE_COMPOUNT_EMPTY( crude_world_partition_creation );
+  world_partition_creation.node_manager = &engine->node_manager;
+  world_partition_creation.world = engine->world;
+  world_partition_creation.load_distance = CRUDE_WORLD_PARTITION_LOAD_DISTANCE_DEFAULT;
+  world_partition_creation.unload_distance = CRUDE_WORLD_PARTITION_UNLOAD_DISTANCE_DEFAULT;
+  world_partition_creation.memory_budget = CRUDE_WORLD_PARTITION_MEMORY_BUDGET_DEFAULT;
+  crude_world_partition_initialize( &engine->world_partition, &world_partition_creation );
+
+  scene_bvh_creation = CRUDE_COMPOUNT_EMPTY( crude_scene_bvh_creation );
+  scene_bvh_creation.world = engine->world;
+  scene_bvh_creation.allocator = &engine->common_allocator;
+  scene_bvh_creation.aabb_margin = CRUDE_SCENE_BVH_AABB_MARGIN_DEFAULT;
+  crude_scene_bvh_initialize( &engine->scene_bvh, &scene_bvh_creation );
+  /* Only categories something queries are tracked, every tracked entity is refit each frame */
+  crude_scene_bvh_track_component( &engine->scene_bvh, ecs_id( crude_audio_player ), CRUDE_SCENE_BVH_CATEGORY_AUDIO_EMITTER, crude_engine_audio_player_bvh_radius_, NULL );
 }
 
 void
@@ -814,7 +956,8 @@ crude_engine_deinitialize_scene_
 )
 {
   crude_entity_destroy_hierarchy( engine->world, engine->main_node );
-  crude_node_manager_deinitialize( &engine->node_manager );
+  crude_scene_bvh_deinitialize( &engine->scene_bvh );
+  crude_node_manager_deinitialize( &engine->node_manager, engine->world );
 }
 
 void
@@ -880,6 +1023,7 @@ crude_engine_graphics_main_thread_loop_
     return false;
   }
   
+  /* Rendering isn't paused while the main node is loaded over frames */
   if ( !crude_entity_valid( engine->world, engine->camera_node ) )
   {
     CRUDE_PROFILER_ZONE_END;
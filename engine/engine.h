@@ -4,11 +4,14 @@
 #include <engine/engine/engine_commands_manager.h>
 #include <engine/graphics/asynchronous_loader_manager.h>
 #include <engine/scene/node_manager.h>
+#include <engine/scene/world_partition.h>
+#include <engine/scene/scene_bvh.h>
 #include <engine/audio/audio_device.h>
 #include <engine/audio/audio_ecs.h>
 #include <engine/physics/physics.h>
 #include <engine/physics/physics_ecs.h>
 #include <engine/platform/platform.h>
+#include <engine/platform/input_replay.h>
 #include <engine/gui/devmenu.h>
 #include <engine/editor/editor.h>
 #include <engine/graphics/scene_renderer.h>
@@ -29,7 +32,9 @@ typedef struct crude_engine
    ******************************/
   crude_task_sheduler                                      task_sheduler;
   bool                                                     running;
+  /* Engine time, during the input replay it advances by recorded frame deltas */
   int64                                                    last_update_time;
+  int64                                                    last_frame_time;
   crude_environment                                        environment;
 
   /******************************
@@ -55,6 +60,8 @@ typedef struct crude_engine
    *
    ******************************/
   crude_node_manager                                       node_manager;
+  crude_world_partition                                    world_partition;
+  crude_scene_bvh                                          scene_bvh;
   crude_engine_commands_manager                            commands_manager;
   
   /******************************
@@ -77,6 +84,9 @@ typedef struct crude_engine
    *
    ******************************/
   crude_platform                                           platform;
+  crude_input_replay                                       input_replay;
+  /* Gameplay draws only from it, so the input replay reproduces gameplay. Rendering keeps using rand( ) */
+  crude_random                                             gameplay_random;
   
   /******************************
    *
@@ -5,6 +5,13 @@
 
 #include <engine/engine/engine_commands_manager.h>
 
+static void
+crude_engine_commands_manager_main_node_loaded_
+(
+  _In_ void                                               *ctx,
+  _In_ crude_entity                                        node
+);
+
 void
 crude_engine_commands_manager_initialize
 (
@@ -14,6 +21,9 @@ crude_engine_commands_manager_initialize
 )
 {
   manager->engine = engine;
+  manager->loading_main_node = false;
+  manager->physics_simulation_enabled = false;
+  manager->main_node_snapshot = NULL;
   CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( manager->commands_queue, 0, crude_heap_allocator_pack( allocator ) );
 }
 
@@ -23,6 +33,10 @@ crude_engine_commands_manager_deinitialize
   _In_ crude_engine_commands_manager                      *manager
 )
 {
+  if ( manager->main_node_snapshot )
+  {
+    crude_node_manager_destroy_snapshot( &manager->engine->node_manager, manager->main_node_snapshot );
+  }
   CRUDE_ARRAY_DEINITIALIZE( manager->commands_queue );
 }
 
@@ -37,6 +51,28 @@ crude_engine_commands_manager_push_reload_node_command
   CRUDE_ARRAY_PUSH( manager->commands_queue, command ); 
 }
 
+void
+crude_engine_commands_manager_push_restart_node_command
+(
+  _In_ crude_engine_commands_manager                      *manager
+)
+{
+  crude_engine_commands_manager_queue_command command = CRUDE_COMPOUNT_EMPTY( crude_engine_commands_manager_queue_command );
+  command.type = CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_RESTART_NODE;
+  CRUDE_ARRAY_PUSH( manager->commands_queue, command );
+}
+
+void
+crude_engine_commands_manager_push_snapshot_node_command
+(
+  _In_ crude_engine_commands_manager                      *manager
+)
+{
+  crude_engine_commands_manager_queue_command command = CRUDE_COMPOUNT_EMPTY( crude_engine_commands_manager_queue_command );
+  command.type = CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_SNAPSHOT_NODE;
+  CRUDE_ARRAY_PUSH( manager->commands_queue, command );
+}
+
 void
 crude_engine_commands_manager_push_load_node_command
 (
@@ -103,22 +139,93 @@ crude_engine_commands_manager_update
     {
       crude_gfx_rhi_wait_idle( &manager->engine->gpu.rhi_device );
 
-      crude_node_manager_clear( &manager->engine->node_manager );
+      /* Snapshot owns model instances, they have to be released before models are cleared */
+      if ( manager->main_node_snapshot )
+      {
+        crude_node_manager_destroy_snapshot( &manager->engine->node_manager, manager->main_node_snapshot );
+        manager->main_node_snapshot = NULL;
+      }
+
+      crude_physics_begin_bodies_batch( &manager->engine->physics );
+      crude_node_manager_clear( &manager->engine->node_manager, manager->engine->world );
       crude_physics_shapes_manager_clear( &manager->engine->physics_shapes_manager );
       crude_gfx_texture_manager_clear( &manager->engine->texture_manager );
       crude_gfx_model_renderer_resources_manager_clear( &manager->engine->model_renderer_resources_manager );
       crude_entity_destroy_hierarchy( manager->engine->world, manager->engine->main_node );
+      crude_physics_end_bodies_batch( &manager->engine->physics );
       
       crude_gfx_rhi_wait_idle( &manager->engine->gpu.rhi_device );
       
+      manager->engine->main_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+      
+      if ( !manager->loading_main_node )
+      {
+        manager->loading_main_node = true;
+        manager->physics_simulation_enabled = manager->engine->physics.simulation_enabled;
+        crude_physics_enable_simulation( &manager->engine->physics, manager->engine->world, false );
+      }
+
       crude_string_copy( manager->engine->main_node_relative_filepath, manager->commands_queue[ i ].load_node.relative_filepath, sizeof( manager->engine->main_node_relative_filepath ) );
-      manager->engine->main_node = crude_node_manager_create_node( &manager->engine->node_manager, manager->commands_queue[ i ].load_node.relative_filepath, manager->engine->world );
+      crude_node_manager_load_node_async( &manager->engine->node_manager, manager->commands_queue[ i ].load_node.relative_filepath, manager->engine->world, NULL, crude_engine_commands_manager_main_node_loaded_, manager );
+      break;
+    }
+    case CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_RELOAD_NODE:
+    {
+      if ( manager->loading_main_node || !crude_entity_valid( manager->engine->world, manager->engine->main_node ) )
+      {
+        CRUDE_LOG_WARNING( CRUDE_CHANNEL_ALL, "Can't reload node \"%s\", main node isn't loaded", manager->engine->main_node_relative_filepath );
+        break;
+      }
+
+      crude_gfx_rhi_wait_idle( &manager->engine->gpu.rhi_device );
+
+      crude_node_manager_reload_node( &manager->engine->node_manager, manager->engine->main_node_relative_filepath, manager->engine->world, manager->engine->main_node );
       
       crude_gfx_scene_renderer_update_instances_from_node( &manager->engine->scene_renderer, manager->engine->world, manager->engine->main_node );
       crude_audio_device_wait_wait_till_uploaded( &manager->engine->audio_device );
 
       crude_physics_run_system_on_start( manager->engine->world );
 
+      if ( manager->main_node_snapshot )
+      {
+        crude_node_manager_destroy_snapshot( &manager->engine->node_manager, manager->main_node_snapshot );
+      }
+      manager->main_node_snapshot = crude_node_manager_take_snapshot( &manager->engine->node_manager, manager->engine->world, manager->engine->main_node );
+      break;
+    }
+    case CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_RESTART_NODE:
+    {
+      if ( manager->loading_main_node || !manager->main_node_snapshot )
+      {
+        CRUDE_LOG_WARNING( CRUDE_CHANNEL_ALL, "Can't restart node \"%s\", main node isn't loaded", manager->engine->main_node_relative_filepath );
+        break;
+      }
+
+      crude_gfx_rhi_wait_idle( &manager->engine->gpu.rhi_device );
+
+      crude_node_manager_restore_snapshot( &manager->engine->node_manager, manager->main_node_snapshot );
+
+      crude_gfx_scene_renderer_update_instances_from_node( &manager->engine->scene_renderer, manager->engine->world, manager->engine->main_node );
+      break;
+    }
+    case CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_SNAPSHOT_NODE:
+    {
+      if ( manager->loading_main_node || !crude_entity_valid( manager->engine->world, manager->engine->main_node ) )
+      {
+        CRUDE_LOG_WARNING( CRUDE_CHANNEL_ALL, "Can't snapshot node \"%s\", main node isn't loaded", manager->engine->main_node_relative_filepath );
+        break;
+      }
+
+      /* Snapshot owns model instances, wait till the frames in flight are done with the old ones */
+      crude_gfx_rhi_wait_idle( &manager->engine->gpu.rhi_device );
+
+      crude_physics_run_system_on_start( manager->engine->world );
+
+      if ( manager->main_node_snapshot )
+      {
+        crude_node_manager_destroy_snapshot( &manager->engine->node_manager, manager->main_node_snapshot );
+      }
+      manager->main_node_snapshot = crude_node_manager_take_snapshot( &manager->engine->node_manager, manager->engine->world, manager->engine->main_node );
       break;
     }
     case CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_RELOAD_TECHNIQUES:
@@ -144,4 +251,32 @@ crude_engine_commands_manager_update
   }
 
   CRUDE_ARRAY_SET_LENGTH( manager->commands_queue, 0u );
+}
+
+void
+crude_engine_commands_manager_main_node_loaded_
+(
+  _In_ void                                               *ctx,
+  _In_ crude_entity                                        node
+)
+{
+  crude_engine_commands_manager                           *manager;
+  
+  manager = CRUDE_CAST( crude_engine_commands_manager*, ctx );
+
+  manager->loading_main_node = false;
+  manager->engine->main_node = node;
+  crude_physics_enable_simulation( &manager->engine->physics, manager->engine->world, manager->physics_simulation_enabled );
+
+  if ( !crude_entity_valid( manager->engine->world, node ) )
+  {
+    return;
+  }
+
+  crude_gfx_scene_renderer_update_instances_from_node( &manager->engine->scene_renderer, manager->engine->world, manager->engine->main_node );
+  crude_audio_device_wait_wait_till_uploaded( &manager->engine->audio_device );
+
+  crude_physics_run_system_on_start( manager->engine->world );
+
+  manager->main_node_snapshot = crude_node_manager_take_snapshot( &manager->engine->node_manager, manager->engine->world, manager->engine->main_node );
 }
\ No newline at end of file
@@ -5,11 +5,14 @@
 #include <engine/scene/scene_config.h>
 
 typedef struct crude_engine crude_engine;
+typedef struct crude_node_manager_snapshot crude_node_manager_snapshot;
 
 typedef enum crude_engine_commands_manager_queue_command_type
 {
   CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_LOAD_NODE,
   CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_RELOAD_NODE,
+  CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_RESTART_NODE,
+  CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_SNAPSHOT_NODE,
   CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_RELOAD_TECHNIQUES,
   CRUDE_ENGINE_COMMANDS_MANAGER_QUEUE_COMMAND_TYPE_COUNT,
 } crude_engine_commands_manager_queue_command_type;
@@ -28,6 +31,12 @@ typedef struct crude_engine_commands_manager_queue_command
     } reload_node;
     struct 
     {
+    } restart_node;
+    struct 
+    {
+    } snapshot_node;
+    struct 
+    {
     } reload_techniques;
   };
 } crude_engine_commands_manager_queue_command;
@@ -36,6 +45,11 @@ typedef struct crude_engine_commands_manager
 {
   crude_engine                                            *engine;
   crude_engine_commands_manager_queue_command             *commands_queue;
+  /* Main node is streamed in by the node manager, physics simulation is paused till it's committed */
+  bool                                                     loading_main_node;
+  bool                                                     physics_simulation_enabled;
+  /* Main node state right after load or the last snapshot command, restart restores it instead of loading node files again */
+  crude_node_manager_snapshot                             *main_node_snapshot;
 } crude_engine_commands_manager;
 
 CRUDE_API void
@@ -58,6 +72,19 @@ crude_engine_commands_manager_push_reload_node_command
   _In_ crude_engine_commands_manager                      *manager
 );
 
+CRUDE_API void
+crude_engine_commands_manager_push_restart_node_command
+(
+  _In_ crude_engine_commands_manager                      *manager
+);
+
+/* Retakes the main node snapshot from the current world state, the editor uses it to start the game without saving the node */
+CRUDE_API void
+crude_engine_commands_manager_push_snapshot_node_command
+(
+  _In_ crude_engine_commands_manager                      *manager
+);
+
 CRUDE_API void
 crude_engine_commands_manager_push_load_node_command
 (
@@ -1,8 +1,7 @@
-#include <thirdparty/cJSON/cJSON.h>
-
 #include <engine/core/file.h>
 #include <engine/core/string.h>
 #include <engine/core/hashmapstr.h>
+#include <engine/core/json.h>
 
 #include <engine/graphics/gpu_resources_loader.h>
 
@@ -34,7 +33,7 @@ load_shader_to_string_buffer_
 static void
 parse_gpu_pipeline_
 (
-  _In_ cJSON const                                        *pipeline_json,
+  _In_ crude_json_cursor                                   pipeline_json,
   _Out_ crude_gfx_pipeline_creation                       *pipeline_creation,
 #if CRUDE_COMPILE_SHADERS
   _In_ shader_buffer_hashmap                              *name_to_buffer,
@@ -59,8 +58,9 @@ crude_gfx_technique_load_from_file
 )
 {
   char const                                              *json_path;
-  cJSON                                                   *technique_json;
-  cJSON const                                             *passes;
+  crude_json_document                                      technique_json_document;
+  crude_json_cursor                                        technique_json;
+  crude_json_cursor                                        passes;
   uint8                                                   *technique_json_buffer;
   crude_gfx_technique_creation                             technique_creation;
   crude_string_buffer                                      technique_buffer;
@@ -95,12 +95,13 @@ crude_gfx_technique_load_from_file
   
   crude_read_file( json_path, crude_stack_allocator_pack( temporary_allocator ), &technique_json_buffer, &technique_json_buffer_size );
 
-  technique_json = cJSON_ParseWithLength( CRUDE_REINTERPRET_CAST( char const*, technique_json_buffer ), technique_json_buffer_size );
-  if ( !technique_json )
+  if ( !crude_json_document_parse( &technique_json_document, CRUDE_REINTERPRET_CAST( char*, technique_json_buffer ), technique_json_buffer_size, crude_stack_allocator_pack( temporary_allocator ) ) )
   {
-    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot parse a file for technique... Error %s", cJSON_GetErrorPtr() );
-    goto cleanup_common_allocations;
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot parse a file for technique... Error at offset %u", crude_json_document_get_error_offset( &technique_json_document ) );
+    goto cleanup_json;
   }
+
+  technique_json = crude_json_document_get_root( &technique_json_document );
   
   technique_creation = CRUDE_COMPOUNT_EMPTY( crude_gfx_technique_creation );
   
@@ -109,26 +110,26 @@ crude_gfx_technique_load_from_file
 #endif
 
   {
-    cJSON const                                           *technique_name_json;
+    crude_json_cursor                                      technique_name_json;
     char const                                            *technique_name;
     
-    technique_name_json = cJSON_GetObjectItemCaseSensitive( technique_json, "name" );
-    technique_name = cJSON_GetStringValue( technique_name_json );
+    technique_name_json = crude_json_cursor_get_object_item( technique_json, "name" );
+    technique_name = crude_json_cursor_get_string_value( technique_name_json );
     crude_string_copy( technique_creation.name, technique_name, sizeof( technique_creation.name ) );
   }
   
 #if CRUDE_COMPILE_SHADERS
   {
-    cJSON const                                           *buffers_json;
+    crude_json_cursor                                      buffers_json;
 
-    buffers_json = cJSON_GetObjectItemCaseSensitive( technique_json, "buffers" );
-    for ( uint32 i = 0; i < cJSON_GetArraySize( buffers_json ); ++i )
+    buffers_json = crude_json_cursor_get_object_item( technique_json, "buffers" );
+    for ( uint32 i = 0; i < crude_json_cursor_get_array_size( buffers_json ); ++i )
     {
-      cJSON const                                       *buffer_json;
-      cJSON const                                       *includes_json;
+      crude_json_cursor                                  buffer_json;
+      crude_json_cursor                                  includes_json;
       char const                                        *filename;
 
-      buffer_json = cJSON_GetArrayItem( buffers_json, i );
+      buffer_json = crude_json_cursor_get_array_item( buffers_json, i );
 
       
       char const                                          *stage;
@@ -143,20 +144,20 @@ crude_gfx_technique_load_from_file
       total_code = crude_string_buffer_current( &shader_code_buffer );
       total_code_size = 0u;
 
-      includes_json = cJSON_GetObjectItemCaseSensitive( buffer_json, "includes" );
-      if ( cJSON_IsArray( includes_json ) )
+      includes_json = crude_json_cursor_get_object_item( buffer_json, "includes" );
+      if ( crude_json_cursor_is_array( includes_json ) )
       {
-        for ( size_t include_index = 0; include_index < cJSON_GetArraySize( includes_json ); ++include_index )
+        for ( size_t include_index = 0; include_index < crude_json_cursor_get_array_size( includes_json ); ++include_index )
         {
-          filename = cJSON_GetStringValue( cJSON_GetArrayItem( includes_json, include_index ) );
+          filename = crude_json_cursor_get_string_value( crude_json_cursor_get_array_item( includes_json, include_index ) );
           load_shader_to_string_buffer_( filename, gpu->environment->directories.shaders_absolute_directory, &total_code_size, &shader_code_buffer, &path_buffer, temporary_allocator );
         }
       }
       
-      filename = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( buffer_json, "filename" ) );
+      filename = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( buffer_json, "filename" ) );
       load_shader_to_string_buffer_( filename, gpu->environment->directories.shaders_absolute_directory, &total_code_size, &shader_code_buffer, &path_buffer, temporary_allocator );
       
-      buffer_name = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( buffer_json, "name" ) );
+      buffer_name = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( buffer_json, "name" ) );
 
       shader_buffer.buffer = total_code;
       shader_buffer.size = total_code_size;
@@ -170,15 +171,15 @@ crude_gfx_technique_load_from_file
 
   {
   
-    cJSON const                                           *pipelines_json;
+    crude_json_cursor                                      pipelines_json;
 
-    pipelines_json = cJSON_GetObjectItemCaseSensitive( technique_json, "pipelines" );
-    for ( uint32 i = 0; i < cJSON_GetArraySize( pipelines_json ); ++i )
+    pipelines_json = crude_json_cursor_get_object_item( technique_json, "pipelines" );
+    for ( uint32 i = 0; i < crude_json_cursor_get_array_size( pipelines_json ); ++i )
     {
-      cJSON const                                       *pipeline;
+      crude_json_cursor                                  pipeline;
       crude_gfx_pipeline_creation                        pipeline_creation;
 
-      pipeline = cJSON_GetArrayItem( pipelines_json, i );
+      pipeline = crude_json_cursor_get_array_item( pipelines_json, i );
       pipeline_creation = crude_gfx_pipeline_creation_empty();
       parse_gpu_pipeline_( pipeline, &pipeline_creation,
 #if CRUDE_COMPILE_SHADERS
@@ -194,7 +195,7 @@ crude_gfx_technique_load_from_file
   }
   
 cleanup_json:
-  cJSON_Delete( technique_json );
+  crude_json_document_deinitialize( &technique_json_document );
 
 cleanup_common_allocations:
   crude_stack_allocator_free_marker( temporary_allocator, allocated_marker  );
@@ -209,7 +210,7 @@ cleanup_common_allocations:
 void
 parse_gpu_pipeline_
 (
-  _In_ cJSON const                                        *pipeline_json,
+  _In_ crude_json_cursor                                   pipeline_json,
   _Out_ crude_gfx_pipeline_creation                       *pipeline_creation,
 #if CRUDE_COMPILE_SHADERS
   _In_ shader_buffer_hashmap                              *name_to_buffer,
@@ -219,18 +220,18 @@ parse_gpu_pipeline_
   _In_ crude_stack_allocator                              *temporary_allocator
 )
 {
-  cJSON const *name_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "name" );
-  if ( name_json != NULL )
+  crude_json_cursor name_json = crude_json_cursor_get_object_item( pipeline_json, "name" );
+  if ( crude_json_cursor_valid( name_json ) )
   {
-    pipeline_creation->name = cJSON_GetStringValue( name_json );
+    pipeline_creation->name = crude_json_cursor_get_string_value( name_json );
   }
   
-  cJSON const *shaders_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "shaders" );
-  if ( shaders_json != NULL )
+  crude_json_cursor shaders_json = crude_json_cursor_get_object_item( pipeline_json, "shaders" );
+  if ( crude_json_cursor_valid( shaders_json ) )
   {
-    for ( size_t shader_index = 0; shader_index < cJSON_GetArraySize( shaders_json ); ++shader_index )
+    for ( size_t shader_index = 0; shader_index < crude_json_cursor_get_array_size( shaders_json ); ++shader_index )
     {
-      cJSON const                                         *shader_stage_json;
+      crude_json_cursor                                    shader_stage_json;
       char const                                          *stage;
       char const                                          *buffer_name;
       shader_buffer_data                                  *shader_buffer;
@@ -244,9 +245,9 @@ parse_gpu_pipeline_
       pipeline_creation->shaders.spv_input = false;
 #endif
       
-      shader_stage_json = cJSON_GetArrayItem( shaders_json, shader_index );
+      shader_stage_json = crude_json_cursor_get_array_item( shaders_json, shader_index );
       
-      buffer_name = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( shader_stage_json, "buffer" ) );
+      buffer_name = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( shader_stage_json, "buffer" ) );
       
 #if CRUDE_COMPILE_SHADERS
       shader_buffer_index = CRUDE_HASHMAPSTR_GET_INDEX( name_to_buffer, buffer_name );
@@ -256,7 +257,7 @@ parse_gpu_pipeline_
       shader_buffer_data empty_shader_buffer = CRUDE_COMPOUNT_EMPTY( shader_buffer_data );
       shader_buffer = &empty_shader_buffer;
 #endif /* CRUDE_COMPILE_SHADERS */
-      stage = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( shader_stage_json, "stage" ) );
+      stage = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( shader_stage_json, "stage" ) );
       if ( strcmp( stage, "vertex" ) == 0 )
       {
         crude_gfx_shader_state_creation_add_stage( &pipeline_creation->shaders, shader_buffer->buffer, shader_buffer->size, CRUDE_GFX_RHI_SHADER_STAGE_VERTEX_BIT );
@@ -292,22 +293,22 @@ parse_gpu_pipeline_
     }
   }
 
-  cJSON const *multisample_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "multisample" );
-  if ( multisample_json != NULL )
+  crude_json_cursor multisample_json = crude_json_cursor_get_object_item( pipeline_json, "multisample" );
+  if ( crude_json_cursor_valid( multisample_json ) )
   {
-    pipeline_creation->multisample.enabled = cJSON_GetObjectItemCaseSensitive( multisample_json, "enabled" );
+    pipeline_creation->multisample.enabled = crude_json_cursor_valid( crude_json_cursor_get_object_item( multisample_json, "enabled" ) );
   }
   
-  cJSON const *depth_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "depth" );
-  if ( depth_json != NULL )
+  crude_json_cursor depth_json = crude_json_cursor_get_object_item( pipeline_json, "depth" );
+  if ( crude_json_cursor_valid( depth_json ) )
   {
     pipeline_creation->depth_stencil.depth_enable = 1;
-    pipeline_creation->depth_stencil.depth_write_enable = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( depth_json, "write" ) );
+    pipeline_creation->depth_stencil.depth_write_enable = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( depth_json, "write" ) );
     
-    cJSON const *comparison_json = cJSON_GetObjectItemCaseSensitive( depth_json, "test" );
-    if ( cJSON_IsString( comparison_json ) )
+    crude_json_cursor comparison_json = crude_json_cursor_get_object_item( depth_json, "test" );
+    if ( crude_json_cursor_is_string( comparison_json ) )
     {
-      char const *comparison = cJSON_GetStringValue( comparison_json );
+      char const *comparison = crude_json_cursor_get_string_value( comparison_json );
       
       if ( strcmp( comparison, "less_or_equal" ) == 0 )
       {
@@ -332,17 +333,17 @@ parse_gpu_pipeline_
     }
   }
   
-  cJSON const *blend_states_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "blend" );
-  if ( blend_states_json != NULL )
+  crude_json_cursor blend_states_json = crude_json_cursor_get_object_item( pipeline_json, "blend" );
+  if ( crude_json_cursor_valid( blend_states_json ) )
   {
-    for ( size_t blend_index = 0; blend_index < cJSON_GetArraySize( blend_states_json ); ++blend_index )
+    for ( size_t blend_index = 0; blend_index < crude_json_cursor_get_array_size( blend_states_json ); ++blend_index )
     {
-      cJSON const *blend_json = cJSON_GetArrayItem( blend_states_json, blend_index );
+      crude_json_cursor blend_json = crude_json_cursor_get_array_item( blend_states_json, blend_index );
       
-      uint32 enabled = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( blend_json, "enable" ) );
-      char const *src_colour = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( blend_json, "src_colour" ) );
-      char const *dst_colour = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( blend_json, "dst_colour" ) );
-      char const *blend_op = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( blend_json, "op" ) );
+      uint32 enabled = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( blend_json, "enable" ) );
+      char const *src_colour = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( blend_json, "src_colour" ) );
+      char const *dst_colour = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( blend_json, "dst_colour" ) );
+      char const *blend_op = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( blend_json, "op" ) );
       
       crude_gfx_blend_state blend_state = CRUDE_COMPOUNT_EMPTY( crude_gfx_blend_state );
       blend_state.source_color = crude_gfx_rhi_string_to_blend_factor( src_colour );
@@ -353,10 +354,10 @@ parse_gpu_pipeline_
     }
   }
   
-  cJSON const *cull_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "cull" );
-  if ( cull_json != NULL )
+  crude_json_cursor cull_json = crude_json_cursor_get_object_item( pipeline_json, "cull" );
+  if ( crude_json_cursor_valid( cull_json ) )
   {
-    char const *cull_mode = cJSON_GetStringValue( cull_json );
+    char const *cull_mode = crude_json_cursor_get_string_value( cull_json );
 
     if ( strcmp( cull_mode, "back" ) == 0 )
     {
@@ -375,32 +376,32 @@ parse_gpu_pipeline_
       CRUDE_ASSERT( false );
     }
   }
-  cJSON const *bias_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "bias" );
-  if ( bias_json )
+  crude_json_cursor bias_json = crude_json_cursor_get_object_item( pipeline_json, "bias" );
+  if ( crude_json_cursor_valid( bias_json ) )
   {
     pipeline_creation->rasterization.depth_bias_enable = true;
-    pipeline_creation->rasterization.depth_bias_constant_factor = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( bias_json, "constant_factor" ) );
-    pipeline_creation->rasterization.depth_bias_clamp = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( bias_json, "clamp" ) );
-    pipeline_creation->rasterization.depth_bias_slope_factor = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( bias_json, "slope_factor" ) );
+    pipeline_creation->rasterization.depth_bias_constant_factor = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( bias_json, "constant_factor" ) );
+    pipeline_creation->rasterization.depth_bias_clamp = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( bias_json, "clamp" ) );
+    pipeline_creation->rasterization.depth_bias_slope_factor = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( bias_json, "slope_factor" ) );
   }
   
-  cJSON const *topology_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "topology" );
-  if ( topology_json != NULL )
+  crude_json_cursor topology_json = crude_json_cursor_get_object_item( pipeline_json, "topology" );
+  if ( crude_json_cursor_valid( topology_json ) )
   {
-    char const *topology_str = cJSON_GetStringValue( topology_json );
+    char const *topology_str = crude_json_cursor_get_string_value( topology_json );
     pipeline_creation->topology = crude_gfx_string_to_primitive_topology( topology_str );
   }
 
   pipeline_creation->rasterization.front = CRUDE_GFX_RHI_FRONT_FACE_COUNTER_CLOCKWISE;
   
-  cJSON const *render_pass_output_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "render_pass_output" );
-  if ( render_pass_output_json != NULL )
+  crude_json_cursor render_pass_output_json = crude_json_cursor_get_object_item( pipeline_json, "render_pass_output" );
+  if ( crude_json_cursor_valid( render_pass_output_json ) )
   {
-    cJSON const *render_pass_output_reference_json = cJSON_GetObjectItemCaseSensitive( render_pass_output_json, "reference" );
-    cJSON const *render_pass_output_custom_json = cJSON_GetObjectItemCaseSensitive( render_pass_output_json, "custom" );
-    if ( render_pass_output_reference_json )
+    crude_json_cursor render_pass_output_reference_json = crude_json_cursor_get_object_item( render_pass_output_json, "reference" );
+    crude_json_cursor render_pass_output_custom_json = crude_json_cursor_get_object_item( render_pass_output_json, "custom" );
+    if ( crude_json_cursor_valid( render_pass_output_reference_json ) )
     {
-      char const *render_pass_name = cJSON_GetStringValue( render_pass_output_reference_json );
+      char const *render_pass_name = crude_json_cursor_get_string_value( render_pass_output_reference_json );
       if ( crude_string_cmp( render_pass_name, "template_imgui_pass" ) == 0 )
       {
 #if CRUDE_EDITOR
@@ -430,18 +431,18 @@ parse_gpu_pipeline_
         pipeline_creation->render_pass_output = render_graph->builder->gpu->swapchain_output;
       }
     }
-    else if ( render_pass_output_custom_json )
+    else if ( crude_json_cursor_valid( render_pass_output_custom_json ) )
     {
       pipeline_creation->render_pass_output = crude_gfx_render_pass_output_empty( );
 
-      for ( uint32 i = 0; i < cJSON_GetArraySize( render_pass_output_custom_json ); ++i )
+      for ( uint32 i = 0; i < crude_json_cursor_get_array_size( render_pass_output_custom_json ); ++i )
       {
-        cJSON const *render_pass_output_custom_attachment_json = cJSON_GetArrayItem( render_pass_output_custom_json, i );
-        cJSON const *render_pass_output_custom_attachment_format_json = cJSON_GetObjectItemCaseSensitive( render_pass_output_custom_attachment_json, "format" );
-        cJSON const *render_pass_output_custom_attachment_load_op_json = cJSON_GetObjectItemCaseSensitive( render_pass_output_custom_attachment_json, "op" );
+        crude_json_cursor render_pass_output_custom_attachment_json = crude_json_cursor_get_array_item( render_pass_output_custom_json, i );
+        crude_json_cursor render_pass_output_custom_attachment_format_json = crude_json_cursor_get_object_item( render_pass_output_custom_attachment_json, "format" );
+        crude_json_cursor render_pass_output_custom_attachment_load_op_json = crude_json_cursor_get_object_item( render_pass_output_custom_attachment_json, "op" );
 
-        crude_gfx_rhi_format vk_format = crude_gfx_string_to_format( cJSON_GetStringValue( render_pass_output_custom_attachment_format_json ) );
-        crude_gfx_render_pass_operation operation = crude_gfx_string_to_render_pass_operation( cJSON_GetStringValue( render_pass_output_custom_attachment_load_op_json ) );
+        crude_gfx_rhi_format vk_format = crude_gfx_string_to_format( crude_json_cursor_get_string_value( render_pass_output_custom_attachment_format_json ) );
+        crude_gfx_render_pass_operation operation = crude_gfx_string_to_render_pass_operation( crude_json_cursor_get_string_value( render_pass_output_custom_attachment_load_op_json ) );
 
         if ( crude_gfx_rhi_format_has_depth_or_stencil( vk_format ) )
         {
@@ -449,33 +450,33 @@ parse_gpu_pipeline_
         }
         else
         {
-          crude_gfx_render_pass_output_add_color( &pipeline_creation->render_pass_output, crude_gfx_string_to_format( cJSON_GetStringValue( render_pass_output_custom_attachment_format_json ) ), CRUDE_GFX_RHI_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, operation );
+          crude_gfx_render_pass_output_add_color( &pipeline_creation->render_pass_output, crude_gfx_string_to_format( crude_json_cursor_get_string_value( render_pass_output_custom_attachment_format_json ) ), CRUDE_GFX_RHI_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, operation );
         }
       }
     }
   }
 
-  cJSON const *vertex_input_json = cJSON_GetObjectItemCaseSensitive( pipeline_json, "vertex_input" );
-  if ( vertex_input_json != NULL )
+  crude_json_cursor vertex_input_json = crude_json_cursor_get_object_item( pipeline_json, "vertex_input" );
+  if ( crude_json_cursor_valid( vertex_input_json ) )
   {
-    cJSON const *vertex_attributes_json = cJSON_GetObjectItemCaseSensitive( vertex_input_json, "attributes" );
-    for ( size_t i = 0; i < cJSON_GetArraySize( vertex_attributes_json ); ++i )
+    crude_json_cursor vertex_attributes_json = crude_json_cursor_get_object_item( vertex_input_json, "attributes" );
+    for ( size_t i = 0; i < crude_json_cursor_get_array_size( vertex_attributes_json ); ++i )
     {
-      cJSON const *vertex_attribute_json = cJSON_GetArrayItem( vertex_attributes_json, i );
-      uint32 location = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( vertex_attribute_json, "location" ) );
-      uint32 binding = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( vertex_attribute_json, "binding" ) );
-      uint32 offset = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( vertex_attribute_json, "offset" ) );
-      crude_gfx_vertex_component_format format = crude_gfx_to_vertex_component_format( cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( vertex_attribute_json, "format" ) ) );
+      crude_json_cursor vertex_attribute_json = crude_json_cursor_get_array_item( vertex_attributes_json, i );
+      uint32 location = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( vertex_attribute_json, "location" ) );
+      uint32 binding = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( vertex_attribute_json, "binding" ) );
+      uint32 offset = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( vertex_attribute_json, "offset" ) );
+      crude_gfx_vertex_component_format format = crude_gfx_to_vertex_component_format( crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( vertex_attribute_json, "format" ) ) );
       crude_gfx_pipeline_creation_add_vertex_attribute( pipeline_creation, location, binding, offset, format );
     }
 
-    cJSON const *vertex_streams_json = cJSON_GetObjectItemCaseSensitive( vertex_input_json, "streams" );
-    for ( size_t i = 0; i < cJSON_GetArraySize( vertex_streams_json ); ++i )
+    crude_json_cursor vertex_streams_json = crude_json_cursor_get_object_item( vertex_input_json, "streams" );
+    for ( size_t i = 0; i < crude_json_cursor_get_array_size( vertex_streams_json ); ++i )
     {
-      cJSON const *vertex_stream_json = cJSON_GetArrayItem( vertex_streams_json, i );
-      uint32 binding = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( vertex_stream_json, "binding" ) );
-      uint32 stride = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( vertex_stream_json, "stride" ) );
-      char const *input_rate = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( vertex_stream_json, "input_rate" ) );
+      crude_json_cursor vertex_stream_json = crude_json_cursor_get_array_item( vertex_streams_json, i );
+      uint32 binding = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( vertex_stream_json, "binding" ) );
+      uint32 stride = crude_json_cursor_get_number_value( crude_json_cursor_get_object_item( vertex_stream_json, "stride" ) );
+      char const *input_rate = crude_json_cursor_get_string_value( crude_json_cursor_get_object_item( vertex_stream_json, "input_rate" ) );
       crude_gfx_pipeline_creation_add_vertex_stream( pipeline_creation, binding, stride, crude_string_cmp( input_rate, "instance" ) ?  CRUDE_GFX_VERTEX_INPUT_RATE_PER_VERTEX : CRUDE_GFX_VERTEX_INPUT_RATE_PER_INSTANCE );
     }
   }
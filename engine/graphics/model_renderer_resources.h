@@ -98,6 +98,10 @@ typedef struct crude_gfx_model_renderer_resources
   crude_gfx_mesh_cpu                                      *meshes;
   char                                                     relative_filepath[ CRUDE_GFX_MODEL_RESOURCE_RELATIVE_FILEPATH_LENGTH_MAX ];
   CRUDE_HASHMAPSTR( uint64 )                              *animation_name_to_index;  
+  /* CPU and GPU bytes of the model, meshlets in the shared buffers are included */
+  uint64                                                   size;
+  /* Distance from the model origin to the farthest mesh bound in the default pose */
+  float32                                                  bounding_radius;
 #if CRUDE_GFX_RAY_TRACING_ENABLED
   bool                                                     rtx_affected;
   crude_gfx_rhi_acceleration_structure                    *rhi_blases;
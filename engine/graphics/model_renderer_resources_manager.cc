@@ -26,7 +26,35 @@ static crude_gfx_model_renderer_resources
 crude_gfx_model_renderer_resources_manager_load_gltf_
 (
   _In_ crude_gfx_model_renderer_resources_manager         *manager,
-  _In_ char const                                         *gltf_relative_filepath
+  _In_ crude_gfx_model_renderer_resources_prepared_gltf   *prepared_gltf
+);
+
+static crude_gfx_model_renderer_resources_handle
+crude_gfx_model_renderer_resources_manager_add_gltf_
+(
+  _In_ crude_gfx_model_renderer_resources_manager         *manager,
+  _In_ crude_gfx_model_renderer_resources_prepared_gltf   *prepared_gltf
+);
+
+static uint64
+crude_gfx_model_renderer_resources_manager_calculate_model_size_
+(
+  _In_ crude_gfx_model_renderer_resources const           *model_renderer_resouces,
+  _In_ crude_gfx_model_renderer_resources_gltf_meshlets const *meshlets
+);
+
+static float32
+crude_gfx_model_renderer_resources_manager_calculate_model_bounding_radius_
+(
+  _In_ crude_gfx_model_renderer_resources const           *model_renderer_resouces
+);
+
+static void
+crude_gfx_model_renderer_resources_manager_gltf_build_meshlets_
+(
+  _In_ crude_heap_allocator                               *allocator,
+  _In_ cgltf_data                                         *gltf,
+  _Out_ crude_gfx_model_renderer_resources_gltf_meshlets  *meshlets
 );
 
 static void
@@ -68,7 +96,8 @@ crude_gfx_model_renderer_resources_manager_gltf_load_geometry_
   _Out_ uint32                                            *gltf_mesh_index_to_mesh_primitive_index,
   _In_ cgltf_data                                         *gltf,
   _In_ char const                                         *gltf_absolute_directory,
-  _In_ uint32                                              images_offset
+  _In_ uint32                                              images_offset,
+  _In_ crude_gfx_model_renderer_resources_gltf_meshlets   *meshlets
 );
 
 static void
@@ -302,8 +331,7 @@ crude_gfx_model_renderer_resources_manager_get_gltf_model
   _In_ char const                                          *filepath
 )
 {
-  crude_gfx_model_renderer_resources_handle                model_renderer_resouces_handle;
-  crude_gfx_model_renderer_resources                      *model_renderer_resouces;
+  crude_gfx_model_renderer_resources_prepared_gltf         prepared_gltf;
   int64                                                    model_renderer_resouces_index;
 
   model_renderer_resouces_index = CRUDE_HASHMAPSTR_GET_INDEX( manager->model_name_to_model_renderer_resource, filepath );
@@ -312,14 +340,133 @@ crude_gfx_model_renderer_resources_manager_get_gltf_model
     return manager->model_name_to_model_renderer_resource[ model_renderer_resouces_index ].value;
   }
   
-  model_renderer_resouces_handle = { crude_resource_pool_obtain_resource( &manager->model_renderer_resources_pool ) };
-  model_renderer_resouces = CRUDE_CAST( crude_gfx_model_renderer_resources*, crude_resource_pool_access_resource( &manager->model_renderer_resources_pool, model_renderer_resouces_handle.index ) );
-  
-  crude_string_copy( model_renderer_resouces->relative_filepath, filepath, sizeof( model_renderer_resouces->relative_filepath ) );
+  crude_gfx_model_renderer_resources_manager_prepare_gltf( manager, filepath, manager->cgltf_temporary_allocator, manager->allocator, &prepared_gltf );
+  return crude_gfx_model_renderer_resources_manager_add_gltf_( manager, &prepared_gltf );
+}
 
-  *model_renderer_resouces = crude_gfx_model_renderer_resources_manager_load_gltf_( manager, model_renderer_resouces->relative_filepath );
-  CRUDE_HASHMAPSTR_SET( manager->model_name_to_model_renderer_resource, CRUDE_COMPOUNT( crude_string_link, { model_renderer_resouces->relative_filepath } ), model_renderer_resouces_handle );
-  return model_renderer_resouces_handle;
+bool
+crude_gfx_model_renderer_resources_manager_has_gltf_model
+(
+  _In_ crude_gfx_model_renderer_resources_manager          *manager,
+  _In_ char const                                          *filepath
+)
+{
+  return CRUDE_HASHMAPSTR_GET_INDEX( manager->model_name_to_model_renderer_resource, filepath ) != -1;
+}
+
+bool
+crude_gfx_model_renderer_resources_manager_prepare_gltf
+(
+  _In_ crude_gfx_model_renderer_resources_manager const    *manager,
+  _In_ char const                                          *filepath,
+  _In_ crude_heap_allocator                                *gltf_allocator,
+  _In_ crude_heap_allocator                                *allocator,
+  _Out_ crude_gfx_model_renderer_resources_prepared_gltf   *prepared_gltf
+)
+{
+  char                                                     gltf_absolute_filepath[ 2 * CRUDE_GFX_MODEL_RESOURCE_RELATIVE_FILEPATH_LENGTH_MAX ];
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_gfx_model_renderer_resources_manager_prepare_gltf" );
+
+  *prepared_gltf = CRUDE_COMPOUNT_EMPTY( crude_gfx_model_renderer_resources_prepared_gltf );
+  crude_string_copy( prepared_gltf->relative_filepath, filepath, sizeof( prepared_gltf->relative_filepath ) );
+
+  crude_snprintf( gltf_absolute_filepath, sizeof( gltf_absolute_filepath ), "%s%s", manager->resources_absolute_directory, filepath );
+  prepared_gltf->gltf = crude_gfx_model_renderer_resources_manager_gltf_parse_( gltf_allocator, gltf_absolute_filepath );
+  if ( prepared_gltf->gltf && manager->gpu->mesh_shaders_extension_present )
+  {
+    crude_gfx_model_renderer_resources_manager_gltf_build_meshlets_( allocator, prepared_gltf->gltf, &prepared_gltf->meshlets );
+  }
+
+  CRUDE_PROFILER_ZONE_END;
+  return prepared_gltf->gltf != NULL;
+}
+
+crude_gfx_model_renderer_resources_handle
+crude_gfx_model_renderer_resources_manager_add_prepared_gltf
+(
+  _In_ crude_gfx_model_renderer_resources_manager          *manager,
+  _In_ crude_gfx_model_renderer_resources_prepared_gltf    *prepared_gltf
+)
+{
+  int64                                                    model_renderer_resouces_index;
+
+  model_renderer_resouces_index = CRUDE_HASHMAPSTR_GET_INDEX( manager->model_name_to_model_renderer_resource, prepared_gltf->relative_filepath );
+  if ( model_renderer_resouces_index != -1 )
+  {
+    crude_gfx_model_renderer_resources_manager_discard_prepared_gltf( prepared_gltf );
+    return manager->model_name_to_model_renderer_resource[ model_renderer_resouces_index ].value;
+  }
+
+  return crude_gfx_model_renderer_resources_manager_add_gltf_( manager, prepared_gltf );
+}
+
+void
+crude_gfx_model_renderer_resources_manager_discard_prepared_gltf
+(
+  _In_ crude_gfx_model_renderer_resources_prepared_gltf    *prepared_gltf
+)
+{
+  if ( prepared_gltf->meshlets.meshlets )
+  {
+    CRUDE_ARRAY_DEINITIALIZE( prepared_gltf->meshlets.meshlets );
+    CRUDE_ARRAY_DEINITIALIZE( prepared_gltf->meshlets.vertices );
+    CRUDE_ARRAY_DEINITIALIZE( prepared_gltf->meshlets.vertices_positions );
+    CRUDE_ARRAY_DEINITIALIZE( prepared_gltf->meshlets.vertices_joints );
+    CRUDE_ARRAY_DEINITIALIZE( prepared_gltf->meshlets.vertices_indices );
+    CRUDE_ARRAY_DEINITIALIZE( prepared_gltf->meshlets.triangles_indices );
+    CRUDE_ARRAY_DEINITIALIZE( prepared_gltf->meshlets.meshes_meshlets_counts );
+  }
+
+  if ( prepared_gltf->gltf )
+  {
+    cgltf_free( prepared_gltf->gltf );
+  }
+
+  *prepared_gltf = CRUDE_COMPOUNT_EMPTY( crude_gfx_model_renderer_resources_prepared_gltf );
+}
+
+void
+crude_gfx_model_renderer_resources_manager_release_gltf_model
+(
+  _In_ crude_gfx_model_renderer_resources_manager          *manager,
+  _In_ crude_gfx_model_renderer_resources_handle            handle
+)
+{
+  crude_gfx_model_renderer_resources                      *model_renderer_resouces;
+
+  model_renderer_resouces = crude_gfx_model_renderer_resources_manager_access_model_renderer_resources( manager, handle );
+  if ( !model_renderer_resouces )
+  {
+    return;
+  }
+
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_GRAPHICS, "Release \"%s\" gltf", model_renderer_resouces->relative_filepath );
+
+  for ( uint32 mesh_index = 0; mesh_index < CRUDE_ARRAY_LENGTH( model_renderer_resouces->meshes ); ++mesh_index )
+  {
+    crude_gfx_memory_allocation const                     *index_hga;
+
+    index_hga = &model_renderer_resouces->meshes[ mesh_index ].index_hga;
+    if ( !index_hga->size )
+    {
+      continue;
+    }
+
+    for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( manager->indices_buffers ); ++i )
+    {
+      if ( manager->indices_buffers[ i ].buffer_handle.index == index_hga->buffer_handle.index && manager->indices_buffers[ i ].offset == index_hga->offset )
+      {
+        CRUDE_ARRAY_DELSWAP( manager->indices_buffers, i );
+        break;
+      }
+    }
+    crude_gfx_memory_deallocate( manager->gpu, *index_hga );
+  }
+
+  CRUDE_HASHMAPSTR_REMOVE( manager->model_name_to_model_renderer_resource, model_renderer_resouces->relative_filepath );
+  crude_gfx_model_renderer_resources_deinitialize( manager->gpu, model_renderer_resouces );
+  crude_resource_pool_release_resource( &manager->model_renderer_resources_pool, handle.index );
 }
 
 void
@@ -351,6 +498,24 @@ crude_gfx_model_renderer_resources_manager_access_model_renderer_resources
   return CRUDE_CAST( crude_gfx_model_renderer_resources*, crude_resource_pool_access_resource( &manager->model_renderer_resources_pool, handle.index ) );
 }
 
+crude_gfx_model_renderer_resources_handle
+crude_gfx_model_renderer_resources_manager_add_gltf_
+(
+  _In_ crude_gfx_model_renderer_resources_manager         *manager,
+  _In_ crude_gfx_model_renderer_resources_prepared_gltf   *prepared_gltf
+)
+{
+  crude_gfx_model_renderer_resources_handle                model_renderer_resouces_handle;
+  crude_gfx_model_renderer_resources                      *model_renderer_resouces;
+
+  model_renderer_resouces_handle = { crude_resource_pool_obtain_resource( &manager->model_renderer_resources_pool ) };
+  model_renderer_resouces = CRUDE_CAST( crude_gfx_model_renderer_resources*, crude_resource_pool_access_resource( &manager->model_renderer_resources_pool, model_renderer_resouces_handle.index ) );
+  
+  *model_renderer_resouces = crude_gfx_model_renderer_resources_manager_load_gltf_( manager, prepared_gltf );
+  CRUDE_HASHMAPSTR_SET( manager->model_name_to_model_renderer_resource, CRUDE_COMPOUNT( crude_string_link, { model_renderer_resouces->relative_filepath } ), model_renderer_resouces_handle );
+  return model_renderer_resouces_handle;
+}
+
 /**
  * Register Nodes
  */
@@ -358,13 +523,12 @@ crude_gfx_model_renderer_resources
 crude_gfx_model_renderer_resources_manager_load_gltf_
 (
   _In_ crude_gfx_model_renderer_resources_manager         *manager,
-  _In_ char const                                         *gltf_relative_filepath
+  _In_ crude_gfx_model_renderer_resources_prepared_gltf   *prepared_gltf
 )
 {
   cgltf_data                                              *gltf;
   uint32                                                  *gltf_mesh_index_to_mesh_primitive_index;
   char                                                    *gltf_absolute_directory;
-  char                                                    *gltf_absolute_filepath;
   crude_gfx_model_renderer_resources                       model_renderer_resouces;
   uint64                                                   images_offset;
 
@@ -372,22 +536,20 @@ crude_gfx_model_renderer_resources_manager_load_gltf_
   
   model_renderer_resouces = CRUDE_COMPOUNT_EMPTY( crude_gfx_model_renderer_resources );
   
-  crude_string_copy( model_renderer_resouces.relative_filepath, gltf_relative_filepath, sizeof( model_renderer_resouces.relative_filepath ) );
+  crude_string_copy( model_renderer_resouces.relative_filepath, prepared_gltf->relative_filepath, sizeof( model_renderer_resouces.relative_filepath ) );
 
   images_offset = CRUDE_ARRAY_LENGTH( manager->images );
 
-  /* Parse gltf */
-  gltf_absolute_filepath = crude_string_buffer_append_use_f( &manager->gltf_absolute_filepath_string_buffer, "%s%s", manager->resources_absolute_directory, gltf_relative_filepath );
-  gltf = crude_gfx_model_renderer_resources_manager_gltf_parse_( manager->cgltf_temporary_allocator, gltf_absolute_filepath );
+  /* Gltf is parsed and meshlets are built by crude_gfx_model_renderer_resources_manager_prepare_gltf */
+  gltf = prepared_gltf->gltf;
   if ( !gltf )
   {
     goto cleanup;
   }
   
-  CRUDE_LOG_INFO( CRUDE_CHANNEL_GRAPHICS, "Loading \"%s\" gltf", gltf_absolute_filepath );
+  gltf_absolute_directory = crude_string_buffer_append_use_f( &manager->gltf_absolute_filepath_string_buffer, "%s%s", manager->resources_absolute_directory, prepared_gltf->relative_filepath );
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_GRAPHICS, "Loading \"%s\" gltf", gltf_absolute_directory );
 
-  gltf_absolute_directory = gltf_absolute_filepath;
-  gltf_absolute_filepath = NULL;
   crude_file_directory_from_path( gltf_absolute_directory );
   
   CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( gltf_mesh_index_to_mesh_primitive_index, gltf->meshes_count, crude_heap_allocator_pack( manager->allocator ) );
@@ -395,7 +557,7 @@ crude_gfx_model_renderer_resources_manager_load_gltf_
   CRUDE_LOG_INFO( CRUDE_CHANNEL_GRAPHICS, "Loading images" );
   crude_gfx_model_renderer_resources_manager_gltf_load_images_( manager, gltf, gltf_absolute_directory );
   CRUDE_LOG_INFO( CRUDE_CHANNEL_GRAPHICS, "Loading geometry" );
-  crude_gfx_model_renderer_resources_manager_gltf_load_geometry_( manager, &model_renderer_resouces, gltf_mesh_index_to_mesh_primitive_index, gltf, gltf_absolute_directory, images_offset );
+  crude_gfx_model_renderer_resources_manager_gltf_load_geometry_( manager, &model_renderer_resouces, gltf_mesh_index_to_mesh_primitive_index, gltf, gltf_absolute_directory, images_offset, &prepared_gltf->meshlets );
   CRUDE_LOG_INFO( CRUDE_CHANNEL_GRAPHICS, "Loading skins" );
   crude_gfx_model_renderer_resources_manager_load_skins_( manager, &model_renderer_resouces, gltf );
   CRUDE_LOG_INFO( CRUDE_CHANNEL_GRAPHICS, "Loading nodes" );
@@ -408,6 +570,9 @@ crude_gfx_model_renderer_resources_manager_load_gltf_
   crude_gfx_model_renderer_resources_manager_create_bottom_level_acceleration_structure_( manager, &model_renderer_resouces );
 #endif
 
+  model_renderer_resouces.size = crude_gfx_model_renderer_resources_manager_calculate_model_size_( &model_renderer_resouces, &prepared_gltf->meshlets );
+  model_renderer_resouces.bounding_radius = crude_gfx_model_renderer_resources_manager_calculate_model_bounding_radius_( &model_renderer_resouces );
+
   CRUDE_LOG_INFO( CRUDE_CHANNEL_GRAPHICS, "Loading finished" );
 
 cleanup:
@@ -416,15 +581,105 @@ cleanup:
     CRUDE_ARRAY_DEINITIALIZE( gltf_mesh_index_to_mesh_primitive_index );
   }
 
-  if ( gltf )
-  {
-    cgltf_free( gltf );
-  }
+  crude_gfx_model_renderer_resources_manager_discard_prepared_gltf( prepared_gltf );
   crude_string_buffer_clear( &manager->gltf_absolute_filepath_string_buffer );
 
   return model_renderer_resouces;
 }
 
+uint64
+crude_gfx_model_renderer_resources_manager_calculate_model_size_
+(
+  _In_ crude_gfx_model_renderer_resources const           *model_renderer_resouces,
+  _In_ crude_gfx_model_renderer_resources_gltf_meshlets const *meshlets
+)
+{
+  uint64                                                   size;
+
+  size = sizeof( *model_renderer_resouces );
+  size += CRUDE_ARRAY_LENGTH( model_renderer_resouces->meshes ) * ( sizeof( crude_gfx_mesh_cpu ) + sizeof( crude_gfx_mesh_draw ) );
+  size += CRUDE_ARRAY_LENGTH( model_renderer_resouces->nodes ) * ( sizeof( crude_gfx_node ) + sizeof( crude_transform ) );
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( model_renderer_resouces->meshes ); ++i )
+  {
+    size += model_renderer_resouces->meshes[ i ].index_hga.size;
+  }
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( model_renderer_resouces->skins ); ++i )
+  {
+    size += CRUDE_ARRAY_LENGTH( model_renderer_resouces->skins[ i ].joints ) * ( sizeof( XMFLOAT4X4 ) + sizeof( int64 ) );
+  }
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( model_renderer_resouces->animations ); ++i )
+  {
+    crude_gfx_animation const                             *animation;
+
+    animation = &model_renderer_resouces->animations[ i ];
+    size += CRUDE_ARRAY_LENGTH( animation->channels ) * sizeof( crude_gfx_animation_channel );
+    for ( uint32 j = 0; j < CRUDE_ARRAY_LENGTH( animation->samplers ); ++j )
+    {
+      size += CRUDE_ARRAY_LENGTH( animation->samplers[ j ].inputs ) * sizeof( float32 ) + CRUDE_ARRAY_LENGTH( animation->samplers[ j ].outputs ) * sizeof( XMFLOAT4 );
+    }
+  }
+
+#if CRUDE_GFX_RAY_TRACING_ENABLED
+  if ( model_renderer_resouces->rtx_affected )
+  {
+    for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( model_renderer_resouces->blases_hga ); ++i )
+    {
+      size += model_renderer_resouces->blases_hga[ i ].size;
+    }
+  }
+#endif
+
+  if ( meshlets->meshlets )
+  {
+    size += CRUDE_ARRAY_LENGTH( meshlets->meshlets ) * sizeof( crude_gfx_meshlet );
+    size += meshlets->vertices_count * ( sizeof( crude_gfx_vertex ) + sizeof( XMFLOAT3 ) + sizeof( crude_gfx_vertex_joint ) );
+    size += meshlets->vertices_indices_count * sizeof( uint32 );
+    size += meshlets->triangles_indices_count * sizeof( uint8 );
+  }
+
+  return size;
+}
+
+float32
+crude_gfx_model_renderer_resources_manager_calculate_model_bounding_radius_
+(
+  _In_ crude_gfx_model_renderer_resources const           *model_renderer_resouces
+)
+{
+  float32                                                  bounding_radius;
+
+  bounding_radius = 0.f;
+  for ( uint32 node_index = 0; node_index < CRUDE_ARRAY_LENGTH( model_renderer_resouces->nodes ); ++node_index )
+  {
+    crude_gfx_node const                                  *node;
+    XMMATRIX                                               node_to_model;
+    float32                                                node_scale;
+
+    node = &model_renderer_resouces->nodes[ node_index ];
+    if ( !CRUDE_ARRAY_LENGTH( node->meshes ) )
+    {
+      continue;
+    }
+
+    node_to_model = crude_gfx_node_to_model( model_renderer_resouces->nodes, model_renderer_resouces->default_nodes_transforms, node_index );
+    node_scale = XMVectorGetX( XMVectorMax( XMVector3Length( node_to_model.r[ 0 ] ), XMVectorMax( XMVector3Length( node_to_model.r[ 1 ] ), XMVector3Length( node_to_model.r[ 2 ] ) ) ) );
+
+    for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( node->meshes ); ++i )
+    {
+      XMFLOAT4 const                                      *mesh_bounding_sphere;
+      XMVECTOR                                             mesh_center;
+
+      mesh_bounding_sphere = &model_renderer_resouces->meshes[ node->meshes[ i ] ].default_bounding_sphere;
+      mesh_center = XMVector3Transform( XMVectorSet( mesh_bounding_sphere->x, mesh_bounding_sphere->y, mesh_bounding_sphere->z, 1.f ), node_to_model );
+      bounding_radius = CRUDE_MAX( bounding_radius, XMVectorGetX( XMVector3Length( mesh_center ) ) + node_scale * mesh_bounding_sphere->w );
+    }
+  }
+
+  return bounding_radius;
+}
 
 /************************************************
  *
@@ -580,6 +835,197 @@ crude_gfx_model_renderer_resources_manager_gltf_parse_
   return gltf;
 }
 
+void
+crude_gfx_model_renderer_resources_manager_gltf_build_meshlets_
+(
+  _In_ crude_heap_allocator                               *allocator,
+  _In_ cgltf_data                                         *gltf,
+  _Out_ crude_gfx_model_renderer_resources_gltf_meshlets  *meshlets
+)
+{
+  crude_gfx_meshlet                                       *local_meshlets;
+  crude_gfx_vertex                                        *local_meshlets_vertices;
+  XMFLOAT3                                                *local_meshlets_vertices_positions;
+  crude_gfx_vertex_joint                                  *local_meshlets_vertices_joints;
+  uint32                                                  *local_meshlets_vertices_indices;
+  uint8                                                   *local_meshlets_triangles_indices;
+  uint32                                                  *meshes_meshlets_counts;
+  uint64                                                   local_meshlets_vertices_offset, local_meshlets_vertices_count;
+  uint32                                                   local_meshlets_offset, local_meshlets_vertices_indices_offset, local_meshlets_triangles_indices_offset;
+  uint32                                                   mesh_index;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_gfx_model_renderer_resources_manager_gltf_build_meshlets" );
+
+  local_meshlets_vertices_count = 0u;
+  mesh_index = 0u;
+
+  for ( uint32 i = 0; i < gltf->meshes_count; ++i )
+  {
+    cgltf_mesh                                            *gltf_mesh;
+    
+    gltf_mesh = &gltf->meshes[ i ];
+    for ( uint32 gltf_primitive_index = 0; gltf_primitive_index < gltf_mesh->primitives_count; ++gltf_primitive_index )
+    {
+      local_meshlets_vertices_count += gltf_mesh->primitives[ gltf_primitive_index ].attributes[ 0 ].data->count;
+    }
+    mesh_index += gltf_mesh->primitives_count;
+  }
+
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( meshes_meshlets_counts, mesh_index, crude_heap_allocator_pack( allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets, 0, crude_heap_allocator_pack( allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_vertices_indices, 0, crude_heap_allocator_pack( allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_triangles_indices, 0, crude_heap_allocator_pack( allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_vertices, local_meshlets_vertices_count, crude_heap_allocator_pack( allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_vertices_positions, local_meshlets_vertices_count, crude_heap_allocator_pack( allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_vertices_joints, local_meshlets_vertices_count, crude_heap_allocator_pack( allocator ) );
+
+  local_meshlets_offset = 0u;
+  local_meshlets_vertices_indices_offset = 0u;
+  local_meshlets_triangles_indices_offset = 0u;
+  local_meshlets_vertices_offset = 0u;
+  mesh_index = 0u;
+
+  for ( uint32 i = 0; i < gltf->meshes_count; ++i )
+  {
+    cgltf_mesh                                            *gltf_mesh;
+    
+    gltf_mesh = &gltf->meshes[ i ];
+
+    for ( uint32 gltf_primitive_index = 0; gltf_primitive_index < gltf_mesh->primitives_count; ++gltf_primitive_index )
+    {
+      crude_gfx_meshlet const                             *last_local_meshlet;
+      cgltf_primitive                                     *gltf_mesh_primitive;
+      uint32                                              *primitive_indices;
+      meshopt_Meshlet                                     *primitive_meshlets;
+      uint64                                               primitive_local_max_meshlets, primitive_local_meshletes_count;
+      uint32                                               primitive_vertices_count, primitive_indices_count;
+    
+      gltf_mesh_primitive = &gltf_mesh->primitives[ gltf_primitive_index ];
+      primitive_vertices_count = gltf_mesh->primitives[ gltf_primitive_index ].attributes[ 0 ].data->count;
+      primitive_indices_count = gltf_mesh->primitives[ gltf_primitive_index ].indices->count;
+    
+      CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( primitive_indices, primitive_indices_count, crude_heap_allocator_pack( allocator ) );
+    
+      crude_gfx_model_renderer_resources_manager_gltf_load_meshlet_vertices_(
+        gltf_mesh_primitive,
+        local_meshlets_vertices + local_meshlets_vertices_offset,
+        local_meshlets_vertices_positions + local_meshlets_vertices_offset,
+        local_meshlets_vertices_joints + local_meshlets_vertices_offset );
+
+      crude_gfx_model_renderer_resources_manager_gltf_load_meshlet_indices_(
+        gltf_mesh_primitive,
+        primitive_indices );
+
+      /* Build meshlets*/
+      primitive_local_max_meshlets = meshopt_buildMeshletsBound(
+        primitive_indices_count,
+        CRUDE_GFX_MESHLET_MAX_VERTICES,
+        CRUDE_GFX_MESHLET_MAX_TRIANGLES );
+    
+      CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( primitive_meshlets, primitive_local_max_meshlets, crude_heap_allocator_pack( allocator ) );
+
+      CRUDE_ARRAY_SET_LENGTH( local_meshlets_vertices_indices, local_meshlets_vertices_indices_offset + primitive_local_max_meshlets * CRUDE_GFX_MESHLET_MAX_VERTICES );
+      CRUDE_ARRAY_SET_LENGTH( local_meshlets_triangles_indices, local_meshlets_triangles_indices_offset + primitive_local_max_meshlets * CRUDE_GFX_MESHLET_MAX_TRIANGLES * 3 );
+      
+      /* Build meshlets */
+      primitive_local_meshletes_count = meshopt_buildMeshlets(
+        primitive_meshlets,
+        local_meshlets_vertices_indices + local_meshlets_vertices_indices_offset,
+        local_meshlets_triangles_indices + local_meshlets_triangles_indices_offset,
+        primitive_indices, primitive_indices_count, 
+        &local_meshlets_vertices_positions[ local_meshlets_vertices_offset ].x,
+        primitive_vertices_count,
+        sizeof( crude_gfx_vertex_position ),
+        CRUDE_GFX_MESHLET_MAX_VERTICES, CRUDE_GFX_MESHLET_MAX_TRIANGLES, CRUDE_GFX_MESHLET_CONE_WEIGHT );
+    
+      CRUDE_ARRAY_SET_LENGTH( local_meshlets, local_meshlets_offset + primitive_local_meshletes_count );
+
+      /* Optimize meshlets */
+      for ( uint32 meshopt_meshlet_index = 0; meshopt_meshlet_index < primitive_local_meshletes_count; ++meshopt_meshlet_index )
+      {
+        meshopt_Meshlet const                             *meshopt_local_meshlet;
+        
+        meshopt_local_meshlet = &primitive_meshlets[ meshopt_meshlet_index ];
+
+        CRUDE_ASSERT( meshopt_local_meshlet->vertex_count <= CRUDE_GFX_MESHLET_MAX_VERTICES );
+        CRUDE_ASSERT( meshopt_local_meshlet->triangle_count <= CRUDE_GFX_MESHLET_MAX_TRIANGLES );
+
+        meshopt_optimizeMeshlet(
+          local_meshlets_vertices_indices + local_meshlets_vertices_indices_offset + meshopt_local_meshlet->vertex_offset,
+          local_meshlets_triangles_indices + local_meshlets_triangles_indices_offset + meshopt_local_meshlet->triangle_offset,
+          meshopt_local_meshlet->triangle_count, meshopt_local_meshlet->vertex_count );
+      }
+
+      /* Fill meshlets */
+      for ( uint32 meshopt_meshlet_index = 0; meshopt_meshlet_index < primitive_local_meshletes_count; ++meshopt_meshlet_index )
+      {
+        crude_gfx_meshlet                                 *new_meshlet;
+        meshopt_Meshlet const                             *meshopt_local_meshlet;
+        meshopt_Bounds                                     meshopt_meshlet_bounds;
+
+        meshopt_local_meshlet = &primitive_meshlets[ meshopt_meshlet_index ];
+
+        meshopt_meshlet_bounds = meshopt_computeMeshletBounds(
+          local_meshlets_vertices_indices + local_meshlets_vertices_indices_offset + meshopt_local_meshlet->vertex_offset,
+          local_meshlets_triangles_indices + local_meshlets_triangles_indices_offset + meshopt_local_meshlet->triangle_offset,
+          meshopt_local_meshlet->triangle_count,
+          &local_meshlets_vertices_positions[ local_meshlets_vertices_offset ].x,
+          primitive_vertices_count,
+          sizeof( crude_gfx_vertex_position ) );
+
+        new_meshlet = &local_meshlets[ meshopt_meshlet_index + local_meshlets_offset ];
+        new_meshlet->vertices_offset = local_meshlets_vertices_indices_offset + meshopt_local_meshlet->vertex_offset;
+        new_meshlet->triangles_offset = local_meshlets_triangles_indices_offset + meshopt_local_meshlet->triangle_offset;
+        new_meshlet->vertices_count = meshopt_local_meshlet->vertex_count;
+        new_meshlet->triangles_count = meshopt_local_meshlet->triangle_count;
+        /* Local mesh index, global index is known when the model is added */
+        new_meshlet->mesh_index = mesh_index;
+        new_meshlet->center.x = meshopt_meshlet_bounds.center[ 0 ];
+        new_meshlet->center.y = meshopt_meshlet_bounds.center[ 1 ];
+        new_meshlet->center.z = meshopt_meshlet_bounds.center[ 2 ];
+        new_meshlet->radius = meshopt_meshlet_bounds.radius;
+        new_meshlet->cone_axis[ 0 ] = meshopt_meshlet_bounds.cone_axis_s8[ 0 ];
+        new_meshlet->cone_axis[ 1 ] = meshopt_meshlet_bounds.cone_axis_s8[ 1 ];
+        new_meshlet->cone_axis[ 2 ] = meshopt_meshlet_bounds.cone_axis_s8[ 2 ];
+        new_meshlet->cone_cutoff = meshopt_meshlet_bounds.cone_cutoff_s8;
+      }
+      
+      last_local_meshlet = &local_meshlets[ local_meshlets_offset + primitive_local_meshletes_count - 1 ];
+      
+      meshes_meshlets_counts[ mesh_index ] = primitive_local_meshletes_count;
+
+      /* We fill offset for each primitive */
+      for ( uint32 i = local_meshlets_vertices_indices_offset; i < last_local_meshlet->vertices_offset + last_local_meshlet->vertices_count; ++i )
+      {
+        local_meshlets_vertices_indices[ i ] += local_meshlets_vertices_offset;
+      }
+
+      local_meshlets_vertices_indices_offset = last_local_meshlet->vertices_offset + last_local_meshlet->vertices_count;
+      local_meshlets_triangles_indices_offset = last_local_meshlet->triangles_offset + 3u * last_local_meshlet->triangles_count;
+      local_meshlets_offset += primitive_local_meshletes_count;
+      local_meshlets_vertices_offset += primitive_vertices_count;
+    
+      CRUDE_ARRAY_DEINITIALIZE( primitive_meshlets );
+      CRUDE_ARRAY_DEINITIALIZE( primitive_indices );
+
+      ++mesh_index;
+    }
+  }
+
+  meshlets->meshlets = local_meshlets;
+  meshlets->vertices = local_meshlets_vertices;
+  meshlets->vertices_positions = local_meshlets_vertices_positions;
+  meshlets->vertices_joints = local_meshlets_vertices_joints;
+  meshlets->vertices_indices = local_meshlets_vertices_indices;
+  meshlets->triangles_indices = local_meshlets_triangles_indices;
+  meshlets->meshes_meshlets_counts = meshes_meshlets_counts;
+  meshlets->vertices_count = local_meshlets_vertices_offset;
+  meshlets->vertices_indices_count = local_meshlets_vertices_indices_offset;
+  meshlets->triangles_indices_count = local_meshlets_triangles_indices_offset;
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
 static void
 crude_gfx_model_renderer_resources_manager_gltf_load_images_
 (
@@ -634,7 +1080,8 @@ crude_gfx_model_renderer_resources_manager_gltf_load_geometry_
   _Out_ uint32                                            *gltf_mesh_index_to_mesh_primitive_index,
   _In_ cgltf_data                                         *gltf,
   _In_ char const                                         *gltf_absolute_directory,
-  _In_ uint32                                              images_offset
+  _In_ uint32                                              images_offset,
+  _In_ crude_gfx_model_renderer_resources_gltf_meshlets   *meshlets
 )
 {
   crude_gfx_mesh_draw                                     *meshes_draws;
@@ -744,170 +1191,27 @@ crude_gfx_model_renderer_resources_manager_gltf_load_geometry_
     }
   }
 
-  if ( manager->gpu->mesh_shaders_extension_present )
+  if ( manager->gpu->mesh_shaders_extension_present && meshlets->meshlets )
   {
-    crude_gfx_meshlet                                     *local_meshlets;
-    crude_gfx_vertex                                      *local_meshlets_vertices;
-    XMFLOAT3                                              *local_meshlets_vertices_positions;
-    crude_gfx_vertex_joint                                *local_meshlets_vertices_joints;
-    uint32                                                *local_meshlets_vertices_indices;
-    uint8                                                 *local_meshlets_triangles_indices;
-    uint64                                                 local_meshlets_vertices_offset, local_meshlets_vertices_count;
-    uint32                                                 local_meshlets_offset, local_meshlets_vertices_indices_offset, local_meshlets_triangles_indices_offset;
-
-    local_meshlets_vertices_count = 0u;
-  
-    for ( uint32 i = 0; i < gltf->meshes_count; ++i )
+    uint32                                                 meshlets_offset;
+
+    /* Meshlets were built with offsets local to the model */
+    meshlets_offset = 0u;
+    for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( model_renderer_resouces->meshes ); ++i )
     {
-      cgltf_mesh                                          *gltf_mesh;
-      
-      gltf_mesh = &gltf->meshes[ i ];
-      for ( uint32 gltf_primitive_index = 0; gltf_primitive_index < gltf_mesh->primitives_count; ++gltf_primitive_index )
-      {
-        local_meshlets_vertices_count += gltf_mesh->primitives[ gltf_primitive_index ].attributes[ 0 ].data->count;
-      }
+      model_renderer_resouces->meshes[ i ].meshlets_count = meshlets->meshes_meshlets_counts[ i ];
+      model_renderer_resouces->meshes[ i ].meshlets_offset = meshlets_offset + manager->total_meshlets_count;
+      meshlets_offset += meshlets->meshes_meshlets_counts[ i ];
     }
 
-    CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets, 0, crude_heap_allocator_pack( manager->allocator ) );
-    CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_vertices_indices, 0, crude_heap_allocator_pack( manager->allocator ) );
-    CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_triangles_indices, 0, crude_heap_allocator_pack( manager->allocator ) );
-    CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_vertices, local_meshlets_vertices_count, crude_heap_allocator_pack( manager->allocator ) );
-    CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_vertices_positions, local_meshlets_vertices_count, crude_heap_allocator_pack( manager->allocator ) );
-    CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( local_meshlets_vertices_joints, local_meshlets_vertices_count, crude_heap_allocator_pack( manager->allocator ) );
-  
-    local_meshlets_offset = 0u;
-    local_meshlets_vertices_indices_offset = 0u;
-    local_meshlets_triangles_indices_offset = 0u;
-    local_meshlets_vertices_offset = 0u;
-    mesh_index = 0u;
-
-    for ( uint32 i = 0; i < gltf->meshes_count; ++i )
+    for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( meshlets->meshlets ); ++i )
     {
-      cgltf_mesh                                          *gltf_mesh;
-      
-      gltf_mesh = &gltf->meshes[ i ];
-
-      for ( uint32 gltf_primitive_index = 0; gltf_primitive_index < gltf_mesh->primitives_count; ++gltf_primitive_index )
-      {
-        crude_gfx_meshlet const                           *last_local_meshlet;
-        cgltf_primitive                                   *gltf_mesh_primitive;
-        uint32                                            *primitive_indices;
-        meshopt_Meshlet                                   *primitive_meshlets;
-        uint64                                             primitive_local_max_meshlets, primitive_local_meshletes_count, primitive_local_meshletes_offset;
-        uint32                                             primitive_vertices_count, primitive_indices_count;
-      
-        gltf_mesh_primitive = &gltf_mesh->primitives[ gltf_primitive_index ];
-
-        primitive_vertices_count = gltf_mesh->primitives[ gltf_primitive_index ].attributes[ 0 ].data->count;
-        primitive_indices_count = gltf_mesh->primitives[ gltf_primitive_index ].indices->count;
-      
-        CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( primitive_indices, primitive_indices_count, crude_heap_allocator_pack( manager->allocator ) );
-      
-        crude_gfx_model_renderer_resources_manager_gltf_load_meshlet_vertices_(
-          gltf_mesh_primitive,
-          local_meshlets_vertices + local_meshlets_vertices_offset,
-          local_meshlets_vertices_positions + local_meshlets_vertices_offset,
-          local_meshlets_vertices_joints + local_meshlets_vertices_offset );
-
-        crude_gfx_model_renderer_resources_manager_gltf_load_meshlet_indices_(
-          gltf_mesh_primitive,
-          primitive_indices );
-
-        /* Build meshlets*/
-        primitive_local_max_meshlets = meshopt_buildMeshletsBound(
-          primitive_indices_count,
-          CRUDE_GFX_MESHLET_MAX_VERTICES,
-          CRUDE_GFX_MESHLET_MAX_TRIANGLES );
-      
-        CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( primitive_meshlets, primitive_local_max_meshlets, crude_heap_allocator_pack( manager->allocator ) );
-
-        CRUDE_ARRAY_SET_LENGTH( local_meshlets_vertices_indices, local_meshlets_vertices_indices_offset + primitive_local_max_meshlets * CRUDE_GFX_MESHLET_MAX_VERTICES );
-        CRUDE_ARRAY_SET_LENGTH( local_meshlets_triangles_indices, local_meshlets_triangles_indices_offset + primitive_local_max_meshlets * CRUDE_GFX_MESHLET_MAX_TRIANGLES * 3 );
-        
-        /* Build meshlets */
-        primitive_local_meshletes_count = meshopt_buildMeshlets(
-          primitive_meshlets,
-          local_meshlets_vertices_indices + local_meshlets_vertices_indices_offset,
-          local_meshlets_triangles_indices + local_meshlets_triangles_indices_offset,
-          primitive_indices, primitive_indices_count, 
-          &local_meshlets_vertices_positions[ local_meshlets_vertices_offset ].x,
-          primitive_vertices_count,
-          sizeof( crude_gfx_vertex_position ),
-          CRUDE_GFX_MESHLET_MAX_VERTICES, CRUDE_GFX_MESHLET_MAX_TRIANGLES, CRUDE_GFX_MESHLET_CONE_WEIGHT );
-      
-        CRUDE_ARRAY_SET_LENGTH( local_meshlets, local_meshlets_offset + primitive_local_meshletes_count );
-
-        /* Optimize meshlets */
-        for ( uint32 meshopt_meshlet_index = 0; meshopt_meshlet_index < primitive_local_meshletes_count; ++meshopt_meshlet_index )
-        {
-          meshopt_Meshlet const                           *meshopt_local_meshlet;
-          
-          meshopt_local_meshlet = &primitive_meshlets[ meshopt_meshlet_index ];
-
-          CRUDE_ASSERT( meshopt_local_meshlet->vertex_count <= CRUDE_GFX_MESHLET_MAX_VERTICES );
-          CRUDE_ASSERT( meshopt_local_meshlet->triangle_count <= CRUDE_GFX_MESHLET_MAX_TRIANGLES );
-
-          meshopt_optimizeMeshlet(
-            local_meshlets_vertices_indices + local_meshlets_vertices_indices_offset + meshopt_local_meshlet->vertex_offset,
-            local_meshlets_triangles_indices + local_meshlets_triangles_indices_offset + meshopt_local_meshlet->triangle_offset,
-            meshopt_local_meshlet->triangle_count, meshopt_local_meshlet->vertex_count );
-        }
-
-        /* Fill meshlets */
-        for ( uint32 meshopt_meshlet_index = 0; meshopt_meshlet_index < primitive_local_meshletes_count; ++meshopt_meshlet_index )
-        {
-          crude_gfx_meshlet                               *new_meshlet;
-          meshopt_Meshlet const                           *meshopt_local_meshlet;
-          meshopt_Bounds                                   meshopt_meshlet_bounds;
-
-          meshopt_local_meshlet = &primitive_meshlets[ meshopt_meshlet_index ];
-
-          meshopt_meshlet_bounds = meshopt_computeMeshletBounds(
-            local_meshlets_vertices_indices + local_meshlets_vertices_indices_offset + meshopt_local_meshlet->vertex_offset,
-            local_meshlets_triangles_indices + local_meshlets_triangles_indices_offset + meshopt_local_meshlet->triangle_offset,
-            meshopt_local_meshlet->triangle_count,
-            &local_meshlets_vertices_positions[ local_meshlets_vertices_offset ].x,
-            primitive_vertices_count,
-            sizeof( crude_gfx_vertex_position ) );
-
-          new_meshlet = &local_meshlets[ meshopt_meshlet_index + local_meshlets_offset ];
-          new_meshlet->vertices_offset = local_meshlets_vertices_indices_offset + meshopt_local_meshlet->vertex_offset;
-          new_meshlet->triangles_offset = local_meshlets_triangles_indices_offset + meshopt_local_meshlet->triangle_offset;
-          new_meshlet->vertices_count = meshopt_local_meshlet->vertex_count;
-          new_meshlet->triangles_count = meshopt_local_meshlet->triangle_count;
-          new_meshlet->mesh_index = model_renderer_resouces->meshes[ mesh_index ].gpu_mesh_global_index;
-          new_meshlet->center.x = meshopt_meshlet_bounds.center[ 0 ];
-          new_meshlet->center.y = meshopt_meshlet_bounds.center[ 1 ];
-          new_meshlet->center.z = meshopt_meshlet_bounds.center[ 2 ];
-          new_meshlet->radius = meshopt_meshlet_bounds.radius;
-          new_meshlet->cone_axis[ 0 ] = meshopt_meshlet_bounds.cone_axis_s8[ 0 ];
-          new_meshlet->cone_axis[ 1 ] = meshopt_meshlet_bounds.cone_axis_s8[ 1 ];
-          new_meshlet->cone_axis[ 2 ] = meshopt_meshlet_bounds.cone_axis_s8[ 2 ];
-          new_meshlet->cone_cutoff = meshopt_meshlet_bounds.cone_cutoff_s8;
-        }
-        
-        last_local_meshlet = &local_meshlets[ local_meshlets_offset + primitive_local_meshletes_count - 1 ];
-        
-        /* Fill meshelets data to mesh */
-        model_renderer_resouces->meshes[ mesh_index ].meshlets_count = primitive_local_meshletes_count;
-        model_renderer_resouces->meshes[ mesh_index ].meshlets_offset = local_meshlets_offset + manager->total_meshlets_count;
-
-        /* We fill offset for each primitive */
-        for ( uint32 i = local_meshlets_vertices_indices_offset; i < last_local_meshlet->vertices_offset + last_local_meshlet->vertices_count; ++i )
-        {
-          local_meshlets_vertices_indices[ i ] += local_meshlets_vertices_offset + manager->total_meshlets_vertices_count;
-        }
-
-        local_meshlets_vertices_indices_offset = last_local_meshlet->vertices_offset + last_local_meshlet->vertices_count;
-        local_meshlets_triangles_indices_offset = last_local_meshlet->triangles_offset + 3u * last_local_meshlet->triangles_count;
-        local_meshlets_offset += primitive_local_meshletes_count;
-        local_meshlets_vertices_offset += primitive_vertices_count;
-      
-        CRUDE_ARRAY_DEINITIALIZE( primitive_meshlets );
-        CRUDE_ARRAY_DEINITIALIZE( primitive_indices );
+      meshlets->meshlets[ i ].mesh_index += manager->total_meshes_count;
+    }
 
-        ++mesh_index;
-      }
+    for ( uint32 i = 0; i < meshlets->vertices_indices_count; ++i )
+    {
+      meshlets->vertices_indices[ i ] += manager->total_meshlets_vertices_count;
     }
     
     /* Create indices buffer for meshes (so we still can use meshlets vertices ) */
@@ -915,96 +1219,86 @@ crude_gfx_model_renderer_resources_manager_gltf_load_geometry_
       uint32                                               primitive_meshlet_index_offset;
 
       primitive_meshlet_index_offset = 0u;
-      mesh_index = 0u;
 
-      for ( uint32 gltf_mesh_index = 0; gltf_mesh_index < gltf->meshes_count; ++gltf_mesh_index )
+      for ( mesh_index = 0u; mesh_index < CRUDE_ARRAY_LENGTH( model_renderer_resouces->meshes ); ++mesh_index )
       {
-        cgltf_mesh                                        *gltf_mesh;
-
-        gltf_mesh = &gltf->meshes[ gltf_mesh_index ];
+        crude_gfx_mesh_cpu                                *mesh_cpu;
+        uint32                                            *mesh_indices;
+        crude_gfx_memory_allocation                        cpu_allocation;
+        uint64                                             mesh_indices_count;
+        
+        mesh_cpu = &model_renderer_resouces->meshes[ mesh_index ];
 
-        for ( uint32 gltf_primitive_index = 0; gltf_primitive_index < gltf_mesh->primitives_count; ++gltf_primitive_index )
+        mesh_indices_count = 0u;
+        for ( uint32 primitive_meshlet_index = 0; primitive_meshlet_index < mesh_cpu->meshlets_count; ++primitive_meshlet_index )
         {
-          crude_gfx_mesh_cpu                                  *mesh_cpu;
-          uint32                                              *mesh_indices;
-          crude_gfx_memory_allocation                          cpu_allocation;
-          uint64                                               mesh_indices_count;
-          
-          mesh_cpu = &model_renderer_resouces->meshes[ mesh_index ];
-
-          mesh_indices_count = 0u;
-          for ( uint32 primitive_meshlet_index = 0; primitive_meshlet_index < mesh_cpu->meshlets_count; ++primitive_meshlet_index )
-          {
-            mesh_indices_count += 3 * local_meshlets[ primitive_meshlet_index_offset + primitive_meshlet_index ].triangles_count;
-          }
+          mesh_indices_count += 3 * meshlets->meshlets[ primitive_meshlet_index_offset + primitive_meshlet_index ].triangles_count;
+        }
 
-          mesh_cpu->indices_count = mesh_indices_count;
+        mesh_cpu->indices_count = mesh_indices_count;
 
-          CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( mesh_indices, mesh_indices_count, crude_heap_allocator_pack( manager->allocator ) );
+        CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( mesh_indices, mesh_indices_count, crude_heap_allocator_pack( manager->allocator ) );
 
-          mesh_indices_count = 0u;
-          for ( uint32 local_meshlet_index = 0; local_meshlet_index < mesh_cpu->meshlets_count; ++local_meshlet_index )
+        mesh_indices_count = 0u;
+        for ( uint32 local_meshlet_index = 0; local_meshlet_index < mesh_cpu->meshlets_count; ++local_meshlet_index )
+        {
+          crude_gfx_meshlet const                         *meshlet;
+          
+          meshlet = &meshlets->meshlets[ primitive_meshlet_index_offset + local_meshlet_index ];
+          for ( uint32 t = 0; t < 3 * meshlet->triangles_count; ++t )
           {
-            crude_gfx_meshlet const                       *meshlet;
-            
-            meshlet = &local_meshlets[ primitive_meshlet_index_offset + local_meshlet_index ];
-            for ( uint32 t = 0; t < 3 * meshlet->triangles_count; ++t )
-            {
-              uint32                                       vertex_index, triangle_index;
+            uint32                                         vertex_index, triangle_index;
 
-              triangle_index = local_meshlets_triangles_indices[ t + meshlet->triangles_offset ];
-              vertex_index = local_meshlets_vertices_indices[ triangle_index + meshlet->vertices_offset ];
-              mesh_indices[ mesh_indices_count++ ] = vertex_index;
-            }
+            triangle_index = meshlets->triangles_indices[ t + meshlet->triangles_offset ];
+            vertex_index = meshlets->vertices_indices[ triangle_index + meshlet->vertices_offset ];
+            mesh_indices[ mesh_indices_count++ ] = vertex_index;
           }
-          
-          cpu_allocation = crude_gfx_memory_allocate_cpu_gpu_copy(
-            manager->gpu,
-            mesh_indices,
-            sizeof( mesh_indices[ 0 ] ) * mesh_indices_count, CRUDE_GFX_RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR  );
-
-          /* Queue cpu memory destroy */
-          crude_gfx_memory_deallocate( manager->gpu, cpu_allocation );
+        }
+        
+        cpu_allocation = crude_gfx_memory_allocate_cpu_gpu_copy(
+          manager->gpu,
+          mesh_indices,
+          sizeof( mesh_indices[ 0 ] ) * mesh_indices_count, CRUDE_GFX_RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR  );
 
-          mesh_cpu->index_hga = crude_gfx_memory_allocate_with_pname(
-            manager->gpu,
-            sizeof( mesh_indices[ 0 ] ) * mesh_indices_count,
-            CRUDE_GFX_MEMORY_TYPE_GPU,
-            "mseh_index_hga", CRUDE_GFX_RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR  );
+        /* Queue cpu memory destroy */
+        crude_gfx_memory_deallocate( manager->gpu, cpu_allocation );
 
-          crude_gfx_cmd_memory_copy( immediate_transfer_cmd_buffer, cpu_allocation, mesh_cpu->index_hga, 0u, 0u );
+        mesh_cpu->index_hga = crude_gfx_memory_allocate_with_pname(
+          manager->gpu,
+          sizeof( mesh_indices[ 0 ] ) * mesh_indices_count,
+          CRUDE_GFX_MEMORY_TYPE_GPU,
+          "mseh_index_hga", CRUDE_GFX_RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR  );
 
-          CRUDE_ARRAY_PUSH( manager->indices_buffers, mesh_cpu->index_hga );
+        crude_gfx_cmd_memory_copy( immediate_transfer_cmd_buffer, cpu_allocation, mesh_cpu->index_hga, 0u, 0u );
 
-          CRUDE_ARRAY_DEINITIALIZE( mesh_indices );
+        CRUDE_ARRAY_PUSH( manager->indices_buffers, mesh_cpu->index_hga );
 
-          ++mesh_index;
+        CRUDE_ARRAY_DEINITIALIZE( mesh_indices );
 
-          primitive_meshlet_index_offset += mesh_cpu->meshlets_count;
-        }
+        primitive_meshlet_index_offset += mesh_cpu->meshlets_count;
       }
     }
 
-    for ( uint32 i = 0; i < local_meshlets_offset; ++i )
+    for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( meshlets->meshlets ); ++i )
     {
-      local_meshlets[ i ].vertices_offset += manager->total_meshlets_vertices_indices_count;
-      local_meshlets[ i ].triangles_offset += manager->total_meshlets_triangles_indices_count;
+      meshlets->meshlets[ i ].vertices_offset += manager->total_meshlets_vertices_indices_count;
+      meshlets->meshlets[ i ].triangles_offset += manager->total_meshlets_triangles_indices_count;
     }
 
-    manager->total_meshlets_count += local_meshlets_offset;
-    manager->total_meshlets_vertices_count += local_meshlets_vertices_offset;
-    manager->total_meshlets_vertices_indices_count += local_meshlets_vertices_indices_offset;
-    manager->total_meshlets_triangles_indices_count += local_meshlets_triangles_indices_offset;
+    manager->total_meshlets_count += CRUDE_ARRAY_LENGTH( meshlets->meshlets );
+    manager->total_meshlets_vertices_count += meshlets->vertices_count;
+    manager->total_meshlets_vertices_indices_count += meshlets->vertices_indices_count;
+    manager->total_meshlets_triangles_indices_count += meshlets->triangles_indices_count;
     
     manager->meshlets_hga = crude_gfx_asynchronous_loader_request_buffer_reallocate_and_copy(
       manager->async_loader,
       crude_gfx_memory_allocate_cpu_gpu_copy(
         manager->gpu,
-        local_meshlets,
-        sizeof( local_meshlets[ 0 ] ) * local_meshlets_offset, 0 ),
+        meshlets->meshlets,
+        sizeof( meshlets->meshlets[ 0 ] ) * CRUDE_ARRAY_LENGTH( meshlets->meshlets ), 0 ),
       crude_gfx_memory_allocate_with_pname(
         manager->gpu,
-        sizeof( local_meshlets[ 0 ] ) * manager->total_meshlets_count,
+        sizeof( meshlets->meshlets[ 0 ] ) * manager->total_meshlets_count,
         CRUDE_GFX_MEMORY_TYPE_GPU,
         "meshlets_hga", 0 ),
       manager->meshlets_hga );
@@ -1013,11 +1307,11 @@ crude_gfx_model_renderer_resources_manager_gltf_load_geometry_
       manager->async_loader,
       crude_gfx_memory_allocate_cpu_gpu_copy(
         manager->gpu,
-        local_meshlets_triangles_indices,
-        sizeof( local_meshlets_triangles_indices[ 0 ] ) * local_meshlets_triangles_indices_offset, 0 ),
+        meshlets->triangles_indices,
+        sizeof( meshlets->triangles_indices[ 0 ] ) * meshlets->triangles_indices_count, 0 ),
       crude_gfx_memory_allocate_with_pname(
         manager->gpu,
-        sizeof( local_meshlets_triangles_indices[ 0 ] ) * manager->total_meshlets_triangles_indices_count,
+        sizeof( meshlets->triangles_indices[ 0 ] ) * manager->total_meshlets_triangles_indices_count,
         CRUDE_GFX_MEMORY_TYPE_GPU,
         "meshlets_triangles_indices_hga", 0 ),
       manager->meshlets_triangles_indices_hga );
@@ -1026,11 +1320,11 @@ crude_gfx_model_renderer_resources_manager_gltf_load_geometry_
       manager->async_loader,
       crude_gfx_memory_allocate_cpu_gpu_copy(
         manager->gpu,
-        local_meshlets_vertices_indices,
-        sizeof( local_meshlets_vertices_indices[ 0 ] ) * local_meshlets_vertices_indices_offset, 0 ),
+        meshlets->vertices_indices,
+        sizeof( meshlets->vertices_indices[ 0 ] ) * meshlets->vertices_indices_count, 0 ),
       crude_gfx_memory_allocate_with_pname(
         manager->gpu,
-        sizeof( local_meshlets_vertices_indices[ 0 ] ) * manager->total_meshlets_vertices_indices_count,
+        sizeof( meshlets->vertices_indices[ 0 ] ) * manager->total_meshlets_vertices_indices_count,
         CRUDE_GFX_MEMORY_TYPE_GPU,
         "meshlets_vertices_indices_hga", 0 ),
       manager->meshlets_vertices_indices_hga );
@@ -1039,11 +1333,11 @@ crude_gfx_model_renderer_resources_manager_gltf_load_geometry_
       manager->async_loader,
       crude_gfx_memory_allocate_cpu_gpu_copy(
         manager->gpu,
-        local_meshlets_vertices,
-        sizeof( local_meshlets_vertices[ 0 ] ) * local_meshlets_vertices_offset, 0 ),
+        meshlets->vertices,
+        sizeof( meshlets->vertices[ 0 ] ) * meshlets->vertices_count, 0 ),
       crude_gfx_memory_allocate_with_pname(
         manager->gpu,
-        sizeof( local_meshlets_vertices[ 0 ] ) * manager->total_meshlets_vertices_count,
+        sizeof( meshlets->vertices[ 0 ] ) * manager->total_meshlets_vertices_count,
         CRUDE_GFX_MEMORY_TYPE_GPU,
         "meshlets_vertices_hga", 0 ),
       manager->meshlets_vertices_hga );
@@ -1054,15 +1348,15 @@ crude_gfx_model_renderer_resources_manager_gltf_load_geometry_
 
       cpu_allocation = crude_gfx_memory_allocate_cpu_gpu_copy(
         manager->gpu,
-        local_meshlets_vertices_positions,
-        sizeof( local_meshlets_vertices_positions[ 0 ] ) * local_meshlets_vertices_offset, CRUDE_GFX_RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR  );
+        meshlets->vertices_positions,
+        sizeof( meshlets->vertices_positions[ 0 ] ) * meshlets->vertices_count, CRUDE_GFX_RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR  );
       
       /* Queue cpu memory destroy */
       crude_gfx_memory_deallocate( manager->gpu, cpu_allocation );
 
       gpu_allocation = crude_gfx_memory_allocate_with_pname(
         manager->gpu,
-        sizeof( local_meshlets_vertices_positions[ 0 ] ) * manager->total_meshlets_vertices_count,
+        sizeof( meshlets->vertices_positions[ 0 ] ) * manager->total_meshlets_vertices_count,
         CRUDE_GFX_MEMORY_TYPE_GPU,
         "meshlets_vertices_positions_hga", CRUDE_GFX_RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR  );
 
@@ -1080,21 +1374,14 @@ crude_gfx_model_renderer_resources_manager_gltf_load_geometry_
       manager->async_loader,
       crude_gfx_memory_allocate_cpu_gpu_copy(
         manager->gpu,
-        local_meshlets_vertices_joints,
-        sizeof( local_meshlets_vertices_joints[ 0 ] ) * local_meshlets_vertices_offset, 0 ),
+        meshlets->vertices_joints,
+        sizeof( meshlets->vertices_joints[ 0 ] ) * meshlets->vertices_count, 0 ),
       crude_gfx_memory_allocate_with_pname(
         manager->gpu,
-        sizeof( local_meshlets_vertices_joints[ 0 ] ) * manager->total_meshlets_vertices_count,
+        sizeof( meshlets->vertices_joints[ 0 ] ) * manager->total_meshlets_vertices_count,
         CRUDE_GFX_MEMORY_TYPE_GPU,
         "meshlets_vertices_joints_hga", 0 ),
       manager->meshlets_vertices_joints_hga );
-    
-    CRUDE_ARRAY_DEINITIALIZE( local_meshlets );
-    CRUDE_ARRAY_DEINITIALIZE( local_meshlets_vertices_indices );
-    CRUDE_ARRAY_DEINITIALIZE( local_meshlets_triangles_indices );
-    CRUDE_ARRAY_DEINITIALIZE( local_meshlets_vertices );
-    CRUDE_ARRAY_DEINITIALIZE( local_meshlets_vertices_positions );
-    CRUDE_ARRAY_DEINITIALIZE( local_meshlets_vertices_joints );
   }
   
   manager->total_meshes_count += CRUDE_ARRAY_LENGTH( model_renderer_resouces->meshes );
@@ -8,6 +8,36 @@
 #include <engine/graphics/texture_manager.h>
 #include <engine/graphics/gpu_memory.h>
 
+struct cgltf_data;
+
+/* Meshlets of one gltf, offsets are local to the model till it's added to the manager */
+typedef struct crude_gfx_model_renderer_resources_gltf_meshlets
+{
+  crude_gfx_meshlet                                       *meshlets;
+  crude_gfx_vertex                                        *vertices;
+  XMFLOAT3                                                *vertices_positions;
+  crude_gfx_vertex_joint                                  *vertices_joints;
+  uint32                                                  *vertices_indices;
+  uint8                                                   *triangles_indices;
+  /* Per mesh primitive, in gltf order */
+  uint32                                                  *meshes_meshlets_counts;
+  uint64                                                   vertices_count;
+  uint32                                                   vertices_indices_count;
+  uint32                                                   triangles_indices_count;
+} crude_gfx_model_renderer_resources_gltf_meshlets;
+
+/**
+ * Gltf with loaded buffers and built meshlets. Prepared without touching
+ * the manager state, so it could be done on a worker thread, GPU resources
+ * are created when it's added to the manager on the main thread.
+ */
+typedef struct crude_gfx_model_renderer_resources_prepared_gltf
+{
+  char                                                     relative_filepath[ CRUDE_GFX_MODEL_RESOURCE_RELATIVE_FILEPATH_LENGTH_MAX ];
+  struct cgltf_data                                       *gltf;
+  crude_gfx_model_renderer_resources_gltf_meshlets         meshlets;
+} crude_gfx_model_renderer_resources_prepared_gltf;
+
 typedef struct crude_gfx_model_renderer_resources_manager_creation
 {
   crude_gfx_asynchronous_loader                           *async_loader;
@@ -100,6 +130,49 @@ crude_gfx_model_renderer_resources_manager_get_gltf_model
   _In_ char const                                         *filepath
 );
 
+CRUDE_API bool
+crude_gfx_model_renderer_resources_manager_has_gltf_model
+(
+  _In_ crude_gfx_model_renderer_resources_manager         *manager,
+  _In_ char const                                         *filepath
+);
+
+/* Thread safe, reads only the manager context. Returns false if gltf can't be parsed */
+CRUDE_API bool
+crude_gfx_model_renderer_resources_manager_prepare_gltf
+(
+  _In_ crude_gfx_model_renderer_resources_manager const   *manager,
+  _In_ char const                                         *filepath,
+  _In_ crude_heap_allocator                               *gltf_allocator,
+  _In_ crude_heap_allocator                               *allocator,
+  _Out_ crude_gfx_model_renderer_resources_prepared_gltf  *prepared_gltf
+);
+
+/* Prepared gltf is consumed, if the model is already loaded it's just discarded */
+CRUDE_API crude_gfx_model_renderer_resources_handle
+crude_gfx_model_renderer_resources_manager_add_prepared_gltf
+(
+  _In_ crude_gfx_model_renderer_resources_manager         *manager,
+  _In_ crude_gfx_model_renderer_resources_prepared_gltf   *prepared_gltf
+);
+
+CRUDE_API void
+crude_gfx_model_renderer_resources_manager_discard_prepared_gltf
+(
+  _In_ crude_gfx_model_renderer_resources_prepared_gltf   *prepared_gltf
+);
+
+/**
+ * Model must not be used by instances anymore, its handle could be reused.
+ * Meshlets ranges stay in the shared buffers till the manager is cleared.
+ */
+CRUDE_API void
+crude_gfx_model_renderer_resources_manager_release_gltf_model
+(
+  _In_ crude_gfx_model_renderer_resources_manager         *manager,
+  _In_ crude_gfx_model_renderer_resources_handle           handle
+);
+
 CRUDE_API void
 crude_gfx_model_renderer_resources_manager_wait_till_uploaded
 (
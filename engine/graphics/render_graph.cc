@@ -1,11 +1,10 @@
-#include <thirdparty/cJSON/cJSON.h>
-
 #include <engine/core/file.h>
 #include <engine/core/log.h>
 #include <engine/core/assert.h>
 #include <engine/core/hashmapstr.h>
 #include <engine/core/string.h>
 #include <engine/core/profiler.h>
+#include <engine/core/json.h>
 
 #include <engine/graphics/render_graph.h>
 
@@ -58,12 +57,13 @@ crude_gfx_render_graph_parse_from_file
   _In_ crude_stack_allocator                              *temporary_allocator
 )
 {
-  cJSON                                                   *render_graph_json;
-  cJSON const                                             *passes;
-  cJSON const                                             *pass;
+  crude_json_document                                      render_graph_json_document;
+  crude_json_cursor                                        render_graph_json;
+  crude_json_cursor                                        passes;
+  crude_json_cursor                                        pass;
   uint8                                                   *render_graph_json_buffer;
   crude_string_buffer                                      temporary_string_buffer;
-  uint32                                                   render_graph_json_buffer_size, temporary_allocator_maker;
+  uint32                                                   render_graph_json_buffer_size, render_graph_temporary_allocator_maker, temporary_allocator_maker;
   
   CRUDE_LOG_INFO( CRUDE_CHANNEL_GRAPHICS, "Parse render graph \"%s\"", render_graph_absolute_filepath );
 
@@ -73,100 +73,99 @@ crude_gfx_render_graph_parse_from_file
     return;
   }
   
-  temporary_allocator_maker = crude_stack_allocator_get_marker( temporary_allocator );
+  render_graph_temporary_allocator_maker = crude_stack_allocator_get_marker( temporary_allocator );
 
+  /* Parsed in place, so the buffer is kept until the passes are created */
   crude_read_file( render_graph_absolute_filepath, crude_stack_allocator_pack( temporary_allocator ), &render_graph_json_buffer, &render_graph_json_buffer_size );
-  render_graph_json = cJSON_ParseWithLength( CRUDE_REINTERPRET_CAST( char const*, render_graph_json_buffer ), render_graph_json_buffer_size );
-  crude_stack_allocator_free_marker( temporary_allocator, temporary_allocator_maker );
     
-  if ( !render_graph_json )
+  if ( !crude_json_document_parse( &render_graph_json_document, CRUDE_REINTERPRET_CAST( char*, render_graph_json_buffer ), render_graph_json_buffer_size, crude_stack_allocator_pack( temporary_allocator ) ) )
   {
-    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot parse a file \"%s\" for render graph... Error %s", render_graph_absolute_filepath, cJSON_GetErrorPtr() );
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot parse a file \"%s\" for render graph... Error at offset %u", render_graph_absolute_filepath, crude_json_document_get_error_offset( &render_graph_json_document ) );
+    crude_stack_allocator_free_marker( temporary_allocator, render_graph_temporary_allocator_maker );
     return;
   }
 
-  passes = cJSON_GetObjectItemCaseSensitive( render_graph_json, "passes" );
-  pass = NULL;
+  render_graph_json = crude_json_document_get_root( &render_graph_json_document );
+
+  passes = crude_json_cursor_get_object_item( render_graph_json, "passes" );
 
-  cJSON_ArrayForEach( pass, passes )
+  CRUDE_JSON_CURSOR_FOR_EACH( pass, passes )
   {
     crude_gfx_render_graph_node_creation                   node_creation;
-    cJSON const                                           *pass_inputs;
-    cJSON const                                           *pass_outputs;
-    cJSON const                                           *pass_input;
-    cJSON const                                           *pass_output;
-    cJSON const                                           *pass_name;
-    cJSON const                                           *pass_enabled;
-    cJSON const                                           *pass_multisample_enabled;
-    cJSON const                                           *pass_pipeline_type;
+    crude_json_cursor                                      pass_inputs;
+    crude_json_cursor                                      pass_outputs;
+    crude_json_cursor                                      pass_input;
+    crude_json_cursor                                      pass_output;
+    crude_json_cursor                                      pass_name;
+    crude_json_cursor                                      pass_enabled;
+    crude_json_cursor                                      pass_multisample_enabled;
+    crude_json_cursor                                      pass_pipeline_type;
     
   
     temporary_allocator_maker = crude_stack_allocator_get_marker( temporary_allocator );
     
     crude_string_buffer_initialize( &temporary_string_buffer, CRUDE_RKILO( 4 ), crude_stack_allocator_pack( temporary_allocator ) );
 
-    pass_inputs = cJSON_GetObjectItemCaseSensitive( pass, "inputs" );
-    pass_outputs = cJSON_GetObjectItemCaseSensitive( pass, "outputs" );
-    CRUDE_ASSERT( pass_outputs );
+    pass_inputs = crude_json_cursor_get_object_item( pass, "inputs" );
+    pass_outputs = crude_json_cursor_get_object_item( pass, "outputs" );
+    CRUDE_ASSERT( crude_json_cursor_valid( pass_outputs ) );
 
     node_creation = CRUDE_COMPOUNT_EMPTY( crude_gfx_render_graph_node_creation );
     
-    pass_multisample_enabled = cJSON_GetObjectItemCaseSensitive( pass, "multisample" );
-    node_creation.multisample = pass_multisample_enabled ? cJSON_GetNumberValue( pass_multisample_enabled ) : 1;
+    pass_multisample_enabled = crude_json_cursor_get_object_item( pass, "multisample" );
+    node_creation.multisample = crude_json_cursor_valid( pass_multisample_enabled ) ? crude_json_cursor_get_number_value( pass_multisample_enabled ) : 1;
 
-    CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_creation.inputs, cJSON_GetArraySize( pass_inputs ), crude_stack_allocator_pack( temporary_allocator ) );
-    CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_creation.outputs, cJSON_GetArraySize( pass_outputs ), crude_stack_allocator_pack( temporary_allocator ) );
+    CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_creation.inputs, crude_json_cursor_get_array_size( pass_inputs ), crude_stack_allocator_pack( temporary_allocator ) );
+    CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_creation.outputs, crude_json_cursor_get_array_size( pass_outputs ), crude_stack_allocator_pack( temporary_allocator ) );
   
-    pass_pipeline_type = cJSON_GetObjectItemCaseSensitive( pass, "type" );
+    pass_pipeline_type = crude_json_cursor_get_object_item( pass, "type" );
 
     node_creation.type = CRUDE_GFX_RENDER_GRAPH_NODE_TYPE_GRAPHICS;
-    if ( pass_pipeline_type )
+    if ( crude_json_cursor_valid( pass_pipeline_type ) )
     {
-      if ( crude_string_cmp( cJSON_GetStringValue( pass_pipeline_type ), "compute" ) == 0 )
+      if ( crude_string_cmp( crude_json_cursor_get_string_value( pass_pipeline_type ), "compute" ) == 0 )
       {
         node_creation.type = CRUDE_GFX_RENDER_GRAPH_NODE_TYPE_COMPUTE;
       }
-      else if ( crude_string_cmp( cJSON_GetStringValue( pass_pipeline_type ), "ray_tracing" ) == 0 )
+      else if ( crude_string_cmp( crude_json_cursor_get_string_value( pass_pipeline_type ), "ray_tracing" ) == 0 )
       {
         node_creation.type = CRUDE_GFX_RENDER_GRAPH_NODE_TYPE_RAY_TRACING;
       }
     }
 
-    if ( pass_inputs )
+    if ( crude_json_cursor_valid( pass_inputs ) )
     {
-      pass_input = NULL;
-      cJSON_ArrayForEach( pass_input, pass_inputs )
+      CRUDE_JSON_CURSOR_FOR_EACH( pass_input, pass_inputs )
       {
-        cJSON const                                         *input_type;
-        cJSON const                                         *input_name;
+        crude_json_cursor                                    input_type;
+        crude_json_cursor                                    input_name;
         crude_gfx_render_graph_resource_input_creation       creation;
 
-        input_type = cJSON_GetObjectItemCaseSensitive( pass_input, "type" );
-        input_name = cJSON_GetObjectItemCaseSensitive( pass_input, "name" );
-        CRUDE_ASSERT( input_type && input_name );
+        input_type = crude_json_cursor_get_object_item( pass_input, "type" );
+        input_name = crude_json_cursor_get_object_item( pass_input, "name" );
+        CRUDE_ASSERT( crude_json_cursor_valid( input_type ) && crude_json_cursor_valid( input_name ) );
 
         creation = CRUDE_COMPOUNT_EMPTY( crude_gfx_render_graph_resource_input_creation );
-        creation.type = crude_gfx_render_graph_resource_string_to_type( cJSON_GetStringValue( input_type ) );
+        creation.type = crude_gfx_render_graph_resource_string_to_type( crude_json_cursor_get_string_value( input_type ) );
         creation.resource_info.external = false;
-        creation.name = crude_string_buffer_append_use_f( &temporary_string_buffer, "%s", cJSON_GetStringValue( input_name ) );
+        creation.name = crude_string_buffer_append_use_f( &temporary_string_buffer, "%s", crude_json_cursor_get_string_value( input_name ) );
         CRUDE_ARRAY_PUSH( node_creation.inputs, creation );
       }
     }
     
-    pass_output = NULL;
-    cJSON_ArrayForEach( pass_output, pass_outputs )
+    CRUDE_JSON_CURSOR_FOR_EACH( pass_output, pass_outputs )
     {
-      cJSON const                                         *output_type;
-      cJSON const                                         *output_name;
+      crude_json_cursor                                    output_type;
+      crude_json_cursor                                    output_name;
       crude_gfx_render_graph_resource_output_creation      output_creation;
       
-      output_type = cJSON_GetObjectItemCaseSensitive( pass_output, "type" );
-      output_name = cJSON_GetObjectItemCaseSensitive( pass_output, "name" );
-      CRUDE_ASSERT( output_type && output_name );
+      output_type = crude_json_cursor_get_object_item( pass_output, "type" );
+      output_name = crude_json_cursor_get_object_item( pass_output, "name" );
+      CRUDE_ASSERT( crude_json_cursor_valid( output_type ) && crude_json_cursor_valid( output_name ) );
 
       output_creation = CRUDE_COMPOUNT_EMPTY( crude_gfx_render_graph_resource_output_creation );
-      output_creation.type = crude_gfx_render_graph_resource_string_to_type( cJSON_GetStringValue( output_type ) );
-      output_creation.name = crude_string_buffer_append_use_f( &temporary_string_buffer, "%s", cJSON_GetStringValue( output_name ) );
+      output_creation.type = crude_gfx_render_graph_resource_string_to_type( crude_json_cursor_get_string_value( output_type ) );
+      output_creation.name = crude_string_buffer_append_use_f( &temporary_string_buffer, "%s", crude_json_cursor_get_string_value( output_name ) );
       output_creation.resource_info.texture.handle.index = CRUDE_RESOURCE_INDEX_INVALID;
 
       switch ( output_creation.type )
@@ -177,26 +176,24 @@ crude_gfx_render_graph_parse_from_file
         }
         case CRUDE_GFX_RENDER_GRAPH_RESOURCE_TYPE_ATTACHMENT:
         {
-          cJSON const                                     *output_format;
-          cJSON const                                     *output_load_op;
-          cJSON const                                     *output_scale;
+          crude_json_cursor                                output_format;
+          crude_json_cursor                                output_load_op;
+          crude_json_cursor                                output_scale;
           
-          output_format = cJSON_GetObjectItemCaseSensitive( pass_output, "format" );
+          output_format = crude_json_cursor_get_object_item( pass_output, "format" );
 
-          output_scale = cJSON_GetObjectItemCaseSensitive( pass_output, "scale" );
-          CRUDE_ASSERT( output_format && output_scale );
-          CRUDE_ASSERT( cJSON_GetArraySize( output_scale ) == 2 );
+          output_scale = crude_json_cursor_get_object_item( pass_output, "scale" );
+          CRUDE_ASSERT( crude_json_cursor_valid( output_format ) && crude_json_cursor_valid( output_scale ) );
           
           if ( node_creation.type == CRUDE_GFX_RENDER_GRAPH_NODE_TYPE_GRAPHICS )
           {
-            output_load_op = cJSON_GetObjectItemCaseSensitive( pass_output, "op" );
-            CRUDE_ASSERT( output_load_op );
-            output_creation.resource_info.texture.load_op = crude_gfx_string_to_render_pass_operation( cJSON_GetStringValue( output_load_op ) );
+            output_load_op = crude_json_cursor_get_object_item( pass_output, "op" );
+            CRUDE_ASSERT( crude_json_cursor_valid( output_load_op ) );
+            output_creation.resource_info.texture.load_op = crude_gfx_string_to_render_pass_operation( crude_json_cursor_get_string_value( output_load_op ) );
           }
 
-          output_creation.resource_info.texture.format = crude_gfx_string_to_format( cJSON_GetStringValue( output_format ) );
-          output_creation.resource_info.texture.scale.x = cJSON_GetNumberValue( cJSON_GetArrayItem( output_scale, 0 ) );
-          output_creation.resource_info.texture.scale.y = cJSON_GetNumberValue( cJSON_GetArrayItem( output_scale, 1 ) );
+          output_creation.resource_info.texture.format = crude_gfx_string_to_format( crude_json_cursor_get_string_value( output_format ) );
+          crude_parse_json_cursor_to_float2( &output_creation.resource_info.texture.scale, output_scale );
           output_creation.resource_info.texture.depth = 1;
 
           output_creation.resource_info.texture.multisample = node_creation.multisample;
@@ -205,23 +202,23 @@ crude_gfx_render_graph_parse_from_file
           {
             if ( crude_gfx_rhi_format_has_depth( output_creation.resource_info.texture.format ) )
             {
-              cJSON const                                   *output_clear_depth;
-              cJSON const                                   *output_clear_stencil;
+              crude_json_cursor                              output_clear_depth;
+              crude_json_cursor                              output_clear_stencil;
 
-              output_clear_depth = cJSON_GetObjectItemCaseSensitive( pass_output, "clear_depth" );
-              output_clear_stencil = cJSON_GetObjectItemCaseSensitive( pass_output, "clear_stencil" );
-              output_creation.resource_info.texture.clear_values[ 0 ] = output_clear_depth ? cJSON_GetNumberValue( output_clear_depth ) : 1.f;
-              output_creation.resource_info.texture.clear_values[ 1 ] = output_clear_stencil ? cJSON_GetNumberValue( output_clear_stencil ) : 0.f;
+              output_clear_depth = crude_json_cursor_get_object_item( pass_output, "clear_depth" );
+              output_clear_stencil = crude_json_cursor_get_object_item( pass_output, "clear_stencil" );
+              output_creation.resource_info.texture.clear_values[ 0 ] = crude_json_cursor_valid( output_clear_depth ) ? crude_json_cursor_get_number_value( output_clear_depth ) : 1.f;
+              output_creation.resource_info.texture.clear_values[ 1 ] = crude_json_cursor_valid( output_clear_stencil ) ? crude_json_cursor_get_number_value( output_clear_stencil ) : 0.f;
             }
             else
             {
-              cJSON const                                   *output_clear_color;
-              output_clear_color = cJSON_GetObjectItemCaseSensitive( pass_output, "clear_color" );
-              if ( output_clear_color )
+              crude_json_cursor                              output_clear_color;
+              output_clear_color = crude_json_cursor_get_object_item( pass_output, "clear_color" );
+              if ( crude_json_cursor_valid( output_clear_color ) )
               {
-                for ( uint32 c = 0; c < cJSON_GetArraySize( output_clear_color ); ++c )
+                for ( uint32 c = 0; c < crude_json_cursor_get_array_size( output_clear_color ); ++c )
                 {
-                  output_creation.resource_info.texture.clear_values[ c ] = cJSON_GetNumberValue( cJSON_GetArrayItem( output_clear_color, c ) );
+                  output_creation.resource_info.texture.clear_values[ c ] = crude_json_cursor_get_number_value( crude_json_cursor_get_array_item( output_clear_color, c ) );
                 }
               }
               else
@@ -248,13 +245,13 @@ crude_gfx_render_graph_parse_from_file
         
       CRUDE_ARRAY_PUSH( node_creation.outputs, output_creation );
     }
-    pass_name = cJSON_GetObjectItemCaseSensitive( pass, "name" );
-    CRUDE_ASSERT( pass_name );
+    pass_name = crude_json_cursor_get_object_item( pass, "name" );
+    CRUDE_ASSERT( crude_json_cursor_valid( pass_name ) );
 
-    pass_enabled = cJSON_GetObjectItemCaseSensitive( pass, "enabled" );
+    pass_enabled = crude_json_cursor_get_object_item( pass, "enabled" );
 
-    node_creation.name = crude_string_buffer_append_use_f( &temporary_string_buffer, "%s", cJSON_GetStringValue( pass_name ) );
-    node_creation.enabled = pass_enabled ? cJSON_GetNumberValue( pass_enabled ) : 1;
+    node_creation.name = crude_string_buffer_append_use_f( &temporary_string_buffer, "%s", crude_json_cursor_get_string_value( pass_name ) );
+    node_creation.enabled = crude_json_cursor_valid( pass_enabled ) ? crude_json_cursor_get_number_value( pass_enabled ) : 1;
 
     crude_gfx_render_graph_node_handle node_handle = crude_gfx_render_graph_builder_create_node( render_graph->builder, &node_creation );
     CRUDE_ARRAY_PUSH( render_graph->nodes, node_handle );
@@ -262,7 +259,8 @@ crude_gfx_render_graph_parse_from_file
     crude_stack_allocator_free_marker( temporary_allocator, temporary_allocator_maker );
   }
   
-  cJSON_Delete( render_graph_json );
+  crude_json_document_deinitialize( &render_graph_json_document );
+  crude_stack_allocator_free_marker( temporary_allocator, render_graph_temporary_allocator_maker );
 }
 
 void
@@ -395,7 +395,11 @@ crude_gfx_scene_renderer_update_instances_from_node
 
   scene_renderer->world_environment_cpu.background_radiance = CRUDE_COMPOUNT_EMPTY( XMFLOAT3 );
 
-  crude_scene_renderer_register_nodes_instances_( scene_renderer, world, main_node );
+  /* Main node isn't set till its load is finished */
+  if ( crude_entity_valid( world, main_node ) )
+  {
+    crude_scene_renderer_register_nodes_instances_( scene_renderer, world, main_node );
+  }
 
   bool probes_count_changed = scene_renderer->ddgi_area.probe_count.x != scene_renderer->prev_ddgi_area.probe_count.x
     || scene_renderer->ddgi_area.probe_count.y != scene_renderer->prev_ddgi_area.probe_count.y 
@@ -41,9 +41,18 @@ crude_gui_devmenu_option devmenu_options[ ] =
   {
     "Reload Techniques", crude_gui_devmenu_reload_techniques_callback, crude_gui_devmenu_reload_techniques_hotkey_pressed_callback
   },
+  {
+    "Reload Node", crude_gui_devmenu_reload_node_callback, crude_gui_devmenu_reload_node_hotkey_pressed_callback
+  },
   {
     "Memory Visual Profiler", crude_gui_devmenu_memory_visual_profiler_callback
   },
+  {
+    "Physics Profiler", crude_gui_devmenu_physics_profiler_callback
+  },
+  {
+    "Audio Profiler", crude_gui_devmenu_audio_profiler_callback
+  },
   {
     "Render Graph", crude_gui_devmenu_render_graph_callback
   },
@@ -73,6 +82,8 @@ crude_gui_devmenu_initialize
   devmenu->dev_heap_allocator = &engine->develop_heap_allocator;
   devmenu->dev_stack_allocator = &engine->develop_temporary_allocator;
   crude_gui_devmenu_memory_visual_profiler_initialize( &devmenu->memory_visual_profiler, devmenu );
+  crude_gui_devmenu_physics_profiler_initialize( &devmenu->physics_profiler, devmenu );
+  crude_gui_devmenu_audio_profiler_initialize( &devmenu->audio_profiler, devmenu );
   crude_gui_devmenu_render_graph_initialize( &devmenu->render_graph, devmenu );
   crude_gui_devmenu_scene_renderer_initialize( &devmenu->scene_renderer, devmenu );
 }
@@ -84,6 +95,8 @@ crude_gui_devmenu_deinitialize
 )
 {
   crude_gui_devmenu_memory_visual_profiler_deinitialize( &devmenu->memory_visual_profiler );
+  crude_gui_devmenu_physics_profiler_deinitialize( &devmenu->physics_profiler );
+  crude_gui_devmenu_audio_profiler_deinitialize( &devmenu->audio_profiler );
   crude_gui_devmenu_render_graph_deinitialize( &devmenu->render_graph );
   crude_gui_devmenu_scene_renderer_deinitialize( &devmenu->scene_renderer );
 }
@@ -122,6 +135,8 @@ crude_gui_devmenu_draw
   //  ImGui::End( );
   //}
   crude_gui_devmenu_memory_visual_profiler_draw( &devmenu->memory_visual_profiler );
+  crude_gui_devmenu_physics_profiler_draw( &devmenu->physics_profiler );
+  crude_gui_devmenu_audio_profiler_draw( &devmenu->audio_profiler );
   crude_gui_devmenu_render_graph_draw( &devmenu->render_graph );
   crude_gui_devmenu_scene_renderer_draw( &devmenu->scene_renderer );
   CRUDE_PROFILER_ZONE_END;
@@ -134,6 +149,8 @@ crude_gui_devmenu_update
 )
 {
   crude_gui_devmenu_memory_visual_profiler_update( &devmenu->memory_visual_profiler );
+  crude_gui_devmenu_physics_profiler_update( &devmenu->physics_profiler );
+  crude_gui_devmenu_audio_profiler_update( &devmenu->audio_profiler );
   crude_gui_devmenu_render_graph_update( &devmenu->render_graph );
   crude_gui_devmenu_scene_renderer_update( &devmenu->scene_renderer );
 
@@ -259,6 +276,24 @@ crude_gui_devmenu_reload_techniques_hotkey_pressed_callback
   return input->keys[ SDL_SCANCODE_LCTRL ].pressed && input->keys[ SDL_SCANCODE_G ].pressed && input->keys[ SDL_SCANCODE_R ].pressed;
 }
 
+void
+crude_gui_devmenu_reload_node_callback
+(
+  _In_ crude_gui_devmenu                                  *devmenu
+)
+{
+  crude_engine_commands_manager_push_reload_node_command( &devmenu->engine->commands_manager );
+}
+
+bool
+crude_gui_devmenu_reload_node_hotkey_pressed_callback
+(
+  _In_ crude_input                                        *input
+)
+{
+  return input->keys[ SDL_SCANCODE_LCTRL ].pressed && input->keys[ SDL_SCANCODE_N ].pressed && input->keys[ SDL_SCANCODE_R ].pressed;
+}
+
 /***********************
  * 
  * Develop Memory Visual Profiler
@@ -413,6 +448,336 @@ crude_gui_devmenu_memory_visual_profiler_callback
 }
 
 
+/***********************
+ * 
+ * Develop Physics Profiler
+ * 
+ ***********************/
+static void
+crude_gui_devmenu_physics_profiler_stop_recording_
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler
+);
+
+static float
+crude_gui_devmenu_physics_profiler_update_time_getter_
+(
+  _In_ void                                               *data,
+  _In_ int                                                 index
+);
+
+void
+crude_gui_devmenu_physics_profiler_initialize
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler,
+  _In_ crude_gui_devmenu                                  *devmenu
+)
+{
+  dev_physics_profiler->devmenu = devmenu;
+  dev_physics_profiler->enabled = false;
+  dev_physics_profiler->paused = false;
+  dev_physics_profiler->current_frame = 0u;
+  dev_physics_profiler->csv_file = NULL;
+  dev_physics_profiler->csv_frames_count = 0u;
+  crude_memory_set( dev_physics_profiler->frames_telemetry, 0u, sizeof( dev_physics_profiler->frames_telemetry ) );
+}
+
+void
+crude_gui_devmenu_physics_profiler_deinitialize
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler
+)
+{
+  crude_gui_devmenu_physics_profiler_stop_recording_( dev_physics_profiler );
+}
+
+void
+crude_gui_devmenu_physics_profiler_update
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler
+)
+{
+  crude_physics                                           *physics;
+  crude_physics_telemetry const                           *telemetry;
+
+  physics = &dev_physics_profiler->devmenu->engine->physics;
+  telemetry = &physics->telemetry;
+
+  if ( !dev_physics_profiler->paused )
+  {
+    dev_physics_profiler->current_frame = ( dev_physics_profiler->current_frame + 1 ) % CRUDE_GUI_DEVMENU_PHYSICS_PROFILER_FRAMES_MAX;
+    dev_physics_profiler->frames_telemetry[ dev_physics_profiler->current_frame ] = *telemetry;
+  }
+
+  if ( dev_physics_profiler->csv_file )
+  {
+    fprintf( CRUDE_REINTERPRET_CAST( FILE*, dev_physics_profiler->csv_file ), "%llu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%u,%u,%u,%u,%u,%u,%u,%u,%u\n",
+      dev_physics_profiler->csv_frames_count, telemetry->update_time, telemetry->max_step_time,
+      telemetry->broad_phase_time, telemetry->narrow_phase_time, telemetry->solver_time, telemetry->callbacks_time, telemetry->other_jobs_time, telemetry->contact_events_dispatch_time,
+      telemetry->steps_count, telemetry->collision_steps, telemetry->bodies_count, physics->max_bodies, telemetry->active_bodies_count,
+      telemetry->contacts_count, physics->max_contact_constraints, telemetry->contact_events_count, telemetry->update_errors );
+    ++dev_physics_profiler->csv_frames_count;
+  }
+}
+
+void
+crude_gui_devmenu_physics_profiler_draw
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler
+)
+{
+  crude_physics                                           *physics;
+  crude_physics_telemetry const                           *telemetry;
+  char                                                     buf[ 128 ];
+  float32                                                  average_update_time, max_update_time;
+
+  if ( !dev_physics_profiler->enabled )
+  {
+    return;
+  }
+
+  physics = &dev_physics_profiler->devmenu->engine->physics;
+  telemetry = &dev_physics_profiler->frames_telemetry[ dev_physics_profiler->current_frame ];
+
+  average_update_time = max_update_time = 0.f;
+  for ( uint32 i = 0; i < CRUDE_GUI_DEVMENU_PHYSICS_PROFILER_FRAMES_MAX; ++i )
+  {
+    average_update_time += dev_physics_profiler->frames_telemetry[ i ].update_time;
+    max_update_time = CRUDE_MAX( max_update_time, dev_physics_profiler->frames_telemetry[ i ].update_time );
+  }
+  average_update_time /= CRUDE_GUI_DEVMENU_PHYSICS_PROFILER_FRAMES_MAX;
+
+  ImGui::Begin( "Physics Profiler" );
+  
+  crude_snprintf( buf, sizeof( buf ), "Update avg %.3f ms | max %.3f ms", average_update_time, max_update_time );
+  ImGui::PlotLines( "##Update", crude_gui_devmenu_physics_profiler_update_time_getter_, dev_physics_profiler, CRUDE_GUI_DEVMENU_PHYSICS_PROFILER_FRAMES_MAX, 0, buf, 0.f, CRUDE_MAX( max_update_time, 0.1f ), ImVec2( ImGui::GetContentRegionAvail( ).x, 80 ) );
+
+  ImGui::Checkbox( "Pause", &dev_physics_profiler->paused );
+  ImGui::SameLine( );
+  if ( dev_physics_profiler->csv_file )
+  {
+    if ( ImGui::Button( "Stop CSV Recording" ) )
+    {
+      crude_gui_devmenu_physics_profiler_stop_recording_( dev_physics_profiler );
+    }
+    ImGui::SameLine( );
+    ImGui::Text( "%llu frames", dev_physics_profiler->csv_frames_count );
+  }
+  else if ( ImGui::Button( "Record CSV" ) )
+  {
+    nfdu8filteritem_t                                       ndf_filters[ ] = { { "CSV", "csv" } };
+
+    nfdu8char_t                                            *ndf_absolute_filepath;
+    nfdsavedialogu8args_t                                   ndf_args;
+    nfdresult_t                                             ndf_result;
+
+    ndf_args = CRUDE_COMPOUNT_EMPTY( nfdsavedialogu8args_t );
+    ndf_args.filterList = ndf_filters;
+    ndf_args.filterCount = CRUDE_COUNTOF( ndf_filters );
+    ndf_args.defaultName = "physics_telemetry.csv";
+
+    ndf_result = NFD_SaveDialogU8_With( &ndf_absolute_filepath, &ndf_args );
+    if ( ndf_result == NFD_OKAY )
+    {
+      dev_physics_profiler->csv_file = fopen( ndf_absolute_filepath, "w" );
+      if ( dev_physics_profiler->csv_file )
+      {
+        fprintf( CRUDE_REINTERPRET_CAST( FILE*, dev_physics_profiler->csv_file ), "frame,update_ms,max_step_ms,broad_phase_ms,narrow_phase_ms,solver_ms,callbacks_ms,other_jobs_ms,contact_events_dispatch_ms,steps,collision_steps,bodies,max_bodies,active_bodies,contacts,max_contact_constraints,contact_events,update_errors\n" );
+        dev_physics_profiler->csv_frames_count = 0u;
+      }
+      else
+      {
+        CRUDE_LOG_ERROR( CRUDE_CHANNEL_FILEIO, "Cannot open physics telemetry file \"%s\"", ndf_absolute_filepath );
+      }
+      NFD_FreePathU8( ndf_absolute_filepath );
+    }
+    else if ( ndf_result == NFD_ERROR )
+    {
+      CRUDE_LOG_ERROR( CRUDE_CHANNEL_FILEIO, "Error: %s", NFD_GetError( ) );
+    }
+  }
+
+  if ( ImGui::CollapsingHeader( "Step", ImGuiTreeNodeFlags_DefaultOpen ) )
+  {
+    ImGui::Text( "Update: %.3f ms", telemetry->update_time );
+    ImGui::Text( "Max Step: %.3f ms", telemetry->max_step_time );
+    ImGui::Text( "Broad Phase: %.3f ms", telemetry->broad_phase_time );
+    ImGui::Text( "Narrow Phase: %.3f ms", telemetry->narrow_phase_time );
+    ImGui::Text( "Solver: %.3f ms", telemetry->solver_time );
+    ImGui::Text( "Callbacks: %.3f ms", telemetry->callbacks_time );
+    ImGui::Text( "Other Jobs: %.3f ms", telemetry->other_jobs_time );
+    ImGui::TextDisabled( "Phase times are summed over worker threads and steps. Broad phase is the tree update only, pair queries run inside narrow phase jobs." );
+    ImGui::Text( "Contact Events Dispatch: %.3f ms", telemetry->contact_events_dispatch_time );
+    ImGui::Text( "Steps: %u (%u collision steps each)", telemetry->steps_count, telemetry->collision_steps );
+    ImGui::Text( "Contact Events: %u", telemetry->contact_events_count );
+  }
+  
+  if ( ImGui::CollapsingHeader( "Capacity", ImGuiTreeNodeFlags_DefaultOpen ) )
+  {
+    crude_snprintf( buf, sizeof( buf ), "Bodies %u / %u", telemetry->bodies_count, physics->max_bodies );
+    ImGui::ProgressBar( telemetry->bodies_count / CRUDE_CAST( float32, physics->max_bodies ), ImVec2( -1, 0 ), buf );
+    crude_snprintf( buf, sizeof( buf ), "Active Bodies %u / %u", telemetry->active_bodies_count, telemetry->bodies_count );
+    ImGui::ProgressBar( telemetry->bodies_count ? telemetry->active_bodies_count / CRUDE_CAST( float32, telemetry->bodies_count ) : 0.f, ImVec2( -1, 0 ), buf );
+    crude_snprintf( buf, sizeof( buf ), "Contacts %u / %u", telemetry->contacts_count, physics->max_contact_constraints );
+    ImGui::ProgressBar( telemetry->contacts_count / CRUDE_CAST( float32, physics->max_contact_constraints ), ImVec2( -1, 0 ), buf );
+    /* Jolt doesn't expose body pairs usage, only the overflow */
+    ImGui::Text( "Body Pairs Cache: %s (max %u)", ( telemetry->update_errors & CRUDE_CAST( uint32, JPH::EPhysicsUpdateError::BodyPairCacheFull ) ) ? "Full" : "Ok", physics->max_body_pairs );
+    ImGui::Text( "Contact Constraints: %s", ( telemetry->update_errors & CRUDE_CAST( uint32, JPH::EPhysicsUpdateError::ManifoldCacheFull | JPH::EPhysicsUpdateError::ContactConstraintsFull ) ) ? "Full" : "Ok" );
+  }
+
+  ImGui::End( );
+}
+
+void
+crude_gui_devmenu_physics_profiler_callback
+(
+  _In_ crude_gui_devmenu                                  *devmenu
+)
+{
+  devmenu->physics_profiler.enabled = !devmenu->physics_profiler.enabled;
+}
+
+void
+crude_gui_devmenu_physics_profiler_stop_recording_
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler
+)
+{
+  if ( dev_physics_profiler->csv_file )
+  {
+    fclose( CRUDE_REINTERPRET_CAST( FILE*, dev_physics_profiler->csv_file ) );
+    dev_physics_profiler->csv_file = NULL;
+  }
+}
+
+float
+crude_gui_devmenu_physics_profiler_update_time_getter_
+(
+  _In_ void                                               *data,
+  _In_ int                                                 index
+)
+{
+  crude_gui_devmenu_physics_profiler                      *dev_physics_profiler;
+
+  dev_physics_profiler = CRUDE_CAST( crude_gui_devmenu_physics_profiler*, data );
+  return dev_physics_profiler->frames_telemetry[ ( dev_physics_profiler->current_frame + 1 + index ) % CRUDE_GUI_DEVMENU_PHYSICS_PROFILER_FRAMES_MAX ].update_time;
+}
+
+/***********************
+ * 
+ * Develop Audio Profiler
+ * 
+ ***********************/
+void
+crude_gui_devmenu_audio_profiler_initialize
+(
+  _In_ crude_gui_devmenu_audio_profiler                   *dev_audio_profiler,
+  _In_ crude_gui_devmenu                                  *devmenu
+)
+{
+  dev_audio_profiler->devmenu = devmenu;
+  dev_audio_profiler->enabled = false;
+}
+
+void
+crude_gui_devmenu_audio_profiler_deinitialize
+(
+  _In_ crude_gui_devmenu_audio_profiler                   *dev_audio_profiler
+)
+{
+}
+
+void
+crude_gui_devmenu_audio_profiler_update
+(
+  _In_ crude_gui_devmenu_audio_profiler                   *dev_audio_profiler
+)
+{
+}
+
+void
+crude_gui_devmenu_audio_profiler_draw
+(
+  _In_ crude_gui_devmenu_audio_profiler                   *dev_audio_profiler
+)
+{
+  crude_audio_device                                      *audio;
+  crude_audio_sound_cache_stats                            sound_cache_stats;
+  crude_audio_voices_stats                                 voices_stats;
+  char                                                     buf[ 128 ];
+
+  if ( !dev_audio_profiler->enabled )
+  {
+    return;
+  }
+
+  audio = &dev_audio_profiler->devmenu->engine->audio_device;
+  sound_cache_stats = crude_audio_device_get_sound_cache_stats( audio );
+  voices_stats = crude_audio_device_get_voices_stats( audio );
+
+  ImGui::Begin( "Audio Profiler" );
+
+  if ( ImGui::CollapsingHeader( "Voices", ImGuiTreeNodeFlags_DefaultOpen ) )
+  {
+    crude_snprintf( buf, sizeof( buf ), "Real Voices %u / %u", voices_stats.real_voices_count, voices_stats.real_voices_max );
+    ImGui::ProgressBar( voices_stats.real_voices_max ? voices_stats.real_voices_count / CRUDE_CAST( float32, voices_stats.real_voices_max ) : 0.f, ImVec2( -1, 0 ), buf );
+    ImGui::Text( "Voices: %u (%u virtual)", voices_stats.voices_count, voices_stats.voices_count - voices_stats.real_voices_count );
+    ImGui::Text( "Last Update: %u virtualized | %u devirtualized | %u finished", voices_stats.virtualized_count, voices_stats.devirtualized_count, voices_stats.finished_count );
+  }
+
+  if ( ImGui::CollapsingHeader( "Sound Cache", ImGuiTreeNodeFlags_DefaultOpen ) )
+  {
+    crude_snprintf( buf, sizeof( buf ), "Memory %.2f / %.2f MB", sound_cache_stats.memory_used / ( 1024.f * 1024.f ), sound_cache_stats.memory_budget / ( 1024.f * 1024.f ) );
+    ImGui::ProgressBar( sound_cache_stats.memory_budget ? CRUDE_CAST( float32, sound_cache_stats.memory_used ) / sound_cache_stats.memory_budget : 0.f, ImVec2( -1, 0 ), buf );
+    ImGui::Text( "Entries: %u (%u referenced)", sound_cache_stats.entries_count, sound_cache_stats.referenced_entries_count );
+    ImGui::Text( "Hits: %u | Misses: %u | Evictions: %u", sound_cache_stats.hits, sound_cache_stats.misses, sound_cache_stats.evictions );
+    if ( ImGui::Button( "Trim" ) )
+    {
+      crude_audio_device_trim_sound_cache( audio );
+    }
+
+    if ( ImGui::BeginTable( "Sounds Data", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable ) )
+    {
+      ImGui::TableSetupColumn( "File" );
+      ImGui::TableSetupColumn( "Size (KB)" );
+      ImGui::TableSetupColumn( "References" );
+      ImGui::TableSetupColumn( "Last Use" );
+      ImGui::TableHeadersRow( );
+      for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( audio->relative_filepath_to_sound_data ); ++i )
+      {
+        crude_sound_data_container                        *sound_data_container;
+
+        if ( !crude_hashmapstr_backet_key_hash_valid( audio->relative_filepath_to_sound_data[ i ].key.key_hash ) )
+        {
+          continue;
+        }
+
+        sound_data_container = crude_audio_device_access_sound_data( audio, audio->relative_filepath_to_sound_data[ i ].value );
+        ImGui::TableNextRow( );
+        ImGui::TableNextColumn( );
+        ImGui::TextUnformatted( sound_data_container->relative_filepath );
+        ImGui::TableNextColumn( );
+        ImGui::Text( "%.1f", sound_data_container->size / 1024.f );
+        ImGui::TableNextColumn( );
+        ImGui::Text( "%u", sound_data_container->references_count );
+        ImGui::TableNextColumn( );
+        ImGui::Text( "%llu", sound_data_container->last_use_index );
+      }
+      ImGui::EndTable( );
+    }
+  }
+
+  ImGui::End( );
+}
+
+void
+crude_gui_devmenu_audio_profiler_callback
+(
+  _In_ crude_gui_devmenu                                  *devmenu
+)
+{
+  devmenu->audio_profiler.enabled = !devmenu->audio_profiler.enabled;
+}
 
 /***********************
  * 
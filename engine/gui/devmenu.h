@@ -5,6 +5,7 @@
 #include <engine/graphics/scene_renderer.h>
 #include <engine/graphics/gpu_profiler.h>
 #include <engine/graphics/imgui.h>
+#include <engine/physics/physics.h>
 
 typedef struct crude_engine crude_engine;
 typedef struct crude_gui_devmenu crude_gui_devmenu;
@@ -16,6 +17,27 @@ typedef struct crude_gui_devmenu_memory_visual_profiler
   crude_allocator_container                               *allocators_containers;
 } crude_gui_devmenu_memory_visual_profiler;
 
+/* Physics telemetry is kept for this many last frames */
+#define CRUDE_GUI_DEVMENU_PHYSICS_PROFILER_FRAMES_MAX              256
+
+typedef struct crude_gui_devmenu_physics_profiler
+{
+  crude_gui_devmenu                                       *devmenu;
+  crude_physics_telemetry                                  frames_telemetry[ CRUDE_GUI_DEVMENU_PHYSICS_PROFILER_FRAMES_MAX ];
+  uint32                                                   current_frame;
+  /* Written every frame while recording */
+  void                                                    *csv_file;
+  uint64                                                   csv_frames_count;
+  bool                                                     paused;
+  bool                                                     enabled;
+} crude_gui_devmenu_physics_profiler;
+
+typedef struct crude_gui_devmenu_audio_profiler
+{
+  crude_gui_devmenu                                       *devmenu;
+  bool                                                     enabled;
+} crude_gui_devmenu_audio_profiler;
+
 typedef struct crude_gui_devmenu_render_graph
 {
   crude_gui_devmenu                                       *devmenu;
@@ -38,6 +60,8 @@ typedef struct crude_gui_devmenu
   crude_engine                                            *engine;
   bool                                                     enabled;
   crude_gui_devmenu_memory_visual_profiler                 memory_visual_profiler;
+  crude_gui_devmenu_physics_profiler                       physics_profiler;
+  crude_gui_devmenu_audio_profiler                         audio_profiler;
   crude_gui_devmenu_render_graph                           render_graph;
   crude_gui_devmenu_scene_renderer                         scene_renderer;
   uint32                                                   selected_option;
@@ -138,6 +162,18 @@ crude_gui_devmenu_reload_techniques_hotkey_pressed_callback
   _In_ crude_input                                        *input
 );
 
+CRUDE_API void
+crude_gui_devmenu_reload_node_callback
+(
+  _In_ crude_gui_devmenu                                  *devmenu
+);
+
+CRUDE_API bool
+crude_gui_devmenu_reload_node_hotkey_pressed_callback
+(
+  _In_ crude_input                                        *input
+);
+
 /***********************
  * 
  * Develop Memory Visual Profiler
@@ -174,6 +210,78 @@ crude_gui_devmenu_memory_visual_profiler_callback
   _In_ crude_gui_devmenu                                  *devmenu
 );
 
+/***********************
+ * 
+ * Develop Physics Profiler
+ * 
+ ***********************/
+CRUDE_API void
+crude_gui_devmenu_physics_profiler_initialize
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler,
+  _In_ crude_gui_devmenu                                  *devmenu
+);
+
+CRUDE_API void
+crude_gui_devmenu_physics_profiler_deinitialize
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler
+);
+
+CRUDE_API void
+crude_gui_devmenu_physics_profiler_update
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler
+);
+
+CRUDE_API void
+crude_gui_devmenu_physics_profiler_draw
+(
+  _In_ crude_gui_devmenu_physics_profiler                 *dev_physics_profiler
+);
+
+CRUDE_API void
+crude_gui_devmenu_physics_profiler_callback
+(
+  _In_ crude_gui_devmenu                                  *devmenu
+);
+
+/***********************
+ * 
+ * Develop Audio Profiler
+ * 
+ ***********************/
+CRUDE_API void
+crude_gui_devmenu_audio_profiler_initialize
+(
+  _In_ crude_gui_devmenu_audio_profiler                   *dev_audio_profiler,
+  _In_ crude_gui_devmenu                                  *devmenu
+);
+
+CRUDE_API void
+crude_gui_devmenu_audio_profiler_deinitialize
+(
+  _In_ crude_gui_devmenu_audio_profiler                   *dev_audio_profiler
+);
+
+CRUDE_API void
+crude_gui_devmenu_audio_profiler_update
+(
+  _In_ crude_gui_devmenu_audio_profiler                   *dev_audio_profiler
+);
+
+CRUDE_API void
+crude_gui_devmenu_audio_profiler_draw
+(
+  _In_ crude_gui_devmenu_audio_profiler                   *dev_audio_profiler
+);
+
+CRUDE_API void
+crude_gui_devmenu_audio_profiler_callback
+(
+  _In_ crude_gui_devmenu                                  *devmenu
+);
+
 /***********************
  * 
  * Develop Render Graph
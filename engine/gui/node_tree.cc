@@ -19,7 +19,8 @@ static char const* crude_gui_node_tree_node_types_names_[ CRUDE_GUI_NODE_TYPE_CO
   "Audio Listener",
   "DDGI Area",
   "World Environment",
-  "Terrain"
+  "Terrain",
+  "World Partition Cell"
 };
 
 static bool
@@ -244,6 +245,11 @@ crude_gui_node_tree_queue_draw
             CRUDE_ENTITY_SET_COMPONENT( world, new_node, crude_transform, { crude_transform_empty( ) } );
             break;
           }
+          case CRUDE_GUI_NODE_TYPE_WORLD_PARTITION_CELL:
+          {
+            CRUDE_ENTITY_SET_COMPONENT( world, new_node, crude_world_partition_cell, { crude_world_partition_cell_empty( ) } );
+            break;
+          }
           }
           node_tree->node_reference = CRUDE_COMPOUNT_EMPTY( crude_entity );
           *selected_node = new_node;
@@ -20,6 +20,7 @@ typedef enum crude_gui_node_type
   CRUDE_GUI_NODE_TYPE_DDGI_AREA,
   CRUDE_GUI_NODE_TYPE_WORLD_ENVIRONMENT,
   CRUDE_GUI_NODE_TYPE_TERRAIN,
+  CRUDE_GUI_NODE_TYPE_WORLD_PARTITION_CELL,
   CRUDE_GUI_NODE_TYPE_COUNT,
 } crude_gui_node_type;
 
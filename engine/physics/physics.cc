@@ -1,5 +1,6 @@
 #include <thirdparty/flecs/flecs.h>
 #include <stdarg.h>
+#include <thread>
 
 #include <engine/core/time.h>
 #include <engine/core/memory.h>
@@ -7,6 +8,7 @@
 #include <engine/core/array.h>
 #include <engine/core/hashmapstr.h>
 #include <engine/core/assert.h>
+#include <engine/core/profiler.h>
 #include <engine/scene/scene_ecs.h>
 #include <engine/physics/physics_ecs.h>
 
@@ -87,6 +89,193 @@ crude_physics_jolt_assert_failed_impl_
 
 #endif /* JPH_ENABLE_ASSERTS */
 
+/* Pending batch additions and removals count as done */
+static bool
+crude_physics_body_added_
+(
+  _In_ int32                                               batch_index
+);
+
+static void
+crude_physics_add_body_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::BodyID                                         jph_body,
+  _In_ uint32                                              handle_index,
+  _Out_ int32                                             *batch_index,
+  _Inout_ uint32                                         **batch_added_bodies,
+  _In_ JPH::EActivation                                    jph_activation
+);
+
+static void
+crude_physics_remove_body_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::BodyID                                         jph_body,
+  _Inout_ int32                                           *batch_index,
+  _In_ uint32                                             *batch_added_bodies
+);
+
+static void
+crude_physics_destroy_body_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::BodyID                                         jph_body,
+  _Inout_ int32                                           *batch_index,
+  _In_ uint32                                             *batch_added_bodies
+);
+
+static void
+crude_physics_commit_batch_bodies_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::EActivation                                    jph_activation
+);
+
+static uint32
+crude_physics_obtain_resource_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_resource_pool                                *resource_pool,
+  _In_ char const                                         *resource_pool_name
+);
+
+static void
+crude_physics_check_bodies_capacity_
+(
+  _In_ crude_physics                                      *physics
+);
+
+static void
+crude_physics_check_contacts_capacity_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ uint32                                              contacts_count
+);
+
+static crude_physics_step_phase
+crude_physics_step_phase_from_job_name_
+(
+  _In_ char const                                         *name
+);
+
+static void
+crude_physics_set_body_active_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::BodyID const                                  &jph_body_id,
+  _In_ uint64                                              jph_body_user_data,
+  _In_ bool                                                active
+);
+
+static crude_entity
+crude_physics_body_entity_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ uint64                                              jph_body_user_data
+);
+
+static void
+crude_physics_sync_list_add_
+(
+  _Inout_ uint32                                         **sync_list,
+  _In_ uint32                                              index
+);
+
+static void
+crude_physics_sync_list_remove_
+(
+  _In_ uint32                                             *sync_list,
+  _In_ uint32                                              index
+);
+
+/* Sync lists keep bodies Jolt left awake after the update */
+static void
+crude_physics_update_sync_lists_
+(
+  _In_ crude_physics                                      *physics
+);
+
+static bool
+crude_physics_ray_cast_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ XMVECTOR                                            origin,
+  _In_ XMVECTOR                                            direction,
+  _In_ _crude_jph_ray_cast_broad_phase_layer_filter_class const *jph_broad_phase_layer_filter_class,
+  _In_ _crude_jph_ray_cast_object_layer_filter_class const *jph_object_layer_filter_class,
+  _Out_ crude_ray_cast_result                             *ray_cast_result
+);
+
+/* direction is NULL for overlap */
+static void
+crude_physics_shape_query_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::Shape const                                   *jph_shape_class,
+  _In_ crude_physics_query_shape const                    *shape,
+  _In_opt_ XMVECTOR const                                 *direction,
+  _In_ uint8                                               broad_phase_mask,
+  _In_ uint32                                              layer_mask,
+  _Inout_ crude_physics_shape_query_result                *result
+);
+
+static void
+crude_physics_shape_query_dispatch_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_query_shape const                    *shape,
+  _In_opt_ XMVECTOR const                                 *direction,
+  _In_ uint8                                               broad_phase_mask,
+  _In_ uint32                                              layer_mask,
+  _Inout_ crude_physics_shape_query_result                *result
+);
+
+static void
+crude_physics_ray_cast_task_execute_
+(
+  _In_ uint32_t                                            start,
+  _In_ uint32_t                                            end,
+  _In_ uint32_t                                            thread_num,
+  _In_ void                                               *args
+);
+
+static void
+crude_physics_virtual_characters_task_initialize_
+(
+  _In_ crude_physics_virtual_characters_task              *task,
+  _In_ crude_physics                                      *physics
+);
+
+static void
+crude_physics_virtual_characters_task_deinitialize_
+(
+  _In_ crude_physics_virtual_characters_task              *task
+);
+
+static void
+crude_physics_virtual_characters_task_execute_
+(
+  _In_ uint32_t                                            start,
+  _In_ uint32_t                                            end,
+  _In_ uint32_t                                            thread_num,
+  _In_ void                                               *args
+);
+
+static void
+crude_physics_update_virtual_characters_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ float32                                             delta_time
+);
+
+static int
+crude_physics_virtual_character_entry_compare_
+(
+  _In_ void const                                         *a,
+  _In_ void const                                         *b
+);
+
 bool
 _crude_jph_object_layer_pair_filter_class::ShouldCollide
 (
@@ -208,14 +397,65 @@ _crude_jph_contact_listener_class::OnContactAdded
   _In_ JPH::ContactSettings                               &settings
 )
 {
-  JPH::Body const                                         *jph_static_body;
+  int64                                                    start_time;
+  uint32                                                   thread_num;
+
+  CRUDE_PROFILER_ZONE_NAME( "OnContactAdded" );
+  start_time = crude_time_now( );
+  push_event_( CRUDE_PHYSICS_CONTACT_EVENT_TYPE_ADDED, body1, body2, manifold );
+
+  thread_num = enkiGetThreadNum( this->physics->task_sheduler->enki_task_sheduler );
+  this->physics->contact_events_buffers[ thread_num ].contact_callbacks_time += crude_time_now( ) - start_time;
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+_crude_jph_contact_listener_class::OnContactPersisted
+(
+  _In_ const JPH::Body                                    &body1,
+  _In_ const JPH::Body                                    &body2,
+  _In_ const JPH::ContactManifold                         &manifold,
+  _In_ JPH::ContactSettings                               &settings
+)
+{
+  uint32                                                   thread_num;
+
+  /* Nothing handles persisted contacts, queuing them would only fill the buffer and drop added ones */
+  thread_num = enkiGetThreadNum( this->physics->task_sheduler->enki_task_sheduler );
+  CRUDE_ASSERT( thread_num < this->physics->contact_events_buffers_count );
+  ++this->physics->contact_events_buffers[ thread_num ].contacts_count;
+}
+
+void
+_crude_jph_contact_listener_class::OnContactRemoved
+(
+  _In_ const JPH::SubShapeIDPair                        &subshapepair
+)
+{
+  //cout << "A contact was removed" << endl;
+}
+
+void
+_crude_jph_contact_listener_class::push_event_
+(
+  _In_ crude_physics_contact_event_type                    type,
+  _In_ JPH::Body const                                    &body1,
+  _In_ JPH::Body const                                    &body2,
+  _In_ JPH::ContactManifold const                         &manifold
+)
+{
+  JPH::Body const                                         *jph_hitted_body;
   JPH::Body const                                         *jph_kinematic_body;
-  crude_physics_kinematic_body_container                  *kinematic_body;
-  crude_physics_static_body_container                     *static_body;
-  crude_physics_kinematic_body_handle                      kinematic_body_handle;
-  crude_physics_static_body_handle                         static_body_handle;
-  crude_entity                                             signal_entity;
-  crude_entity                                             hitted_entity;
+  crude_physics_contact_events_buffer                     *events_buffer;
+  crude_physics_contact_event                             *event;
+  JPH::Vec3                                                jph_normal;
+  uint32                                                   thread_num;
+
+  /* Called from physics jobs, every thread owns its buffer */
+  thread_num = enkiGetThreadNum( this->physics->task_sheduler->enki_task_sheduler );
+  CRUDE_ASSERT( thread_num < this->physics->contact_events_buffers_count );
+  events_buffer = &this->physics->contact_events_buffers[ thread_num ];
+  ++events_buffer->contacts_count;
 
   if ( body1.GetMotionType( ) == JPH::EMotionType::Dynamic || body2.GetMotionType( ) == JPH::EMotionType::Dynamic )
   {
@@ -223,56 +463,51 @@ _crude_jph_contact_listener_class::OnContactAdded
     return;
   }
 
-  if ( body1.GetMotionType( ) == JPH::EMotionType::Kinematic )
+  /* Kinematic vs kinematic pairs come from a sensor overlapping the inner body of a virtual character, sensor is the signal body then */
+  if ( body1.IsSensor( ) || ( !body2.IsSensor( ) && body1.GetMotionType( ) == JPH::EMotionType::Kinematic ) )
   {
     jph_kinematic_body = &body1;
-    jph_static_body = &body2;
-    CRUDE_ASSERT( body2.GetMotionType( ) == JPH::EMotionType::Static );
+    jph_hitted_body = &body2;
+    jph_normal = manifold.mWorldSpaceNormal;
   }
-  else if ( body2.GetMotionType( ) == JPH::EMotionType::Kinematic )
+  else if ( body2.IsSensor( ) || body2.GetMotionType( ) == JPH::EMotionType::Kinematic )
   {
     jph_kinematic_body = &body2;
-    jph_static_body = &body1;
-    CRUDE_ASSERT( body1.GetMotionType( ) == JPH::EMotionType::Static );
+    jph_hitted_body = &body1;
+    jph_normal = -manifold.mWorldSpaceNormal;
   }
   else
   {
-    // !TODO WHY THE FUCK IT CALLED FOR CHARACTER!!!!!!!!
     CRUDE_ASSERT( false );
     return;
   }
 
-  kinematic_body_handle.index = jph_kinematic_body->GetUserData( );
-  kinematic_body = crude_physics_access_kinematic_body( this->physics, kinematic_body_handle );
-  signal_entity = kinematic_body->entity;
-  
-  static_body_handle.index = jph_static_body->GetUserData( );
-  static_body = crude_physics_access_static_body( this->physics, static_body_handle );
-  hitted_entity = static_body->entity;
-  
-  CRUDE_ASSERT( kinematic_body->contact_added_callback );
-  kinematic_body->contact_added_callback( signal_entity, hitted_entity );
-}
+  if ( CRUDE_PHYSICS_BODY_USER_DATA_TYPE( jph_kinematic_body->GetUserData( ) ) != CRUDE_PHYSICS_BODY_USER_DATA_TYPE_KINEMATIC_BODY )
+  {
+    return;
+  }
 
-void
-_crude_jph_contact_listener_class::OnContactPersisted
-(
-  _In_ const JPH::Body                                    &body1,
-  _In_ const JPH::Body                                    &body2,
-  _In_ const JPH::ContactManifold                         &manifold,
-  _In_ JPH::ContactSettings                               &settings
-)
-{
-  //cout << "A contact was persisted" << endl;
+  if ( events_buffer->events_count >= CRUDE_PHYSICS_CONTACT_EVENTS_PER_THREAD_MAX )
+  {
+    ++events_buffer->dropped_events_count;
+    return;
+  }
+
+  event = &events_buffer->events[ events_buffer->events_count++ ];
+  event->type = type;
+  event->kinematic_body_handle.index = CRUDE_PHYSICS_BODY_USER_DATA_INDEX( jph_kinematic_body->GetUserData( ) );
+  event->signal_entity = crude_physics_access_kinematic_body( this->physics, event->kinematic_body_handle )->entity;
+  event->hitted_entity = crude_physics_body_entity_( this->physics, jph_hitted_body->GetUserData( ) );
+  XMStoreFloat3( &event->point, crude_jph_vec3_to_vector( manifold.GetWorldSpaceContactPointOn1( 0 ) ) );
+  XMStoreFloat3( &event->normal, crude_jph_vec3_to_vector( jph_normal ) );
 }
 
-void
-_crude_jph_contact_listener_class::OnContactRemoved
+_crude_jph_body_activation_listener_class::_crude_jph_body_activation_listener_class
 (
-  _In_ const JPH::SubShapeIDPair                        &subshapepair
+  _In_ crude_physics                                      *physics
 )
 {
-  //cout << "A contact was removed" << endl;
+  this->physics = physics;
 }
 
 void
@@ -282,7 +517,7 @@ _crude_jph_body_activation_listener_class::OnBodyActivated
   _In_ uint64                                              body_user_data
 )
 {
-  //cout << "A body got activated" << endl;
+  crude_physics_set_body_active_( this->physics, body_id, body_user_data, true );
 }
 
 void
@@ -292,470 +527,1868 @@ _crude_jph_body_activation_listener_class::OnBodyDeactivated
   _In_ uint64                                              body_user_data
 )
 {
-  //cout << "A body went to sleep" << endl;
+  crude_physics_set_body_active_( this->physics, body_id, body_user_data, false );
 }
 
 void
-crude_physics_initialize
+_crude_jph_character_vs_character_collision_class::snapshot
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_creation const                       *creation,
-  _In_ crude_ecs                                          *world
+  _In_ float32                                             expansion
 )
 {
-  physics->physics_allocator = creation->physics_allocator;
-  physics->physics_allocator_container = crude_heap_allocator_pack( creation->physics_allocator );
-  physics->physics_system_context = creation->physics_system_context;
+  this->snapshot_bounds.resize( this->mCharacters.size( ) );
+  for ( size_t i = 0; i < this->mCharacters.size( ); ++i )
+  {
+    JPH::CharacterVirtual const                           *jph_character;
 
-  physics->last_update_time = crude_time_now( );
-  physics->simulation_enabled = true;
+    jph_character = this->mCharacters[ i ];
+    this->snapshot_bounds[ i ] = jph_character->GetShape( )->GetWorldSpaceBounds( jph_character->GetCenterOfMassTransform( ), JPH::Vec3::sOne( ) );
+    this->snapshot_bounds[ i ].ExpandBy( JPH::Vec3::sReplicate( expansion ) );
+  }
+}
 
-  crude_resource_pool_initialize( &physics->characters_resource_pool, physics->physics_allocator_container, 16, sizeof( crude_physics_character_container ) );
-  crude_resource_pool_initialize( &physics->static_body_resource_pool, physics->physics_allocator_container, 256, sizeof( crude_physics_static_body_container ) );
-  crude_resource_pool_initialize( &physics->kinematic_body_resource_pool, physics->physics_allocator_container, 256, sizeof( crude_physics_kinematic_body_container ) );
+void
+_crude_jph_character_vs_character_collision_class::CollideCharacter
+(
+  _In_ JPH::CharacterVirtual const                        *jph_character,
+  _In_ JPH::RMat44Arg                                      jph_center_of_mass_transform,
+  _In_ JPH::CollideShapeSettings const                    &jph_collide_shape_settings,
+  _In_ JPH::RVec3Arg                                       jph_base_offset,
+  _In_ JPH::CollideShapeCollector                         &jph_collector
+) const
+{
+  JPH::CollideShapeSettings                                jph_settings;
+  JPH::Mat44                                               jph_transform;
+  JPH::AABox                                               jph_bounds;
+  JPH::Shape const                                        *jph_shape;
 
-  g_physics_heap_allocator_ = creation->physics_allocator;
-  JPH::Allocate = crude_physics_jph_allocate_implementation;
-  JPH::Reallocate = crude_physics_jph_reallocate_implementation;
-  JPH::Free = crude_physics_jph_free_implementation;
-  JPH::AlignedAllocate = crude_physics_jph_aligned_allocate_implementation;
-  JPH::AlignedFree = crude_physics_jph_aligned_free_implementation;
-  
-#if defined(JPH_ENABLE_ASSERTS)
-  JPH::Trace = crude_physics_jolt_trace_impl_;
+  CRUDE_ASSERT( this->snapshot_bounds.size( ) == this->mCharacters.size( ) );
 
-  JPH_IF_ENABLE_ASSERTS( JPH::AssertFailed = crude_physics_jolt_assert_failed_impl_ ;);
-#endif
+  /* Shapes are relative to the base offset, same as JPH::CharacterVsCharacterCollisionSimple */
+  jph_transform = jph_center_of_mass_transform.PostTranslated( -jph_base_offset ).ToMat44( );
+  jph_shape = jph_character->GetShape( );
+  jph_settings = jph_collide_shape_settings;
+  jph_bounds = jph_shape->GetWorldSpaceBounds( jph_transform, JPH::Vec3::sOne( ) );
 
-  JPH::Factory::sInstance = new JPH::Factory( );
+  for ( size_t i = 0; i < this->mCharacters.size( ) && !jph_collector.ShouldEarlyOut( ); ++i )
+  {
+    JPH::CharacterVirtual const                           *jph_other_character;
+    JPH::AABox                                             jph_other_bounds;
+    JPH::Mat44                                             jph_other_transform;
 
-  JPH::RegisterTypes( );
-  
-  physics->jph_temporary_allocator_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::TempAllocatorImpl( 10 * 1024 * 1024 );
-  physics->jph_job_system_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::JobSystemThreadPool( JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, 1u );
-  physics->jph_physics_system_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::PhysicsSystem( );
+    jph_other_character = this->mCharacters[ i ];
+    if ( jph_other_character == jph_character )
+    {
+      continue;
+    }
 
-  physics->jph_broad_phase_layer_interface_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_bp_layer_interface_class );
-  physics->jph_object_vs_broadphase_layer_filter_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_object_vs_broad_phase_layer_filter );
-  physics->jph_object_vs_object_layer_filter_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_object_layer_pair_filter_class );
-  
-  physics->jph_body_activation_listener_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_body_activation_listener_class );
-  physics->jph_contact_listener_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_contact_listener_class, physics );
+    jph_settings.mMaxSeparationDistance = jph_collide_shape_settings.mMaxSeparationDistance + jph_other_character->GetCharacterPadding( );
 
-  physics->jph_physics_system_class->Init(
-    CRUDE_PHYSICS_JOLT_MAX_BODIES, CRUDE_PHYSICS_JOLT_NUM_BODIES_MUTEXES, CRUDE_PHYSICS_JOLT_MAX_BODIES_PAIRS, CRUDE_PHYSICS_JOLT_MAX_CONTACT_CONSTRAINTS,
-    *physics->jph_broad_phase_layer_interface_class, *physics->jph_object_vs_broadphase_layer_filter_class, *physics->jph_object_vs_object_layer_filter_class );
+    /* Pose of the other character is read only when the snapshot overlaps, it isn't moved by another worker then */
+    jph_other_bounds = this->snapshot_bounds[ i ];
+    jph_other_bounds.Translate( JPH::Vec3( -jph_base_offset ) );
+    jph_other_bounds.ExpandBy( JPH::Vec3::sReplicate( jph_settings.mMaxSeparationDistance ) );
+    if ( !jph_bounds.Overlaps( jph_other_bounds ) )
+    {
+      continue;
+    }
 
-  physics->jph_physics_system_class->SetBodyActivationListener( physics->jph_body_activation_listener_class );
-  physics->jph_physics_system_class->SetContactListener( physics->jph_contact_listener_class );
-  
-  //physics->jph_physics_system_class->OptimizeBroadPhase( );
+    jph_other_transform = jph_other_character->GetCenterOfMassTransform( ).PostTranslated( -jph_base_offset ).ToMat44( );
 
-  physics->physics_shapes_manager = creation->physics_shapes_manager;
+    jph_collector.SetUserData( CRUDE_REINTERPRET_CAST( JPH::uint64, jph_other_character ) );
+    JPH::CollisionDispatch::sCollideShapeVsShape( jph_shape, jph_other_character->GetShape( ), JPH::Vec3::sOne( ), JPH::Vec3::sOne( ), jph_transform, jph_other_transform, JPH::SubShapeIDCreator( ), JPH::SubShapeIDCreator( ), jph_settings, jph_collector );
+  }
+
+  jph_collector.SetUserData( 0 );
 }
 
 void
-crude_physics_deinitialize
+_crude_jph_character_vs_character_collision_class::CastCharacter
 (
-  _In_ crude_physics                                      *physics
-)
+  _In_ JPH::CharacterVirtual const                        *jph_character,
+  _In_ JPH::RMat44Arg                                      jph_center_of_mass_transform,
+  _In_ JPH::Vec3Arg                                        jph_direction,
+  _In_ JPH::ShapeCastSettings const                       &jph_shape_cast_settings,
+  _In_ JPH::RVec3Arg                                       jph_base_offset,
+  _In_ JPH::CastShapeCollector                            &jph_collector
+) const
 {
-  JPH::BodyInterface                                      *jph_body_interface_class;
+  JPH::Vec3                                                jph_origin;
+  JPH::Vec3                                                jph_extents;
 
-  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
-  
-  JPH::UnregisterTypes();
-  
-  delete JPH::Factory::sInstance;
-  JPH::Factory::sInstance = nullptr;
-  
-  CRUDE_JOLT_OVERRIDEN_FREE physics->jph_temporary_allocator_class;
-  CRUDE_JOLT_OVERRIDEN_FREE physics->jph_job_system_class;
-  CRUDE_JOLT_OVERRIDEN_FREE physics->jph_physics_system_class;
+  CRUDE_ASSERT( this->snapshot_bounds.size( ) == this->mCharacters.size( ) );
 
-  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_broad_phase_layer_interface_class, _crude_jph_bp_layer_interface_class );
-  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_object_vs_broadphase_layer_filter_class, _crude_jph_object_vs_broad_phase_layer_filter );
-  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_object_vs_object_layer_filter_class, _crude_jph_object_layer_pair_filter_class );
-  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_body_activation_listener_class, _crude_jph_body_activation_listener_class );
-  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_contact_listener_class, _crude_jph_contact_listener_class );
-  
-  crude_resource_pool_deinitialize( &physics->characters_resource_pool );
-  crude_resource_pool_deinitialize( &physics->static_body_resource_pool );
-  crude_resource_pool_deinitialize( &physics->kinematic_body_resource_pool );
-}
+  JPH::ShapeCast jph_shape_cast( jph_character->GetShape( ), JPH::Vec3::sOne( ), jph_center_of_mass_transform.PostTranslated( -jph_base_offset ).ToMat44( ), jph_direction );
+  jph_origin = jph_shape_cast.mShapeWorldBounds.GetCenter( );
+  jph_extents = jph_shape_cast.mShapeWorldBounds.GetExtent( );
 
-void
-crude_physics_update
-(
-  _In_ crude_physics                                      *physics,
-  _In_ int64                                               current_time
-)
-{
-  if ( !physics->simulation_enabled )
+  for ( size_t i = 0; i < this->mCharacters.size( ) && !jph_collector.ShouldEarlyOut( ); ++i )
   {
-    return;
-  }
+    JPH::CharacterVirtual const                           *jph_other_character;
+    JPH::AABox                                             jph_other_bounds;
+    JPH::Mat44                                             jph_other_transform;
 
-  if ( crude_time_delta_seconds( physics->last_update_time, current_time ) < CRUDE_PHYSICS_JOLT_DELTA_TIME )
-  {
-    return;
+    jph_other_character = this->mCharacters[ i ];
+    if ( jph_other_character == jph_character )
+    {
+      continue;
+    }
+
+    jph_other_bounds = this->snapshot_bounds[ i ];
+    jph_other_bounds.Translate( JPH::Vec3( -jph_base_offset ) );
+    jph_other_bounds.ExpandBy( jph_extents );
+    if ( !JPH::RayAABoxHits( jph_origin, jph_direction, jph_other_bounds.mMin, jph_other_bounds.mMax ) )
+    {
+      continue;
+    }
+
+    jph_other_transform = jph_other_character->GetCenterOfMassTransform( ).PostTranslated( -jph_base_offset ).ToMat44( );
+
+    jph_collector.SetUserData( CRUDE_REINTERPRET_CAST( JPH::uint64, jph_other_character ) );
+    JPH::CollisionDispatch::sCastShapeVsShapeWorldSpace( jph_shape_cast, jph_shape_cast_settings, jph_other_character->GetShape( ), JPH::Vec3::sOne( ), JPH::ShapeFilter( ), jph_other_transform, JPH::SubShapeIDCreator( ), JPH::SubShapeIDCreator( ), jph_collector );
   }
 
-  physics->jph_physics_system_class->Update( CRUDE_PHYSICS_JOLT_DELTA_TIME, CRUDE_PHYSICS_JOLT_COLLISIONS_STEPS, physics->jph_temporary_allocator_class, physics->jph_job_system_class );
-  physics->last_update_time = current_time;
+  jph_collector.SetUserData( 0 );
 }
 
-void
-crude_physics_enable_simulation
+bool
+_crude_jph_inner_body_filter_class::ShouldCollideLocked
 (
-  _In_ crude_physics                                      *physics,
-  _In_ ecs_world_t                                        *world,
-  _In_ bool                                                enable
-)
+  _In_ JPH::Body const                                    &jph_body
+) const
 {
-  physics->simulation_enabled = enable;
-  crude_entity_enable( world, crude_ecs_on_pre_physics_update, enable );
-  crude_entity_enable( world, crude_ecs_on_post_physics_update, enable );
+  /* JPH::Character body is dynamic, so only inner bodies are kinematic characters */
+  return !jph_body.IsKinematic( ) || CRUDE_PHYSICS_BODY_USER_DATA_TYPE( jph_body.GetUserData( ) ) != CRUDE_PHYSICS_BODY_USER_DATA_TYPE_CHARACTER;
 }
 
-crude_physics_character_creation
-crude_physics_character_creation_empty
+bool
+_crude_jph_ray_cast_object_layer_filter_class::ShouldCollide
 (
-)
+  _In_ JPH::ObjectLayer                                    layer
+) const
 {
-  crude_physics_character_creation creation = CRUDE_COMPOUNT_EMPTY( crude_physics_character_creation );
-  return creation;
+  return CRUDE_JPH_OBJECT_MASK( this->mask ) & CRUDE_JPH_OBJECT_LAYER( layer );
 }
 
-crude_physics_static_body_creation
-crude_physics_static_body_creation_empty
+bool
+_crude_jph_ray_cast_broad_phase_layer_filter_class::ShouldCollide
 (
-)
+  _In_ JPH::BroadPhaseLayer                                layer
+) const
 {
-  crude_physics_static_body_creation creation = CRUDE_COMPOUNT_EMPTY( crude_physics_static_body_creation );
-  return creation;
+  if ( ( this->mask & g_crude_jph_broad_phase_layer_dynamic_mask ) && ( layer == g_crude_jph_broad_phase_layer_dynamic_class ) )
+  {
+    return true;
+  }
+  if ( ( this->mask & g_crude_jph_broad_phase_layer_static_mask ) && ( layer == g_crude_jph_broad_phase_layer_static_class ) )
+  {
+    return true;
+  }
+  if ( ( this->mask & g_crude_jph_broad_phase_layer_area_mask ) && ( layer == g_crude_jph_broad_phase_layer_area_class ) )
+  {
+    return true;
+  }
+  return false;
 }
 
-crude_physics_kinematic_body_creation
-crude_physics_kinematic_body_creation_empty
+_crude_jph_shape_cast_collector_class::_crude_jph_shape_cast_collector_class
 (
+  _In_ crude_physics_shape_query_result                   *result
 )
 {
-  crude_physics_kinematic_body_creation creation = CRUDE_COMPOUNT_EMPTY( crude_physics_kinematic_body_creation );
-  return creation;
+  this->result = result;
 }
 
-crude_physics_character_handle
-crude_physics_create_character
+void
+_crude_jph_shape_cast_collector_class::AddHit
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_character_creation const             *creation
+  _In_ JPH::ShapeCastResult const                         &jph_result
 )
 {
-  crude_physics_character_container                       *character_container;
-  crude_physics_character_handle                           handle;
-  JPH::Ref< JPH::CharacterSettings >                       jph_settings_class;
-  JPH::RefConst< JPH::Shape >                              jph_standing_shape;
-    
-  jph_standing_shape = JPH::RotatedTranslatedShapeSettings(
-    JPH::Vec3( 0, 0.5f * creation->character_height_standing + creation->character_radius_standing, 0 ),
-    JPH::Quat::sIdentity( ),
-    CRUDE_JOLT_OVERRIDEN_NEW JPH::CapsuleShape( 0.5f * creation->character_height_standing, creation->character_radius_standing )
-  ).Create( ).Get( );
+  crude_physics_shape_hit                                 *hit;
 
-  jph_settings_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::CharacterSettings( );
-  jph_settings_class->mMaxSlopeAngle = creation->max_slop_angle;
-  jph_settings_class->mLayer = creation->layers;
-  jph_settings_class->mShape = jph_standing_shape;
-  jph_settings_class->mFriction = creation->friction;
-  jph_settings_class->mSupportingVolume = JPH::Plane( JPH::Vec3::sAxisY( ), -creation->character_radius_standing );
-    
-  handle.index = crude_resource_pool_obtain_resource( &physics->characters_resource_pool );
+  if ( this->result->hits_count < this->result->hits_capacity )
+  {
+    hit = &this->result->hits[ this->result->hits_count++ ];
+  }
+  else
+  {
+    /* Replace the farthest hit, the collector only reports hits closer than the early out fraction */
+    hit = NULL;
+    for ( uint32 i = 0; i < this->result->hits_count; ++i )
+    {
+      if ( !hit || this->result->hits[ i ].fraction > hit->fraction )
+      {
+        hit = &this->result->hits[ i ];
+      }
+    }
+    this->result->overflow = true;
+    if ( !hit )
+    {
+      ForceEarlyOut( );
+      return;
+    }
+  }
 
-  character_container = crude_physics_access_character( physics, handle );
-  CRUDE_CXX_CONSTRUCTOR( &character_container->jph_character_class, JPH::Ref< JPH::Character > );
+  *hit = CRUDE_COMPOUNT_EMPTY( crude_physics_shape_hit );
+  XMStoreFloat3( &hit->point, crude_jph_vec3_to_vector( jph_result.mContactPointOn2 ) );
+  XMStoreFloat3( &hit->normal, crude_jph_vec3_to_vector( -jph_result.mPenetrationAxis.NormalizedOr( JPH::Vec3::sZero( ) ) ) );
+  hit->fraction = jph_result.mFraction;
+  hit->jph_body_id = jph_result.mBodyID2.GetIndexAndSequenceNumber( );
 
-  character_container->jph_character_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::Character(
-    jph_settings_class,
-    JPH::RVec3::sZero( ),
-    JPH::Quat::sIdentity( ),
-    0,
-    physics->jph_physics_system_class );
-  
-  character_container->jph_character_class->AddToPhysicsSystem( JPH::EActivation::Activate );
-  
-  CRUDE_CXX_CONSTRUCTOR( &character_container->manually_stored_transform, JPH::Mat44 );
+  if ( this->result->hits_count == this->result->hits_capacity )
+  {
+    float32                                                farthest_fraction;
 
-  return handle;
+    farthest_fraction = 0.f;
+    for ( uint32 i = 0; i < this->result->hits_count; ++i )
+    {
+      farthest_fraction = CRUDE_MAX( farthest_fraction, this->result->hits[ i ].fraction );
+    }
+    if ( farthest_fraction < GetEarlyOutFraction( ) )
+    {
+      UpdateEarlyOutFraction( farthest_fraction );
+    }
+  }
 }
 
-crude_physics_character_container*
-crude_physics_access_character
+_crude_jph_shape_overlap_collector_class::_crude_jph_shape_overlap_collector_class
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_character_handle                      handle
+  _In_ crude_physics_shape_query_result                   *result
 )
 {
-  return CRUDE_CAST( crude_physics_character_container*, crude_resource_pool_access_resource( &physics->characters_resource_pool, handle.index ) );
+  this->result = result;
 }
 
-CRUDE_API void
-crude_physics_destroy_character_instant
+void
+_crude_jph_shape_overlap_collector_class::AddHit
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_character_handle                      handle
+  _In_ JPH::CollideShapeResult const                      &jph_result
 )
 {
-  crude_physics_character_container                       *character_container;
+  crude_physics_shape_hit                                 *hit;
+  uint32                                                   jph_body_id;
 
-  character_container = crude_physics_access_character( physics, handle );
+  /* Hits of one body are reported together, so checking the last one is enough */
+  jph_body_id = jph_result.mBodyID2.GetIndexAndSequenceNumber( );
+  if ( this->result->hits_count && this->result->hits[ this->result->hits_count - 1 ].jph_body_id == jph_body_id )
+  {
+    return;
+  }
 
-  character_container->jph_character_class->RemoveFromPhysicsSystem( );
-  character_container->jph_character_class.~Ref( );
+  if ( this->result->hits_count == this->result->hits_capacity )
+  {
+    this->result->overflow = true;
+    ForceEarlyOut( );
+    return;
+  }
 
-  crude_resource_pool_release_resource( &physics->characters_resource_pool, handle.index );
+  hit = &this->result->hits[ this->result->hits_count++ ];
+  *hit = CRUDE_COMPOUNT_EMPTY( crude_physics_shape_hit );
+  XMStoreFloat3( &hit->point, crude_jph_vec3_to_vector( jph_result.mContactPointOn2 ) );
+  XMStoreFloat3( &hit->normal, crude_jph_vec3_to_vector( -jph_result.mPenetrationAxis.NormalizedOr( JPH::Vec3::sZero( ) ) ) );
+  hit->jph_body_id = jph_body_id;
 }
 
-
-crude_physics_static_body_handle
-crude_physics_create_static_body
+_crude_jph_job_system_class::_crude_jph_job_system_class
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_static_body_creation const           *creation
+  _In_ crude_task_sheduler                                *task_sheduler,
+  _In_ uint32                                              max_jobs,
+  _In_ uint32                                              max_barriers
 )
+  : JPH::JobSystemWithBarrier( max_barriers )
 {
-  crude_physics_static_body_container                     *static_body_container;
-  JPH::BodyInterface                                      *jph_body_interface_class;
-  JPH::ShapeSettings::ShapeResult                          jph_shape_result_class;
-  JPH::ShapeRefC                                           jph_shape_class;
-  JPH::BodyCreationSettings                                jph_settings_class;
-  crude_physics_static_body_handle                         handle;
-    
-  handle.index = crude_resource_pool_obtain_resource( &physics->static_body_resource_pool );
-
-  static_body_container = crude_physics_access_static_body( physics, handle );
-
-  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
-  
-  if ( creation->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_BOX )
+  this->task_sheduler = task_sheduler;
+  this->jobs.Init( max_jobs, max_jobs );
+  this->task_slots_count = max_jobs;
+  this->task_slots = CRUDE_JOLT_OVERRIDEN_NEW task_slot[ max_jobs ];
+  this->next_task_slot = 0u;
+  for ( uint32 i = 0; i < CRUDE_PHYSICS_STEP_PHASE_COUNT; ++i )
   {
-    JPH::BoxShapeSettings                                    jph_shape_settings_class;
-    jph_shape_settings_class = CRUDE_COMPOUNT( JPH::BoxShapeSettings, { JPH::Vec3( creation->box.extent.x, creation->box.extent.y, creation->box.extent.z ) } );
-    jph_shape_settings_class.SetEmbedded( );
-    jph_shape_result_class = jph_shape_settings_class.Create( );
-    jph_shape_class = jph_shape_result_class.Get( );
+    this->phases_time[ i ] = 0;
   }
-  else if ( creation->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH )
+  for ( uint32 i = 0; i < this->task_slots_count; ++i )
   {
-    jph_shape_class = crude_physics_shapes_manager_access_mesh_shape( physics->physics_shapes_manager, creation->mesh.handle )->jph_shape_class;
+    this->task_slots[ i ].enki_task_set = enkiCreateTaskSet( task_sheduler->enki_task_sheduler, execute_task_ );
+    this->task_slots[ i ].job = nullptr;
+    this->task_slots[ i ].in_use = false;
   }
-
-  jph_settings_class = JPH::BodyCreationSettings( jph_shape_class, JPH::RVec3( 0.0, 0.0, 0.0 ), JPH::Quat::sIdentity( ), JPH::EMotionType::Static, creation->layers );
-  jph_settings_class.mUserData = handle.index;
-
-  CRUDE_CXX_CONSTRUCTOR( &static_body_container->jph_body_class, JPH::BodyID, jph_body_interface_class->CreateAndAddBody( jph_settings_class, JPH::EActivation::Activate ) );
-  
-  static_body_container->entity = creation->entity;
-
-  return handle;
 }
 
-crude_physics_static_body_container*
-crude_physics_access_static_body
+_crude_jph_job_system_class::~_crude_jph_job_system_class
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_static_body_handle                    handle
 )
-{ 
-  return CRUDE_CAST( crude_physics_static_body_container*, crude_resource_pool_access_resource( &physics->static_body_resource_pool, handle.index ) );
+{
+  for ( uint32 i = 0; i < this->task_slots_count; ++i )
+  {
+    enkiWaitForTaskSet( this->task_sheduler->enki_task_sheduler, this->task_slots[ i ].enki_task_set );
+    enkiDeleteTaskSet( this->task_sheduler->enki_task_sheduler, this->task_slots[ i ].enki_task_set );
+  }
+  CRUDE_JOLT_OVERRIDEN_FREE[] this->task_slots;
 }
 
-void
-crude_physics_destroy_static_body_instant
+int
+_crude_jph_job_system_class::GetMaxConcurrency
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_static_body_handle                    handle
-)
+) const
 {
-  JPH::BodyInterface                                      *jph_body_interface_class;
-  crude_physics_static_body_container                     *static_body_container;
-
-  static_body_container = crude_physics_access_static_body( physics, handle );
-  
-  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
-
-  jph_body_interface_class->RemoveBody( static_body_container->jph_body_class );
-  jph_body_interface_class->DestroyBody( static_body_container->jph_body_class );
-
-  crude_resource_pool_release_resource( &physics->static_body_resource_pool, handle.index );
+  return enkiGetNumTaskThreads( this->task_sheduler->enki_task_sheduler );
 }
 
-crude_physics_kinematic_body_handle
-crude_physics_create_kinematic_body
+JPH::JobHandle
+_crude_jph_job_system_class::CreateJob
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_kinematic_body_creation const        *creation
+  _In_ char const                                         *name,
+  _In_ JPH::ColorArg                                       color,
+  _In_ JPH::JobSystem::JobFunction const                  &job_function,
+  _In_ JPH::uint32                                         dependencies_count
 )
 {
-  crude_physics_kinematic_body_container                  *kinematic_body_container;
-  JPH::BodyInterface                                      *jph_body_interface_class;
-  JPH::ShapeSettings::ShapeResult                          jph_shape_result_class;
-  JPH::ShapeRefC                                           jph_shape_class;
-  JPH::BodyCreationSettings                                jph_settings_class;
-  crude_physics_kinematic_body_handle                      handle;
-    
-  handle.index = crude_resource_pool_obtain_resource( &physics->kinematic_body_resource_pool );
-
-  kinematic_body_container = crude_physics_access_kinematic_body( physics, handle );
+  JPH::JobSystem::JobFunction                              timed_job_function;
+  Job                                                     *job;
+  JPH::atomic< int64 >                                    *phase_time;
+  uint32                                                   job_index;
 
-  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
-  
-  if ( creation->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_BOX )
+  phase_time = &this->phases_time[ crude_physics_step_phase_from_job_name_( name ) ];
+  timed_job_function = [ phase_time, job_function ]( )
   {
-    JPH::BoxShapeSettings                                    jph_shape_settings_class;
-    jph_shape_settings_class = CRUDE_COMPOUNT( JPH::BoxShapeSettings, { JPH::Vec3( creation->box.extent.x, creation->box.extent.y, creation->box.extent.z ) } );
-    jph_shape_settings_class.SetEmbedded( );
-    jph_shape_result_class = jph_shape_settings_class.Create( );
-    jph_shape_class = jph_shape_result_class.Get( );
-  }
-  else if ( creation->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH )
+    int64                                                  start_time;
+
+    start_time = crude_time_now( );
+    job_function( );
+    phase_time->fetch_add( crude_time_now( ) - start_time, std::memory_order_relaxed );
+  };
+
+  /* Jobs are sized from JPH::cMaxPhysicsJobs, so the step never runs out of them. Waiting for all tasks
+   * here would wait for the calling job too, other jobs release theirs without help */
+  job_index = this->jobs.ConstructObject( name, color, this, timed_job_function, dependencies_count );
+  while ( job_index == JPH::FixedSizeFreeList< Job >::cInvalidObjectIndex )
   {
-    jph_shape_class = crude_physics_shapes_manager_access_mesh_shape( physics->physics_shapes_manager, creation->mesh.handle )->jph_shape_class;
+    CRUDE_ASSERTM( CRUDE_CHANNEL_PHYSICS, false, "No physics jobs available!" );
+    std::this_thread::yield( );
+    job_index = this->jobs.ConstructObject( name, color, this, timed_job_function, dependencies_count );
   }
 
-  jph_settings_class = JPH::BodyCreationSettings( jph_shape_class, JPH::RVec3( 0.0, 0.0, 0.0 ), JPH::Quat::sIdentity( ), JPH::EMotionType::Kinematic, creation->layers );
-  jph_settings_class.mUserData = handle.index;
+  job = &this->jobs.Get( job_index );
 
-  if ( creation->sensor )
+  /* Handle keeps a reference, the job is queued below and may immediately complete */
+  JPH::JobHandle handle( job );
+
+  if ( dependencies_count == 0 )
   {
-    jph_settings_class.mIsSensor = true;
-    jph_settings_class.mCollideKinematicVsNonDynamic = true;
+    QueueJob( job );
   }
 
-  CRUDE_CXX_CONSTRUCTOR( &kinematic_body_container->jph_body_class, JPH::BodyID, jph_body_interface_class->CreateAndAddBody( jph_settings_class, JPH::EActivation::Activate ) );
-  
-  kinematic_body_container->entity = creation->entity;
-
   return handle;
 }
 
-crude_physics_kinematic_body_container*
-crude_physics_access_kinematic_body
+void
+_crude_jph_job_system_class::consume_phases_time
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_kinematic_body_handle                 handle
+  _Out_ int64                                              phases_time[ CRUDE_PHYSICS_STEP_PHASE_COUNT ]
 )
 {
-  return CRUDE_CAST( crude_physics_kinematic_body_container*, crude_resource_pool_access_resource( &physics->kinematic_body_resource_pool, handle.index ) );
+  for ( uint32 i = 0; i < CRUDE_PHYSICS_STEP_PHASE_COUNT; ++i )
+  {
+    phases_time[ i ] = this->phases_time[ i ].exchange( 0, std::memory_order_relaxed );
+  }
 }
 
 void
-crude_physics_destroy_kinematic_body_instant
+_crude_jph_job_system_class::QueueJob
 (
-  _In_ crude_physics                                      *physics,
-  _In_ crude_physics_kinematic_body_handle                 handle
+  _In_ Job                                                *job
 )
 {
-  JPH::BodyInterface                                      *jph_body_interface_class;
-  crude_physics_kinematic_body_container                  *kinematic_body_container;
+  job->AddRef( );
 
-  kinematic_body_container = crude_physics_access_kinematic_body( physics, handle );
-  
-  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
+  for ( uint32 i = 0; i < this->task_slots_count; ++i )
+  {
+    task_slot                                             *slot;
+    bool                                                   expected_in_use;
+
+    slot = &this->task_slots[ this->next_task_slot.fetch_add( 1u, std::memory_order_relaxed ) % this->task_slots_count ];
+    expected_in_use = false;
+    if ( !slot->in_use.compare_exchange_strong( expected_in_use, true, std::memory_order_acquire ) )
+    {
+      continue;
+    }
 
-  jph_body_interface_class->RemoveBody( kinematic_body_container->jph_body_class );
-  jph_body_interface_class->DestroyBody( kinematic_body_container->jph_body_class );
+    /* execute_task_ releases the slot right before enki marks the task set complete */
+    if ( !enkiIsTaskSetComplete( this->task_sheduler->enki_task_sheduler, slot->enki_task_set ) )
+    {
+      slot->in_use.store( false, std::memory_order_release );
+      continue;
+    }
 
-  crude_resource_pool_release_resource( &physics->kinematic_body_resource_pool, handle.index );
+    slot->job = job;
+    enkiAddTaskSetArgs( this->task_sheduler->enki_task_sheduler, slot->enki_task_set, slot, 1u );
+    return;
+  }
+
+  /* Slots are only taken by jobs or freed ones not yet marked complete, so this is rare and doesn't block the calling job */
+  job->Execute( );
+  job->Release( );
 }
 
-bool
-crude_physics_ray_cast
+void
+_crude_jph_job_system_class::QueueJobs
 (
-  _In_ crude_physics                                      *physics,
-  _In_ ecs_world_t                                        *world,
-  _In_ XMVECTOR                                            origin,
-  _In_ XMVECTOR                                            direction,
-  _In_ uint8                                               broad_phase_mask,
-  _In_ uint32                                              layer_mask,
-  _Out_ crude_ray_cast_result                             *ray_cast_result
+  _In_ Job                                               **jobs,
+  _In_ JPH::uint                                           jobs_count
 )
 {
-  class _crude_ray_cast_layer_filter_class : public JPH::ObjectLayerFilter
-  {
-  public:
-    _crude_ray_cast_layer_filter_class
-    (
-      _In_ uint32                                          mask
-    )
-    {
-      this->mask = mask;
-    }
-    virtual bool
-    ShouldCollide
-    ( 
-      _In_ JPH::ObjectLayer                                layer
-    ) const override
-    {
-      return CRUDE_JPH_OBJECT_MASK( mask ) & CRUDE_JPH_OBJECT_LAYER( layer );
-    }
-  private:
-    uint32                                                 mask;
-  };
-  class _crude_ray_cast_broad_layer_filter_class : public JPH::BroadPhaseLayerFilter
+  for ( JPH::uint i = 0; i < jobs_count; ++i )
   {
-  public:
-    _crude_ray_cast_broad_layer_filter_class
-    (
-      _In_ uint8                                           jph_broad_phase_mask
-    )
-    {
-      this->jph_broad_phase_mask = jph_broad_phase_mask;
-    }
-    virtual bool
-    ShouldCollide
-    (
-      _In_ JPH::BroadPhaseLayer                            layer
-    ) const override
-    {
-      if ( ( jph_broad_phase_mask & g_crude_jph_broad_phase_layer_dynamic_mask ) && ( layer == g_crude_jph_broad_phase_layer_dynamic_class ) )
-      {
-        return true;
-      }
-      if ( ( jph_broad_phase_mask & g_crude_jph_broad_phase_layer_static_mask ) && ( layer == g_crude_jph_broad_phase_layer_static_class ) )
-      {
-        return true;
-      }
-      if ( ( jph_broad_phase_mask & g_crude_jph_broad_phase_layer_area_mask ) && ( layer == g_crude_jph_broad_phase_layer_area_class ) )
-      {
-        return true;
-      }
-      return false;
-    }
-  private:
-    uint8                                                  jph_broad_phase_mask;
-  };
+    QueueJob( jobs[ i ] );
+  }
+}
 
+void
+_crude_jph_job_system_class::FreeJob
+(
+  _In_ Job                                                *job
+)
+{
+  this->jobs.DestructObject( job );
+}
+
+void
+_crude_jph_job_system_class::execute_task_
+(
+  _In_ uint32_t                                            start,
+  _In_ uint32_t                                            end,
+  _In_ uint32_t                                            thread_num,
+  _In_ void                                               *args
+)
+{
+  task_slot                                               *slot;
+  Job                                                     *job;
+
+  slot = CRUDE_CAST( task_slot*, args );
+  job = slot->job;
+  slot->job = nullptr;
+
+  /* Barrier could execute the job first while waiting, Execute does nothing then */
+  job->Execute( );
+  job->Release( );
+  slot->in_use.store( false, std::memory_order_release );
+}
+
+void
+crude_physics_initialize
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_creation const                       *creation,
+  _In_ crude_ecs                                          *world
+)
+{
+  physics->physics_allocator = creation->physics_allocator;
+  physics->physics_allocator_container = crude_heap_allocator_pack( creation->physics_allocator );
+  physics->physics_system_context = creation->physics_system_context;
+
+  physics->last_update_time = crude_time_now( );
+  physics->simulation_enabled = true;
+  physics->max_bodies = creation->max_bodies ? creation->max_bodies : CRUDE_PHYSICS_JOLT_MAX_BODIES;
+  physics->max_body_pairs = creation->max_body_pairs ? creation->max_body_pairs : ( creation->max_bodies ? creation->max_bodies : CRUDE_PHYSICS_JOLT_MAX_BODIES_PAIRS );
+  physics->max_contact_constraints = creation->max_contact_constraints ? creation->max_contact_constraints : ( creation->max_bodies ? creation->max_bodies : CRUDE_PHYSICS_JOLT_MAX_CONTACT_CONSTRAINTS );
+  physics->bodies_capacity_warned = false;
+  physics->body_pairs_capacity_warned = false;
+  physics->contact_constraints_capacity_warned = false;
+  physics->ray_cast_tasks_in_flight_count = 0u;
+  physics->update_errors_warned = 0u;
+  physics->max_steps_per_update = creation->max_steps_per_update ? creation->max_steps_per_update : CRUDE_PHYSICS_MAX_STEPS_PER_UPDATE;
+  physics->accumulated_time = 0.f;
+  physics->last_update_steps_count = 0u;
+  physics->interpolation_alpha = 1.f;
+  crude_physics_set_step_delta_time( physics, creation->step_delta_time > 0.f ? creation->step_delta_time : CRUDE_PHYSICS_JOLT_DELTA_TIME );
+
+  physics->bodies_batch_depth = 0u;
+  physics->unoptimized_bodies_count = 0u;
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( physics->batch_added_static_bodies, 256, physics->physics_allocator_container );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( physics->batch_added_kinematic_bodies, 64, physics->physics_allocator_container );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( physics->batch_removed_bodies, 256, physics->physics_allocator_container );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( physics->batch_destroyed_bodies, 256, physics->physics_allocator_container );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( physics->batch_bodies, 256, physics->physics_allocator_container );
+
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( physics->sync_characters, 16, physics->physics_allocator_container );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( physics->sync_static_bodies, 256, physics->physics_allocator_container );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( physics->sync_kinematic_bodies, 64, physics->physics_allocator_container );
+
+  crude_resource_pool_initialize( &physics->characters_resource_pool, physics->physics_allocator_container, 16, sizeof( crude_physics_character_container ) );
+  crude_resource_pool_initialize( &physics->static_body_resource_pool, physics->physics_allocator_container, 256, sizeof( crude_physics_static_body_container ) );
+  crude_resource_pool_initialize( &physics->kinematic_body_resource_pool, physics->physics_allocator_container, 256, sizeof( crude_physics_kinematic_body_container ) );
+
+  g_physics_heap_allocator_ = creation->physics_allocator;
+  JPH::Allocate = crude_physics_jph_allocate_implementation;
+  JPH::Reallocate = crude_physics_jph_reallocate_implementation;
+  JPH::Free = crude_physics_jph_free_implementation;
+  JPH::AlignedAllocate = crude_physics_jph_aligned_allocate_implementation;
+  JPH::AlignedFree = crude_physics_jph_aligned_free_implementation;
+  
+#if defined(JPH_ENABLE_ASSERTS)
+  JPH::Trace = crude_physics_jolt_trace_impl_;
+
+  JPH_IF_ENABLE_ASSERTS( JPH::AssertFailed = crude_physics_jolt_assert_failed_impl_ ;);
+#endif
+
+  JPH::Factory::sInstance = new JPH::Factory( );
+
+  JPH::RegisterTypes( );
+  
+  physics->jph_temporary_allocator_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::TempAllocatorImpl( 10 * 1024 * 1024 );
+  physics->task_sheduler = creation->task_sheduler;
+  physics->jph_job_system_class = CRUDE_JOLT_OVERRIDEN_NEW _crude_jph_job_system_class( physics->task_sheduler, JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers );
+  physics->jph_physics_system_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::PhysicsSystem( );
+
+  physics->jph_broad_phase_layer_interface_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_bp_layer_interface_class );
+  physics->jph_object_vs_broadphase_layer_filter_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_object_vs_broad_phase_layer_filter );
+  physics->jph_object_vs_object_layer_filter_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_object_layer_pair_filter_class );
+  
+  physics->jph_body_activation_listener_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_body_activation_listener_class, physics );
+  physics->jph_contact_listener_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_contact_listener_class, physics );
+
+  physics->jph_physics_system_class->Init(
+    physics->max_bodies, CRUDE_PHYSICS_JOLT_NUM_BODIES_MUTEXES, physics->max_body_pairs, physics->max_contact_constraints,
+    *physics->jph_broad_phase_layer_interface_class, *physics->jph_object_vs_broadphase_layer_filter_class, *physics->jph_object_vs_object_layer_filter_class );
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_PHYSICS, "Physics capacity: %u bodies, %u body pairs, %u contact constraints", physics->max_bodies, physics->max_body_pairs, physics->max_contact_constraints );
+
+  physics->jph_physics_system_class->SetBodyActivationListener( physics->jph_body_activation_listener_class );
+  physics->jph_physics_system_class->SetContactListener( physics->jph_contact_listener_class );
+  
+  //physics->jph_physics_system_class->OptimizeBroadPhase( );
+
+  physics->physics_shapes_manager = creation->physics_shapes_manager;
+
+  crude_physics_ray_cast_task_initialize( &physics->ray_cast_task, physics );
+
+  physics->jph_character_vs_character_collision_class = CRUDE_ALLOCATE_AND_CONSTRUCT( physics->physics_allocator_container, _crude_jph_character_vs_character_collision_class );
+  crude_physics_virtual_characters_task_initialize_( &physics->virtual_characters_task, physics );
+
+  physics->contact_events_buffers_count = enkiGetNumTaskThreads( physics->task_sheduler->enki_task_sheduler );
+  physics->contact_events_buffers = CRUDE_CAST( crude_physics_contact_events_buffer*, CRUDE_ALLOCATE( physics->physics_allocator_container, physics->contact_events_buffers_count * sizeof( crude_physics_contact_events_buffer ) ) );
+  for ( uint32 i = 0; i < physics->contact_events_buffers_count; ++i )
+  {
+    physics->contact_events_buffers[ i ].events_count = 0u;
+    physics->contact_events_buffers[ i ].dropped_events_count = 0u;
+    physics->contact_events_buffers[ i ].contacts_count = 0u;
+  }
+  physics->telemetry = CRUDE_COMPOUNT_EMPTY( crude_physics_telemetry );
+  physics->contact_events_overflow_warned = false;
+}
+
+void
+crude_physics_deinitialize
+(
+  _In_ crude_physics                                      *physics
+)
+{
+  JPH::BodyInterface                                      *jph_body_interface_class;
+
+  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
+  
+  crude_physics_ray_cast_task_deinitialize( &physics->ray_cast_task );
+  CRUDE_DEALLOCATE( physics->physics_allocator_container, physics->contact_events_buffers );
+
+  crude_physics_virtual_characters_task_deinitialize_( &physics->virtual_characters_task );
+  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_character_vs_character_collision_class, _crude_jph_character_vs_character_collision_class );
+
+  JPH::UnregisterTypes();
+  
+  delete JPH::Factory::sInstance;
+  JPH::Factory::sInstance = nullptr;
+  
+  CRUDE_JOLT_OVERRIDEN_FREE physics->jph_temporary_allocator_class;
+  CRUDE_JOLT_OVERRIDEN_FREE physics->jph_job_system_class;
+  CRUDE_JOLT_OVERRIDEN_FREE physics->jph_physics_system_class;
+
+  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_broad_phase_layer_interface_class, _crude_jph_bp_layer_interface_class );
+  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_object_vs_broadphase_layer_filter_class, _crude_jph_object_vs_broad_phase_layer_filter );
+  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_object_vs_object_layer_filter_class, _crude_jph_object_layer_pair_filter_class );
+  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_body_activation_listener_class, _crude_jph_body_activation_listener_class );
+  CRUDE_DEALLOCATE_AND_DECONSTRUCT( physics->physics_allocator_container, physics->jph_contact_listener_class, _crude_jph_contact_listener_class );
+  
+  crude_resource_pool_deinitialize( &physics->characters_resource_pool );
+  crude_resource_pool_deinitialize( &physics->static_body_resource_pool );
+  crude_resource_pool_deinitialize( &physics->kinematic_body_resource_pool );
+
+  CRUDE_ARRAY_DEINITIALIZE( physics->batch_added_static_bodies );
+  CRUDE_ARRAY_DEINITIALIZE( physics->batch_added_kinematic_bodies );
+  CRUDE_ARRAY_DEINITIALIZE( physics->batch_removed_bodies );
+  CRUDE_ARRAY_DEINITIALIZE( physics->batch_destroyed_bodies );
+  CRUDE_ARRAY_DEINITIALIZE( physics->batch_bodies );
+
+  CRUDE_ARRAY_DEINITIALIZE( physics->sync_characters );
+  CRUDE_ARRAY_DEINITIALIZE( physics->sync_static_bodies );
+  CRUDE_ARRAY_DEINITIALIZE( physics->sync_kinematic_bodies );
+}
+
+void
+crude_physics_update
+(
+  _In_ crude_physics                                      *physics,
+  _In_ int64                                               current_time
+)
+{
+  crude_physics_telemetry                                 *telemetry;
+  int64                                                    phases_time[ CRUDE_PHYSICS_STEP_PHASE_COUNT ];
+  int64                                                    contact_callbacks_time;
+  int64                                                    update_start_time;
+  float32                                                  max_accumulated_time;
+
+  physics->last_update_steps_count = 0u;
+
+  telemetry = &physics->telemetry;
+  telemetry->steps_count = 0u;
+  telemetry->max_step_time = 0.f;
+  telemetry->update_time = 0.f;
+  telemetry->broad_phase_time = 0.f;
+  telemetry->narrow_phase_time = 0.f;
+  telemetry->solver_time = 0.f;
+  telemetry->callbacks_time = 0.f;
+  telemetry->other_jobs_time = 0.f;
+  telemetry->contacts_count = 0u;
+  telemetry->update_errors = 0u;
+
+  /* Events which weren't dispatched since the last update are dropped */
+  for ( uint32 i = 0; i < physics->contact_events_buffers_count; ++i )
+  {
+    physics->contact_events_buffers[ i ].events_count = 0u;
+    physics->contact_events_buffers[ i ].contact_callbacks_time = 0;
+  }
+
+  if ( !physics->simulation_enabled )
+  {
+    physics->last_update_time = current_time;
+    physics->accumulated_time = 0.f;
+    return;
+  }
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_update" );
+  update_start_time = crude_time_now( );
+
+  physics->accumulated_time += crude_time_delta_seconds( physics->last_update_time, current_time );
+  physics->last_update_time = current_time;
+
+  max_accumulated_time = physics->max_steps_per_update * physics->step_delta_time;
+  if ( physics->accumulated_time > max_accumulated_time )
+  {
+    physics->accumulated_time = max_accumulated_time;
+  }
+
+  while ( physics->accumulated_time >= physics->step_delta_time )
+  {
+    JPH::EPhysicsUpdateError                               jph_update_error;
+    int64                                                  step_start_time;
+    uint32                                                 new_update_errors;
+    uint32                                                 step_contacts_count;
+
+    CRUDE_PROFILER_ZONE_NAME( "crude_physics_step" );
+    step_start_time = crude_time_now( );
+    crude_physics_update_virtual_characters_( physics, physics->step_delta_time );
+    /* Blocks on the job system barrier till all step jobs are done */
+    jph_update_error = physics->jph_physics_system_class->Update( physics->step_delta_time, physics->collision_steps, physics->jph_temporary_allocator_class, physics->jph_job_system_class );
+    CRUDE_PROFILER_ZONE_END;
+    telemetry->max_step_time = CRUDE_MAX( telemetry->max_step_time, 1000.f * crude_time_delta_seconds( step_start_time, crude_time_now( ) ) );
+    telemetry->update_errors |= CRUDE_CAST( uint32, jph_update_error );
+
+    step_contacts_count = 0u;
+    for ( uint32 i = 0; i < physics->contact_events_buffers_count; ++i )
+    {
+      step_contacts_count += physics->contact_events_buffers[ i ].contacts_count;
+      physics->contact_events_buffers[ i ].contacts_count = 0u;
+    }
+    telemetry->contacts_count = CRUDE_MAX( telemetry->contacts_count, step_contacts_count );
+    crude_physics_check_contacts_capacity_( physics, step_contacts_count );
+    
+    new_update_errors = CRUDE_CAST( uint32, jph_update_error ) & ~physics->update_errors_warned;
+    if ( new_update_errors )
+    {
+      physics->update_errors_warned |= new_update_errors;
+      if ( new_update_errors & CRUDE_CAST( uint32, JPH::EPhysicsUpdateError::BodyPairCacheFull ) )
+      {
+        CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "Body pairs limit (%u) is reached, some contacts are ignored. Increase \"max_body_pairs\" in environment", physics->max_body_pairs );
+      }
+      if ( new_update_errors & CRUDE_CAST( uint32, JPH::EPhysicsUpdateError::ManifoldCacheFull | JPH::EPhysicsUpdateError::ContactConstraintsFull ) )
+      {
+        CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "Contact constraints limit (%u) is reached, some contacts are ignored. Increase \"max_contact_constraints\" in environment", physics->max_contact_constraints );
+      }
+    }
+
+    physics->accumulated_time -= physics->step_delta_time;
+    ++physics->last_update_steps_count;
+  }
+
+  physics->interpolation_alpha = physics->accumulated_time / physics->step_delta_time;
+
+  if ( physics->last_update_steps_count )
+  {
+    crude_physics_update_sync_lists_( physics );
+  }
+
+  physics->jph_job_system_class->consume_phases_time( phases_time );
+  contact_callbacks_time = 0;
+  for ( uint32 i = 0; i < physics->contact_events_buffers_count; ++i )
+  {
+    contact_callbacks_time += physics->contact_events_buffers[ i ].contact_callbacks_time;
+  }
+
+  /* Contact listener runs inside narrow phase jobs */
+  telemetry->broad_phase_time = 1000.f * crude_time_seconds( phases_time[ CRUDE_PHYSICS_STEP_PHASE_BROAD_PHASE ] );
+  telemetry->narrow_phase_time = 1000.f * crude_time_seconds( CRUDE_MAX_INT( 0, phases_time[ CRUDE_PHYSICS_STEP_PHASE_NARROW_PHASE ] - contact_callbacks_time ) );
+  telemetry->solver_time = 1000.f * crude_time_seconds( phases_time[ CRUDE_PHYSICS_STEP_PHASE_SOLVER ] );
+  telemetry->callbacks_time = 1000.f * crude_time_seconds( phases_time[ CRUDE_PHYSICS_STEP_PHASE_CALLBACKS ] + contact_callbacks_time );
+  telemetry->other_jobs_time = 1000.f * crude_time_seconds( phases_time[ CRUDE_PHYSICS_STEP_PHASE_OTHER ] );
+  telemetry->update_time = 1000.f * crude_time_delta_seconds( update_start_time, crude_time_now( ) );
+  telemetry->steps_count = physics->last_update_steps_count;
+  telemetry->collision_steps = physics->collision_steps;
+  telemetry->bodies_count = physics->jph_physics_system_class->GetNumBodies( );
+  telemetry->active_bodies_count = physics->jph_physics_system_class->GetNumActiveBodies( JPH::EBodyType::RigidBody );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_reset_time
+(
+  _In_ crude_physics                                      *physics,
+  _In_ int64                                               current_time
+)
+{
+  physics->last_update_time = current_time;
+  physics->accumulated_time = 0.f;
+  physics->interpolation_alpha = 0.f;
+}
+
+void
+crude_physics_set_step_delta_time
+(
+  _In_ crude_physics                                      *physics,
+  _In_ float32                                             step_delta_time
+)
+{
+  CRUDE_ASSERT( step_delta_time > 0.f );
+  physics->step_delta_time = step_delta_time;
+  physics->collision_steps = CRUDE_CAST( uint32, CRUDE_MAX( 1.f, ceilf( step_delta_time / CRUDE_PHYSICS_JOLT_COLLISIONS_STEPS_DELTA_TIME - 0.001f ) ) );
+  physics->accumulated_time = 0.f;
+}
+
+void
+crude_physics_begin_bodies_batch
+(
+  _In_ crude_physics                                      *physics
+)
+{
+  ++physics->bodies_batch_depth;
+}
+
+void
+crude_physics_end_bodies_batch
+(
+  _In_ crude_physics                                      *physics
+)
+{
+  JPH::BodyInterface                                      *jph_body_interface_class;
+  uint32                                                   added_bodies_count;
+
+  CRUDE_ASSERT( physics->bodies_batch_depth );
+  if ( --physics->bodies_batch_depth )
+  {
+    return;
+  }
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_end_bodies_batch" );
+
+  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
+
+  if ( CRUDE_ARRAY_LENGTH( physics->batch_removed_bodies ) )
+  {
+    jph_body_interface_class->RemoveBodies( physics->batch_removed_bodies, CRUDE_ARRAY_LENGTH( physics->batch_removed_bodies ) );
+  }
+  if ( CRUDE_ARRAY_LENGTH( physics->batch_destroyed_bodies ) )
+  {
+    jph_body_interface_class->DestroyBodies( physics->batch_destroyed_bodies, CRUDE_ARRAY_LENGTH( physics->batch_destroyed_bodies ) );
+  }
+
+  added_bodies_count = 0u;
+
+  CRUDE_ARRAY_SET_LENGTH( physics->batch_bodies, 0u );
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( physics->batch_added_static_bodies ); ++i )
+  {
+    crude_physics_static_body_container                   *static_body_container;
+
+    if ( physics->batch_added_static_bodies[ i ] == CRUDE_RESOURCE_INDEX_INVALID )
+    {
+      continue;
+    }
+
+    static_body_container = crude_physics_access_static_body( physics, CRUDE_COMPOUNT( crude_physics_static_body_handle, { physics->batch_added_static_bodies[ i ] } ) );
+    static_body_container->batch_index = -1;
+    CRUDE_ARRAY_PUSH( physics->batch_bodies, static_body_container->jph_body_class );
+  }
+  added_bodies_count += CRUDE_ARRAY_LENGTH( physics->batch_bodies );
+  crude_physics_commit_batch_bodies_( physics, JPH::EActivation::DontActivate );
+
+  CRUDE_ARRAY_SET_LENGTH( physics->batch_bodies, 0u );
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( physics->batch_added_kinematic_bodies ); ++i )
+  {
+    crude_physics_kinematic_body_container                *kinematic_body_container;
+
+    if ( physics->batch_added_kinematic_bodies[ i ] == CRUDE_RESOURCE_INDEX_INVALID )
+    {
+      continue;
+    }
+
+    kinematic_body_container = crude_physics_access_kinematic_body( physics, CRUDE_COMPOUNT( crude_physics_kinematic_body_handle, { physics->batch_added_kinematic_bodies[ i ] } ) );
+    kinematic_body_container->batch_index = -1;
+    CRUDE_ARRAY_PUSH( physics->batch_bodies, kinematic_body_container->jph_body_class );
+  }
+  added_bodies_count += CRUDE_ARRAY_LENGTH( physics->batch_bodies );
+  crude_physics_commit_batch_bodies_( physics, JPH::EActivation::Activate );
+
+  physics->unoptimized_bodies_count += added_bodies_count;
+
+  CRUDE_ARRAY_SET_LENGTH( physics->batch_added_static_bodies, 0u );
+  CRUDE_ARRAY_SET_LENGTH( physics->batch_added_kinematic_bodies, 0u );
+  CRUDE_ARRAY_SET_LENGTH( physics->batch_removed_bodies, 0u );
+  CRUDE_ARRAY_SET_LENGTH( physics->batch_destroyed_bodies, 0u );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_optimize_broad_phase
+(
+  _In_ crude_physics                                      *physics
+)
+{
+  /* Bodies added one by one leave the broad phase tree unbalanced */
+  if ( physics->unoptimized_bodies_count < CRUDE_PHYSICS_OPTIMIZE_BROAD_PHASE_BODIES_COUNT )
+  {
+    return;
+  }
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_optimize_broad_phase" );
+  physics->jph_physics_system_class->OptimizeBroadPhase( );
+  physics->unoptimized_bodies_count = 0u;
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_enable_simulation
+(
+  _In_ crude_physics                                      *physics,
+  _In_ ecs_world_t                                        *world,
+  _In_ bool                                                enable
+)
+{
+  physics->simulation_enabled = enable;
+  crude_entity_enable( world, crude_ecs_on_pre_physics_update, enable );
+  crude_entity_enable( world, crude_ecs_on_post_physics_update, enable );
+}
+
+crude_physics_character_creation
+crude_physics_character_creation_empty
+(
+)
+{
+  crude_physics_character_creation creation = CRUDE_COMPOUNT_EMPTY( crude_physics_character_creation );
+  return creation;
+}
+
+crude_physics_static_body_creation
+crude_physics_static_body_creation_empty
+(
+)
+{
+  crude_physics_static_body_creation creation = CRUDE_COMPOUNT_EMPTY( crude_physics_static_body_creation );
+  return creation;
+}
+
+crude_physics_kinematic_body_creation
+crude_physics_kinematic_body_creation_empty
+(
+)
+{
+  crude_physics_kinematic_body_creation creation = CRUDE_COMPOUNT_EMPTY( crude_physics_kinematic_body_creation );
+  return creation;
+}
+
+crude_physics_character_handle
+crude_physics_create_character
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_character_creation const             *creation
+)
+{
+  crude_physics_character_container                       *character_container;
+  crude_physics_character_handle                           handle;
+  JPH::Ref< JPH::CharacterSettings >                       jph_settings_class;
+  JPH::Ref< JPH::CharacterVirtualSettings >                jph_virtual_settings_class;
+  JPH::RefConst< JPH::Shape >                              jph_standing_shape;
+    
+  jph_standing_shape = JPH::RotatedTranslatedShapeSettings(
+    JPH::Vec3( 0, 0.5f * creation->character_height_standing + creation->character_radius_standing, 0 ),
+    JPH::Quat::sIdentity( ),
+    CRUDE_JOLT_OVERRIDEN_NEW JPH::CapsuleShape( 0.5f * creation->character_height_standing, creation->character_radius_standing )
+  ).Create( ).Get( );
+    
+  handle.index = crude_physics_obtain_resource_( physics, &physics->characters_resource_pool, "characters" );
+
+  character_container = crude_physics_access_character( physics, handle );
+  CRUDE_CXX_CONSTRUCTOR( &character_container->jph_character_class, JPH::Ref< JPH::Character > );
+  CRUDE_CXX_CONSTRUCTOR( &character_container->jph_character_virtual_class, JPH::Ref< JPH::CharacterVirtual > );
+  character_container->active = false;
+  character_container->inactive_synced = false;
+  character_container->entity = creation->entity;
+  character_container->layers = creation->layers;
+  character_container->virtual_enabled = false;
+
+  if ( creation->virtual_character )
+  {
+    jph_virtual_settings_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::CharacterVirtualSettings( );
+    jph_virtual_settings_class->mMaxSlopeAngle = creation->max_slop_angle;
+    jph_virtual_settings_class->mShape = jph_standing_shape;
+    jph_virtual_settings_class->mSupportingVolume = JPH::Plane( JPH::Vec3::sAxisY( ), -creation->character_radius_standing );
+    /* Kinematic inner body makes the character visible to bodies, queries and sensors, it shares the character user data */
+    jph_virtual_settings_class->mInnerBodyShape = jph_standing_shape;
+    jph_virtual_settings_class->mInnerBodyLayer = creation->layers;
+
+    character_container->jph_character_virtual_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::CharacterVirtual(
+      jph_virtual_settings_class,
+      JPH::RVec3::sZero( ),
+      JPH::Quat::sIdentity( ),
+      CRUDE_PHYSICS_BODY_USER_DATA( CRUDE_PHYSICS_BODY_USER_DATA_TYPE_CHARACTER, handle.index ),
+      physics->jph_physics_system_class );
+
+    character_container->jph_character_virtual_class->SetCharacterVsCharacterCollision( physics->jph_character_vs_character_collision_class );
+    physics->jph_character_vs_character_collision_class->Add( character_container->jph_character_virtual_class );
+    character_container->virtual_enabled = true;
+
+    /* There is no body to fall asleep, virtual character is moved every step */
+    character_container->active = true;
+  }
+  else
+  {
+    jph_settings_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::CharacterSettings( );
+    jph_settings_class->mMaxSlopeAngle = creation->max_slop_angle;
+    jph_settings_class->mLayer = creation->layers;
+    jph_settings_class->mShape = jph_standing_shape;
+    jph_settings_class->mFriction = creation->friction;
+    jph_settings_class->mSupportingVolume = JPH::Plane( JPH::Vec3::sAxisY( ), -creation->character_radius_standing );
+
+    character_container->jph_character_class = CRUDE_JOLT_OVERRIDEN_NEW JPH::Character(
+      jph_settings_class,
+      JPH::RVec3::sZero( ),
+      JPH::Quat::sIdentity( ),
+      CRUDE_PHYSICS_BODY_USER_DATA( CRUDE_PHYSICS_BODY_USER_DATA_TYPE_CHARACTER, handle.index ),
+      physics->jph_physics_system_class );
+  
+    character_container->jph_character_class->AddToPhysicsSystem( JPH::EActivation::Activate );
+  }
+  
+  CRUDE_CXX_CONSTRUCTOR( &character_container->manually_stored_transform, JPH::Mat44 );
+  crude_physics_sync_list_add_( &physics->sync_characters, handle.index );
+
+  character_container->previous_translation = character_container->current_translation = character_container->interpolation_offset_translation = XMFLOAT3{ 0.f, 0.f, 0.f };
+  character_container->previous_rotation = character_container->current_rotation = character_container->interpolation_offset_rotation = XMFLOAT4{ 0.f, 0.f, 0.f, 1.f };
+
+  return handle;
+}
+
+crude_physics_character_container*
+crude_physics_access_character
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_character_handle                      handle
+)
+{
+  return CRUDE_CAST( crude_physics_character_container*, crude_resource_pool_access_resource( &physics->characters_resource_pool, handle.index ) );
+}
+
+CRUDE_API void
+crude_physics_destroy_character_instant
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_character_handle                      handle
+)
+{
+  crude_physics_character_container                       *character_container;
+
+  character_container = crude_physics_access_character( physics, handle );
+
+  if ( character_container->jph_character_virtual_class )
+  {
+    if ( character_container->virtual_enabled )
+    {
+      physics->jph_character_vs_character_collision_class->Remove( character_container->jph_character_virtual_class );
+    }
+  }
+  else if ( physics->jph_physics_system_class->GetBodyInterface( ).IsAdded( character_container->jph_character_class->GetBodyID( ) ) )
+  {
+    character_container->jph_character_class->RemoveFromPhysicsSystem( );
+  }
+
+  character_container->jph_character_class.~Ref( );
+  character_container->jph_character_virtual_class.~Ref( );
+
+  crude_physics_sync_list_remove_( physics->sync_characters, handle.index );
+  crude_resource_pool_release_resource( &physics->characters_resource_pool, handle.index );
+}
+
+
+void
+crude_physics_enable_character
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_character_handle                      handle,
+  _In_ bool                                                enable
+)
+{
+  crude_physics_character_container                       *character_container;
+  JPH::BodyID                                              jph_inner_body_id;
+  bool                                                     added;
+
+  character_container = crude_physics_access_character( physics, handle );
+
+  if ( enable )
+  {
+    character_container->inactive_synced = false;
+    crude_physics_sync_list_add_( &physics->sync_characters, handle.index );
+  }
+  else
+  {
+    crude_physics_sync_list_remove_( physics->sync_characters, handle.index );
+  }
+
+  /* Disabled virtual character isn't updated and others don't collide with it */
+  if ( character_container->jph_character_virtual_class )
+  {
+    jph_inner_body_id = character_container->jph_character_virtual_class->GetInnerBodyID( );
+    if ( enable && !character_container->virtual_enabled )
+    {
+      physics->jph_character_vs_character_collision_class->Add( character_container->jph_character_virtual_class );
+      if ( !jph_inner_body_id.IsInvalid( ) )
+      {
+        physics->jph_physics_system_class->GetBodyInterface( ).AddBody( jph_inner_body_id, JPH::EActivation::Activate );
+      }
+    }
+    else if ( !enable && character_container->virtual_enabled )
+    {
+      physics->jph_character_vs_character_collision_class->Remove( character_container->jph_character_virtual_class );
+      /* Destructor of JPH::CharacterVirtual skips removing the inner body when it isn't added */
+      if ( !jph_inner_body_id.IsInvalid( ) )
+      {
+        physics->jph_physics_system_class->GetBodyInterface( ).RemoveBody( jph_inner_body_id );
+      }
+    }
+    character_container->virtual_enabled = enable;
+    return;
+  }
+
+  added = physics->jph_physics_system_class->GetBodyInterface( ).IsAdded( character_container->jph_character_class->GetBodyID( ) );
+
+  if ( enable && !added )
+  {
+    character_container->jph_character_class->AddToPhysicsSystem( JPH::EActivation::Activate );
+  }
+  else if ( !enable && added )
+  {
+    character_container->jph_character_class->RemoveFromPhysicsSystem( );
+  }
+}
+
+XMVECTOR
+crude_physics_character_get_linear_velocity
+(
+  _In_ crude_physics_character_container const           *character_container
+)
+{
+  if ( character_container->jph_character_virtual_class )
+  {
+    return crude_jph_vec3_to_vector( character_container->jph_character_virtual_class->GetLinearVelocity( ) );
+  }
+  return crude_jph_vec3_to_vector( character_container->jph_character_class->GetLinearVelocity( ) );
+}
+
+void
+crude_physics_character_set_linear_velocity
+(
+  _In_ crude_physics_character_container                  *character_container,
+  _In_ XMVECTOR                                            velocity
+)
+{
+  if ( character_container->jph_character_virtual_class )
+  {
+    character_container->jph_character_virtual_class->SetLinearVelocity( crude_vector_to_jph_vec3( velocity ) );
+  }
+  else
+  {
+    character_container->jph_character_class->SetLinearVelocity( crude_vector_to_jph_vec3( velocity ) );
+  }
+}
+
+JPH::RMat44
+crude_physics_character_get_world_transform
+(
+  _In_ crude_physics_character_container const           *character_container
+)
+{
+  if ( character_container->jph_character_virtual_class )
+  {
+    return character_container->jph_character_virtual_class->GetWorldTransform( );
+  }
+  return character_container->jph_character_class->GetWorldTransform( );
+}
+
+void
+crude_physics_character_set_position_and_rotation
+(
+  _In_ crude_physics_character_container                  *character_container,
+  _In_ XMVECTOR                                            translation,
+  _In_ XMVECTOR                                            rotation
+)
+{
+  if ( character_container->jph_character_virtual_class )
+  {
+    character_container->jph_character_virtual_class->SetPosition( crude_vector_to_jph_vec3( translation ) );
+    character_container->jph_character_virtual_class->SetRotation( crude_vector_to_jph_quat( rotation ) );
+  }
+  else
+  {
+    character_container->jph_character_class->SetPositionAndRotation( crude_vector_to_jph_vec3( translation ), crude_vector_to_jph_quat( rotation ) );
+  }
+}
+
+crude_physics_static_body_handle
+crude_physics_create_static_body
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_static_body_creation const           *creation
+)
+{
+  crude_physics_static_body_container                     *static_body_container;
+  JPH::BodyInterface                                      *jph_body_interface_class;
+  JPH::ShapeSettings::ShapeResult                          jph_shape_result_class;
+  JPH::ShapeRefC                                           jph_shape_class;
+  JPH::BodyCreationSettings                                jph_settings_class;
+  JPH::Body                                               *jph_body_class;
+  crude_physics_static_body_handle                         handle;
+    
+  handle.index = crude_physics_obtain_resource_( physics, &physics->static_body_resource_pool, "static bodies" );
+
+  static_body_container = crude_physics_access_static_body( physics, handle );
+
+  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
+  
+  if ( creation->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_BOX )
+  {
+    JPH::BoxShapeSettings                                    jph_shape_settings_class;
+    jph_shape_settings_class = CRUDE_COMPOUNT( JPH::BoxShapeSettings, { JPH::Vec3( creation->box.extent.x, creation->box.extent.y, creation->box.extent.z ) } );
+    jph_shape_settings_class.SetEmbedded( );
+    jph_shape_result_class = jph_shape_settings_class.Create( );
+    jph_shape_class = jph_shape_result_class.Get( );
+  }
+  else if ( creation->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH )
+  {
+    jph_shape_class = crude_physics_shapes_manager_access_mesh_shape( physics->physics_shapes_manager, creation->mesh.handle )->jph_shape_class;
+  }
+
+  jph_settings_class = JPH::BodyCreationSettings( jph_shape_class, JPH::RVec3( 0.0, 0.0, 0.0 ), JPH::Quat::sIdentity( ), JPH::EMotionType::Static, creation->layers );
+  jph_settings_class.mUserData = CRUDE_PHYSICS_BODY_USER_DATA( CRUDE_PHYSICS_BODY_USER_DATA_TYPE_STATIC_BODY, handle.index );
+
+  jph_body_class = jph_body_interface_class->CreateBody( jph_settings_class );
+  if ( !jph_body_class )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_PHYSICS, "Cannot create static body, bodies limit (%u) is reached. Increase \"max_bodies\" in environment", physics->max_bodies );
+    crude_resource_pool_release_resource( &physics->static_body_resource_pool, handle.index );
+    handle.index = CRUDE_RESOURCE_INDEX_INVALID;
+    return handle;
+  }
+
+  CRUDE_CXX_CONSTRUCTOR( &static_body_container->jph_body_class, JPH::BodyID, jph_body_class->GetID( ) );
+  crude_physics_add_body_( physics, static_body_container->jph_body_class, handle.index, &static_body_container->batch_index, &physics->batch_added_static_bodies, JPH::EActivation::DontActivate );
+  
+  static_body_container->entity = creation->entity;
+  static_body_container->pose_synced = false;
+  crude_physics_sync_list_add_( &physics->sync_static_bodies, handle.index );
+
+  crude_physics_check_bodies_capacity_( physics );
+  return handle;
+}
+
+crude_physics_static_body_container*
+crude_physics_access_static_body
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_static_body_handle                    handle
+)
+{ 
+  return CRUDE_CAST( crude_physics_static_body_container*, crude_resource_pool_access_resource( &physics->static_body_resource_pool, handle.index ) );
+}
+
+void
+crude_physics_destroy_static_body_instant
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_static_body_handle                    handle
+)
+{
+  crude_physics_static_body_container                     *static_body_container;
+
+  static_body_container = crude_physics_access_static_body( physics, handle );
+  crude_physics_destroy_body_( physics, static_body_container->jph_body_class, &static_body_container->batch_index, physics->batch_added_static_bodies );
+
+  crude_physics_sync_list_remove_( physics->sync_static_bodies, handle.index );
+  crude_resource_pool_release_resource( &physics->static_body_resource_pool, handle.index );
+}
+
+void
+crude_physics_enable_static_body
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_static_body_handle                    handle,
+  _In_ bool                                                enable
+)
+{
+  crude_physics_static_body_container                     *static_body_container;
+  bool                                                     added;
+
+  static_body_container = crude_physics_access_static_body( physics, handle );
+  added = crude_physics_body_added_( static_body_container->batch_index );
+
+  if ( enable && !added )
+  {
+    crude_physics_add_body_( physics, static_body_container->jph_body_class, handle.index, &static_body_container->batch_index, &physics->batch_added_static_bodies, JPH::EActivation::DontActivate );
+    crude_physics_sync_list_add_( &physics->sync_static_bodies, handle.index );
+  }
+  else if ( !enable && added )
+  {
+    crude_physics_remove_body_( physics, static_body_container->jph_body_class, &static_body_container->batch_index, physics->batch_added_static_bodies );
+    crude_physics_sync_list_remove_( physics->sync_static_bodies, handle.index );
+  }
+}
+
+crude_physics_kinematic_body_handle
+crude_physics_create_kinematic_body
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_kinematic_body_creation const        *creation
+)
+{
+  crude_physics_kinematic_body_container                  *kinematic_body_container;
+  JPH::BodyInterface                                      *jph_body_interface_class;
+  JPH::ShapeSettings::ShapeResult                          jph_shape_result_class;
+  JPH::ShapeRefC                                           jph_shape_class;
+  JPH::BodyCreationSettings                                jph_settings_class;
+  JPH::Body                                               *jph_body_class;
+  crude_physics_kinematic_body_handle                      handle;
+    
+  handle.index = crude_physics_obtain_resource_( physics, &physics->kinematic_body_resource_pool, "kinematic bodies" );
+
+  kinematic_body_container = crude_physics_access_kinematic_body( physics, handle );
+
+  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
+  
+  if ( creation->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_BOX )
+  {
+    JPH::BoxShapeSettings                                    jph_shape_settings_class;
+    jph_shape_settings_class = CRUDE_COMPOUNT( JPH::BoxShapeSettings, { JPH::Vec3( creation->box.extent.x, creation->box.extent.y, creation->box.extent.z ) } );
+    jph_shape_settings_class.SetEmbedded( );
+    jph_shape_result_class = jph_shape_settings_class.Create( );
+    jph_shape_class = jph_shape_result_class.Get( );
+  }
+  else if ( creation->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH )
+  {
+    jph_shape_class = crude_physics_shapes_manager_access_mesh_shape( physics->physics_shapes_manager, creation->mesh.handle )->jph_shape_class;
+  }
+
+  jph_settings_class = JPH::BodyCreationSettings( jph_shape_class, JPH::RVec3( 0.0, 0.0, 0.0 ), JPH::Quat::sIdentity( ), JPH::EMotionType::Kinematic, creation->layers );
+  jph_settings_class.mUserData = CRUDE_PHYSICS_BODY_USER_DATA( CRUDE_PHYSICS_BODY_USER_DATA_TYPE_KINEMATIC_BODY, handle.index );
+
+  if ( creation->sensor )
+  {
+    jph_settings_class.mIsSensor = true;
+    jph_settings_class.mCollideKinematicVsNonDynamic = true;
+  }
+
+  jph_body_class = jph_body_interface_class->CreateBody( jph_settings_class );
+  if ( !jph_body_class )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_PHYSICS, "Cannot create kinematic body, bodies limit (%u) is reached. Increase \"max_bodies\" in environment", physics->max_bodies );
+    crude_resource_pool_release_resource( &physics->kinematic_body_resource_pool, handle.index );
+    handle.index = CRUDE_RESOURCE_INDEX_INVALID;
+    return handle;
+  }
+
+  CRUDE_CXX_CONSTRUCTOR( &kinematic_body_container->jph_body_class, JPH::BodyID, jph_body_class->GetID( ) );
+  crude_physics_add_body_( physics, kinematic_body_container->jph_body_class, handle.index, &kinematic_body_container->batch_index, &physics->batch_added_kinematic_bodies, JPH::EActivation::Activate );
+  
+  kinematic_body_container->entity = creation->entity;
+  kinematic_body_container->contact_added_callback = NULL;
+  kinematic_body_container->pose_synced = false;
+  crude_physics_sync_list_add_( &physics->sync_kinematic_bodies, handle.index );
+
+  crude_physics_check_bodies_capacity_( physics );
+  return handle;
+}
+
+crude_physics_kinematic_body_container*
+crude_physics_access_kinematic_body
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_kinematic_body_handle                 handle
+)
+{
+  return CRUDE_CAST( crude_physics_kinematic_body_container*, crude_resource_pool_access_resource( &physics->kinematic_body_resource_pool, handle.index ) );
+}
+
+void
+crude_physics_destroy_kinematic_body_instant
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_kinematic_body_handle                 handle
+)
+{
+  crude_physics_kinematic_body_container                  *kinematic_body_container;
+
+  kinematic_body_container = crude_physics_access_kinematic_body( physics, handle );
+  crude_physics_destroy_body_( physics, kinematic_body_container->jph_body_class, &kinematic_body_container->batch_index, physics->batch_added_kinematic_bodies );
+
+  crude_physics_sync_list_remove_( physics->sync_kinematic_bodies, handle.index );
+
+  /* Contact events of this step could still point to the slot, see crude_physics_dispatch_contact_events */
+  kinematic_body_container->entity = 0;
+  kinematic_body_container->contact_added_callback = NULL;
+  crude_resource_pool_release_resource( &physics->kinematic_body_resource_pool, handle.index );
+}
+
+void
+crude_physics_enable_kinematic_body
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_kinematic_body_handle                 handle,
+  _In_ bool                                                enable
+)
+{
+  crude_physics_kinematic_body_container                  *kinematic_body_container;
+  bool                                                     added;
+
+  kinematic_body_container = crude_physics_access_kinematic_body( physics, handle );
+  added = crude_physics_body_added_( kinematic_body_container->batch_index );
+
+  if ( enable && !added )
+  {
+    crude_physics_add_body_( physics, kinematic_body_container->jph_body_class, handle.index, &kinematic_body_container->batch_index, &physics->batch_added_kinematic_bodies, JPH::EActivation::Activate );
+    crude_physics_sync_list_add_( &physics->sync_kinematic_bodies, handle.index );
+  }
+  else if ( !enable && added )
+  {
+    crude_physics_remove_body_( physics, kinematic_body_container->jph_body_class, &kinematic_body_container->batch_index, physics->batch_added_kinematic_bodies );
+    crude_physics_sync_list_remove_( physics->sync_kinematic_bodies, handle.index );
+  }
+}
+
+bool
+crude_physics_ray_cast
+(
+  _In_ crude_physics                                      *physics,
+  _In_ ecs_world_t                                        *world,
+  _In_ XMVECTOR                                            origin,
+  _In_ XMVECTOR                                            direction,
+  _In_ uint8                                               broad_phase_mask,
+  _In_ uint32                                              layer_mask,
+  _Out_ crude_ray_cast_result                             *ray_cast_result
+)
+{
+  _crude_jph_ray_cast_broad_phase_layer_filter_class       jph_broad_phase_layer_filter_class;
+  _crude_jph_ray_cast_object_layer_filter_class            jph_object_layer_filter_class;
+
+  jph_broad_phase_layer_filter_class.mask = broad_phase_mask;
+  jph_object_layer_filter_class.mask = layer_mask;
+  return crude_physics_ray_cast_( physics, origin, direction, &jph_broad_phase_layer_filter_class, &jph_object_layer_filter_class, ray_cast_result );
+}
+
+void
+crude_physics_ray_cast_batch
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_ray_cast_query const                 *queries,
+  _In_ uint32                                              queries_count,
+  _Out_ crude_physics_ray_cast_batch_result               *results
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_ray_cast_batch" );
+  crude_physics_ray_cast_task_start( &physics->ray_cast_task, queries, queries_count, results );
+  crude_physics_ray_cast_task_wait( &physics->ray_cast_task );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_ray_cast_task_initialize
+(
+  _In_ crude_physics_ray_cast_task                        *task,
+  _In_ crude_physics                                      *physics
+)
+{
+  *task = CRUDE_COMPOUNT_EMPTY( crude_physics_ray_cast_task );
+  task->physics = physics;
+  task->enki_task_set = enkiCreateTaskSet( physics->task_sheduler->enki_task_sheduler, crude_physics_ray_cast_task_execute_ );
+}
+
+void
+crude_physics_ray_cast_task_deinitialize
+(
+  _In_ crude_physics_ray_cast_task                        *task
+)
+{
+  crude_physics_ray_cast_task_wait( task );
+  enkiDeleteTaskSet( task->physics->task_sheduler->enki_task_sheduler, task->enki_task_set );
+}
+
+void
+crude_physics_ray_cast_task_start
+(
+  _In_ crude_physics_ray_cast_task                        *task,
+  _In_ crude_physics_ray_cast_query const                 *queries,
+  _In_ uint32                                              queries_count,
+  _Out_ crude_physics_ray_cast_batch_result               *results
+)
+{
+  enkiParamsTaskSet                                        enki_params;
+
+  CRUDE_ASSERTM( CRUDE_CHANNEL_PHYSICS, enkiIsTaskSetComplete( task->physics->task_sheduler->enki_task_sheduler, task->enki_task_set ), "Ray cast task is started before the previous one was waited" );
+
+  task->queries = queries;
+  task->results = results;
+  task->queries_count = queries_count;
+
+  if ( queries_count == 0 )
+  {
+    return;
+  }
+
+  task->in_flight = true;
+  ++task->physics->ray_cast_tasks_in_flight_count;
+
+  enki_params = enkiGetParamsTaskSet( task->enki_task_set );
+  enki_params.pArgs = task;
+  enki_params.setSize = queries_count;
+  enki_params.minRange = CRUDE_PHYSICS_RAY_CAST_BATCH_MIN_RANGE;
+  enkiSetParamsTaskSet( task->enki_task_set, enki_params );
+  enkiAddTaskSet( task->physics->task_sheduler->enki_task_sheduler, task->enki_task_set );
+}
+
+void
+crude_physics_ray_cast_task_wait
+(
+  _In_ crude_physics_ray_cast_task                        *task
+)
+{
+  enkiWaitForTaskSet( task->physics->task_sheduler->enki_task_sheduler, task->enki_task_set );
+
+  if ( task->in_flight )
+  {
+    task->in_flight = false;
+    --task->physics->ray_cast_tasks_in_flight_count;
+  }
+}
+
+void
+crude_physics_dispatch_contact_events
+(
+  _In_ crude_physics                                      *physics
+)
+{
+  int64                                                    dispatch_start_time;
+  uint32                                                   dropped_events_count;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_dispatch_contact_events" );
+  dispatch_start_time = crude_time_now( );
+  dropped_events_count = 0u;
+  physics->telemetry.contact_events_count = 0u;
+  for ( uint32 buffer_index = 0; buffer_index < physics->contact_events_buffers_count; ++buffer_index )
+  {
+    crude_physics_contact_events_buffer                   *events_buffer;
+
+    events_buffer = &physics->contact_events_buffers[ buffer_index ];
+    for ( uint32 event_index = 0; event_index < events_buffer->events_count; ++event_index )
+    {
+      crude_physics_contact_event const                   *event;
+      crude_physics_kinematic_body_container              *kinematic_body;
+
+      event = &events_buffer->events[ event_index ];
+
+      /* Body could be destroyed after the step, even by an earlier callback of this dispatch, then the slot is cleared or reused */
+      kinematic_body = crude_physics_access_kinematic_body( physics, event->kinematic_body_handle );
+      if ( !kinematic_body->contact_added_callback || kinematic_body->entity != event->signal_entity )
+      {
+        continue;
+      }
+
+      kinematic_body->contact_added_callback( event->signal_entity, event->hitted_entity );
+    }
+
+    physics->telemetry.contact_events_count += events_buffer->events_count;
+    events_buffer->events_count = 0u;
+    dropped_events_count += events_buffer->dropped_events_count;
+    events_buffer->dropped_events_count = 0u;
+  }
+
+  if ( dropped_events_count && !physics->contact_events_overflow_warned )
+  {
+    physics->contact_events_overflow_warned = true;
+    CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "%u contact events were dropped, increase CRUDE_PHYSICS_CONTACT_EVENTS_PER_THREAD_MAX", dropped_events_count );
+  }
+
+  physics->telemetry.contact_events_dispatch_time = 1000.f * crude_time_delta_seconds( dispatch_start_time, crude_time_now( ) );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_shape_cast
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_query_shape const                    *shape,
+  _In_ XMVECTOR                                            direction,
+  _In_ uint8                                               broad_phase_mask,
+  _In_ uint32                                              layer_mask,
+  _Inout_ crude_physics_shape_query_result                *result
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_shape_cast" );
+  crude_physics_shape_query_dispatch_( physics, shape, &direction, broad_phase_mask, layer_mask, result );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_shape_overlap
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_query_shape const                    *shape,
+  _In_ uint8                                               broad_phase_mask,
+  _In_ uint32                                              layer_mask,
+  _Inout_ crude_physics_shape_query_result                *result
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_shape_overlap" );
+  crude_physics_shape_query_dispatch_( physics, shape, NULL, broad_phase_mask, layer_mask, result );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+crude_physics_shape_query_result
+crude_physics_shape_query_result_empty
+(
+  _In_ crude_physics_shape_hit                            *hits,
+  _In_ uint32                                              hits_capacity
+)
+{
+  crude_physics_shape_query_result                         result;
+
+  result = CRUDE_COMPOUNT_EMPTY( crude_physics_shape_query_result );
+  result.hits = hits;
+  result.hits_capacity = hits_capacity;
+  return result;
+}
+
+#if defined(JPH_ENABLE_ASSERTS)
+
+static void
+crude_physics_jolt_trace_impl_
+(
+  _In_ char const                                         *fmt,
+  _In_ ...
+)
+{
+  char                                                     buffer[ 1024 ];
+  va_list                                                  list;
+
+  va_start( list, fmt );
+  vsnprintf( buffer, sizeof( buffer ), fmt, list );
+  va_end( list );
+
+  CRUDE_LOG_ERROR( CRUDE_CHANNEL_PHYSICS, buffer );
+}
+
+static bool
+crude_physics_jolt_assert_failed_impl_
+(
+  _In_ char const                                          *expression,
+  _In_ char const                                          *message,
+  _In_ char const                                          *file,
+  _In_ uint32                                               line
+)
+{
+  CRUDE_LOG_ERROR( CRUDE_CHANNEL_PHYSICS, "%s:%i: (%s) %s",  file, line, expression, message ? message : "" );
+  return true;
+}
+
+#endif /* JPH_ENABLE_ASSERTS */
+
+bool
+crude_physics_body_added_
+(
+  _In_ int32                                               batch_index
+)
+{
+  return batch_index != CRUDE_PHYSICS_BATCH_INDEX_REMOVED;
+}
+
+void
+crude_physics_add_body_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::BodyID                                         jph_body,
+  _In_ uint32                                              handle_index,
+  _Out_ int32                                             *batch_index,
+  _Inout_ uint32                                         **batch_added_bodies,
+  _In_ JPH::EActivation                                    jph_activation
+)
+{
+  /* Body with pending removal is added back after the batch removes it */
+  if ( physics->bodies_batch_depth )
+  {
+    *batch_index = CRUDE_ARRAY_LENGTH( *batch_added_bodies );
+    CRUDE_ARRAY_PUSH( *batch_added_bodies, handle_index );
+    return;
+  }
+
+  *batch_index = -1;
+  physics->jph_physics_system_class->GetBodyInterface( ).AddBody( jph_body, jph_activation );
+  ++physics->unoptimized_bodies_count;
+}
+
+void
+crude_physics_remove_body_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::BodyID                                         jph_body,
+  _Inout_ int32                                           *batch_index,
+  _In_ uint32                                             *batch_added_bodies
+)
+{
+  /* Body wasn't added yet, invalid index is skipped when the batch is committed. Removal pushed before the addition is still pending */
+  if ( *batch_index >= 0 )
+  {
+    batch_added_bodies[ *batch_index ] = CRUDE_RESOURCE_INDEX_INVALID;
+    *batch_index = CRUDE_PHYSICS_BATCH_INDEX_REMOVED;
+    return;
+  }
+
+  *batch_index = CRUDE_PHYSICS_BATCH_INDEX_REMOVED;
+  if ( physics->bodies_batch_depth )
+  {
+    CRUDE_ARRAY_PUSH( physics->batch_removed_bodies, jph_body );
+    return;
+  }
+
+  physics->jph_physics_system_class->GetBodyInterface( ).RemoveBody( jph_body );
+}
+
+void
+crude_physics_destroy_body_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::BodyID                                         jph_body,
+  _Inout_ int32                                           *batch_index,
+  _In_ uint32                                             *batch_added_bodies
+)
+{
+  if ( crude_physics_body_added_( *batch_index ) )
+  {
+    crude_physics_remove_body_( physics, jph_body, batch_index, batch_added_bodies );
+  }
+
+  if ( physics->bodies_batch_depth )
+  {
+    CRUDE_ARRAY_PUSH( physics->batch_destroyed_bodies, jph_body );
+    return;
+  }
+
+  physics->jph_physics_system_class->GetBodyInterface( ).DestroyBody( jph_body );
+}
+
+void
+crude_physics_commit_batch_bodies_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::EActivation                                    jph_activation
+)
+{
+  JPH::BodyInterface                                      *jph_body_interface_class;
+  JPH::BodyInterface::AddState                             jph_add_state;
+
+  if ( CRUDE_ARRAY_LENGTH( physics->batch_bodies ) == 0 )
+  {
+    return;
+  }
+
+  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterface( );
+  jph_add_state = jph_body_interface_class->AddBodiesPrepare( physics->batch_bodies, CRUDE_ARRAY_LENGTH( physics->batch_bodies ) );
+  jph_body_interface_class->AddBodiesFinalize( physics->batch_bodies, CRUDE_ARRAY_LENGTH( physics->batch_bodies ), jph_add_state, jph_activation );
+}
+
+uint32
+crude_physics_obtain_resource_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_resource_pool                                *resource_pool,
+  _In_ char const                                         *resource_pool_name
+)
+{
+  if ( resource_pool->used_indices == resource_pool->pool_size )
+  {
+    /* Containers are moved to the new memory, worker ray casts read them */
+    CRUDE_ASSERTM( CRUDE_CHANNEL_PHYSICS, physics->ray_cast_tasks_in_flight_count == 0, "Physics %s pool can't grow while ray cast tasks are in flight", resource_pool_name );
+    CRUDE_LOG_INFO( CRUDE_CHANNEL_PHYSICS, "Physics %s pool is full, growing from %u to %u", resource_pool_name, resource_pool->pool_size, resource_pool->pool_size * 2 );
+    crude_resource_pool_grow( resource_pool, resource_pool->pool_size * 2 );
+  }
+  return crude_resource_pool_obtain_resource( resource_pool );
+}
+
+void
+crude_physics_check_bodies_capacity_
+(
+  _In_ crude_physics                                      *physics
+)
+{
+  uint32                                                   bodies_count;
+
+  bodies_count = physics->jph_physics_system_class->GetNumBodies( );
+  if ( bodies_count < physics->max_bodies * CRUDE_PHYSICS_CAPACITY_WARNING_RATIO )
+  {
+    physics->bodies_capacity_warned = false;
+    return;
+  }
+
+  if ( !physics->bodies_capacity_warned )
+  {
+    physics->bodies_capacity_warned = true;
+    CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "Bodies count %u is close to the limit %u. Increase \"max_bodies\" in environment", bodies_count, physics->max_bodies );
+  }
+}
+
+void
+crude_physics_check_contacts_capacity_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ uint32                                              contacts_count
+)
+{
+  /* Jolt doesn't expose pairs and constraints usage, every contact manifold takes a constraint and at least one body pair */
+  if ( contacts_count < physics->max_body_pairs * CRUDE_PHYSICS_CAPACITY_WARNING_RATIO )
+  {
+    physics->body_pairs_capacity_warned = false;
+  }
+  else if ( !physics->body_pairs_capacity_warned )
+  {
+    physics->body_pairs_capacity_warned = true;
+    CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "Contacts count %u is close to the body pairs limit %u. Increase \"max_body_pairs\" in environment", contacts_count, physics->max_body_pairs );
+  }
+
+  if ( contacts_count < physics->max_contact_constraints * CRUDE_PHYSICS_CAPACITY_WARNING_RATIO )
+  {
+    physics->contact_constraints_capacity_warned = false;
+  }
+  else if ( !physics->contact_constraints_capacity_warned )
+  {
+    physics->contact_constraints_capacity_warned = true;
+    CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "Contacts count %u is close to the contact constraints limit %u. Increase \"max_contact_constraints\" in environment", contacts_count, physics->max_contact_constraints );
+  }
+}
+
+crude_physics_step_phase
+crude_physics_step_phase_from_job_name_
+(
+  _In_ char const                                         *name
+)
+{
+  static char const                                       *broad_phase_jobs[] = { "UpdateBroadPhasePrepare", "UpdateBroadPhaseFinalize" };
+  static char const                                       *narrow_phase_jobs[] = { "FindCollisions", "FindCCDContacts", "ResolveCCDContacts", "SoftBodyCollide" };
+  static char const                                       *solver_jobs[] = {
+    "DetermineActiveConstraints", "ApplyGravity", "BuildIslandsFromConstraints", "FinalizeIslands", "BodySetIslandIndex", "SetupVelocityConstraints",
+    "SolveVelocityConstraints", "PreIntegrateVelocity", "IntegrateVelocity", "PostIntegrateVelocity", "SolvePositionConstraints",
+    "SoftBodyPrepare", "SoftBodySimulate", "SoftBodyFinalize" };
+  static char const                                       *callbacks_jobs[] = { "StepListeners", "ContactRemovedCallbacks" };
+
+  for ( uint32 i = 0; i < CRUDE_COUNTOF( broad_phase_jobs ); ++i )
+  {
+    if ( strcmp( name, broad_phase_jobs[ i ] ) == 0 )
+    {
+      return CRUDE_PHYSICS_STEP_PHASE_BROAD_PHASE;
+    }
+  }
+  for ( uint32 i = 0; i < CRUDE_COUNTOF( narrow_phase_jobs ); ++i )
+  {
+    if ( strcmp( name, narrow_phase_jobs[ i ] ) == 0 )
+    {
+      return CRUDE_PHYSICS_STEP_PHASE_NARROW_PHASE;
+    }
+  }
+  for ( uint32 i = 0; i < CRUDE_COUNTOF( solver_jobs ); ++i )
+  {
+    if ( strcmp( name, solver_jobs[ i ] ) == 0 )
+    {
+      return CRUDE_PHYSICS_STEP_PHASE_SOLVER;
+    }
+  }
+  for ( uint32 i = 0; i < CRUDE_COUNTOF( callbacks_jobs ); ++i )
+  {
+    if ( strcmp( name, callbacks_jobs[ i ] ) == 0 )
+    {
+      return CRUDE_PHYSICS_STEP_PHASE_CALLBACKS;
+    }
+  }
+  return CRUDE_PHYSICS_STEP_PHASE_OTHER;
+}
+
+crude_entity
+crude_physics_body_entity_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ uint64                                              jph_body_user_data
+)
+{
+  uint32                                                   index;
+
+  index = CRUDE_PHYSICS_BODY_USER_DATA_INDEX( jph_body_user_data );
+  switch ( CRUDE_PHYSICS_BODY_USER_DATA_TYPE( jph_body_user_data ) )
+  {
+  case CRUDE_PHYSICS_BODY_USER_DATA_TYPE_STATIC_BODY:
+    return crude_physics_access_static_body( physics, CRUDE_COMPOUNT( crude_physics_static_body_handle, { index } ) )->entity;
+  case CRUDE_PHYSICS_BODY_USER_DATA_TYPE_KINEMATIC_BODY:
+    return crude_physics_access_kinematic_body( physics, CRUDE_COMPOUNT( crude_physics_kinematic_body_handle, { index } ) )->entity;
+  case CRUDE_PHYSICS_BODY_USER_DATA_TYPE_CHARACTER:
+    return crude_physics_access_character( physics, CRUDE_COMPOUNT( crude_physics_character_handle, { index } ) )->entity;
+  }
+
+  return CRUDE_COMPOUNT_EMPTY( crude_entity );
+}
+
+bool
+crude_physics_ray_cast_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ XMVECTOR                                            origin,
+  _In_ XMVECTOR                                            direction,
+  _In_ _crude_jph_ray_cast_broad_phase_layer_filter_class const *jph_broad_phase_layer_filter_class,
+  _In_ _crude_jph_ray_cast_object_layer_filter_class const *jph_object_layer_filter_class,
+  _Out_ crude_ray_cast_result                             *ray_cast_result
+)
+{
   JPH::RRayCast                                            jph_ray_cast;
   JPH::RayCastResult                                       jph_ray_cast_result;
-  XMMATRIX                                                 view_to_world;
   
   jph_ray_cast.mDirection = crude_vector_to_jph_vec3( direction );
   jph_ray_cast.mOrigin = crude_vector_to_jph_vec3( origin );
   
   *ray_cast_result = CRUDE_COMPOUNT_EMPTY( crude_ray_cast_result );
-  if ( physics->jph_physics_system_class->GetNarrowPhaseQuery( ).CastRay( jph_ray_cast, jph_ray_cast_result, _crude_ray_cast_broad_layer_filter_class( broad_phase_mask ), _crude_ray_cast_layer_filter_class( layer_mask ) ) )
+  if ( physics->jph_physics_system_class->GetNarrowPhaseQuery( ).CastRay( jph_ray_cast, jph_ray_cast_result, *jph_broad_phase_layer_filter_class, *jph_object_layer_filter_class ) )
   {
     JPH::RVec3                                             jph_hit_point;
-    crude_physics_static_body_handle                       static_body_handle;
 
     jph_hit_point = jph_ray_cast.GetPointOnRay( jph_ray_cast_result.mFraction );
 
     ray_cast_result->layer = physics->jph_physics_system_class->GetBodyInterface().GetObjectLayer( jph_ray_cast_result.mBodyID );
-    
-    static_body_handle.index = physics->jph_physics_system_class->GetBodyInterface().GetUserData( jph_ray_cast_result.mBodyID );
-
-    ray_cast_result->entity = crude_physics_access_static_body( physics, static_body_handle )->entity;
+    ray_cast_result->entity = crude_physics_body_entity_( physics, physics->jph_physics_system_class->GetBodyInterface().GetUserData( jph_ray_cast_result.mBodyID ) );
     XMStoreFloat3( &ray_cast_result->point, crude_jph_vec3_to_vector( jph_hit_point ) );
     return true;
   }
@@ -763,36 +2396,522 @@ crude_physics_ray_cast
   return false;
 }
 
-#if defined(JPH_ENABLE_ASSERTS)
+void
+crude_physics_ray_cast_task_execute_
+(
+  _In_ uint32_t                                            start,
+  _In_ uint32_t                                            end,
+  _In_ uint32_t                                            thread_num,
+  _In_ void                                               *args
+)
+{
+  crude_physics_ray_cast_task                             *task;
+  _crude_jph_ray_cast_broad_phase_layer_filter_class       jph_broad_phase_layer_filter_class;
+  _crude_jph_ray_cast_object_layer_filter_class            jph_object_layer_filter_class;
 
-static void
-crude_physics_jolt_trace_impl_
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_ray_cast_task_execute" );
+
+  task = CRUDE_CAST( crude_physics_ray_cast_task*, args );
+  for ( uint32 i = start; i < end; ++i )
+  {
+    crude_physics_ray_cast_query const                    *query;
+    crude_physics_ray_cast_batch_result                   *result;
+
+    query = &task->queries[ i ];
+    result = &task->results[ i ];
+
+    jph_broad_phase_layer_filter_class.mask = query->broad_phase_mask;
+    jph_object_layer_filter_class.mask = query->layer_mask;
+    result->hit = crude_physics_ray_cast_( task->physics, XMLoadFloat3( &query->origin ), XMLoadFloat3( &query->direction ), &jph_broad_phase_layer_filter_class, &jph_object_layer_filter_class, &result->ray_cast_result );
+  }
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_virtual_characters_task_initialize_
 (
-  _In_ char const                                         *fmt,
-  _In_ ...
+  _In_ crude_physics_virtual_characters_task              *task,
+  _In_ crude_physics                                      *physics
 )
 {
-  char                                                     buffer[ 1024 ];
-  va_list                                                  list;
+  *task = CRUDE_COMPOUNT_EMPTY( crude_physics_virtual_characters_task );
+  task->physics = physics;
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( task->entries, 64, physics->physics_allocator_container );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( task->cells, 64, physics->physics_allocator_container );
+
+  task->jph_temporary_allocators_count = enkiGetNumTaskThreads( physics->task_sheduler->enki_task_sheduler );
+  task->jph_temporary_allocators_classes = CRUDE_CAST( JPH::TempAllocatorImpl**, CRUDE_ALLOCATE( physics->physics_allocator_container, task->jph_temporary_allocators_count * sizeof( JPH::TempAllocatorImpl* ) ) );
+  for ( uint32 i = 0; i < task->jph_temporary_allocators_count; ++i )
+  {
+    task->jph_temporary_allocators_classes[ i ] = CRUDE_JOLT_OVERRIDEN_NEW JPH::TempAllocatorImpl( CRUDE_PHYSICS_VIRTUAL_CHARACTER_TEMPORARY_ALLOCATOR_SIZE );
+  }
 
-  va_start( list, fmt );
-  vsnprintf( buffer, sizeof( buffer ), fmt, list );
-  va_end( list );
+  task->enki_task_set = enkiCreateTaskSet( physics->task_sheduler->enki_task_sheduler, crude_physics_virtual_characters_task_execute_ );
+}
 
-  CRUDE_LOG_ERROR( CRUDE_CHANNEL_PHYSICS, buffer );
+void
+crude_physics_virtual_characters_task_deinitialize_
+(
+  _In_ crude_physics_virtual_characters_task              *task
+)
+{
+  enkiWaitForTaskSet( task->physics->task_sheduler->enki_task_sheduler, task->enki_task_set );
+  enkiDeleteTaskSet( task->physics->task_sheduler->enki_task_sheduler, task->enki_task_set );
+
+  for ( uint32 i = 0; i < task->jph_temporary_allocators_count; ++i )
+  {
+    CRUDE_JOLT_OVERRIDEN_FREE task->jph_temporary_allocators_classes[ i ];
+  }
+  CRUDE_DEALLOCATE( task->physics->physics_allocator_container, task->jph_temporary_allocators_classes );
+
+  CRUDE_ARRAY_DEINITIALIZE( task->entries );
+  CRUDE_ARRAY_DEINITIALIZE( task->cells );
 }
 
-static bool
-crude_physics_jolt_assert_failed_impl_
+void
+crude_physics_virtual_characters_task_execute_
 (
-  _In_ char const                                          *expression,
-  _In_ char const                                          *message,
-  _In_ char const                                          *file,
-  _In_ uint32                                               line
+  _In_ uint32_t                                            start,
+  _In_ uint32_t                                            end,
+  _In_ uint32_t                                            thread_num,
+  _In_ void                                               *args
 )
 {
-  CRUDE_LOG_ERROR( CRUDE_CHANNEL_PHYSICS, "%s:%i: (%s) %s",  file, line, expression, message ? message : "" );
-  return true;
+  crude_physics_virtual_characters_task                   *task;
+  crude_physics                                           *physics;
+  JPH::TempAllocatorImpl                                  *jph_temporary_allocator_class;
+  JPH::CharacterVirtual::ExtendedUpdateSettings            jph_update_settings;
+  _crude_jph_inner_body_filter_class                       jph_inner_body_filter_class;
+  JPH::Vec3                                                jph_gravity;
+  uint32                                                   cells_offset;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_virtual_characters_task_execute" );
+
+  task = CRUDE_CAST( crude_physics_virtual_characters_task*, args );
+  physics = task->physics;
+
+  CRUDE_ASSERT( thread_num < task->jph_temporary_allocators_count );
+  jph_temporary_allocator_class = task->jph_temporary_allocators_classes[ thread_num ];
+  jph_gravity = physics->jph_physics_system_class->GetGravity( );
+  cells_offset = task->colors_cells_offsets[ task->current_color ];
+
+  for ( uint32 cell_index = cells_offset + start; cell_index < cells_offset + end; ++cell_index )
+  {
+    crude_physics_virtual_characters_cell const           *cell;
+
+    cell = &task->cells[ cell_index ];
+    for ( uint32 i = 0; i < cell->entries_count; ++i )
+    {
+      JPH::CharacterVirtual                               *jph_character;
+      crude_physics_character_container                   *character_container;
+      crude_physics_character_handle                       character_handle;
+
+      jph_character = physics->jph_character_vs_character_collision_class->mCharacters[ task->entries[ cell->entries_offset + i ].character_index ];
+      character_handle.index = CRUDE_PHYSICS_BODY_USER_DATA_INDEX( jph_character->GetUserData( ) );
+      character_container = crude_physics_access_character( physics, character_handle );
+
+      JPH::DefaultBroadPhaseLayerFilter jph_broad_phase_layer_filter_class( *physics->jph_object_vs_broadphase_layer_filter_class, character_container->layers );
+      JPH::DefaultObjectLayerFilter jph_object_layer_filter_class( *physics->jph_object_vs_object_layer_filter_class, character_container->layers );
+
+      jph_character->ExtendedUpdate( task->delta_time, jph_gravity, jph_update_settings, jph_broad_phase_layer_filter_class, jph_object_layer_filter_class, jph_inner_body_filter_class, JPH::ShapeFilter( ), *jph_temporary_allocator_class );
+    }
+  }
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_update_virtual_characters_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ float32                                             delta_time
+)
+{
+  _crude_jph_character_vs_character_collision_class       *jph_collision_class;
+  crude_physics_virtual_characters_task                   *task;
+  JPH::Vec3                                                jph_gravity;
+  float32                                                  max_move_distance;
+  float32                                                  max_half_extent;
+  float32                                                  cell_size;
+  uint32                                                   characters_count;
+  uint32                                                   cell_index;
+
+  jph_collision_class = physics->jph_character_vs_character_collision_class;
+  task = &physics->virtual_characters_task;
+
+  characters_count = CRUDE_CAST( uint32, jph_collision_class->mCharacters.size( ) );
+  if ( characters_count == 0 )
+  {
+    return;
+  }
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_update_virtual_characters_" );
+
+  /* ExtendedUpdate only moves the character by its velocity, falling speed is handled here like a body would do */
+  jph_gravity = physics->jph_physics_system_class->GetGravity( );
+  max_move_distance = 0.f;
+  for ( uint32 i = 0; i < characters_count; ++i )
+  {
+    JPH::CharacterVirtual                                 *jph_character;
+    JPH::Vec3                                              jph_velocity;
+    JPH::Vec3                                              jph_ground_velocity;
+
+    jph_character = jph_collision_class->mCharacters[ i ];
+    jph_velocity = jph_character->GetLinearVelocity( );
+    if ( jph_character->GetGroundState( ) == JPH::CharacterBase::EGroundState::OnGround )
+    {
+      jph_ground_velocity = jph_character->GetGroundVelocity( );
+      jph_velocity.SetY( CRUDE_MAX( jph_velocity.GetY( ), jph_ground_velocity.GetY( ) ) );
+    }
+    jph_velocity += jph_gravity * delta_time;
+    jph_character->SetLinearVelocity( jph_velocity );
+    max_move_distance = CRUDE_MAX( max_move_distance, jph_velocity.Length( ) * delta_time );
+  }
+
+  jph_collision_class->snapshot( max_move_distance + CRUDE_PHYSICS_VIRTUAL_CHARACTER_MOVE_MARGIN );
+
+  /* Characters of same colored cells are at least one cell apart, so their snapshots never overlap */
+  max_half_extent = 0.f;
+  for ( uint32 i = 0; i < characters_count; ++i )
+  {
+    JPH::Vec3                                              jph_extent;
+
+    jph_extent = jph_collision_class->snapshot_bounds[ i ].GetExtent( );
+    max_half_extent = CRUDE_MAX( max_half_extent, CRUDE_MAX( jph_extent.GetX( ), jph_extent.GetZ( ) ) );
+  }
+  cell_size = 2.f * max_half_extent + CRUDE_PHYSICS_VIRTUAL_CHARACTER_MOVE_MARGIN;
+
+  CRUDE_ARRAY_SET_LENGTH( task->entries, characters_count );
+  for ( uint32 i = 0; i < characters_count; ++i )
+  {
+    JPH::Vec3                                              jph_center;
+    int32                                                  cell_x, cell_z;
+    uint64                                                 color;
+
+    jph_center = jph_collision_class->snapshot_bounds[ i ].GetCenter( );
+    cell_x = CRUDE_CAST( int32, floorf( jph_center.GetX( ) / cell_size ) );
+    cell_z = CRUDE_CAST( int32, floorf( jph_center.GetZ( ) / cell_size ) );
+    color = ( cell_x & 1 ) | ( ( cell_z & 1 ) << 1 );
+
+    task->entries[ i ].cell_key = ( color << 62 ) | ( CRUDE_CAST( uint64, CRUDE_CAST( uint32, cell_x ) & 0x7fffffff ) << 31 ) | ( CRUDE_CAST( uint32, cell_z ) & 0x7fffffff );
+    task->entries[ i ].character_index = i;
+  }
+
+  qsort( task->entries, characters_count, sizeof( crude_physics_virtual_character_entry ), crude_physics_virtual_character_entry_compare_ );
+
+  CRUDE_ARRAY_SET_LENGTH( task->cells, 0u );
+  for ( uint32 i = 0; i < characters_count; ++i )
+  {
+    if ( i == 0 || task->entries[ i ].cell_key != task->entries[ i - 1 ].cell_key )
+    {
+      CRUDE_ARRAY_PUSH( task->cells, CRUDE_COMPOUNT( crude_physics_virtual_characters_cell, { i, 0u } ) );
+    }
+    ++CRUDE_ARRAY_BACK( task->cells ).entries_count;
+  }
+
+  cell_index = 0u;
+  for ( uint32 color = 0; color <= CRUDE_PHYSICS_VIRTUAL_CHARACTERS_COLORS_COUNT; ++color )
+  {
+    while ( cell_index < CRUDE_ARRAY_LENGTH( task->cells ) && ( task->entries[ task->cells[ cell_index ].entries_offset ].cell_key >> 62 ) < color )
+    {
+      ++cell_index;
+    }
+    task->colors_cells_offsets[ color ] = cell_index;
+  }
+
+  task->delta_time = delta_time;
+  for ( uint32 color = 0; color < CRUDE_PHYSICS_VIRTUAL_CHARACTERS_COLORS_COUNT; ++color )
+  {
+    enkiParamsTaskSet                                      enki_params;
+    uint32                                                 cells_count;
+
+    cells_count = task->colors_cells_offsets[ color + 1 ] - task->colors_cells_offsets[ color ];
+    if ( cells_count == 0 )
+    {
+      continue;
+    }
+
+    task->current_color = color;
+
+    enki_params = enkiGetParamsTaskSet( task->enki_task_set );
+    enki_params.pArgs = task;
+    enki_params.setSize = cells_count;
+    enki_params.minRange = CRUDE_PHYSICS_VIRTUAL_CHARACTER_CELLS_MIN_RANGE;
+    enkiSetParamsTaskSet( task->enki_task_set, enki_params );
+    enkiAddTaskSet( physics->task_sheduler->enki_task_sheduler, task->enki_task_set );
+    enkiWaitForTaskSet( physics->task_sheduler->enki_task_sheduler, task->enki_task_set );
+  }
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+int
+crude_physics_virtual_character_entry_compare_
+(
+  _In_ void const                                         *a,
+  _In_ void const                                         *b
+)
+{
+  uint64                                                   a_key, b_key;
+
+  a_key = CRUDE_CAST( crude_physics_virtual_character_entry const*, a )->cell_key;
+  b_key = CRUDE_CAST( crude_physics_virtual_character_entry const*, b )->cell_key;
+  return ( a_key > b_key ) - ( a_key < b_key );
+}
+
+void
+crude_physics_set_body_active_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::BodyID const                                  &jph_body_id,
+  _In_ uint64                                              jph_body_user_data,
+  _In_ bool                                                active
+)
+{
+  crude_physics_character_container                       *character_container;
+
+  /* Kinematic bodies are taken from Jolt active bodies in crude_physics_update_sync_lists_ */
+  if ( CRUDE_PHYSICS_BODY_USER_DATA_TYPE( jph_body_user_data ) != CRUDE_PHYSICS_BODY_USER_DATA_TYPE_CHARACTER )
+  {
+    return;
+  }
+
+  /* Removal of batched bodies could happen after the handle was released and inner bodies of virtual characters share the user data, so the body id is checked */
+  character_container = crude_physics_access_character( physics, CRUDE_COMPOUNT( crude_physics_character_handle, { CRUDE_PHYSICS_BODY_USER_DATA_INDEX( jph_body_user_data ) } ) );
+  if ( character_container->jph_character_class && character_container->jph_character_class->GetBodyID( ) == jph_body_id )
+  {
+    character_container->active = active;
+    character_container->inactive_synced = false;
+  }
+}
+
+void
+crude_physics_sync_list_add_
+(
+  _Inout_ uint32                                         **sync_list,
+  _In_ uint32                                              index
+)
+{
+  uint32                                                  *list;
+
+  list = *sync_list;
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( list ); ++i )
+  {
+    if ( list[ i ] == index )
+    {
+      return;
+    }
+  }
+
+  CRUDE_ARRAY_PUSH( list, index );
+  *sync_list = list;
+}
+
+void
+crude_physics_sync_list_remove_
+(
+  _In_ uint32                                             *sync_list,
+  _In_ uint32                                              index
+)
+{
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( sync_list ); ++i )
+  {
+    if ( sync_list[ i ] == index )
+    {
+      CRUDE_ARRAY_DELSWAP( sync_list, i );
+      return;
+    }
+  }
+}
+
+void
+crude_physics_update_sync_lists_
+(
+  _In_ crude_physics                                      *physics
+)
+{
+  _crude_jph_character_vs_character_collision_class       *jph_collision_class;
+  JPH::BodyInterface                                      *jph_body_interface_class;
+  JPH::BodyID const                                       *jph_active_bodies;
+  uint32                                                   jph_active_bodies_count;
+  uint32                                                   kept_characters_count;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_update_sync_lists_" );
+
+  jph_collision_class = physics->jph_character_vs_character_collision_class;
+  jph_body_interface_class = &physics->jph_physics_system_class->GetBodyInterfaceNoLock( );
+
+  /* Characters which fell asleep during the update stay till their interpolation settled */
+  kept_characters_count = 0u;
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( physics->sync_characters ); ++i )
+  {
+    crude_physics_character_container                     *character_container;
+
+    character_container = crude_physics_access_character( physics, CRUDE_COMPOUNT( crude_physics_character_handle, { physics->sync_characters[ i ] } ) );
+    if ( character_container->jph_character_class && !character_container->active && !character_container->inactive_synced )
+    {
+      physics->sync_characters[ kept_characters_count++ ] = physics->sync_characters[ i ];
+    }
+  }
+  CRUDE_ARRAY_SET_LENGTH( physics->sync_characters, kept_characters_count );
+  CRUDE_ARRAY_SET_LENGTH( physics->sync_kinematic_bodies, 0u );
+
+  /* Virtual characters have no body to fall asleep, they are moved every step */
+  for ( uint32 i = 0; i < jph_collision_class->mCharacters.size( ); ++i )
+  {
+    CRUDE_ARRAY_PUSH( physics->sync_characters, CRUDE_PHYSICS_BODY_USER_DATA_INDEX( jph_collision_class->mCharacters[ i ]->GetUserData( ) ) );
+  }
+
+  /* Nothing else changes the active bodies list till the next update */
+  jph_active_bodies = physics->jph_physics_system_class->GetActiveBodiesUnsafe( JPH::EBodyType::RigidBody );
+  jph_active_bodies_count = physics->jph_physics_system_class->GetNumActiveBodies( JPH::EBodyType::RigidBody );
+  for ( uint32 i = 0; i < jph_active_bodies_count; ++i )
+  {
+    uint64                                                 jph_body_user_data;
+    uint32                                                 index;
+
+    jph_body_user_data = jph_body_interface_class->GetUserData( jph_active_bodies[ i ] );
+    index = CRUDE_PHYSICS_BODY_USER_DATA_INDEX( jph_body_user_data );
+    switch ( CRUDE_PHYSICS_BODY_USER_DATA_TYPE( jph_body_user_data ) )
+    {
+    case CRUDE_PHYSICS_BODY_USER_DATA_TYPE_CHARACTER:
+    {
+      crude_physics_character_container                   *character_container;
+
+      /* Inner bodies of virtual characters are skipped, virtual characters are already added */
+      character_container = crude_physics_access_character( physics, CRUDE_COMPOUNT( crude_physics_character_handle, { index } ) );
+      if ( character_container->jph_character_class && character_container->jph_character_class->GetBodyID( ) == jph_active_bodies[ i ] )
+      {
+        CRUDE_ARRAY_PUSH( physics->sync_characters, index );
+      }
+      break;
+    }
+    case CRUDE_PHYSICS_BODY_USER_DATA_TYPE_KINEMATIC_BODY:
+    {
+      CRUDE_ARRAY_PUSH( physics->sync_kinematic_bodies, index );
+      break;
+    }
+    }
+  }
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_shape_query_dispatch_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_query_shape const                    *shape,
+  _In_opt_ XMVECTOR const                                 *direction,
+  _In_ uint8                                               broad_phase_mask,
+  _In_ uint32                                              layer_mask,
+  _Inout_ crude_physics_shape_query_result                *result
+)
+{
+  /* Shapes live on the stack, embedded so references don't free them */
+  switch ( shape->type )
+  {
+  case CRUDE_PHYSICS_QUERY_SHAPE_TYPE_SPHERE:
+  {
+    JPH::SphereShape                                       jph_sphere_shape_class( shape->sphere.radius );
+    jph_sphere_shape_class.SetEmbedded( );
+    crude_physics_shape_query_( physics, &jph_sphere_shape_class, shape, direction, broad_phase_mask, layer_mask, result );
+    break;
+  }
+  case CRUDE_PHYSICS_QUERY_SHAPE_TYPE_CAPSULE:
+  {
+    JPH::CapsuleShape                                      jph_capsule_shape_class( shape->capsule.half_height, shape->capsule.radius );
+    jph_capsule_shape_class.SetEmbedded( );
+    crude_physics_shape_query_( physics, &jph_capsule_shape_class, shape, direction, broad_phase_mask, layer_mask, result );
+    break;
+  }
+  case CRUDE_PHYSICS_QUERY_SHAPE_TYPE_BOX:
+  {
+    JPH::Vec3                                              jph_extent;
+
+    jph_extent = JPH::Vec3( shape->box.extent.x, shape->box.extent.y, shape->box.extent.z );
+
+    JPH::BoxShape                                          jph_box_shape_class( jph_extent, JPH::min( JPH::cDefaultConvexRadius, jph_extent.ReduceMin( ) ) );
+    jph_box_shape_class.SetEmbedded( );
+    crude_physics_shape_query_( physics, &jph_box_shape_class, shape, direction, broad_phase_mask, layer_mask, result );
+    break;
+  }
+  default:
+  {
+    CRUDE_ASSERT( false );
+  }
+  }
 }
 
-#endif /* JPH_ENABLE_ASSERTS */
\ No newline at end of file
+void
+crude_physics_shape_query_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ JPH::Shape const                                   *jph_shape_class,
+  _In_ crude_physics_query_shape const                    *shape,
+  _In_opt_ XMVECTOR const                                 *direction,
+  _In_ uint8                                               broad_phase_mask,
+  _In_ uint32                                              layer_mask,
+  _Inout_ crude_physics_shape_query_result                *result
+)
+{
+  _crude_jph_ray_cast_broad_phase_layer_filter_class       jph_broad_phase_layer_filter_class;
+  _crude_jph_ray_cast_object_layer_filter_class            jph_object_layer_filter_class;
+  JPH::RMat44                                              jph_transform;
+  JPH::BodyLockInterface const                            *jph_body_lock_interface_class;
+  
+  result->hits_count = 0u;
+  result->overflow = false;
+
+  jph_broad_phase_layer_filter_class.mask = broad_phase_mask;
+  jph_object_layer_filter_class.mask = layer_mask;
+  jph_transform = JPH::RMat44::sRotationTranslation( JPH::Quat( shape->rotation.x, shape->rotation.y, shape->rotation.z, shape->rotation.w ), JPH::RVec3( shape->translation.x, shape->translation.y, shape->translation.z ) );
+
+  if ( direction )
+  {
+    _crude_jph_shape_cast_collector_class                  jph_collector_class( result );
+    JPH::RShapeCast                                        jph_shape_cast = JPH::RShapeCast::sFromWorldTransform( jph_shape_class, JPH::Vec3::sOne( ), jph_transform, crude_vector_to_jph_vec3( *direction ) );
+
+    physics->jph_physics_system_class->GetNarrowPhaseQuery( ).CastShape( jph_shape_cast, JPH::ShapeCastSettings( ), JPH::RVec3::sZero( ), jph_collector_class, jph_broad_phase_layer_filter_class, jph_object_layer_filter_class );
+    
+    /* Insertion sort, hits count is small */
+    for ( uint32 i = 1; i < result->hits_count; ++i )
+    {
+      crude_physics_shape_hit                              hit;
+      uint32                                               j;
+
+      hit = result->hits[ i ];
+      for ( j = i; j > 0 && result->hits[ j - 1 ].fraction > hit.fraction; --j )
+      {
+        result->hits[ j ] = result->hits[ j - 1 ];
+      }
+      result->hits[ j ] = hit;
+    }
+  }
+  else
+  {
+    _crude_jph_shape_overlap_collector_class               jph_collector_class( result );
+
+    physics->jph_physics_system_class->GetNarrowPhaseQuery( ).CollideShape( jph_shape_class, JPH::Vec3::sOne( ), jph_transform, JPH::CollideShapeSettings( ), JPH::RVec3::sZero( ), jph_collector_class, jph_broad_phase_layer_filter_class, jph_object_layer_filter_class );
+  }
+
+  /* Bodies are locked after the query, collectors are called while the query holds the lock */
+  jph_body_lock_interface_class = &physics->jph_physics_system_class->GetBodyLockInterface( );
+  for ( uint32 i = 0; i < result->hits_count; ++i )
+  {
+    crude_physics_shape_hit                               *hit;
+    
+    hit = &result->hits[ i ];
+
+    JPH::BodyLockRead                                      jph_body_lock_class( *jph_body_lock_interface_class, JPH::BodyID( hit->jph_body_id ) );
+    if ( !jph_body_lock_class.Succeeded( ) )
+    {
+      continue;
+    }
+
+    JPH::Body const                                       &jph_body_class = jph_body_lock_class.GetBody( );
+    hit->layer = jph_body_class.GetObjectLayer( );
+    hit->entity = crude_physics_body_entity_( physics, jph_body_class.GetUserData( ) );
+  }
+}
@@ -2,6 +2,7 @@
 
 #include <engine/core/ecs.h>
 #include <engine/core/math.h>
+#include <engine/core/task_sheduler.h>
 #include <engine/physics/physics_shapes_manager.h>
 #include <engine/physics/physics_resource.h>
 #include <engine/physics/physics_ecs.h>
@@ -83,6 +84,11 @@ public:
   ) const override;
 };
 
+typedef enum crude_physics_contact_event_type
+{
+  CRUDE_PHYSICS_CONTACT_EVENT_TYPE_ADDED,
+} crude_physics_contact_event_type;
+
 class _crude_jph_contact_listener_class : public JPH::ContactListener
 {
 public:
@@ -123,12 +129,27 @@ public:
     _In_ const JPH::SubShapeIDPair                        &subshapepair
   ) override;
 private:
+  void
+  push_event_
+  (
+    _In_ crude_physics_contact_event_type                  type,
+    _In_ JPH::Body const                                  &body1,
+    _In_ JPH::Body const                                  &body2,
+    _In_ JPH::ContactManifold const                       &manifold
+  );
+
   crude_physics                                           *physics;
 };
 
+/* Keeps active flags of characters, called from physics jobs */
 class _crude_jph_body_activation_listener_class : public JPH::BodyActivationListener
 {
 public:
+  _crude_jph_body_activation_listener_class
+  (
+    _In_ crude_physics                                    *physics
+  );
+
   virtual void
   OnBodyActivated
   (
@@ -142,13 +163,424 @@ public:
     _In_ const JPH::BodyID                                &body_id,
     _In_ uint64                                            body_user_data
   ) override;
+private:
+  crude_physics                                           *physics;
 };
 
+/**
+ * Other characters are culled by bounds snapshotted before the update, so
+ * a character never reads the pose of a character which is moved by
+ * another worker, see crude_physics_virtual_characters_task.
+ */
+class _crude_jph_character_vs_character_collision_class final : public JPH::CharacterVsCharacterCollisionSimple
+{
+public:
+  /* Bounds are expanded by the distance characters could move until the next snapshot */
+  void
+  snapshot
+  (
+    _In_ float32                                           expansion
+  );
+
+  virtual void
+  CollideCharacter
+  (
+    _In_ JPH::CharacterVirtual const                      *jph_character,
+    _In_ JPH::RMat44Arg                                    jph_center_of_mass_transform,
+    _In_ JPH::CollideShapeSettings const                  &jph_collide_shape_settings,
+    _In_ JPH::RVec3Arg                                     jph_base_offset,
+    _In_ JPH::CollideShapeCollector                       &jph_collector
+  ) const override;
+
+  virtual void
+  CastCharacter
+  (
+    _In_ JPH::CharacterVirtual const                      *jph_character,
+    _In_ JPH::RMat44Arg                                    jph_center_of_mass_transform,
+    _In_ JPH::Vec3Arg                                      jph_direction,
+    _In_ JPH::ShapeCastSettings const                     &jph_shape_cast_settings,
+    _In_ JPH::RVec3Arg                                     jph_base_offset,
+    _In_ JPH::CastShapeCollector                          &jph_collector
+  ) const override;
+
+  /* Same order as mCharacters */
+  JPH::Array< JPH::AABox >                                 snapshot_bounds;
+};
+
+/**
+ * Skips inner bodies of virtual characters in character updates, they
+ * collide with each other through _crude_jph_character_vs_character_collision_class
+ * and an inner body can be moved by another worker meanwhile.
+ */
+class _crude_jph_inner_body_filter_class final : public JPH::BodyFilter
+{
+public:
+  virtual bool
+  ShouldCollideLocked
+  (
+    _In_ JPH::Body const                                  &jph_body
+  ) const override;
+};
+
+/* Masks are public, so one filter is reused for all rays of a batch range */
+class _crude_jph_ray_cast_object_layer_filter_class : public JPH::ObjectLayerFilter
+{
+public:
+  virtual bool
+  ShouldCollide
+  (
+    _In_ JPH::ObjectLayer                                  layer
+  ) const override;
+
+  uint32                                                   mask;
+};
+
+class _crude_jph_ray_cast_broad_phase_layer_filter_class : public JPH::BroadPhaseLayerFilter
+{
+public:
+  virtual bool
+  ShouldCollide
+  (
+    _In_ JPH::BroadPhaseLayer                              layer
+  ) const override;
+
+  uint8                                                    mask;
+};
+
+typedef struct crude_physics_shape_query_result crude_physics_shape_query_result;
+
+/* Keeps the closest hits once the result is full */
+class _crude_jph_shape_cast_collector_class final : public JPH::CastShapeCollector
+{
+public:
+  _crude_jph_shape_cast_collector_class
+  (
+    _In_ crude_physics_shape_query_result                 *result
+  );
+
+  virtual void
+  AddHit
+  (
+    _In_ JPH::ShapeCastResult const                       &jph_result
+  ) override;
+private:
+  crude_physics_shape_query_result                        *result;
+};
+
+/* One hit per body, query early outs once the result is full */
+class _crude_jph_shape_overlap_collector_class final : public JPH::CollideShapeCollector
+{
+public:
+  _crude_jph_shape_overlap_collector_class
+  (
+    _In_ crude_physics_shape_query_result                 *result
+  );
+
+  virtual void
+  AddHit
+  (
+    _In_ JPH::CollideShapeResult const                    &jph_result
+  ) override;
+private:
+  crude_physics_shape_query_result                        *result;
+};
+
+/* Jolt jobs grouped by their name, see crude_physics_telemetry */
+typedef enum crude_physics_step_phase
+{
+  CRUDE_PHYSICS_STEP_PHASE_BROAD_PHASE,
+  CRUDE_PHYSICS_STEP_PHASE_NARROW_PHASE,
+  CRUDE_PHYSICS_STEP_PHASE_SOLVER,
+  CRUDE_PHYSICS_STEP_PHASE_CALLBACKS,
+  CRUDE_PHYSICS_STEP_PHASE_OTHER,
+  CRUDE_PHYSICS_STEP_PHASE_COUNT
+} crude_physics_step_phase;
+
+/**
+ * Runs Jolt jobs as task sets on crude_task_sheduler workers, so the physics
+ * step shares threads with the rest of the engine. Every queued job takes a
+ * task set slot, slot is reused once enki reports it complete, the job runs
+ * on the queuing thread when no slot is free. Job functions
+ * are wrapped to sum their time per crude_physics_step_phase, the barrier
+ * executes jobs directly too, so measuring in the task set would miss them.
+ */
+class _crude_jph_job_system_class final : public JPH::JobSystemWithBarrier
+{
+public:
+  _crude_jph_job_system_class
+  (
+    _In_ crude_task_sheduler                              *task_sheduler,
+    _In_ uint32                                            max_jobs,
+    _In_ uint32                                            max_barriers
+  );
+
+  virtual
+  ~_crude_jph_job_system_class
+  (
+  ) override;
+
+  virtual int
+  GetMaxConcurrency
+  (
+  ) const override;
+
+  virtual JPH::JobHandle
+  CreateJob
+  (
+    _In_ char const                                       *name,
+    _In_ JPH::ColorArg                                     color,
+    _In_ JPH::JobSystem::JobFunction const                &job_function,
+    _In_ JPH::uint32                                       dependencies_count = 0
+  ) override;
+
+  /* Microseconds summed over all threads since the last call */
+  void
+  consume_phases_time
+  (
+    _Out_ int64                                            phases_time[ CRUDE_PHYSICS_STEP_PHASE_COUNT ]
+  );
+
+protected:
+  virtual void
+  QueueJob
+  (
+    _In_ Job                                              *job
+  ) override;
+
+  virtual void
+  QueueJobs
+  (
+    _In_ Job                                             **jobs,
+    _In_ JPH::uint                                         jobs_count
+  ) override;
+
+  virtual void
+  FreeJob
+  (
+    _In_ Job                                              *job
+  ) override;
+
+private:
+  typedef struct task_slot
+  {
+    enkiTaskSet                                           *enki_task_set;
+    Job                                                   *job;
+    JPH::atomic< bool >                                    in_use;
+  } task_slot;
+
+  static void
+  execute_task_
+  (
+    _In_ uint32_t                                          start,
+    _In_ uint32_t                                          end,
+    _In_ uint32_t                                          thread_num,
+    _In_ void                                             *args
+  );
+
+  crude_task_sheduler                                     *task_sheduler;
+  JPH::FixedSizeFreeList< Job >                            jobs;
+  task_slot                                               *task_slots;
+  uint32                                                   task_slots_count;
+  JPH::atomic< uint32 >                                    next_task_slot;
+  JPH::atomic< int64 >                                     phases_time[ CRUDE_PHYSICS_STEP_PHASE_COUNT ];
+};
+
+typedef struct crude_physics_ray_cast_query
+{
+  XMFLOAT3                                                 origin;
+  /* Not normalized, ray length is the direction length */
+  XMFLOAT3                                                 direction;
+  uint32                                                   layer_mask;
+  uint8                                                    broad_phase_mask;
+} crude_physics_ray_cast_query;
+
+typedef struct crude_physics_ray_cast_batch_result
+{
+  crude_ray_cast_result                                    ray_cast_result;
+  bool                                                     hit;
+} crude_physics_ray_cast_batch_result;
+
+/**
+ * Rays are split between task sheduler workers. Queries and results are
+ * owned by the caller and must stay alive until the task is waited, which
+ * has to happen before the next crude_physics_update. Bodies can't be
+ * created while the task is in flight, a growing pool moves the containers
+ * workers read.
+ */
+typedef struct crude_physics_ray_cast_task
+{
+  crude_physics                                           *physics;
+  crude_physics_ray_cast_query const                      *queries;
+  crude_physics_ray_cast_batch_result                     *results;
+  uint32                                                   queries_count;
+  enkiTaskSet                                             *enki_task_set;
+  bool                                                     in_flight;
+} crude_physics_ray_cast_task;
+
+#define CRUDE_PHYSICS_VIRTUAL_CHARACTERS_COLORS_COUNT            4
+
+typedef struct crude_physics_virtual_character_entry
+{
+  /* Color is in the highest bits, so cells of one color are sorted together */
+  uint64                                                   cell_key;
+  /* Index in the characters collision list */
+  uint32                                                   character_index;
+} crude_physics_virtual_character_entry;
+
+typedef struct crude_physics_virtual_characters_cell
+{
+  uint32                                                   entries_offset;
+  uint32                                                   entries_count;
+} crude_physics_virtual_characters_cell;
+
+/**
+ * Virtual characters are split by a grid on the XZ plane, cells are
+ * colored like a checkerboard with 2x2 tiles. Cells are larger than the
+ * distance between characters which could touch during a step, so cells
+ * of one color are updated in parallel and colors go one after another.
+ * Characters of one cell are updated by one worker.
+ */
+typedef struct crude_physics_virtual_characters_task
+{
+  crude_physics                                           *physics;
+  crude_physics_virtual_character_entry                   *entries;
+  crude_physics_virtual_characters_cell                   *cells;
+  uint32                                                   colors_cells_offsets[ CRUDE_PHYSICS_VIRTUAL_CHARACTERS_COLORS_COUNT + 1 ];
+  uint32                                                   current_color;
+  float32                                                  delta_time;
+  /* One per task sheduler thread, JPH::TempAllocatorImpl isn't thread safe */
+  JPH::TempAllocatorImpl                                 **jph_temporary_allocators_classes;
+  uint32                                                   jph_temporary_allocators_count;
+  enkiTaskSet                                             *enki_task_set;
+} crude_physics_virtual_characters_task;
+
+typedef enum crude_physics_query_shape_type
+{
+  CRUDE_PHYSICS_QUERY_SHAPE_TYPE_SPHERE,
+  CRUDE_PHYSICS_QUERY_SHAPE_TYPE_CAPSULE,
+  CRUDE_PHYSICS_QUERY_SHAPE_TYPE_BOX,
+} crude_physics_query_shape_type;
+
+/* Capsule is aligned with the local Y axis like characters */
+typedef struct crude_physics_query_shape
+{
+  crude_physics_query_shape_type                           type;
+  union
+  {
+    struct
+    {
+      float32                                              radius;
+    } sphere;
+    struct
+    {
+      float32                                              half_height;
+      float32                                              radius;
+    } capsule;
+    struct
+    {
+      XMFLOAT3                                             extent;
+    } box;
+  };
+  XMFLOAT3                                                 translation;
+  XMFLOAT4                                                 rotation;
+} crude_physics_query_shape;
+
+typedef struct crude_physics_shape_hit
+{
+  /* Empty for characters */
+  crude_entity                                             entity;
+  uint32                                                   layer;
+  XMFLOAT3                                                 point;
+  /* Points from the hit surface to the query shape */
+  XMFLOAT3                                                 normal;
+  /* Part of the sweep direction before the hit, 0 for overlaps */
+  float32                                                  fraction;
+  uint32                                                   jph_body_id;
+} crude_physics_shape_hit;
+
+/**
+ * Caller owned hits buffer, queries never allocate. overflow is set when
+ * hits_capacity was too small, sweeps keep the closest hits then.
+ */
+typedef struct crude_physics_shape_query_result
+{
+  crude_physics_shape_hit                                 *hits;
+  uint32                                                   hits_capacity;
+  uint32                                                   hits_count;
+  bool                                                     overflow;
+} crude_physics_shape_query_result;
+
+/* Contacts of kinematic bodies with static bodies and virtual characters, only added contacts are queued */
+typedef struct crude_physics_contact_event
+{
+  crude_physics_contact_event_type                         type;
+  crude_physics_kinematic_body_handle                      kinematic_body_handle;
+  crude_entity                                             signal_entity;
+  crude_entity                                             hitted_entity;
+  XMFLOAT3                                                 point;
+  /* Points from the signal body to the hitted one */
+  XMFLOAT3                                                 normal;
+} crude_physics_contact_event;
+
+/**
+ * Each task sheduler thread writes only its own buffer during the step,
+ * so pushing an event needs no locks. Buffers are read on the main thread
+ * after the step joined all physics jobs.
+ */
+typedef struct crude_physics_contact_events_buffer
+{
+  crude_physics_contact_event                              events[ CRUDE_PHYSICS_CONTACT_EVENTS_PER_THREAD_MAX ];
+  uint32                                                   events_count;
+  uint32                                                   dropped_events_count;
+  /* Contact manifolds reported during the current step, all motion types */
+  uint32                                                   contacts_count;
+  /* Microseconds spent in contact listener callbacks during the current update */
+  int64                                                    contact_callbacks_time;
+} crude_physics_contact_events_buffer;
+
+/**
+ * Filled by every crude_physics_update, times are in milliseconds. Phase
+ * times are Jolt jobs grouped by name and summed over worker threads and
+ * steps, so they can exceed update_time. Jolt finds body pairs and collides
+ * them in the same jobs, so broad phase is only the tree update, pair queries
+ * are in narrow phase. Contact listener callbacks run inside narrow phase
+ * jobs and are moved to callbacks.
+ */
+typedef struct crude_physics_telemetry
+{
+  float32                                                  update_time;
+  float32                                                  max_step_time;
+  float32                                                  broad_phase_time;
+  float32                                                  narrow_phase_time;
+  float32                                                  solver_time;
+  float32                                                  callbacks_time;
+  float32                                                  other_jobs_time;
+  float32                                                  contact_events_dispatch_time;
+  uint32                                                   steps_count;
+  uint32                                                   collision_steps;
+  uint32                                                   bodies_count;
+  uint32                                                   active_bodies_count;
+  /* Largest number of contact manifolds in one step */
+  uint32                                                   contacts_count;
+  uint32                                                   contact_events_count;
+  /* JPH::EPhysicsUpdateError flags of the last update, Jolt reports only whether body pairs overflowed, not their usage */
+  uint32                                                   update_errors;
+} crude_physics_telemetry;
+
 typedef struct crude_physics_creation
 {
   crude_physics_shapes_manager                            *physics_shapes_manager;
   crude_heap_allocator                                    *physics_allocator;
   crude_physics_system_context                            *physics_system_context;
+  crude_task_sheduler                                     *task_sheduler;
+  /* CRUDE_PHYSICS_JOLT_MAX_BODIES if 0, pairs and contact constraints scale with bodies if 0 */
+  uint32                                                   max_bodies;
+  uint32                                                   max_body_pairs;
+  uint32                                                   max_contact_constraints;
+  /* CRUDE_PHYSICS_JOLT_DELTA_TIME if 0 */
+  float32                                                  step_delta_time;
+  /* CRUDE_PHYSICS_MAX_STEPS_PER_UPDATE if 0 */
+  uint32                                                   max_steps_per_update;
 } crude_physics_creation;
 
 typedef struct crude_physics
@@ -157,6 +589,7 @@ typedef struct crude_physics
   crude_physics_shapes_manager                            *physics_shapes_manager;
   crude_heap_allocator                                    *physics_allocator;
   crude_physics_system_context                            *physics_system_context;
+  crude_task_sheduler                                     *task_sheduler;
   crude_allocator_container                                physics_allocator_container;
   
   /* Common */
@@ -165,16 +598,72 @@ typedef struct crude_physics
   crude_resource_pool                                      kinematic_body_resource_pool;
   bool                                                     simulation_enabled;
   int64                                                    last_update_time;
+
+  /* Capacity */
+  uint32                                                   max_bodies;
+  uint32                                                   max_body_pairs;
+  uint32                                                   max_contact_constraints;
+  bool                                                     bodies_capacity_warned;
+  bool                                                     body_pairs_capacity_warned;
+  bool                                                     contact_constraints_capacity_warned;
+  /* Started and not waited ray cast tasks, resource pools don't grow while it's not 0 */
+  uint32                                                   ray_cast_tasks_in_flight_count;
+  /* JPH::EPhysicsUpdateError flags which were already logged */
+  uint32                                                   update_errors_warned;
+
+  /* Fixed step */
+  float32                                                  step_delta_time;
+  uint32                                                   max_steps_per_update;
+  uint32                                                   collision_steps;
+  float32                                                  accumulated_time;
+  /* Steps done by the last crude_physics_update */
+  uint32                                                   last_update_steps_count;
+  /* Fraction of the step left in the accumulator, used to interpolate bodies for rendering */
+  float32                                                  interpolation_alpha;
+
+  /* Bodies batch */
+  uint32                                                   bodies_batch_depth;
+  /* Handles indices, CRUDE_RESOURCE_INDEX_INVALID for bodies removed before the batch ended */
+  uint32                                                  *batch_added_static_bodies;
+  uint32                                                  *batch_added_kinematic_bodies;
+  JPH::BodyID                                             *batch_removed_bodies;
+  JPH::BodyID                                             *batch_destroyed_bodies;
+  JPH::BodyID                                             *batch_bodies;
+  /* Bodies added since the broad phase tree was rebuilt */
+  uint32                                                   unoptimized_bodies_count;
+
+  /* Sync, handles indices of bodies synced with transforms by the physics systems */
+  /* Characters awake after the last update, asleep ones till their interpolation settled and created or enabled ones */
+  uint32                                                  *sync_characters;
+  /* Static bodies created or enabled since the last sync, resting static bodies aren't synced */
+  uint32                                                  *sync_static_bodies;
+  /* Kinematic bodies awake after the last update and created or enabled ones */
+  uint32                                                  *sync_kinematic_bodies;
     
   /* JPH */
   JPH::PhysicsSystem                                      *jph_physics_system_class;
   JPH::TempAllocatorImpl                                  *jph_temporary_allocator_class;
-  JPH::JobSystemThreadPool                                *jph_job_system_class;
+  _crude_jph_job_system_class                             *jph_job_system_class;
   _crude_jph_bp_layer_interface_class                     *jph_broad_phase_layer_interface_class;
   _crude_jph_object_vs_broad_phase_layer_filter           *jph_object_vs_broadphase_layer_filter_class;
   _crude_jph_object_layer_pair_filter_class               *jph_object_vs_object_layer_filter_class;
   _crude_jph_body_activation_listener_class               *jph_body_activation_listener_class;
   _crude_jph_contact_listener_class                       *jph_contact_listener_class;
+
+  /* Telemetry */
+  crude_physics_telemetry                                  telemetry;
+
+  /* Contact events, one buffer per task sheduler thread */
+  crude_physics_contact_events_buffer                     *contact_events_buffers;
+  uint32                                                   contact_events_buffers_count;
+  bool                                                     contact_events_overflow_warned;
+
+  /* Used by blocking crude_physics_ray_cast_batch */
+  crude_physics_ray_cast_task                              ray_cast_task;
+
+  /* Virtual characters are moved before every step */
+  _crude_jph_character_vs_character_collision_class       *jph_character_vs_character_collision_class;
+  crude_physics_virtual_characters_task                    virtual_characters_task;
 } crude_physics;
 
 CRUDE_API void
@@ -198,6 +687,53 @@ crude_physics_update
   _In_ int64                                               current_time
 );
 
+/**
+ * Drops accumulated time, the next crude_physics_update measures the delta
+ * from current_time. Used when the engine clock jumps, e.g. input replay start.
+ */
+CRUDE_API void
+crude_physics_reset_time
+(
+  _In_ crude_physics                                      *physics,
+  _In_ int64                                               current_time
+);
+
+/**
+ * Static and kinematic bodies created between begin and end are added to
+ * the broad phase together, destroyed bodies are removed together. Batches
+ * could be nested, bodies are committed when the outer one ends.
+ */
+CRUDE_API void
+crude_physics_begin_bodies_batch
+(
+  _In_ crude_physics                                      *physics
+);
+
+CRUDE_API void
+crude_physics_end_bodies_batch
+(
+  _In_ crude_physics                                      *physics
+);
+
+/**
+ * Rebuilds the broad phase tree once at least CRUDE_PHYSICS_OPTIMIZE_BROAD_PHASE_BODIES_COUNT
+ * bodies were added since the last rebuild. Node loads call it when they complete, so
+ * bodies committed over several frames are counted together.
+ */
+CRUDE_API void
+crude_physics_optimize_broad_phase
+(
+  _In_ crude_physics                                      *physics
+);
+
+/* Could be used to lower the tick rate on weak CPUs, bodies are interpolated between steps anyway */
+CRUDE_API void
+crude_physics_set_step_delta_time
+(
+  _In_ crude_physics                                      *physics,
+  _In_ float32                                             step_delta_time
+);
+
 CRUDE_API void
 crude_physics_enable_simulation
 (
@@ -242,6 +778,42 @@ crude_physics_destroy_character_instant
   _In_ crude_physics_character_handle                      handle
 );
 
+CRUDE_API void
+crude_physics_enable_character
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_character_handle                      handle,
+  _In_ bool                                                enable
+);
+
+/* Works for both rigid and virtual characters */
+CRUDE_API XMVECTOR
+crude_physics_character_get_linear_velocity
+(
+  _In_ crude_physics_character_container const           *character_container
+);
+
+CRUDE_API void
+crude_physics_character_set_linear_velocity
+(
+  _In_ crude_physics_character_container                  *character_container,
+  _In_ XMVECTOR                                            velocity
+);
+
+CRUDE_API JPH::RMat44
+crude_physics_character_get_world_transform
+(
+  _In_ crude_physics_character_container const           *character_container
+);
+
+CRUDE_API void
+crude_physics_character_set_position_and_rotation
+(
+  _In_ crude_physics_character_container                  *character_container,
+  _In_ XMVECTOR                                            translation,
+  _In_ XMVECTOR                                            rotation
+);
+
 CRUDE_API crude_physics_static_body_handle
 crude_physics_create_static_body
 (
@@ -263,6 +835,14 @@ crude_physics_destroy_static_body_instant
   _In_ crude_physics_static_body_handle                    handle
 );
 
+CRUDE_API void
+crude_physics_enable_static_body
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_static_body_handle                    handle,
+  _In_ bool                                                enable
+);
+
 CRUDE_API crude_physics_kinematic_body_handle
 crude_physics_create_kinematic_body
 (
@@ -284,6 +864,14 @@ crude_physics_destroy_kinematic_body_instant
   _In_ crude_physics_kinematic_body_handle                 handle
 );
 
+CRUDE_API void
+crude_physics_enable_kinematic_body
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_kinematic_body_handle                 handle,
+  _In_ bool                                                enable
+);
+
 CRUDE_API bool
 crude_physics_ray_cast
 (
@@ -294,4 +882,83 @@ crude_physics_ray_cast
   _In_ uint8                                               broad_phase_mask,
   _In_ uint32                                              layer_mask,
   _Out_ crude_ray_cast_result                             *ray_cast_result
-);
\ No newline at end of file
+);
+
+/* Blocks until all rays are done, results[ i ] matches queries[ i ] */
+CRUDE_API void
+crude_physics_ray_cast_batch
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_ray_cast_query const                 *queries,
+  _In_ uint32                                              queries_count,
+  _Out_ crude_physics_ray_cast_batch_result               *results
+);
+
+CRUDE_API void
+crude_physics_ray_cast_task_initialize
+(
+  _In_ crude_physics_ray_cast_task                        *task,
+  _In_ crude_physics                                      *physics
+);
+
+CRUDE_API void
+crude_physics_ray_cast_task_deinitialize
+(
+  _In_ crude_physics_ray_cast_task                        *task
+);
+
+/* Previous rays of the task have to be waited before */
+CRUDE_API void
+crude_physics_ray_cast_task_start
+(
+  _In_ crude_physics_ray_cast_task                        *task,
+  _In_ crude_physics_ray_cast_query const                 *queries,
+  _In_ uint32                                              queries_count,
+  _Out_ crude_physics_ray_cast_batch_result               *results
+);
+
+CRUDE_API void
+crude_physics_ray_cast_task_wait
+(
+  _In_ crude_physics_ray_cast_task                        *task
+);
+
+/**
+ * Calls contact_added_callback of kinematic bodies for contacts queued by
+ * the last crude_physics_update. Runs on the main thread in the
+ * crude_ecs_on_physics_contacts phase, callbacks are free to touch the world.
+ */
+CRUDE_API void
+crude_physics_dispatch_contact_events
+(
+  _In_ crude_physics                                      *physics
+);
+
+/* Sweeps the shape along direction, hits are sorted by fraction */
+CRUDE_API void
+crude_physics_shape_cast
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_query_shape const                    *shape,
+  _In_ XMVECTOR                                            direction,
+  _In_ uint8                                               broad_phase_mask,
+  _In_ uint32                                              layer_mask,
+  _Inout_ crude_physics_shape_query_result                *result
+);
+
+CRUDE_API void
+crude_physics_shape_overlap
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_query_shape const                    *shape,
+  _In_ uint8                                               broad_phase_mask,
+  _In_ uint32                                              layer_mask,
+  _Inout_ crude_physics_shape_query_result                *result
+);
+
+CRUDE_API crude_physics_shape_query_result
+crude_physics_shape_query_result_empty
+(
+  _In_ crude_physics_shape_hit                            *hits,
+  _In_ uint32                                              hits_capacity
+);
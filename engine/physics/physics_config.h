@@ -1,11 +1,35 @@
 #pragma once
 
+// Defaults, environment "physics" section overrides them. Pairs and contact constraints scale with bodies when only bodies are set
 #define CRUDE_PHYSICS_JOLT_MAX_BODIES                      1024
 #define CRUDE_PHYSICS_JOLT_NUM_BODIES_MUTEXES              0
 #define CRUDE_PHYSICS_JOLT_MAX_BODIES_PAIRS                1024
 #define CRUDE_PHYSICS_JOLT_MAX_CONTACT_CONSTRAINTS         1024
+// Warning is logged once bodies or contacts count reaches this part of the limit
+#define CRUDE_PHYSICS_CAPACITY_WARNING_RATIO               0.9f
 #define CRUDE_PHYSICS_JOLT_DELTA_TIME                      ( 1 / 60.f )
 // If you take larger steps than 1 / 60th of a second you need to do multiple collision steps in order to keep the simulation stable. Do 1 collision step per 1 / 60th of a second (round up).
-#define CRUDE_PHYSICS_JOLT_COLLISIONS_STEPS                1
+#define CRUDE_PHYSICS_JOLT_COLLISIONS_STEPS_DELTA_TIME     ( 1 / 60.f )
+// Accumulated time above this number of steps is dropped, so a long frame doesn't cause even longer one
+#define CRUDE_PHYSICS_MAX_STEPS_PER_UPDATE                 4
+// Node load adding at least this number of bodies rebuilds the broad phase tree once it completes
+#define CRUDE_PHYSICS_OPTIMIZE_BROAD_PHASE_BODIES_COUNT    256
+// Bodies whose world pose moved less than this since the last sync aren't pushed to Jolt
+#define CRUDE_PHYSICS_POSE_SYNC_EPSILON                    1e-5f
+// Contact events one physics thread could queue between two dispatches, the rest is dropped
+#define CRUDE_PHYSICS_CONTACT_EVENTS_PER_THREAD_MAX        256
+// Smallest number of rays one task sheduler worker takes from a batch
+#define CRUDE_PHYSICS_RAY_CAST_BATCH_MIN_RANGE             16
+// Temporary allocator of every task sheduler thread updating virtual characters
+#define CRUDE_PHYSICS_VIRTUAL_CHARACTER_TEMPORARY_ALLOCATOR_SIZE ( 256 * 1024 )
+// Added to the distance virtual character could move in one step, covers padding, stairs and predictive contacts
+#define CRUDE_PHYSICS_VIRTUAL_CHARACTER_MOVE_MARGIN        0.5f
+// Smallest number of virtual character cells one task sheduler worker takes
+#define CRUDE_PHYSICS_VIRTUAL_CHARACTER_CELLS_MIN_RANGE    4
+// Bump when mesh shape building changes, so cooked shapes from the older build are rebuilt
+#define CRUDE_PHYSICS_MESH_SHAPE_CACHE_VERSION             2
+#define CRUDE_PHYSICS_MESH_SHAPE_CACHE_MAGIC               0x4853504A /* JPSH */
+// Subdirectory of the cache directory for cooked mesh shapes
+#define CRUDE_PHYSICS_MESH_SHAPE_CACHE_DIRECTORY           "physics_shapes_cache"
 
 #define CRUDE_PHYSICS_OCTREE_RELATIVE_FILEPATH_LENGTH_MAX  1024
\ No newline at end of file
@@ -67,6 +67,7 @@ CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_IMPLEMENTATION( crude_physics_character )
   component->friction = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( component_json, "friction" ) );
   component->max_slop_angle = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( component_json, "max_slop_angle" ) );
   component->layers = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( component_json, "layers" ) );
+  component->virtual_character = cJSON_IsTrue( cJSON_GetObjectItemCaseSensitive( component_json, "virtual_character" ) );
   return true;
 }
 
@@ -79,6 +80,10 @@ CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_IMPLEMENTATION( crude_physics_character )
   cJSON_AddItemToObject( static_body_json, "friction", cJSON_CreateNumber( component->friction ) );
   cJSON_AddItemToObject( static_body_json, "max_slop_angle", cJSON_CreateNumber( component->max_slop_angle ) );
   cJSON_AddItemToObject( static_body_json, "layers", cJSON_CreateNumber( component->layers ) );
+  if ( component->virtual_character )
+  {
+    cJSON_AddItemToObject( static_body_json, "virtual_character", cJSON_CreateBool( component->virtual_character ) );
+  }
   return static_body_json;
 }
 
@@ -97,6 +102,10 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_physics_character )
   CRUDE_IMGUI_OPTION( "Character Radius", {
     modified |= ImGui::DragFloat( "##Character Radius", &component->radius, 0.1f );  
     } );
+
+  CRUDE_IMGUI_OPTION( "Virtual", {
+    modified |= ImGui::Checkbox( "##Virtual", &component->virtual_character );  
+    } );
   
   CRUDE_IMGUI_OPTION( "Flags", {
     ImGui::Spacing( );
@@ -141,8 +150,8 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_physics_character_hand
 
   character_container = crude_physics_access_character( manager->physics_manager, *component );
   
-  jph_wolrd_transform = character_container->jph_character_class->GetWorldTransform( );
-  jph_velocity = character_container->jph_character_class->GetLinearVelocity( );
+  jph_wolrd_transform = crude_physics_character_get_world_transform( character_container );
+  jph_velocity = crude_vector_to_jph_vec3( crude_physics_character_get_linear_velocity( character_container ) );
 
   ImGui::LabelText( "World Transform", "%f %f %f", jph_wolrd_transform.GetTranslation( ).GetX( ), jph_wolrd_transform.GetTranslation( ).GetY( ), jph_wolrd_transform.GetTranslation( ).GetZ( ) );
   ImGui::LabelText( "World Rotation", "%f %f %f %f", jph_wolrd_transform.GetQuaternion( ).GetX( ), jph_wolrd_transform.GetQuaternion( ).GetY( ), jph_wolrd_transform.GetQuaternion( ).GetZ( ), jph_wolrd_transform.GetQuaternion( ).GetW( ) );
@@ -471,16 +480,22 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_physics_kinematic_body
  *********************************************************/
 CRUDE_ECS_SYSTEM_DECLARE( crude_physics_system );
 
+CRUDE_ECS_SYSTEM_DECLARE( crude_physics_contact_events_system_ );
 CRUDE_ECS_SYSTEM_DECLARE( crude_physics_character_pre_simulation_system_ );
 CRUDE_ECS_SYSTEM_DECLARE( crude_physics_character_post_simulation_system_ );
 CRUDE_ECS_SYSTEM_DECLARE( crude_physics_static_body_post_simulation_system_ );
 CRUDE_ECS_SYSTEM_DECLARE( crude_physics_kinematic_body_post_simulation_system_ );
+CRUDE_ECS_SYSTEM_DECLARE( crude_physics_character_sync_system_ );
+CRUDE_ECS_SYSTEM_DECLARE( crude_physics_static_body_sync_system_ );
+CRUDE_ECS_SYSTEM_DECLARE( crude_physics_kinematic_body_sync_system_ );
 CRUDE_ECS_OBSERVER_DECLARE( crude_physics_character_destroy_observer_ );
 CRUDE_ECS_OBSERVER_DECLARE( crude_physics_character_create_observer_ );
 CRUDE_ECS_OBSERVER_DECLARE( crude_physics_static_body_destroy_observer_ );
 CRUDE_ECS_OBSERVER_DECLARE( crude_physics_static_body_create_observer_ );
 CRUDE_ECS_OBSERVER_DECLARE( crude_physics_kinematic_body_destroy_observer_ );
 CRUDE_ECS_OBSERVER_DECLARE( crude_physics_kinematic_body_create_observer_ );
+CRUDE_ECS_OBSERVER_DECLARE( crude_physics_static_body_transform_observer_ );
+CRUDE_ECS_OBSERVER_DECLARE( crude_physics_kinematic_body_transform_observer_ );
 
 static void
 crude_physics_character_create_observer_
@@ -518,6 +533,18 @@ crude_physics_kinematic_body_destroy_observer_
   _In_ ecs_iter_t                                         *it
 );
 
+static void
+crude_physics_static_body_transform_observer_
+(
+  _In_ ecs_iter_t                                         *it
+);
+
+static void
+crude_physics_kinematic_body_transform_observer_
+(
+  _In_ ecs_iter_t                                         *it
+);
+
 static void
 crude_physics_character_pre_simulation_system_
 (
@@ -542,6 +569,84 @@ crude_physics_kinematic_body_post_simulation_system_
   _In_ ecs_iter_t                                         *it
 );
 
+static void
+crude_physics_character_sync_system_
+(
+  _In_ ecs_iter_t                                         *it
+);
+
+static void
+crude_physics_static_body_sync_system_
+(
+  _In_ ecs_iter_t                                         *it
+);
+
+static void
+crude_physics_kinematic_body_sync_system_
+(
+  _In_ ecs_iter_t                                         *it
+);
+
+static void
+crude_physics_character_pre_simulation_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_character_container                  *character_container,
+  _In_ crude_transform                                    *transform
+);
+
+static void
+crude_physics_character_post_simulation_
+(
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_character_container                  *character_container,
+  _In_ crude_transform const                              *transform
+);
+
+static void
+crude_physics_static_body_post_simulation_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_static_body_container                *static_body_container,
+  _In_ crude_transform const                              *transform
+);
+
+static void
+crude_physics_kinematic_body_post_simulation_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_kinematic_body_container             *kinematic_body_container,
+  _In_ crude_transform const                              *transform
+);
+
+/* Kinematic bodies attached to an awake character follow it even when Jolt put them to sleep */
+static void
+crude_physics_kinematic_body_post_simulation_children_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+);
+
+static void
+crude_physics_contact_events_system_
+(
+  _In_ ecs_iter_t                                         *it
+);
+
+/* Returns true and stores the pose if it moved more than CRUDE_PHYSICS_POSE_SYNC_EPSILON */
+static bool
+crude_physics_sync_pose_
+(
+  _In_ XMVECTOR                                            translation,
+  _In_ XMVECTOR                                            rotation,
+  _Inout_ XMFLOAT3                                        *synced_translation,
+  _Inout_ XMFLOAT4                                        *synced_rotation,
+  _Inout_ bool                                            *pose_synced
+);
+
 void
 crude_physics_system_import
 (
@@ -558,8 +663,10 @@ crude_physics_system_import
     { .id = ecs_id( crude_physics_character ), .oper = EcsAnd }
   } );
   
+  /* Destroy observers match disabled entities, pooled nodes are destroyed disabled */
   CRUDE_ECS_OBSERVER_DEFINE( world, crude_physics_character_destroy_observer_, EcsOnRemove, ctx, { 
-    { .id = ecs_id( crude_physics_character ), .oper = EcsAnd }
+    { .id = ecs_id( crude_physics_character ), .oper = EcsAnd },
+    { .id = EcsDisabled, .oper = EcsOptional }
   } );
   
   CRUDE_ECS_OBSERVER_DEFINE( world, crude_physics_kinematic_body_create_observer_, EcsOnSet, ctx, { 
@@ -567,7 +674,8 @@ crude_physics_system_import
   } );
   
   CRUDE_ECS_OBSERVER_DEFINE( world, crude_physics_kinematic_body_destroy_observer_, EcsOnRemove, ctx, { 
-    { .id = ecs_id( crude_physics_kinematic_body ), .oper = EcsAnd }
+    { .id = ecs_id( crude_physics_kinematic_body ), .oper = EcsAnd },
+    { .id = EcsDisabled, .oper = EcsOptional }
   } );
   
   CRUDE_ECS_OBSERVER_DEFINE( world, crude_physics_static_body_create_observer_, EcsOnSet, ctx, { 
@@ -575,25 +683,42 @@ crude_physics_system_import
   } );
   
   CRUDE_ECS_OBSERVER_DEFINE( world, crude_physics_static_body_destroy_observer_, EcsOnRemove, ctx, { 
-    { .id = ecs_id( crude_physics_static_body ), .oper = EcsAnd }
+    { .id = ecs_id( crude_physics_static_body ), .oper = EcsAnd },
+    { .id = EcsDisabled, .oper = EcsOptional }
   } );
 
-  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_character_pre_simulation_system_, crude_ecs_on_pre_physics_update, ctx, { 
-    { .id = ecs_id( crude_physics_character_handle ) },
-    { .id = ecs_id( crude_transform ) }
+  /* Resting static and kinematic bodies aren't synced by the simulation systems, so moving the node pushes the pose right away.
+   * Only the node's own transform is observed, bodies under a moved parent follow it only while they are active */
+  CRUDE_ECS_OBSERVER_DEFINE( world, crude_physics_static_body_transform_observer_, EcsOnSet, ctx, { 
+    { .id = ecs_id( crude_transform ), .oper = EcsAnd },
+    { .id = ecs_id( crude_physics_static_body_handle ), .inout = EcsInOutFilter, .oper = EcsAnd }
+  } );
+  
+  CRUDE_ECS_OBSERVER_DEFINE( world, crude_physics_kinematic_body_transform_observer_, EcsOnSet, ctx, { 
+    { .id = ecs_id( crude_transform ), .oper = EcsAnd },
+    { .id = ecs_id( crude_physics_kinematic_body_handle ), .inout = EcsInOutFilter, .oper = EcsAnd }
   } );
 
-  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_character_post_simulation_system_, crude_ecs_on_post_physics_update, ctx, { 
+  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_contact_events_system_, crude_ecs_on_physics_contacts, ctx, { } );
+
+  /* Simulation systems only walk the physics sync lists, sleeping and resting bodies cost nothing */
+  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_character_pre_simulation_system_, crude_ecs_on_pre_physics_update, ctx, { } );
+  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_character_post_simulation_system_, crude_ecs_on_post_physics_update, ctx, { } );
+  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_static_body_post_simulation_system_, crude_ecs_on_post_physics_update, ctx, { } );
+  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_kinematic_body_post_simulation_system_, crude_ecs_on_post_physics_update, ctx, { } );
+
+  /* Not in the pipeline, all bodies are synced by crude_physics_run_system_on_start */
+  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_character_sync_system_, 0, ctx, { 
     { .id = ecs_id( crude_physics_character_handle ) },
     { .id = ecs_id( crude_transform ) }
   } );
 
-  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_static_body_post_simulation_system_, crude_ecs_on_post_physics_update, ctx, { 
+  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_static_body_sync_system_, 0, ctx, { 
     { .id = ecs_id( crude_physics_static_body_handle ) },
     { .id = ecs_id( crude_transform ) }
   } );
 
-  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_kinematic_body_post_simulation_system_, crude_ecs_on_post_physics_update, ctx, { 
+  CRUDE_ECS_SYSTEM_DEFINE( world, crude_physics_kinematic_body_sync_system_, 0, ctx, { 
     { .id = ecs_id( crude_physics_kinematic_body_handle ) },
     { .id = ecs_id( crude_transform ) }
   } );  
@@ -605,9 +730,9 @@ crude_physics_run_system_on_start
   _In_ crude_ecs                                          *world
 )
 {
-  ecs_run( world, ecs_id( crude_physics_character_post_simulation_system_ ), 0, NULL );
-  ecs_run( world, ecs_id( crude_physics_static_body_post_simulation_system_ ), 0, NULL );
-  ecs_run( world, ecs_id( crude_physics_kinematic_body_post_simulation_system_ ), 0, NULL );
+  ecs_run( world, ecs_id( crude_physics_character_sync_system_ ), 0, NULL );
+  ecs_run( world, ecs_id( crude_physics_static_body_sync_system_ ), 0, NULL );
+  ecs_run( world, ecs_id( crude_physics_kinematic_body_sync_system_ ), 0, NULL );
 }
 
 void
@@ -643,6 +768,8 @@ crude_physics_character_create_observer_
     character_creation.friction = character->friction;
     character_creation.max_slop_angle = character->max_slop_angle;
     character_creation.layers = character->layers;
+    character_creation.virtual_character = character->virtual_character;
+    character_creation.entity = it->entities[ i ];
 
     character_handle = crude_physics_create_character( ctx->physics, &character_creation );
     CRUDE_ENTITY_SET_COMPONENT( it->world, it->entities[ i ], crude_physics_character_handle, { character_handle } );
@@ -722,6 +849,11 @@ crude_physics_static_body_create_observer_
     }
     
     static_body_handle = crude_physics_create_static_body( ctx->physics, &static_body_creation );
+    if ( CRUDE_RESOURCE_HANDLE_IS_INVALID( static_body_handle ) )
+    {
+      CRUDE_ENTITY_REMOVE_COMPONENT( it->world, it->entities[ i ], crude_physics_static_body_handle );
+      continue;
+    }
     CRUDE_ENTITY_SET_COMPONENT( it->world, it->entities[ i ], crude_physics_static_body_handle, { static_body_handle } );
   }
 }
@@ -801,6 +933,11 @@ crude_physics_kinematic_body_create_observer_
     }
     
     kinematic_body_handle = crude_physics_create_kinematic_body( ctx->physics, &kinematic_body_creation );
+    if ( CRUDE_RESOURCE_HANDLE_IS_INVALID( kinematic_body_handle ) )
+    {
+      CRUDE_ENTITY_REMOVE_COMPONENT( it->world, it->entities[ i ], crude_physics_kinematic_body_handle );
+      continue;
+    }
     CRUDE_ENTITY_SET_COMPONENT( it->world, it->entities[ i ], crude_physics_kinematic_body_handle, { kinematic_body_handle } );
   }
 }
@@ -838,90 +975,97 @@ crude_physics_kinematic_body_destroy_observer_
 }
 
 void
-crude_physics_character_pre_simulation_system_
+crude_physics_static_body_transform_observer_
 (
   _In_ ecs_iter_t                                         *it
 )
 {
   crude_physics_system_context                            *ctx;
-  crude_physics_character_handle                          *character_handle_per_entity;
   crude_transform                                         *transform_per_entity;
+  crude_physics_static_body_handle                        *static_body_handle_per_entity;
 
-  CRUDE_PROFILER_ZONE_NAME( "crude_physics_character_pre_simulation_system_" );
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_static_body_transform_observer_" );
 
   ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
-  character_handle_per_entity = ecs_field( it, crude_physics_character_handle, 0 );
-  transform_per_entity = ecs_field( it, crude_transform, 1 );
+  transform_per_entity = ecs_field( it, crude_transform, 0 );
+  static_body_handle_per_entity = ecs_field( it, crude_physics_static_body_handle, 1 );
 
   for ( uint32 i = 0; i < it->count; ++i )
   {
-    crude_physics_character_handle                        *character_handle;
-    crude_transform                                       *transform;
-    crude_physics_character_container                     *character_container;
-    XMVECTOR                                               rotation_diff;
-    XMVECTOR                                               translation_diff;
-    JPH::RMat44                                            jph_world_transform;
-    
-    character_handle = &character_handle_per_entity[ i ];
-    transform = &transform_per_entity[ i ]; 
-    
-    character_container = crude_physics_access_character( ctx->physics, character_handle[ i ] );
-    character_container->jph_character_class->PostSimulation( 0.05f );
+    crude_physics_static_body_post_simulation_( ctx->physics, it->world, crude_physics_access_static_body( ctx->physics, static_body_handle_per_entity[ i ] ), &transform_per_entity[ i ] );
+  }
 
-    rotation_diff = XMQuaternionMultiply(
-      crude_jph_quat_to_vector( character_container->jph_character_class->GetRotation( ) ),
-      XMQuaternionInverse(
-        crude_jph_quat_to_vector( character_container->manually_stored_transform.GetQuaternion( ) )
-      ) );
+  CRUDE_PROFILER_ZONE_END;
+}
 
-    translation_diff = XMVectorSubtract(
-      crude_jph_vec3_to_vector( character_container->jph_character_class->GetPosition( ) ),
-      crude_jph_vec3_to_vector( character_container->manually_stored_transform.GetTranslation( ) ) );
+void
+crude_physics_kinematic_body_transform_observer_
+(
+  _In_ ecs_iter_t                                         *it
+)
+{
+  crude_physics_system_context                            *ctx;
+  crude_transform                                         *transform_per_entity;
+  crude_physics_kinematic_body_handle                     *kinematic_body_handle_per_entity;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_kinematic_body_transform_observer_" );
+
+  ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
+  transform_per_entity = ecs_field( it, crude_transform, 0 );
+  kinematic_body_handle_per_entity = ecs_field( it, crude_physics_kinematic_body_handle, 1 );
 
-    XMStoreFloat3( &transform->translation, XMVectorAdd( XMLoadFloat3( &transform->translation ), translation_diff ) );
-    XMStoreFloat4( &transform->rotation, XMQuaternionMultiply( XMLoadFloat4( &transform->rotation ), rotation_diff ) );
+  /* Moved body is activated, so it's synced by the simulation systems till Jolt puts it to sleep again */
+  for ( uint32 i = 0; i < it->count; ++i )
+  {
+    crude_physics_kinematic_body_post_simulation_( ctx->physics, it->world, crude_physics_access_kinematic_body( ctx->physics, kinematic_body_handle_per_entity[ i ] ), &transform_per_entity[ i ] );
   }
-cleanup:
+
   CRUDE_PROFILER_ZONE_END;
 }
 
 void
-crude_physics_character_post_simulation_system_
+crude_physics_character_pre_simulation_system_
 (
   _In_ ecs_iter_t                                         *it
 )
 {
   crude_physics_system_context                            *ctx;
-  crude_physics_character_handle                          *character_handle_per_entity;
-  crude_transform                                         *transform_per_entity;
 
-  CRUDE_PROFILER_ZONE_NAME( "crude_physics_character_post_simulation_system_" );
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_character_pre_simulation_system_" );
 
   ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
-  character_handle_per_entity = ecs_field( it, crude_physics_character_handle, 0 );
-  transform_per_entity = ecs_field( it, crude_transform, 1 );
 
-  for ( uint32 i = 0; i < it->count; ++i )
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( ctx->physics->sync_characters ); ++i )
   {
-    crude_physics_character_handle                        *character_handle;
-    crude_transform                                       *transform;
     crude_physics_character_container                     *character_container;
-    XMMATRIX                                               node_to_world;
-    XMVECTOR                                               scale, translation, rotation;
     
-    character_handle = &character_handle_per_entity[ i ];
-    transform = &transform_per_entity[ i ]; 
-    
-    character_container = crude_physics_access_character( ctx->physics,*character_handle );
+    character_container = crude_physics_access_character( ctx->physics, CRUDE_COMPOUNT( crude_physics_character_handle, { ctx->physics->sync_characters[ i ] } ) );
+    crude_physics_character_pre_simulation_( ctx->physics, character_container, CRUDE_ENTITY_GET_MUTABLE_COMPONENT( it->world, character_container->entity, crude_transform ) );
+  }
 
-    node_to_world = crude_transform_node_to_world( it->world, it->entities[ i ], transform );
+  CRUDE_PROFILER_ZONE_END;
+}
 
-    XMMatrixDecompose( &scale, &rotation, &translation, node_to_world );
+void
+crude_physics_character_post_simulation_system_
+(
+  _In_ ecs_iter_t                                         *it
+)
+{
+  crude_physics_system_context                            *ctx;
 
-    character_container->jph_character_class->SetPositionAndRotation( crude_vector_to_jph_vec3( translation ), crude_vector_to_jph_quat( rotation ) );
-    character_container->manually_stored_transform = character_container->jph_character_class->GetWorldTransform( );
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_character_post_simulation_system_" );
+
+  ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( ctx->physics->sync_characters ); ++i )
+  {
+    crude_physics_character_container                     *character_container;
+    
+    character_container = crude_physics_access_character( ctx->physics, CRUDE_COMPOUNT( crude_physics_character_handle, { ctx->physics->sync_characters[ i ] } ) );
+    crude_physics_character_post_simulation_( it->world, character_container, CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( it->world, character_container->entity, crude_transform ) );
   }
-cleanup:
+
   CRUDE_PROFILER_ZONE_END;
 }
 
@@ -932,79 +1076,335 @@ crude_physics_static_body_post_simulation_system_
 )
 {
   crude_physics_system_context                            *ctx;
-  crude_physics_static_body_handle                        *static_body_handle_per_entity;
-  crude_transform                                         *transform_per_entity;
-  JPH::BodyInterface                                      *jph_body_interface_class;
 
   CRUDE_PROFILER_ZONE_NAME( "crude_physics_static_body_post_simulation_system_" );
 
   ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
-  static_body_handle_per_entity = ecs_field( it, crude_physics_static_body_handle, 0 );
-  transform_per_entity = ecs_field( it, crude_transform, 1 );
 
-  jph_body_interface_class = &ctx->physics->jph_physics_system_class->GetBodyInterface( );  
-
-  for ( uint32 i = 0; i < it->count; ++i )
+  /* Static bodies are pushed once after they were created or enabled */
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( ctx->physics->sync_static_bodies ); ++i )
   {
-    crude_physics_static_body_handle                      *static_body_handle;
-    crude_transform                                       *transform;
     crude_physics_static_body_container                   *static_body_container;
-    XMMATRIX                                               node_to_world;
-    XMVECTOR                                               scale, translation, rotation;
     
-    static_body_handle = &static_body_handle_per_entity[ i ];
-    transform = &transform_per_entity[ i ]; 
-    
-    static_body_container = crude_physics_access_static_body( ctx->physics, *static_body_handle );
+    static_body_container = crude_physics_access_static_body( ctx->physics, CRUDE_COMPOUNT( crude_physics_static_body_handle, { ctx->physics->sync_static_bodies[ i ] } ) );
+    crude_physics_static_body_post_simulation_( ctx->physics, it->world, static_body_container, CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( it->world, static_body_container->entity, crude_transform ) );
+  }
+  CRUDE_ARRAY_SET_LENGTH( ctx->physics->sync_static_bodies, 0u );
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_physics_kinematic_body_post_simulation_system_
+(
+  _In_ ecs_iter_t                                         *it
+)
+{
+  crude_physics_system_context                            *ctx;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_kinematic_body_post_simulation_system_" );
 
-    node_to_world = crude_transform_node_to_world( it->world, it->entities[ i ], transform );
+  ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
 
-    XMMatrixDecompose( &scale, &rotation, &translation, node_to_world );
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( ctx->physics->sync_kinematic_bodies ); ++i )
+  {
+    crude_physics_kinematic_body_container                *kinematic_body_container;
+    
+    kinematic_body_container = crude_physics_access_kinematic_body( ctx->physics, CRUDE_COMPOUNT( crude_physics_kinematic_body_handle, { ctx->physics->sync_kinematic_bodies[ i ] } ) );
+    crude_physics_kinematic_body_post_simulation_( ctx->physics, it->world, kinematic_body_container, CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( it->world, kinematic_body_container->entity, crude_transform ) );
+  }
 
-    jph_body_interface_class->SetPositionAndRotation( static_body_container->jph_body_class, crude_vector_to_jph_vec3( translation ), crude_vector_to_jph_quat( rotation ), JPH::EActivation::DontActivate );
+  /* Bodies already pushed this frame don't move again, their synced pose is equal */
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( ctx->physics->sync_characters ); ++i )
+  {
+    crude_physics_kinematic_body_post_simulation_children_( ctx->physics, it->world, crude_physics_access_character( ctx->physics, CRUDE_COMPOUNT( crude_physics_character_handle, { ctx->physics->sync_characters[ i ] } ) )->entity );
   }
-cleanup:
+
   CRUDE_PROFILER_ZONE_END;
 }
 
 void
-crude_physics_kinematic_body_post_simulation_system_
+crude_physics_character_sync_system_
 (
   _In_ ecs_iter_t                                         *it
 )
 {
   crude_physics_system_context                            *ctx;
-  crude_physics_kinematic_body_handle                     *kinematic_body_handle_per_entity;
+  crude_physics_character_handle                          *character_handle_per_entity;
   crude_transform                                         *transform_per_entity;
-  JPH::BodyInterface                                      *jph_body_interface_class;
 
-  CRUDE_PROFILER_ZONE_NAME( "crude_physics_kinematic_body_post_simulation_system_" );
+  ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
+  character_handle_per_entity = ecs_field( it, crude_physics_character_handle, 0 );
+  transform_per_entity = ecs_field( it, crude_transform, 1 );
+
+  for ( uint32 i = 0; i < it->count; ++i )
+  {
+    crude_physics_character_post_simulation_( it->world, crude_physics_access_character( ctx->physics, character_handle_per_entity[ i ] ), &transform_per_entity[ i ] );
+  }
+}
+
+void
+crude_physics_static_body_sync_system_
+(
+  _In_ ecs_iter_t                                         *it
+)
+{
+  crude_physics_system_context                            *ctx;
+  crude_physics_static_body_handle                        *static_body_handle_per_entity;
+  crude_transform                                         *transform_per_entity;
 
   ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
-  kinematic_body_handle_per_entity = ecs_field( it, crude_physics_kinematic_body_handle, 0 );
+  static_body_handle_per_entity = ecs_field( it, crude_physics_static_body_handle, 0 );
   transform_per_entity = ecs_field( it, crude_transform, 1 );
 
-  jph_body_interface_class = &ctx->physics->jph_physics_system_class->GetBodyInterface( );  
+  for ( uint32 i = 0; i < it->count; ++i )
+  {
+    crude_physics_static_body_post_simulation_( ctx->physics, it->world, crude_physics_access_static_body( ctx->physics, static_body_handle_per_entity[ i ] ), &transform_per_entity[ i ] );
+  }
+}
+
+void
+crude_physics_kinematic_body_sync_system_
+(
+  _In_ ecs_iter_t                                         *it
+)
+{
+  crude_physics_system_context                            *ctx;
+  crude_physics_kinematic_body_handle                     *kinematic_body_handle_per_entity;
+  crude_transform                                         *transform_per_entity;
+
+  ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
+  kinematic_body_handle_per_entity = ecs_field( it, crude_physics_kinematic_body_handle, 0 );
+  transform_per_entity = ecs_field( it, crude_transform, 1 );
 
   for ( uint32 i = 0; i < it->count; ++i )
   {
-    crude_physics_kinematic_body_handle                   *kinematic_body_handle;
-    crude_transform                                       *transform;
-    crude_physics_kinematic_body_container                *kinematic_body_container;
-    XMMATRIX                                               node_to_world;
-    XMVECTOR                                               scale, translation, rotation;
-    
-    kinematic_body_handle = &kinematic_body_handle_per_entity[ i ];
-    transform = &transform_per_entity[ i ]; 
-    
-    kinematic_body_container = crude_physics_access_kinematic_body( ctx->physics, *kinematic_body_handle );
+    crude_physics_kinematic_body_post_simulation_( ctx->physics, it->world, crude_physics_access_kinematic_body( ctx->physics, kinematic_body_handle_per_entity[ i ] ), &transform_per_entity[ i ] );
+  }
+}
+
+void
+crude_physics_character_pre_simulation_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_physics_character_container                  *character_container,
+  _In_ crude_transform                                    *transform
+)
+{
+  XMVECTOR                                                 rotation_diff;
+  XMVECTOR                                                 translation_diff;
+  XMVECTOR                                                 simulated_translation, simulated_rotation;
+  XMVECTOR                                                 stored_translation, stored_rotation;
+  XMVECTOR                                                 previous_translation, previous_rotation;
+  XMVECTOR                                                 current_translation, current_rotation;
+  XMVECTOR                                                 rendered_translation, rendered_rotation;
+  XMVECTOR                                                 offset_translation, offset_rotation;
+  JPH::RMat44                                              jph_world_transform;
+
+  /* Sleeping character keeps its pose, the transform is left untouched once interpolation settled */
+  if ( !character_container->active && character_container->inactive_synced )
+  {
+    return;
+  }
+
+  /* Virtual characters are already moved by crude_physics_update */
+  if ( character_container->jph_character_class )
+  {
+    character_container->jph_character_class->PostSimulation( 0.05f );
+  }
+
+  jph_world_transform = crude_physics_character_get_world_transform( character_container );
+  simulated_translation = crude_jph_vec3_to_vector( jph_world_transform.GetTranslation( ) );
+  simulated_rotation = crude_jph_quat_to_vector( jph_world_transform.GetQuaternion( ) );
+  stored_translation = crude_jph_vec3_to_vector( character_container->manually_stored_transform.GetTranslation( ) );
+  stored_rotation = crude_jph_quat_to_vector( character_container->manually_stored_transform.GetQuaternion( ) );
+
+  if ( physics->last_update_steps_count )
+  {
+    float32                                                previous_step_fraction;
+
+    /* Pose one step before the last one, assuming the motion was linear during the update */
+    previous_step_fraction = CRUDE_CAST( float32, physics->last_update_steps_count - 1 ) / physics->last_update_steps_count;
+    previous_translation = XMVectorLerp( stored_translation, simulated_translation, previous_step_fraction );
+    previous_rotation = XMQuaternionSlerp( stored_rotation, simulated_rotation, previous_step_fraction );
+  }
+  else
+  {
+    /* The character could be moved by the transform since the last step */
+    current_translation = XMLoadFloat3( &character_container->current_translation );
+    current_rotation = XMLoadFloat4( &character_container->current_rotation );
+    previous_translation = XMVectorAdd( XMLoadFloat3( &character_container->previous_translation ), XMVectorSubtract( simulated_translation, current_translation ) );
+    previous_rotation = XMQuaternionMultiply( XMLoadFloat4( &character_container->previous_rotation ), XMQuaternionMultiply( XMQuaternionInverse( current_rotation ), simulated_rotation ) );
+  }
+
+  XMStoreFloat3( &character_container->previous_translation, previous_translation );
+  XMStoreFloat4( &character_container->previous_rotation, previous_rotation );
+  XMStoreFloat3( &character_container->current_translation, simulated_translation );
+  XMStoreFloat4( &character_container->current_rotation, simulated_rotation );
+
+  rendered_translation = XMVectorLerp( previous_translation, simulated_translation, physics->interpolation_alpha );
+  rendered_rotation = XMQuaternionSlerp( previous_rotation, simulated_rotation, physics->interpolation_alpha );
+
+  /* Transform holds the rendered pose of the last frame, stored pose minus the offset */
+  offset_translation = XMLoadFloat3( &character_container->interpolation_offset_translation );
+  offset_rotation = XMLoadFloat4( &character_container->interpolation_offset_rotation );
+
+  translation_diff = XMVectorSubtract( rendered_translation, XMVectorSubtract( stored_translation, offset_translation ) );
+  rotation_diff = XMQuaternionMultiply( XMQuaternionInverse( XMQuaternionMultiply( stored_rotation, XMQuaternionInverse( offset_rotation ) ) ), rendered_rotation );
+
+  XMStoreFloat3( &transform->translation, XMVectorAdd( XMLoadFloat3( &transform->translation ), translation_diff ) );
+  XMStoreFloat4( &transform->rotation, XMQuaternionMultiply( XMLoadFloat4( &transform->rotation ), rotation_diff ) );
 
-    node_to_world = crude_transform_node_to_world( it->world, it->entities[ i ], transform );
+  XMStoreFloat3( &character_container->interpolation_offset_translation, XMVectorSubtract( simulated_translation, rendered_translation ) );
+  XMStoreFloat4( &character_container->interpolation_offset_rotation, XMQuaternionMultiply( XMQuaternionInverse( rendered_rotation ), simulated_rotation ) );
 
-    XMMatrixDecompose( &scale, &rotation, &translation, node_to_world );
+  /* A step without motion makes previous and current poses equal, so the offset is zero after it */
+  if ( !character_container->active && physics->last_update_steps_count )
+  {
+    character_container->inactive_synced = true;
+  }
+}
+
+void
+crude_physics_character_post_simulation_
+(
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_character_container                  *character_container,
+  _In_ crude_transform const                              *transform
+)
+{
+  XMMATRIX                                                 node_to_world;
+  XMVECTOR                                                 scale, translation, rotation;
+
+  node_to_world = crude_transform_node_to_world( world, character_container->entity, transform );
 
-    jph_body_interface_class->SetPositionAndRotation( kinematic_body_container->jph_body_class, crude_vector_to_jph_vec3( translation ), crude_vector_to_jph_quat( rotation ), JPH::EActivation::Activate );
+  XMMatrixDecompose( &scale, &rotation, &translation, node_to_world );
+
+  /* Transform is interpolated, the character keeps the simulated pose */
+  translation = XMVectorAdd( translation, XMLoadFloat3( &character_container->interpolation_offset_translation ) );
+  rotation = XMQuaternionMultiply( rotation, XMLoadFloat4( &character_container->interpolation_offset_rotation ) );
+
+  /* Pushing the simulated pose back would only wake up the body, skip it unless the transform was moved */
+  if ( !crude_physics_sync_pose_( translation, rotation, &character_container->current_translation, &character_container->current_rotation, NULL ) )
+  {
+    character_container->manually_stored_transform = JPH::RMat44::sRotationTranslation( crude_vector_to_jph_quat( rotation ), crude_vector_to_jph_vec3( translation ) );
+    return;
   }
-cleanup:
+
+  crude_physics_character_set_position_and_rotation( character_container, translation, rotation );
+  character_container->manually_stored_transform = crude_physics_character_get_world_transform( character_container );
+}
+
+void
+crude_physics_static_body_post_simulation_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_static_body_container                *static_body_container,
+  _In_ crude_transform const                              *transform
+)
+{
+  XMMATRIX                                                 node_to_world;
+  XMVECTOR                                                 scale, translation, rotation;
+
+  node_to_world = crude_transform_node_to_world( world, static_body_container->entity, transform );
+
+  XMMatrixDecompose( &scale, &rotation, &translation, node_to_world );
+
+  if ( crude_physics_sync_pose_( translation, rotation, &static_body_container->synced_translation, &static_body_container->synced_rotation, &static_body_container->pose_synced ) )
+  {
+    physics->jph_physics_system_class->GetBodyInterface( ).SetPositionAndRotation( static_body_container->jph_body_class, crude_vector_to_jph_vec3( translation ), crude_vector_to_jph_quat( rotation ), JPH::EActivation::DontActivate );
+  }
+}
+
+void
+crude_physics_kinematic_body_post_simulation_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_kinematic_body_container             *kinematic_body_container,
+  _In_ crude_transform const                              *transform
+)
+{
+  XMMATRIX                                                 node_to_world;
+  XMVECTOR                                                 scale, translation, rotation;
+
+  node_to_world = crude_transform_node_to_world( world, kinematic_body_container->entity, transform );
+
+  XMMatrixDecompose( &scale, &rotation, &translation, node_to_world );
+
+  /* Resting kinematic body isn't activated again, so Jolt could put it to sleep */
+  if ( crude_physics_sync_pose_( translation, rotation, &kinematic_body_container->synced_translation, &kinematic_body_container->synced_rotation, &kinematic_body_container->pose_synced ) )
+  {
+    physics->jph_physics_system_class->GetBodyInterface( ).SetPositionAndRotation( kinematic_body_container->jph_body_class, crude_vector_to_jph_vec3( translation ), crude_vector_to_jph_quat( rotation ), JPH::EActivation::Activate );
+  }
+}
+
+void
+crude_physics_kinematic_body_post_simulation_children_
+(
+  _In_ crude_physics                                      *physics,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+)
+{
+  ecs_iter_t                                               children_it;
+
+  children_it = crude_ecs_children( world, node );
+  while ( ecs_children_next( &children_it ) )
+  {
+    for ( size_t i = 0; i < children_it.count; ++i )
+    {
+      crude_entity                                         child;
+
+      child = crude_entity_from_iterator( &children_it, i );
+      if ( CRUDE_ENTITY_HAS_COMPONENT( world, child, crude_physics_kinematic_body_handle ) )
+      {
+        crude_physics_kinematic_body_post_simulation_( physics, world, crude_physics_access_kinematic_body( physics, *CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, child, crude_physics_kinematic_body_handle ) ), CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, child, crude_transform ) );
+      }
+      crude_physics_kinematic_body_post_simulation_children_( physics, world, child );
+    }
+  }
+}
+
+void
+crude_physics_contact_events_system_
+(
+  _In_ ecs_iter_t                                         *it
+)
+{
+  crude_physics_system_context                            *ctx;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_contact_events_system_" );
+
+  ctx = CRUDE_CAST( crude_physics_system_context*, it->ctx );
+  crude_physics_dispatch_contact_events( ctx->physics );
   CRUDE_PROFILER_ZONE_END;
-}
\ No newline at end of file
+}
+
+bool
+crude_physics_sync_pose_
+(
+  _In_ XMVECTOR                                            translation,
+  _In_ XMVECTOR                                            rotation,
+  _Inout_ XMFLOAT3                                        *synced_translation,
+  _Inout_ XMFLOAT4                                        *synced_rotation,
+  _Inout_ bool                                            *pose_synced
+)
+{
+  XMVECTOR                                                 epsilon;
+
+  epsilon = XMVectorReplicate( CRUDE_PHYSICS_POSE_SYNC_EPSILON );
+  if ( ( !pose_synced || *pose_synced ) && XMVector3NearEqual( translation, XMLoadFloat3( synced_translation ), epsilon ) && XMVector4NearEqual( rotation, XMLoadFloat4( synced_rotation ), epsilon ) )
+  {
+    return false;
+  }
+
+  XMStoreFloat3( synced_translation, translation );
+  XMStoreFloat4( synced_rotation, rotation );
+  if ( pose_synced )
+  {
+    *pose_synced = true;
+  }
+  return true;
+}
@@ -4,7 +4,8 @@
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
@@ -12,12 +13,17 @@
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Body/BodyActivationListener.h>
 #include <Jolt/Physics/Character/Character.h>
+#include <Jolt/Physics/Character/CharacterVirtual.h>
 #include <Jolt/Physics/Collision/Shape/RotatedTranslatedShape.h>
 #include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
 #include <Jolt/Physics/Collision/Shape/MeshShape.h>
 #include <Jolt/Physics/Collision/NarrowPhaseQuery.h>
 #include <Jolt/Physics/Collision/RayCast.h>
 #include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/CollisionDispatch.h>
+#include <Jolt/Geometry/RayAABox.h>
 
 #include <engine/physics/physics_config.h>
 #include <engine/scene/scene_ecs.h>
@@ -29,6 +35,20 @@ typedef enum crude_physics_body_shape_type
   CRUDE_PHYSICS_BODY_SHAPE_TYPE_COUNT
 } crude_physics_body_shape_type;
 
+typedef enum crude_physics_body_user_data_type
+{
+  CRUDE_PHYSICS_BODY_USER_DATA_TYPE_STATIC_BODY,
+  CRUDE_PHYSICS_BODY_USER_DATA_TYPE_KINEMATIC_BODY,
+  CRUDE_PHYSICS_BODY_USER_DATA_TYPE_CHARACTER,
+} crude_physics_body_user_data_type;
+
+#define CRUDE_PHYSICS_BATCH_INDEX_REMOVED                  ( -2 )
+
+/* Jolt body user data keeps the handle index in low bits and the body type in high bits */
+#define CRUDE_PHYSICS_BODY_USER_DATA( type, index )        ( ( CRUDE_CAST( uint64, type ) << 32 ) | CRUDE_CAST( uint64, index ) )
+#define CRUDE_PHYSICS_BODY_USER_DATA_TYPE( user_data )     ( CRUDE_CAST( crude_physics_body_user_data_type, ( user_data ) >> 32 ) )
+#define CRUDE_PHYSICS_BODY_USER_DATA_INDEX( user_data )    ( CRUDE_CAST( uint32, ( user_data ) & 0xffffffff ) )
+
 typedef struct crude_physics_character_handle
 {
   uint32                                                   index;
@@ -62,12 +82,38 @@ typedef struct crude_physics_character_creation
   float32                                                  friction;
   float32                                                  max_slop_angle;
   uint16                                                   layers;
+  /* JPH::CharacterVirtual without a rigid body, cheaper for crowds */
+  bool                                                     virtual_character;
+  crude_entity                                             entity;
 } crude_physics_character_creation;
 
+/**
+ * previous and current are character poses one physics step apart, the
+ * entity transform gets the pose interpolated between them. Interpolation
+ * offset is the difference between the simulated and the rendered pose,
+ * it's added back when the transform is pushed to the character.
+ * Virtual characters have no body and are moved by crude_physics_update,
+ * only one of jph_character_class and jph_character_virtual_class is set.
+ */
 typedef struct crude_physics_character_container
 {
   JPH::RMat44                                              manually_stored_transform;
   JPH::Ref< JPH::Character >                               jph_character_class;
+  JPH::Ref< JPH::CharacterVirtual >                        jph_character_virtual_class;
+  crude_entity                                             entity;
+  XMFLOAT3                                                 previous_translation;
+  XMFLOAT4                                                 previous_rotation;
+  XMFLOAT3                                                 current_translation;
+  XMFLOAT4                                                 current_rotation;
+  XMFLOAT3                                                 interpolation_offset_translation;
+  XMFLOAT4                                                 interpolation_offset_rotation;
+  /* Set by the activation listener */
+  bool                                                     active;
+  /* Interpolation settled after the body went to sleep, transform isn't touched until it wakes up */
+  bool                                                     inactive_synced;
+  /* Virtual characters only, layers are used to filter bodies during the update */
+  uint16                                                   layers;
+  bool                                                     virtual_enabled;
 } crude_physics_character_container;
 
 typedef struct crude_physics_character
@@ -78,6 +124,7 @@ typedef struct crude_physics_character
   float32                                                  max_slop_angle;
   crude_physics_character_handle                           handle;
   int32                                                    layers;
+  bool                                                     virtual_character;
 } crude_physics_character;
 
 typedef struct crude_physics_static_body_creation
@@ -102,6 +149,12 @@ typedef struct crude_physics_static_body_container
 {
   JPH::BodyID                                              jph_body_class;
   crude_entity                                             entity;
+  /* Index in the bodies batch until the batch adds the body, CRUDE_PHYSICS_BATCH_INDEX_REMOVED while the body is removed or its removal is pending, -1 otherwise */
+  int32                                                    batch_index;
+  /* Last world pose pushed to Jolt, body is only moved when it changes */
+  XMFLOAT3                                                 synced_translation;
+  XMFLOAT4                                                 synced_rotation;
+  bool                                                     pose_synced;
 } crude_physics_static_body_container;
 
 typedef struct crude_physics_static_body
@@ -144,7 +197,12 @@ typedef struct crude_physics_kinematic_body_container
 {
   JPH::BodyID                                              jph_body_class;
   crude_entity                                             entity;
+  /* Same as crude_physics_static_body_container::batch_index */
+  int32                                                    batch_index;
   crude_physics_kinematic_body_contact_added_callback      contact_added_callback;
+  XMFLOAT3                                                 synced_translation;
+  XMFLOAT4                                                 synced_rotation;
+  bool                                                     pose_synced;
 } crude_physics_kinematic_body_container;
 
 typedef struct crude_physics_kinematic_body
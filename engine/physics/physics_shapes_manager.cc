@@ -1,11 +1,75 @@
+#include <string.h>
+
 #include <thirdparty/cgltf/cgltf.h>
 
 #include <engine/core/hashmapstr.h>
 #include <engine/core/file.h>
+#include <engine/core/log.h>
+#include <engine/core/array.h>
+#include <engine/core/profiler.h>
 #include <engine/physics/physics.h>
 
 #include <engine/physics/physics_shapes_manager.h>
 
+class _crude_jph_memory_stream_out_class final : public JPH::StreamOut
+{
+public:
+  _crude_jph_memory_stream_out_class
+  (
+    _In_ crude_heap_allocator                             *allocator
+  );
+
+  ~_crude_jph_memory_stream_out_class
+  (
+  );
+
+  virtual void
+  WriteBytes
+  (
+    _In_ void const                                       *data,
+    _In_ size_t                                            data_size
+  ) override;
+
+  virtual bool
+  IsFailed
+  (
+  ) const override;
+
+  uint8                                                   *buffer;
+};
+
+class _crude_jph_memory_stream_in_class final : public JPH::StreamIn
+{
+public:
+  _crude_jph_memory_stream_in_class
+  (
+    _In_ uint8 const                                      *buffer,
+    _In_ size_t                                            buffer_size
+  );
+
+  virtual void
+  ReadBytes
+  (
+    _Out_ void                                            *data,
+    _In_ size_t                                            data_size
+  ) override;
+
+  virtual bool
+  IsEOF
+  (
+  ) const override;
+
+  virtual bool
+  IsFailed
+  (
+  ) const override;
+private:
+  uint8 const                                             *buffer;
+  size_t                                                   buffer_size;
+  size_t                                                   offset;
+  bool                                                     failed;
+};
+
 static cgltf_data*
 crude_physics_shapes_manager_gltf_parse_
 (
@@ -16,7 +80,6 @@ crude_physics_shapes_manager_gltf_parse_
 static void
 crude_physics_shapes_manager_gltf_load_nodes_
 (
-  _In_ crude_physics_shapes_manager                       *manager,
   _In_ cgltf_data                                         *gltf,
   _In_ cgltf_node                                        **gltf_nodes,
   _In_ uint32                                              gltf_nodes_count,
@@ -24,11 +87,58 @@ crude_physics_shapes_manager_gltf_load_nodes_
   _In_ XMMATRIX                                            parent_to_world
 );
 
+static bool
+crude_physics_shapes_manager_gltf_load_buffers_
+(
+  _In_ crude_heap_allocator                               *gltf_allocator,
+  _In_ cgltf_data                                         *gltf,
+  _In_ char const                                         *gltf_path
+);
+
+/* Doesn't touch the manager state, only directories are read */
+static JPH::Ref< JPH::Shape >
+crude_physics_shapes_manager_build_mesh_shape_
+(
+  _In_ crude_physics_shapes_manager const                 *manager,
+  _In_ char const                                         *gltf_relative_filepath,
+  _In_ crude_heap_allocator                               *allocator
+);
+
 static crude_physics_mesh_shape_handle
-crude_physics_shapes_manager_load_mesh_shape_from_gltf_
+crude_physics_shapes_manager_add_mesh_shape_
 (
   _In_ crude_physics_shapes_manager                       *manager,
-  _In_ char const                                         *gltf_realtive_filepath
+  _In_ char const                                         *relative_filepath,
+  _In_ JPH::Shape                                         *jph_shape
+);
+
+/**
+ * Hash of gltf json, embedded binary chunk, last write time of external
+ * buffers and everything which affects the built shape. Buffers are not
+ * loaded, only the json is parsed.
+ */
+static uint64
+crude_physics_shapes_manager_mesh_shape_source_hash_
+(
+  _In_ cgltf_data                                         *gltf,
+  _In_ char const                                         *gltf_absolute_filepath
+);
+
+static JPH::Ref< JPH::Shape >
+crude_physics_shapes_manager_restore_mesh_shape_
+(
+  _In_ crude_heap_allocator                               *allocator,
+  _In_ char const                                         *cache_absolute_filepath,
+  _In_ uint64                                              source_hash
+);
+
+static void
+crude_physics_shapes_manager_save_mesh_shape_
+(
+  _In_ crude_heap_allocator                               *allocator,
+  _In_ JPH::Shape const                                   *jph_shape_class,
+  _In_ char const                                         *cache_absolute_filepath,
+  _In_ uint64                                              source_hash
 );
 
 void
@@ -42,13 +152,22 @@ crude_physics_shapes_manager_initialize
   manager->cgltf_temporary_allocator = creation->cgltf_temporary_allocator;
   manager->physics_manager = creation->physics_manager;
   manager->resources_absolute_directory = creation->resources_absolute_directory;
+  manager->cache_absolute_directory[ 0 ] = 0;
+  if ( creation->cache_absolute_directory )
+  {
+    crude_snprintf( manager->cache_absolute_directory, sizeof( manager->cache_absolute_directory ), "%s\\%s", creation->cache_absolute_directory, CRUDE_PHYSICS_MESH_SHAPE_CACHE_DIRECTORY );
+    if ( !crude_file_create_directory( manager->cache_absolute_directory ) )
+    {
+      CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "Cannot create mesh shapes cache directory \"%s\", cache is disabled", manager->cache_absolute_directory );
+      manager->cache_absolute_directory[ 0 ] = 0;
+    }
+  }
 #if CRUDE_DEVELOP
   manager->model_renderer_resources_manager = creation->model_renderer_resources_manager;
 #endif
 
   CRUDE_HASHMAPSTR_INITIALIZE( manager->mesh_shape_relative_filepath_to_hadle, crude_heap_allocator_pack( manager->allocator ) );
   crude_resource_pool_initialize( &manager->mesh_shape_resource_pool, crude_heap_allocator_pack( manager->allocator ), 256, sizeof( crude_physics_mesh_shape_container ) );
-  crude_string_buffer_initialize( &manager->gltf_absolute_filepath_string_buffer, CRUDE_RKILO( 16 ), crude_heap_allocator_pack( manager->allocator ) );
 }
 
 void
@@ -60,7 +179,6 @@ crude_physics_shapes_manager_deinitialize
   crude_physics_shapes_manager_clear( manager );
   CRUDE_HASHMAPSTR_DEINITIALIZE( manager->mesh_shape_relative_filepath_to_hadle );
   crude_resource_pool_deinitialize( &manager->mesh_shape_resource_pool );
-  crude_string_buffer_deinitialize( &manager->gltf_absolute_filepath_string_buffer );
 }
 
 crude_physics_mesh_shape_handle
@@ -70,8 +188,6 @@ crude_physics_shapes_manager_get_mesh_shape_handle
   _In_ char const                                         *relative_filepath
 )
 {
-  crude_physics_mesh_shape_container                      *mesh_shape_container;
-  crude_physics_mesh_shape_handle                          mesh_shape_handle;
   int64                                                    handle_index;
 
   handle_index = CRUDE_HASHMAPSTR_GET_INDEX( manager->mesh_shape_relative_filepath_to_hadle, relative_filepath );
@@ -80,19 +196,78 @@ crude_physics_shapes_manager_get_mesh_shape_handle
     return manager->mesh_shape_relative_filepath_to_hadle[ handle_index ].value;
   }
 
-  mesh_shape_handle = crude_physics_shapes_manager_load_mesh_shape_from_gltf_( manager, relative_filepath );
-  mesh_shape_container = crude_physics_shapes_manager_access_mesh_shape( manager, mesh_shape_handle );
-  CRUDE_HASHMAPSTR_SET( manager->mesh_shape_relative_filepath_to_hadle, CRUDE_COMPOUNT( crude_string_link, { mesh_shape_container->relative_filepath } ), mesh_shape_handle );
-#if CRUDE_DEVELOP
-  crude_gfx_model_renderer_resources_instance_initialize(
-    &mesh_shape_container->debug_model_renderer_resource_instance,
-    manager->model_renderer_resources_manager,
-    crude_gfx_model_renderer_resources_manager_get_gltf_model( manager->model_renderer_resources_manager, relative_filepath ) );
-  CRUDE_HASHMAPSTR_SET( manager->mesh_shape_relative_filepath_to_hadle, CRUDE_COMPOUNT( crude_string_link, { mesh_shape_container->relative_filepath } ), mesh_shape_handle );
-#endif
+  return crude_physics_shapes_manager_add_mesh_shape_( manager, relative_filepath, crude_physics_shapes_manager_build_mesh_shape_( manager, relative_filepath, manager->cgltf_temporary_allocator ) );
+}
+
+bool
+crude_physics_shapes_manager_has_mesh_shape
+(
+  _In_ crude_physics_shapes_manager                       *manager,
+  _In_ char const                                         *relative_filepath
+)
+{
+  return CRUDE_HASHMAPSTR_GET_INDEX( manager->mesh_shape_relative_filepath_to_hadle, relative_filepath ) != -1;
+}
+
+bool
+crude_physics_shapes_manager_prepare_mesh_shape
+(
+  _In_ crude_physics_shapes_manager const                 *manager,
+  _In_ char const                                         *relative_filepath,
+  _In_ crude_heap_allocator                               *allocator,
+  _Out_ crude_physics_prepared_mesh_shape                 *prepared_mesh_shape
+)
+{
+  JPH::Ref< JPH::Shape >                                   jph_shape_class;
+
+  jph_shape_class = crude_physics_shapes_manager_build_mesh_shape_( manager, relative_filepath, allocator );
+
+  crude_string_copy( prepared_mesh_shape->relative_filepath, relative_filepath, sizeof( prepared_mesh_shape->relative_filepath ) );
+  prepared_mesh_shape->jph_shape = jph_shape_class.GetPtr( );
+  if ( prepared_mesh_shape->jph_shape )
+  {
+    prepared_mesh_shape->jph_shape->AddRef( );
+  }
+  return prepared_mesh_shape->jph_shape != NULL;
+}
+
+crude_physics_mesh_shape_handle
+crude_physics_shapes_manager_add_prepared_mesh_shape
+(
+  _In_ crude_physics_shapes_manager                       *manager,
+  _In_ crude_physics_prepared_mesh_shape                  *prepared_mesh_shape
+)
+{
+  crude_physics_mesh_shape_handle                          mesh_shape_handle;
+  int64                                                    handle_index;
+
+  handle_index = CRUDE_HASHMAPSTR_GET_INDEX( manager->mesh_shape_relative_filepath_to_hadle, prepared_mesh_shape->relative_filepath );
+  if ( handle_index != -1 )
+  {
+    mesh_shape_handle = manager->mesh_shape_relative_filepath_to_hadle[ handle_index ].value;
+  }
+  else
+  {
+    mesh_shape_handle = crude_physics_shapes_manager_add_mesh_shape_( manager, prepared_mesh_shape->relative_filepath, prepared_mesh_shape->jph_shape );
+  }
+
+  crude_physics_shapes_manager_discard_prepared_mesh_shape( prepared_mesh_shape );
   return mesh_shape_handle;
 }
 
+void
+crude_physics_shapes_manager_discard_prepared_mesh_shape
+(
+  _In_ crude_physics_prepared_mesh_shape                  *prepared_mesh_shape
+)
+{
+  if ( prepared_mesh_shape->jph_shape )
+  {
+    prepared_mesh_shape->jph_shape->Release( );
+    prepared_mesh_shape->jph_shape = NULL;
+  }
+}
+
 crude_physics_mesh_shape_container*
 crude_physics_shapes_manager_access_mesh_shape
 (
@@ -103,6 +278,28 @@ crude_physics_shapes_manager_access_mesh_shape
   return CRUDE_CAST( crude_physics_mesh_shape_container*, crude_resource_pool_access_resource( &manager->mesh_shape_resource_pool, handle.index ) );
 }
 
+void
+crude_physics_shapes_manager_release_mesh_shape
+(
+  _In_ crude_physics_shapes_manager                       *manager,
+  _In_ crude_physics_mesh_shape_handle                     handle
+)
+{
+  crude_physics_mesh_shape_container                      *mesh_shape_container;
+
+  mesh_shape_container = crude_physics_shapes_manager_access_mesh_shape( manager, handle );
+
+  CRUDE_HASHMAPSTR_REMOVE( manager->mesh_shape_relative_filepath_to_hadle, mesh_shape_container->relative_filepath );
+  mesh_shape_container->jph_shape_class.~Ref( );
+#if CRUDE_DEVELOP && !CRUDE_HEADLESS
+  if ( manager->model_renderer_resources_manager )
+  {
+    crude_gfx_model_renderer_resources_instance_deinitialize( &mesh_shape_container->debug_model_renderer_resource_instance );
+  }
+#endif
+  crude_resource_pool_release_resource( &manager->mesh_shape_resource_pool, handle.index );
+}
+
 void
 crude_physics_shapes_manager_clear
 (
@@ -116,15 +313,16 @@ crude_physics_shapes_manager_clear
       crude_physics_mesh_shape_container *mesh_shape_container = CRUDE_CAST( crude_physics_mesh_shape_container*, crude_resource_pool_access_resource( &manager->mesh_shape_resource_pool, manager->mesh_shape_relative_filepath_to_hadle[ i ].value.index ) );
       mesh_shape_container->jph_shape_class.~Ref( );
       
-#if CRUDE_DEVELOP
-      crude_gfx_model_renderer_resources_instance_deinitialize( &mesh_shape_container->debug_model_renderer_resource_instance );
+#if CRUDE_DEVELOP && !CRUDE_HEADLESS
+      if ( manager->model_renderer_resources_manager )
+      {
+        crude_gfx_model_renderer_resources_instance_deinitialize( &mesh_shape_container->debug_model_renderer_resource_instance );
+      }
 #endif
       crude_resource_pool_release_resource( &manager->mesh_shape_resource_pool, manager->mesh_shape_relative_filepath_to_hadle[ i ].value.index );
     }
     manager->mesh_shape_relative_filepath_to_hadle[ i ].key.key_hash = CRUDE_HASHMAPSTR_BACKET_STATE_EMPTY;
   }
-
-  crude_string_buffer_clear( &manager->gltf_absolute_filepath_string_buffer );
 }
 
 cgltf_data*
@@ -154,27 +352,48 @@ crude_physics_shapes_manager_gltf_parse_
     return NULL;
   }
 
+  return gltf;
+}
+
+bool
+crude_physics_shapes_manager_gltf_load_buffers_
+(
+  _In_ crude_heap_allocator                               *gltf_allocator,
+  _In_ cgltf_data                                         *gltf,
+  _In_ char const                                         *gltf_path
+)
+{
+  cgltf_result                                             result;
+  cgltf_options                                            gltf_options;
+  crude_allocator_container                                gltf_allocator_container;
+
+  gltf_allocator_container = crude_heap_allocator_pack( gltf_allocator );
+
+  gltf_options = CRUDE_COMPOUNT_EMPTY( cgltf_options );
+  gltf_options.memory.alloc_func = gltf_allocator_container.allocate;
+  gltf_options.memory.free_func = gltf_allocator_container.deallocate;
+  gltf_options.memory.user_data = gltf_allocator_container.ctx;
+
   result = cgltf_load_buffers( &gltf_options, gltf, gltf_path );
   if ( result != cgltf_result_success )
   {
     CRUDE_ASSERTM( CRUDE_CHANNEL_GRAPHICS, false, "Failed to load buffers from gltf file: %s", gltf_path );
-    return NULL;
+    return false;
   }
 
   result = cgltf_validate( gltf );
   if ( result != cgltf_result_success )
   {
     CRUDE_ASSERTM( CRUDE_CHANNEL_GRAPHICS, false, "Failed to validate gltf file: %s", gltf_path );
-    return NULL;
+    return false;
   }
 
-  return gltf;
+  return true;
 }
 
 void
 crude_physics_shapes_manager_gltf_load_nodes_
 (
-  _In_ crude_physics_shapes_manager                       *manager,
   _In_ cgltf_data                                         *gltf,
   _In_ cgltf_node                                        **gltf_nodes,
   _In_ uint32                                              gltf_nodes_count,
@@ -292,52 +511,70 @@ crude_physics_shapes_manager_gltf_load_nodes_
       }
     }
 
-    crude_physics_shapes_manager_gltf_load_nodes_( manager, gltf, gltf_nodes[ i ]->children, gltf_nodes[ i ]->children_count, jph_triangles, node_to_parent );
+    crude_physics_shapes_manager_gltf_load_nodes_( gltf, gltf_nodes[ i ]->children, gltf_nodes[ i ]->children_count, jph_triangles, node_to_parent );
   }
 }
 
-crude_physics_mesh_shape_handle
-crude_physics_shapes_manager_load_mesh_shape_from_gltf_
+JPH::Ref< JPH::Shape >
+crude_physics_shapes_manager_build_mesh_shape_
 (
-  _In_ crude_physics_shapes_manager                       *manager,
-  _In_ char const                                         *gltf_relative_filepath
+  _In_ crude_physics_shapes_manager const                 *manager,
+  _In_ char const                                         *gltf_relative_filepath,
+  _In_ crude_heap_allocator                               *allocator
 )
 {
   cgltf_data                                              *gltf;
-  crude_physics_mesh_shape_container                      *mesh_shape;
-  char                                                    *gltf_absolute_filepath;
-  JPH::BodyInterface                                      *jph_body_interface_class;
+  JPH::Ref< JPH::Shape >                                   jph_shape_class;
   JPH::Array< JPH::Triangle >                              jph_triangles;
   JPH::MeshShapeSettings                                   jph_shape_settings_class;
   JPH::ShapeSettings::ShapeResult                          jph_shape_result_class;
-  crude_physics_mesh_shape_handle                          mesh_shape_handle;
+  char                                                     gltf_absolute_filepath[ 2048 ];
+  char                                                     cache_absolute_filepath[ 1024 ];
+  uint64                                                   source_hash;
   
-  gltf_absolute_filepath = crude_string_buffer_append_use_f( &manager->gltf_absolute_filepath_string_buffer, "%s%s", manager->resources_absolute_directory, gltf_relative_filepath );
+  CRUDE_PROFILER_ZONE_NAME( "crude_physics_shapes_manager_build_mesh_shape" );
+
+  crude_snprintf( gltf_absolute_filepath, sizeof( gltf_absolute_filepath ), "%s%s", manager->resources_absolute_directory, gltf_relative_filepath );
 
-  /* Parse gltf */
-  gltf = crude_physics_shapes_manager_gltf_parse_( manager->cgltf_temporary_allocator, gltf_absolute_filepath );
+  /* Only json is parsed, buffers are loaded if the cooked shape can't be restored */
+  gltf = crude_physics_shapes_manager_gltf_parse_( allocator, gltf_absolute_filepath );
   if ( !gltf )
   {
     goto cleanup;
   }
-  
-  mesh_shape_handle = CRUDE_COMPOUNT( crude_physics_mesh_shape_handle, { crude_resource_pool_obtain_resource( &manager->mesh_shape_resource_pool ) } );
-  mesh_shape = CRUDE_CAST( crude_physics_mesh_shape_container*, crude_resource_pool_access_resource( &manager->mesh_shape_resource_pool, mesh_shape_handle.index ) );
 
-  crude_string_copy( mesh_shape->relative_filepath, gltf_relative_filepath, sizeof( mesh_shape->relative_filepath ) );
+  /* Restore cooked shape, the source hash is a part of the name so changed source doesn't match the old file */
+  source_hash = 0u;
+  if ( manager->cache_absolute_directory[ 0 ] )
+  {
+    source_hash = crude_physics_shapes_manager_mesh_shape_source_hash_( gltf, gltf_absolute_filepath );
+    crude_snprintf( cache_absolute_filepath, sizeof( cache_absolute_filepath ), "%s\\%016llx.jphshape", manager->cache_absolute_directory, source_hash );
+    jph_shape_class = crude_physics_shapes_manager_restore_mesh_shape_( allocator, cache_absolute_filepath, source_hash );
+  }
 
-  for ( uint32 i = 0; i < gltf->scenes_count; ++i )
+  if ( !jph_shape_class )
   {
-    crude_physics_shapes_manager_gltf_load_nodes_( manager, gltf, gltf->scene[ i ].nodes, gltf->scene[ i ].nodes_count, &jph_triangles, XMMatrixIdentity( ) );
+    if ( !crude_physics_shapes_manager_gltf_load_buffers_( allocator, gltf, gltf_absolute_filepath ) )
+    {
+      goto cleanup;
+    }
+
+    for ( uint32 i = 0; i < gltf->scenes_count; ++i )
+    {
+      crude_physics_shapes_manager_gltf_load_nodes_( gltf, gltf->scene[ i ].nodes, gltf->scene[ i ].nodes_count, &jph_triangles, XMMatrixIdentity( ) );
+    }
+    
+    jph_shape_settings_class = CRUDE_COMPOUNT( JPH::MeshShapeSettings, { jph_triangles } );
+    jph_shape_settings_class.SetEmbedded( );
+    
+    jph_shape_result_class = jph_shape_settings_class.Create( );
+    jph_shape_class = jph_shape_result_class.Get( );
+
+    if ( manager->cache_absolute_directory[ 0 ] && jph_shape_class )
+    {
+      crude_physics_shapes_manager_save_mesh_shape_( allocator, jph_shape_class, cache_absolute_filepath, source_hash );
+    }
   }
-  
-  jph_body_interface_class = &manager->physics_manager->jph_physics_system_class->GetBodyInterface( );
-  
-  jph_shape_settings_class = CRUDE_COMPOUNT( JPH::MeshShapeSettings, { jph_triangles } );
-  jph_shape_settings_class.SetEmbedded( );
-  
-  jph_shape_result_class = jph_shape_settings_class.Create( );
-  CRUDE_CXX_CONSTRUCTOR( &mesh_shape->jph_shape_class, JPH::Ref< JPH::Shape >, jph_shape_result_class.Get( ) );
 
 cleanup:
   if ( gltf )
@@ -345,5 +582,245 @@ cleanup:
     cgltf_free( gltf );
   }
 
+  CRUDE_PROFILER_ZONE_END;
+  return jph_shape_class;
+}
+
+crude_physics_mesh_shape_handle
+crude_physics_shapes_manager_add_mesh_shape_
+(
+  _In_ crude_physics_shapes_manager                       *manager,
+  _In_ char const                                         *relative_filepath,
+  _In_ JPH::Shape                                         *jph_shape
+)
+{
+  crude_physics_mesh_shape_container                      *mesh_shape_container;
+  crude_physics_mesh_shape_handle                          mesh_shape_handle;
+
+  mesh_shape_handle = CRUDE_COMPOUNT( crude_physics_mesh_shape_handle, { crude_resource_pool_obtain_resource( &manager->mesh_shape_resource_pool ) } );
+  mesh_shape_container = crude_physics_shapes_manager_access_mesh_shape( manager, mesh_shape_handle );
+
+  crude_string_copy( mesh_shape_container->relative_filepath, relative_filepath, sizeof( mesh_shape_container->relative_filepath ) );
+  CRUDE_CXX_CONSTRUCTOR( &mesh_shape_container->jph_shape_class, JPH::Ref< JPH::Shape >, jph_shape );
+  mesh_shape_container->size = jph_shape ? jph_shape->GetStats( ).mSizeBytes : 0u;
+
+  CRUDE_HASHMAPSTR_SET( manager->mesh_shape_relative_filepath_to_hadle, CRUDE_COMPOUNT( crude_string_link, { mesh_shape_container->relative_filepath } ), mesh_shape_handle );
+#if CRUDE_DEVELOP && !CRUDE_HEADLESS
+  /* Headless tools create the manager without renderer resources */
+  if ( manager->model_renderer_resources_manager )
+  {
+    crude_gfx_model_renderer_resources_instance_initialize(
+      &mesh_shape_container->debug_model_renderer_resource_instance,
+      manager->model_renderer_resources_manager,
+      crude_gfx_model_renderer_resources_manager_get_gltf_model( manager->model_renderer_resources_manager, relative_filepath ) );
+  }
+#endif
   return mesh_shape_handle;
-}
\ No newline at end of file
+}
+
+uint64
+crude_physics_shapes_manager_mesh_shape_source_hash_
+(
+  _In_ cgltf_data                                         *gltf,
+  _In_ char const                                         *gltf_absolute_filepath
+)
+{
+  JPH::MeshShapeSettings                                   jph_default_settings_class;
+  char                                                     buffer_absolute_filepath[ 1024 ];
+  char                                                    *buffer_absolute_directory_end;
+  uint32                                                   build_settings[ 6 ];
+  uint64                                                   hash;
+  
+  /* Shapes are built with default settings, so a Jolt update could change them */
+  build_settings[ 0 ] = CRUDE_PHYSICS_MESH_SHAPE_CACHE_VERSION;
+  build_settings[ 1 ] = JPH_VERSION_MAJOR;
+  build_settings[ 2 ] = JPH_VERSION_MINOR;
+  build_settings[ 3 ] = JPH_VERSION_PATCH;
+  build_settings[ 4 ] = jph_default_settings_class.mMaxTrianglesPerLeaf;
+  build_settings[ 5 ] = CRUDE_CAST( uint32, jph_default_settings_class.mBuildQuality );
+
+  hash = crude_hash_bytes( CRUDE_REINTERPRET_CAST( uint8 const*, build_settings ), sizeof( build_settings ), 0 );
+  hash = crude_hash_bytes( CRUDE_REINTERPRET_CAST( uint8 const*, &jph_default_settings_class.mActiveEdgeCosThresholdAngle ), sizeof( jph_default_settings_class.mActiveEdgeCosThresholdAngle ), hash );
+  hash = crude_hash_bytes( CRUDE_REINTERPRET_CAST( uint8 const*, gltf->json ), gltf->json_size, hash );
+  if ( gltf->bin )
+  {
+    hash = crude_hash_bytes( CRUDE_REINTERPRET_CAST( uint8 const*, gltf->bin ), gltf->bin_size, hash );
+  }
+
+  crude_string_copy( buffer_absolute_filepath, gltf_absolute_filepath, sizeof( buffer_absolute_filepath ) );
+  crude_file_directory_from_path( buffer_absolute_filepath );
+  buffer_absolute_directory_end = buffer_absolute_filepath + crude_string_length( buffer_absolute_filepath );
+
+  /* External buffers aren't read, their last write time stands for the content */
+  for ( uint32 i = 0; i < gltf->buffers_count; ++i )
+  {
+    uint64                                                 buffer_last_write_time;
+
+    if ( !gltf->buffers[ i ].uri || strncmp( gltf->buffers[ i ].uri, "data:", 5 ) == 0 )
+    {
+      continue;
+    }
+
+    crude_string_copy( buffer_absolute_directory_end, gltf->buffers[ i ].uri, sizeof( buffer_absolute_filepath ) - ( buffer_absolute_directory_end - buffer_absolute_filepath ) );
+    buffer_last_write_time = crude_file_last_write_time( buffer_absolute_filepath );
+    hash = crude_hash_bytes( CRUDE_REINTERPRET_CAST( uint8 const*, &buffer_last_write_time ), sizeof( buffer_last_write_time ), hash );
+  }
+  return hash;
+}
+
+JPH::Ref< JPH::Shape >
+crude_physics_shapes_manager_restore_mesh_shape_
+(
+  _In_ crude_heap_allocator                               *allocator,
+  _In_ char const                                         *cache_absolute_filepath,
+  _In_ uint64                                              source_hash
+)
+{
+  crude_physics_mesh_shape_cache_header const             *header;
+  uint8                                                   *buffer;
+  JPH::Shape::IDToShapeMap                                 jph_id_to_shape_map_class;
+  JPH::Shape::IDToMaterialMap                              jph_id_to_material_map_class;
+  JPH::Shape::ShapeResult                                  jph_shape_result_class;
+  JPH::Ref< JPH::Shape >                                   jph_shape_class;
+  uint32                                                   buffer_size;
+
+  if ( !crude_file_exist( cache_absolute_filepath ) )
+  {
+    return jph_shape_class;
+  }
+
+  crude_read_file_binary( cache_absolute_filepath, NULL, &buffer_size );
+  buffer = CRUDE_CAST( uint8*, CRUDE_ALLOCATE( crude_heap_allocator_pack( allocator ), buffer_size ) );
+  crude_read_file_binary( cache_absolute_filepath, buffer, &buffer_size );
+
+  header = CRUDE_REINTERPRET_CAST( crude_physics_mesh_shape_cache_header const*, buffer );
+  if ( buffer_size < sizeof( *header ) || header->magic != CRUDE_PHYSICS_MESH_SHAPE_CACHE_MAGIC || header->version != CRUDE_PHYSICS_MESH_SHAPE_CACHE_VERSION || header->source_hash != source_hash )
+  {
+    CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "Cooked mesh shape \"%s\" is outdated, rebuilding", cache_absolute_filepath );
+    goto cleanup;
+  }
+
+  {
+    _crude_jph_memory_stream_in_class                      jph_stream_in_class( buffer + sizeof( *header ), buffer_size - sizeof( *header ) );
+
+    jph_shape_result_class = JPH::Shape::sRestoreWithChildren( jph_stream_in_class, jph_id_to_shape_map_class, jph_id_to_material_map_class );
+    if ( jph_shape_result_class.HasError( ) || jph_stream_in_class.IsFailed( ) )
+    {
+      CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "Failed to restore cooked mesh shape \"%s\", rebuilding", cache_absolute_filepath );
+      goto cleanup;
+    }
+    jph_shape_class = jph_shape_result_class.Get( );
+  }
+
+cleanup:
+  CRUDE_DEALLOCATE( crude_heap_allocator_pack( allocator ), buffer );
+  return jph_shape_class;
+}
+
+void
+crude_physics_shapes_manager_save_mesh_shape_
+(
+  _In_ crude_heap_allocator                               *allocator,
+  _In_ JPH::Shape const                                   *jph_shape_class,
+  _In_ char const                                         *cache_absolute_filepath,
+  _In_ uint64                                              source_hash
+)
+{
+  _crude_jph_memory_stream_out_class                       jph_stream_out_class( allocator );
+  JPH::Shape::ShapeToIDMap                                 jph_shape_to_id_map_class;
+  JPH::Shape::MaterialToIDMap                              jph_material_to_id_map_class;
+  crude_physics_mesh_shape_cache_header                    header;
+
+  header = CRUDE_COMPOUNT_EMPTY( crude_physics_mesh_shape_cache_header );
+  header.magic = CRUDE_PHYSICS_MESH_SHAPE_CACHE_MAGIC;
+  header.version = CRUDE_PHYSICS_MESH_SHAPE_CACHE_VERSION;
+  header.source_hash = source_hash;
+
+  jph_stream_out_class.WriteBytes( &header, sizeof( header ) );
+  jph_shape_class->SaveWithChildren( jph_stream_out_class, jph_shape_to_id_map_class, jph_material_to_id_map_class );
+
+  if ( !crude_write_file_binary( cache_absolute_filepath, jph_stream_out_class.buffer, CRUDE_ARRAY_LENGTH( jph_stream_out_class.buffer ) ) )
+  {
+    CRUDE_LOG_WARNING( CRUDE_CHANNEL_PHYSICS, "Failed to write cooked mesh shape \"%s\"", cache_absolute_filepath );
+  }
+}
+
+_crude_jph_memory_stream_out_class::_crude_jph_memory_stream_out_class
+(
+  _In_ crude_heap_allocator                               *allocator
+)
+{
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( this->buffer, CRUDE_RKILO( 64 ), crude_heap_allocator_pack( allocator ) );
+}
+
+_crude_jph_memory_stream_out_class::~_crude_jph_memory_stream_out_class
+(
+)
+{
+  CRUDE_ARRAY_DEINITIALIZE( this->buffer );
+}
+
+void
+_crude_jph_memory_stream_out_class::WriteBytes
+(
+  _In_ void const                                         *data,
+  _In_ size_t                                              data_size
+)
+{
+  size_t                                                   offset;
+
+  offset = CRUDE_ARRAY_LENGTH( this->buffer );
+  CRUDE_ARRAY_SET_LENGTH( this->buffer, offset + data_size );
+  memcpy( this->buffer + offset, data, data_size );
+}
+
+bool
+_crude_jph_memory_stream_out_class::IsFailed
+(
+) const
+{
+  return false;
+}
+
+_crude_jph_memory_stream_in_class::_crude_jph_memory_stream_in_class
+(
+  _In_ uint8 const                                        *buffer,
+  _In_ size_t                                              buffer_size
+)
+  : buffer( buffer ), buffer_size( buffer_size ), offset( 0u ), failed( false )
+{
+}
+
+void
+_crude_jph_memory_stream_in_class::ReadBytes
+(
+  _Out_ void                                              *data,
+  _In_ size_t                                              data_size
+)
+{
+  if ( this->failed || this->offset + data_size > this->buffer_size )
+  {
+    this->failed = true;
+    memset( data, 0, data_size );
+    return;
+  }
+
+  memcpy( data, this->buffer + this->offset, data_size );
+  this->offset += data_size;
+}
+
+bool
+_crude_jph_memory_stream_in_class::IsEOF
+(
+) const
+{
+  return this->offset >= this->buffer_size;
+}
+
+bool
+_crude_jph_memory_stream_in_class::IsFailed
+(
+) const
+{
+  return this->failed;
+}
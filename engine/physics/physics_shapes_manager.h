@@ -20,14 +20,35 @@ typedef struct crude_physics_mesh_shape_container
 #endif
   JPH::Ref< JPH::Shape >                                   jph_shape_class;
   char                                                     relative_filepath[ 1024 ];
+  uint64                                                   size;
 } crude_physics_mesh_shape_container;
 
+/* Cooked mesh shape file starts with the header, shape binary state follows */
+typedef struct crude_physics_mesh_shape_cache_header
+{
+  uint32                                                   magic;
+  uint32                                                   version;
+  uint64                                                   source_hash;
+} crude_physics_mesh_shape_cache_header;
+
+/**
+ * Mesh shape built without touching the manager state, so it could be done
+ * on a worker thread. Holds a reference to the shape till it's added.
+ */
+typedef struct crude_physics_prepared_mesh_shape
+{
+  char                                                     relative_filepath[ 1024 ];
+  JPH::Shape                                              *jph_shape;
+} crude_physics_prepared_mesh_shape;
+
 typedef struct crude_physics_shapes_manager_creation
 {
   crude_heap_allocator                                    *allocator;
   crude_heap_allocator                                    *cgltf_temporary_allocator;
   crude_physics                                           *physics_manager;
   char const                                              *resources_absolute_directory;
+  /* Cooked mesh shapes are stored in its subdirectory, cache is disabled if NULL */
+  char const                                              *cache_absolute_directory;
 #if CRUDE_DEVELOP
   crude_gfx_model_renderer_resources_manager              *model_renderer_resources_manager;
 #endif
@@ -45,8 +66,9 @@ typedef struct crude_physics_shapes_manager
 #endif
 
   /* Common */
+  /* Empty if cache is disabled */
+  char                                                     cache_absolute_directory[ 1024 ];
   crude_resource_pool                                      mesh_shape_resource_pool;
-  crude_string_buffer                                      gltf_absolute_filepath_string_buffer;
   CRUDE_HASHMAPSTR( crude_physics_mesh_shape_handle )     *mesh_shape_relative_filepath_to_hadle;
 } crude_physics_shapes_manager;
 
@@ -70,6 +92,37 @@ crude_physics_shapes_manager_get_mesh_shape_handle
   _In_ char const                                         *relative_filepath
 );
 
+CRUDE_API bool
+crude_physics_shapes_manager_has_mesh_shape
+(
+  _In_ crude_physics_shapes_manager                       *manager,
+  _In_ char const                                         *relative_filepath
+);
+
+/* Thread safe, reads only the manager context. Returns false if shape can't be built */
+CRUDE_API bool
+crude_physics_shapes_manager_prepare_mesh_shape
+(
+  _In_ crude_physics_shapes_manager const                 *manager,
+  _In_ char const                                         *relative_filepath,
+  _In_ crude_heap_allocator                               *allocator,
+  _Out_ crude_physics_prepared_mesh_shape                 *prepared_mesh_shape
+);
+
+/* Prepared shape is consumed, if the shape is already loaded it's just discarded */
+CRUDE_API crude_physics_mesh_shape_handle
+crude_physics_shapes_manager_add_prepared_mesh_shape
+(
+  _In_ crude_physics_shapes_manager                       *manager,
+  _In_ crude_physics_prepared_mesh_shape                  *prepared_mesh_shape
+);
+
+CRUDE_API void
+crude_physics_shapes_manager_discard_prepared_mesh_shape
+(
+  _In_ crude_physics_prepared_mesh_shape                  *prepared_mesh_shape
+);
+
 CRUDE_API crude_physics_mesh_shape_container*
 crude_physics_shapes_manager_access_mesh_shape
 (
@@ -77,6 +130,14 @@ crude_physics_shapes_manager_access_mesh_shape
   _In_ crude_physics_mesh_shape_handle                     handle
 );
 
+/* Bodies keep their own shape references, so only the manager reference is dropped */
+CRUDE_API void
+crude_physics_shapes_manager_release_mesh_shape
+(
+  _In_ crude_physics_shapes_manager                       *manager,
+  _In_ crude_physics_mesh_shape_handle                     handle
+);
+
 CRUDE_API void
 crude_physics_shapes_manager_clear
 (
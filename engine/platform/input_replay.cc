@@ -0,0 +1,460 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <engine/core/file.h>
+#include <engine/core/log.h>
+#include <engine/core/array.h>
+#include <engine/core/time.h>
+
+#include <engine/platform/input_replay.h>
+
+#define CRUDE_INPUT_REPLAY_FRAME_FLAG_MOUSE_CHANGED                ( 1 << 0 )
+
+/* delta time, changed keys count, flags, mouse buttons, mouse axes and every key changed */
+#define CRUDE_INPUT_REPLAY_FRAME_SIZE_MAX                          ( sizeof( uint32 ) + sizeof( uint16 ) + 2 * sizeof( uint8 ) + 8 * sizeof( float32 ) + SDL_SCANCODE_COUNT * ( sizeof( uint16 ) + sizeof( uint8 ) ) )
+
+static void
+crude_input_replay_record_frame_
+(
+  _In_ crude_input_replay                                 *replay,
+  _In_ crude_input const                                  *input,
+  _In_ int64                                               delta_time
+);
+
+static bool
+crude_input_replay_replay_frame_
+(
+  _In_ crude_input_replay                                 *replay,
+  _Inout_ crude_input                                     *input,
+  _Out_ int64                                             *delta_time
+);
+
+static bool
+crude_input_replay_read_
+(
+  _In_ crude_input_replay                                 *replay,
+  _Out_ void                                              *data,
+  _In_ uint32                                              size
+);
+
+static void
+crude_input_replay_write_benchmark_
+(
+  _In_ crude_input_replay                                 *replay
+);
+
+static uint8
+crude_input_replay_pack_key_state_
+(
+  _In_ crude_key_state const                              *key
+);
+
+static void
+crude_input_replay_unpack_key_state_
+(
+  _Out_ crude_key_state                                   *key,
+  _In_ uint8                                               bits
+);
+
+static int
+crude_input_replay_compare_time_
+(
+  _In_ void const                                         *a,
+  _In_ void const                                         *b
+);
+
+void
+crude_input_replay_initialize
+(
+  _In_ crude_input_replay                                 *replay,
+  _In_ crude_input_replay_creation const                  *creation
+)
+{
+  uint32                                                   header[ 3 ];
+
+  replay->allocator = creation->allocator;
+  replay->mode = creation->mode;
+  replay->benchmark_absolute_filepath = creation->benchmark_absolute_filepath;
+  replay->file = NULL;
+  replay->recorded_input = CRUDE_COMPOUNT_EMPTY( crude_input );
+  replay->buffer = NULL;
+  replay->buffer_size = 0u;
+  replay->buffer_offset = 0u;
+  replay->frames_timings = NULL;
+  replay->random_seed = 0u;
+  replay->frames_count = 0u;
+  replay->finished = false;
+
+  if ( replay->mode == CRUDE_INPUT_REPLAY_MODE_RECORD )
+  {
+    replay->file = fopen( creation->absolute_filepath, "wb" );
+    if ( !replay->file )
+    {
+      CRUDE_LOG_ERROR( CRUDE_CHANNEL_PLATFORM, "Cannot open input replay file \"%s\" for recording", creation->absolute_filepath );
+      replay->mode = CRUDE_INPUT_REPLAY_MODE_NONE;
+      return;
+    }
+
+    replay->random_seed = CRUDE_CAST( uint32, crude_time_now( ) );
+
+    header[ 0 ] = CRUDE_INPUT_REPLAY_MAGIC;
+    header[ 1 ] = CRUDE_INPUT_REPLAY_VERSION;
+    header[ 2 ] = replay->random_seed;
+    fwrite( header, sizeof( header ), 1, CRUDE_REINTERPRET_CAST( FILE*, replay->file ) );
+    CRUDE_LOG_INFO( CRUDE_CHANNEL_PLATFORM, "Recording input replay to \"%s\"", creation->absolute_filepath );
+  }
+  else if ( replay->mode == CRUDE_INPUT_REPLAY_MODE_REPLAY )
+  {
+    if ( !crude_read_file_binary( creation->absolute_filepath, NULL, &replay->buffer_size ) )
+    {
+      replay->mode = CRUDE_INPUT_REPLAY_MODE_NONE;
+      return;
+    }
+
+    replay->buffer = CRUDE_REINTERPRET_CAST( uint8*, CRUDE_ALLOCATE( crude_heap_allocator_pack( replay->allocator ), replay->buffer_size ) );
+    crude_read_file_binary( creation->absolute_filepath, replay->buffer, &replay->buffer_size );
+
+    if ( !crude_input_replay_read_( replay, header, sizeof( header ) ) || header[ 0 ] != CRUDE_INPUT_REPLAY_MAGIC || header[ 1 ] != CRUDE_INPUT_REPLAY_VERSION )
+    {
+      CRUDE_LOG_ERROR( CRUDE_CHANNEL_PLATFORM, "Input replay file \"%s\" is invalid or has an unsupported version", creation->absolute_filepath );
+      CRUDE_DEALLOCATE( crude_heap_allocator_pack( replay->allocator ), replay->buffer );
+      replay->buffer = NULL;
+      replay->mode = CRUDE_INPUT_REPLAY_MODE_NONE;
+      return;
+    }
+
+    replay->random_seed = header[ 2 ];
+    CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( replay->frames_timings, 1024, crude_heap_allocator_pack( replay->allocator ) );
+    CRUDE_LOG_INFO( CRUDE_CHANNEL_PLATFORM, "Replaying input from \"%s\"", creation->absolute_filepath );
+  }
+}
+
+void
+crude_input_replay_deinitialize
+(
+  _In_ crude_input_replay                                 *replay
+)
+{
+  if ( replay->file )
+  {
+    fclose( CRUDE_REINTERPRET_CAST( FILE*, replay->file ) );
+    replay->file = NULL;
+    CRUDE_LOG_INFO( CRUDE_CHANNEL_PLATFORM, "Input replay recorded %u frames", replay->frames_count );
+  }
+
+  if ( replay->frames_timings )
+  {
+    crude_input_replay_write_benchmark_( replay );
+    CRUDE_ARRAY_DEINITIALIZE( replay->frames_timings );
+  }
+
+  if ( replay->buffer )
+  {
+    CRUDE_DEALLOCATE( crude_heap_allocator_pack( replay->allocator ), replay->buffer );
+    replay->buffer = NULL;
+  }
+}
+
+bool
+crude_input_replay_update
+(
+  _In_ crude_input_replay                                 *replay,
+  _Inout_ crude_input                                     *input,
+  _Inout_ int64                                           *delta_time
+)
+{
+  if ( replay->mode == CRUDE_INPUT_REPLAY_MODE_RECORD )
+  {
+    crude_input_replay_record_frame_( replay, input, *delta_time );
+    return true;
+  }
+
+  if ( replay->mode == CRUDE_INPUT_REPLAY_MODE_REPLAY )
+  {
+    if ( replay->finished )
+    {
+      return false;
+    }
+
+    if ( !crude_input_replay_replay_frame_( replay, input, delta_time ) )
+    {
+      replay->finished = true;
+      CRUDE_LOG_INFO( CRUDE_CHANNEL_PLATFORM, "Input replay finished after %u frames", replay->frames_count );
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void
+crude_input_replay_push_frame_timing
+(
+  _In_ crude_input_replay                                 *replay,
+  _In_ int64                                               frame_time,
+  _In_ int64                                               update_time
+)
+{
+  crude_input_replay_frame_timing                          frame_timing;
+
+  if ( replay->mode != CRUDE_INPUT_REPLAY_MODE_REPLAY || replay->finished )
+  {
+    return;
+  }
+
+  frame_timing.frame_time = frame_time;
+  frame_timing.update_time = update_time;
+  CRUDE_ARRAY_PUSH( replay->frames_timings, frame_timing );
+}
+
+void
+crude_input_replay_record_frame_
+(
+  _In_ crude_input_replay                                 *replay,
+  _In_ crude_input const                                  *input,
+  _In_ int64                                               delta_time
+)
+{
+  uint8                                                    frame[ CRUDE_INPUT_REPLAY_FRAME_SIZE_MAX ];
+  float32                                                  mouse_axes[ 8 ], recorded_mouse_axes[ 8 ];
+  uint32                                                   frame_size, frame_delta_time;
+  uint16                                                   changed_keys_count;
+  uint8                                                    flags, mouse_buttons;
+
+  frame_delta_time = CRUDE_CAST( uint32, delta_time < 0 ? 0 : ( delta_time > UINT32_MAX ? UINT32_MAX : delta_time ) );
+
+  mouse_buttons = crude_input_replay_pack_key_state_( &input->mouse.left ) | ( crude_input_replay_pack_key_state_( &input->mouse.right ) << 3 );
+  mouse_axes[ 0 ] = input->mouse.wnd.x;
+  mouse_axes[ 1 ] = input->mouse.wnd.y;
+  mouse_axes[ 2 ] = input->mouse.rel.x;
+  mouse_axes[ 3 ] = input->mouse.rel.y;
+  mouse_axes[ 4 ] = input->mouse.view.x;
+  mouse_axes[ 5 ] = input->mouse.view.y;
+  mouse_axes[ 6 ] = input->mouse.scroll.x;
+  mouse_axes[ 7 ] = input->mouse.scroll.y;
+
+  recorded_mouse_axes[ 0 ] = replay->recorded_input.mouse.wnd.x;
+  recorded_mouse_axes[ 1 ] = replay->recorded_input.mouse.wnd.y;
+  recorded_mouse_axes[ 2 ] = replay->recorded_input.mouse.rel.x;
+  recorded_mouse_axes[ 3 ] = replay->recorded_input.mouse.rel.y;
+  recorded_mouse_axes[ 4 ] = replay->recorded_input.mouse.view.x;
+  recorded_mouse_axes[ 5 ] = replay->recorded_input.mouse.view.y;
+  recorded_mouse_axes[ 6 ] = replay->recorded_input.mouse.scroll.x;
+  recorded_mouse_axes[ 7 ] = replay->recorded_input.mouse.scroll.y;
+
+  flags = 0u;
+  if ( replay->frames_count == 0 || memcmp( mouse_axes, recorded_mouse_axes, sizeof( mouse_axes ) ) != 0 )
+  {
+    flags |= CRUDE_INPUT_REPLAY_FRAME_FLAG_MOUSE_CHANGED;
+  }
+
+  /* Header is filled after keys are counted */
+  frame_size = sizeof( uint32 ) + sizeof( uint16 ) + 2 * sizeof( uint8 );
+
+  if ( flags & CRUDE_INPUT_REPLAY_FRAME_FLAG_MOUSE_CHANGED )
+  {
+    crude_memory_copy( frame + frame_size, mouse_axes, sizeof( mouse_axes ) );
+    frame_size += sizeof( mouse_axes );
+  }
+
+  changed_keys_count = 0u;
+  for ( uint16 scancode = 0; scancode < SDL_SCANCODE_COUNT; ++scancode )
+  {
+    uint8                                                  key_bits;
+
+    key_bits = crude_input_replay_pack_key_state_( &input->keys[ scancode ] );
+    if ( replay->frames_count && key_bits == crude_input_replay_pack_key_state_( &replay->recorded_input.keys[ scancode ] ) )
+    {
+      continue;
+    }
+
+    crude_memory_copy( frame + frame_size, &scancode, sizeof( scancode ) );
+    frame_size += sizeof( scancode );
+    frame[ frame_size++ ] = key_bits;
+    ++changed_keys_count;
+  }
+
+  crude_memory_copy( frame, &frame_delta_time, sizeof( frame_delta_time ) );
+  crude_memory_copy( frame + sizeof( uint32 ), &changed_keys_count, sizeof( changed_keys_count ) );
+  frame[ sizeof( uint32 ) + sizeof( uint16 ) ] = flags;
+  frame[ sizeof( uint32 ) + sizeof( uint16 ) + 1 ] = mouse_buttons;
+
+  fwrite( frame, frame_size, 1, CRUDE_REINTERPRET_CAST( FILE*, replay->file ) );
+
+  crude_memory_copy( replay->recorded_input.keys, input->keys, sizeof( input->keys ) );
+  replay->recorded_input.mouse = input->mouse;
+  ++replay->frames_count;
+}
+
+bool
+crude_input_replay_replay_frame_
+(
+  _In_ crude_input_replay                                 *replay,
+  _Inout_ crude_input                                     *input,
+  _Out_ int64                                             *delta_time
+)
+{
+  float32                                                  mouse_axes[ 8 ];
+  uint32                                                   frame_delta_time;
+  uint16                                                   changed_keys_count;
+  uint8                                                    flags, mouse_buttons;
+
+  if ( !crude_input_replay_read_( replay, &frame_delta_time, sizeof( frame_delta_time ) ) ||
+       !crude_input_replay_read_( replay, &changed_keys_count, sizeof( changed_keys_count ) ) ||
+       !crude_input_replay_read_( replay, &flags, sizeof( flags ) ) ||
+       !crude_input_replay_read_( replay, &mouse_buttons, sizeof( mouse_buttons ) ) )
+  {
+    return false;
+  }
+
+  if ( flags & CRUDE_INPUT_REPLAY_FRAME_FLAG_MOUSE_CHANGED )
+  {
+    if ( !crude_input_replay_read_( replay, mouse_axes, sizeof( mouse_axes ) ) )
+    {
+      return false;
+    }
+
+    replay->recorded_input.mouse.wnd.x = mouse_axes[ 0 ];
+    replay->recorded_input.mouse.wnd.y = mouse_axes[ 1 ];
+    replay->recorded_input.mouse.rel.x = mouse_axes[ 2 ];
+    replay->recorded_input.mouse.rel.y = mouse_axes[ 3 ];
+    replay->recorded_input.mouse.view.x = mouse_axes[ 4 ];
+    replay->recorded_input.mouse.view.y = mouse_axes[ 5 ];
+    replay->recorded_input.mouse.scroll.x = mouse_axes[ 6 ];
+    replay->recorded_input.mouse.scroll.y = mouse_axes[ 7 ];
+  }
+  crude_input_replay_unpack_key_state_( &replay->recorded_input.mouse.left, mouse_buttons & 0x7 );
+  crude_input_replay_unpack_key_state_( &replay->recorded_input.mouse.right, ( mouse_buttons >> 3 ) & 0x7 );
+
+  for ( uint32 i = 0; i < changed_keys_count; ++i )
+  {
+    uint16                                                 scancode;
+    uint8                                                  key_bits;
+
+    if ( !crude_input_replay_read_( replay, &scancode, sizeof( scancode ) ) || !crude_input_replay_read_( replay, &key_bits, sizeof( key_bits ) ) || scancode >= SDL_SCANCODE_COUNT )
+    {
+      return false;
+    }
+
+    crude_input_replay_unpack_key_state_( &replay->recorded_input.keys[ scancode ], key_bits );
+  }
+
+  /* Previous state was already rotated by crude_platform_update from the last replayed frame */
+  crude_memory_copy( input->keys, replay->recorded_input.keys, sizeof( input->keys ) );
+  input->mouse = replay->recorded_input.mouse;
+  *delta_time = frame_delta_time;
+  ++replay->frames_count;
+  return true;
+}
+
+bool
+crude_input_replay_read_
+(
+  _In_ crude_input_replay                                 *replay,
+  _Out_ void                                              *data,
+  _In_ uint32                                              size
+)
+{
+  /* buffer_size is the count of bytes read, the null terminator is past it */
+  if ( replay->buffer_offset + size > replay->buffer_size )
+  {
+    return false;
+  }
+
+  crude_memory_copy( data, replay->buffer + replay->buffer_offset, size );
+  replay->buffer_offset += size;
+  return true;
+}
+
+void
+crude_input_replay_write_benchmark_
+(
+  _In_ crude_input_replay                                 *replay
+)
+{
+  int64                                                   *sorted_frames_times;
+  FILE                                                    *file;
+  float64                                                  average_frame_time;
+  uint32                                                   frames_timings_count;
+
+  frames_timings_count = CRUDE_ARRAY_LENGTH( replay->frames_timings );
+  if ( frames_timings_count == 0 )
+  {
+    return;
+  }
+
+  average_frame_time = 0.0;
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( sorted_frames_times, frames_timings_count, crude_heap_allocator_pack( replay->allocator ) );
+  for ( uint32 i = 0; i < frames_timings_count; ++i )
+  {
+    sorted_frames_times[ i ] = replay->frames_timings[ i ].frame_time;
+    average_frame_time += replay->frames_timings[ i ].frame_time;
+  }
+  average_frame_time /= frames_timings_count;
+  qsort( sorted_frames_times, frames_timings_count, sizeof( int64 ), crude_input_replay_compare_time_ );
+
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_PLATFORM, "Replay benchmark: %u frames, frame time ms avg %.3f p50 %.3f p95 %.3f p99 %.3f max %.3f",
+    frames_timings_count,
+    average_frame_time / 1000.0,
+    sorted_frames_times[ frames_timings_count / 2 ] / 1000.0,
+    sorted_frames_times[ ( frames_timings_count * 95 ) / 100 ] / 1000.0,
+    sorted_frames_times[ ( frames_timings_count * 99 ) / 100 ] / 1000.0,
+    sorted_frames_times[ frames_timings_count - 1 ] / 1000.0 );
+
+  CRUDE_ARRAY_DEINITIALIZE( sorted_frames_times );
+
+  if ( !replay->benchmark_absolute_filepath )
+  {
+    return;
+  }
+
+  file = fopen( replay->benchmark_absolute_filepath, "w" );
+  if ( !file )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_PLATFORM, "Cannot write replay benchmark to \"%s\"", replay->benchmark_absolute_filepath );
+    return;
+  }
+
+  fprintf( file, "frame,frame_ms,update_ms\n" );
+  for ( uint32 i = 0; i < frames_timings_count; ++i )
+  {
+    fprintf( file, "%u,%.3f,%.3f\n", i, replay->frames_timings[ i ].frame_time / 1000.0, replay->frames_timings[ i ].update_time / 1000.0 );
+  }
+  fclose( file );
+}
+
+uint8
+crude_input_replay_pack_key_state_
+(
+  _In_ crude_key_state const                              *key
+)
+{
+  return ( key->pressed ? 1 : 0 ) | ( key->state ? 2 : 0 ) | ( key->current ? 4 : 0 );
+}
+
+void
+crude_input_replay_unpack_key_state_
+(
+  _Out_ crude_key_state                                   *key,
+  _In_ uint8                                               bits
+)
+{
+  key->pressed = bits & 1;
+  key->state = bits & 2;
+  key->current = bits & 4;
+}
+
+int
+crude_input_replay_compare_time_
+(
+  _In_ void const                                         *a,
+  _In_ void const                                         *b
+)
+{
+  int64                                                    time_a, time_b;
+
+  time_a = *CRUDE_CAST( int64 const*, a );
+  time_b = *CRUDE_CAST( int64 const*, b );
+  return ( time_a > time_b ) - ( time_a < time_b );
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <engine/core/memory.h>
+#include <engine/platform/platform_resources.h>
+
+#define CRUDE_INPUT_REPLAY_MAGIC                                   0x52495243 /* CRIR */
+#define CRUDE_INPUT_REPLAY_VERSION                                 2
+
+typedef enum crude_input_replay_mode
+{
+  CRUDE_INPUT_REPLAY_MODE_NONE,
+  CRUDE_INPUT_REPLAY_MODE_RECORD,
+  CRUDE_INPUT_REPLAY_MODE_REPLAY,
+} crude_input_replay_mode;
+
+typedef struct crude_input_replay_creation
+{
+  crude_input_replay_mode                                  mode;
+  char const                                              *absolute_filepath;
+  /* Optional, per frame timings are written there as csv when the replay ends */
+  char const                                              *benchmark_absolute_filepath;
+  crude_heap_allocator                                    *allocator;
+} crude_input_replay_creation;
+
+typedef struct crude_input_replay_frame_timing
+{
+  int64                                                    frame_time;
+  int64                                                    update_time;
+} crude_input_replay_frame_timing;
+
+/**
+ * Records crude_input and frame delta time once per frame and replays
+ * them later. Frames only store keys which changed since the previous
+ * frame, so an idle frame costs a few bytes. In replay mode frame timings
+ * are gathered for the benchmark output.
+ */
+typedef struct crude_input_replay
+{
+  /* Context */
+  crude_heap_allocator                                    *allocator;
+
+  /* Options */
+  crude_input_replay_mode                                  mode;
+  char const                                              *benchmark_absolute_filepath;
+
+  /* Record */
+  void                                                    *file;
+  crude_input                                              recorded_input;
+
+  /* Replay */
+  uint8                                                   *buffer;
+  uint32                                                   buffer_size;
+  uint32                                                   buffer_offset;
+  crude_input_replay_frame_timing                         *frames_timings;
+
+  /* Common */
+  /* Stored in the file header, gameplay random is seeded with it when the first frame is recorded or replayed */
+  uint32                                                   random_seed;
+  uint32                                                   frames_count;
+  bool                                                     finished;
+} crude_input_replay;
+
+CRUDE_API void
+crude_input_replay_initialize
+(
+  _In_ crude_input_replay                                 *replay,
+  _In_ crude_input_replay_creation const                  *creation
+);
+
+/* Writes the benchmark file if replay mode gathered timings */
+CRUDE_API void
+crude_input_replay_deinitialize
+(
+  _In_ crude_input_replay                                 *replay
+);
+
+/**
+ * Record mode writes input and delta_time, replay mode overwrites them
+ * with the next recorded frame. Returns false once the replay ran out of
+ * frames, input and delta_time are left untouched then.
+ */
+CRUDE_API bool
+crude_input_replay_update
+(
+  _In_ crude_input_replay                                 *replay,
+  _Inout_ crude_input                                     *input,
+  _Inout_ int64                                           *delta_time
+);
+
+CRUDE_API void
+crude_input_replay_push_frame_timing
+(
+  _In_ crude_input_replay                                 *replay,
+  _In_ int64                                               frame_time,
+  _In_ int64                                               update_time
+);
@@ -9,6 +9,7 @@ crude_components_serialization_manager_initialize
 {
   CRUDE_HASHMAP_INITIALIZE_WITH_CAPACITY( manager->component_id_to_imgui_funs, 512, crude_heap_allocator_pack( allocator ) );
   CRUDE_HASHMAP_INITIALIZE_WITH_CAPACITY( manager->component_id_to_json_funs, 512, crude_heap_allocator_pack( allocator ) );
+  CRUDE_HASHMAP_INITIALIZE_WITH_CAPACITY( manager->component_id_to_value_json_funs, 512, crude_heap_allocator_pack( allocator ) );
   CRUDE_HASHMAPSTR_INITIALIZE_WITH_CAPACITY( manager->component_name_to_json_funs, 512, crude_heap_allocator_pack( allocator ) );
 }
 
@@ -20,6 +21,7 @@ crude_components_serialization_manager_deinitialize
 {
   CRUDE_HASHMAP_DEINITIALIZE( manager->component_id_to_imgui_funs );
   CRUDE_HASHMAP_DEINITIALIZE( manager->component_id_to_json_funs );
+  CRUDE_HASHMAP_DEINITIALIZE( manager->component_id_to_value_json_funs );
   CRUDE_HASHMAPSTR_DEINITIALIZE( manager->component_name_to_json_funs );
 }
 
@@ -45,6 +47,17 @@ crude_components_serialization_manager_add_component_to_json
   CRUDE_HASHMAP_SET( manager->component_id_to_json_funs, component_id, fn );
 }
 
+void
+crude_components_serialization_manager_add_component_value_to_json
+(
+  _In_ crude_components_serialization_manager             *manager,
+  _In_ ecs_id_t                                            component_id,
+  _In_ crude_crude_components_serialization_parse_component_value_to_json_func fn
+)
+{
+  CRUDE_HASHMAP_SET( manager->component_id_to_value_json_funs, component_id, fn );
+}
+
 void
 crude_components_serialization_manager_add_json_to_component
 (
@@ -24,6 +24,12 @@ typedef cJSON* (*crude_crude_components_serialization_parse_component_to_json_fu
   _In_ crude_node_manager                                 *manager
 );
 
+typedef cJSON* (*crude_crude_components_serialization_parse_component_value_to_json_func)
+(
+  _In_ void const                                         *component,
+  _In_ crude_node_manager                                 *manager
+);
+
 typedef void (*crude_crude_components_serialization_parse_json_to_component_func)
 (
   _In_ crude_ecs                                          *world,
@@ -36,6 +42,7 @@ typedef struct crude_components_serialization_manager
 {
   CRUDE_HASHMAP( crude_crude_components_serialization_parse_component_to_imgui_func ) *component_id_to_imgui_funs;
   CRUDE_HASHMAP( crude_crude_components_serialization_parse_component_to_json_func ) *component_id_to_json_funs;
+  CRUDE_HASHMAP( crude_crude_components_serialization_parse_component_value_to_json_func ) *component_id_to_value_json_funs;
   CRUDE_HASHMAPSTR( crude_crude_components_serialization_parse_json_to_component_func ) *component_name_to_json_funs;
 } crude_components_serialization_manager;
 
@@ -68,6 +75,14 @@ crude_components_serialization_manager_add_component_to_json
   _In_ crude_crude_components_serialization_parse_component_to_json_func fn
 );
 
+CRUDE_API void
+crude_components_serialization_manager_add_component_value_to_json
+(
+  _In_ crude_components_serialization_manager             *manager,
+  _In_ ecs_id_t                                            component_id,
+  _In_ crude_crude_components_serialization_parse_component_value_to_json_func fn
+);
+
 CRUDE_API void
 crude_components_serialization_manager_add_json_to_component
 (
@@ -119,6 +134,11 @@ cJSON* crude_components_serialization_parse_component_to_json_func_raw##componen
   _In_ crude_entity                                        node,\
   _In_ crude_node_manager                                 *manager\
 );\
+cJSON* crude_components_serialization_parse_component_value_to_json_func_raw##component_type\
+(\
+  _In_ void const                                         *component,\
+  _In_ crude_node_manager                                 *manager\
+);\
 cJSON* crude_parse_component_to_json_func##component_type\
 (\
   _In_ component_type const                               *component,\
@@ -144,7 +164,8 @@ void crude_components_serialization_parse_component_to_imgui_func_raw##component
 crude_components_serialization_manager_add_component_to_imgui( manager, ecs_id( component_type ), crude_components_serialization_parse_component_to_imgui_func_raw##component_type )
 
 #define CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, component_type )\
-crude_components_serialization_manager_add_component_to_json( manager, ecs_id( component_type ), crude_components_serialization_parse_component_to_json_func_raw##component_type )
+crude_components_serialization_manager_add_component_to_json( manager, ecs_id( component_type ), crude_components_serialization_parse_component_to_json_func_raw##component_type ),\
+crude_components_serialization_manager_add_component_value_to_json( manager, ecs_id( component_type ), crude_components_serialization_parse_component_value_to_json_func_raw##component_type )
 
 #define CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, component_type )\
 crude_components_serialization_manager_add_json_to_component( manager, CRUDE_COMPOUNT( crude_string_link, { #component_type } ), crude_components_serialization_parse_json_to_component__func_raw##component_type )
@@ -186,6 +207,14 @@ cJSON* crude_components_serialization_parse_component_to_json_func_raw##componen
   }\
   return NULL;\
 }\
+cJSON* crude_components_serialization_parse_component_value_to_json_func_raw##component_type\
+(\
+  _In_ void const                                         *component,\
+  _In_ crude_node_manager                                 *manager\
+)\
+{\
+  return CRUDE_PARSE_COMPONENT_TO_JSON( component_type )( CRUDE_REINTERPRET_CAST( component_type const*, component ), manager );\
+}\
 cJSON* crude_parse_component_to_json_func##component_type\
 (\
   _In_ component_type const                               *component,\
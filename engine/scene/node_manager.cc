@@ -4,8 +4,11 @@
 #include <engine/core/file.h>
 #include <engine/core/string.h>
 #include <engine/core/array.h>
+#include <engine/core/profiler.h>
+#include <engine/core/time.h>
 #include <engine/scene/scene_ecs.h>
 #include <engine/physics/physics_ecs.h>
+#include <engine/audio/audio_ecs.h>
 #include <engine/scene/scripts/free_camera_ecs.h>
 #include <engine/graphics/scene_renderer.h>
 
@@ -20,328 +23,3305 @@ crude_node_manager_load_node_from_json_
   _In_opt_ crude_entity                                   *parent
 );
 
-static cJSON*
-crude_node_manager_parse_json_
+static void
+crude_node_manager_load_components_from_json_
 (
   _In_ crude_node_manager                                 *manager,
-  _In_ char const                                         *absolute_filepath
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_opt_ cJSON const                                    *components_json
+);
+
+static void
+crude_node_manager_staging_task_set_fn_
+(
+  _In_ uint32_t                                            start_,
+  _In_ uint32_t                                            end_,
+  _In_ uint32_t                                            threadnum_,
+  _In_ void                                               *ctx
 );
 
 static cJSON*
-crude_node_manager_node_to_json_hierarchy_
+crude_node_manager_stage_node_file_
 (
   _In_ crude_node_manager                                 *manager,
-  _In_ crude_ecs                                          *world,
-  _In_ crude_entity                                        node
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ char const                                         *node_realtive_filepath
 );
 
-void
-crude_node_manager_initialize
+static bool
+crude_node_manager_stage_node_json_
 (
   _In_ crude_node_manager                                 *manager,
-  _In_ crude_node_manager_creation const                  *creation
-)
-{
-  manager->physics_manager = creation->physics_manager;
-  manager->temporary_allocator = creation->temporary_allocator;
-  manager->components_serialization_manager = creation->components_serialization_manager;
-  manager->resources_absolute_directory = creation->resources_absolute_directory;
-  manager->model_renderer_resources_manager = creation->model_renderer_resources_manager;
-  manager->allocator = creation->allocator;
-  manager->select_camera_func = creation->select_camera_func;
-  manager->select_camera_ctx = creation->select_camera_ctx;
-  manager->audio_device = creation->audio_device;
-  manager->scene_renderer = creation->scene_renderer;
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ cJSON const                                        *node_json,
+  _In_ int32                                               parent_index
+);
 
-  CRUDE_HASHMAPSTR_INITIALIZE( manager->relative_filepath_to_node_json, crude_heap_allocator_pack( manager->allocator ) );
-  crude_string_buffer_initialize( &manager->absolute_filepath_string_buffer, CRUDE_RMEGA( 1 ), crude_heap_allocator_pack( manager->allocator ) );
-}
+static void
+crude_node_manager_stage_assets_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_opt_ cJSON const                                    *components_json
+);
 
-void
-crude_node_manager_deinitialize
+static void
+crude_node_manager_stage_asset_
 (
-  _In_ crude_node_manager                                 *manager
-)
-{
-  crude_node_manager_clear( manager );
-  crude_string_buffer_deinitialize( &manager->absolute_filepath_string_buffer );
-  CRUDE_HASHMAPSTR_DEINITIALIZE( manager->relative_filepath_to_node_json );
-}
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ crude_node_manager_staged_asset_type                type,
+  _In_ char const                                         *relative_filepath
+);
 
-void
-crude_node_manager_clear
+static void
+crude_node_manager_prepare_staged_assets_
 (
-  _In_ crude_node_manager                                 *manager
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_load                       *node_load
+);
+
+static void
+crude_node_manager_add_staged_asset_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_staged_asset                    *staged_asset
+);
+
+static void
+crude_node_manager_commit_staged_command_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ crude_node_manager_staged_command const            *staged_command
+);
+
+static void
+crude_node_manager_finish_node_load_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ bool                                                cache_jsons
+);
+
+static void
+crude_node_manager_load_components_from_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_opt_ cJSON const                                    *components_json
 )
 {
-  for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( manager->relative_filepath_to_node_json ); ++i )
+  for ( uint32 component_index = 0; component_index < cJSON_GetArraySize( components_json ); ++component_index )
   {
-    if ( crude_hashmapstr_backet_key_hash_valid( manager->relative_filepath_to_node_json[ i ].key.key_hash ) )
-    {
-      cJSON_Delete( manager->relative_filepath_to_node_json[ i ].value.json );
-    }
-    manager->relative_filepath_to_node_json[ i ].key.key_hash = CRUDE_HASHMAPSTR_BACKET_STATE_EMPTY;
+    cJSON const                                           *component_json;
+    cJSON const                                           *component_type_json;
+    char const                                            *component_type;
+
+    component_json = cJSON_GetArrayItem( components_json, component_index );
+    component_type_json = cJSON_GetObjectItemCaseSensitive( component_json, "type" );
+    component_type = cJSON_GetStringValue( component_type_json );
+  
+    int64 index = CRUDE_HASHMAPSTR_GET_INDEX( manager->components_serialization_manager->component_name_to_json_funs, component_type );
+    CRUDE_ASSERT( index != -1 );
+    manager->components_serialization_manager->component_name_to_json_funs[ index ].value( world, node, component_json, manager );
   }
 }
 
-crude_entity
-crude_node_manager_create_node
+void
+crude_node_manager_staging_task_set_fn_
 (
-  _In_ crude_node_manager                                 *manager,
-  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
-  _In_ crude_ecs                                          *world
+  _In_ uint32_t                                            start_,
+  _In_ uint32_t                                            end_,
+  _In_ uint32_t                                            threadnum_,
+  _In_ void                                               *ctx
 )
 {
-  char const                                              *node_absolute_filepath;
-  crude_node_manager_node_json                            *node_json;
-  int64                                                    node_index;
-  crude_node_manager_node_json                             new_node_json;
+  crude_node_manager                                      *manager;
+  crude_node_manager_node_load                            *node_load;
+  cJSON                                                   *node_json;
 
-  crude_string_buffer_clear( &manager->absolute_filepath_string_buffer );
-  node_absolute_filepath = crude_string_buffer_append_use_f( &manager->absolute_filepath_string_buffer, "%s%s", manager->resources_absolute_directory, node_realtive_filepath );
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_staging_task_set_fn_" );
 
-  node_index = CRUDE_HASHMAPSTR_GET_INDEX( manager->relative_filepath_to_node_json, node_realtive_filepath );
-  if ( node_index == -1 )
-  {
-    new_node_json.json = crude_node_manager_parse_json_( manager, node_absolute_filepath );
-    crude_string_copy( new_node_json.relative_filepath, node_realtive_filepath, sizeof( new_node_json.relative_filepath ) );
+  manager = CRUDE_CAST( crude_node_manager*, ctx );
+  node_load = manager->staging_node_load;
 
-    CRUDE_HASHMAPSTR_SET( manager->relative_filepath_to_node_json, CRUDE_COMPOUNT( crude_string_link, { new_node_json.relative_filepath } ), new_node_json );
-    node_json = &new_node_json;
+  if ( node_load->state == CRUDE_NODE_MANAGER_NODE_LOAD_STATE_PREPARING )
+  {
+    crude_node_manager_prepare_staged_assets_( manager, node_load );
+    CRUDE_PROFILER_ZONE_END;
+    return;
   }
-  else 
+  
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_load->staged_jsons, 4, crude_heap_allocator_pack( &manager->staging_allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_load->staged_nodes, 64, crude_heap_allocator_pack( &manager->staging_allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_load->staged_commands, 128, crude_heap_allocator_pack( &manager->staging_allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_load->staged_assets, 16, crude_heap_allocator_pack( &manager->staging_allocator ) );
+
+  node_json = crude_node_manager_stage_node_file_( manager, node_load, node_load->relative_filepath );
+  node_load->staging_failed = !node_json || !crude_node_manager_stage_node_json_( manager, node_load, node_json, -1 );
+  
+  CRUDE_ARRAY_INITIALIZE_WITH_LENGTH( node_load->nodes, CRUDE_ARRAY_LENGTH( node_load->staged_nodes ), crude_heap_allocator_pack( &manager->staging_allocator ) );
+
+  for ( uint32 i = 0; !node_load->staging_failed && i < CRUDE_ARRAY_LENGTH( node_load->staged_nodes ); ++i )
   {
-    node_json = &manager->relative_filepath_to_node_json[ node_index ].value;
+    crude_node_manager_stage_assets_( manager, node_load, node_load->staged_nodes[ i ].components_json );
+    crude_node_manager_stage_assets_( manager, node_load, node_load->staged_nodes[ i ].override_components_json );
   }
 
-  return crude_node_manager_load_node_from_json_( manager, node_json->json, world, NULL );
+  CRUDE_PROFILER_ZONE_END;
 }
 
-void
-crude_node_manager_save_node_to_file
+cJSON*
+crude_node_manager_stage_node_file_
 (
   _In_ crude_node_manager                                 *manager,
-  _In_ crude_ecs                                          *world,
-  _In_ crude_entity                                        node,
-  _In_ char const                                          saved_relative_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ]
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ char const                                         *node_realtive_filepath
 )
 {
-  char const                                              *saved_absolute_filepath;
-  cJSON                                                   *node_json;
-  char const                                              *node_str;
+  crude_node_manager_node_json                             staged_json;
+  char                                                     node_absolute_filepath[ 2 * CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ];
+  uint8                                                   *json_buffer;
+  uint32                                                   json_buffer_size;
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( node_load->staged_jsons ); ++i )
+  {
+    if ( crude_string_cmp( node_load->staged_jsons[ i ].relative_filepath, node_realtive_filepath ) == 0 )
+    {
+      return node_load->staged_jsons[ i ].json;
+    }
+  }
+
+  /* Manager cache and string buffer belong to the main thread, node file is parsed again */
+  crude_snprintf( node_absolute_filepath, sizeof( node_absolute_filepath ), "%s%s", manager->resources_absolute_directory, node_realtive_filepath );
   
-  crude_string_buffer_clear( &manager->absolute_filepath_string_buffer );
-  saved_absolute_filepath = crude_string_buffer_append_use_f( &manager->absolute_filepath_string_buffer, "%s%s", manager->resources_absolute_directory, saved_relative_filepath );
+  if ( !crude_file_exist( node_absolute_filepath ) )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot find a file \"%s\" to parse scene", node_absolute_filepath );
+    return NULL;
+  }
+  
+  crude_read_file( node_absolute_filepath, crude_heap_allocator_pack( &manager->staging_allocator ), &json_buffer, &json_buffer_size );
+  
+  staged_json.json = cJSON_ParseWithLength( CRUDE_REINTERPRET_CAST( char const*, json_buffer ), json_buffer_size );
+  CRUDE_DEALLOCATE( crude_heap_allocator_pack( &manager->staging_allocator ), json_buffer );
+
+  if ( !staged_json.json )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot parse a file for scene... Error %s", cJSON_GetErrorPtr() );
+    return NULL;
+  }
 
-  node_json = crude_node_manager_node_to_json_hierarchy_( manager, world, node );
-  node_str = cJSON_Print( node_json );
-  crude_write_file( saved_absolute_filepath, node_str, crude_string_length( node_str ) ); // TODO
-  cJSON_Delete( node_json );
+  crude_string_copy( staged_json.relative_filepath, node_realtive_filepath, sizeof( staged_json.relative_filepath ) );
+  CRUDE_ARRAY_PUSH( node_load->staged_jsons, staged_json );
+  return staged_json.json;
 }
 
-crude_entity
-crude_node_manager_load_node_from_json_
+bool
+crude_node_manager_stage_node_json_
 (
   _In_ crude_node_manager                                 *manager,
-  _In_ cJSON                                              *node_json,
-  _In_ crude_ecs                                          *world,
-  _In_opt_ crude_entity                                   *parent
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ cJSON const                                        *node_json,
+  _In_ int32                                               parent_index
 )
 {
-  crude_entity                                             node;
-  char const                                              *node_name;
-  bool                                                     is_node_external;
-  bool                                                     copy_components;
-  
-  node_name = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( node_json, "name") );
+  crude_node_manager_staged_node                           staged_node;
+  crude_node_manager_staged_command                        staged_command;
+  cJSON const                                             *children_json;
+  uint32                                                   node_index;
 
-  copy_components = true;
+  node_index = CRUDE_ARRAY_LENGTH( node_load->staged_nodes );
 
-  is_node_external = cJSON_HasObjectItem( node_json, "external" );
-  if ( is_node_external )
+  staged_node = CRUDE_COMPOUNT_EMPTY( crude_node_manager_staged_node );
+  staged_node.name = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( node_json, "name" ) );
+  staged_node.parent_index = parent_index;
+  staged_node.components_json = cJSON_GetObjectItemCaseSensitive( node_json, "components" );
+  children_json = cJSON_GetObjectItemCaseSensitive( node_json, "children" );
+
+  if ( cJSON_HasObjectItem( node_json, "external" ) )
   {
-    cJSON                                                 *node_external_json;
+    cJSON const                                           *node_external_json;
+    cJSON const                                           *external_node_json;
     char const                                            *node_external_relative_filepath;
-    crude_node_external                                    node_external_component;
 
-    CRUDE_ASSERT( parent ); /* WTF IS GOING ONE, DONT PUT EXTERNAL ON TOP OF SCENE */
+    CRUDE_ASSERT( parent_index != -1 ); /* WTF IS GOING ONE, DONT PUT EXTERNAL ON TOP OF SCENE */
 
-    node_external_json = cJSON_GetObjectItemCaseSensitive( node_json, "external");
+    node_external_json = cJSON_GetObjectItemCaseSensitive( node_json, "external" );
     node_external_relative_filepath = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( node_external_json, "relative_filepath" ) );
     
-    node_external_component = crude_node_external_empty( );
-    node_external_component.type = CRUDE_CAST( crude_node_external_type, cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( node_external_json, "type") ) );
-    crude_string_copy( node_external_component.node_relative_filepath, node_external_relative_filepath, sizeof( node_external_component.node_relative_filepath ) );
-    node = crude_node_manager_create_node( manager, node_external_relative_filepath, world );
-    crude_entity_set_name( world, node, node_name );
-    crude_entity_set_parent( world, node, *parent );
-
-    if ( node_external_component.type == CRUDE_NODE_EXTERNAL_TYPE_REFERENCE )
+    external_node_json = crude_node_manager_stage_node_file_( manager, node_load, node_external_relative_filepath );
+    if ( !external_node_json )
     {
-      copy_components = false;
+      return false;
     }
-    
-    CRUDE_ENTITY_SET_COMPONENT( world, node, crude_node_external, { node_external_component } );
+
+    staged_node.is_external = true;
+    staged_node.external = crude_node_external_empty( );
+    staged_node.external.type = CRUDE_CAST( crude_node_external_type, cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( node_external_json, "type") ) );
+    crude_string_copy( staged_node.external.node_relative_filepath, node_external_relative_filepath, sizeof( staged_node.external.node_relative_filepath ) );
+
+    staged_node.override_components_json = ( staged_node.external.type == CRUDE_NODE_EXTERNAL_TYPE_REFERENCE ) ? NULL : staged_node.components_json;
+    staged_node.components_json = cJSON_GetObjectItemCaseSensitive( external_node_json, "components" );
+    children_json = cJSON_GetObjectItemCaseSensitive( external_node_json, "children" );
   }
-  else
+
+  CRUDE_ARRAY_PUSH( node_load->staged_nodes, staged_node );
+
+  staged_command.type = CRUDE_NODE_MANAGER_STAGED_COMMAND_TYPE_CREATE_NODE;
+  staged_command.node_index = node_index;
+  CRUDE_ARRAY_PUSH( node_load->staged_commands, staged_command );
+
+  for ( uint32 child_index = 0; child_index < cJSON_GetArraySize( children_json ); ++child_index )
   {
-    node = crude_entity_create_empty( world, node_name );
-    
-    if ( parent )
+    if ( !crude_node_manager_stage_node_json_( manager, node_load, cJSON_GetArrayItem( children_json, child_index ), node_index ) )
     {
-      crude_entity_set_parent( world, node, *parent );
+      return false;
     }
   }
-  
-  if ( !is_node_external )
+
+  staged_command.type = CRUDE_NODE_MANAGER_STAGED_COMMAND_TYPE_SET_COMPONENTS;
+  staged_command.node_index = node_index;
+  CRUDE_ARRAY_PUSH( node_load->staged_commands, staged_command );
+  return true;
+}
+
+void
+crude_node_manager_stage_assets_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_opt_ cJSON const                                    *components_json
+)
+{
+  for ( uint32 component_index = 0; component_index < cJSON_GetArraySize( components_json ); ++component_index )
   {
-    cJSON                                                 *children_json;
-    cJSON                                                 *child_json;
-  
-    children_json = cJSON_GetObjectItemCaseSensitive( node_json, "children" );
-    for ( uint32 child_index = 0; child_index < cJSON_GetArraySize( children_json ); ++child_index )
+    cJSON const                                           *component_json;
+    char const                                            *component_type;
+
+    component_json = cJSON_GetArrayItem( components_json, component_index );
+    component_type = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( component_json, "type" ) );
+
+    if ( crude_string_cmp( component_type, CRUDE_COMPONENT_STRING( crude_gltf ) ) == 0 )
     {
-      child_json = cJSON_GetArrayItem( children_json, child_index );
-      crude_entity child_node = crude_node_manager_load_node_from_json_( manager, child_json, world, &node );
+      crude_node_manager_stage_asset_( node_load, CRUDE_NODE_MANAGER_STAGED_ASSET_TYPE_GLTF, cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( component_json, "path" ) ) );
+    }
+    else if ( crude_string_cmp( component_type, CRUDE_COMPONENT_STRING( crude_physics_static_body ) ) == 0 || crude_string_cmp( component_type, CRUDE_COMPONENT_STRING( crude_physics_kinematic_body ) ) == 0 )
+    {
+      char const                                          *mesh_relative_filepath;
+
+      if ( cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( component_json, "shape_type" ) ) != CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH )
+      {
+        continue;
+      }
+
+      mesh_relative_filepath = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( cJSON_GetObjectItemCaseSensitive( component_json, "mesh" ), "relative_filepath" ) );
+      crude_node_manager_stage_asset_( node_load, CRUDE_NODE_MANAGER_STAGED_ASSET_TYPE_MESH_SHAPE, mesh_relative_filepath );
+#if CRUDE_DEVELOP
+      /* Mesh shape debug model */
+      if ( manager->physics_manager->physics_shapes_manager->model_renderer_resources_manager )
+      {
+        crude_node_manager_stage_asset_( node_load, CRUDE_NODE_MANAGER_STAGED_ASSET_TYPE_GLTF, mesh_relative_filepath );
+      }
+#endif
     }
   }
+}
 
-  if ( copy_components )
+void
+crude_node_manager_stage_asset_
+(
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ crude_node_manager_staged_asset_type                type,
+  _In_ char const                                         *relative_filepath
+)
+{
+  crude_node_manager_staged_asset                          staged_asset;
+
+  if ( !relative_filepath || !relative_filepath[ 0 ] )
   {
-    cJSON const                                           *node_components_json;
-  
-    node_components_json = cJSON_GetObjectItemCaseSensitive( node_json, "components" );
+    return;
+  }
 
-    for ( uint32 component_index = 0; component_index < cJSON_GetArraySize( node_components_json ); ++component_index )
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( node_load->staged_assets ); ++i )
+  {
+    if ( node_load->staged_assets[ i ].type == type && crude_string_cmp( node_load->staged_assets[ i ].relative_filepath, relative_filepath ) == 0 )
     {
-      cJSON const                                       *component_json;
-      cJSON const                                       *component_type_json;
-      char const                                        *component_type;
-
-      component_json = cJSON_GetArrayItem( node_components_json, component_index );
-      component_type_json = cJSON_GetObjectItemCaseSensitive( component_json, "type" );
-      component_type = cJSON_GetStringValue( component_type_json );
-  
-      int64 index = CRUDE_HASHMAPSTR_GET_INDEX( manager->components_serialization_manager->component_name_to_json_funs, component_type );
-      CRUDE_ASSERT( index != -1 );
-      manager->components_serialization_manager->component_name_to_json_funs[ index ].value( world, node, component_json, manager );
+      return;
     }
   }
 
-  return node;
+  staged_asset = CRUDE_COMPOUNT_EMPTY( crude_node_manager_staged_asset );
+  staged_asset.type = type;
+  staged_asset.relative_filepath = relative_filepath;
+  CRUDE_ARRAY_PUSH( node_load->staged_assets, staged_asset );
 }
 
-cJSON*
-crude_node_manager_parse_json_
+void
+crude_node_manager_prepare_staged_assets_
 (
   _In_ crude_node_manager                                 *manager,
-  _In_ char const                                         *absolute_filepath
+  _In_ crude_node_manager_node_load                       *node_load
 )
 {
-  cJSON                                                 *json;
-  uint8                                                 *json_buffer;
-  uint32                                                 json_buffer_size;
-  uint32                                                 temporary_allocator_marker;
-  
-  temporary_allocator_marker = crude_stack_allocator_get_marker( manager->temporary_allocator );
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( node_load->staged_assets ); ++i )
+  {
+    crude_node_manager_staged_asset                       *staged_asset;
 
-  json = NULL;
+    staged_asset = &node_load->staged_assets[ i ];
+    if ( staged_asset->type == CRUDE_NODE_MANAGER_STAGED_ASSET_TYPE_GLTF )
+    {
+      crude_gfx_model_renderer_resources_manager_prepare_gltf( manager->model_renderer_resources_manager, staged_asset->relative_filepath, &manager->staging_allocator, &manager->staging_allocator, &staged_asset->prepared_gltf );
+    }
+    else
+    {
+      crude_physics_shapes_manager_prepare_mesh_shape( manager->physics_manager->physics_shapes_manager, staged_asset->relative_filepath, &manager->staging_allocator, &staged_asset->prepared_mesh_shape );
+    }
+  }
+}
 
-  if ( !crude_file_exist( absolute_filepath ) )
+void
+crude_node_manager_add_staged_asset_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_staged_asset                    *staged_asset
+)
+{
+  if ( staged_asset->type == CRUDE_NODE_MANAGER_STAGED_ASSET_TYPE_GLTF )
   {
-    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot find a file \"%s\" to parse scene", absolute_filepath );
-    goto cleanup;
+    crude_gfx_model_renderer_resources_manager_add_prepared_gltf( manager->model_renderer_resources_manager, &staged_asset->prepared_gltf );
   }
-  
-  crude_read_file( absolute_filepath, crude_stack_allocator_pack( manager->temporary_allocator ), &json_buffer, &json_buffer_size );
-  
-  json = cJSON_ParseWithLength( CRUDE_REINTERPRET_CAST( char const*, json_buffer ), json_buffer_size );
-  if ( !json )
+  else
   {
-    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot parse a file for scene... Error %s", cJSON_GetErrorPtr() );
-    goto cleanup;
+    crude_physics_shapes_manager_add_prepared_mesh_shape( manager->physics_manager->physics_shapes_manager, &staged_asset->prepared_mesh_shape );
   }
-
-cleanup:
-  crude_stack_allocator_free_marker( manager->temporary_allocator, temporary_allocator_marker );
-  return json;
 }
 
-cJSON*
-crude_node_manager_node_to_json_hierarchy_
+void
+crude_node_manager_commit_staged_command_
 (
   _In_ crude_node_manager                                 *manager,
-  _In_ crude_ecs                                          *world,
-  _In_ crude_entity                                        node
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ crude_node_manager_staged_command const            *staged_command
 )
 {
-  cJSON                                                   *node_json;
-  bool                                                     is_external_node, is_gltf_node, export_components;
-  
-  is_external_node = is_gltf_node = false;
-
-  node_json = cJSON_CreateObject( );
-  
-  cJSON_AddItemToObject( node_json, "name", cJSON_CreateString( crude_entity_get_name( world, node ) ) );
+  crude_node_manager_staged_node const                    *staged_node;
+  crude_entity                                             node;
 
-  export_components = true;
+  staged_node = &node_load->staged_nodes[ staged_command->node_index ];
 
-  is_external_node = CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_node_external );
-  if ( is_external_node )
+  if ( staged_command->type == CRUDE_NODE_MANAGER_STAGED_COMMAND_TYPE_CREATE_NODE )
   {
-    crude_node_external const                             *node_external;
-    cJSON                                                 *node_external_json;
-
-    node_external = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_node_external );
-    
-    node_external_json = cJSON_AddObjectToObject( node_json, "external" );
-    cJSON_AddItemToObject( node_external_json, "relative_filepath", cJSON_CreateString( node_external->node_relative_filepath ) );
-    cJSON_AddItemToObject( node_external_json, "type", cJSON_CreateNumber( node_external->type ) );
+    node = crude_entity_create_empty( node_load->world, staged_node->name );
 
-    if ( node_external->type != CRUDE_NODE_EXTERNAL_TYPE_COPY )
+    if ( staged_node->parent_index != -1 )
     {
-      export_components = false;
+      crude_entity_set_parent( node_load->world, node, node_load->nodes[ staged_node->parent_index ] );
     }
-  }
-  
-  if ( export_components )
-  {
-    cJSON                                                 *node_components_json;
-
-    node_components_json = cJSON_AddArrayToObject( node_json, "components" );
-    
-    for ( uint32 i = 0; i < CRUDE_HASHMAP_CAPACITY( manager->components_serialization_manager->component_id_to_json_funs ); ++i )
+    else if ( node_load->parent )
     {
-      if ( crude_hashmap_backet_key_valid( manager->components_serialization_manager->component_id_to_json_funs[ i ].key ) )
-      {
-        cJSON* component_json = manager->components_serialization_manager->component_id_to_json_funs[ i ].value( world, node, manager );
-        if ( component_json )
-        {
-          cJSON_AddItemToArray( node_components_json, component_json );
-        }
-      }
+      crude_entity_set_parent( node_load->world, node, node_load->parent );
+    }
+
+    node_load->nodes[ staged_command->node_index ] = node;
+    return;
+  }
+
+  node = node_load->nodes[ staged_command->node_index ];
+
+  crude_node_manager_load_components_from_json_( manager, node_load->world, node, staged_node->components_json );
+
+  if ( staged_node->is_external )
+  {
+    CRUDE_ENTITY_SET_COMPONENT( node_load->world, node, crude_node_external, { staged_node->external } );
+  }
+  
+  crude_node_manager_load_components_from_json_( manager, node_load->world, node, staged_node->override_components_json );
+}
+
+void
+crude_node_manager_finish_node_load_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_load                       *node_load,
+  _In_ bool                                                cache_jsons
+)
+{
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( node_load->staged_jsons ); ++i )
+  {
+    if ( cache_jsons && CRUDE_HASHMAPSTR_GET_INDEX( manager->relative_filepath_to_node_json, node_load->staged_jsons[ i ].relative_filepath ) == -1 )
+    {
+      CRUDE_HASHMAPSTR_SET( manager->relative_filepath_to_node_json, CRUDE_COMPOUNT( crude_string_link, { node_load->staged_jsons[ i ].relative_filepath } ), node_load->staged_jsons[ i ] );
+    }
+    else
+    {
+      cJSON_Delete( node_load->staged_jsons[ i ].json );
+    }
+  }
+
+  /* Canceled loads could have prepared assets which weren't added */
+  for ( uint32 i = node_load->added_assets_count; i < CRUDE_ARRAY_LENGTH( node_load->staged_assets ); ++i )
+  {
+    crude_gfx_model_renderer_resources_manager_discard_prepared_gltf( &node_load->staged_assets[ i ].prepared_gltf );
+    crude_physics_shapes_manager_discard_prepared_mesh_shape( &node_load->staged_assets[ i ].prepared_mesh_shape );
+  }
+
+  CRUDE_ARRAY_DEINITIALIZE( node_load->staged_jsons );
+  CRUDE_ARRAY_DEINITIALIZE( node_load->staged_nodes );
+  CRUDE_ARRAY_DEINITIALIZE( node_load->staged_commands );
+  CRUDE_ARRAY_DEINITIALIZE( node_load->staged_assets );
+  CRUDE_ARRAY_DEINITIALIZE( node_load->nodes );
+
+  for ( uint32 i = 1; i < CRUDE_ARRAY_LENGTH( manager->node_loads ); ++i )
+  {
+    manager->node_loads[ i - 1 ] = manager->node_loads[ i ];
+  }
+  CRUDE_ARRAY_SET_LENGTH( manager->node_loads, CRUDE_ARRAY_LENGTH( manager->node_loads ) - 1 );
+
+  CRUDE_DEALLOCATE( crude_heap_allocator_pack( manager->allocator ), node_load );
+}
+
+cJSON*
+crude_node_manager_parse_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *absolute_filepath
+);
+
+static void
+crude_node_manager_save_task_set_fn_
+(
+  _In_ uint32_t                                            start_,
+  _In_ uint32_t                                            end_,
+  _In_ uint32_t                                            threadnum_,
+  _In_ void                                               *ctx
+);
+
+static void
+crude_node_manager_node_save_capture_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_save                       *node_save,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ int32                                               parent_index
+);
+
+static void
+crude_node_manager_node_save_capture_component_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_save                       *node_save,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ ecs_id_t                                            id,
+  _In_opt_ crude_crude_components_serialization_parse_component_value_to_json_func to_json_fn
+);
+
+static uint32
+crude_node_manager_node_save_write_node_
+(
+  _In_ crude_node_manager_node_save                       *node_save,
+  _In_ uint32                                              node_index
+);
+
+static bool
+crude_node_manager_finish_node_save_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ bool                                                wait
+);
+
+static cJSON*
+crude_node_manager_get_node_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *node_realtive_filepath
+);
+
+static crude_node_manager_node_template*
+crude_node_manager_compile_node_template_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *node_realtive_filepath,
+  _In_ crude_ecs                                          *world
+);
+
+static void
+crude_node_manager_node_template_flatten_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_template                   *node_template,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ int32                                               parent_index,
+  _In_ bool                                                live_node
+);
+
+static void
+crude_node_manager_node_template_deinitialize_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_template                   *node_template
+);
+
+static void
+crude_node_manager_node_template_component_copy_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ ecs_id_t                                            id,
+  _Out_ void                                              *dst,
+  _In_ void const                                         *src,
+  _In_ uint32                                              size
+);
+
+static crude_node_manager_node_template*
+crude_node_manager_get_node_template_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *node_realtive_filepath,
+  _In_ crude_ecs                                          *world
+);
+
+static void
+crude_node_manager_node_template_reset_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_template                   *node_template,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+);
+
+static void
+crude_node_manager_reset_model_instance_animations_
+(
+  _Inout_ crude_gfx_model_renderer_resources_instance     *dst_instance,
+  _In_ crude_gfx_model_renderer_resources_instance const  *src_instance
+);
+
+static crude_node_manager_node_pool*
+crude_node_manager_get_node_pool_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *node_realtive_filepath
+);
+
+static void
+crude_node_manager_node_enable_hierarchy_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ bool                                                enable
+);
+
+static void
+crude_node_manager_clear_node_jsons_
+(
+  _In_ crude_node_manager                                 *manager
+);
+
+static void
+crude_node_manager_reload_node_from_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ cJSON                                              *node_json,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+);
+
+static void
+crude_node_manager_reload_components_from_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_opt_ cJSON const                                    *components_json
+);
+
+static int32
+crude_node_manager_get_component_json_index_
+(
+  _In_opt_ cJSON const                                    *components_json,
+  _In_ char const                                         *component_type
+);
+
+static cJSON*
+crude_node_manager_get_child_json_
+(
+  _In_opt_ cJSON const                                    *children_json,
+  _In_opt_ char const                                     *child_name
+);
+
+static bool
+crude_node_manager_is_handle_component_
+(
+  _In_ ecs_id_t                                            id
+);
+
+static bool
+crude_node_manager_is_resource_component_
+(
+  _In_ ecs_id_t                                            id
+);
+
+static void
+crude_node_manager_remove_component_
+(
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ ecs_id_t                                            id
+);
+
+static void
+crude_node_manager_collect_node_assets_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _Inout_ crude_node_manager_node_assets                  *assets
+);
+
+static void
+crude_node_manager_collect_model_asset_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_gfx_model_renderer_resources_handle           handle,
+  _Inout_ crude_node_manager_node_assets                  *assets
+);
+
+static void
+crude_node_manager_collect_mesh_shape_asset_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_physics_mesh_shape_handle                     handle,
+  _Inout_ crude_node_manager_node_assets                  *assets
+);
+
+static bool
+crude_node_manager_is_model_used_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_gfx_model_renderer_resources_handle           handle
+);
+
+static bool
+crude_node_manager_is_mesh_shape_used_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_mesh_shape_handle                     handle
+);
+
+void
+crude_node_manager_initialize
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_creation const                  *creation
+)
+{
+  manager->physics_manager = creation->physics_manager;
+  manager->temporary_allocator = creation->temporary_allocator;
+  manager->components_serialization_manager = creation->components_serialization_manager;
+  manager->resources_absolute_directory = creation->resources_absolute_directory;
+  manager->model_renderer_resources_manager = creation->model_renderer_resources_manager;
+  manager->allocator = creation->allocator;
+  manager->select_camera_func = creation->select_camera_func;
+  manager->select_camera_ctx = creation->select_camera_ctx;
+  manager->audio_device = creation->audio_device;
+  manager->scene_renderer = creation->scene_renderer;
+
+  manager->task_sheduler = creation->task_sheduler;
+
+  manager->compiling_node_template = false;
+  manager->staging_node_load = NULL;
+  manager->commit_budget_seconds = CRUDE_NODE_LOAD_COMMIT_BUDGET_SECONDS_DEFAULT;
+
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( manager->node_loads, 4, crude_heap_allocator_pack( manager->allocator ) );
+  crude_heap_allocator_initialize( &manager->staging_allocator, CRUDE_NODE_LOAD_STAGING_ALLOCATOR_SIZE, "node_manager_staging_allocator" );
+  manager->staging_task_set_handle = crude_task_sheduler_create_task_set( manager->task_sheduler, crude_node_manager_staging_task_set_fn_, manager );
+  manager->node_save = NULL;
+  manager->save_task_set_handle = crude_task_sheduler_create_task_set( manager->task_sheduler, crude_node_manager_save_task_set_fn_, manager );
+
+  CRUDE_HASHMAPSTR_INITIALIZE( manager->relative_filepath_to_node_json, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_HASHMAPSTR_INITIALIZE( manager->relative_filepath_to_node_template, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_HASHMAPSTR_INITIALIZE( manager->relative_filepath_to_node_pool, crude_heap_allocator_pack( manager->allocator ) );
+  crude_string_buffer_initialize( &manager->absolute_filepath_string_buffer, CRUDE_RMEGA( 1 ), crude_heap_allocator_pack( manager->allocator ) );
+}
+
+void
+crude_node_manager_deinitialize
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world
+)
+{
+  crude_node_manager_clear( manager, world );
+  crude_task_sheduler_destroy_task_set( manager->task_sheduler, manager->staging_task_set_handle );
+  crude_task_sheduler_destroy_task_set( manager->task_sheduler, manager->save_task_set_handle );
+  crude_heap_allocator_deinitialize( &manager->staging_allocator );
+  CRUDE_ARRAY_DEINITIALIZE( manager->node_loads );
+  crude_string_buffer_deinitialize( &manager->absolute_filepath_string_buffer );
+  CRUDE_HASHMAPSTR_DEINITIALIZE( manager->relative_filepath_to_node_json );
+  CRUDE_HASHMAPSTR_DEINITIALIZE( manager->relative_filepath_to_node_template );
+  CRUDE_HASHMAPSTR_DEINITIALIZE( manager->relative_filepath_to_node_pool );
+}
+
+void
+crude_node_manager_clear
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world
+)
+{
+  crude_node_manager_finish_node_save_( manager, true );
+
+  crude_physics_begin_bodies_batch( manager->physics_manager );
+
+  /* Pending loads are canceled, nodes committed so far are destroyed */
+  if ( manager->staging_node_load )
+  {
+    crude_task_sheduler_wait_task_set( manager->task_sheduler, manager->staging_task_set_handle );
+    manager->staging_node_load = NULL;
+  }
+
+  while ( CRUDE_ARRAY_LENGTH( manager->node_loads ) )
+  {
+    crude_node_manager_node_load                          *node_load;
+    crude_node_manager_node_loaded                         loaded_func;
+    void                                                  *loaded_ctx;
+
+    node_load = manager->node_loads[ 0 ];
+    if ( node_load->committed_commands_count )
+    {
+      crude_entity_destroy_hierarchy( node_load->world, node_load->nodes[ 0 ] );
+    }
+    loaded_func = node_load->loaded_func;
+    loaded_ctx = node_load->loaded_ctx;
+    crude_node_manager_finish_node_load_( manager, node_load, false );
+    if ( loaded_func )
+    {
+      loaded_func( loaded_ctx, CRUDE_COMPOUNT_EMPTY( crude_entity ) );
+    }
+  }
+
+  for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( manager->relative_filepath_to_node_pool ); ++i )
+  {
+    if ( crude_hashmapstr_backet_key_hash_valid( manager->relative_filepath_to_node_pool[ i ].key.key_hash ) )
+    {
+      crude_node_manager_node_pool                        *node_pool;
+
+      node_pool = manager->relative_filepath_to_node_pool[ i ].value;
+      for ( uint32 k = 0; k < CRUDE_ARRAY_LENGTH( node_pool->free_nodes ); ++k )
+      {
+        if ( crude_entity_valid( world, node_pool->free_nodes[ k ] ) )
+        {
+          crude_entity_destroy_hierarchy( world, node_pool->free_nodes[ k ] );
+        }
+      }
+      CRUDE_ARRAY_DEINITIALIZE( node_pool->free_nodes );
+      CRUDE_DEALLOCATE( crude_heap_allocator_pack( manager->allocator ), node_pool );
+    }
+    manager->relative_filepath_to_node_pool[ i ].key.key_hash = CRUDE_HASHMAPSTR_BACKET_STATE_EMPTY;
+  }
+
+  crude_physics_end_bodies_batch( manager->physics_manager );
+
+  crude_node_manager_clear_node_jsons_( manager );
+  
+  for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( manager->relative_filepath_to_node_template ); ++i )
+  {
+    if ( crude_hashmapstr_backet_key_hash_valid( manager->relative_filepath_to_node_template[ i ].key.key_hash ) )
+    {
+      crude_node_manager_node_template_deinitialize_( manager, manager->relative_filepath_to_node_template[ i ].value );
+    }
+    manager->relative_filepath_to_node_template[ i ].key.key_hash = CRUDE_HASHMAPSTR_BACKET_STATE_EMPTY;
+  }
+}
+
+crude_entity
+crude_node_manager_create_node
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world
+)
+{
+  crude_entity                                             node;
+
+  crude_physics_begin_bodies_batch( manager->physics_manager );
+  node = crude_node_manager_load_node_from_json_( manager, crude_node_manager_get_node_json_( manager, node_realtive_filepath ), world, NULL );
+  crude_physics_end_bodies_batch( manager->physics_manager );
+  crude_physics_optimize_broad_phase( manager->physics_manager );
+  return node;
+}
+
+void
+crude_node_manager_load_node_async
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_opt_ crude_entity const                             *parent,
+  _In_opt_ crude_node_manager_node_loaded                  loaded_func,
+  _In_opt_ void                                           *loaded_ctx
+)
+{
+  crude_node_manager_node_load                            *node_load;
+
+  node_load = CRUDE_CAST( crude_node_manager_node_load*, CRUDE_ALLOCATE( crude_heap_allocator_pack( manager->allocator ), sizeof( crude_node_manager_node_load ) ) );
+  *node_load = CRUDE_COMPOUNT_EMPTY( crude_node_manager_node_load );
+  crude_string_copy( node_load->relative_filepath, node_realtive_filepath, sizeof( node_load->relative_filepath ) );
+  node_load->world = world;
+  node_load->parent = parent ? *parent : CRUDE_COMPOUNT_EMPTY( crude_entity );
+  node_load->loaded_func = loaded_func;
+  node_load->loaded_ctx = loaded_ctx;
+  node_load->state = CRUDE_NODE_MANAGER_NODE_LOAD_STATE_QUEUED;
+
+  CRUDE_ARRAY_PUSH( manager->node_loads, node_load );
+}
+
+void
+crude_node_manager_reload_node
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+)
+{
+  cJSON                                                   *node_json;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_reload_node" );
+
+  /* External node files could be changed too, so every cached json is parsed again */
+  crude_node_manager_clear_node_jsons_( manager );
+
+  node_json = crude_node_manager_get_node_json_( manager, node_realtive_filepath );
+  if ( node_json )
+  {
+    crude_node_manager_reload_node_from_json_( manager, node_json, world, node );
+  }
+  
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_node_manager_update
+(
+  _In_ crude_node_manager                                 *manager
+)
+{
+  int64                                                    commit_start_time;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_update" );
+
+  commit_start_time = crude_time_now( );
+
+  crude_node_manager_finish_node_save_( manager, false );
+
+  while ( CRUDE_ARRAY_LENGTH( manager->node_loads ) )
+  {
+    crude_node_manager_node_load                          *node_load;
+    crude_entity                                           node;
+    crude_node_manager_node_loaded                         loaded_func;
+    void                                                  *loaded_ctx;
+
+    node_load = manager->node_loads[ 0 ];
+
+    if ( node_load->state == CRUDE_NODE_MANAGER_NODE_LOAD_STATE_QUEUED )
+    {
+      /* Staging could read a file which is being saved */
+      if ( manager->node_save )
+      {
+        break;
+      }
+
+      node_load->state = CRUDE_NODE_MANAGER_NODE_LOAD_STATE_STAGING;
+      manager->staging_node_load = node_load;
+      crude_task_sheduler_start_task_set( manager->task_sheduler, manager->staging_task_set_handle );
+      break;
+    }
+
+    if ( node_load->state == CRUDE_NODE_MANAGER_NODE_LOAD_STATE_STAGING )
+    {
+      if ( !crude_task_sheduler_is_task_set_complete( manager->task_sheduler, manager->staging_task_set_handle ) )
+      {
+        break;
+      }
+
+      manager->staging_node_load = NULL;
+      node_load->state = CRUDE_NODE_MANAGER_NODE_LOAD_STATE_COMMITTING;
+
+      if ( node_load->staging_failed )
+      {
+        CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot stage node \"%s\"", node_load->relative_filepath );
+        loaded_func = node_load->loaded_func;
+        loaded_ctx = node_load->loaded_ctx;
+        crude_node_manager_finish_node_load_( manager, node_load, false );
+        if ( loaded_func )
+        {
+          loaded_func( loaded_ctx, CRUDE_COMPOUNT_EMPTY( crude_entity ) );
+        }
+        continue;
+      }
+
+      /* Only the main thread reads managers, so loaded assets are skipped here */
+      for ( uint32 i = CRUDE_ARRAY_LENGTH( node_load->staged_assets ); i > 0; --i )
+      {
+        crude_node_manager_staged_asset const             *staged_asset;
+        bool                                               loaded;
+
+        staged_asset = &node_load->staged_assets[ i - 1 ];
+        if ( staged_asset->type == CRUDE_NODE_MANAGER_STAGED_ASSET_TYPE_GLTF )
+        {
+          loaded = crude_gfx_model_renderer_resources_manager_has_gltf_model( manager->model_renderer_resources_manager, staged_asset->relative_filepath );
+        }
+        else
+        {
+          loaded = crude_physics_shapes_manager_has_mesh_shape( manager->physics_manager->physics_shapes_manager, staged_asset->relative_filepath );
+        }
+
+        if ( loaded )
+        {
+          CRUDE_ARRAY_DELSWAP( node_load->staged_assets, i - 1 );
+        }
+      }
+
+      if ( CRUDE_ARRAY_LENGTH( node_load->staged_assets ) )
+      {
+        node_load->state = CRUDE_NODE_MANAGER_NODE_LOAD_STATE_PREPARING;
+        manager->staging_node_load = node_load;
+        crude_task_sheduler_start_task_set( manager->task_sheduler, manager->staging_task_set_handle );
+        break;
+      }
+    }
+
+    if ( node_load->state == CRUDE_NODE_MANAGER_NODE_LOAD_STATE_PREPARING )
+    {
+      if ( !crude_task_sheduler_is_task_set_complete( manager->task_sheduler, manager->staging_task_set_handle ) )
+      {
+        break;
+      }
+
+      manager->staging_node_load = NULL;
+      node_load->state = CRUDE_NODE_MANAGER_NODE_LOAD_STATE_COMMITTING;
+    }
+
+    /* GPU resources of prepared assets are created one by one, so a big load is spread over frames */
+    while ( node_load->added_assets_count < CRUDE_ARRAY_LENGTH( node_load->staged_assets ) )
+    {
+      crude_node_manager_add_staged_asset_( manager, &node_load->staged_assets[ node_load->added_assets_count++ ] );
+
+      if ( crude_time_delta_seconds( commit_start_time, crude_time_now( ) ) > manager->commit_budget_seconds )
+      {
+        goto cleanup;
+      }
+    }
+    
+    /* Bodies created by committed components are added to the broad phase together */
+    crude_physics_begin_bodies_batch( manager->physics_manager );
+    while ( node_load->committed_commands_count < CRUDE_ARRAY_LENGTH( node_load->staged_commands ) )
+    {
+      crude_node_manager_commit_staged_command_( manager, node_load, &node_load->staged_commands[ node_load->committed_commands_count++ ] );
+
+      if ( crude_time_delta_seconds( commit_start_time, crude_time_now( ) ) > manager->commit_budget_seconds )
+      {
+        crude_physics_end_bodies_batch( manager->physics_manager );
+        goto cleanup;
+      }
+    }
+    crude_physics_end_bodies_batch( manager->physics_manager );
+
+    /* Bodies committed over several frames are counted together */
+    crude_physics_optimize_broad_phase( manager->physics_manager );
+
+    node = node_load->nodes[ 0 ];
+    loaded_func = node_load->loaded_func;
+    loaded_ctx = node_load->loaded_ctx;
+    crude_node_manager_finish_node_load_( manager, node_load, true );
+    
+    /* Called after the load is removed, so callback can queue new loads or clear the manager */
+    if ( loaded_func )
+    {
+      loaded_func( loaded_ctx, node );
+    }
+  }
+
+cleanup:
+  CRUDE_PROFILER_ZONE_END;
+}
+
+bool
+crude_node_manager_is_loading
+(
+  _In_ crude_node_manager                                 *manager
+)
+{
+  return CRUDE_ARRAY_LENGTH( manager->node_loads ) > 0;
+}
+
+void
+crude_node_manager_instantiate_nodes
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_opt_ crude_entity const                             *parent,
+  _In_ uint32                                              count,
+  _Out_ crude_entity                                      *nodes
+)
+{
+  crude_node_manager_node_template                        *node_template;
+  crude_entity                                            *template_nodes_entities;
+  uint32                                                   template_nodes_count;
+  uint32                                                   temporary_allocator_marker;
+
+  if ( count == 0 )
+  {
+    return;
+  }
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_instantiate_nodes" );
+  crude_physics_begin_bodies_batch( manager->physics_manager );
+
+  node_template = crude_node_manager_get_node_template_( manager, node_realtive_filepath, world );
+
+  temporary_allocator_marker = crude_stack_allocator_get_marker( manager->temporary_allocator );
+
+  template_nodes_count = CRUDE_ARRAY_LENGTH( node_template->nodes );
+  template_nodes_entities = CRUDE_CAST( crude_entity*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), sizeof( crude_entity ) * template_nodes_count * count ) );
+
+  /* All copies of a template node land in the same table with all of its components in a single archetype move */
+  for ( uint32 template_node_index = 0; template_node_index < template_nodes_count; ++template_node_index )
+  {
+    crude_node_manager_node_template_node const           *template_node;
+    crude_entity const                                    *copies;
+    ecs_bulk_desc_t                                        bulk_desc;
+    uint32                                                 ids_count;
+    
+    template_node = &node_template->nodes[ template_node_index ];
+
+    bulk_desc = CRUDE_COMPOUNT_EMPTY( ecs_bulk_desc_t );
+    bulk_desc.count = count;
+
+    ids_count = 0u;
+    if ( template_node_index == 0 && parent )
+    {
+      bulk_desc.ids[ ids_count++ ] = ecs_pair( EcsChildOf, *parent );
+    }
+
+    CRUDE_ASSERT( ids_count + template_node->components_count < FLECS_ID_DESC_MAX );
+    for ( uint32 i = 0; i < template_node->components_count; ++i )
+    {
+      bulk_desc.ids[ ids_count++ ] = node_template->components[ template_node->first_component_index + i ].id;
+    }
+
+    /* No data here, create observers look up named children and parent transforms, so values are set once the hierarchy is fixed up */
+    copies = ecs_bulk_init( world, &bulk_desc );
+    crude_memory_copy( template_nodes_entities + template_node_index * count, copies, sizeof( crude_entity ) * count );
+  }
+
+  /* Nodes are in pre-order, so ChildOf pairs are fixed up layer by layer, parents before children. Children keep their names, gameplay code looks them up by name */
+  for ( uint32 template_node_index = 1; template_node_index < template_nodes_count; ++template_node_index )
+  {
+    crude_node_manager_node_template_node const           *template_node;
+    
+    template_node = &node_template->nodes[ template_node_index ];
+
+    for ( uint32 instance_index = 0; instance_index < count; ++instance_index )
+    {
+      ecs_entity_desc_t                                    entity_desc;
+
+      entity_desc = CRUDE_COMPOUNT_EMPTY( ecs_entity_desc_t );
+      entity_desc.id = template_nodes_entities[ template_node_index * count + instance_index ];
+      entity_desc.parent = template_nodes_entities[ template_node->parent_index * count + instance_index ];
+      entity_desc.name = template_node->name[ 0 ] ? template_node->name : "entity";
+      entity_desc.sep = "";
+      ecs_entity_init( world, &entity_desc );
+    }
+  }
+
+  /* Components are already in place, values are written without moving the entities and OnSet is emitted once the whole entity is filled */
+  for ( uint32 commit_index = 0; commit_index < template_nodes_count; ++commit_index )
+  {
+    crude_node_manager_node_template_node const           *template_node;
+    uint32                                                 template_node_index;
+    
+    template_node_index = node_template->commit_order[ commit_index ];
+    template_node = &node_template->nodes[ template_node_index ];
+
+    for ( uint32 instance_index = 0; instance_index < count; ++instance_index )
+    {
+      crude_entity                                         node;
+
+      node = template_nodes_entities[ template_node_index * count + instance_index ];
+
+      for ( uint32 i = 0; i < template_node->components_count; ++i )
+      {
+        crude_node_manager_node_template_component const  *component;
+        void                                              *value;
+        
+        component = &node_template->components[ template_node->first_component_index + i ];
+        if ( !component->size )
+        {
+          continue;
+        }
+
+        value = crude_entity_get_mutable_component( world, node, component->id );
+        if ( component->type_info->hooks.copy )
+        {
+          component->type_info->hooks.copy( value, node_template->values + component->offset, 1, component->type_info );
+        }
+        else
+        {
+          crude_node_manager_node_template_component_copy_( manager, component->id, value, node_template->values + component->offset, component->size );
+        }
+      }
+
+      for ( uint32 i = 0; i < template_node->components_count; ++i )
+      {
+        crude_node_manager_node_template_component const  *component;
+        
+        component = &node_template->components[ template_node->first_component_index + i ];
+        if ( component->size )
+        {
+          crude_entity_modified_component( world, node, component->id );
+        }
+      }
+    }
+  }
+
+  crude_memory_copy( nodes, template_nodes_entities, sizeof( crude_entity ) * count );
+
+  crude_stack_allocator_free_marker( manager->temporary_allocator, temporary_allocator_marker );
+  crude_physics_end_bodies_batch( manager->physics_manager );
+  crude_physics_optimize_broad_phase( manager->physics_manager );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_node_manager_configure_node_pool
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_opt_ crude_entity const                             *parent,
+  _In_ uint32                                              warm_up_count,
+  _In_ uint32                                              free_nodes_max_count
+)
+{
+  crude_node_manager_node_pool                            *node_pool;
+  crude_entity                                            *warm_up_nodes;
+  uint32                                                   warm_up_nodes_count;
+  uint32                                                   temporary_allocator_marker;
+
+  node_pool = crude_node_manager_get_node_pool_( manager, node_realtive_filepath );
+  node_pool->free_nodes_max_count = free_nodes_max_count;
+
+  if ( warm_up_count <= CRUDE_ARRAY_LENGTH( node_pool->free_nodes ) )
+  {
+    return;
+  }
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_configure_node_pool" );
+
+  temporary_allocator_marker = crude_stack_allocator_get_marker( manager->temporary_allocator );
+  
+  warm_up_nodes_count = warm_up_count - CRUDE_ARRAY_LENGTH( node_pool->free_nodes );
+  warm_up_nodes = CRUDE_CAST( crude_entity*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), sizeof( crude_entity ) * warm_up_nodes_count ) );
+  
+  crude_node_manager_instantiate_nodes( manager, node_realtive_filepath, world, parent, warm_up_nodes_count, warm_up_nodes );
+  for ( uint32 i = 0; i < warm_up_nodes_count; ++i )
+  {
+    crude_node_manager_node_enable_hierarchy_( manager, world, warm_up_nodes[ i ], false );
+    CRUDE_ARRAY_PUSH( node_pool->free_nodes, warm_up_nodes[ i ] );
+  }
+
+  crude_stack_allocator_free_marker( manager->temporary_allocator, temporary_allocator_marker );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+crude_entity
+crude_node_manager_acquire_node
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_opt_ crude_entity const                             *parent
+)
+{
+  crude_node_manager_node_pool                            *node_pool;
+  crude_entity                                             node;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_acquire_node" );
+
+  node_pool = crude_node_manager_get_node_pool_( manager, node_realtive_filepath );
+
+  while ( CRUDE_ARRAY_LENGTH( node_pool->free_nodes ) )
+  {
+    node = CRUDE_ARRAY_POP( node_pool->free_nodes );
+
+    /* Parent could be destroyed together with the free node */
+    if ( !crude_entity_valid( world, node ) )
+    {
+      continue;
+    }
+
+    if ( parent )
+    {
+      crude_entity_set_parent( world, node, *parent );
+    }
+
+    crude_node_manager_node_enable_hierarchy_( manager, world, node, true );
+    crude_node_manager_node_template_reset_( manager, crude_node_manager_get_node_template_( manager, node_realtive_filepath, world ), world, node );
+    goto cleanup;
+  }
+
+  crude_node_manager_instantiate_nodes( manager, node_realtive_filepath, world, parent, 1, &node );
+
+cleanup:
+  CRUDE_PROFILER_ZONE_END;
+  return node;
+}
+
+void
+crude_node_manager_release_node
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+)
+{
+  crude_node_manager_node_pool                            *node_pool;
+
+  node_pool = crude_node_manager_get_node_pool_( manager, node_realtive_filepath );
+
+  /* Free nodes destroyed with their parent are dropped before the limit is checked */
+  if ( CRUDE_ARRAY_LENGTH( node_pool->free_nodes ) >= node_pool->free_nodes_max_count )
+  {
+    for ( uint32 i = CRUDE_ARRAY_LENGTH( node_pool->free_nodes ); i > 0; --i )
+    {
+      if ( !crude_entity_valid( world, node_pool->free_nodes[ i - 1 ] ) )
+      {
+        CRUDE_ARRAY_DELSWAP( node_pool->free_nodes, i - 1 );
+      }
+    }
+  }
+
+  if ( CRUDE_ARRAY_LENGTH( node_pool->free_nodes ) >= node_pool->free_nodes_max_count )
+  {
+    crude_entity_destroy_hierarchy( world, node );
+    return;
+  }
+
+  crude_node_manager_node_enable_hierarchy_( manager, world, node, false );
+  CRUDE_ARRAY_PUSH( node_pool->free_nodes, node );
+}
+
+void
+crude_node_manager_enable_node
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ bool                                                enable
+)
+{
+  crude_node_manager_node_enable_hierarchy_( manager, world, node, enable );
+}
+
+crude_node_manager_snapshot*
+crude_node_manager_take_snapshot
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+)
+{
+  crude_node_manager_snapshot                             *snapshot;
+  crude_node_manager_node_template                        *node_template;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_take_snapshot" );
+
+  node_template = CRUDE_CAST( crude_node_manager_node_template*, CRUDE_ALLOCATE( crude_heap_allocator_pack( manager->allocator ), sizeof( crude_node_manager_node_template ) ) );
+  *node_template = CRUDE_COMPOUNT_EMPTY( crude_node_manager_node_template );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_template->nodes, 64, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_template->commit_order, 64, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_template->components, 256, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_template->values, 16384, crude_heap_allocator_pack( manager->allocator ) );
+
+  crude_node_manager_node_template_flatten_( manager, node_template, world, node, -1, true );
+
+  snapshot = CRUDE_CAST( crude_node_manager_snapshot*, CRUDE_ALLOCATE( crude_heap_allocator_pack( manager->allocator ), sizeof( crude_node_manager_snapshot ) ) );
+  snapshot->world = world;
+  snapshot->nodes_template = node_template;
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( snapshot->characters, 4, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( snapshot->sounds, 16, crude_heap_allocator_pack( manager->allocator ) );
+
+  /* Handles are not captured, state behind them is stored by node index */
+  for ( uint32 node_index = 0; node_index < CRUDE_ARRAY_LENGTH( node_template->nodes ); ++node_index )
+  {
+    crude_entity                                           snapshot_node;
+
+    snapshot_node = node_template->nodes[ node_index ].entity;
+
+    if ( CRUDE_ENTITY_HAS_COMPONENT( world, snapshot_node, crude_physics_character_handle ) )
+    {
+      crude_physics_character_container                   *character_container;
+      crude_node_manager_snapshot_character                snapshot_character;
+
+      character_container = crude_physics_access_character( manager->physics_manager, *CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, snapshot_node, crude_physics_character_handle ) );
+
+      snapshot_character.node_index = node_index;
+      XMStoreFloat3( &snapshot_character.linear_velocity, crude_physics_character_get_linear_velocity( character_container ) );
+      CRUDE_ARRAY_PUSH( snapshot->characters, snapshot_character );
+    }
+
+    if ( CRUDE_ENTITY_HAS_COMPONENT( world, snapshot_node, crude_audio_player_handle ) )
+    {
+      crude_node_manager_snapshot_sound                    snapshot_sound;
+      crude_sound_handle                                   sound_handle;
+
+      sound_handle = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, snapshot_node, crude_audio_player_handle )->sound_handle;
+      if ( sound_handle.index != CRUDE_SOUND_HANDLE_INVALID.index )
+      {
+        snapshot_sound.node_index = node_index;
+        snapshot_sound.playing = crude_audio_device_sound_is_playing( manager->audio_device, sound_handle );
+        CRUDE_ARRAY_PUSH( snapshot->sounds, snapshot_sound );
+      }
+    }
+  }
+
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_CORE, "Snapshot taken: %i nodes, %i components, %i bytes", CRUDE_ARRAY_LENGTH( node_template->nodes ), CRUDE_ARRAY_LENGTH( node_template->components ), CRUDE_ARRAY_LENGTH( node_template->values ) );
+  CRUDE_PROFILER_ZONE_END;
+  return snapshot;
+}
+
+void
+crude_node_manager_restore_snapshot
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_snapshot                        *snapshot
+)
+{
+  crude_node_manager_node_template                        *node_template;
+  crude_ecs                                               *world;
+  crude_entity                                            *snapshot_nodes_entities;
+  bool                                                    *snapshot_nodes_revived;
+  ecs_value_t                                             *components_values;
+  uint8                                                   *instance_values;
+  CRUDE_HASHMAP( uint32 )                                 *entity_to_snapshot_node_index;
+  crude_entity                                            *stale_nodes;
+  ecs_id_t                                                *stale_components_ids;
+  uint32                                                   snapshot_nodes_count;
+  uint32                                                   temporary_allocator_marker;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_restore_snapshot" );
+
+  world = snapshot->world;
+  node_template = snapshot->nodes_template;
+  snapshot_nodes_count = CRUDE_ARRAY_LENGTH( node_template->nodes );
+
+  temporary_allocator_marker = crude_stack_allocator_get_marker( manager->temporary_allocator );
+
+  snapshot_nodes_entities = CRUDE_CAST( crude_entity*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), sizeof( crude_entity ) * snapshot_nodes_count ) );
+  snapshot_nodes_revived = CRUDE_CAST( bool*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), sizeof( bool ) * snapshot_nodes_count ) );
+  components_values = CRUDE_CAST( ecs_value_t*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), sizeof( ecs_value_t ) * ( CRUDE_ARRAY_LENGTH( node_template->components ) + 1 ) ) );
+  instance_values = CRUDE_CAST( uint8*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), CRUDE_ARRAY_LENGTH( node_template->values ) + 16 ) );
+  instance_values = CRUDE_REINTERPRET_CAST( uint8*, crude_memory_align( CRUDE_REINTERPRET_CAST( sizet, instance_values ), 16 ) );
+
+  CRUDE_HASHMAP_INITIALIZE( entity_to_snapshot_node_index, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( stale_nodes, 16, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( stale_components_ids, 16, crude_heap_allocator_pack( manager->allocator ) );
+
+  for ( uint32 node_index = 0; node_index < snapshot_nodes_count; ++node_index )
+  {
+    CRUDE_HASHMAP_SET( entity_to_snapshot_node_index, node_template->nodes[ node_index ].entity, node_index );
+  }
+
+  /* Entities created after the snapshot are destroyed first, so revived ones don't clash with their names */
+  for ( uint32 node_index = 0; node_index < snapshot_nodes_count; ++node_index )
+  {
+    crude_entity                                           snapshot_node;
+    crude_entity                                           streamed_node;
+    ecs_iter_t                                             it;
+
+    snapshot_node = node_template->nodes[ node_index ].entity;
+    if ( !crude_entity_valid( world, snapshot_node ) )
+    {
+      continue;
+    }
+
+    streamed_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+    if ( CRUDE_ENTITY_HAS_COMPONENT( world, snapshot_node, crude_world_partition_cell ) )
+    {
+      streamed_node = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, snapshot_node, crude_world_partition_cell )->streamed_node;
+    }
+
+    it = crude_ecs_children( world, snapshot_node );
+    while ( ecs_children_next( &it ) )
+    {
+      for ( size_t i = 0; i < it.count; ++i )
+      {
+        crude_entity                                       child;
+
+        child = crude_entity_from_iterator( &it, i );
+        if ( child != streamed_node && CRUDE_HASHMAP_GET_INDEX( entity_to_snapshot_node_index, child ) == -1 )
+        {
+          CRUDE_ARRAY_PUSH( stale_nodes, child );
+        }
+      }
+    }
+  }
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( stale_nodes ); ++i )
+  {
+    crude_entity_destroy_hierarchy( world, stale_nodes[ i ] );
+  }
+
+  /* Destroyed entities are revived in pre-order, parents first */
+  for ( uint32 node_index = 0; node_index < snapshot_nodes_count; ++node_index )
+  {
+    crude_node_manager_node_template_node const           *snapshot_node;
+    crude_entity                                           parent_node;
+    crude_entity                                           node;
+
+    snapshot_node = &node_template->nodes[ node_index ];
+    parent_node = snapshot_node->parent_index == -1 ? CRUDE_COMPOUNT_EMPTY( crude_entity ) : snapshot_nodes_entities[ snapshot_node->parent_index ];
+    node = snapshot_node->entity;
+    snapshot_nodes_revived[ node_index ] = false;
+
+    if ( !crude_entity_valid( world, node ) )
+    {
+      ecs_entity_desc_t                                    entity_desc;
+
+      /* Index could be recycled by another entity, references to this one can't be kept then */
+      if ( ecs_get_alive( world, CRUDE_CAST( uint32, node ) ) )
+      {
+        CRUDE_LOG_WARNING( CRUDE_CHANNEL_CORE, "Snapshot node \"%s\" id is reused, node is restored with a new id", snapshot_node->name );
+        node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+      }
+
+      entity_desc = CRUDE_COMPOUNT_EMPTY( ecs_entity_desc_t );
+      entity_desc.id = node;
+      entity_desc.parent = parent_node;
+      entity_desc.name = snapshot_node->name[ 0 ] ? snapshot_node->name : NULL;
+      entity_desc.sep = "";
+      node = ecs_entity_init( world, &entity_desc );
+      snapshot_nodes_revived[ node_index ] = true;
+    }
+    else if ( parent_node && crude_entity_get_parent( world, node ) != parent_node )
+    {
+      crude_entity_set_parent( world, node, parent_node );
+    }
+
+    snapshot_nodes_entities[ node_index ] = node;
+  }
+
+  for ( uint32 commit_index = 0; commit_index < snapshot_nodes_count; ++commit_index )
+  {
+    crude_node_manager_node_template_node const           *snapshot_node;
+    crude_entity                                           node;
+    ecs_type_t const                                      *node_type;
+    uint32                                                 node_index;
+    
+    node_index = node_template->commit_order[ commit_index ];
+    snapshot_node = &node_template->nodes[ node_index ];
+    node = snapshot_nodes_entities[ node_index ];
+
+    if ( snapshot_nodes_revived[ node_index ] )
+    {
+      ecs_entity_desc_t                                    entity_desc;
+
+      for ( uint32 i = 0; i < snapshot_node->components_count; ++i )
+      {
+        crude_node_manager_node_template_component const  *component;
+        
+        component = &node_template->components[ snapshot_node->first_component_index + i ];
+
+        components_values[ i ].type = component->id;
+        components_values[ i ].ptr = NULL;
+
+        if ( component->size )
+        {
+          crude_node_manager_node_template_component_copy_( manager, component->id, instance_values + component->offset, node_template->values + component->offset, component->size );
+          components_values[ i ].ptr = instance_values + component->offset;
+        }
+      }
+      components_values[ snapshot_node->components_count ] = CRUDE_COMPOUNT_EMPTY( ecs_value_t );
+
+      entity_desc = CRUDE_COMPOUNT_EMPTY( ecs_entity_desc_t );
+      entity_desc.id = node;
+      entity_desc.set = components_values;
+      ecs_entity_init( world, &entity_desc );
+      continue;
+    }
+
+    /* Components added after the snapshot */
+    CRUDE_ARRAY_SET_LENGTH( stale_components_ids, 0u );
+    node_type = ecs_get_type( world, node );
+    for ( uint32 i = 0; i < node_type->count; ++i )
+    {
+      ecs_id_t                                             id;
+      bool                                                 captured;
+
+      id = node_type->array[ i ];
+      if ( ECS_IS_PAIR( id ) || crude_node_manager_is_handle_component_( id ) )
+      {
+        continue;
+      }
+
+      captured = false;
+      for ( uint32 k = 0; k < snapshot_node->components_count; ++k )
+      {
+        if ( node_template->components[ snapshot_node->first_component_index + k ].id == id )
+        {
+          captured = true;
+          break;
+        }
+      }
+
+      if ( !captured )
+      {
+        CRUDE_ARRAY_PUSH( stale_components_ids, id );
+      }
+    }
+
+    for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( stale_components_ids ); ++i )
+    {
+      crude_node_manager_remove_component_( world, node, stale_components_ids[ i ] );
+    }
+    
+    /* Only diverged components are set, unchanged bodies and sounds are not recreated by create observers */
+    for ( uint32 i = 0; i < snapshot_node->components_count; ++i )
+    {
+      crude_node_manager_node_template_component const    *component;
+      void const                                          *snapshot_value;
+      
+      component = &node_template->components[ snapshot_node->first_component_index + i ];
+      snapshot_value = node_template->values + component->offset;
+
+      if ( !crude_entity_has_id( world, node, component->id ) )
+      {
+        if ( component->size )
+        {
+          crude_node_manager_node_template_component_copy_( manager, component->id, instance_values + component->offset, snapshot_value, component->size );
+          crude_entity_set_component( world, node, component->id, component->size, instance_values + component->offset );
+        }
+        else
+        {
+          crude_entity_add_id( world, node, component->id );
+        }
+        continue;
+      }
+
+      if ( !component->size )
+      {
+        continue;
+      }
+
+      if ( component->id == ecs_id( crude_gltf ) )
+      {
+        crude_gltf                                        *gltf;
+        
+        gltf = CRUDE_ENTITY_GET_MUTABLE_COMPONENT( world, node, crude_gltf );
+        crude_node_manager_reset_model_instance_animations_( &gltf->model_renderer_resources_instance, &CRUDE_CAST( crude_gltf const*, snapshot_value )->model_renderer_resources_instance );
+        gltf->model_renderer_resources_instance.model_to_world = CRUDE_CAST( crude_gltf const*, snapshot_value )->model_renderer_resources_instance.model_to_world;
+        gltf->hidden = CRUDE_CAST( crude_gltf const*, snapshot_value )->hidden;
+        continue;
+      }
+
+      /* Streamed cell content is owned by the world partition */
+      if ( component->id == ecs_id( crude_world_partition_cell ) )
+      {
+        crude_memory_copy( instance_values + component->offset, snapshot_value, component->size );
+        CRUDE_REINTERPRET_CAST( crude_world_partition_cell*, instance_values + component->offset )->streamed_node = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_world_partition_cell )->streamed_node;
+        snapshot_value = instance_values + component->offset;
+      }
+
+      if ( memcmp( crude_entity_get_immutable_component( world, node, component->id ), snapshot_value, component->size ) != 0 )
+      {
+        crude_entity_set_component( world, node, component->id, component->size, snapshot_value );
+      }
+    }
+  }
+
+  /* Bodies follow restored transforms, same as after load */
+  crude_physics_run_system_on_start( world );
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( snapshot->characters ); ++i )
+  {
+    crude_entity                                           node;
+
+    node = snapshot_nodes_entities[ snapshot->characters[ i ].node_index ];
+    if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_physics_character_handle ) )
+    {
+      crude_physics_character_set_linear_velocity( crude_physics_access_character( manager->physics_manager, *CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_physics_character_handle ) ), XMLoadFloat3( &snapshot->characters[ i ].linear_velocity ) );
+    }
+  }
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( snapshot->sounds ); ++i )
+  {
+    crude_entity                                           node;
+    crude_sound_handle                                     sound_handle;
+
+    node = snapshot_nodes_entities[ snapshot->sounds[ i ].node_index ];
+    if ( !CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_audio_player_handle ) )
+    {
+      continue;
+    }
+
+    sound_handle = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_audio_player_handle )->sound_handle;
+    if ( sound_handle.index == CRUDE_SOUND_HANDLE_INVALID.index )
+    {
+      continue;
+    }
+
+    crude_audio_device_sound_stop( manager->audio_device, sound_handle );
+    crude_audio_device_sound_reset( manager->audio_device, sound_handle );
+    if ( snapshot->sounds[ i ].playing )
+    {
+      crude_audio_device_sound_start( manager->audio_device, sound_handle );
+    }
+  }
+
+  CRUDE_ARRAY_DEINITIALIZE( stale_components_ids );
+  CRUDE_ARRAY_DEINITIALIZE( stale_nodes );
+  CRUDE_HASHMAP_DEINITIALIZE( entity_to_snapshot_node_index );
+  crude_stack_allocator_free_marker( manager->temporary_allocator, temporary_allocator_marker );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_node_manager_destroy_snapshot
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_snapshot                        *snapshot
+)
+{
+  crude_node_manager_node_template_deinitialize_( manager, snapshot->nodes_template );
+  CRUDE_ARRAY_DEINITIALIZE( snapshot->characters );
+  CRUDE_ARRAY_DEINITIALIZE( snapshot->sounds );
+  CRUDE_DEALLOCATE( crude_heap_allocator_pack( manager->allocator ), snapshot );
+}
+
+void
+crude_node_manager_save_node_to_file
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ char const                                          saved_relative_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ]
+)
+{
+  crude_node_manager_node_save                            *node_save;
+  char const                                              *saved_absolute_filepath;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_save_node_to_file" );
+
+  /* Only one save is in flight, the next one waits for it */
+  crude_node_manager_finish_node_save_( manager, true );
+
+  crude_string_buffer_clear( &manager->absolute_filepath_string_buffer );
+  saved_absolute_filepath = crude_string_buffer_append_use_f( &manager->absolute_filepath_string_buffer, "%s%s", manager->resources_absolute_directory, saved_relative_filepath );
+  CRUDE_ASSERT( crude_string_length( saved_absolute_filepath ) < CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX );
+
+  node_save = CRUDE_CAST( crude_node_manager_node_save*, CRUDE_ALLOCATE( crude_heap_allocator_pack( manager->allocator ), sizeof( crude_node_manager_node_save ) ) );
+  crude_string_copy( node_save->absolute_filepath, saved_absolute_filepath, sizeof( node_save->absolute_filepath ) );
+  node_save->failed = false;
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_save->nodes, 64, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_save->components, 256, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_save->components_to_json_funs, 256, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_save->components_json, 256, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_save->values, CRUDE_RKILO( 64 ), crude_heap_allocator_pack( manager->allocator ) );
+
+  crude_node_manager_node_save_capture_( manager, node_save, world, node, -1 );
+
+  manager->node_save = node_save;
+  crude_task_sheduler_start_task_set( manager->task_sheduler, manager->save_task_set_handle );
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_node_manager_collect_node_assets
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ crude_stack_allocator                              *allocator,
+  _Out_ crude_node_manager_node_assets                    *assets
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_collect_node_assets" );
+
+  assets->size = 0u;
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( assets->models, 16, crude_stack_allocator_pack( allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( assets->mesh_shapes, 16, crude_stack_allocator_pack( allocator ) );
+
+  crude_node_manager_collect_node_assets_( manager, world, node, assets );
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_node_manager_release_unused_node_assets
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_node_manager_node_assets const               *assets
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_release_unused_node_assets" );
+
+  /* Shapes go first, they could hold debug models */
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( assets->mesh_shapes ); ++i )
+  {
+    if ( !crude_node_manager_is_mesh_shape_used_( manager, world, assets->mesh_shapes[ i ] ) )
+    {
+      crude_physics_shapes_manager_release_mesh_shape( manager->physics_manager->physics_shapes_manager, assets->mesh_shapes[ i ] );
+    }
+  }
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( assets->models ); ++i )
+  {
+    if ( !crude_node_manager_is_model_used_( manager, world, assets->models[ i ] ) )
+    {
+      crude_gfx_model_renderer_resources_manager_release_gltf_model( manager->model_renderer_resources_manager, assets->models[ i ] );
+    }
+  }
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+crude_entity
+crude_node_manager_load_node_from_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ cJSON                                              *node_json,
+  _In_ crude_ecs                                          *world,
+  _In_opt_ crude_entity                                   *parent
+)
+{
+  crude_entity                                             node;
+  char const                                              *node_name;
+  bool                                                     is_node_external;
+  bool                                                     copy_components;
+  
+  node_name = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( node_json, "name") );
+
+  copy_components = true;
+
+  is_node_external = cJSON_HasObjectItem( node_json, "external" );
+  if ( is_node_external )
+  {
+    cJSON                                                 *node_external_json;
+    char const                                            *node_external_relative_filepath;
+    crude_node_external                                    node_external_component;
+
+    CRUDE_ASSERT( parent ); /* WTF IS GOING ONE, DONT PUT EXTERNAL ON TOP OF SCENE */
+
+    node_external_json = cJSON_GetObjectItemCaseSensitive( node_json, "external");
+    node_external_relative_filepath = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( node_external_json, "relative_filepath" ) );
+    
+    node_external_component = crude_node_external_empty( );
+    node_external_component.type = CRUDE_CAST( crude_node_external_type, cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( node_external_json, "type") ) );
+    crude_string_copy( node_external_component.node_relative_filepath, node_external_relative_filepath, sizeof( node_external_component.node_relative_filepath ) );
+    node = crude_node_manager_create_node( manager, node_external_relative_filepath, world );
+    crude_entity_set_name( world, node, node_name );
+    crude_entity_set_parent( world, node, *parent );
+
+    if ( node_external_component.type == CRUDE_NODE_EXTERNAL_TYPE_REFERENCE )
+    {
+      copy_components = false;
+    }
+    
+    CRUDE_ENTITY_SET_COMPONENT( world, node, crude_node_external, { node_external_component } );
+  }
+  else
+  {
+    node = crude_entity_create_empty( world, node_name );
+
+    /* Observers don't match prefabs, so template nodes don't create physics bodies, sounds, etc. */
+    if ( manager->compiling_node_template )
+    {
+      crude_entity_add_id( world, node, EcsPrefab );
+    }
+    
+    if ( parent )
+    {
+      crude_entity_set_parent( world, node, *parent );
+    }
+  }
+  
+  if ( !is_node_external )
+  {
+    cJSON                                                 *children_json;
+    cJSON                                                 *child_json;
+  
+    children_json = cJSON_GetObjectItemCaseSensitive( node_json, "children" );
+    for ( uint32 child_index = 0; child_index < cJSON_GetArraySize( children_json ); ++child_index )
+    {
+      child_json = cJSON_GetArrayItem( children_json, child_index );
+      crude_entity child_node = crude_node_manager_load_node_from_json_( manager, child_json, world, &node );
+    }
+  }
+
+  if ( copy_components )
+  {
+    crude_node_manager_load_components_from_json_( manager, world, node, cJSON_GetObjectItemCaseSensitive( node_json, "components" ) );
+  }
+
+  return node;
+}
+
+cJSON*
+crude_node_manager_parse_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *absolute_filepath
+)
+{
+  cJSON                                                 *json;
+  uint8                                                 *json_buffer;
+  uint32                                                 json_buffer_size;
+  uint32                                                 temporary_allocator_marker;
+  
+  temporary_allocator_marker = crude_stack_allocator_get_marker( manager->temporary_allocator );
+
+  json = NULL;
+
+  if ( !crude_file_exist( absolute_filepath ) )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot find a file \"%s\" to parse scene", absolute_filepath );
+    goto cleanup;
+  }
+  
+  crude_read_file( absolute_filepath, crude_stack_allocator_pack( manager->temporary_allocator ), &json_buffer, &json_buffer_size );
+  
+  json = cJSON_ParseWithLength( CRUDE_REINTERPRET_CAST( char const*, json_buffer ), json_buffer_size );
+  if ( !json )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_GRAPHICS, "Cannot parse a file for scene... Error %s", cJSON_GetErrorPtr() );
+    goto cleanup;
+  }
+
+cleanup:
+  crude_stack_allocator_free_marker( manager->temporary_allocator, temporary_allocator_marker );
+  return json;
+}
+
+cJSON*
+crude_node_manager_get_node_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *node_realtive_filepath
+)
+{
+  char const                                              *node_absolute_filepath;
+  int64                                                    node_index;
+  crude_node_manager_node_json                             new_node_json;
+
+  node_index = CRUDE_HASHMAPSTR_GET_INDEX( manager->relative_filepath_to_node_json, node_realtive_filepath );
+  if ( node_index != -1 )
+  {
+    return manager->relative_filepath_to_node_json[ node_index ].value.json;
+  }
+
+  /* The file could be the one which is being saved */
+  crude_node_manager_finish_node_save_( manager, true );
+
+  crude_string_buffer_clear( &manager->absolute_filepath_string_buffer );
+  node_absolute_filepath = crude_string_buffer_append_use_f( &manager->absolute_filepath_string_buffer, "%s%s", manager->resources_absolute_directory, node_realtive_filepath );
+
+  new_node_json.json = crude_node_manager_parse_json_( manager, node_absolute_filepath );
+  crude_string_copy( new_node_json.relative_filepath, node_realtive_filepath, sizeof( new_node_json.relative_filepath ) );
+
+  CRUDE_HASHMAPSTR_SET( manager->relative_filepath_to_node_json, CRUDE_COMPOUNT( crude_string_link, { new_node_json.relative_filepath } ), new_node_json );
+  return new_node_json.json;
+}
+
+crude_node_manager_node_template*
+crude_node_manager_compile_node_template_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *node_realtive_filepath,
+  _In_ crude_ecs                                          *world
+)
+{
+  crude_node_manager_node_template                        *node_template;
+  cJSON                                                   *node_json;
+  crude_entity                                             template_parent;
+  crude_entity                                             template_node;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_compile_node_template_" );
+
+  node_json = crude_node_manager_get_node_json_( manager, node_realtive_filepath );
+
+  node_template = CRUDE_CAST( crude_node_manager_node_template*, CRUDE_ALLOCATE( crude_heap_allocator_pack( manager->allocator ), sizeof( crude_node_manager_node_template ) ) );
+  crude_string_copy( node_template->relative_filepath, node_realtive_filepath, sizeof( node_template->relative_filepath ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_template->nodes, 8, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_template->commit_order, 8, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_template->components, 32, crude_heap_allocator_pack( manager->allocator ) );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_template->values, 4096, crude_heap_allocator_pack( manager->allocator ) );
+  
+  /* Parse the node once into a prefab hierarchy, flatten it and throw the prefabs away */
+  template_parent = crude_entity_create_empty_without_name( world );
+  crude_entity_add_id( world, template_parent, EcsPrefab );
+
+  manager->compiling_node_template = true;
+  template_node = crude_node_manager_load_node_from_json_( manager, node_json, world, &template_parent );
+  manager->compiling_node_template = false;
+
+  crude_node_manager_node_template_flatten_( manager, node_template, world, template_node, -1, false );
+  crude_entity_destroy_hierarchy( world, template_parent );
+
+  CRUDE_HASHMAPSTR_SET( manager->relative_filepath_to_node_template, CRUDE_COMPOUNT( crude_string_link, { node_template->relative_filepath } ), node_template );
+
+  CRUDE_LOG_INFO( CRUDE_CHANNEL_CORE, "Compiled node template \"%s\": %i nodes, %i components, %i bytes", node_realtive_filepath, CRUDE_ARRAY_LENGTH( node_template->nodes ), CRUDE_ARRAY_LENGTH( node_template->components ), CRUDE_ARRAY_LENGTH( node_template->values ) );
+  CRUDE_PROFILER_ZONE_END;
+  return node_template;
+}
+
+void
+crude_node_manager_node_template_flatten_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_template                   *node_template,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ int32                                               parent_index,
+  _In_ bool                                                live_node
+)
+{
+  crude_node_manager_node_template_node                    template_node;
+  ecs_type_t const                                        *node_type;
+  char const                                              *node_name;
+  crude_entity                                             streamed_node;
+  ecs_iter_t                                               it;
+  uint32                                                   template_node_index;
+
+  node_name = crude_entity_get_name( world, node );
+
+  template_node = CRUDE_COMPOUNT_EMPTY( crude_node_manager_node_template_node );
+  crude_string_copy( template_node.name, node_name ? node_name : "", sizeof( template_node.name ) );
+  template_node.entity = node;
+  template_node.parent_index = parent_index;
+  template_node.first_component_index = CRUDE_ARRAY_LENGTH( node_template->components );
+  
+  node_type = ecs_get_type( world, node );
+  for ( uint32 i = 0; i < node_type->count; ++i )
+  {
+    crude_node_manager_node_template_component             component;
+    ecs_type_info_t const                                 *type_info;
+    ecs_id_t                                               id;
+
+    id = node_type->array[ i ];
+
+    /* ChildOf and name pairs are recreated on instantiation */
+    if ( ECS_IS_PAIR( id ) || id == EcsPrefab )
+    {
+      continue;
+    }
+
+    if ( live_node && crude_node_manager_is_handle_component_( id ) )
+    {
+      continue;
+    }
+
+    type_info = ecs_get_type_info( world, id );
+
+    component.id = id;
+    component.type_info = type_info;
+    component.size = type_info ? type_info->size : 0;
+    component.offset = crude_memory_align( CRUDE_ARRAY_LENGTH( node_template->values ), 16 );
+
+    if ( component.size )
+    {
+      CRUDE_ARRAY_SET_LENGTH( node_template->values, component.offset + component.size );
+
+      /* Heap data of the entity (or the prefab thrown away after flattening) can't be shared, the template owns a deep copy */
+      if ( type_info->hooks.copy_ctor )
+      {
+        type_info->hooks.copy_ctor( node_template->values + component.offset, ecs_get_id( world, node, id ), 1, type_info );
+      }
+      /* Template takes prefab model instances as is, live ones stay with the entity and are copied */
+      else if ( live_node )
+      {
+        crude_node_manager_node_template_component_copy_( manager, id, node_template->values + component.offset, ecs_get_id( world, node, id ), component.size );
+      }
+      else
+      {
+        crude_memory_copy( node_template->values + component.offset, ecs_get_id( world, node, id ), component.size );
+      }
+
+      if ( id == ecs_id( crude_world_partition_cell ) )
+      {
+        CRUDE_REINTERPRET_CAST( crude_world_partition_cell*, node_template->values + component.offset )->streamed_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+      }
+    }
+
+    CRUDE_ARRAY_PUSH( node_template->components, component );
+  }
+  template_node.components_count = CRUDE_ARRAY_LENGTH( node_template->components ) - template_node.first_component_index;
+
+  template_node_index = CRUDE_ARRAY_LENGTH( node_template->nodes );
+  CRUDE_ARRAY_PUSH( node_template->nodes, template_node );
+
+  /* Streamed content belongs to the cell node file */
+  streamed_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+  if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_world_partition_cell ) )
+  {
+    streamed_node = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_world_partition_cell )->streamed_node;
+  }
+
+  it = crude_ecs_children( world, node );
+  while ( ecs_children_next( &it ) )
+  {
+    for ( size_t i = 0; i < it.count; ++i )
+    {
+      crude_entity                                         child;
+
+      child = crude_entity_from_iterator( &it, i );
+      if ( child != streamed_node )
+      {
+        crude_node_manager_node_template_flatten_( manager, node_template, world, child, template_node_index, live_node );
+      }
+    }
+  }
+
+  CRUDE_ARRAY_PUSH( node_template->commit_order, template_node_index );
+}
+
+void
+crude_node_manager_node_template_deinitialize_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_template                   *node_template
+)
+{
+  /* Template owns model instances parsed during compilation and the heap data of components with hooks */
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( node_template->components ); ++i )
+  {
+    crude_node_manager_node_template_component const      *component;
+
+    component = &node_template->components[ i ];
+
+    if ( component->id == ecs_id( crude_gltf ) )
+    {
+      crude_gltf                                           gltf;
+      crude_memory_copy( &gltf, node_template->values + component->offset, sizeof( crude_gltf ) );
+      crude_gfx_model_renderer_resources_instance_deinitialize( &gltf.model_renderer_resources_instance );
+    }
+    else if ( component->size && component->type_info->hooks.dtor )
+    {
+      component->type_info->hooks.dtor( node_template->values + component->offset, 1, component->type_info );
+    }
+  }
+
+  CRUDE_ARRAY_DEINITIALIZE( node_template->nodes );
+  CRUDE_ARRAY_DEINITIALIZE( node_template->commit_order );
+  CRUDE_ARRAY_DEINITIALIZE( node_template->components );
+  CRUDE_ARRAY_DEINITIALIZE( node_template->values );
+  CRUDE_DEALLOCATE( crude_heap_allocator_pack( manager->allocator ), node_template );
+}
+
+void
+crude_node_manager_node_template_component_copy_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ ecs_id_t                                            id,
+  _Out_ void                                              *dst,
+  _In_ void const                                         *src,
+  _In_ uint32                                              size
+)
+{
+  /* Components with hooks are copied shallow, flecs runs their copy hook when the value is set on the entity */
+  crude_memory_copy( dst, src, size );
+
+  /* Model instance arrays can't be shared between copies, crude_gltf_destroy_observer_ frees them per entity */
+  if ( id == ecs_id( crude_gltf ) )
+  {
+    crude_gltf const                                      *src_gltf;
+    crude_gltf                                            *dst_gltf;
+    crude_gfx_model_renderer_resources_instance           *dst_instance;
+    crude_gfx_model_renderer_resources_instance const     *src_instance;
+
+    src_gltf = CRUDE_CAST( crude_gltf const*, src );
+    dst_gltf = CRUDE_CAST( crude_gltf*, dst );
+    src_instance = &src_gltf->model_renderer_resources_instance;
+    dst_instance = &dst_gltf->model_renderer_resources_instance;
+
+    crude_gfx_model_renderer_resources_instance_initialize(
+      dst_instance,
+      src_instance->model_renderer_resources_handle.index != -1 ? manager->model_renderer_resources_manager : NULL,
+      src_instance->model_renderer_resources_handle );
+
+    crude_node_manager_reset_model_instance_animations_( dst_instance, src_instance );
+    dst_instance->model_to_world = src_instance->model_to_world;
+    dst_instance->cast_shadow = src_instance->cast_shadow;
+  }
+}
+
+crude_node_manager_node_template*
+crude_node_manager_get_node_template_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *node_realtive_filepath,
+  _In_ crude_ecs                                          *world
+)
+{
+  int64                                                    node_template_index;
+
+  node_template_index = CRUDE_HASHMAPSTR_GET_INDEX( manager->relative_filepath_to_node_template, node_realtive_filepath );
+  if ( node_template_index == -1 )
+  {
+    return crude_node_manager_compile_node_template_( manager, node_realtive_filepath, world );
+  }
+  return manager->relative_filepath_to_node_template[ node_template_index ].value;
+}
+
+void
+crude_node_manager_node_template_reset_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_template                   *node_template,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+)
+{
+  crude_entity                                            *template_nodes_entities;
+  bool                                                    *template_nodes_created;
+  ecs_value_t                                             *components_values;
+  uint8                                                   *instance_values;
+  uint32                                                   template_nodes_count;
+  uint32                                                   temporary_allocator_marker;
+
+  temporary_allocator_marker = crude_stack_allocator_get_marker( manager->temporary_allocator );
+
+  template_nodes_count = CRUDE_ARRAY_LENGTH( node_template->nodes );
+  template_nodes_entities = CRUDE_CAST( crude_entity*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), sizeof( crude_entity ) * template_nodes_count ) );
+  template_nodes_created = CRUDE_CAST( bool*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), sizeof( bool ) * template_nodes_count ) );
+  components_values = CRUDE_CAST( ecs_value_t*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), sizeof( ecs_value_t ) * ( CRUDE_ARRAY_LENGTH( node_template->components ) + 1 ) ) );
+  instance_values = CRUDE_CAST( uint8*, CRUDE_ALLOCATE( crude_stack_allocator_pack( manager->temporary_allocator ), CRUDE_ARRAY_LENGTH( node_template->values ) + 16 ) );
+  instance_values = CRUDE_REINTERPRET_CAST( uint8*, crude_memory_align( CRUDE_REINTERPRET_CAST( sizet, instance_values ), 16 ) );
+
+  template_nodes_entities[ 0 ] = node;
+  template_nodes_created[ 0 ] = false;
+
+  /* Gameplay could destroy some children (e.g. health of the dead zombie), recreate them */
+  for ( uint32 template_node_index = 1; template_node_index < template_nodes_count; ++template_node_index )
+  {
+    crude_node_manager_node_template_node const           *template_node;
+    crude_entity                                           parent_node;
+    crude_entity                                           child_node;
+
+    template_node = &node_template->nodes[ template_node_index ];
+    parent_node = template_nodes_entities[ template_node->parent_index ];
+
+    child_node = crude_ecs_lookup_entity_from_parent( world, parent_node, template_node->name[ 0 ] ? template_node->name : "entity" );
+    template_nodes_created[ template_node_index ] = false;
+
+    if ( !child_node )
+    {
+      ecs_entity_desc_t                                    entity_desc;
+
+      entity_desc = CRUDE_COMPOUNT_EMPTY( ecs_entity_desc_t );
+      entity_desc.parent = parent_node;
+      entity_desc.name = template_node->name[ 0 ] ? template_node->name : "entity";
+      entity_desc.sep = "";
+      child_node = ecs_entity_init( world, &entity_desc );
+      template_nodes_created[ template_node_index ] = true;
+    }
+
+    template_nodes_entities[ template_node_index ] = child_node;
+  }
+
+  for ( uint32 commit_index = 0; commit_index < template_nodes_count; ++commit_index )
+  {
+    crude_node_manager_node_template_node const           *template_node;
+    crude_entity                                           template_node_entity;
+    uint32                                                 template_node_index;
+    
+    template_node_index = node_template->commit_order[ commit_index ];
+    template_node = &node_template->nodes[ template_node_index ];
+    template_node_entity = template_nodes_entities[ template_node_index ];
+
+    if ( template_nodes_created[ template_node_index ] )
+    {
+      ecs_entity_desc_t                                    entity_desc;
+
+      for ( uint32 i = 0; i < template_node->components_count; ++i )
+      {
+        crude_node_manager_node_template_component const  *component;
+        
+        component = &node_template->components[ template_node->first_component_index + i ];
+
+        components_values[ i ].type = component->id;
+        components_values[ i ].ptr = NULL;
+
+        if ( component->size )
+        {
+          crude_node_manager_node_template_component_copy_( manager, component->id, instance_values + component->offset, node_template->values + component->offset, component->size );
+          components_values[ i ].ptr = instance_values + component->offset;
+        }
+      }
+      components_values[ template_node->components_count ] = CRUDE_COMPOUNT_EMPTY( ecs_value_t );
+
+      entity_desc = CRUDE_COMPOUNT_EMPTY( ecs_entity_desc_t );
+      entity_desc.id = template_node_entity;
+      entity_desc.set = components_values;
+      ecs_entity_init( world, &entity_desc );
+      continue;
+    }
+    
+    /* Only diverged components are set, unchanged bodies and sounds are not recreated by create observers */
+    for ( uint32 i = 0; i < template_node->components_count; ++i )
+    {
+      crude_node_manager_node_template_component const    *component;
+      void const                                          *template_value;
+      void const                                          *current_value;
+      
+      component = &node_template->components[ template_node->first_component_index + i ];
+      template_value = node_template->values + component->offset;
+
+      if ( !crude_entity_has_id( world, template_node_entity, component->id ) )
+      {
+        if ( component->size )
+        {
+          crude_node_manager_node_template_component_copy_( manager, component->id, instance_values + component->offset, template_value, component->size );
+          crude_entity_set_component( world, template_node_entity, component->id, component->size, instance_values + component->offset );
+        }
+        else
+        {
+          crude_entity_add_id( world, template_node_entity, component->id );
+        }
+        continue;
+      }
+
+      if ( !component->size )
+      {
+        continue;
+      }
+
+      if ( component->id == ecs_id( crude_gltf ) )
+      {
+        crude_gltf                                        *gltf;
+        
+        gltf = CRUDE_CAST( crude_gltf*, crude_entity_get_mutable_component( world, template_node_entity, component->id ) );
+        crude_node_manager_reset_model_instance_animations_( &gltf->model_renderer_resources_instance, &CRUDE_CAST( crude_gltf const*, template_value )->model_renderer_resources_instance );
+        gltf->hidden = CRUDE_CAST( crude_gltf const*, template_value )->hidden;
+        continue;
+      }
+
+      current_value = crude_entity_get_immutable_component( world, template_node_entity, component->id );
+      if ( memcmp( current_value, template_value, component->size ) != 0 )
+      {
+        crude_entity_set_component( world, template_node_entity, component->id, component->size, template_value );
+      }
+    }
+  }
+
+  crude_stack_allocator_free_marker( manager->temporary_allocator, temporary_allocator_marker );
+}
+
+void
+crude_node_manager_reset_model_instance_animations_
+(
+  _Inout_ crude_gfx_model_renderer_resources_instance     *dst_instance,
+  _In_ crude_gfx_model_renderer_resources_instance const  *src_instance
+)
+{
+  for ( uint32 k = 0; k < CRUDE_COUNTOF( dst_instance->animations_instances ); ++k )
+  {
+    crude_transform                                       *nodes_transforms;
+
+    nodes_transforms = dst_instance->animations_instances[ k ].nodes_transforms;
+    dst_instance->animations_instances[ k ] = src_instance->animations_instances[ k ];
+    dst_instance->animations_instances[ k ].nodes_transforms = nodes_transforms;
+  }
+  dst_instance->cast_shadow = src_instance->cast_shadow;
+}
+
+crude_node_manager_node_pool*
+crude_node_manager_get_node_pool_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                         *node_realtive_filepath
+)
+{
+  crude_node_manager_node_pool                            *node_pool;
+  int64                                                    node_pool_index;
+
+  node_pool_index = CRUDE_HASHMAPSTR_GET_INDEX( manager->relative_filepath_to_node_pool, node_realtive_filepath );
+  if ( node_pool_index != -1 )
+  {
+    return manager->relative_filepath_to_node_pool[ node_pool_index ].value;
+  }
+  
+  node_pool = CRUDE_CAST( crude_node_manager_node_pool*, CRUDE_ALLOCATE( crude_heap_allocator_pack( manager->allocator ), sizeof( crude_node_manager_node_pool ) ) );
+  crude_string_copy( node_pool->relative_filepath, node_realtive_filepath, sizeof( node_pool->relative_filepath ) );
+  node_pool->free_nodes_max_count = CRUDE_NODE_POOL_FREE_NODES_MAX_COUNT_DEFAULT;
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( node_pool->free_nodes, node_pool->free_nodes_max_count, crude_heap_allocator_pack( manager->allocator ) );
+  
+  CRUDE_HASHMAPSTR_SET( manager->relative_filepath_to_node_pool, CRUDE_COMPOUNT( crude_string_link, { node_pool->relative_filepath } ), node_pool );
+  return node_pool;
+}
+
+void
+crude_node_manager_node_enable_hierarchy_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ bool                                                enable
+)
+{
+  ecs_iter_t                                               it;
+
+  /* Bodies stay in pools, they are only removed from the broad phase */
+  if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_physics_character_handle ) )
+  {
+    crude_physics_enable_character( manager->physics_manager, *CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_physics_character_handle ), enable );
+  }
+  if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_physics_static_body_handle ) )
+  {
+    crude_physics_enable_static_body( manager->physics_manager, *CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_physics_static_body_handle ), enable );
+  }
+  if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_physics_kinematic_body_handle ) )
+  {
+    crude_physics_enable_kinematic_body( manager->physics_manager, *CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_physics_kinematic_body_handle ), enable );
+  }
+  if ( !enable && CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_audio_player_handle ) )
+  {
+    crude_sound_handle                                     sound_handle;
+
+    sound_handle = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_audio_player_handle )->sound_handle;
+    if ( sound_handle.index != CRUDE_SOUND_HANDLE_INVALID.index )
+    {
+      crude_audio_device_sound_stop( manager->audio_device, sound_handle );
+    }
+  }
+
+  /* Table moves are deferred so children iteration stays valid */
+  ecs_defer_begin( world );
+  crude_entity_enable( world, node, enable );
+  
+  it = crude_ecs_children( world, node );
+  while ( ecs_children_next( &it ) )
+  {
+    for ( size_t i = 0; i < it.count; ++i )
+    {
+      crude_node_manager_node_enable_hierarchy_( manager, world, crude_entity_from_iterator( &it, i ), enable );
+    }
+  }
+  ecs_defer_end( world );
+}
+
+void
+crude_node_manager_clear_node_jsons_
+(
+  _In_ crude_node_manager                                 *manager
+)
+{
+  for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( manager->relative_filepath_to_node_json ); ++i )
+  {
+    if ( crude_hashmapstr_backet_key_hash_valid( manager->relative_filepath_to_node_json[ i ].key.key_hash ) )
+    {
+      cJSON_Delete( manager->relative_filepath_to_node_json[ i ].value.json );
+    }
+    manager->relative_filepath_to_node_json[ i ].key.key_hash = CRUDE_HASHMAPSTR_BACKET_STATE_EMPTY;
+  }
+  CRUDE_HASHMAPSTR_LENGTH( manager->relative_filepath_to_node_json ) = 0;
+}
+
+void
+crude_node_manager_reload_node_from_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ cJSON                                              *node_json,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+)
+{
+  cJSON                                                   *children_json;
+  cJSON                                                   *components_json;
+  cJSON                                                   *merged_components_json;
+  crude_entity                                            *stale_children;
+  crude_entity                                             streamed_node;
+  ecs_iter_t                                               it;
+  bool                                                     is_node_external;
+  bool                                                     replace_node;
+
+  merged_components_json = NULL;
+
+  is_node_external = cJSON_HasObjectItem( node_json, "external" );
+  replace_node = ( is_node_external != CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_node_external ) );
+
+  if ( !replace_node && is_node_external )
+  {
+    cJSON                                                 *node_external_json;
+    crude_node_external const                             *node_external;
+    char const                                            *node_external_relative_filepath;
+    crude_node_external_type                               node_external_type;
+
+    node_external_json = cJSON_GetObjectItemCaseSensitive( node_json, "external" );
+    node_external_relative_filepath = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( node_external_json, "relative_filepath" ) );
+    node_external_type = CRUDE_CAST( crude_node_external_type, cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( node_external_json, "type" ) ) );
+
+    node_external = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_node_external );
+    replace_node = ( node_external->type != node_external_type ) || ( crude_string_cmp( node_external->node_relative_filepath, node_external_relative_filepath ) != 0 );
+  }
+
+  /* Node kind changed, nothing to diff against */
+  if ( replace_node )
+  {
+    crude_entity                                           parent;
+    
+    parent = crude_entity_get_parent( world, node );
+    crude_entity_destroy_hierarchy( world, node );
+    crude_node_manager_load_node_from_json_( manager, node_json, world, &parent );
+    return;
+  }
+
+  if ( is_node_external )
+  {
+    crude_node_external const                             *node_external;
+    cJSON                                                 *external_node_json;
+    cJSON const                                           *override_components_json;
+
+    node_external = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_node_external );
+    external_node_json = crude_node_manager_get_node_json_( manager, node_external->node_relative_filepath );
+
+    children_json = cJSON_GetObjectItemCaseSensitive( external_node_json, "children" );
+    components_json = cJSON_GetObjectItemCaseSensitive( external_node_json, "components" );
+
+    /* Copied external node gets override components on top of the external ones, see crude_node_manager_load_node_from_json_ */
+    if ( node_external->type == CRUDE_NODE_EXTERNAL_TYPE_COPY )
+    {
+      merged_components_json = components_json ? cJSON_Duplicate( components_json, true ) : cJSON_CreateArray( );
+      override_components_json = cJSON_GetObjectItemCaseSensitive( node_json, "components" );
+
+      for ( uint32 component_index = 0; component_index < cJSON_GetArraySize( override_components_json ); ++component_index )
+      {
+        cJSON const                                       *override_component_json;
+        int32                                              merged_component_index;
+
+        override_component_json = cJSON_GetArrayItem( override_components_json, component_index );
+        merged_component_index = crude_node_manager_get_component_json_index_( merged_components_json, cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( override_component_json, "type" ) ) );
+        if ( merged_component_index == -1 )
+        {
+          cJSON_AddItemToArray( merged_components_json, cJSON_Duplicate( override_component_json, true ) );
+        }
+        else
+        {
+          cJSON_ReplaceItemInArray( merged_components_json, merged_component_index, cJSON_Duplicate( override_component_json, true ) );
+        }
+      }
+
+      components_json = merged_components_json;
+    }
+  }
+  else
+  {
+    children_json = cJSON_GetObjectItemCaseSensitive( node_json, "children" );
+    components_json = cJSON_GetObjectItemCaseSensitive( node_json, "components" );
+  }
+
+  for ( uint32 child_index = 0; child_index < cJSON_GetArraySize( children_json ); ++child_index )
+  {
+    cJSON                                                 *child_json;
+    char const                                            *child_name;
+    crude_entity                                           child;
+
+    child_json = cJSON_GetArrayItem( children_json, child_index );
+    child_name = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( child_json, "name" ) );
+    child = child_name ? crude_ecs_lookup_entity_from_parent( world, node, child_name ) : CRUDE_COMPOUNT_EMPTY( crude_entity );
+
+    if ( crude_entity_valid( world, child ) )
+    {
+      crude_node_manager_reload_node_from_json_( manager, child_json, world, child );
+    }
+    else
+    {
+      crude_node_manager_load_node_from_json_( manager, child_json, world, &node );
     }
   }
   
-  if ( !is_gltf_node && !is_external_node )
+  streamed_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+  if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_world_partition_cell ) )
+  {
+    streamed_node = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_world_partition_cell )->streamed_node;
+  }
+
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( stale_children, 4, crude_heap_allocator_pack( manager->allocator ) );
+
+  it = crude_ecs_children( world, node );
+  while ( ecs_children_next( &it ) )
+  {
+    for ( size_t i = 0; i < it.count; ++i )
+    {
+      crude_entity                                         child;
+
+      child = crude_entity_from_iterator( &it, i );
+      if ( child != streamed_node && !crude_node_manager_get_child_json_( children_json, crude_entity_get_name( world, child ) ) )
+      {
+        CRUDE_ARRAY_PUSH( stale_children, child );
+      }
+    }
+  }
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( stale_children ); ++i )
+  {
+    crude_entity_destroy_hierarchy( world, stale_children[ i ] );
+  }
+
+  CRUDE_ARRAY_DEINITIALIZE( stale_children );
+
+  crude_node_manager_reload_components_from_json_( manager, world, node, components_json );
+
+  if ( merged_components_json )
+  {
+    cJSON_Delete( merged_components_json );
+  }
+}
+
+void
+crude_node_manager_reload_components_from_json_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_opt_ cJSON const                                    *components_json
+)
+{
+  crude_components_serialization_manager                  *serialization_manager;
+  cJSON const                                            **matched_components_json;
+
+  serialization_manager = manager->components_serialization_manager;
+
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( matched_components_json, 8, crude_heap_allocator_pack( manager->allocator ) );
+
+  /* Live components are serialized back and compared with the file, unchanged ones are left untouched */
+  for ( uint32 i = 0; i < CRUDE_HASHMAP_CAPACITY( serialization_manager->component_id_to_json_funs ); ++i )
+  {
+    cJSON                                                 *live_component_json;
+    cJSON const                                           *component_json;
+    ecs_id_t                                               component_id;
+    int32                                                  component_index;
+
+    if ( !crude_hashmap_backet_key_valid( serialization_manager->component_id_to_json_funs[ i ].key ) )
+    {
+      continue;
+    }
+
+    live_component_json = serialization_manager->component_id_to_json_funs[ i ].value( world, node, manager );
+    if ( !live_component_json )
+    {
+      continue;
+    }
+    
+    component_id = serialization_manager->component_id_to_json_funs[ i ].key;
+    component_index = crude_node_manager_get_component_json_index_( components_json, cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( live_component_json, "type" ) ) );
+
+    if ( component_index == -1 )
+    {
+      crude_node_manager_remove_component_( world, node, component_id );
+    }
+    else
+    {
+      component_json = cJSON_GetArrayItem( components_json, component_index );
+      CRUDE_ARRAY_PUSH( matched_components_json, component_json );
+
+      if ( !cJSON_Compare( live_component_json, component_json, true ) )
+      {
+        crude_entity                                       streamed_node;
+        int64                                              parse_func_index;
+
+        streamed_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+
+        /* Set replaces the component without remove observers, old model instance is released here */
+        if ( component_id == ecs_id( crude_gltf ) )
+        {
+          crude_gfx_model_renderer_resources_instance_deinitialize( &CRUDE_ENTITY_GET_MUTABLE_COMPONENT( world, node, crude_gltf )->model_renderer_resources_instance );
+        }
+        else if ( component_id == ecs_id( crude_world_partition_cell ) )
+        {
+          streamed_node = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_world_partition_cell )->streamed_node;
+        }
+
+        parse_func_index = CRUDE_HASHMAPSTR_GET_INDEX( serialization_manager->component_name_to_json_funs, cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( component_json, "type" ) ) );
+        CRUDE_ASSERT( parse_func_index != -1 );
+        serialization_manager->component_name_to_json_funs[ parse_func_index ].value( world, node, component_json, manager );
+        
+        if ( component_id == ecs_id( crude_world_partition_cell ) )
+        {
+          CRUDE_ENTITY_GET_MUTABLE_COMPONENT( world, node, crude_world_partition_cell )->streamed_node = streamed_node;
+        }
+      }
+    }
+
+    cJSON_Delete( live_component_json );
+  }
+
+  for ( uint32 component_index = 0; component_index < cJSON_GetArraySize( components_json ); ++component_index )
+  {
+    cJSON const                                           *component_json;
+    bool                                                   component_matched;
+    int64                                                  parse_func_index;
+
+    component_json = cJSON_GetArrayItem( components_json, component_index );
+
+    component_matched = false;
+    for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( matched_components_json ); ++i )
+    {
+      if ( matched_components_json[ i ] == component_json )
+      {
+        component_matched = true;
+        break;
+      }
+    }
+
+    if ( component_matched )
+    {
+      continue;
+    }
+
+    parse_func_index = CRUDE_HASHMAPSTR_GET_INDEX( serialization_manager->component_name_to_json_funs, cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( component_json, "type" ) ) );
+    CRUDE_ASSERT( parse_func_index != -1 );
+    serialization_manager->component_name_to_json_funs[ parse_func_index ].value( world, node, component_json, manager );
+  }
+
+  CRUDE_ARRAY_DEINITIALIZE( matched_components_json );
+}
+
+int32
+crude_node_manager_get_component_json_index_
+(
+  _In_opt_ cJSON const                                    *components_json,
+  _In_ char const                                         *component_type
+)
+{
+  for ( uint32 component_index = 0; component_index < cJSON_GetArraySize( components_json ); ++component_index )
+  {
+    char const                                            *type;
+
+    type = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( cJSON_GetArrayItem( components_json, component_index ), "type" ) );
+    if ( type && crude_string_cmp( type, component_type ) == 0 )
+    {
+      return component_index;
+    }
+  }
+  return -1;
+}
+
+cJSON*
+crude_node_manager_get_child_json_
+(
+  _In_opt_ cJSON const                                    *children_json,
+  _In_opt_ char const                                     *child_name
+)
+{
+  if ( !child_name )
+  {
+    return NULL;
+  }
+
+  for ( uint32 child_index = 0; child_index < cJSON_GetArraySize( children_json ); ++child_index )
+  {
+    cJSON                                                 *child_json;
+    char const                                            *name;
+
+    child_json = cJSON_GetArrayItem( children_json, child_index );
+    name = cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( child_json, "name" ) );
+    if ( name && crude_string_cmp( name, child_name ) == 0 )
+    {
+      return child_json;
+    }
+  }
+  return NULL;
+}
+
+bool
+crude_node_manager_is_handle_component_
+(
+  _In_ ecs_id_t                                            id
+)
+{
+  return id == ecs_id( crude_physics_character_handle )
+    || id == ecs_id( crude_physics_static_body_handle )
+    || id == ecs_id( crude_physics_kinematic_body_handle )
+    || id == ecs_id( crude_audio_player_handle );
+}
+
+bool
+crude_node_manager_is_resource_component_
+(
+  _In_ ecs_id_t                                            id
+)
+{
+  return id == ecs_id( crude_gltf )
+    || id == ecs_id( crude_terrain )
+    || id == ecs_id( crude_physics_static_body )
+    || id == ecs_id( crude_physics_kinematic_body );
+}
+
+void
+crude_node_manager_remove_component_
+(
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ ecs_id_t                                            id
+)
+{
+  crude_entity_remove_id( world, node, id );
+
+  /* Destroy observers keep handle components, stale handle would be destroyed again once the body is added back */
+  if ( id == ecs_id( crude_physics_character ) )
+  {
+    CRUDE_ENTITY_REMOVE_COMPONENT( world, node, crude_physics_character_handle );
+  }
+  else if ( id == ecs_id( crude_physics_static_body ) )
+  {
+    CRUDE_ENTITY_REMOVE_COMPONENT( world, node, crude_physics_static_body_handle );
+  }
+  else if ( id == ecs_id( crude_physics_kinematic_body ) )
+  {
+    CRUDE_ENTITY_REMOVE_COMPONENT( world, node, crude_physics_kinematic_body_handle );
+  }
+}
+
+void
+crude_node_manager_collect_node_assets_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _Inout_ crude_node_manager_node_assets                  *assets
+)
+{
+  ecs_iter_t                                               it;
+
+  if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_gltf ) )
   {
-    cJSON                                                 *children_json;
-    ecs_iter_t                                             it;
+    crude_node_manager_collect_model_asset_( manager, CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_gltf )->model_renderer_resources_instance.model_renderer_resources_handle, assets );
+  }
 
-    children_json = cJSON_AddArrayToObject( node_json, "children" );
-    
-    it = crude_ecs_children( world, node );
-    while ( ecs_children_next( &it ) )
+  if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_physics_static_body ) )
+  {
+    crude_physics_static_body const                       *static_body;
+
+    static_body = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_physics_static_body );
+    if ( static_body->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH )
     {
-      for ( size_t i = 0; i < it.count; ++i )
+      crude_node_manager_collect_mesh_shape_asset_( manager, static_body->mesh.handle, assets );
+    }
+  }
+
+  if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_physics_kinematic_body ) )
+  {
+    crude_physics_kinematic_body const                    *kinematic_body;
+
+    kinematic_body = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_physics_kinematic_body );
+    if ( kinematic_body->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH )
+    {
+      crude_node_manager_collect_mesh_shape_asset_( manager, kinematic_body->mesh.handle, assets );
+    }
+  }
+
+  it = crude_ecs_children( world, node );
+  while ( ecs_children_next( &it ) )
+  {
+    for ( size_t i = 0; i < it.count; ++i )
+    {
+      crude_node_manager_collect_node_assets_( manager, world, crude_entity_from_iterator( &it, i ), assets );
+    }
+  }
+}
+
+void
+crude_node_manager_collect_model_asset_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_gfx_model_renderer_resources_handle           handle,
+  _Inout_ crude_node_manager_node_assets                  *assets
+)
+{
+  if ( handle.index == -1 )
+  {
+    return;
+  }
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( assets->models ); ++i )
+  {
+    if ( assets->models[ i ].index == handle.index )
+    {
+      return;
+    }
+  }
+
+  CRUDE_ARRAY_PUSH( assets->models, handle );
+  assets->size += crude_gfx_model_renderer_resources_manager_access_model_renderer_resources( manager->model_renderer_resources_manager, handle )->size;
+}
+
+void
+crude_node_manager_collect_mesh_shape_asset_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_physics_mesh_shape_handle                     handle,
+  _Inout_ crude_node_manager_node_assets                  *assets
+)
+{
+  crude_physics_mesh_shape_container const                *mesh_shape_container;
+
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( assets->mesh_shapes ); ++i )
+  {
+    if ( assets->mesh_shapes[ i ].index == handle.index )
+    {
+      return;
+    }
+  }
+
+  mesh_shape_container = crude_physics_shapes_manager_access_mesh_shape( manager->physics_manager->physics_shapes_manager, handle );
+  CRUDE_ARRAY_PUSH( assets->mesh_shapes, handle );
+  assets->size += mesh_shape_container->size;
+
+#if CRUDE_DEVELOP
+  if ( manager->physics_manager->physics_shapes_manager->model_renderer_resources_manager )
+  {
+    crude_node_manager_collect_model_asset_( manager, mesh_shape_container->debug_model_renderer_resource_instance.model_renderer_resources_handle, assets );
+  }
+#endif
+}
+
+bool
+crude_node_manager_is_model_used_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_gfx_model_renderer_resources_handle           handle
+)
+{
+  ecs_iter_t                                               it;
+
+  /* Disabled pooled nodes and prefabs are matched too */
+  it = ecs_each_id( world, ecs_id( crude_gltf ) );
+  while ( ecs_each_next( &it ) )
+  {
+    crude_gltf                                            *gltfs;
+
+    gltfs = ecs_field( &it, crude_gltf, 0 );
+    for ( uint32 i = 0; i < it.count; ++i )
+    {
+      if ( gltfs[ i ].model_renderer_resources_instance.model_renderer_resources_handle.index == handle.index )
       {
-        crude_entity                                       child;
+        ecs_iter_fini( &it );
+        return true;
+      }
+    }
+  }
 
-        child = crude_entity_from_iterator( &it, i );
-        cJSON_AddItemToArray( children_json, crude_node_manager_node_to_json_hierarchy_( manager, world, child ) );
+  for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( manager->relative_filepath_to_node_template ); ++i )
+  {
+    crude_node_manager_node_template const                *node_template;
+
+    if ( !crude_hashmapstr_backet_key_hash_valid( manager->relative_filepath_to_node_template[ i ].key.key_hash ) )
+    {
+      continue;
+    }
+
+    node_template = manager->relative_filepath_to_node_template[ i ].value;
+    for ( uint32 component_index = 0; component_index < CRUDE_ARRAY_LENGTH( node_template->components ); ++component_index )
+    {
+      crude_gltf const                                    *gltf;
+
+      if ( node_template->components[ component_index ].id != ecs_id( crude_gltf ) )
+      {
+        continue;
+      }
+
+      gltf = CRUDE_REINTERPRET_CAST( crude_gltf const*, node_template->values + node_template->components[ component_index ].offset );
+      if ( gltf->model_renderer_resources_instance.model_renderer_resources_handle.index == handle.index )
+      {
+        return true;
+      }
+    }
+  }
+
+#if CRUDE_DEVELOP
+  {
+    crude_physics_shapes_manager                          *shapes_manager;
+
+    shapes_manager = manager->physics_manager->physics_shapes_manager;
+    for ( uint32 i = 0; shapes_manager->model_renderer_resources_manager && i < CRUDE_HASHMAPSTR_CAPACITY( shapes_manager->mesh_shape_relative_filepath_to_hadle ); ++i )
+    {
+      if ( !crude_hashmapstr_backet_key_hash_valid( shapes_manager->mesh_shape_relative_filepath_to_hadle[ i ].key.key_hash ) )
+      {
+        continue;
+      }
+
+      if ( crude_physics_shapes_manager_access_mesh_shape( shapes_manager, shapes_manager->mesh_shape_relative_filepath_to_hadle[ i ].value )->debug_model_renderer_resource_instance.model_renderer_resources_handle.index == handle.index )
+      {
+        return true;
+      }
+    }
+  }
+#endif
+
+  return false;
+}
+
+bool
+crude_node_manager_is_mesh_shape_used_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_physics_mesh_shape_handle                     handle
+)
+{
+  ecs_iter_t                                               it;
+
+  it = ecs_each_id( world, ecs_id( crude_physics_static_body ) );
+  while ( ecs_each_next( &it ) )
+  {
+    crude_physics_static_body                             *static_bodies;
+
+    static_bodies = ecs_field( &it, crude_physics_static_body, 0 );
+    for ( uint32 i = 0; i < it.count; ++i )
+    {
+      if ( static_bodies[ i ].type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH && static_bodies[ i ].mesh.handle.index == handle.index )
+      {
+        ecs_iter_fini( &it );
+        return true;
+      }
+    }
+  }
+
+  it = ecs_each_id( world, ecs_id( crude_physics_kinematic_body ) );
+  while ( ecs_each_next( &it ) )
+  {
+    crude_physics_kinematic_body                          *kinematic_bodies;
+
+    kinematic_bodies = ecs_field( &it, crude_physics_kinematic_body, 0 );
+    for ( uint32 i = 0; i < it.count; ++i )
+    {
+      if ( kinematic_bodies[ i ].type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH && kinematic_bodies[ i ].mesh.handle.index == handle.index )
+      {
+        ecs_iter_fini( &it );
+        return true;
+      }
+    }
+  }
+
+  for ( uint32 i = 0; i < CRUDE_HASHMAPSTR_CAPACITY( manager->relative_filepath_to_node_template ); ++i )
+  {
+    crude_node_manager_node_template const                *node_template;
+
+    if ( !crude_hashmapstr_backet_key_hash_valid( manager->relative_filepath_to_node_template[ i ].key.key_hash ) )
+    {
+      continue;
+    }
+
+    node_template = manager->relative_filepath_to_node_template[ i ].value;
+    for ( uint32 component_index = 0; component_index < CRUDE_ARRAY_LENGTH( node_template->components ); ++component_index )
+    {
+      crude_node_manager_node_template_component const    *component;
+      uint8 const                                         *value;
+
+      component = &node_template->components[ component_index ];
+      value = node_template->values + component->offset;
+      if ( component->id == ecs_id( crude_physics_static_body ) && CRUDE_REINTERPRET_CAST( crude_physics_static_body const*, value )->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH && CRUDE_REINTERPRET_CAST( crude_physics_static_body const*, value )->mesh.handle.index == handle.index )
+      {
+        return true;
+      }
+      if ( component->id == ecs_id( crude_physics_kinematic_body ) && CRUDE_REINTERPRET_CAST( crude_physics_kinematic_body const*, value )->type == CRUDE_PHYSICS_BODY_SHAPE_TYPE_MESH && CRUDE_REINTERPRET_CAST( crude_physics_kinematic_body const*, value )->mesh.handle.index == handle.index )
+      {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void
+crude_node_manager_save_task_set_fn_
+(
+  _In_ uint32_t                                            start_,
+  _In_ uint32_t                                            end_,
+  _In_ uint32_t                                            threadnum_,
+  _In_ void                                               *ctx
+)
+{
+  crude_node_manager                                      *manager;
+  crude_node_manager_node_save                            *node_save;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_node_manager_save_task_set_fn_" );
+
+  manager = CRUDE_CAST( crude_node_manager*, ctx );
+  node_save = manager->node_save;
+
+  if ( crude_json_writer_initialize( &node_save->writer, node_save->absolute_filepath ) )
+  {
+    crude_node_manager_node_save_write_node_( node_save, 0 );
+  }
+  node_save->failed = !crude_json_writer_deinitialize( &node_save->writer );
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_node_manager_node_save_capture_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_save                       *node_save,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ int32                                               parent_index
+)
+{
+  crude_components_serialization_manager                  *serialization_manager;
+  crude_node_manager_node_template_node                    save_node;
+  crude_node_external const                               *node_external;
+  char const                                              *node_name;
+  crude_entity                                             streamed_node;
+  ecs_iter_t                                               it;
+  uint32                                                   save_node_index;
+
+  serialization_manager = manager->components_serialization_manager;
+  node_name = crude_entity_get_name( world, node );
+
+  save_node = CRUDE_COMPOUNT_EMPTY( crude_node_manager_node_template_node );
+  crude_string_copy( save_node.name, node_name ? node_name : "", sizeof( save_node.name ) );
+  save_node.entity = node;
+  save_node.parent_index = parent_index;
+  save_node.first_component_index = CRUDE_ARRAY_LENGTH( node_save->components );
+
+  node_external = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_node_external );
+  if ( node_external )
+  {
+    crude_node_manager_node_save_capture_component_( manager, node_save, world, node, ecs_id( crude_node_external ), NULL );
+  }
+
+  if ( !node_external || node_external->type == CRUDE_NODE_EXTERNAL_TYPE_COPY )
+  {
+    for ( uint32 i = 0; i < CRUDE_HASHMAP_CAPACITY( serialization_manager->component_id_to_value_json_funs ); ++i )
+    {
+      if ( crude_hashmap_backet_key_valid( serialization_manager->component_id_to_value_json_funs[ i ].key ) && ecs_has_id( world, node, serialization_manager->component_id_to_value_json_funs[ i ].key ) )
+      {
+        crude_node_manager_node_save_capture_component_( manager, node_save, world, node, serialization_manager->component_id_to_value_json_funs[ i ].key, serialization_manager->component_id_to_value_json_funs[ i ].value );
+      }
+    }
+  }
+  save_node.components_count = CRUDE_ARRAY_LENGTH( node_save->components ) - save_node.first_component_index;
+
+  save_node_index = CRUDE_ARRAY_LENGTH( node_save->nodes );
+  CRUDE_ARRAY_PUSH( node_save->nodes, save_node );
+
+  /* Children of the external node are in its own file */
+  if ( node_external )
+  {
+    return;
+  }
+
+  streamed_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+  if ( CRUDE_ENTITY_HAS_COMPONENT( world, node, crude_world_partition_cell ) )
+  {
+    streamed_node = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( world, node, crude_world_partition_cell )->streamed_node;
+  }
+
+  it = crude_ecs_children( world, node );
+  while ( ecs_children_next( &it ) )
+  {
+    for ( size_t i = 0; i < it.count; ++i )
+    {
+      crude_entity                                         child;
+
+      child = crude_entity_from_iterator( &it, i );
+      if ( child != streamed_node )
+      {
+        crude_node_manager_node_save_capture_( manager, node_save, world, child, save_node_index );
+      }
+    }
+  }
+}
+
+void
+crude_node_manager_node_save_capture_component_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_node_save                       *node_save,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ ecs_id_t                                            id,
+  _In_opt_ crude_crude_components_serialization_parse_component_value_to_json_func to_json_fn
+)
+{
+  crude_node_manager_node_template_component               component;
+  ecs_type_info_t const                                   *type_info;
+  cJSON                                                   *component_json;
+
+  type_info = ecs_get_type_info( world, id );
+
+  component.id = id;
+  component.type_info = type_info;
+  component.size = type_info ? type_info->size : 0;
+  component.offset = crude_memory_align( CRUDE_ARRAY_LENGTH( node_save->values ), 16 );
+
+  /* Values are copied as is, serialization only reads them and doesn't need deep copies */
+  if ( component.size )
+  {
+    CRUDE_ARRAY_SET_LENGTH( node_save->values, component.offset + component.size );
+    crude_memory_copy( node_save->values + component.offset, ecs_get_id( world, node, id ), component.size );
+  }
+
+  /* Model, texture and mesh shape paths are resolved here, the managers are owned by the main thread */
+  component_json = NULL;
+  if ( to_json_fn && crude_node_manager_is_resource_component_( id ) )
+  {
+    component_json = to_json_fn( node_save->values + component.offset, manager );
+  }
+
+  CRUDE_ARRAY_PUSH( node_save->components, component );
+  CRUDE_ARRAY_PUSH( node_save->components_to_json_funs, to_json_fn );
+  CRUDE_ARRAY_PUSH( node_save->components_json, component_json );
+}
+
+uint32
+crude_node_manager_node_save_write_node_
+(
+  _In_ crude_node_manager_node_save                       *node_save,
+  _In_ uint32                                              node_index
+)
+{
+  crude_node_manager_node_template_node const             *save_node;
+  crude_node_external const                               *node_external;
+  crude_json_writer                                       *writer;
+  uint32                                                   first_component_index;
+  uint32                                                   child_index;
+
+  save_node = &node_save->nodes[ node_index ];
+  writer = &node_save->writer;
+
+  crude_json_writer_begin_object( writer );
+
+  if ( save_node->name[ 0 ] )
+  {
+    crude_json_writer_key( writer, "name" );
+    crude_json_writer_string( writer, save_node->name );
+  }
+
+  first_component_index = save_node->first_component_index;
+
+  node_external = NULL;
+  if ( save_node->components_count && node_save->components[ first_component_index ].id == ecs_id( crude_node_external ) )
+  {
+    node_external = CRUDE_REINTERPRET_CAST( crude_node_external const*, node_save->values + node_save->components[ first_component_index ].offset );
+    ++first_component_index;
+
+    crude_json_writer_key( writer, "external" );
+    crude_json_writer_begin_object( writer );
+    crude_json_writer_key( writer, "relative_filepath" );
+    crude_json_writer_string( writer, node_external->node_relative_filepath );
+    crude_json_writer_key( writer, "type" );
+    crude_json_writer_number( writer, node_external->type );
+    crude_json_writer_end_object( writer );
+  }
+
+  if ( !node_external || node_external->type == CRUDE_NODE_EXTERNAL_TYPE_COPY )
+  {
+    crude_json_writer_key( writer, "components" );
+    crude_json_writer_begin_array( writer );
+    for ( uint32 i = first_component_index; i < save_node->first_component_index + save_node->components_count; ++i )
+    {
+      cJSON                                               *component_json;
+
+      if ( node_save->components_json[ i ] )
+      {
+        crude_json_writer_cjson( writer, node_save->components_json[ i ] );
+        continue;
+      }
+
+      /* Only one component is kept as cJSON at a time, the rest don't read the managers and get no node manager */
+      component_json = node_save->components_to_json_funs[ i ]( node_save->values + node_save->components[ i ].offset, NULL );
+      if ( component_json )
+      {
+        crude_json_writer_cjson( writer, component_json );
+        cJSON_Delete( component_json );
       }
     }
+    crude_json_writer_end_array( writer );
+  }
+
+  /* Nodes are in pre-order, so children follow the node and each subtree ends where the next sibling starts */
+  child_index = node_index + 1;
+  if ( !node_external )
+  {
+    crude_json_writer_key( writer, "children" );
+    crude_json_writer_begin_array( writer );
+    while ( child_index < CRUDE_ARRAY_LENGTH( node_save->nodes ) && node_save->nodes[ child_index ].parent_index == node_index )
+    {
+      child_index = crude_node_manager_node_save_write_node_( node_save, child_index );
+    }
+    crude_json_writer_end_array( writer );
+  }
+
+  crude_json_writer_end_object( writer );
+  return child_index;
+}
+
+bool
+crude_node_manager_finish_node_save_
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ bool                                                wait
+)
+{
+  crude_node_manager_node_save                            *node_save;
+
+  node_save = manager->node_save;
+  if ( !node_save )
+  {
+    return true;
+  }
+
+  if ( wait )
+  {
+    crude_task_sheduler_wait_task_set( manager->task_sheduler, manager->save_task_set_handle );
+  }
+  else if ( !crude_task_sheduler_is_task_set_complete( manager->task_sheduler, manager->save_task_set_handle ) )
+  {
+    return false;
+  }
+
+  if ( node_save->failed )
+  {
+    CRUDE_LOG_ERROR( CRUDE_CHANNEL_CORE, "Cannot save node to \"%s\"", node_save->absolute_filepath );
+  }
+  else
+  {
+    CRUDE_LOG_INFO( CRUDE_CHANNEL_CORE, "Saved node to \"%s\": %i nodes, %i components", node_save->absolute_filepath, CRUDE_ARRAY_LENGTH( node_save->nodes ), CRUDE_ARRAY_LENGTH( node_save->components ) );
+  }
+
+  CRUDE_ARRAY_DEINITIALIZE( node_save->nodes );
+  CRUDE_ARRAY_DEINITIALIZE( node_save->components );
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( node_save->components_json ); ++i )
+  {
+    if ( node_save->components_json[ i ] )
+    {
+      cJSON_Delete( node_save->components_json[ i ] );
+    }
   }
 
-  return node_json;
+  CRUDE_ARRAY_DEINITIALIZE( node_save->components_to_json_funs );
+  CRUDE_ARRAY_DEINITIALIZE( node_save->components_json );
+  CRUDE_ARRAY_DEINITIALIZE( node_save->values );
+  CRUDE_DEALLOCATE( crude_heap_allocator_pack( manager->allocator ), node_save );
+  manager->node_save = NULL;
+  return true;
 }
\ No newline at end of file
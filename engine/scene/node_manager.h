@@ -4,6 +4,9 @@
 #include <engine/core/memory.h>
 #include <engine/core/string.h>
 #include <engine/core/hashmapstr.h>
+#include <engine/core/task_sheduler.h>
+#include <engine/core/json_writer.h>
+#include <engine/scene/components_serialization.h>
 #include <engine/graphics/model_renderer_resources_manager.h>
 #include <engine/audio/audio_device.h>
 #include <engine/physics/physics.h>
@@ -17,15 +20,182 @@ typedef void (*crude_node_manager_select_camera)
   _In_ crude_entity                                        camera_node
 );
 
+typedef void (*crude_node_manager_node_loaded)
+( 
+  _In_ void                                               *ctx,
+  _In_ crude_entity                                        node
+);
+
 typedef struct crude_node_manager_node_json
 {
   cJSON                                                   *json;
   char                                                     relative_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ];
 } crude_node_manager_node_json;
 
+typedef struct crude_node_manager_node_template_component
+{
+  ecs_id_t                                                 id;
+  /* Components with lifecycle hooks own heap data, templates copy and free it through them */
+  ecs_type_info_t const                                   *type_info;
+  uint32                                                   size;
+  uint32                                                   offset;
+} crude_node_manager_node_template_component;
+
+typedef struct crude_node_manager_node_template_node
+{
+  char                                                     name[ CRUDE_NODE_NAME_LENGTH_MAX ];
+  /* Flattened entity, only snapshots use it */
+  crude_entity                                             entity;
+  int32                                                    parent_index;
+  uint32                                                   first_component_index;
+  uint32                                                   components_count;
+} crude_node_manager_node_template_node;
+
+/* Nodes are stored in pre-order, commit_order is post-order (children first, like crude_node_manager_create_node) */
+typedef struct crude_node_manager_node_template
+{
+  char                                                     relative_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ];
+  crude_node_manager_node_template_node                   *nodes;
+  uint32                                                  *commit_order;
+  crude_node_manager_node_template_component              *components;
+  uint8                                                   *values;
+} crude_node_manager_node_template;
+
+typedef struct crude_node_manager_snapshot_character
+{
+  uint32                                                   node_index;
+  XMFLOAT3                                                 linear_velocity;
+} crude_node_manager_snapshot_character;
+
+typedef struct crude_node_manager_snapshot_sound
+{
+  uint32                                                   node_index;
+  bool                                                     playing;
+} crude_node_manager_snapshot_sound;
+
+/**
+ * Live hierarchy flattened like a node template. Handle components are not
+ * captured, bodies and sounds are synced from side tables on restore.
+ */
+typedef struct crude_node_manager_snapshot
+{
+  crude_ecs                                               *world;
+  crude_node_manager_node_template                        *nodes_template;
+  crude_node_manager_snapshot_character                   *characters;
+  crude_node_manager_snapshot_sound                       *sounds;
+} crude_node_manager_snapshot;
+
+/**
+ * Component values are captured on the main thread without deep copies,
+ * the save task serializes them with crude_json_writer. Components that
+ * reference resources are converted to cJSON on capture, so the task
+ * never reads the resource managers.
+ */
+typedef struct crude_node_manager_node_save
+{
+  char                                                     absolute_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ];
+  /* Pre-order, like template nodes */
+  crude_node_manager_node_template_node                   *nodes;
+  crude_node_manager_node_template_component              *components;
+  /* Resolved on capture, the worker doesn't touch the serialization manager */
+  crude_crude_components_serialization_parse_component_value_to_json_func *components_to_json_funs;
+  /* Converted on capture for components that reference resources, NULL for the rest */
+  cJSON                                                  **components_json;
+  uint8                                                   *values;
+  crude_json_writer                                        writer;
+  bool                                                     failed;
+} crude_node_manager_node_save;
+
+typedef struct crude_node_manager_node_pool
+{
+  char                                                     relative_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ];
+  crude_entity                                            *free_nodes;
+  uint32                                                   free_nodes_max_count;
+} crude_node_manager_node_pool;
+
+typedef enum crude_node_manager_node_load_state
+{
+  CRUDE_NODE_MANAGER_NODE_LOAD_STATE_QUEUED,
+  CRUDE_NODE_MANAGER_NODE_LOAD_STATE_STAGING,
+  CRUDE_NODE_MANAGER_NODE_LOAD_STATE_PREPARING,
+  CRUDE_NODE_MANAGER_NODE_LOAD_STATE_COMMITTING,
+} crude_node_manager_node_load_state;
+
+typedef enum crude_node_manager_staged_command_type
+{
+  CRUDE_NODE_MANAGER_STAGED_COMMAND_TYPE_CREATE_NODE,
+  CRUDE_NODE_MANAGER_STAGED_COMMAND_TYPE_SET_COMPONENTS,
+} crude_node_manager_staged_command_type;
+
+typedef struct crude_node_manager_staged_command
+{
+  crude_node_manager_staged_command_type                   type;
+  uint32                                                   node_index;
+} crude_node_manager_staged_command;
+
+typedef struct crude_node_manager_staged_node
+{
+  char const                                              *name;
+  int32                                                    parent_index;
+  cJSON const                                             *components_json;
+  /* Components of the external node which is not a reference, set after the external ones */
+  cJSON const                                             *override_components_json;
+  crude_node_external                                      external;
+  bool                                                     is_external;
+} crude_node_manager_staged_node;
+
+typedef enum crude_node_manager_staged_asset_type
+{
+  CRUDE_NODE_MANAGER_STAGED_ASSET_TYPE_GLTF,
+  CRUDE_NODE_MANAGER_STAGED_ASSET_TYPE_MESH_SHAPE,
+} crude_node_manager_staged_asset_type;
+
+/* Asset referenced by staged components, added to its manager before components are committed */
+typedef struct crude_node_manager_staged_asset
+{
+  crude_node_manager_staged_asset_type                     type;
+  /* Points to the staged json */
+  char const                                              *relative_filepath;
+  crude_gfx_model_renderer_resources_prepared_gltf         prepared_gltf;
+  crude_physics_prepared_mesh_shape                        prepared_mesh_shape;
+} crude_node_manager_staged_asset;
+
+/**
+ * Staging runs on a worker thread and doesn't touch the world: node files
+ * are read and parsed, external nodes are resolved and the hierarchy is
+ * flattened to commands in crude_node_manager_create_node order.
+ */
+typedef struct crude_node_manager_node_load
+{
+  char                                                     relative_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ];
+  crude_ecs                                               *world;
+  crude_entity                                             parent;
+  crude_node_manager_node_loaded                           loaded_func;
+  void                                                    *loaded_ctx;
+  crude_node_manager_node_load_state                       state;
+  bool                                                     staging_failed;
+  crude_node_manager_node_json                            *staged_jsons;
+  crude_node_manager_staged_node                          *staged_nodes;
+  crude_node_manager_staged_command                       *staged_commands;
+  /* Assets which aren't loaded by managers yet are prepared on a worker thread after staging */
+  crude_node_manager_staged_asset                         *staged_assets;
+  crude_entity                                            *nodes;
+  uint32                                                   added_assets_count;
+  uint32                                                   committed_commands_count;
+} crude_node_manager_node_load;
+
+/* Distinct models and mesh shapes used by a hierarchy, size is reported by the managers */
+typedef struct crude_node_manager_node_assets
+{
+  crude_gfx_model_renderer_resources_handle               *models;
+  crude_physics_mesh_shape_handle                         *mesh_shapes;
+  uint64                                                   size;
+} crude_node_manager_node_assets;
+
 typedef struct crude_node_manager_creation
 {
   crude_physics                                           *physics_manager;
+  crude_task_sheduler                                     *task_sheduler;
   crude_stack_allocator                                   *temporary_allocator;
   crude_heap_allocator                                    *allocator;
   crude_components_serialization_manager                  *components_serialization_manager;
@@ -45,14 +215,31 @@ typedef struct crude_node_manager
   crude_gfx_model_renderer_resources_manager              *model_renderer_resources_manager;
   crude_gfx_scene_renderer                                *scene_renderer;
   crude_components_serialization_manager                  *components_serialization_manager;
+  crude_task_sheduler                                     *task_sheduler;
   crude_stack_allocator                                   *temporary_allocator;
   crude_heap_allocator                                    *allocator;
 
+  /* Loading */
+  crude_node_manager_node_load                           **node_loads;
+  crude_node_manager_node_load                            *staging_node_load;
+  /* Stages the node load or prepares its assets, depending on the load state */
+  crude_task_set_handle                                    staging_task_set_handle;
+  /* Only the staging task allocates from it while staging_node_load is set */
+  crude_heap_allocator                                     staging_allocator;
+  float32                                                  commit_budget_seconds;
+
+  /* Saving */
+  crude_node_manager_node_save                            *node_save;
+  crude_task_set_handle                                    save_task_set_handle;
+
   /* Data */
   crude_node_manager_select_camera                         select_camera_func;
   void                                                    *select_camera_ctx;
   char const                                              *resources_absolute_directory;
   CRUDE_HASHMAPSTR( crude_node_manager_node_json )        *relative_filepath_to_node_json;
+  CRUDE_HASHMAPSTR( crude_node_manager_node_template* )   *relative_filepath_to_node_template;
+  CRUDE_HASHMAPSTR( crude_node_manager_node_pool* )       *relative_filepath_to_node_pool;
+  bool                                                     compiling_node_template;
   crude_string_buffer                                      absolute_filepath_string_buffer;
 } crude_node_manager;
 
@@ -66,13 +253,15 @@ crude_node_manager_initialize
 CRUDE_API void
 crude_node_manager_deinitialize
 (
-  _In_ crude_node_manager                                 *manager
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world
 );
 
 CRUDE_API void
 crude_node_manager_clear
 (
-  _In_ crude_node_manager                                 *manager
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world
 );
 
 CRUDE_API crude_entity
@@ -83,6 +272,154 @@ crude_node_manager_create_node
   _In_ crude_ecs                                          *world
 );
 
+/**
+ * Node is staged on a worker thread and committed to the world in
+ * crude_node_manager_update. Loads are processed one by one, loaded_func
+ * gets an empty entity if node files can't be parsed or the load is
+ * canceled by crude_node_manager_clear.
+ */
+CRUDE_API void
+crude_node_manager_load_node_async
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_opt_ crude_entity const                             *parent,
+  _In_opt_ crude_node_manager_node_loaded                  loaded_func,
+  _In_opt_ void                                           *loaded_ctx
+);
+
+/**
+ * Node files are read again and diffed against the live hierarchy. Only
+ * changed components are set, children are matched by name, so unchanged
+ * entities keep their physics bodies, sounds and model instances.
+ */
+CRUDE_API void
+crude_node_manager_reload_node
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+);
+
+/**
+ * Commits staged nodes until commit_budget_seconds runs out. At least one
+ * command is committed per update, so a node with heavy assets (gltf,
+ * mesh shapes) can still take longer.
+ */
+CRUDE_API void
+crude_node_manager_update
+(
+  _In_ crude_node_manager                                 *manager
+);
+
+CRUDE_API bool
+crude_node_manager_is_loading
+(
+  _In_ crude_node_manager                                 *manager
+);
+
+/**
+ * Template is compiled on first use. All copies of a template node are
+ * created with its components in one bulk operation, then children are
+ * parented and named. Roots stay unnamed.
+ */
+CRUDE_API void
+crude_node_manager_instantiate_nodes
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_opt_ crude_entity const                             *parent,
+  _In_ uint32                                              count,
+  _Out_ crude_entity                                      *nodes
+);
+
+/**
+ * Warm up nodes are created under parent and disabled. Free nodes above
+ * free_nodes_max_count are destroyed on release.
+ */
+CRUDE_API void
+crude_node_manager_configure_node_pool
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_opt_ crude_entity const                             *parent,
+  _In_ uint32                                              warm_up_count,
+  _In_ uint32                                              free_nodes_max_count
+);
+
+/**
+ * Reuses a released node if there is one: the hierarchy is enabled, missing
+ * children are recreated and components that diverged from the template
+ * are set back (gameplay tags added at runtime are left to the caller).
+ */
+CRUDE_API crude_entity
+crude_node_manager_acquire_node
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_opt_ crude_entity const                             *parent
+);
+
+/**
+ * Free nodes stay disabled in the world. Destroy observers match disabled
+ * entities, so free nodes destroyed with their parent release bodies,
+ * sounds and model instances.
+ */
+CRUDE_API void
+crude_node_manager_release_node
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ char const                                          node_realtive_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ],
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+);
+
+/**
+ * Hierarchy is enabled or disabled like pooled nodes: bodies are removed
+ * from the broad phase and sounds are stopped, nothing is destroyed.
+ */
+CRUDE_API void
+crude_node_manager_enable_node
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ bool                                                enable
+);
+
+/**
+ * Destroyed entities are revived with the same ids on restore, so entity
+ * references in components stay valid. Entities and components added after
+ * the snapshot are removed, only diverged components are set back.
+ */
+CRUDE_API crude_node_manager_snapshot*
+crude_node_manager_take_snapshot
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node
+);
+
+CRUDE_API void
+crude_node_manager_restore_snapshot
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_snapshot                        *snapshot
+);
+
+CRUDE_API void
+crude_node_manager_destroy_snapshot
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_node_manager_snapshot                        *snapshot
+);
+
+/* Returns right after capturing the node, the file is written by a worker */
 CRUDE_API void
 crude_node_manager_save_node_to_file
 (
@@ -90,4 +427,26 @@ crude_node_manager_save_node_to_file
   _In_ crude_ecs                                          *world,
   _In_ crude_entity                                        node,
   _In_ char const                                          saved_relative_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ]
-);
\ No newline at end of file
+);
+
+CRUDE_API void
+crude_node_manager_collect_node_assets
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_entity                                        node,
+  _In_ crude_stack_allocator                              *allocator,
+  _Out_ crude_node_manager_node_assets                    *assets
+);
+
+/**
+ * Assets are released from the managers if no node in the world and no
+ * node template uses them anymore. Call it after the hierarchy is destroyed.
+ */
+CRUDE_API void
+crude_node_manager_release_unused_node_assets
+(
+  _In_ crude_node_manager                                 *manager,
+  _In_ crude_ecs                                          *world,
+  _In_ crude_node_manager_node_assets const               *assets
+);
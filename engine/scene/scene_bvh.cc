@@ -0,0 +1,952 @@
+#include <engine/core/profiler.h>
+#include <engine/core/array.h>
+#include <engine/scene/scene_ecs.h>
+
+#include <engine/scene/scene_bvh.h>
+
+typedef bool (*crude_scene_bvh_overlap_func)
+(
+  _In_ void const                                         *shape,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+);
+
+static int32
+crude_scene_bvh_allocate_node_
+(
+  _In_ crude_scene_bvh                                    *bvh
+);
+
+static void
+crude_scene_bvh_free_node_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               node_index
+);
+
+static void
+crude_scene_bvh_insert_leaf_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               leaf
+);
+
+static void
+crude_scene_bvh_remove_leaf_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               leaf
+);
+
+static int32
+crude_scene_bvh_balance_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               node_index
+);
+
+static void
+crude_scene_bvh_refit_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               node_index
+);
+
+static void
+crude_scene_bvh_query_
+(
+  _In_ crude_scene_bvh const                              *bvh,
+  _In_ void const                                         *shape,
+  _In_ crude_scene_bvh_overlap_func                        overlap_func,
+  _In_ uint32                                              category_mask,
+  _Inout_ crude_scene_bvh_query_result                    *result
+);
+
+static void
+crude_scene_bvh_update_tracker_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ uint32                                              tracker_index
+);
+
+static bool
+crude_scene_bvh_overlap_sphere_
+(
+  _In_ void const                                         *shape,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+);
+
+static bool
+crude_scene_bvh_overlap_box_
+(
+  _In_ void const                                         *shape,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+);
+
+static bool
+crude_scene_bvh_overlap_frustum_
+(
+  _In_ void const                                         *shape,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+);
+
+static crude_scene_bvh_aabb
+crude_scene_bvh_aabb_union_
+(
+  _In_ crude_scene_bvh_aabb const                         *a,
+  _In_ crude_scene_bvh_aabb const                         *b
+);
+
+static float32
+crude_scene_bvh_aabb_perimeter_
+(
+  _In_ crude_scene_bvh_aabb const                         *aabb
+);
+
+static bool
+crude_scene_bvh_aabb_contains_
+(
+  _In_ crude_scene_bvh_aabb const                         *outer,
+  _In_ crude_scene_bvh_aabb const                         *inner
+);
+
+static bool
+crude_scene_bvh_node_is_leaf_
+(
+  _In_ crude_scene_bvh_node const                         *node
+);
+
+void
+crude_scene_bvh_initialize
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ crude_scene_bvh_creation const                     *creation
+)
+{
+  bvh->world = creation->world;
+  bvh->allocator = creation->allocator;
+  bvh->aabb_margin = creation->aabb_margin;
+  bvh->root = CRUDE_SCENE_BVH_NULL_NODE;
+  bvh->free_list = CRUDE_SCENE_BVH_NULL_NODE;
+  bvh->proxies_count = 0u;
+  bvh->update_index = 0u;
+  bvh->trackers_count = 0u;
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( bvh->nodes, CRUDE_SCENE_BVH_NODES_INITIAL_CAPACITY, crude_heap_allocator_pack( bvh->allocator ) );
+}
+
+void
+crude_scene_bvh_deinitialize
+(
+  _In_ crude_scene_bvh                                    *bvh
+)
+{
+  for ( uint32 i = 0; i < bvh->trackers_count; ++i )
+  {
+    CRUDE_HASHMAP_DEINITIALIZE( bvh->trackers[ i ].entity_to_proxy );
+  }
+  CRUDE_ARRAY_DEINITIALIZE( bvh->nodes );
+}
+
+void
+crude_scene_bvh_clear
+(
+  _In_ crude_scene_bvh                                    *bvh
+)
+{
+  for ( uint32 i = 0; i < bvh->trackers_count; ++i )
+  {
+    CRUDE_HASHMAP_DEINITIALIZE( bvh->trackers[ i ].entity_to_proxy );
+    CRUDE_HASHMAP_INITIALIZE( bvh->trackers[ i ].entity_to_proxy, crude_heap_allocator_pack( bvh->allocator ) );
+  }
+  CRUDE_ARRAY_SET_LENGTH( bvh->nodes, 0u );
+  bvh->root = CRUDE_SCENE_BVH_NULL_NODE;
+  bvh->free_list = CRUDE_SCENE_BVH_NULL_NODE;
+  bvh->proxies_count = 0u;
+}
+
+void
+crude_scene_bvh_track_component
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ ecs_id_t                                            component_id,
+  _In_ uint32                                              category,
+  _In_ crude_scene_bvh_radius_func                         radius_func,
+  _In_opt_ void                                           *radius_func_ctx
+)
+{
+  crude_scene_bvh_tracker                                 *tracker;
+
+  CRUDE_ASSERT( bvh->trackers_count < CRUDE_SCENE_BVH_TRACKERS_MAX );
+
+  tracker = &bvh->trackers[ bvh->trackers_count++ ];
+  tracker->component_id = component_id;
+  tracker->category = category;
+  tracker->radius_func = radius_func;
+  tracker->radius_func_ctx = radius_func_ctx;
+  CRUDE_HASHMAP_INITIALIZE( tracker->entity_to_proxy, crude_heap_allocator_pack( bvh->allocator ) );
+}
+
+void
+crude_scene_bvh_update
+(
+  _In_ crude_scene_bvh                                    *bvh
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_scene_bvh_update" );
+
+  ++bvh->update_index;
+
+  for ( uint32 i = 0; i < bvh->trackers_count; ++i )
+  {
+    crude_scene_bvh_update_tracker_( bvh, i );
+  }
+
+  /* Tracked proxies which weren't touched belong to destroyed entities or removed components */
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( bvh->nodes ); ++i )
+  {
+    crude_scene_bvh_node                                  *node;
+
+    node = &bvh->nodes[ i ];
+    if ( node->height != 0 || node->tracker_index == -1 || node->update_index == bvh->update_index )
+    {
+      continue;
+    }
+
+    CRUDE_HASHMAP_REMOVE( bvh->trackers[ node->tracker_index ].entity_to_proxy, node->entity );
+    crude_scene_bvh_remove( bvh, i );
+  }
+
+  CRUDE_PROFILER_ZONE_END;
+}
+
+int32
+crude_scene_bvh_insert
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ crude_entity                                        entity,
+  _In_ uint32                                              category,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+)
+{
+  crude_scene_bvh_node                                    *node;
+  int32                                                    proxy;
+
+  proxy = crude_scene_bvh_allocate_node_( bvh );
+
+  node = &bvh->nodes[ proxy ];
+  node->aabb.min = XMFLOAT3{ aabb->min.x - bvh->aabb_margin, aabb->min.y - bvh->aabb_margin, aabb->min.z - bvh->aabb_margin };
+  node->aabb.max = XMFLOAT3{ aabb->max.x + bvh->aabb_margin, aabb->max.y + bvh->aabb_margin, aabb->max.z + bvh->aabb_margin };
+  node->entity = entity;
+  node->categories = category;
+  node->height = 0;
+  node->tracker_index = -1;
+  node->update_index = bvh->update_index;
+
+  crude_scene_bvh_insert_leaf_( bvh, proxy );
+  ++bvh->proxies_count;
+  return proxy;
+}
+
+void
+crude_scene_bvh_remove
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               proxy
+)
+{
+  CRUDE_ASSERT( crude_scene_bvh_node_is_leaf_( &bvh->nodes[ proxy ] ) );
+
+  crude_scene_bvh_remove_leaf_( bvh, proxy );
+  crude_scene_bvh_free_node_( bvh, proxy );
+  --bvh->proxies_count;
+}
+
+bool
+crude_scene_bvh_move
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               proxy,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+)
+{
+  crude_scene_bvh_node                                    *node;
+
+  CRUDE_ASSERT( crude_scene_bvh_node_is_leaf_( &bvh->nodes[ proxy ] ) );
+
+  node = &bvh->nodes[ proxy ];
+  if ( crude_scene_bvh_aabb_contains_( &node->aabb, aabb ) )
+  {
+    return false;
+  }
+
+  crude_scene_bvh_remove_leaf_( bvh, proxy );
+
+  node = &bvh->nodes[ proxy ];
+  node->aabb.min = XMFLOAT3{ aabb->min.x - bvh->aabb_margin, aabb->min.y - bvh->aabb_margin, aabb->min.z - bvh->aabb_margin };
+  node->aabb.max = XMFLOAT3{ aabb->max.x + bvh->aabb_margin, aabb->max.y + bvh->aabb_margin, aabb->max.z + bvh->aabb_margin };
+
+  crude_scene_bvh_insert_leaf_( bvh, proxy );
+  return true;
+}
+
+void
+crude_scene_bvh_query_spheres
+(
+  _In_ crude_scene_bvh const                              *bvh,
+  _In_ XMFLOAT4 const                                     *spheres,
+  _In_ uint32                                              spheres_count,
+  _In_ uint32                                              category_mask,
+  _Inout_ crude_scene_bvh_query_result                    *result
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_scene_bvh_query_spheres" );
+  result->entities_count = 0u;
+  result->overflow = false;
+  for ( uint32 i = 0; i < spheres_count; ++i )
+  {
+    uint32 offset = result->entities_count;
+    crude_scene_bvh_query_( bvh, &spheres[ i ], crude_scene_bvh_overlap_sphere_, category_mask, result );
+    if ( result->ranges )
+    {
+      result->ranges[ i ].offset = offset;
+      result->ranges[ i ].count = result->entities_count - offset;
+    }
+  }
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_scene_bvh_query_boxes
+(
+  _In_ crude_scene_bvh const                              *bvh,
+  _In_ crude_scene_bvh_aabb const                         *boxes,
+  _In_ uint32                                              boxes_count,
+  _In_ uint32                                              category_mask,
+  _Inout_ crude_scene_bvh_query_result                    *result
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_scene_bvh_query_boxes" );
+  result->entities_count = 0u;
+  result->overflow = false;
+  for ( uint32 i = 0; i < boxes_count; ++i )
+  {
+    uint32 offset = result->entities_count;
+    crude_scene_bvh_query_( bvh, &boxes[ i ], crude_scene_bvh_overlap_box_, category_mask, result );
+    if ( result->ranges )
+    {
+      result->ranges[ i ].offset = offset;
+      result->ranges[ i ].count = result->entities_count - offset;
+    }
+  }
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_scene_bvh_query_frustums
+(
+  _In_ crude_scene_bvh const                              *bvh,
+  _In_ crude_scene_bvh_frustum const                      *frustums,
+  _In_ uint32                                              frustums_count,
+  _In_ uint32                                              category_mask,
+  _Inout_ crude_scene_bvh_query_result                    *result
+)
+{
+  CRUDE_PROFILER_ZONE_NAME( "crude_scene_bvh_query_frustums" );
+  result->entities_count = 0u;
+  result->overflow = false;
+  for ( uint32 i = 0; i < frustums_count; ++i )
+  {
+    uint32 offset = result->entities_count;
+    crude_scene_bvh_query_( bvh, &frustums[ i ], crude_scene_bvh_overlap_frustum_, category_mask, result );
+    if ( result->ranges )
+    {
+      result->ranges[ i ].offset = offset;
+      result->ranges[ i ].count = result->entities_count - offset;
+    }
+  }
+  CRUDE_PROFILER_ZONE_END;
+}
+
+crude_scene_bvh_query_result
+crude_scene_bvh_query_result_empty
+(
+  _In_ crude_entity                                       *entities,
+  _In_ uint32                                              entities_capacity,
+  _In_opt_ crude_scene_bvh_query_range                    *ranges
+)
+{
+  crude_scene_bvh_query_result                             result;
+
+  result = CRUDE_COMPOUNT_EMPTY( crude_scene_bvh_query_result );
+  result.entities = entities;
+  result.entities_capacity = entities_capacity;
+  result.ranges = ranges;
+  return result;
+}
+
+crude_scene_bvh_frustum
+crude_scene_bvh_frustum_from_world_to_clip
+(
+  _In_ XMMATRIX                                            world_to_clip
+)
+{
+  crude_scene_bvh_frustum                                  frustum;
+  XMMATRIX                                                 world_to_clip_transposed;
+
+  world_to_clip_transposed = XMMatrixTranspose( world_to_clip );
+  XMStoreFloat4( &frustum.planes[ 0 ], XMPlaneNormalize( XMVectorAdd( world_to_clip_transposed.r[ 3 ], world_to_clip_transposed.r[ 0 ] ) ) );
+  XMStoreFloat4( &frustum.planes[ 1 ], XMPlaneNormalize( XMVectorSubtract( world_to_clip_transposed.r[ 3 ], world_to_clip_transposed.r[ 0 ] ) ) );
+  XMStoreFloat4( &frustum.planes[ 2 ], XMPlaneNormalize( XMVectorAdd( world_to_clip_transposed.r[ 3 ], world_to_clip_transposed.r[ 1 ] ) ) );
+  XMStoreFloat4( &frustum.planes[ 3 ], XMPlaneNormalize( XMVectorSubtract( world_to_clip_transposed.r[ 3 ], world_to_clip_transposed.r[ 1 ] ) ) );
+  XMStoreFloat4( &frustum.planes[ 4 ], XMPlaneNormalize( XMVectorAdd( world_to_clip_transposed.r[ 3 ], world_to_clip_transposed.r[ 2 ] ) ) );
+  XMStoreFloat4( &frustum.planes[ 5 ], XMPlaneNormalize( XMVectorSubtract( world_to_clip_transposed.r[ 3 ], world_to_clip_transposed.r[ 2 ] ) ) );
+  return frustum;
+}
+
+crude_scene_bvh_aabb
+crude_scene_bvh_aabb_from_sphere
+(
+  _In_ XMVECTOR                                            center,
+  _In_ float32                                             radius
+)
+{
+  crude_scene_bvh_aabb                                     aabb;
+
+  XMStoreFloat3( &aabb.min, XMVectorSubtract( center, XMVectorReplicate( radius ) ) );
+  XMStoreFloat3( &aabb.max, XMVectorAdd( center, XMVectorReplicate( radius ) ) );
+  return aabb;
+}
+
+int32
+crude_scene_bvh_allocate_node_
+(
+  _In_ crude_scene_bvh                                    *bvh
+)
+{
+  crude_scene_bvh_node                                    *node;
+  int32                                                    node_index;
+
+  if ( bvh->free_list == CRUDE_SCENE_BVH_NULL_NODE )
+  {
+    CRUDE_ARRAY_PUSH( bvh->nodes, CRUDE_COMPOUNT_EMPTY( crude_scene_bvh_node ) );
+    node_index = CRUDE_ARRAY_LENGTH( bvh->nodes ) - 1;
+  }
+  else
+  {
+    node_index = bvh->free_list;
+    bvh->free_list = bvh->nodes[ node_index ].parent;
+  }
+
+  node = &bvh->nodes[ node_index ];
+  node->parent = CRUDE_SCENE_BVH_NULL_NODE;
+  node->child1 = CRUDE_SCENE_BVH_NULL_NODE;
+  node->child2 = CRUDE_SCENE_BVH_NULL_NODE;
+  node->height = 0;
+  node->categories = 0u;
+  node->entity = CRUDE_COMPOUNT_EMPTY( crude_entity );
+  node->tracker_index = -1;
+  return node_index;
+}
+
+void
+crude_scene_bvh_free_node_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               node_index
+)
+{
+  bvh->nodes[ node_index ].parent = bvh->free_list;
+  bvh->nodes[ node_index ].height = -1;
+  bvh->free_list = node_index;
+}
+
+void
+crude_scene_bvh_insert_leaf_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               leaf
+)
+{
+  crude_scene_bvh_aabb                                     leaf_aabb;
+  int32                                                    sibling, old_parent, new_parent;
+
+  if ( bvh->root == CRUDE_SCENE_BVH_NULL_NODE )
+  {
+    bvh->root = leaf;
+    bvh->nodes[ leaf ].parent = CRUDE_SCENE_BVH_NULL_NODE;
+    return;
+  }
+
+  /* Find the best sibling by surface area heuristic */
+  leaf_aabb = bvh->nodes[ leaf ].aabb;
+  sibling = bvh->root;
+  while ( !crude_scene_bvh_node_is_leaf_( &bvh->nodes[ sibling ] ) )
+  {
+    crude_scene_bvh_node const                            *node;
+    crude_scene_bvh_aabb                                   combined_aabb;
+    float32                                                area, combined_area, cost, inheritance_cost, cost1, cost2;
+
+    node = &bvh->nodes[ sibling ];
+    area = crude_scene_bvh_aabb_perimeter_( &node->aabb );
+    combined_aabb = crude_scene_bvh_aabb_union_( &node->aabb, &leaf_aabb );
+    combined_area = crude_scene_bvh_aabb_perimeter_( &combined_aabb );
+
+    cost = 2.f * combined_area;
+    inheritance_cost = 2.f * ( combined_area - area );
+
+    for ( uint32 i = 0; i < 2; ++i )
+    {
+      crude_scene_bvh_node const                          *child;
+      crude_scene_bvh_aabb                                 child_aabb;
+      float32                                              child_cost;
+
+      child = &bvh->nodes[ i == 0 ? node->child1 : node->child2 ];
+      child_aabb = crude_scene_bvh_aabb_union_( &leaf_aabb, &child->aabb );
+      child_cost = crude_scene_bvh_aabb_perimeter_( &child_aabb ) + inheritance_cost;
+      if ( !crude_scene_bvh_node_is_leaf_( child ) )
+      {
+        child_cost -= crude_scene_bvh_aabb_perimeter_( &child->aabb );
+      }
+
+      if ( i == 0 )
+      {
+        cost1 = child_cost;
+      }
+      else
+      {
+        cost2 = child_cost;
+      }
+    }
+
+    if ( cost < cost1 && cost < cost2 )
+    {
+      break;
+    }
+
+    sibling = ( cost1 < cost2 ) ? node->child1 : node->child2;
+  }
+
+  old_parent = bvh->nodes[ sibling ].parent;
+  new_parent = crude_scene_bvh_allocate_node_( bvh );
+  bvh->nodes[ new_parent ].parent = old_parent;
+  bvh->nodes[ new_parent ].aabb = crude_scene_bvh_aabb_union_( &leaf_aabb, &bvh->nodes[ sibling ].aabb );
+  bvh->nodes[ new_parent ].categories = bvh->nodes[ leaf ].categories | bvh->nodes[ sibling ].categories;
+  bvh->nodes[ new_parent ].height = bvh->nodes[ sibling ].height + 1;
+  bvh->nodes[ new_parent ].child1 = sibling;
+  bvh->nodes[ new_parent ].child2 = leaf;
+  bvh->nodes[ sibling ].parent = new_parent;
+  bvh->nodes[ leaf ].parent = new_parent;
+
+  if ( old_parent == CRUDE_SCENE_BVH_NULL_NODE )
+  {
+    bvh->root = new_parent;
+  }
+  else if ( bvh->nodes[ old_parent ].child1 == sibling )
+  {
+    bvh->nodes[ old_parent ].child1 = new_parent;
+  }
+  else
+  {
+    bvh->nodes[ old_parent ].child2 = new_parent;
+  }
+
+  crude_scene_bvh_refit_( bvh, bvh->nodes[ leaf ].parent );
+}
+
+void
+crude_scene_bvh_remove_leaf_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               leaf
+)
+{
+  int32                                                    parent, grand_parent, sibling;
+
+  if ( leaf == bvh->root )
+  {
+    bvh->root = CRUDE_SCENE_BVH_NULL_NODE;
+    return;
+  }
+
+  parent = bvh->nodes[ leaf ].parent;
+  grand_parent = bvh->nodes[ parent ].parent;
+  sibling = ( bvh->nodes[ parent ].child1 == leaf ) ? bvh->nodes[ parent ].child2 : bvh->nodes[ parent ].child1;
+
+  crude_scene_bvh_free_node_( bvh, parent );
+
+  if ( grand_parent == CRUDE_SCENE_BVH_NULL_NODE )
+  {
+    bvh->root = sibling;
+    bvh->nodes[ sibling ].parent = CRUDE_SCENE_BVH_NULL_NODE;
+    return;
+  }
+
+  if ( bvh->nodes[ grand_parent ].child1 == parent )
+  {
+    bvh->nodes[ grand_parent ].child1 = sibling;
+  }
+  else
+  {
+    bvh->nodes[ grand_parent ].child2 = sibling;
+  }
+  bvh->nodes[ sibling ].parent = grand_parent;
+
+  crude_scene_bvh_refit_( bvh, grand_parent );
+}
+
+void
+crude_scene_bvh_refit_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               node_index
+)
+{
+  while ( node_index != CRUDE_SCENE_BVH_NULL_NODE )
+  {
+    crude_scene_bvh_node                                  *node, *child1, *child2;
+
+    node_index = crude_scene_bvh_balance_( bvh, node_index );
+
+    node = &bvh->nodes[ node_index ];
+    child1 = &bvh->nodes[ node->child1 ];
+    child2 = &bvh->nodes[ node->child2 ];
+    node->height = 1 + ( ( child1->height > child2->height ) ? child1->height : child2->height );
+    node->aabb = crude_scene_bvh_aabb_union_( &child1->aabb, &child2->aabb );
+    node->categories = child1->categories | child2->categories;
+
+    node_index = node->parent;
+  }
+}
+
+/* Rotates the tree when children heights differ by more than one, returns the new subtree root */
+int32
+crude_scene_bvh_balance_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               a_index
+)
+{
+  crude_scene_bvh_node                                    *a, *b, *c;
+  int32                                                    b_index, c_index, balance;
+
+  a = &bvh->nodes[ a_index ];
+  if ( crude_scene_bvh_node_is_leaf_( a ) || a->height < 2 )
+  {
+    return a_index;
+  }
+
+  b_index = a->child1;
+  c_index = a->child2;
+  b = &bvh->nodes[ b_index ];
+  c = &bvh->nodes[ c_index ];
+
+  balance = c->height - b->height;
+
+  /* Rotate c up, or b up mirrored */
+  if ( balance > 1 || balance < -1 )
+  {
+    crude_scene_bvh_node                                  *up, *down, *f, *g;
+    int32                                                  up_index, down_index, f_index, g_index;
+
+    up_index = ( balance > 1 ) ? c_index : b_index;
+    down_index = ( balance > 1 ) ? b_index : c_index;
+    up = &bvh->nodes[ up_index ];
+    down = &bvh->nodes[ down_index ];
+    f_index = up->child1;
+    g_index = up->child2;
+    f = &bvh->nodes[ f_index ];
+    g = &bvh->nodes[ g_index ];
+
+    up->child1 = a_index;
+    up->parent = a->parent;
+    a->parent = up_index;
+
+    if ( up->parent == CRUDE_SCENE_BVH_NULL_NODE )
+    {
+      bvh->root = up_index;
+    }
+    else if ( bvh->nodes[ up->parent ].child1 == a_index )
+    {
+      bvh->nodes[ up->parent ].child1 = up_index;
+    }
+    else
+    {
+      bvh->nodes[ up->parent ].child2 = up_index;
+    }
+
+    /* The taller grandchild stays under up, the other one replaces up under a */
+    if ( f->height > g->height )
+    {
+      up->child2 = f_index;
+      if ( balance > 1 )
+      {
+        a->child2 = g_index;
+      }
+      else
+      {
+        a->child1 = g_index;
+      }
+      g->parent = a_index;
+      a->aabb = crude_scene_bvh_aabb_union_( &down->aabb, &g->aabb );
+      a->categories = down->categories | g->categories;
+      up->aabb = crude_scene_bvh_aabb_union_( &a->aabb, &f->aabb );
+      up->categories = a->categories | f->categories;
+      a->height = 1 + ( ( down->height > g->height ) ? down->height : g->height );
+      up->height = 1 + ( ( a->height > f->height ) ? a->height : f->height );
+    }
+    else
+    {
+      up->child2 = g_index;
+      if ( balance > 1 )
+      {
+        a->child2 = f_index;
+      }
+      else
+      {
+        a->child1 = f_index;
+      }
+      f->parent = a_index;
+      a->aabb = crude_scene_bvh_aabb_union_( &down->aabb, &f->aabb );
+      a->categories = down->categories | f->categories;
+      up->aabb = crude_scene_bvh_aabb_union_( &a->aabb, &g->aabb );
+      up->categories = a->categories | g->categories;
+      a->height = 1 + ( ( down->height > f->height ) ? down->height : f->height );
+      up->height = 1 + ( ( a->height > g->height ) ? a->height : g->height );
+    }
+
+    return up_index;
+  }
+
+  return a_index;
+}
+
+void
+crude_scene_bvh_query_
+(
+  _In_ crude_scene_bvh const                              *bvh,
+  _In_ void const                                         *shape,
+  _In_ crude_scene_bvh_overlap_func                        overlap_func,
+  _In_ uint32                                              category_mask,
+  _Inout_ crude_scene_bvh_query_result                    *result
+)
+{
+  int32                                                    stack[ CRUDE_SCENE_BVH_QUERY_STACK_SIZE ];
+  uint32                                                   stack_count;
+
+  if ( bvh->root == CRUDE_SCENE_BVH_NULL_NODE )
+  {
+    return;
+  }
+
+  stack_count = 0u;
+  stack[ stack_count++ ] = bvh->root;
+
+  while ( stack_count )
+  {
+    crude_scene_bvh_node const                            *node;
+
+    node = &bvh->nodes[ stack[ --stack_count ] ];
+
+    if ( !( node->categories & category_mask ) || !overlap_func( shape, &node->aabb ) )
+    {
+      continue;
+    }
+
+    if ( crude_scene_bvh_node_is_leaf_( node ) )
+    {
+      if ( result->entities_count < result->entities_capacity )
+      {
+        result->entities[ result->entities_count++ ] = node->entity;
+      }
+      else
+      {
+        result->overflow = true;
+      }
+      continue;
+    }
+
+    /* Stack never holds more than height + 1 nodes, so overflow means a corrupted tree */
+    CRUDE_ASSERT( stack_count + 2 <= CRUDE_SCENE_BVH_QUERY_STACK_SIZE );
+    stack[ stack_count++ ] = node->child1;
+    stack[ stack_count++ ] = node->child2;
+  }
+}
+
+void
+crude_scene_bvh_update_tracker_
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ uint32                                              tracker_index
+)
+{
+  crude_scene_bvh_tracker                                 *tracker;
+  ecs_type_info_t const                                   *type_info;
+  ecs_iter_t                                               it;
+
+  tracker = &bvh->trackers[ tracker_index ];
+  type_info = ecs_get_type_info( bvh->world, tracker->component_id );
+
+  it = ecs_each_id( bvh->world, tracker->component_id );
+  while ( ecs_each_next( &it ) )
+  {
+    uint8 const                                           *components;
+
+    /* Template and pooled nodes are not in the scene */
+    if ( ecs_table_has_flags( it.table, EcsTableIsPrefab | EcsTableIsDisabled ) )
+    {
+      continue;
+    }
+
+    components = CRUDE_REINTERPRET_CAST( uint8 const*, ecs_field_w_size( &it, type_info->size, 0 ) );
+
+    for ( uint32 i = 0; i < it.count; ++i )
+    {
+      crude_transform const                               *transform;
+      crude_scene_bvh_aabb                                 aabb;
+      crude_entity                                         entity;
+      XMFLOAT4                                             sphere;
+      XMVECTOR                                             center;
+      float32                                              radius;
+      int32                                                proxy;
+      int64                                                proxy_index;
+
+      entity = crude_entity_from_iterator( &it, i );
+      transform = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( bvh->world, entity, crude_transform );
+      if ( !transform )
+      {
+        continue;
+      }
+
+      center = crude_transform_node_to_world( bvh->world, entity, transform ).r[ 3 ];
+      radius = tracker->radius_func( tracker->radius_func_ctx, components + i * type_info->size );
+      XMStoreFloat4( &sphere, XMVectorSetW( center, radius ) );
+
+      proxy_index = CRUDE_HASHMAP_GET_INDEX( tracker->entity_to_proxy, entity );
+      if ( proxy_index == -1 )
+      {
+        aabb = crude_scene_bvh_aabb_from_sphere( center, radius );
+        proxy = crude_scene_bvh_insert( bvh, entity, tracker->category, &aabb );
+        bvh->nodes[ proxy ].tracker_index = tracker_index;
+        bvh->nodes[ proxy ].tracked_sphere = sphere;
+        CRUDE_HASHMAP_SET( tracker->entity_to_proxy, entity, proxy );
+      }
+      else
+      {
+        proxy = tracker->entity_to_proxy[ proxy_index ].value;
+        if ( !XMVector4NearEqual( XMLoadFloat4( &sphere ), XMLoadFloat4( &bvh->nodes[ proxy ].tracked_sphere ), XMVectorReplicate( CRUDE_SCENE_BVH_REFIT_EPSILON ) ) )
+        {
+          aabb = crude_scene_bvh_aabb_from_sphere( center, radius );
+          crude_scene_bvh_move( bvh, proxy, &aabb );
+          bvh->nodes[ proxy ].tracked_sphere = sphere;
+        }
+      }
+
+      bvh->nodes[ proxy ].update_index = bvh->update_index;
+    }
+  }
+}
+
+bool
+crude_scene_bvh_overlap_sphere_
+(
+  _In_ void const                                         *shape,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+)
+{
+  XMFLOAT4 const                                          *sphere;
+  XMVECTOR                                                 center, closest_point;
+
+  sphere = CRUDE_CAST( XMFLOAT4 const*, shape );
+  center = XMVectorSet( sphere->x, sphere->y, sphere->z, 0.f );
+  closest_point = XMVectorClamp( center, XMLoadFloat3( &aabb->min ), XMLoadFloat3( &aabb->max ) );
+  return XMVectorGetX( XMVector3LengthSq( XMVectorSubtract( center, closest_point ) ) ) <= sphere->w * sphere->w;
+}
+
+bool
+crude_scene_bvh_overlap_box_
+(
+  _In_ void const                                         *shape,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+)
+{
+  crude_scene_bvh_aabb const                              *box;
+
+  box = CRUDE_CAST( crude_scene_bvh_aabb const*, shape );
+  return XMVector3LessOrEqual( XMLoadFloat3( &box->min ), XMLoadFloat3( &aabb->max ) ) && XMVector3LessOrEqual( XMLoadFloat3( &aabb->min ), XMLoadFloat3( &box->max ) );
+}
+
+bool
+crude_scene_bvh_overlap_frustum_
+(
+  _In_ void const                                         *shape,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+)
+{
+  crude_scene_bvh_frustum const                           *frustum;
+  XMVECTOR                                                 center, extent;
+
+  frustum = CRUDE_CAST( crude_scene_bvh_frustum const*, shape );
+  center = XMVectorScale( XMVectorAdd( XMLoadFloat3( &aabb->min ), XMLoadFloat3( &aabb->max ) ), 0.5f );
+  extent = XMVectorScale( XMVectorSubtract( XMLoadFloat3( &aabb->max ), XMLoadFloat3( &aabb->min ) ), 0.5f );
+
+  for ( uint32 i = 0; i < 6; ++i )
+  {
+    XMVECTOR                                               plane;
+    float32                                                distance, radius;
+
+    plane = XMLoadFloat4( &frustum->planes[ i ] );
+    distance = XMVectorGetX( XMPlaneDotCoord( plane, center ) );
+    radius = XMVectorGetX( XMVector3Dot( extent, XMVectorAbs( plane ) ) );
+    if ( distance < -radius )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+crude_scene_bvh_aabb
+crude_scene_bvh_aabb_union_
+(
+  _In_ crude_scene_bvh_aabb const                         *a,
+  _In_ crude_scene_bvh_aabb const                         *b
+)
+{
+  crude_scene_bvh_aabb                                     aabb;
+
+  XMStoreFloat3( &aabb.min, XMVectorMin( XMLoadFloat3( &a->min ), XMLoadFloat3( &b->min ) ) );
+  XMStoreFloat3( &aabb.max, XMVectorMax( XMLoadFloat3( &a->max ), XMLoadFloat3( &b->max ) ) );
+  return aabb;
+}
+
+float32
+crude_scene_bvh_aabb_perimeter_
+(
+  _In_ crude_scene_bvh_aabb const                         *aabb
+)
+{
+  float32                                                  x, y, z;
+
+  x = aabb->max.x - aabb->min.x;
+  y = aabb->max.y - aabb->min.y;
+  z = aabb->max.z - aabb->min.z;
+  return 2.f * ( x * y + y * z + z * x );
+}
+
+bool
+crude_scene_bvh_aabb_contains_
+(
+  _In_ crude_scene_bvh_aabb const                         *outer,
+  _In_ crude_scene_bvh_aabb const                         *inner
+)
+{
+  return XMVector3LessOrEqual( XMLoadFloat3( &outer->min ), XMLoadFloat3( &inner->min ) ) && XMVector3LessOrEqual( XMLoadFloat3( &inner->max ), XMLoadFloat3( &outer->max ) );
+}
+
+bool
+crude_scene_bvh_node_is_leaf_
+(
+  _In_ crude_scene_bvh_node const                         *node
+)
+{
+  return node->child1 == CRUDE_SCENE_BVH_NULL_NODE;
+}
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <engine/core/ecs.h>
+#include <engine/core/math.h>
+#include <engine/core/hashmap.h>
+#include <engine/scene/scene_config.h>
+
+#define CRUDE_SCENE_BVH_NULL_NODE                                  ( -1 )
+
+typedef enum crude_scene_bvh_category
+{
+  CRUDE_SCENE_BVH_CATEGORY_LIGHT = 1 << 0,
+  CRUDE_SCENE_BVH_CATEGORY_AUDIO_EMITTER = 1 << 1,
+  CRUDE_SCENE_BVH_CATEGORY_GLTF = 1 << 2,
+  CRUDE_SCENE_BVH_CATEGORY_AGENT = 1 << 3,
+  CRUDE_SCENE_BVH_CATEGORY_ALL = 0xFFFFFFFF
+} crude_scene_bvh_category;
+
+/* Bounding radius of the tracked component around the node world position */
+typedef float32 (*crude_scene_bvh_radius_func)
+(
+  _In_opt_ void                                           *ctx,
+  _In_ void const                                         *component
+);
+
+typedef struct crude_scene_bvh_aabb
+{
+  XMFLOAT3                                                 min;
+  XMFLOAT3                                                 max;
+} crude_scene_bvh_aabb;
+
+/* Planes point inside, same layout as camera frustum_planes_culling */
+typedef struct crude_scene_bvh_frustum
+{
+  XMFLOAT4                                                 planes[ 6 ];
+} crude_scene_bvh_frustum;
+
+/**
+ * Leaves store fat aabbs, so small movements only update the stored
+ * bounds and the leaf is reinserted once it leaves the fat one. Internal
+ * nodes keep the union of children categories to prune category queries.
+ */
+typedef struct crude_scene_bvh_node
+{
+  crude_scene_bvh_aabb                                     aabb;
+  crude_entity                                             entity;
+  uint32                                                   categories;
+  /* Next free node when the node is unused */
+  int32                                                    parent;
+  int32                                                    child1;
+  int32                                                    child2;
+  int32                                                    height;
+  /* -1 for proxies inserted manually */
+  int32                                                    tracker_index;
+  uint32                                                   update_index;
+  /* World position and radius of the last refit, tracked proxies only */
+  XMFLOAT4                                                 tracked_sphere;
+} crude_scene_bvh_node;
+
+/* Entities whose world position and radius didn't change since the last refit don't touch the tree */
+typedef struct crude_scene_bvh_tracker
+{
+  ecs_id_t                                                 component_id;
+  uint32                                                   category;
+  crude_scene_bvh_radius_func                              radius_func;
+  void                                                    *radius_func_ctx;
+  CRUDE_HASHMAP( int32 )                                  *entity_to_proxy;
+} crude_scene_bvh_tracker;
+
+typedef struct crude_scene_bvh_query_range
+{
+  uint32                                                   offset;
+  uint32                                                   count;
+} crude_scene_bvh_query_range;
+
+/**
+ * Caller owned result buffer, queries never allocate. Batched queries fill
+ * ranges[ query_index ], overflow is set when entities_capacity was too small
+ * and the rest of the hits are dropped.
+ */
+typedef struct crude_scene_bvh_query_result
+{
+  crude_entity                                            *entities;
+  uint32                                                   entities_capacity;
+  uint32                                                   entities_count;
+  crude_scene_bvh_query_range                             *ranges;
+  bool                                                     overflow;
+} crude_scene_bvh_query_result;
+
+typedef struct crude_scene_bvh_creation
+{
+  crude_ecs                                               *world;
+  crude_heap_allocator                                    *allocator;
+  float32                                                  aabb_margin;
+} crude_scene_bvh_creation;
+
+/**
+ * Dynamic aabb tree of scene entities. Components registered with
+ * crude_scene_bvh_track_component are synced in crude_scene_bvh_update,
+ * other proxies could be managed manually.
+ */
+typedef struct crude_scene_bvh
+{
+  /* Context */
+  crude_ecs                                               *world;
+  crude_heap_allocator                                    *allocator;
+
+  /* Options */
+  float32                                                  aabb_margin;
+
+  /* Data */
+  crude_scene_bvh_node                                    *nodes;
+  int32                                                    root;
+  int32                                                    free_list;
+  uint32                                                   proxies_count;
+  uint32                                                   update_index;
+  crude_scene_bvh_tracker                                  trackers[ CRUDE_SCENE_BVH_TRACKERS_MAX ];
+  uint32                                                   trackers_count;
+} crude_scene_bvh;
+
+CRUDE_API void
+crude_scene_bvh_initialize
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ crude_scene_bvh_creation const                     *creation
+);
+
+CRUDE_API void
+crude_scene_bvh_deinitialize
+(
+  _In_ crude_scene_bvh                                    *bvh
+);
+
+CRUDE_API void
+crude_scene_bvh_clear
+(
+  _In_ crude_scene_bvh                                    *bvh
+);
+
+CRUDE_API void
+crude_scene_bvh_track_component
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ ecs_id_t                                            component_id,
+  _In_ uint32                                              category,
+  _In_ crude_scene_bvh_radius_func                         radius_func,
+  _In_opt_ void                                           *radius_func_ctx
+);
+
+/* Refits tracked entities, inserts new ones and removes destroyed ones */
+CRUDE_API void
+crude_scene_bvh_update
+(
+  _In_ crude_scene_bvh                                    *bvh
+);
+
+CRUDE_API int32
+crude_scene_bvh_insert
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ crude_entity                                        entity,
+  _In_ uint32                                              category,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+);
+
+CRUDE_API void
+crude_scene_bvh_remove
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               proxy
+);
+
+/* Returns true if the proxy was reinserted */
+CRUDE_API bool
+crude_scene_bvh_move
+(
+  _In_ crude_scene_bvh                                    *bvh,
+  _In_ int32                                               proxy,
+  _In_ crude_scene_bvh_aabb const                         *aabb
+);
+
+CRUDE_API void
+crude_scene_bvh_query_spheres
+(
+  _In_ crude_scene_bvh const                              *bvh,
+  _In_ XMFLOAT4 const                                     *spheres,
+  _In_ uint32                                              spheres_count,
+  _In_ uint32                                              category_mask,
+  _Inout_ crude_scene_bvh_query_result                    *result
+);
+
+CRUDE_API void
+crude_scene_bvh_query_boxes
+(
+  _In_ crude_scene_bvh const                              *bvh,
+  _In_ crude_scene_bvh_aabb const                         *boxes,
+  _In_ uint32                                              boxes_count,
+  _In_ uint32                                              category_mask,
+  _Inout_ crude_scene_bvh_query_result                    *result
+);
+
+CRUDE_API void
+crude_scene_bvh_query_frustums
+(
+  _In_ crude_scene_bvh const                              *bvh,
+  _In_ crude_scene_bvh_frustum const                      *frustums,
+  _In_ uint32                                              frustums_count,
+  _In_ uint32                                              category_mask,
+  _Inout_ crude_scene_bvh_query_result                    *result
+);
+
+CRUDE_API crude_scene_bvh_query_result
+crude_scene_bvh_query_result_empty
+(
+  _In_ crude_entity                                       *entities,
+  _In_ uint32                                              entities_capacity,
+  _In_opt_ crude_scene_bvh_query_range                    *ranges
+);
+
+CRUDE_API crude_scene_bvh_frustum
+crude_scene_bvh_frustum_from_world_to_clip
+(
+  _In_ XMMATRIX                                            world_to_clip
+);
+
+CRUDE_API crude_scene_bvh_aabb
+crude_scene_bvh_aabb_from_sphere
+(
+  _In_ XMVECTOR                                            center,
+  _In_ float32                                             radius
+);
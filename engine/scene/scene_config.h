@@ -1,4 +1,16 @@
 #pragma once
 
 #define CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX                      1024
-#define CRUDE_NODE_COUNT_MAX                                         1024
\ No newline at end of file
+#define CRUDE_NODE_COUNT_MAX                                         1024
+#define CRUDE_NODE_NAME_LENGTH_MAX                                   128
+#define CRUDE_NODE_POOL_FREE_NODES_MAX_COUNT_DEFAULT                 64
+#define CRUDE_NODE_LOAD_COMMIT_BUDGET_SECONDS_DEFAULT                ( 0.004f )
+#define CRUDE_NODE_LOAD_STAGING_ALLOCATOR_SIZE                       ( CRUDE_RMEGA( 256 ) )
+#define CRUDE_WORLD_PARTITION_LOAD_DISTANCE_DEFAULT                  ( 64.f )
+#define CRUDE_WORLD_PARTITION_UNLOAD_DISTANCE_DEFAULT                ( 96.f )
+#define CRUDE_WORLD_PARTITION_MEMORY_BUDGET_DEFAULT                  ( CRUDE_RMEGA( 512 ) )
+#define CRUDE_SCENE_BVH_TRACKERS_MAX                                 16
+#define CRUDE_SCENE_BVH_QUERY_STACK_SIZE                             256
+#define CRUDE_SCENE_BVH_NODES_INITIAL_CAPACITY                       256
+#define CRUDE_SCENE_BVH_AABB_MARGIN_DEFAULT                          ( 0.5f )
+#define CRUDE_SCENE_BVH_REFIT_EPSILON                                ( 1e-4f )
@@ -12,6 +12,7 @@
  *
  *********************************************************/
 
+#if !CRUDE_HEADLESS
 CRUDE_ECS_OBSERVER_DECLARE( crude_gltf_destroy_observer_ );
 
 static void
@@ -19,6 +20,7 @@ crude_gltf_destroy_observer_
 (
   _In_ ecs_iter_t                                         *it
 );
+#endif
 
 ECS_COMPONENT_DECLARE( crude_transform );
 ECS_COMPONENT_DECLARE( crude_light );
@@ -29,6 +31,7 @@ ECS_COMPONENT_DECLARE( crude_ray );
 ECS_COMPONENT_DECLARE( crude_ddgi_area );
 ECS_COMPONENT_DECLARE( crude_terrain );
 ECS_COMPONENT_DECLARE( crude_world_environment );
+ECS_COMPONENT_DECLARE( crude_world_partition_cell );
 
 CRUDE_COMPONENT_STRING_DEFINE( crude_camera, "crude_camera" );
 CRUDE_COMPONENT_STRING_DEFINE( crude_transform, "crude_transform" );
@@ -39,6 +42,7 @@ CRUDE_COMPONENT_STRING_DEFINE( crude_ray, "crude_ray" );
 CRUDE_COMPONENT_STRING_DEFINE( crude_ddgi_area, "crude_ddgi_area" );
 CRUDE_COMPONENT_STRING_DEFINE( crude_terrain, "crude_terrain" );
 CRUDE_COMPONENT_STRING_DEFINE( crude_world_environment, "crude_world_environment" );
+CRUDE_COMPONENT_STRING_DEFINE( crude_world_partition_cell, "crude_world_partition_cell" );
 
 void
 crude_scene_components_import
@@ -57,35 +61,44 @@ crude_scene_components_import
   CRUDE_ECS_COMPONENT_DEFINE( world, crude_ddgi_area );
   CRUDE_ECS_COMPONENT_DEFINE( world, crude_terrain );
   CRUDE_ECS_COMPONENT_DEFINE( world, crude_world_environment );
+  CRUDE_ECS_COMPONENT_DEFINE( world, crude_world_partition_cell );
   CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_transform );
   CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_light );
   CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_camera );
-  CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_gltf );
   CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_node_external );
   CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_ray );
   CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_ddgi_area );
-  CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_terrain );
   CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_world_environment );
+  CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_world_partition_cell );
   CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_transform );
   CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_light );
   CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_camera );
-  CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_gltf );
   CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_ray );
   CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_ddgi_area );
-  CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_terrain );
   CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_world_environment );
+  CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_world_partition_cell );
   CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_transform );
   CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_light );
   CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_camera );
-  CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_gltf );
   CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_ray );
   CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_ddgi_area );
-  CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_terrain );
   CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_world_environment );
+  CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_world_partition_cell );
+
+  /* Headless builds have no renderer resources behind gltf and terrain components */
+#if !CRUDE_HEADLESS
+  CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_gltf );
+  CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DEFINE( manager, crude_terrain );
+  CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_gltf );
+  CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DEFINE( manager, crude_terrain );
+  CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_gltf );
+  CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DEFINE( manager, crude_terrain );
 
   CRUDE_ECS_OBSERVER_DEFINE( world, crude_gltf_destroy_observer_, EcsOnRemove, NULL, { 
-    { .id = ecs_id( crude_gltf ), .oper = EcsAnd }
+    { .id = ecs_id( crude_gltf ), .oper = EcsAnd },
+    { .id = EcsDisabled, .oper = EcsOptional }
   } );
+#endif
 }
 
 CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_IMPLEMENTATION( crude_camera )
@@ -170,6 +183,7 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_transform )
   } );
 }
 
+#if !CRUDE_HEADLESS
 CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_IMPLEMENTATION( crude_gltf )
 {
   char const                                              *gltf_relative_filepath;
@@ -372,6 +386,7 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_gltf )
     } );
 #endif /* CRUDE_DEVELOP */
 }
+#endif /* !CRUDE_HEADLESS */
 
 CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_IMPLEMENTATION( crude_light )
 {
@@ -611,6 +626,73 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_ddgi_area )
   } );
 }
 
+CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_IMPLEMENTATION( crude_world_partition_cell )
+{
+  *component = crude_world_partition_cell_empty( );
+
+  crude_string_copy( component->node_relative_filepath, cJSON_GetStringValue( cJSON_GetObjectItemCaseSensitive( component_json, "node_relative_filepath" ) ), sizeof( component->node_relative_filepath ) );
+  crude_parse_json_to_float3( &component->bounds_min, cJSON_GetObjectItemCaseSensitive( component_json, "bounds_min" ) );
+  crude_parse_json_to_float3( &component->bounds_max, cJSON_GetObjectItemCaseSensitive( component_json, "bounds_max" ) );
+  component->priority = cJSON_GetNumberValue( cJSON_GetObjectItemCaseSensitive( component_json, "priority" ) );
+  return true;
+}
+
+CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_IMPLEMENTATION( crude_world_partition_cell )
+{
+  cJSON *world_partition_cell_json = cJSON_CreateObject( );
+  cJSON_AddItemToObject( world_partition_cell_json, "type", cJSON_CreateString( CRUDE_COMPONENT_STRING( crude_world_partition_cell ) ) );
+  cJSON_AddItemToObject( world_partition_cell_json, "node_relative_filepath", cJSON_CreateString( component->node_relative_filepath ) );
+  cJSON_AddItemToObject( world_partition_cell_json, "bounds_min", cJSON_CreateFloatArray( &component->bounds_min.x, 3 ) );
+  cJSON_AddItemToObject( world_partition_cell_json, "bounds_max", cJSON_CreateFloatArray( &component->bounds_max.x, 3 ) );
+  cJSON_AddItemToObject( world_partition_cell_json, "priority", cJSON_CreateNumber( component->priority ) );
+  return world_partition_cell_json;
+}
+
+CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_world_partition_cell )
+{
+  CRUDE_IMGUI_START_OPTIONS;
+  
+  CRUDE_IMGUI_OPTION( "Bounds Min", {
+    ImGui::DragFloat3( "##Bounds Min", &component->bounds_min.x, 0.1f );
+  } );
+  
+  CRUDE_IMGUI_OPTION( "Bounds Max", {
+    ImGui::DragFloat3( "##Bounds Max", &component->bounds_max.x, 0.1f );
+  } );
+  
+  CRUDE_IMGUI_OPTION( "Priority", {
+    ImGui::DragInt( "##Priority", &component->priority );
+  } );
+  
+  CRUDE_IMGUI_OPTION( "Resident Memory Size", {
+    ImGui::Text( "%llu KB", component->resident_memory_size / 1024 );
+  } );
+  
+  CRUDE_IMGUI_OPTION( "Streamed", {
+    ImGui::Text( "%s", crude_entity_valid( world, component->streamed_node ) ? "Yes" : "No" );
+  } );
+
+  ImGui::Text( "\"%s\"", component->node_relative_filepath[ 0 ] ? component->node_relative_filepath : "Empty" );
+
+  if ( ImGui::BeginDragDropTarget( ) )
+  {
+    ImGuiPayload const                                    *im_payload;
+    char                                                  *replace_relative_filepath;
+  
+    im_payload = ImGui::AcceptDragDropPayload( "crude_content_browser_file" );
+    if ( im_payload )
+    {
+      replace_relative_filepath = CRUDE_CAST( char*, im_payload->Data );
+      if ( strstr( replace_relative_filepath, ".crude_node" ) )
+      {
+        crude_string_copy( component->node_relative_filepath, replace_relative_filepath, sizeof( component->node_relative_filepath ) );
+      }
+    }
+    ImGui::EndDragDropTarget();
+  }
+}
+
+#if !CRUDE_HEADLESS
 CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_IMPLEMENTATION( crude_terrain )
 {
   crude_gfx_texture_manager                               *texture_manager;
@@ -670,6 +752,7 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_terrain )
     }
   } );
 }
+#endif /* !CRUDE_HEADLESS */
 
 CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_IMPLEMENTATION( crude_world_environment )
 {
@@ -708,6 +791,7 @@ CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_IMPLEMENTATION( crude_world_environment )
   } );
 }
 
+#if !CRUDE_HEADLESS
 void
 crude_gltf_destroy_observer_ 
 (
@@ -724,4 +808,5 @@ crude_gltf_destroy_observer_
     
     crude_gfx_model_renderer_resources_instance_deinitialize( &gltf->model_renderer_resources_instance );
   }
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -6,6 +6,8 @@
 
 #include <engine/scene/scene_resources.h>
 
+/* Contact events queued by the physics step are dispatched here, before anything else reads the world */
+ecs_entity_t const crude_ecs_on_physics_contacts = EcsOnLoad;
 ecs_entity_t const crude_ecs_on_pre_physics_update = EcsPostLoad;
 ecs_entity_t const crude_ecs_on_engine_update = EcsPreUpdate;
 ecs_entity_t const crude_ecs_on_game_update = EcsOnUpdate;
@@ -31,6 +33,7 @@ CRUDE_API ECS_COMPONENT_DECLARE( crude_ray );
 CRUDE_API ECS_COMPONENT_DECLARE( crude_ddgi_area );
 CRUDE_API ECS_COMPONENT_DECLARE( crude_terrain );
 CRUDE_API ECS_COMPONENT_DECLARE( crude_world_environment );
+CRUDE_API ECS_COMPONENT_DECLARE( crude_world_partition_cell );
 
 CRUDE_API CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DECLARATION( crude_camera );
 CRUDE_API CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DECLARATION( crude_camera );
@@ -48,6 +51,8 @@ CRUDE_API CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DECLARATION( crude_terrain );
 CRUDE_API CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DECLARATION( crude_terrain );
 CRUDE_API CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DECLARATION( crude_world_environment );
 CRUDE_API CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DECLARATION( crude_world_environment );
+CRUDE_API CRUDE_PARSE_JSON_TO_COMPONENT_FUNC_DECLARATION( crude_world_partition_cell );
+CRUDE_API CRUDE_PARSE_COMPONENT_TO_JSON_FUNC_DECLARATION( crude_world_partition_cell );
 
 CRUDE_API CRUDE_COMPONENT_STRING_DECLARE( crude_camera );
 CRUDE_API CRUDE_COMPONENT_STRING_DECLARE( crude_transform );
@@ -58,6 +63,7 @@ CRUDE_API CRUDE_COMPONENT_STRING_DECLARE( crude_ray );
 CRUDE_API CRUDE_COMPONENT_STRING_DECLARE( crude_ddgi_area );
 CRUDE_API CRUDE_COMPONENT_STRING_DECLARE( crude_terrain );
 CRUDE_API CRUDE_COMPONENT_STRING_DECLARE( crude_world_environment );
+CRUDE_API CRUDE_COMPONENT_STRING_DECLARE( crude_world_partition_cell );
 
 CRUDE_API CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DECLARATION( crude_camera );
 CRUDE_API CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DECLARATION( crude_transform );
@@ -68,6 +74,7 @@ CRUDE_API CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DECLARATION( crude_ray );
 CRUDE_API CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DECLARATION( crude_ddgi_area );
 CRUDE_API CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DECLARATION( crude_terrain );
 CRUDE_API CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DECLARATION( crude_world_environment );
+CRUDE_API CRUDE_PARSE_COMPONENT_TO_IMGUI_FUNC_DECLARATION( crude_world_partition_cell );
 
 CRUDE_API void
 crude_scene_components_import
@@ -24,6 +24,7 @@ crude_transform_empty
   return transform;
 }
 
+#if !CRUDE_HEADLESS
 crude_gltf
 crude_gltf_empty
 (
@@ -34,6 +35,7 @@ crude_gltf_empty
   crude_gfx_model_renderer_resources_instance_initialize( &gltf.model_renderer_resources_instance, NULL, CRUDE_COMPOUNT( crude_gfx_model_renderer_resources_handle, { -1 } ) );
   return gltf;
 }
+#endif
 
 crude_ray
 crude_ray_empty
@@ -229,4 +231,17 @@ crude_ddgi_area_empty
   ddgi_area.probe_rays = 128;
   ddgi_area.use_half_resolution = false;
   return ddgi_area;
+}
+
+crude_world_partition_cell
+crude_world_partition_cell_empty
+(
+)
+{
+  crude_world_partition_cell                               world_partition_cell;
+
+  world_partition_cell = CRUDE_COMPOUNT_EMPTY( crude_world_partition_cell );
+  world_partition_cell.bounds_min = XMFLOAT3{ -32.0, -32.0, -32.0 };
+  world_partition_cell.bounds_max = XMFLOAT3{ 32.0, 32.0, 32.0 };
+  return world_partition_cell;
 }
\ No newline at end of file
@@ -87,6 +87,23 @@ typedef struct crude_ddgi_area
   bool                                                     use_half_resolution;
 } crude_ddgi_area;
 
+/**
+ * Node file streamed in by crude_world_partition when the focus is close
+ * to the cell bounds (world space). Resident cost is measured from the
+ * model and shape managers once the cell is loaded.
+ */
+typedef struct crude_world_partition_cell
+{
+  char                                                     node_relative_filepath[ CRUDE_NODE_RELATIVE_FILEPATH_LENGTH_MAX ];
+  XMFLOAT3                                                 bounds_min;
+  XMFLOAT3                                                 bounds_max;
+  int32                                                    priority;
+  /* Runtime */
+  crude_entity                                             streamed_node;
+  /* Models and mesh shapes of the last streamed node, assets shared with other cells are counted in each */
+  uint64                                                   resident_memory_size;
+} crude_world_partition_cell;
+
 typedef struct crude_terrain
 {
   crude_gfx_texture_handle                                 height_texture_handle;
@@ -181,4 +198,9 @@ crude_light_empty
 CRUDE_API crude_ddgi_area
 crude_ddgi_area_empty
 (
+);
+
+CRUDE_API crude_world_partition_cell
+crude_world_partition_cell_empty
+(
 );
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include <engine/core/profiler.h>
+#include <engine/core/array.h>
+#include <engine/scene/scene_ecs.h>
+
+#include <engine/scene/world_partition.h>
+
+typedef struct crude_world_partition_cell_distance
+{
+  crude_entity                                             cell_node;
+  float32                                                  distance;
+} crude_world_partition_cell_distance;
+
+static void
+crude_world_partition_cell_loaded_
+(
+  _In_ void                                               *ctx,
+  _In_ crude_entity                                        node
+);
+
+static void
+crude_world_partition_unload_cell_
+(
+  _In_ crude_world_partition                              *partition,
+  _In_ crude_entity                                        cell_node
+);
+
+static bool
+crude_world_partition_evict_farthest_cell_
+(
+  _In_ crude_world_partition                              *partition,
+  _In_ crude_world_partition_cell_distance const          *cells_distances,
+  _In_ float32                                             min_distance
+);
+
+void
+crude_world_partition_initialize
+(
+  _In_ crude_world_partition                              *partition,
+  _In_ crude_world_partition_creation const               *creation
+)
+{
+  partition->node_manager = creation->node_manager;
+  partition->world = creation->world;
+  partition->load_distance = creation->load_distance;
+  partition->unload_distance = CRUDE_MAX( creation->unload_distance, creation->load_distance );
+  partition->memory_budget = creation->memory_budget;
+  partition->loading_cell_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+  partition->resident_memory_size = 0u;
+  partition->resident_cells_count = 0u;
+}
+
+void
+crude_world_partition_update
+(
+  _In_ crude_world_partition                              *partition,
+  _In_ XMVECTOR                                            focus_position
+)
+{
+  crude_world_partition_cell_distance                     *cells_distances;
+  crude_world_partition_cell const                        *candidate_cell;
+  ecs_iter_t                                               it;
+  int64                                                    candidate_index;
+  uint32                                                   temporary_allocator_marker;
+
+  CRUDE_PROFILER_ZONE_NAME( "crude_world_partition_update" );
+
+  temporary_allocator_marker = crude_stack_allocator_get_marker( partition->node_manager->temporary_allocator );
+  CRUDE_ARRAY_INITIALIZE_WITH_CAPACITY( cells_distances, ecs_count_id( partition->world, ecs_id( crude_world_partition_cell ) ), crude_stack_allocator_pack( partition->node_manager->temporary_allocator ) );
+
+  partition->resident_memory_size = 0u;
+  partition->resident_cells_count = 0u;
+
+  it = ecs_each_id( partition->world, ecs_id( crude_world_partition_cell ) );
+  while ( ecs_each_next( &it ) )
+  {
+    crude_world_partition_cell                            *cells;
+
+    /* Template and pooled nodes are not streamed */
+    if ( ecs_table_has_flags( it.table, EcsTableIsPrefab | EcsTableIsDisabled ) )
+    {
+      continue;
+    }
+
+    cells = ecs_field( &it, crude_world_partition_cell, 0 );
+
+    for ( uint32 i = 0; i < it.count; ++i )
+    {
+      crude_world_partition_cell_distance                  cell_distance;
+      XMVECTOR                                             closest_point;
+
+      /* Streamed node could be destroyed by gameplay */
+      if ( cells[ i ].streamed_node && !crude_entity_valid( partition->world, cells[ i ].streamed_node ) )
+      {
+        cells[ i ].streamed_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+      }
+
+      closest_point = XMVectorClamp( focus_position, XMLoadFloat3( &cells[ i ].bounds_min ), XMLoadFloat3( &cells[ i ].bounds_max ) );
+
+      cell_distance.cell_node = crude_entity_from_iterator( &it, i );
+      cell_distance.distance = XMVectorGetX( XMVector3Length( XMVectorSubtract( focus_position, closest_point ) ) );
+      CRUDE_ARRAY_PUSH( cells_distances, cell_distance );
+
+      if ( cells[ i ].streamed_node )
+      {
+        partition->resident_memory_size += cells[ i ].resident_memory_size;
+        ++partition->resident_cells_count;
+      }
+    }
+  }
+
+  /* Structural changes are done after iteration */
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( cells_distances ); ++i )
+  {
+    if ( cells_distances[ i ].distance > partition->unload_distance )
+    {
+      crude_world_partition_unload_cell_( partition, cells_distances[ i ].cell_node );
+    }
+  }
+
+  /* Cell size is known only after its load, so the last loaded cell could overflow the budget */
+  while ( partition->resident_memory_size > partition->memory_budget && partition->resident_cells_count > 1 )
+  {
+    if ( !crude_world_partition_evict_farthest_cell_( partition, cells_distances, 0.f ) )
+    {
+      break;
+    }
+  }
+
+  /* Node manager commits loads one by one, so only one cell is requested at a time */
+  if ( partition->loading_cell_node )
+  {
+    goto cleanup;
+  }
+
+  candidate_index = -1;
+  candidate_cell = NULL;
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( cells_distances ); ++i )
+  {
+    crude_world_partition_cell const                      *cell;
+
+    if ( cells_distances[ i ].distance > partition->load_distance )
+    {
+      continue;
+    }
+
+    cell = CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( partition->world, cells_distances[ i ].cell_node, crude_world_partition_cell );
+    if ( cell->streamed_node || !cell->node_relative_filepath[ 0 ] )
+    {
+      continue;
+    }
+
+    if ( candidate_index == -1 || cell->priority > candidate_cell->priority || ( cell->priority == candidate_cell->priority && cells_distances[ i ].distance < cells_distances[ candidate_index ].distance ) )
+    {
+      candidate_index = i;
+      candidate_cell = cell;
+    }
+  }
+
+  if ( candidate_index == -1 )
+  {
+    goto cleanup;
+  }
+
+  /* Cells which were never loaded are estimated by zero */
+  while ( partition->resident_memory_size + candidate_cell->resident_memory_size > partition->memory_budget )
+  {
+    /* Everything resident is closer than the candidate */
+    if ( !crude_world_partition_evict_farthest_cell_( partition, cells_distances, cells_distances[ candidate_index ].distance ) )
+    {
+      goto cleanup;
+    }
+  }
+
+  partition->loading_cell_node = cells_distances[ candidate_index ].cell_node;
+  crude_node_manager_load_node_async( partition->node_manager, candidate_cell->node_relative_filepath, partition->world, &partition->loading_cell_node, crude_world_partition_cell_loaded_, partition );
+
+cleanup:
+  crude_stack_allocator_free_marker( partition->node_manager->temporary_allocator, temporary_allocator_marker );
+  CRUDE_PROFILER_ZONE_END;
+}
+
+void
+crude_world_partition_cell_loaded_
+(
+  _In_ void                                               *ctx,
+  _In_ crude_entity                                        node
+)
+{
+  crude_world_partition                                   *partition;
+  crude_world_partition_cell                              *cell;
+  crude_node_manager_node_assets                           assets;
+  crude_entity                                             cell_node;
+  uint32                                                   temporary_allocator_marker;
+
+  partition = CRUDE_CAST( crude_world_partition*, ctx );
+  cell_node = partition->loading_cell_node;
+  partition->loading_cell_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+
+  if ( !crude_entity_valid( partition->world, node ) )
+  {
+    return;
+  }
+
+  temporary_allocator_marker = crude_stack_allocator_get_marker( partition->node_manager->temporary_allocator );
+  crude_node_manager_collect_node_assets( partition->node_manager, partition->world, node, partition->node_manager->temporary_allocator, &assets );
+
+  if ( !crude_entity_valid( partition->world, cell_node ) )
+  {
+    crude_entity_destroy_hierarchy( partition->world, node );
+    crude_node_manager_release_unused_node_assets( partition->node_manager, partition->world, &assets );
+    goto cleanup;
+  }
+
+  cell = CRUDE_ENTITY_GET_MUTABLE_COMPONENT( partition->world, cell_node, crude_world_partition_cell );
+  cell->streamed_node = node;
+  cell->resident_memory_size = assets.size;
+
+  partition->resident_memory_size += cell->resident_memory_size;
+  ++partition->resident_cells_count;
+
+cleanup:
+  crude_stack_allocator_free_marker( partition->node_manager->temporary_allocator, temporary_allocator_marker );
+}
+
+void
+crude_world_partition_unload_cell_
+(
+  _In_ crude_world_partition                              *partition,
+  _In_ crude_entity                                        cell_node
+)
+{
+  crude_world_partition_cell                              *cell;
+  crude_node_manager_node_assets                           assets;
+  uint32                                                   temporary_allocator_marker;
+
+  cell = CRUDE_ENTITY_GET_MUTABLE_COMPONENT( partition->world, cell_node, crude_world_partition_cell );
+  if ( !cell->streamed_node )
+  {
+    return;
+  }
+
+  temporary_allocator_marker = crude_stack_allocator_get_marker( partition->node_manager->temporary_allocator );
+
+  /* Models and shapes aren't released with entities, other nodes could still use them */
+  crude_node_manager_collect_node_assets( partition->node_manager, partition->world, cell->streamed_node, partition->node_manager->temporary_allocator, &assets );
+  crude_entity_destroy_hierarchy( partition->world, cell->streamed_node );
+  crude_node_manager_release_unused_node_assets( partition->node_manager, partition->world, &assets );
+
+  crude_stack_allocator_free_marker( partition->node_manager->temporary_allocator, temporary_allocator_marker );
+
+  cell->streamed_node = CRUDE_COMPOUNT_EMPTY( crude_entity );
+
+  partition->resident_memory_size -= CRUDE_MIN( partition->resident_memory_size, cell->resident_memory_size );
+  --partition->resident_cells_count;
+}
+
+bool
+crude_world_partition_evict_farthest_cell_
+(
+  _In_ crude_world_partition                              *partition,
+  _In_ crude_world_partition_cell_distance const          *cells_distances,
+  _In_ float32                                             min_distance
+)
+{
+  int64                                                    evict_index;
+
+  evict_index = -1;
+  for ( uint32 i = 0; i < CRUDE_ARRAY_LENGTH( cells_distances ); ++i )
+  {
+    if ( cells_distances[ i ].distance <= min_distance )
+    {
+      continue;
+    }
+
+    if ( !CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( partition->world, cells_distances[ i ].cell_node, crude_world_partition_cell )->streamed_node )
+    {
+      continue;
+    }
+
+    if ( evict_index == -1 || cells_distances[ i ].distance > cells_distances[ evict_index ].distance )
+    {
+      evict_index = i;
+    }
+  }
+
+  if ( evict_index == -1 )
+  {
+    return false;
+  }
+
+  crude_world_partition_unload_cell_( partition, cells_distances[ evict_index ].cell_node );
+  return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <engine/core/ecs.h>
+#include <engine/core/math.h>
+#include <engine/scene/node_manager.h>
+
+typedef struct crude_world_partition_creation
+{
+  crude_node_manager                                      *node_manager;
+  crude_ecs                                               *world;
+  float32                                                  load_distance;
+  float32                                                  unload_distance;
+  uint64                                                   memory_budget;
+} crude_world_partition_creation;
+
+/**
+ * Streams crude_world_partition_cell nodes around the focus position. Cells
+ * are loaded with priority first and distance second, unloaded only after
+ * unload_distance (hysteresis), and farther cells are evicted when a nearer
+ * one doesn't fit into memory_budget.
+ */
+typedef struct crude_world_partition
+{
+  /* Context */
+  crude_node_manager                                      *node_manager;
+  crude_ecs                                               *world;
+
+  /* Options */
+  float32                                                  load_distance;
+  float32                                                  unload_distance;
+  uint64                                                   memory_budget;
+
+  /* Data */
+  crude_entity                                             loading_cell_node;
+  uint64                                                   resident_memory_size;
+  uint32                                                   resident_cells_count;
+} crude_world_partition;
+
+CRUDE_API void
+crude_world_partition_initialize
+(
+  _In_ crude_world_partition                              *partition,
+  _In_ crude_world_partition_creation const               *creation
+);
+
+CRUDE_API void
+crude_world_partition_update
+(
+  _In_ crude_world_partition                              *partition,
+  _In_ XMVECTOR                                            focus_position
+);
@@ -398,7 +398,7 @@ crude_player_controller_game_update_system_
       
         player_controller->move_speed = player_controller->walk_speed;
         
-        player_velocity = crude_jph_vec3_to_vector( physcs_character_container->jph_character_class->GetLinearVelocity( ) );
+        player_velocity = crude_physics_character_get_linear_velocity( physcs_character_container );
         
         if ( move_direction.z < 0 )
         {
@@ -428,7 +428,7 @@ crude_player_controller_game_update_system_
           new_player_velocity = XMVectorSetY( new_player_velocity, XMVectorGetY( player_velocity ) );
         }
 
-        physcs_character_container->jph_character_class->SetLinearVelocity( crude_vector_to_jph_vec3( new_player_velocity ) );
+        crude_physics_character_set_linear_velocity( physcs_character_container, new_player_velocity );
       }
     }
 
@@ -581,7 +581,7 @@ crude_player_health_damage_callback_
 
   game = crude_game_instance( );
   
-  if ( rand(  ) % 8  > 6 )
+  if ( crude_random_next_u32( &game->engine->gameplay_random ) % 8  > 6 )
   {
     crude_audio_player_handle *critical_hit_audio_player_handle = CRUDE_ENTITY_GET_MUTABLE_COMPONENT( game->engine->world, crude_ecs_lookup_entity_from_parent( game->engine->world, game->player_node, "critical_hit_audio_player" ), crude_audio_player_handle );
     crude_audio_device_sound_reset( &game->engine->audio_device, critical_hit_audio_player_handle->sound_handle );
@@ -242,10 +242,24 @@ crude_zombie_game_update_system_
   crude_game                                              *game;
   crude_zombie_system_context                             *ctx;
   crude_zombie                                            *zombie_per_entity;
+  crude_physics_ray_cast_query                            *sight_queries;
+  crude_physics_ray_cast_batch_result                     *sight_results;
+  uint32                                                  *sight_zombies_indices;
+  XMFLOAT3                                                 sight_player_position;
+  uint32                                                   sight_queries_count;
+  uint64                                                   temporary_allocator_marker;
 
   game = crude_game_instance( );
   ctx = CRUDE_CAST( crude_zombie_system_context*, it->ctx );
   zombie_per_entity = ecs_field( it, crude_zombie, 0 );
+
+  /* Sight rays of all zombies are cast together on the task sheduler workers after the loop */
+  temporary_allocator_marker = crude_stack_allocator_get_marker( &game->engine->temporary_allocator );
+  sight_queries = CRUDE_CAST( crude_physics_ray_cast_query*, CRUDE_ALLOCATE( crude_stack_allocator_pack( &game->engine->temporary_allocator ), sizeof( crude_physics_ray_cast_query ) * it->count ) );
+  sight_results = CRUDE_CAST( crude_physics_ray_cast_batch_result*, CRUDE_ALLOCATE( crude_stack_allocator_pack( &game->engine->temporary_allocator ), sizeof( crude_physics_ray_cast_batch_result ) * it->count ) );
+  sight_zombies_indices = CRUDE_CAST( uint32*, CRUDE_ALLOCATE( crude_stack_allocator_pack( &game->engine->temporary_allocator ), sizeof( uint32 ) * it->count ) );
+  sight_player_position = XMFLOAT3{ 0.f, 0.f, 0.f };
+  sight_queries_count = 0u;
   
   for ( uint32 i = 0; i < it->count; ++i )
   {
@@ -279,6 +293,11 @@ crude_zombie_game_update_system_
       {
         crude_gfx_model_renderer_resources_instance_blend_one_animation( &zombie_model->model_renderer_resources_instance, zombie->dead_animation_index );
       }
+      else if ( CRUDE_ENTITY_HAS_COMPONENT( it->world, zombie_entity, crude_node_external ) )
+      {
+        /* Spawned from a zombie node, it's reused by the next crude_node_manager_acquire_node */
+        crude_node_manager_release_node( &game->engine->node_manager, CRUDE_ENTITY_GET_IMMUTABLE_COMPONENT( it->world, zombie_entity, crude_node_external )->node_relative_filepath, it->world, zombie_entity );
+      }
       else
       {
         CRUDE_ENTITY_ADD_COMPONENT( game->engine->world, zombie_entity, crude_dead );
@@ -341,7 +360,7 @@ crude_zombie_game_update_system_
 
       if ( zombie_model->model_renderer_resources_instance.animations_instances[ zombie->hit_animation_index ].disabled && crude_entity_valid( it->world, game->player_node ) )
       {
-        crude_ray_cast_result                                ray_cast_result;
+        crude_physics_ray_cast_query                        *sight_query;
         XMMATRIX                                             ray_to_player_to_world;
         XMVECTOR                                             ray_direction, ray_origin;
 
@@ -353,13 +372,14 @@ crude_zombie_game_update_system_
         float32 angle = XMVectorGetX( XMVector3Dot( XMVector3Normalize( XMVectorSetY( ray_direction, 0 ) ), XMVector3Normalize( XMVectorSetY( XMVector3TransformNormal( XMVectorSet( 0, 0, 1, 0 ), ray_to_player_to_world ), 0 ) ) ) );
         if ( acos( angle ) < XM_PIDIV2 )
         {
-          if ( crude_physics_ray_cast( &game->engine->physics, game->engine->world, ray_origin, ray_direction, g_crude_jph_broad_phase_layer_area_mask | g_crude_jph_broad_phase_layer_static_mask, g_crude_jph_mask_custom0 | g_crude_jph_mask_custom2, &ray_cast_result ) )
-          {
-            if ( ray_cast_result.layer & g_crude_jph_layer_custom2 )
-            {
-              XMStoreFloat3( &zombie->target_point, player_to_world.r[ 3 ] );
-            }
-          }
+          sight_query = &sight_queries[ sight_queries_count ];
+          XMStoreFloat3( &sight_query->origin, ray_origin );
+          XMStoreFloat3( &sight_query->direction, ray_direction );
+          sight_query->broad_phase_mask = g_crude_jph_broad_phase_layer_area_mask | g_crude_jph_broad_phase_layer_static_mask;
+          sight_query->layer_mask = g_crude_jph_mask_custom0 | g_crude_jph_mask_custom2;
+          sight_zombies_indices[ sight_queries_count ] = i;
+          XMStoreFloat3( &sight_player_position, player_to_world.r[ 3 ] );
+          ++sight_queries_count;
         }
       }
 
@@ -381,6 +401,17 @@ crude_zombie_game_update_system_
       }
     }
   }
+
+  crude_physics_ray_cast_batch( &game->engine->physics, sight_queries, sight_queries_count, sight_results );
+  for ( uint32 i = 0; i < sight_queries_count; ++i )
+  {
+    if ( sight_results[ i ].hit && ( sight_results[ i ].ray_cast_result.layer & g_crude_jph_layer_custom2 ) )
+    {
+      zombie_per_entity[ sight_zombies_indices[ i ] ].target_point = sight_player_position;
+    }
+  }
+
+  crude_stack_allocator_free_marker( &game->engine->temporary_allocator, temporary_allocator_marker );
   CRUDE_PROFILER_ZONE_END;
 }
 
@@ -494,9 +525,10 @@ crude_zombie_health_death_callback_
 
   zombie->dying = true;
   
+  /* Disabled instead of destroyed, the released zombie is enabled back by the node pool */
   crude_entity zombie_attack_sensor_entity = crude_ecs_lookup_entity_from_parent( game->engine->world, zombie_pivot_entity, "attack_sensor" );
-  crude_entity_destroy_hierarchy( game->engine->world, health_entity );
-  crude_entity_destroy_hierarchy( game->engine->world, zombie_attack_sensor_entity );
+  crude_node_manager_enable_node( &game->engine->node_manager, game->engine->world, health_entity, false );
+  crude_node_manager_enable_node( &game->engine->node_manager, game->engine->world, zombie_attack_sensor_entity, false );
 
   zombie_death_audio_player_entity = crude_ecs_lookup_entity_from_parent( game->engine->world, zombie_entity, "zombie_dead" );
   zombie_death_audio_player_handle = CRUDE_ENTITY_GET_MUTABLE_COMPONENT( game->engine->world, zombie_death_audio_player_entity, crude_audio_player_handle );